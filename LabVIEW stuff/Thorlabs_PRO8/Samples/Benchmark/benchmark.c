@@ -0,0 +1,660 @@
+/****************************************************************************
+
+   Thorlabs PRO800/PRO8000 Instrument Driver Benchmark
+
+   Source file    benchmark.c
+
+   Date:          Oct-16-2026
+   Software-Nr:   N/A
+   Version:       1.0
+   Copyright:     Copyright(c) 2010, Thorlabs GmbH (www.thorlabs.com)
+
+   Disclaimer:
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+
+
+   NOTE: The benchmark times each driver function family against the
+         resource given with -r, or against the simulator in
+         Samples/Simulator served on a pseudo terminal of this process.
+         It needs Linux and POSIX threads. Build it in this directory with
+
+            cc -O2 -I../.. -I<VISA include> -I<CVI include> -o benchmark
+               benchmark.c ../../pro8.c ../Simulator/pro8sim.c
+               -lvisa -lcvirte -lpthread -lm
+
+         where <VISA include> holds visa.h (e.g. '/usr/include/ni-visa')
+         and <CVI include> holds utility.h and formatio.h of the
+         LabWindows/CVI Run-Time Engine for Linux.
+
+****************************************************************************/
+
+#define _GNU_SOURCE
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+
+// Set your compiler include search path to the VXIPNP include directory
+#include "visa.h"
+#include "pro8.h"
+#include "pro8_ext.h"
+#include "../Simulator/pro8sim.h"
+
+/*===========================================================================
+ Macros
+===========================================================================*/
+#define HIST_SUB_BITS            6                          // 64 sub-buckets per power of two, 1.6 % resolution
+#define HIST_SUB_COUNT           (1 << HIST_SUB_BITS)
+#define HIST_BUCKETS             (HIST_SUB_COUNT * 40)      // up to 2^40 ns
+#define DEFAULT_ITERATIONS       2000
+#define WARMUP_ITERATIONS        20
+#define ELCH_STEPS               1001
+
+
+/*===========================================================================
+ Types
+===========================================================================*/
+typedef struct
+{
+   unsigned long long   count[HIST_BUCKETS];
+   unsigned long long   total;
+   unsigned long long   min, max;
+   double               sum;
+} histogram_t;
+
+typedef struct
+{
+   ViSession   handle;
+   ViInt16     ldSlot, tecSlot, anySlot, otherSlot;
+   ViInt32     iteration;
+   ViInt32     elchStep;                                  // steps of the running sweep
+} bench_t;
+
+typedef struct
+{
+   char        *name;
+   int         needs;                                     // NEED_xxx
+   ViStatus    (*setup)(bench_t *b);
+   ViStatus    (*call)(bench_t *b);
+} family_t;
+
+typedef struct
+{
+   ViSession   handle;
+   volatile int stop;
+   unsigned long long calls;
+} load_t;
+
+#define NEED_LD                  0x01
+#define NEED_TEC                 0x02
+#define NEED_TWO                 0x04
+
+
+/*===========================================================================
+ Prototypes
+===========================================================================*/
+void usage(const char *program);
+void error_exit(ViSession handle, ViStatus err);
+unsigned long long now_ns(void);
+void hist_record(histogram_t *h, unsigned long long ns);
+double hist_percentile(const histogram_t *h, double percentile);
+ViStatus find_slots(bench_t *b);
+void *load_thread(void *data);
+
+ViStatus setup_ld(bench_t *b);
+ViStatus setup_tec(bench_t *b);
+ViStatus setup_elch(bench_t *b);
+ViStatus call_set_slot(bench_t *b);
+ViStatus call_slot_config(bench_t *b);
+ViStatus call_slot_data(bench_t *b);
+ViStatus call_ld_set_current(bench_t *b);
+ViStatus call_ld_get_current_set(bench_t *b);
+ViStatus call_ld_get_current_act(bench_t *b);
+ViStatus call_ld_get_voltage(bench_t *b);
+ViStatus call_tec_set_temp(bench_t *b);
+ViStatus call_tec_get_temp_act(bench_t *b);
+ViStatus call_tec_set_pid(bench_t *b);
+ViStatus call_tec_get_pid(bench_t *b);
+ViStatus call_elch_meas(bench_t *b);
+ViStatus call_telemetry(bench_t *b);
+ViStatus call_error_query(bench_t *b);
+
+
+/*===========================================================================
+ Families
+===========================================================================*/
+static const family_t families[] =
+{
+   {"SetSlot",                NEED_TWO,   VI_NULL,    call_set_slot              },
+   {"GetSlotConfiguration",   0,          VI_NULL,    call_slot_config           },
+   {"SlotDataQueryEx",        0,          VI_NULL,    call_slot_data             },
+   {"LdcSetLdCurrent",        NEED_LD,    setup_ld,   call_ld_set_current        },
+   {"LdcGetLdCurrent(SET)",   NEED_LD,    setup_ld,   call_ld_get_current_set    },
+   {"LdcGetLdCurrent(ACT)",   NEED_LD,    setup_ld,   call_ld_get_current_act    },
+   {"LdcGetLdVoltage",        NEED_LD,    setup_ld,   call_ld_get_voltage        },
+   {"TecSetTemp",             NEED_TEC,   setup_tec,  call_tec_set_temp          },
+   {"TecGetTemp(ACT)",        NEED_TEC,   setup_tec,  call_tec_get_temp_act      },
+   {"TecSetPID",              NEED_TEC,   setup_tec,  call_tec_set_pid           },
+   {"TecGetPID",              NEED_TEC,   setup_tec,  call_tec_get_pid           },
+   {"ElchGetMeasVal",         NEED_LD,    setup_elch, call_elch_meas             },
+   {"TelemetrySnapshot",      0,          VI_NULL,    call_telemetry             },
+   {"errorQuery",             0,          VI_NULL,    call_error_query           },
+};
+
+#define FAMILY_COUNT             ((int)(sizeof(families) / sizeof(families[0])))
+
+
+/*===========================================================================
+ Functions
+===========================================================================*/
+int main(int argc, char **argv)
+{
+   ViStatus             err;
+   ViChar               *rscPtr      = VI_NULL;
+   ViChar               resource[256];
+   ViChar               transport[32];
+   ViReal64             pingMin, pingAvg, pingMax;
+   ViInt16              completion   = -1;
+   sim_config_t         cfg;
+   sim_t                *sim         = NULL;
+   bench_t              b;
+   static histogram_t   hist;
+   load_t               load;
+   pthread_t            loadThreads[16];
+   unsigned long long   rx0, tx0, rx1, tx1, start, t0, t1;
+   int                  opt, i, f, n, iterations = DEFAULT_ITERATIONS, loads = 0, first = 1;
+   char                 *filter      = NULL, *jsonName = NULL;
+   FILE                 *json        = NULL;
+   double               elapsed;
+
+   sim_default_config(&cfg);
+
+   // Parameter checking
+   while((opt = getopt(argc, argv, "r:n:l:c:f:o:m:s:j:S:h")) != -1)
+   {
+      switch(opt)
+      {
+         case 'r': rscPtr = optarg;                                       break;
+         case 'n': iterations = atoi(optarg);                             break;
+         case 'l': loads = atoi(optarg);                                  break;
+         case 'c': completion = (ViInt16)atoi(optarg);                    break;
+         case 'f': filter = optarg;                                       break;
+         case 'o': jsonName = optarg;                                     break;
+         case 'm': if(sim_parse_modules(&cfg, optarg)) usage(argv[0]);    break;
+         case 's': cfg.serviceTime = atof(optarg);                        break;
+         case 'j': cfg.jitter = atof(optarg);                             break;
+         case 'S': if(sim_parse_service(&cfg, optarg)) usage(argv[0]);    break;
+         default:  usage(argv[0]);
+      }
+   }
+   if((iterations < 1) || (loads < 0) || (loads > 16)) usage(argv[0]);
+
+   // Simulator - served by a thread of this process
+   if(!rscPtr)
+   {
+      if(((sim = sim_create(&cfg)) == NULL) || (sim_start_pty(sim, resource, sizeof(resource)) < 0))
+      {
+         fprintf(stderr, "ERROR: Simulator can not be started\n");
+         return (EXIT_FAILURE);
+      }
+      rscPtr = resource;
+   }
+
+   // Open session to instrument
+   memset(&b, 0, sizeof(b));
+   fprintf(stderr, "Opening session to '%s' ...\n", rscPtr);
+   err = Pro8_init(rscPtr, VI_ON, VI_OFF, &b.handle);
+   if(err) error_exit(b.handle, err);
+   if(completion >= 0)
+   {
+      err = Pro8_SetCompletionMode(b.handle, completion);
+      if(err) error_exit(b.handle, err);
+   }
+   err = Pro8_TransportPing(b.handle, 1, transport, &pingMin, &pingAvg, &pingMax);
+   if(err) error_exit(b.handle, err);
+   err = find_slots(&b);
+   if(err) error_exit(b.handle, err);
+
+   // Machine readable results
+   if(jsonName)
+   {
+      json = (strcmp(jsonName, "-") == 0) ? stdout : fopen(jsonName, "w");
+      if(!json)
+      {
+         perror(jsonName);
+         error_exit(b.handle, VI_SUCCESS);
+      }
+      fprintf(json, "{\"resource\": \"%s\", \"transport\": \"%s\", \"simulated\": %s, \"load_threads\": %d, \"iterations\": %d, \"results\": [",
+              rscPtr, transport, sim ? "true" : "false", loads, iterations);
+   }
+
+   // Load - telemetry snapshots on the same session
+   load.handle = b.handle;
+   load.stop   = 0;
+   load.calls  = 0;
+   for(i = 0; i < loads; i++)
+   {
+      if(pthread_create(&loadThreads[i], NULL, load_thread, &load) != 0) loads = i;
+   }
+
+   printf("Transport %s, %d load threads, %d calls per family\n\n", transport, loads, iterations);
+   printf("%-24s %10s %10s %10s %10s %10s %10s %8s\n", "Family", "calls/s", "p50 us", "p99 us", "p999 us", "max us", "bytes", "errors");
+
+   for(f = 0; f < FAMILY_COUNT; f++)
+   {
+      if(filter && !strstr(families[f].name, filter)) continue;
+      if(((families[f].needs & NEED_LD)  && !b.ldSlot) ||
+         ((families[f].needs & NEED_TEC) && !b.tecSlot) ||
+         ((families[f].needs & NEED_TWO) && !b.otherSlot))
+      {
+         printf("%-24s skipped - no module\n", families[f].name);
+         continue;
+      }
+      if(families[f].setup && ((err = families[f].setup(&b)) != VI_SUCCESS))
+      {
+         printf("%-24s skipped - setup failed (0x%08lX)\n", families[f].name, (unsigned long)err);
+         continue;
+      }
+      // Warm up
+      for(b.iteration = 0; b.iteration < WARMUP_ITERATIONS; b.iteration++) families[f].call(&b);
+
+      // Timed calls
+      memset(&hist, 0, sizeof(hist));
+      n = 0;
+      if(sim) sim_get_traffic(sim, &rx0, &tx0);
+      start = now_ns();
+      for(b.iteration = 0; b.iteration < iterations; b.iteration++)
+      {
+         t0 = now_ns();
+         err = families[f].call(&b);
+         t1 = now_ns();
+         if(err < 0) n++;
+         hist_record(&hist, t1 - t0);
+      }
+      elapsed = (double)(now_ns() - start) * 1.0e-9;
+      if(sim) sim_get_traffic(sim, &rx1, &tx1);
+
+      // Results
+      printf("%-24s %10.0f %10.1f %10.1f %10.1f %10.1f ", families[f].name, iterations / elapsed,
+             hist_percentile(&hist, 50.0) * 1.0e-3, hist_percentile(&hist, 99.0) * 1.0e-3, hist_percentile(&hist, 99.9) * 1.0e-3, hist.max * 1.0e-3);
+      if(sim) printf("%10.1f ", (double)((rx1 - rx0) + (tx1 - tx0)) / iterations);
+      else    printf("%10s ", "-");
+      printf("%8d\n", n);
+      if(json)
+      {
+         fprintf(json, "%s\n  {\"family\": \"%s\", \"calls\": %d, \"errors\": %d, \"seconds\": %.6f, \"calls_per_second\": %.1f, "
+                       "\"min_us\": %.3f, \"mean_us\": %.3f, \"p50_us\": %.3f, \"p90_us\": %.3f, \"p99_us\": %.3f, \"p999_us\": %.3f, \"max_us\": %.3f, ",
+                 first ? "" : ",", families[f].name, iterations, n, elapsed, iterations / elapsed,
+                 hist.min * 1.0e-3, hist.sum / hist.total * 1.0e-3, hist_percentile(&hist, 50.0) * 1.0e-3, hist_percentile(&hist, 90.0) * 1.0e-3,
+                 hist_percentile(&hist, 99.0) * 1.0e-3, hist_percentile(&hist, 99.9) * 1.0e-3, hist.max * 1.0e-3);
+         if(sim) fprintf(json, "\"bytes_sent_per_call\": %.1f, \"bytes_received_per_call\": %.1f}", (double)(rx1 - rx0) / iterations, (double)(tx1 - tx0) / iterations);
+         else    fprintf(json, "\"bytes_sent_per_call\": null, \"bytes_received_per_call\": null}");
+         first = 0;
+      }
+   }
+
+   // Stop load
+   load.stop = 1;
+   for(i = 0; i < loads; i++) pthread_join(loadThreads[i], NULL);
+   if(loads) printf("\n%llu load calls\n", load.calls);
+
+   if(json)
+   {
+      fprintf(json, "\n]}\n");
+      if(json != stdout) fclose(json);
+   }
+
+   // Close session to instrument
+   Pro8_close(b.handle);
+   if(sim) sim_destroy(sim);
+   return (EXIT_SUCCESS);
+}
+
+
+/*---------------------------------------------------------------------------
+  Find the slots of the families - first LD and TEC capable module, first
+  and second populated slot
+---------------------------------------------------------------------------*/
+ViStatus find_slots(bench_t *b)
+{
+   ViStatus err;
+   ViInt16  type[8], sub[8];
+   int      i;
+
+   err = Pro8_GetSlotConfiguration(b->handle, &type[0], &sub[0], &type[1], &sub[1], &type[2], &sub[2], &type[3], &sub[3],
+                                   &type[4], &sub[4], &type[5], &sub[5], &type[6], &sub[6], &type[7], &sub[7]);
+   if(err) return (err);
+   for(i = 0; i < PRO8_NUM_SLOTS; i++)
+   {
+      if(type[i] == 0) continue;
+      if(!b->anySlot)                                       b->anySlot   = i + 1;
+      else if(!b->otherSlot)                                b->otherSlot = i + 1;
+      if(!b->ldSlot  && ((type[i] == 191) || (type[i] == 47) || (type[i] == 159)))   b->ldSlot  = i + 1;
+      if(!b->tecSlot && ((type[i] == 223) || (type[i] == 159)))                      b->tecSlot = i + 1;
+   }
+   if(!b->anySlot) return (VI_ERROR_RSRC_NFOUND);
+   return (Pro8_SetSlot(b->handle, b->anySlot));
+}
+
+
+/*---------------------------------------------------------------------------
+  Load thread - telemetry snapshots of all slots until stopped
+---------------------------------------------------------------------------*/
+void *load_thread(void *data)
+{
+   load_t         *load = (load_t*)data;
+   Pro8_tSample   samples[64];
+   ViInt32        count;
+
+   while(!load->stop)
+   {
+      Pro8_TelemetrySnapshot(load->handle, PRO8_CHANNEL_ALL, 64, samples, &count);
+      __sync_fetch_and_add(&load->calls, 1);
+   }
+   return NULL;
+}
+
+
+/*---------------------------------------------------------------------------
+  Setups - the active slot is part of each call, load threads move it
+---------------------------------------------------------------------------*/
+ViStatus setup_ld(bench_t *b)
+{
+   ViStatus err;
+
+   err = Pro8_SetSlot(b->handle, b->ldSlot);
+   if(!err) err = Pro8_LdcSetLdCurrent(b->handle, 0.01);
+   return (err);
+}
+
+
+ViStatus setup_tec(bench_t *b)
+{
+   ViStatus err;
+
+   err = Pro8_SetSlot(b->handle, b->tecSlot);
+   if(!err) err = Pro8_TecSetPtOutput(b->handle, 1);
+   return (err);
+}
+
+
+ViStatus setup_elch(bench_t *b)
+{
+   ViStatus err;
+
+   err = Pro8_SetSlot(b->handle, b->ldSlot);
+   if(!err) err = Pro8_LdcSetElchSetVal(b->handle, 0, 0.0, 0.05);
+   if(!err) err = Pro8_LdcSetElchMeasVal(b->handle, 2, 1);
+   if(!err) err = Pro8_ElchSetParameters(b->handle, ELCH_STEPS, 1);
+   if(!err) err = Pro8_ElchRun(b->handle, 1);
+   b->elchStep = 0;
+   return (err);
+}
+
+
+/*---------------------------------------------------------------------------
+  Calls - one timed function call each, the active slot is selected in
+  the same transaction
+---------------------------------------------------------------------------*/
+ViStatus call_set_slot(bench_t *b)
+{
+   return (Pro8_SetSlot(b->handle, (b->iteration & 1) ? b->otherSlot : b->anySlot));
+}
+
+
+ViStatus call_slot_config(bench_t *b)
+{
+   ViInt16 type[8];
+
+   return (Pro8_GetSlotConfiguration(b->handle, &type[0], VI_NULL, &type[1], VI_NULL, &type[2], VI_NULL, &type[3], VI_NULL,
+                                     &type[4], VI_NULL, &type[5], VI_NULL, &type[6], VI_NULL, &type[7], VI_NULL));
+}
+
+
+ViStatus call_slot_data(bench_t *b)
+{
+   ViStatus err;
+   ViChar   ident[256], serial[256];
+   ViInt16  type, sub;
+
+   Pro8_LockSession(b->handle);
+   err = Pro8_SetSlot(b->handle, b->anySlot);
+   if(!err) err = Pro8_SlotDataQueryEx(b->handle, &type, &sub, ident, serial, VI_NULL, VI_NULL, VI_NULL, VI_NULL, VI_NULL, VI_NULL, VI_NULL, VI_NULL, VI_NULL, VI_NULL);
+   Pro8_UnlockSession(b->handle);
+   return (err);
+}
+
+
+ViStatus call_ld_set_current(bench_t *b)
+{
+   ViStatus err;
+
+   Pro8_LockSession(b->handle);
+   err = Pro8_SetSlot(b->handle, b->ldSlot);
+   if(!err) err = Pro8_LdcSetLdCurrent(b->handle, 0.01 + 1.0e-6 * (b->iteration & 0xFF));
+   Pro8_UnlockSession(b->handle);
+   return (err);
+}
+
+
+ViStatus call_ld_get_current_set(bench_t *b)
+{
+   ViStatus err;
+   ViReal64 value;
+
+   Pro8_LockSession(b->handle);
+   err = Pro8_SetSlot(b->handle, b->ldSlot);
+   if(!err) err = Pro8_LdcGetLdCurrent(b->handle, 2, &value);
+   Pro8_UnlockSession(b->handle);
+   return (err);
+}
+
+
+ViStatus call_ld_get_current_act(bench_t *b)
+{
+   ViStatus err;
+   ViReal64 value;
+
+   Pro8_LockSession(b->handle);
+   err = Pro8_SetSlot(b->handle, b->ldSlot);
+   if(!err) err = Pro8_LdcGetLdCurrent(b->handle, 3, &value);
+   Pro8_UnlockSession(b->handle);
+   return (err);
+}
+
+
+ViStatus call_ld_get_voltage(bench_t *b)
+{
+   ViStatus err;
+   ViReal64 value;
+
+   Pro8_LockSession(b->handle);
+   err = Pro8_SetSlot(b->handle, b->ldSlot);
+   if(!err) err = Pro8_LdcGetLdVoltage(b->handle, &value);
+   Pro8_UnlockSession(b->handle);
+   return (err);
+}
+
+
+ViStatus call_tec_set_temp(bench_t *b)
+{
+   ViStatus err;
+
+   Pro8_LockSession(b->handle);
+   err = Pro8_SetSlot(b->handle, b->tecSlot);
+   if(!err) err = Pro8_TecSetTemp(b->handle, 25.0 + 0.001 * (b->iteration & 0xFF));
+   Pro8_UnlockSession(b->handle);
+   return (err);
+}
+
+
+ViStatus call_tec_get_temp_act(bench_t *b)
+{
+   ViStatus err;
+   ViReal64 value;
+
+   Pro8_LockSession(b->handle);
+   err = Pro8_SetSlot(b->handle, b->tecSlot);
+   if(!err) err = Pro8_TecGetTemp(b->handle, 3, &value);
+   Pro8_UnlockSession(b->handle);
+   return (err);
+}
+
+
+ViStatus call_tec_set_pid(bench_t *b)
+{
+   ViStatus err;
+
+   Pro8_LockSession(b->handle);
+   err = Pro8_SetSlot(b->handle, b->tecSlot);
+   if(!err) err = Pro8_TecSetPID(b->handle, 10.0 + 0.01 * (b->iteration & 0xFF), 1.0, 0.0);
+   Pro8_UnlockSession(b->handle);
+   return (err);
+}
+
+
+ViStatus call_tec_get_pid(bench_t *b)
+{
+   ViStatus err;
+   ViReal64 p, i, d;
+
+   Pro8_LockSession(b->handle);
+   err = Pro8_SetSlot(b->handle, b->tecSlot);
+   if(!err) err = Pro8_TecGetPID(b->handle, 2, &p, &i, &d);
+   Pro8_UnlockSession(b->handle);
+   return (err);
+}
+
+
+ViStatus call_elch_meas(bench_t *b)
+{
+   ViReal64 value;
+
+   // A new sweep after the last step, timed with the call it precedes
+   if(b->elchStep++ >= ELCH_STEPS)
+   {
+      Pro8_ElchRun(b->handle, 1);
+      b->elchStep = 1;
+   }
+   return (Pro8_ElchGetMeasVal(b->handle, 1, &value, VI_NULL, VI_NULL, VI_NULL, VI_NULL, VI_NULL, VI_NULL, VI_NULL));
+}
+
+
+ViStatus call_telemetry(bench_t *b)
+{
+   Pro8_tSample   samples[64];
+   ViInt32        count;
+
+   return (Pro8_TelemetrySnapshot(b->handle, PRO8_CHANNEL_ALL, 64, samples, &count));
+}
+
+
+ViStatus call_error_query(bench_t *b)
+{
+   ViInt32  code;
+   ViChar   message[256];
+
+   return (Pro8_errorQuery(b->handle, &code, message));
+}
+
+
+/*---------------------------------------------------------------------------
+  Histogram - log-linear buckets like HdrHistogram, values in ns
+---------------------------------------------------------------------------*/
+void hist_record(histogram_t *h, unsigned long long ns)
+{
+   int shift = 0, index;
+
+   while((ns >> shift) >= (2 * HIST_SUB_COUNT)) shift++;
+   index = (shift == 0) ? (int)ns : shift * HIST_SUB_COUNT + (int)(ns >> shift);
+   if(index >= HIST_BUCKETS) index = HIST_BUCKETS - 1;
+   h->count[index]++;
+   if((h->total == 0) || (ns < h->min)) h->min = ns;
+   if(ns > h->max) h->max = ns;
+   h->total++;
+   h->sum += (double)ns;
+}
+
+
+double hist_percentile(const histogram_t *h, double percentile)
+{
+   unsigned long long rank, seen = 0;
+   int                index, shift;
+   double             value;
+
+   if(h->total == 0) return 0.0;
+   rank = (unsigned long long)(percentile / 100.0 * h->total + 0.5);
+   if(rank < 1) rank = 1;
+   for(index = 0; index < HIST_BUCKETS; index++)
+   {
+      seen += h->count[index];
+      if(seen >= rank) break;
+   }
+   // Middle of the bucket, not beyond the largest value
+   if(index < 2 * HIST_SUB_COUNT) return (double)index;
+   shift = index / HIST_SUB_COUNT - 1;
+   value = (double)((unsigned long long)(index - shift * HIST_SUB_COUNT) << shift) + (double)(1ULL << shift) / 2.0;
+   return (value < (double)h->max) ? value : (double)h->max;
+}
+
+
+unsigned long long now_ns(void)
+{
+   struct timespec ts;
+
+   clock_gettime(CLOCK_MONOTONIC, &ts);
+   return (unsigned long long)ts.tv_sec * 1000000000ULL + (unsigned long long)ts.tv_nsec;
+}
+
+
+/*---------------------------------------------------------------------------
+  Print the command line options and exit
+---------------------------------------------------------------------------*/
+void usage(const char *program)
+{
+   fprintf(stderr, "Usage: %s [options]\n\n", program);
+   fprintf(stderr, "  -r resource  instrument resource, e.g. \"tcp:host:5025\" (default: simulator on a pty)\n");
+   fprintf(stderr, "  -n calls     timed calls per family (default %d)\n", DEFAULT_ITERATIONS);
+   fprintf(stderr, "  -l threads   load threads taking telemetry snapshots on the same session (0..16)\n");
+   fprintf(stderr, "  -c mode      completion mode, see Pro8_SetCompletionMode\n");
+   fprintf(stderr, "  -f name      run the families whose name contains name\n");
+   fprintf(stderr, "  -o file      write the results as JSON to file, \"-\" = stdout\n");
+   fprintf(stderr, "  -m modules   simulator modules, e.g. \"LDC,TEC,ITC\"\n");
+   fprintf(stderr, "  -s seconds   simulator service time of a command\n");
+   fprintf(stderr, "  -j seconds   simulator jitter of a message\n");
+   fprintf(stderr, "  -S services  simulator service time of single commands, e.g. \":TEMP:ACT?=0.005\"\n");
+   exit(EXIT_FAILURE);
+}
+
+
+/*---------------------------------------------------------------------------
+  Exit with error message
+---------------------------------------------------------------------------*/
+void error_exit(ViSession instrHdl, ViStatus err)
+{
+   ViChar   buf[1024];
+
+   if(err)
+   {
+      Pro8_errorMessage (instrHdl, err, buf);
+      fprintf(stderr, "ERROR: %s\n", buf);
+   }
+   if(instrHdl != VI_NULL) Pro8_close (instrHdl);
+   exit (EXIT_FAILURE);
+}
@@ -41,6 +41,7 @@
 // Set your compiler include search path to the VXIPNP\WinNt\include directory
 #include "visa.h"
 #include "PRO8.h"
+#include "pro8_ext.h"
 
 #ifdef _CVI_
    #define EXIT_SUCCESS 0
@@ -50,7 +51,7 @@
 /*===========================================================================
  Macros
 ===========================================================================*/
-#define COMM_TIMEOUT             5000    // communications timeout in ms
+#define PROBE_TIMEOUT            2.0     // deadline of an instrument probe in s
 
 
 /*===========================================================================
@@ -59,6 +60,7 @@
 void error_exit(ViSession handle, ViStatus err);
 void waitKeypress(void);
 ViStatus find_instruments(ViString findPattern, ViChar **resource);
+void _VI_FUNCH print_instrument(ViInt32 index, Pro8_tInstrument *instrument, ViAddr data);
 ViStatus get_device_id(ViSession handle);
 ViStatus get_slot_config(ViSession instrHdl);
 
@@ -169,99 +171,56 @@ ViStatus get_slot_config(ViSession instrHdl)
 
 
 /*---------------------------------------------------------------------------
-  Find Instruments
+  Find Instruments - all instruments are probed at the same time
 ---------------------------------------------------------------------------*/
 ViStatus find_instruments(ViString findPattern, ViChar **resource)
 {
-   ViStatus       err;
-   ViSession      resMgr, instr;
-   ViFindList     findList;
-   ViUInt32       findCnt, cnt;
-   ViChar         *rscBuf, *rscPtr;
-   static ViChar  rscStr[VI_FIND_BUFLEN];
-   ViChar         name[256], sernr[256];
-   int            i, done;
+   ViStatus                err;
+   static Pro8_tInstrument inventory[PRO8_FIND_MAX_INSTRUMENTS];
+   ViInt32                 findCnt, cnt;
+   int                     i, done;
 
    printf("Scanning for instruments ...\n");
 
-   if((err = viOpenDefaultRM(&resMgr))) return(err);
-   switch((err = viFindRsrc(resMgr, findPattern, &findList, &findCnt, rscStr)))
-   {
-      case VI_SUCCESS:
-         break;
-
-      case VI_ERROR_RSRC_NFOUND:
-         viClose(resMgr);
-         printf("No matching instruments found\n\n");
-         return (err);
+   // Results are printed as they arrive
+   err = Pro8_FindInstruments(findPattern, PROBE_TIMEOUT, print_instrument, VI_NULL, PRO8_FIND_MAX_INSTRUMENTS, inventory, &findCnt);
+   if(err < 0) return (err);
 
-      default:
-         viClose(resMgr);
-         return (err);
+   if(err == VI_SUCCESS_MAX_CNT)
+   {
+      // More instruments found than probed - offer the probed ones
+      printf("Found %d instruments, probed the first %d\n", findCnt, PRO8_FIND_MAX_INSTRUMENTS);
+      findCnt = PRO8_FIND_MAX_INSTRUMENTS;
    }
 
-   if(findCnt < 2)
+   if(findCnt == 0)
    {
-      // Found only one matching instrument - return this
-      *resource = rscStr;
-      viClose(findList);
-      viClose(resMgr);
+      printf("No matching instruments found\n\n");
+      *resource = VI_NULL;
       return (VI_SUCCESS);
    }
 
-   // Found multiple instruments - get resource strings of all instruments into buffer
-   if((rscBuf = malloc(findCnt * VI_FIND_BUFLEN)) == NULL) return (VI_ERROR_SYSTEM_ERROR);
-   rscPtr = rscBuf;
-   strncpy(rscBuf, rscStr, VI_FIND_BUFLEN); // copy first found instrument resource string
-   rscPtr += VI_FIND_BUFLEN;
-
-   for(cnt = 1; cnt < findCnt; cnt++)
+   if(findCnt < 2)
    {
-      if((err = viFindNext (findList, rscPtr)))
-      {
-         free(rscBuf);
-         return(err);
-      }
-      rscPtr += VI_FIND_BUFLEN;
+      // Found only one matching instrument - return this
+      *resource = inventory[0].resource;
+      return (VI_SUCCESS);
    }
-   viClose(findList);
 
    // Display selection
    done = 0;
    do
    {
-      printf("Found %d matching instruments:\n\n", findCnt);
-      rscPtr = rscBuf;
-
-      for(cnt = 0; cnt < findCnt; cnt++)
-      {
-         // Open resource
-         if((err = viOpen (resMgr, rscPtr, VI_NULL, COMM_TIMEOUT, &instr)) != 0)
-         {
-            viClose(resMgr);
-            free(rscBuf);
-            return(err);
-
-         }
-         // Get attribute data
-         viGetAttribute(instr,VI_ATTR_MODEL_NAME,      name);
-         viGetAttribute(instr,VI_ATTR_USB_SERIAL_NUM,  sernr);
-         // Closing
-         viClose(instr);
-
-         // Print out
-         printf("% d: %s \tS/N:%s\n", cnt+1, name, sernr);
-         rscPtr += VI_FIND_BUFLEN;
-      }
-
       printf("\nPlease select: ");
       while((i = getchar()) == EOF);
       i -= '0';
       fflush(stdin);
       printf("\n");
-      if((i < 1) || (i > cnt))
+      if((i < 1) || (i > findCnt))
       {
          printf("Invalid selection\n\n");
+         printf("Found %d matching instruments:\n\n", findCnt);
+         for(cnt = 0; cnt < findCnt; cnt++) print_instrument(cnt, &inventory[cnt], VI_NULL);
       }
       else
       {
@@ -270,17 +229,31 @@ ViStatus find_instruments(ViString findPattern, ViChar **resource)
    }
    while(!done);
 
-   // Copy resource string to static buffer
-   strncpy(rscStr, rscBuf + ((i-1) * VI_FIND_BUFLEN), VI_FIND_BUFLEN);
-   *resource = rscStr;
-
-   // Cleanup
-   viClose(resMgr);
-   free(rscBuf);
+   *resource = inventory[i-1].resource;
    return (VI_SUCCESS);
 }
 
 
+/*---------------------------------------------------------------------------
+  Print out a found instrument
+---------------------------------------------------------------------------*/
+void _VI_FUNCH print_instrument(ViInt32 index, Pro8_tInstrument *instrument, ViAddr data)
+{
+   int i, modules = 0;
+
+   if(instrument->status < 0)
+   {
+      printf("% d: %s \tnot responding (%.1f s)\n", index+1, instrument->resource, instrument->time);
+      return;
+   }
+   for(i = 0; i < PRO8_NUM_SLOTS; i++)
+   {
+      if(instrument->type[i] != 0) modules++;
+   }
+   printf("% d: %s \tS/N:%s \t%d modules (%.1f s)\n", index+1, instrument->model, instrument->serial, modules, instrument->time);
+}
+
+
 /*---------------------------------------------------------------------------
   Exit with error message
 ---------------------------------------------------------------------------*/
@@ -0,0 +1,1131 @@
+/****************************************************************************
+
+   Thorlabs PRO800/PRO8000 SCPI Simulator
+
+   Source file    pro8sim.c
+
+   Date:          Oct-16-2026
+   Software-Nr:   N/A
+   Version:       1.0
+   Copyright:     Copyright(c) 2010, Thorlabs GmbH (www.thorlabs.com)
+
+   Disclaimer:
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+
+
+   NOTE: The simulator keeps one mainframe. A program message is executed
+         after the service time of the previous one has passed. A message
+         without queries returns at once and the FIN bit stays cleared
+         for its service time, a message with queries is answered after
+         its service time. *STB? alone is answered at once, like a serial
+         poll. As on the instrument, a query that fails is not answered.
+
+****************************************************************************/
+
+#define _GNU_SOURCE
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <strings.h>
+#include <ctype.h>
+#include <math.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <termios.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+
+#include "pro8sim.h"
+
+/*===========================================================================
+ Macros
+===========================================================================*/
+#define SIM_MAX_PARAMS           64      // parameters kept per slot
+#define SIM_TEXT_SIZE            32      // longest text parameter
+#define SIM_MAX_ERRORS           30      // size of the error queue
+#define SIM_AMBIENT              25.0    // temperature of a TEC that is off in C
+
+#define SIM_STB_FIN              0x01    // status byte bits
+#define SIM_STB_EAV              0x04
+#define SIM_STB_RQS              0x40
+
+#define SIM_LD                   0x01    // module classes
+#define SIM_TEC                  0x02
+#define SIM_PDA                  0x04
+
+#define SIM_TYPE_LDC             191     // module type codes of :CONFIG:PLUG?
+#define SIM_TYPE_MLC             47
+#define SIM_TYPE_TEC             223
+#define SIM_TYPE_ITC             159
+#define SIM_TYPE_PDA             107
+
+#define SIM_ERR_UNKNOWN_COMMAND  100     // instrument error codes
+#define SIM_ERR_NUMERIC          102
+#define SIM_ERR_MISSING          104
+#define SIM_ERR_EMPTY_SLOT       107
+#define SIM_ERR_NOT_SETTABLE     108
+#define SIM_ERR_WRONG_PARAMETER  111
+#define SIM_ERR_OVERFLOW         190
+#define SIM_ERR_RANGE            200
+#define SIM_ERR_ELCH_SET         310
+#define SIM_ERR_ELCH_READ        311
+#define SIM_ERR_TOO_MANY         400
+
+
+/*===========================================================================
+ Types
+===========================================================================*/
+typedef struct
+{
+   char     name[SIM_HEADER_SIZE];       // header without suffix, e.g. "ILD" or "LASER"
+   double   set, min, max;
+   double   start, stop;                 // ELCH start and stop values
+   int      sweep;                       // start and stop were set
+   int      meas;                        // ELCH measurement position, 0 = none
+   char     text[SIM_TEXT_SIZE];         // value of a text parameter, e.g. "ON"
+} sim_param_t;
+
+typedef struct
+{
+   int            type, sub;
+   int            count;
+   sim_param_t    param[SIM_MAX_PARAMS];
+   double         temp;                  // actual temperature in C
+   double         tempTime;              // time of the temperature
+} sim_slot_t;
+
+struct sim
+{
+   sim_config_t      cfg;
+   pthread_mutex_t   lock;
+   sim_slot_t        slot[SIM_NUM_SLOTS];
+   int               active;             // active slot 1..8
+   int               valueMode;          // :SYST:ANSW VALUE
+   int               sre;                // service request enable register
+   int               errors[SIM_MAX_ERRORS];
+   int               errorCount;
+   int               elchSteps, elchMeas;
+   int               elchStep;           // next step, -1 = not running
+   double            busyUntil;          // end of the service time of the last message
+   unsigned          random;
+   unsigned long long received, sent;    // bytes read and written by the servers
+   int               ptySlave;           // slave kept open so the master never reads EIO
+};
+
+typedef struct
+{
+   int      classes;
+   char     *name;
+   double   min, max, set;
+} sim_limit_t;
+
+typedef struct
+{
+   sim_t    *sim;
+   int      fd;
+} sim_conn_t;
+
+
+/*===========================================================================
+ Tables
+===========================================================================*/
+static const sim_limit_t sim_limits[] =
+{
+   {SIM_LD,    "ILD",       0.0,     0.2,     0.0     },
+   {SIM_LD,    "IMD",       0.0,     2.0e-3,  0.0     },
+   {SIM_LD,    "POPT",      0.0,     0.05,    0.0     },
+   {SIM_LD,    "LIMC",      0.0,     0.2,     0.1     },
+   {SIM_LD,    "LIMM",      0.0,     2.0e-3,  1.0e-3  },
+   {SIM_LD,    "LIMP",      0.0,     0.05,    0.02    },
+   {SIM_LD,    "CALPD",     0.0,     1000.0,  1.0     },
+   {SIM_TEC,   "TEMP",      -20.0,   80.0,    25.0    },
+   {SIM_TEC,   "RESI",      100.0,   1.0e6,   1.0e4   },
+   {SIM_TEC,   "LIMT",      0.0,     2.0,     1.0     },
+   {SIM_TEC,   "TWIN",      0.01,    10.0,    1.0     },
+   {SIM_TEC,   "RWIN",      1.0,     1.0e5,   1.0e3   },
+   {SIM_TEC,   "SHAREP",    0.0,     100.0,   10.0    },
+   {SIM_TEC,   "SHAREI",    0.0,     100.0,   1.0     },
+   {SIM_TEC,   "SHARED",    0.0,     100.0,   0.0     },
+   {SIM_TEC,   "CALTB",     0.0,     1.0e4,   3988.0  },
+   {SIM_TEC,   "CALTR",     0.0,     1.0e6,   1.0e4   },
+   {SIM_TEC,   "CALTT",     -50.0,   150.0,   25.0    },
+   {SIM_TEC,   "CALTC1",    -1.0,    1.0,     1.1292e-3},
+   {SIM_TEC,   "CALTC2",    -1.0,    1.0,     2.3411e-4},
+   {SIM_TEC,   "CALTC3",    -1.0,    1.0,     8.7755e-8},
+   {SIM_PDA,   "LAMBDA",    400.0,   1100.0,  850.0   },
+   {SIM_PDA,   "P_W",       0.0,     0.01,    0.0     },
+   {SIM_PDA,   "P_DBM",     -60.0,   10.0,    -30.0   },
+   {SIM_PDA,   "VBIAS",     0.0,     10.0,    0.0     },
+};
+
+static const char *sim_texts[][2] =
+{
+   {"MODE", "CC"}, {"LDPOL", "CG"}, {"PDPOL", "CG"}, {"SENS", "TH"}, {"LFMOD:TYPE", "SINE"},
+   {"TPSLOT", "1"}, {"OSW", "0"}, {"RANGE", "0"}, {"PORT", "1"},
+};
+
+static const struct { int code; char *text; } sim_errorTexts[] =
+{
+   {SIM_ERR_UNKNOWN_COMMAND, "Unknown command"},
+   {SIM_ERR_NUMERIC,         "Invalid numeric parameter"},
+   {SIM_ERR_MISSING,         "Missing parameter"},
+   {SIM_ERR_EMPTY_SLOT,      "Empty slot"},
+   {SIM_ERR_NOT_SETTABLE,    "Parameter can not be set"},
+   {SIM_ERR_WRONG_PARAMETER, "Wrong parameter"},
+   {SIM_ERR_OVERFLOW,        "Parser buffer overflow"},
+   {SIM_ERR_RANGE,           "Data out of range"},
+   {SIM_ERR_ELCH_SET,        "ELCH set value initialisation not complete"},
+   {SIM_ERR_ELCH_READ,       "ELCH read value(s) initialisation not complete"},
+   {SIM_ERR_TOO_MANY,        "Too many errors"},
+};
+
+
+/*===========================================================================
+ Prototypes
+===========================================================================*/
+static double       sim_now(void);
+static void         sim_sleep_until(double t);
+static double       sim_random(sim_t *sim);
+static int          sim_classes(int type);
+static void         sim_reset(sim_t *sim);
+static void         sim_error(sim_t *sim, int code);
+static sim_param_t *sim_param(sim_t *sim, sim_slot_t *slot, const char *name);
+static double       sim_set(sim_t *sim, sim_slot_t *slot, const char *name);
+static int          sim_is_on(sim_t *sim, sim_slot_t *slot, const char *name);
+static void         sim_update_temp(sim_t *sim, sim_slot_t *slot, double now);
+static double       sim_actual(sim_t *sim, sim_slot_t *slot, const char *name);
+static double       sim_service_time(sim_t *sim, const char *command);
+static int          sim_execute(sim_t *sim, char *header, char *param, char *answer, int size);
+static int          sim_slot_command(sim_t *sim, char *header, int query, char *param, char *answer, int size);
+static int          sim_elch_trigger(sim_t *sim, char *answer, int size);
+static void        *sim_fd_thread(void *data);
+
+
+/*===========================================================================
+ Configuration
+===========================================================================*/
+/*---------------------------------------------------------------------------
+  Default configuration - LDC, TEC and ITC in slots 1 to 3, 1 ms service
+  time with 100 us jitter
+---------------------------------------------------------------------------*/
+void sim_default_config(sim_config_t *cfg)
+{
+   memset(cfg, 0, sizeof(sim_config_t));
+   cfg->type[0]     = SIM_TYPE_LDC;
+   cfg->type[1]     = SIM_TYPE_TEC;
+   cfg->type[2]     = SIM_TYPE_ITC;
+   cfg->serviceTime = 1.0e-3;
+   cfg->jitter      = 1.0e-4;
+   cfg->tau         = 5.0;
+   cfg->noise       = 1.0e-3;
+   cfg->seed        = 1;
+}
+
+
+/*---------------------------------------------------------------------------
+  Module population, e.g. "LDC,TEC,-,ITC,PDA" or "191/0,223/0" - one entry
+  per slot from slot 1, "-" or an empty entry is an empty slot
+---------------------------------------------------------------------------*/
+int sim_parse_modules(sim_config_t *cfg, const char *spec)
+{
+   static const struct { char *name; int type; } names[] =
+   {
+      {"LDC", SIM_TYPE_LDC}, {"MLC", SIM_TYPE_MLC}, {"TEC", SIM_TYPE_TEC}, {"ITC", SIM_TYPE_ITC}, {"PDA", SIM_TYPE_PDA},
+   };
+   char        item[SIM_HEADER_SIZE];
+   const char  *p = spec;
+   int         slot, len, i, type, sub;
+
+   for(slot = 0; slot < SIM_NUM_SLOTS; slot++) cfg->type[slot] = cfg->sub[slot] = 0;
+   for(slot = 0; *p; slot++)
+   {
+      if(slot >= SIM_NUM_SLOTS) return -1;
+      len = (int)strcspn(p, ",");
+      if(len >= SIM_HEADER_SIZE) return -1;
+      memcpy(item, p, len);
+      item[len] = '\0';
+      p += len;
+      if(*p == ',') p++;
+      // Empty slot
+      if((item[0] == '\0') || (strcmp(item, "-") == 0)) continue;
+      // Module name or type code
+      type = sub = -1;
+      for(i = 0; i < (int)(sizeof(names) / sizeof(names[0])); i++)
+      {
+         if(strcasecmp(item, names[i].name) == 0) type = names[i].type, sub = 0;
+      }
+      if((type < 0) && ((sscanf(item, "%d/%d", &type, &sub) < 1) || (type <= 0))) return -1;
+      if(sub < 0) sub = 0;
+      cfg->type[slot] = type;
+      cfg->sub[slot]  = sub;
+   }
+   return 0;
+}
+
+
+/*---------------------------------------------------------------------------
+  Service time of single commands, e.g. ":ELCH:RUN=0.2,:TEMP:ACT?=0.005"
+  - the longest header prefix matching a command applies
+---------------------------------------------------------------------------*/
+int sim_parse_service(sim_config_t *cfg, const char *spec)
+{
+   char        item[SIM_HEADER_SIZE + 32], *equal, *end;
+   const char  *p = spec;
+   int         len;
+   double      time;
+
+   while(*p)
+   {
+      len = (int)strcspn(p, ",");
+      if(len >= (int)sizeof(item)) return -1;
+      memcpy(item, p, len);
+      item[len] = '\0';
+      p += len;
+      if(*p == ',') p++;
+      if(item[0] == '\0') continue;
+      // prefix=time
+      if((equal = strrchr(item, '=')) == NULL) return -1;
+      *equal = '\0';
+      time = strtod(equal + 1, &end);
+      if((*end != '\0') || (time < 0.0) || (item[0] == '\0') || (strlen(item) >= SIM_HEADER_SIZE)) return -1;
+      if(cfg->serviceCount >= SIM_MAX_SERVICE) return -1;
+      strcpy(cfg->service[cfg->serviceCount].prefix, item);
+      cfg->service[cfg->serviceCount].time = time;
+      cfg->serviceCount++;
+   }
+   return 0;
+}
+
+
+/*===========================================================================
+ Simulator
+===========================================================================*/
+sim_t *sim_create(const sim_config_t *cfg)
+{
+   sim_t *sim;
+   int   i;
+
+   if((sim = (sim_t*)calloc(1, sizeof(sim_t))) == NULL) return NULL;
+   sim->cfg = *cfg;
+   if(sim->cfg.tau <= 0.0) sim->cfg.tau = 1.0e-3;
+   pthread_mutex_init(&sim->lock, NULL);
+   for(i = 0; i < SIM_NUM_SLOTS; i++)
+   {
+      sim->slot[i].type = cfg->type[i];
+      sim->slot[i].sub  = cfg->sub[i];
+   }
+   sim->random   = cfg->seed;
+   sim->ptySlave = -1;
+   sim_reset(sim);
+   return sim;
+}
+
+
+void sim_destroy(sim_t *sim)
+{
+   if(!sim) return;
+   if(sim->ptySlave >= 0) close(sim->ptySlave);
+   pthread_mutex_destroy(&sim->lock);
+   free(sim);
+}
+
+
+/*---------------------------------------------------------------------------
+  Program message - executes message (without terminator) and returns the
+  length of the response in response, 0 if there is none
+---------------------------------------------------------------------------*/
+int sim_message(sim_t *sim, const char *message, char *response, int size)
+{
+   char     line[SIM_LINE_SIZE], answer[SIM_LINE_SIZE];
+   char     *command, *next, *param, *p;
+   int      length = 0, queries = 0, quoted, stb;
+   double   now, service = 0.0;
+
+   if(size < 1) return -1;
+   response[0] = '\0';
+   while(isspace((unsigned char)*message)) message++;
+   if(strlen(message) >= sizeof(line))
+   {
+      pthread_mutex_lock(&sim->lock);
+      sim_error(sim, SIM_ERR_OVERFLOW);
+      pthread_mutex_unlock(&sim->lock);
+      return 0;
+   }
+   strcpy(line, message);
+   for(p = line + strlen(line); (p > line) && isspace((unsigned char)p[-1]); ) *--p = '\0';
+
+   pthread_mutex_lock(&sim->lock);
+   now = sim_now();
+   // Serial poll - answered while a message is executed
+   if(strcasecmp(line, "*STB?") == 0)
+   {
+      stb = (now >= sim->busyUntil) ? SIM_STB_FIN : 0;
+      if(sim->errorCount) stb |= SIM_STB_EAV;
+      if(stb & sim->sre)  stb |= SIM_STB_RQS;
+      length = snprintf(response, size, "%d", stb);
+      pthread_mutex_unlock(&sim->lock);
+      return (length < size) ? length : size - 1;
+   }
+   // The previous message is still executed
+   if(now < sim->busyUntil)
+   {
+      sim_sleep_until(sim->busyUntil);
+      now = sim->busyUntil;
+   }
+   // Compound command - ';' outside of strings separates the commands
+   for(command = line; command; command = next)
+   {
+      for(next = command, quoted = 0; *next && (quoted || (*next != ';')); next++)
+      {
+         if(*next == '"') quoted = !quoted;
+      }
+      if(*next) *next++ = '\0';
+      else      next = NULL;
+      while(isspace((unsigned char)*command)) command++;
+      if(*command == '\0') continue;
+      service += sim_service_time(sim, command);
+      // Header - parameter
+      param = command + strcspn(command, " \t");
+      if(*param) *param++ = '\0';
+      while(isspace((unsigned char)*param)) param++;
+      answer[0] = '\0';
+      if(sim_execute(sim, command, param, answer, sizeof(answer)) < 0) continue;
+      if(command[strlen(command) - 1] != '?') continue;
+      // Answer
+      queries++;
+      length += snprintf(&response[length], size - length, "%s%s", (queries > 1) ? ";" : "", answer);
+      if(length >= size) length = size - 1;
+   }
+   // Service time
+   service += sim->cfg.jitter * (2.0 * sim_random(sim) - 1.0);
+   if(service < 0.0) service = 0.0;
+   sim->busyUntil = now + service;
+   if(sim->cfg.verbose) fprintf(stderr, "> %s\n%s%s%s", message, length ? "< " : "", response, length ? "\n" : "");
+   if(length) sim_sleep_until(sim->busyUntil);
+   pthread_mutex_unlock(&sim->lock);
+   return length;
+}
+
+
+/*===========================================================================
+ Servers
+===========================================================================*/
+/*---------------------------------------------------------------------------
+  Serve a file descriptor - executes the messages terminated by '\n' read
+  from fd and writes the responses terminated by '\n', until end of file
+---------------------------------------------------------------------------*/
+int sim_serve_fd(sim_t *sim, int fd)
+{
+   char     rx[SIM_LINE_SIZE], response[SIM_LINE_SIZE + 1];
+   int      length = 0, overflow = 0, n, sent, w;
+   char     *start, *end;
+
+   for(;;)
+   {
+      do n = (int)read(fd, &rx[length], sizeof(rx) - length); while((n < 0) && (errno == EINTR));
+      if(n == 0) return 0;
+      if(n < 0)  return (errno == EIO) ? 0 : -1;
+      length += n;
+      pthread_mutex_lock(&sim->lock);
+      sim->received += n;
+      pthread_mutex_unlock(&sim->lock);
+      // Messages
+      start = rx;
+      while((end = memchr(start, '\n', length - (start - rx))) != NULL)
+      {
+         *end = '\0';
+         if(overflow)
+         {
+            overflow = 0;
+            start = end + 1;
+            continue;
+         }
+         if((end > start) && (end[-1] == '\r')) end[-1] = '\0';
+         if((n = sim_message(sim, start, response, SIM_LINE_SIZE)) > 0)
+         {
+            response[n++] = '\n';
+            for(sent = 0; sent < n; sent += w)
+            {
+               do w = (int)write(fd, &response[sent], n - sent); while((w < 0) && (errno == EINTR));
+               if(w < 0) return -1;
+            }
+            pthread_mutex_lock(&sim->lock);
+            sim->sent += n;
+            pthread_mutex_unlock(&sim->lock);
+         }
+         start = end + 1;
+      }
+      // Rest of a message - a message longer than the buffer is dropped
+      length -= (int)(start - rx);
+      memmove(rx, start, length);
+      if(length == (int)sizeof(rx))
+      {
+         pthread_mutex_lock(&sim->lock);
+         sim_error(sim, SIM_ERR_OVERFLOW);
+         pthread_mutex_unlock(&sim->lock);
+         overflow = 1;
+         length   = 0;
+      }
+   }
+}
+
+
+/*---------------------------------------------------------------------------
+  Traffic - bytes read and written by sim_serve_fd since sim_create
+---------------------------------------------------------------------------*/
+void sim_get_traffic(sim_t *sim, unsigned long long *received, unsigned long long *sent)
+{
+   pthread_mutex_lock(&sim->lock);
+   if(received) *received = sim->received;
+   if(sent)     *sent     = sim->sent;
+   pthread_mutex_unlock(&sim->lock);
+}
+
+
+/*---------------------------------------------------------------------------
+  Start a pseudo terminal served by a thread - resource returns the driver
+  resource name, e.g. "tty:/dev/pts/3"
+---------------------------------------------------------------------------*/
+int sim_start_pty(sim_t *sim, char *resource, int size)
+{
+   struct termios tio;
+   sim_conn_t     *conn;
+   pthread_t      thread;
+   char           *name;
+   int            master;
+
+   if((master = posix_openpt(O_RDWR | O_NOCTTY)) < 0) return -1;
+   if((grantpt(master) < 0) || (unlockpt(master) < 0) || ((name = ptsname(master)) == NULL)) goto failed;
+   if(snprintf(resource, size, "tty:%s", name) >= size) goto failed;
+   // Raw slave - it stays open, so the master does not see the driver close it
+   if((sim->ptySlave = open(name, O_RDWR | O_NOCTTY)) < 0) goto failed;
+   if(tcgetattr(sim->ptySlave, &tio) == 0)
+   {
+      cfmakeraw(&tio);
+      tcsetattr(sim->ptySlave, TCSANOW, &tio);
+   }
+   // Server thread
+   if((conn = (sim_conn_t*)malloc(sizeof(sim_conn_t))) == NULL) goto failed;
+   conn->sim = sim;
+   conn->fd  = master;
+   if(pthread_create(&thread, NULL, sim_fd_thread, conn) != 0)
+   {
+      free(conn);
+      goto failed;
+   }
+   pthread_detach(thread);
+   return 0;
+
+failed:
+   if(sim->ptySlave >= 0) close(sim->ptySlave);
+   sim->ptySlave = -1;
+   close(master);
+   return -1;
+}
+
+
+/*---------------------------------------------------------------------------
+  Serve a TCP port - one thread per connection, all connections share the
+  mainframe. If once is set the first connection is served by the calling
+  thread and the function returns when it is closed.
+---------------------------------------------------------------------------*/
+int sim_serve_tcp(sim_t *sim, int port, int once)
+{
+   struct sockaddr_in   addr;
+   sim_conn_t           *conn;
+   pthread_t            thread;
+   int                  server, fd, one = 1, result;
+
+   if((server = socket(AF_INET, SOCK_STREAM, 0)) < 0) return -1;
+   setsockopt(server, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+   memset(&addr, 0, sizeof(addr));
+   addr.sin_family      = AF_INET;
+   addr.sin_addr.s_addr = htonl(INADDR_ANY);
+   addr.sin_port        = htons((unsigned short)port);
+   if((bind(server, (struct sockaddr*)&addr, sizeof(addr)) < 0) || (listen(server, 8) < 0))
+   {
+      close(server);
+      return -1;
+   }
+   for(;;)
+   {
+      if((fd = accept(server, NULL, NULL)) < 0)
+      {
+         if(errno == EINTR) continue;
+         close(server);
+         return -1;
+      }
+      setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+      if(sim->cfg.verbose) fprintf(stderr, "Connection %d opened\n", fd);
+      if(once)
+      {
+         close(server);
+         result = sim_serve_fd(sim, fd);
+         close(fd);
+         return result;
+      }
+      if((conn = (sim_conn_t*)malloc(sizeof(sim_conn_t))) == NULL)
+      {
+         close(fd);
+         continue;
+      }
+      conn->sim = sim;
+      conn->fd  = fd;
+      if(pthread_create(&thread, NULL, sim_fd_thread, conn) != 0)
+      {
+         free(conn);
+         close(fd);
+         continue;
+      }
+      pthread_detach(thread);
+   }
+}
+
+
+static void *sim_fd_thread(void *data)
+{
+   sim_conn_t  conn = *(sim_conn_t*)data;
+
+   free(data);
+   sim_serve_fd(conn.sim, conn.fd);
+   if(conn.sim->cfg.verbose) fprintf(stderr, "Connection %d closed\n", conn.fd);
+   close(conn.fd);
+   return NULL;
+}
+
+
+/*===========================================================================
+ Commands
+===========================================================================*/
+/*---------------------------------------------------------------------------
+  Execute a command - header is the command header as sent, param its
+  parameter. The response of a query is written to answer. Returns -1 if
+  an error was put into the error queue.
+---------------------------------------------------------------------------*/
+static int sim_execute(sim_t *sim, char *header, char *param, char *answer, int size)
+{
+   char        name[SIM_HEADER_SIZE], *head;
+   sim_slot_t  *slot;
+   int         i, n, query, value;
+
+   // Normalized header - upper case, without ':', '*' and '?'
+   head = ((*header == ':') || (*header == '*')) ? header + 1 : header;
+   for(i = 0; head[i] && (i < SIM_HEADER_SIZE - 1); i++) name[i] = (char)toupper((unsigned char)head[i]);
+   name[i] = '\0';
+   if(head[i])
+   {
+      sim_error(sim, SIM_ERR_UNKNOWN_COMMAND);
+      return -1;
+   }
+   query = (i > 0) && (name[i - 1] == '?');
+   if(query) name[--i] = '\0';
+   if((name[0] == '\0') || (query && *param))
+   {
+      sim_error(sim, SIM_ERR_UNKNOWN_COMMAND);
+      return -1;
+   }
+   // Header of full answers
+   if(query && !sim->valueMode && (*header != '*') && strcmp(name, "SYST:ERR"))
+   {
+      n = snprintf(answer, size, "%.*s ", (int)strlen(header) - 1, header);
+      answer += n;
+      size   -= n;
+   }
+   slot = &sim->slot[sim->active - 1];
+
+   // Common commands
+   if(*header == '*')
+   {
+      if     (strcmp(name, "IDN") == 0 && query)    snprintf(answer, size, "THORLABS,PRO8000,M%08u,3.41", sim->cfg.seed);
+      else if(strcmp(name, "STB") == 0 && query)    snprintf(answer, size, "%d", ((sim->errorCount) ? SIM_STB_EAV : 0) | SIM_STB_FIN);
+      else if(strcmp(name, "TST") == 0 && query)    snprintf(answer, size, "0");
+      else if(strcmp(name, "OPC") == 0 && query)    snprintf(answer, size, "1");
+      else if(strcmp(name, "SRE") == 0 && query)    snprintf(answer, size, "%d", sim->sre);
+      else if(strcmp(name, "SRE") == 0)             sim->sre = atoi(param) & 0xFF;
+      else if(strcmp(name, "CLS") == 0 && !query)   sim->errorCount = 0;
+      else if(strcmp(name, "RST") == 0 && !query)   sim_reset(sim);
+      else if(strcmp(name, "RCL") == 0 && !query)   ;
+      else if(strcmp(name, "OPC") == 0 && !query)   ;
+      else
+      {
+         sim_error(sim, SIM_ERR_UNKNOWN_COMMAND);
+         return -1;
+      }
+      return 0;
+   }
+
+   // Mainframe commands
+   if(strcmp(name, "SLOT") == 0)
+   {
+      if(query) snprintf(answer, size, "%d", sim->active);
+      else
+      {
+         if(*param == '\0')                           { sim_error(sim, SIM_ERR_MISSING); return -1; }
+         value = atoi(param);
+         if((value < 1) || (value > SIM_NUM_SLOTS))   { sim_error(sim, SIM_ERR_RANGE);   return -1; }
+         sim->active = value;
+      }
+      return 0;
+   }
+   if(strcmp(name, "CONFIG:PLUG") == 0)
+   {
+      if(!query) { sim_error(sim, SIM_ERR_NOT_SETTABLE); return -1; }
+      for(i = n = 0; i < SIM_NUM_SLOTS; i++) n += snprintf(&answer[n], (size > n) ? size - n : 0, "%s%d,%d", i ? "," : "", sim->slot[i].type, sim->slot[i].sub);
+      return 0;
+   }
+   if(strcmp(name, "SYST:ERR") == 0)
+   {
+      if(!query) { sim_error(sim, SIM_ERR_NOT_SETTABLE); return -1; }
+      if(sim->errorCount == 0)
+      {
+         snprintf(answer, size, "0, \"No error\"");
+         return 0;
+      }
+      value = sim->errors[0];
+      memmove(&sim->errors[0], &sim->errors[1], --sim->errorCount * sizeof(int));
+      for(i = 0; (i < (int)(sizeof(sim_errorTexts) / sizeof(sim_errorTexts[0]))) && (sim_errorTexts[i].code != value); i++);
+      snprintf(answer, size, "%d, \"%s\"", value, (i < (int)(sizeof(sim_errorTexts) / sizeof(sim_errorTexts[0]))) ? sim_errorTexts[i].text : "Error");
+      return 0;
+   }
+   if(strcmp(name, "SYST:ANSW") == 0)
+   {
+      if(query)                            snprintf(answer, size, "%s", sim->valueMode ? "VALUE" : "FULL");
+      else if(strcasecmp(param, "FULL") == 0)  sim->valueMode = 0;
+      else if(strcasecmp(param, "VALUE") == 0) sim->valueMode = 1;
+      else { sim_error(sim, *param ? SIM_ERR_WRONG_PARAMETER : SIM_ERR_MISSING); return -1; }
+      return 0;
+   }
+   if(strncmp(name, "STAT:", 5) == 0)
+   {
+      // Status registers - the simulator does not report device errors
+      if(query) snprintf(answer, size, "0");
+      return 0;
+   }
+   if(strncmp(name, "ELCH:", 5) == 0)
+   {
+      if(strcmp(name, "ELCH:TRIG") == 0 && query) return sim_elch_trigger(sim, answer, size);
+      if(strcmp(name, "ELCH:STEPS") == 0 || strcmp(name, "ELCH:MEAS") == 0 || strcmp(name, "ELCH:RUN") == 0)
+      {
+         int *reg = (name[5] == 'S') ? &sim->elchSteps : (name[5] == 'M') ? &sim->elchMeas : &sim->elchStep;
+
+         if(query)
+         {
+            snprintf(answer, size, "%d", (reg == &sim->elchStep) ? (sim->elchStep >= 0) : *reg);
+            return 0;
+         }
+         if(*param == '\0') { sim_error(sim, SIM_ERR_MISSING); return -1; }
+         value = atoi(param);
+         if(reg == &sim->elchStep)
+         {
+            if((value < 0) || (value > 2))     { sim_error(sim, SIM_ERR_RANGE); return -1; }
+            sim->elchStep = value ? 0 : -1;
+         }
+         else if(reg == &sim->elchSteps)
+         {
+            if((value < 2) || (value > 1001))  { sim_error(sim, SIM_ERR_RANGE); return -1; }
+            sim->elchSteps = value;
+         }
+         else
+         {
+            if((value < 1) || (value > 8))     { sim_error(sim, SIM_ERR_RANGE); return -1; }
+            sim->elchMeas = value;
+         }
+         return 0;
+      }
+      sim_error(sim, SIM_ERR_UNKNOWN_COMMAND);
+      return -1;
+   }
+
+   // Slot commands
+   if(slot->type == 0)
+   {
+      sim_error(sim, SIM_ERR_EMPTY_SLOT);
+      return -1;
+   }
+   if(strncmp(name, "TYPE:", 5) == 0)
+   {
+      if(!query)                          { sim_error(sim, SIM_ERR_NOT_SETTABLE); return -1; }
+      if     (strcmp(name, "TYPE:ID") == 0)  snprintf(answer, size, "%d", slot->type);
+      else if(strcmp(name, "TYPE:SUB") == 0) snprintf(answer, size, "%d", slot->sub);
+      else if(strcmp(name, "TYPE:SN") == 0)  snprintf(answer, size, "M%05u%03d", sim->cfg.seed, sim->active);
+      else if(strcmp(name, "TYPE:OPT") == 0) snprintf(answer, size, "0,0,0,0,0,0,0,0,0,0");
+      else if(strcmp(name, "TYPE:TXT") == 0)
+      {
+         switch(slot->type)
+         {
+            case SIM_TYPE_LDC:   snprintf(answer, size, "\"LDC8002\""); break;
+            case SIM_TYPE_MLC:   snprintf(answer, size, "\"MLC8025\""); break;
+            case SIM_TYPE_TEC:   snprintf(answer, size, "\"TED8020\""); break;
+            case SIM_TYPE_ITC:   snprintf(answer, size, "\"ITC8022\""); break;
+            case SIM_TYPE_PDA:   snprintf(answer, size, "\"PDA8000\""); break;
+            default:             snprintf(answer, size, "\"MODULE %d\"", slot->type); break;
+         }
+      }
+      else { sim_error(sim, SIM_ERR_UNKNOWN_COMMAND); return -1; }
+      return 0;
+   }
+   return sim_slot_command(sim, name, query, param, answer, size);
+}
+
+
+/*---------------------------------------------------------------------------
+  Slot command - ":X:SET", ":X:MIN?", ":X:MAX?", ":X:ACT?", ":X:START",
+  ":X:STOP" and ":X:MEAS" address the numeric parameter X of the active
+  slot, any other header is a text parameter like ":LASER ON"
+---------------------------------------------------------------------------*/
+static int sim_slot_command(sim_t *sim, char *name, int query, char *param, char *answer, int size)
+{
+   static const char *fields[] = {":SET", ":MIN", ":MAX", ":ACT", ":START", ":STOP", ":MEAS"};
+   sim_slot_t  *slot  = &sim->slot[sim->active - 1];
+   sim_param_t *p;
+   char        *end, *field = NULL;
+   double      value  = 0.0;
+   int         i, f   = -1, len = (int)strlen(name);
+
+   for(i = 0; i < (int)(sizeof(fields) / sizeof(fields[0])); i++)
+   {
+      int n = (int)strlen(fields[i]);
+
+      if((len > n) && (strcmp(&name[len - n], fields[i]) == 0))
+      {
+         f     = i;
+         field = &name[len - n];
+      }
+   }
+   if(field) *field = '\0';
+   if((p = sim_param(sim, slot, name)) == NULL)
+   {
+      sim_error(sim, SIM_ERR_UNKNOWN_COMMAND);
+      return -1;
+   }
+   // Text parameter
+   if(f < 0)
+   {
+      if(query) snprintf(answer, size, "%s", p->text);
+      else if(*param == '\0')                          { sim_error(sim, SIM_ERR_MISSING); return -1; }
+      else if(strlen(param) >= SIM_TEXT_SIZE)          { sim_error(sim, SIM_ERR_WRONG_PARAMETER); return -1; }
+      else
+      {
+         sim_update_temp(sim, slot, sim_now());
+         for(i = 0; param[i]; i++) p->text[i] = (char)toupper((unsigned char)param[i]);
+         p->text[i] = '\0';
+      }
+      return 0;
+   }
+   // Numeric parameter
+   if(query)
+   {
+      switch(f)
+      {
+         case 0:  value = p->set;   break;
+         case 1:  value = p->min;   break;
+         case 2:  value = p->max;   break;
+         case 3:  value = sim_actual(sim, slot, name); break;
+         case 4:  value = p->start; break;
+         case 5:  value = p->stop;  break;
+         case 6:  snprintf(answer, size, "%d", p->meas); return 0;
+      }
+      snprintf(answer, size, "%.6E", value);
+      return 0;
+   }
+   if((f == 1) || (f == 2) || (f == 3)) { sim_error(sim, SIM_ERR_NOT_SETTABLE); return -1; }
+   if(*param == '\0')                   { sim_error(sim, SIM_ERR_MISSING); return -1; }
+   value = strtod(param, &end);
+   while(isspace((unsigned char)*end)) end++;
+   if(*end)                             { sim_error(sim, SIM_ERR_NUMERIC); return -1; }
+   if(f == 6)
+   {
+      if((value < 0) || (value > 8))    { sim_error(sim, SIM_ERR_RANGE); return -1; }
+      p->meas = (int)value;
+      return 0;
+   }
+   if((value < p->min) || (value > p->max)) { sim_error(sim, SIM_ERR_RANGE); return -1; }
+   switch(f)
+   {
+      case 0:
+         sim_update_temp(sim, slot, sim_now());
+         p->set = value;
+         break;
+      case 4:  p->start = value; p->sweep |= 1; break;
+      case 5:  p->stop  = value; p->sweep |= 2; break;
+   }
+   return 0;
+}
+
+
+/*---------------------------------------------------------------------------
+  ELCH trigger - sets the next step of all parameters with start and stop
+  values and returns the actual values at the measurement positions
+---------------------------------------------------------------------------*/
+static int sim_elch_trigger(sim_t *sim, char *answer, int size)
+{
+   sim_param_t *p;
+   double      fraction, values[8] = {0.0};
+   int         sweeps = 0, reads = 0, s, i, n;
+
+   // Initialisation - set and read values are assigned
+   for(s = 0; s < SIM_NUM_SLOTS; s++)
+   {
+      for(i = 0; i < sim->slot[s].count; i++)
+      {
+         p = &sim->slot[s].param[i];
+         if(p->sweep == 3) sweeps++;
+         if((p->meas >= 1) && (p->meas <= sim->elchMeas)) reads++;
+      }
+   }
+   if((sim->elchStep < 0) || (sweeps == 0)) { sim_error(sim, SIM_ERR_ELCH_SET);  return -1; }
+   if(reads == 0)                           { sim_error(sim, SIM_ERR_ELCH_READ); return -1; }
+   // Step - set values first, then the actual values they cause
+   fraction = (double)sim->elchStep / (double)(sim->elchSteps - 1);
+   for(s = 0; s < SIM_NUM_SLOTS; s++)
+   {
+      sim_update_temp(sim, &sim->slot[s], sim_now());
+      for(i = 0; i < sim->slot[s].count; i++)
+      {
+         p = &sim->slot[s].param[i];
+         if(p->sweep == 3) p->set = p->start + fraction * (p->stop - p->start);
+      }
+   }
+   for(s = 0; s < SIM_NUM_SLOTS; s++)
+   {
+      for(i = 0; i < sim->slot[s].count; i++)
+      {
+         p = &sim->slot[s].param[i];
+         if((p->meas >= 1) && (p->meas <= sim->elchMeas)) values[p->meas - 1] = sim_actual(sim, &sim->slot[s], p->name);
+      }
+   }
+   for(i = n = 0; i < sim->elchMeas; i++) n += snprintf(&answer[n], (size > n) ? size - n : 0, "%s%.6E", i ? "," : "", values[i]);
+   if(++sim->elchStep >= sim->elchSteps) sim->elchStep = -1;
+   return 0;
+}
+
+
+/*===========================================================================
+ Model
+===========================================================================*/
+/*---------------------------------------------------------------------------
+  Parameter of a slot - created with the defaults of the module at first
+  use, NULL if the slot has no room for it
+---------------------------------------------------------------------------*/
+static sim_param_t *sim_param(sim_t *sim, sim_slot_t *slot, const char *name)
+{
+   sim_param_t *p;
+   int         i;
+
+   for(i = 0; i < slot->count; i++)
+   {
+      if(strcmp(slot->param[i].name, name) == 0) return &slot->param[i];
+   }
+   if((slot->count >= SIM_MAX_PARAMS) || (strlen(name) >= SIM_HEADER_SIZE) || (name[0] == '\0')) return NULL;
+   p = &slot->param[slot->count++];
+   memset(p, 0, sizeof(sim_param_t));
+   strcpy(p->name, name);
+   // Defaults - parameters the table does not know take any value
+   p->min = -1.0e6;
+   p->max =  1.0e6;
+   for(i = 0; i < (int)(sizeof(sim_limits) / sizeof(sim_limits[0])); i++)
+   {
+      if(((sim_limits[i].classes & sim_classes(slot->type)) == 0) || strcmp(sim_limits[i].name, name)) continue;
+      p->min = sim_limits[i].min;
+      p->max = sim_limits[i].max;
+      p->set = sim_limits[i].set;
+   }
+   strcpy(p->text, "OFF");
+   for(i = 0; i < (int)(sizeof(sim_texts) / sizeof(sim_texts[0])); i++)
+   {
+      if(strcmp(sim_texts[i][0], name) == 0) strcpy(p->text, sim_texts[i][1]);
+   }
+   (void)sim;
+   return p;
+}
+
+
+static double sim_set(sim_t *sim, sim_slot_t *slot, const char *name)
+{
+   sim_param_t *p = sim_param(sim, slot, name);
+
+   return p ? p->set : 0.0;
+}
+
+
+static int sim_is_on(sim_t *sim, sim_slot_t *slot, const char *name)
+{
+   sim_param_t *p = sim_param(sim, slot, name);
+
+   return p && (strcmp(p->text, "ON") == 0);
+}
+
+
+/*---------------------------------------------------------------------------
+  Temperature - first order lag with time constant tau towards the set
+  temperature if the TEC is on, else towards the ambient temperature
+---------------------------------------------------------------------------*/
+static void sim_update_temp(sim_t *sim, sim_slot_t *slot, double now)
+{
+   double target;
+
+   if((sim_classes(slot->type) & SIM_TEC) == 0) return;
+   target = sim_is_on(sim, slot, "TEC") ? sim_set(sim, slot, "TEMP") : SIM_AMBIENT;
+   if(now > slot->tempTime) slot->temp = target + (slot->temp - target) * exp(-(now - slot->tempTime) / sim->cfg.tau);
+   slot->tempTime = now;
+}
+
+
+/*---------------------------------------------------------------------------
+  Actual value of parameter name - derived from the set values of the
+  slot, with the configured relative noise
+---------------------------------------------------------------------------*/
+static double sim_actual(sim_t *sim, sim_slot_t *slot, const char *name)
+{
+   int      classes = sim_classes(slot->type);
+   double   value, ild = 0.0, temp = SIM_AMBIENT, ite = 0.0, limit;
+
+   if(classes & SIM_LD)
+   {
+      if(sim_is_on(sim, slot, "LASER")) ild = sim_set(sim, slot, "ILD");
+   }
+   if(classes & SIM_TEC)
+   {
+      sim_update_temp(sim, slot, sim_now());
+      temp = slot->temp;
+      if(sim_is_on(sim, slot, "TEC"))
+      {
+         limit = sim_set(sim, slot, "LIMT");
+         ite   = 2.0 * (sim_set(sim, slot, "TEMP") - temp);
+         if(ite >  limit) ite =  limit;
+         if(ite < -limit) ite = -limit;
+      }
+   }
+   if     ((classes & SIM_LD)  && strcmp(name, "ILD") == 0)                              value = ild;
+   else if((classes & SIM_LD)  && strcmp(name, "IMD") == 0)                              value = 0.01 * ild;
+   else if((classes & SIM_LD)  && strcmp(name, "POPT") == 0)                             value = (ild > 0.02) ? 0.8 * (ild - 0.02) : 0.0;
+   else if((classes & SIM_LD)  && (strcmp(name, "VLD") == 0 || strcmp(name, "VFWD") == 0)) value = (ild > 0.0) ? 1.6 + 8.0 * ild : 0.0;
+   else if((classes & SIM_TEC) && strcmp(name, "TEMP") == 0)                             value = temp;
+   else if((classes & SIM_TEC) && strcmp(name, "ITE") == 0)                              value = ite;
+   else if((classes & SIM_TEC) && strcmp(name, "VTE") == 0)                              value = 1.5 * ite;
+   else if((classes & SIM_TEC) && strcmp(name, "RESI") == 0)                             value = 1.0e4 * exp(3988.0 * (1.0 / (temp + 273.15) - 1.0 / 298.15));
+   else if((classes & SIM_PDA) && strcmp(name, "IPD") == 0)                              value = 1.0e-4;
+   else if((classes & SIM_PDA) && strcmp(name, "P_W") == 0)                              value = 2.0e-4;
+   else if((classes & SIM_PDA) && strcmp(name, "P_DBM") == 0)                            value = 10.0 * log10(2.0e-4 / 1.0e-3);
+   else                                                                                  value = sim_set(sim, slot, name);
+   return value * (1.0 + sim->cfg.noise * (2.0 * sim_random(sim) - 1.0));
+}
+
+
+/*---------------------------------------------------------------------------
+  Service time of a command - the longest matching prefix or the default
+---------------------------------------------------------------------------*/
+static double sim_service_time(sim_t *sim, const char *command)
+{
+   double   time = sim->cfg.serviceTime;
+   size_t   best = 0, len;
+   int      i;
+
+   for(i = 0; i < sim->cfg.serviceCount; i++)
+   {
+      len = strlen(sim->cfg.service[i].prefix);
+      if((len > best) && (strncasecmp(command, sim->cfg.service[i].prefix, len) == 0))
+      {
+         best = len;
+         time = sim->cfg.service[i].time;
+      }
+   }
+   return time;
+}
+
+
+/*---------------------------------------------------------------------------
+  Reset - *RST and power on state
+---------------------------------------------------------------------------*/
+static void sim_reset(sim_t *sim)
+{
+   int i;
+
+   for(i = 0; i < SIM_NUM_SLOTS; i++)
+   {
+      sim->slot[i].count    = 0;
+      sim->slot[i].temp     = SIM_AMBIENT;
+      sim->slot[i].tempTime = sim_now();
+   }
+   sim->active    = 1;
+   sim->elchSteps = 2;
+   sim->elchMeas  = 1;
+   sim->elchStep  = -1;
+}
+
+
+static void sim_error(sim_t *sim, int code)
+{
+   if(sim->errorCount < SIM_MAX_ERRORS) sim->errors[sim->errorCount++] = code;
+   else                                 sim->errors[SIM_MAX_ERRORS - 1] = SIM_ERR_TOO_MANY;
+}
+
+
+static int sim_classes(int type)
+{
+   switch(type)
+   {
+      case SIM_TYPE_LDC:
+      case SIM_TYPE_MLC:   return SIM_LD;
+      case SIM_TYPE_TEC:   return SIM_TEC;
+      case SIM_TYPE_ITC:   return SIM_LD | SIM_TEC;
+      case SIM_TYPE_PDA:   return SIM_PDA;
+      default:             return 0;
+   }
+}
+
+
+/*===========================================================================
+ Helpers
+===========================================================================*/
+static double sim_now(void)
+{
+   struct timespec ts;
+
+   clock_gettime(CLOCK_MONOTONIC, &ts);
+   return (double)ts.tv_sec + (double)ts.tv_nsec * 1.0e-9;
+}
+
+
+static void sim_sleep_until(double t)
+{
+   struct timespec ts;
+
+   ts.tv_sec  = (time_t)t;
+   ts.tv_nsec = (long)((t - (double)ts.tv_sec) * 1.0e9);
+   if(ts.tv_nsec > 999999999L) ts.tv_nsec = 999999999L;
+   while(clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR);
+}
+
+
+/*---------------------------------------------------------------------------
+  Uniform random number in [0, 1) - jitter and noise repeat with the seed
+---------------------------------------------------------------------------*/
+static double sim_random(sim_t *sim)
+{
+   sim->random = sim->random * 1103515245u + 12345u;
+   return (double)((sim->random >> 8) & 0xFFFFFF) / 16777216.0;
+}
+
+
+/****************************************************************************
+  End of Source file
+****************************************************************************/
@@ -0,0 +1,96 @@
+/****************************************************************************
+
+   Thorlabs PRO800/PRO8000 SCPI Simulator
+
+   Header file    pro8sim.h
+
+   Copyright:     Copyright(c) 2010, Thorlabs GmbH (www.thorlabs.com)
+
+   Disclaimer:
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+
+
+   NOTE: The simulator answers the SCPI subset the driver uses on a
+         pseudo terminal ("tty:" resources) or a TCP socket ("tcp:"
+         resources). It needs Linux and POSIX threads.
+
+****************************************************************************/
+
+#ifndef _PRO8SIM_HEADER_
+#define _PRO8SIM_HEADER_
+
+#if defined(__cplusplus) || defined(__cplusplus__)
+extern "C" {
+#endif
+
+/*===========================================================================
+ Macros
+===========================================================================*/
+#define SIM_NUM_SLOTS            8       // slots of a PRO8000
+#define SIM_MAX_SERVICE          32      // per-command service times
+#define SIM_HEADER_SIZE          32      // longest command header
+#define SIM_LINE_SIZE            4096    // longest program message
+
+/*===========================================================================
+ Types
+===========================================================================*/
+typedef struct
+{
+   char     prefix[SIM_HEADER_SIZE];     // command header prefix, e.g. ":ELCH:RUN"
+   double   time;                        // service time in s
+} sim_service_t;
+
+typedef struct
+{
+   int            type[SIM_NUM_SLOTS];   // module type code per slot, 0 = empty
+   int            sub[SIM_NUM_SLOTS];    // module subtype code per slot
+   double         serviceTime;           // service time of a command in s
+   double         jitter;                // service time varies by +-jitter s
+   int            serviceCount;
+   sim_service_t  service[SIM_MAX_SERVICE];  // service times of single commands
+   double         tau;                   // time constant of the TEC loop in s
+   double         noise;                 // relative noise of actual values
+   unsigned       seed;                  // random seed of jitter and noise
+   int            verbose;               // print messages to stderr
+} sim_config_t;
+
+typedef struct sim sim_t;
+
+/*===========================================================================
+ Prototypes
+===========================================================================*/
+void   sim_default_config(sim_config_t *cfg);
+int    sim_parse_modules(sim_config_t *cfg, const char *spec);
+int    sim_parse_service(sim_config_t *cfg, const char *spec);
+
+sim_t *sim_create(const sim_config_t *cfg);
+void   sim_destroy(sim_t *sim);
+
+int    sim_message(sim_t *sim, const char *message, char *response, int size);
+int    sim_serve_fd(sim_t *sim, int fd);
+int    sim_start_pty(sim_t *sim, char *resource, int size);
+int    sim_serve_tcp(sim_t *sim, int port, int once);
+void   sim_get_traffic(sim_t *sim, unsigned long long *received, unsigned long long *sent);
+
+#if defined(__cplusplus) || defined(__cplusplus__)
+}
+#endif
+
+#endif   /* _PRO8SIM_HEADER_ */
+
+/****************************************************************************
+  End of Header file
+****************************************************************************/
@@ -0,0 +1,153 @@
+/****************************************************************************
+
+   Thorlabs PRO800/PRO8000 SCPI Simulator Application
+
+   Source file    simulator.c
+
+   Date:          Oct-16-2026
+   Software-Nr:   N/A
+   Version:       1.0
+   Copyright:     Copyright(c) 2010, Thorlabs GmbH (www.thorlabs.com)
+
+   Disclaimer:
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+
+
+   NOTE: Build with 'cc -O2 -o pro8sim simulator.c pro8sim.c -lpthread -lm'.
+         The program prints the resource name to pass to Pro8_init, e.g.
+         "tty:/dev/pts/3" or "tcp:localhost:5025", and serves it until it
+         is terminated.
+
+****************************************************************************/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "pro8sim.h"
+
+/*===========================================================================
+ Prototypes
+===========================================================================*/
+void usage(const char *program);
+
+/*===========================================================================
+ Functions
+===========================================================================*/
+int main(int argc, char **argv)
+{
+   sim_config_t   cfg;
+   sim_t          *sim;
+   char           resource[256];
+   int            opt, port = 0, once = 0;
+
+   sim_default_config(&cfg);
+
+   // Parameter checking
+   while((opt = getopt(argc, argv, "m:s:j:c:t:n:r:p:1vh")) != -1)
+   {
+      switch(opt)
+      {
+         case 'm':
+            if(sim_parse_modules(&cfg, optarg)) usage(argv[0]);
+            break;
+         case 's':
+            cfg.serviceTime = atof(optarg);
+            break;
+         case 'j':
+            cfg.jitter = atof(optarg);
+            break;
+         case 'c':
+            if(sim_parse_service(&cfg, optarg)) usage(argv[0]);
+            break;
+         case 't':
+            cfg.tau = atof(optarg);
+            break;
+         case 'n':
+            cfg.noise = atof(optarg);
+            break;
+         case 'r':
+            cfg.seed = (unsigned)strtoul(optarg, NULL, 0);
+            break;
+         case 'p':
+            port = atoi(optarg);
+            break;
+         case '1':
+            once = 1;
+            break;
+         case 'v':
+            cfg.verbose = 1;
+            break;
+         default:
+            usage(argv[0]);
+      }
+   }
+   if((cfg.serviceTime < 0.0) || (cfg.jitter < 0.0) || (cfg.noise < 0.0) || (port < 0) || (port > 65535)) usage(argv[0]);
+
+   if((sim = sim_create(&cfg)) == NULL)
+   {
+      fprintf(stderr, "ERROR: Out of memory\n");
+      return (EXIT_FAILURE);
+   }
+
+   // Socket
+   if(port)
+   {
+      printf("tcp:localhost:%d\n", port);
+      fflush(stdout);
+      if(sim_serve_tcp(sim, port, once) < 0)
+      {
+         perror("ERROR: tcp");
+         sim_destroy(sim);
+         return (EXIT_FAILURE);
+      }
+      sim_destroy(sim);
+      return (EXIT_SUCCESS);
+   }
+
+   // Pseudo terminal - served by a thread until the program is terminated
+   if(sim_start_pty(sim, resource, sizeof(resource)) < 0)
+   {
+      perror("ERROR: pty");
+      sim_destroy(sim);
+      return (EXIT_FAILURE);
+   }
+   printf("%s\n", resource);
+   fflush(stdout);
+   for(;;) pause();
+}
+
+
+/*---------------------------------------------------------------------------
+  Print the command line options and exit
+---------------------------------------------------------------------------*/
+void usage(const char *program)
+{
+   fprintf(stderr, "Usage: %s [options]\n\n", program);
+   fprintf(stderr, "  -m modules   modules from slot 1, e.g. \"LDC,TEC,-,ITC,PDA\" or \"191/0,223/0\"\n");
+   fprintf(stderr, "               (default \"LDC,TEC,ITC\")\n");
+   fprintf(stderr, "  -s seconds   service time of a command (default 0.001)\n");
+   fprintf(stderr, "  -j seconds   jitter of the service time of a message (default 0.0001)\n");
+   fprintf(stderr, "  -c services  service time of single commands, e.g. \":ELCH:RUN=0.2,:TEMP:ACT?=0.005\"\n");
+   fprintf(stderr, "  -t seconds   time constant of the TEC loop (default 5)\n");
+   fprintf(stderr, "  -n noise     relative noise of the actual values (default 0.001)\n");
+   fprintf(stderr, "  -r seed      random seed of jitter and noise (default 1)\n");
+   fprintf(stderr, "  -p port      serve a TCP port instead of a pseudo terminal\n");
+   fprintf(stderr, "  -1           serve one TCP connection and exit\n");
+   fprintf(stderr, "  -v           print messages and responses to stderr\n");
+   exit(EXIT_FAILURE);
+}
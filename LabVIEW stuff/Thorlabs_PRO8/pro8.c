@@ -27,25 +27,54 @@
 
    Source file
 
-   Date:          Jun-28-2010
+   Date:          Oct-16-2026
    Built with:    NI LabWindows/CVI 9.1.0
    Software-Nr:   09.178.xxx
-   Version:       2.5.3
+   Version:       2.6.0
 
    Changelog:     see 'readme.rtf'
 
 ****************************************************************************/
 
 
+#if defined(_WIN32)
+#include <windows.h>
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002   // Windows 10 1803 and later, older SDKs do not define it
+#endif
+#else
+#include <time.h>
+#endif
+#if defined(__linux__)
+#include <errno.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <poll.h>
+#include <sched.h>
+#include <termios.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <linux/usb/tmc.h>
+#endif
 #include <visa.h>
+#include <stdarg.h>
+#include <stdlib.h>
 #include <string.h>
+#include <locale.h>
+#include <math.h>
 #include <utility.h>
 #include <formatio.h>
 #include "pro8.h"
+#include "pro8_ext.h"
 
-#define PRO8_DRIVER_REVISION           "2.5.3"              // Instrument driver revision
+#define PRO8_DRIVER_REVISION           "2.6.0"              // Instrument driver revision
 #define BUFFER_SIZE                    512L                 // File I/O buffer size
 #define CMD_BUF_SIZE                   128                  // Buffer size of the command format buffer
+#define RESPONSE_BUF_SIZE              1024                 // Buffer size of compound query responses
 
 #define PRO8_ID_RESPONSE_COMPANY_A     "PROFILE"            // The device has to respond this string as the company name
 #define PRO8_ID_RESPONSE_COMPANY_B     "THORLABS"           // The device has to respond this string as the company name
@@ -62,6 +91,66 @@
 #define PRO8_POLL_STB_LOOP_DELAY       0.05                 // Delay (seconds) in function Pro8_WaitForFinBit()
 #define PRO8_GET_ERROR_LOOP_COUNTER    50                   // Max number of loops in function Pro8_GetInstrumentError(...)
 
+#define PRO8_MAX_SESSIONS              32                   // Max number of sessions opened by Pro8_init(...) at the same time
+#define PRO8_SESSION_WAIT_TIME         0.001                // Delay (seconds) while Pro8_FreeSession waits for threads using the session
+#define PRO8_COMPLETION_TIMEOUT        5.0                  // Timeout (seconds) in function Pro8_WaitForFinBit(), same as 100 x 50 ms
+#define PRO8_BACKOFF_MIN_DELAY         0.00005              // First backoff delay (seconds) in function Pro8_WaitForFinBit()
+#define PRO8_BACKOFF_MAX_DELAY         0.005                // Longest backoff delay (seconds) in function Pro8_WaitForFinBit()
+#define PRO8_SLEEP_SPIN_TIME           0.0005               // Remainder (seconds) of a delay Pro8_SleepSeconds yields the processor for on Windows
+#define PRO8_WAIT_AVERAGE_WEIGHT       8                    // Weight of the exponential moving average of the wait time
+#define PRO8_BATCH_MAX_LENGTH          250                  // Max length of a compound command, fits the instruments input buffer
+#define PRO8_ERROR_BULK_COUNT          10                   // Number of error queue entries read by one compound query
+#define PRO8_COMMAND_LOG_LENGTH        64                   // Number of commands kept in the command log of a session
+#define PRO8_COMMAND_LOG_WIDTH         64                   // Max length of a command kept in the command log
+#define PRO8_ASYNC_STOP                (-1)                 // Queue entry that stops the I/O thread of a session
+#define PRO8_SENDER_WAKE               1                    // Queue entry that wakes the setpoint sender of a session
+#define PRO8_SHADOW_SIZE               128                  // Number of values kept in the shadow model of a session
+#define PRO8_SHADOW_QUERY_WIDTH        24                   // Max length of a query kept in the shadow model
+#define PRO8_SHADOW_VALUE_WIDTH        32                   // Max length of a value kept in the shadow model
+#define PRO8_META_LIMITS               16                   // Number of MIN/MAX limits kept per slot
+#define PRO8_META_HEADER_WIDTH         16                   // Max length of the header of a limit, e.g. ":ILD"
+#define PRO8_META_TEXT_WIDTH           256                  // Buffer size of the identification and serial number
+#define PRO8_PLUG_CHECK_INTERVAL       1.0                  // Default interval (seconds) of the plug configuration check
+#define PRO8_TRANSPORT_HANDLE          0x7F000000           // First session handle of the usbtmc, tty and tcp transports
+#define PRO8_TRANSPORT_TIMEOUT         2000                 // I/O timeout (ms) of the usbtmc, tty and tcp transports
+#define PRO8_VISA_TRANSPORT            (&Pro8_transports[0])
+#define PRO8_TELEMETRY_MAX_SAMPLES     (PRO8_NUM_SLOTS * PRO8_CHANNEL_COUNT)   // Max number of samples of a snapshot
+#define PRO8_ELCH_MAX_BATCH            20                   // Max number of :ELCH:TRIG? queries in a compound query, fits PRO8_BATCH_MAX_LENGTH
+#define PRO8_ELCH_VALUE_WIDTH          14                   // Max length of a value in the response to :ELCH:TRIG?, e.g. "+1.234567E-03,"
+#define PRO8_ELCH_HEADER_WIDTH         16                   // Max length of the header and separator of the response to :ELCH:TRIG?
+#define PRO8_WAVEFORM_SYNC_POINTS      64                   // Max number of points written by the waveform thread without waiting for the FIN bit
+#define PRO8_WAVEFORM_SYNC_MARGIN      0.002                // Min spare time (seconds) before the next point for a wait for the FIN bit
+#define PRO8_WAVEFORM_YIELD_TIME       0.0001               // Time (seconds) a late waveform thread leaves the released lock to waiting threads
+#define PRO8_WAVEFORM_SPIN_TIME        0.002                // Time (seconds) before a deadline the waveform thread stops sleeping on Windows
+#define PRO8_SETTLE_INTERVAL           0.05                 // Time (seconds) between two temperature samples of Pro8_TecWaitSettled
+#define PRO8_SETTLE_WINDOW             32                   // Number of samples the thermal response is fitted to
+#define PRO8_SETTLE_MIN_SAMPLES        8                    // Min number of samples of a fit
+#define PRO8_SETTLE_CONFIRM            5                    // Number of last samples that have to be within the tolerance
+#define PRO8_SETTLE_HORIZON            1200                 // Number of intervals the fitted response is predicted
+#define PRO8_TUNE_HYSTERESIS           0.05                 // Hysteresis of the relay, fraction of the relay amplitude
+#define PRO8_TUNE_SKIP                 1                    // Number of relay periods before the oscillation is measured
+#define PRO8_TUNE_CYCLES               3                    // Number of relay periods measured
+#define PRO8_TUNE_CALIBRATE_STEP       0.1                  // Set temperature step of the share calibration, fraction of the relay amplitude
+#define PRO8_TUNE_CALIBRATE_TIME       0.5                  // Time (seconds) the integral share is observed
+#define PRO8_TUNE_MIN_IMPROVEMENT      (2 * PRO8_SETTLE_INTERVAL)   // Min reduction of the settling time (seconds) the tuned shares are kept for
+#define PRO8_METRICS_POLL_TIMEOUT      200                  // Interval (ms) the metrics thread checks for the stop request
+#define PRO8_METRICS_REQUEST_TIMEOUT   100                  // Time (ms) the metrics socket waits for the request of a client
+#define PRO8_METRICS_CLIENT_TIMEOUT    1000                 // Time (ms) the metrics socket serves a client at most
+
+#define PRO8_COUNT_WRITE               0                    // Events of Pro8_Count
+#define PRO8_COUNT_READ                1
+#define PRO8_COUNT_STB                 2
+#define PRO8_COUNT_SLEEP               3
+#define PRO8_COUNT_WAIT                4
+#define PRO8_COUNT_TIMEOUT             5
+#define PRO8_COUNT_DRAIN               6
+
+#define PRO8_TYPE_LDC                  191                  // Type codes of Pro8_GetSlotConfiguration
+#define PRO8_TYPE_MLC                  47
+#define PRO8_TYPE_TEC                  223
+#define PRO8_TYPE_ITC                  159
+#define PRO8_TYPE_PDA                  107
+
 
 //===========================================================================
 // Pro8_stringValPair is used in the unigpb_errorMessage function
@@ -72,6 +161,430 @@ typedef struct  Pro8_stringValPair
    ViString stringName;
 }  Pro8_tStringValPair;
 
+//===========================================================================
+// Pro8_tDiyFp is the "do it yourself" floating point number of the
+// round-trip number formatting in Pro8_FormatReal: f * 2^e
+//===========================================================================
+#if defined(_CVI_) || defined(_MSC_VER)
+typedef unsigned __int64   Pro8_tUInt64;
+#else
+typedef unsigned long long Pro8_tUInt64;
+#endif
+
+#define PRO8_DIY_HIDDEN_BIT            ((Pro8_tUInt64)1 << 52)               // Hidden bit of a normalized double
+#define PRO8_DIY_FRACTION_MASK         (PRO8_DIY_HIDDEN_BIT - 1)             // Fraction bits of a double
+
+typedef struct  Pro8_diyFp
+{
+   Pro8_tUInt64 f;
+   ViInt32      e;
+}  Pro8_tDiyFp;
+
+typedef struct  Pro8_cachedPower
+{
+   ViUInt32 hi;                  // Upper 32 bits of the normalized significand of 10^k
+   ViUInt32 lo;                  // Lower 32 bits
+   ViInt16  e;                   // Binary exponent
+}  Pro8_tCachedPower;
+
+//===========================================================================
+// Pro8_logEntry is a command written by a session and its sequence number
+//===========================================================================
+typedef struct  Pro8_logEntry
+{
+   ViUInt32 sequence;            // Sequence number, 0 if the entry is empty
+   ViChar   command[PRO8_COMMAND_LOG_WIDTH];
+}  Pro8_tLogEntry;
+
+//===========================================================================
+// Pro8_future is an asynchronous operation and its result
+//===========================================================================
+typedef struct  Pro8_future
+{
+   ViBoolean            used;             // Entry is allocated
+   ViBoolean            keep;             // Result is kept until Pro8_AsyncRelease
+   volatile ViBoolean   done;             // Operation is finished
+   ViStatus             status;           // Status returned by the operation
+   Pro8_AsyncFunction   function;         // Function to call, VI_NULL for a command
+   ViAddr               data;
+   Pro8_AsyncCallback   callback;         // Called by the I/O thread when finished
+   ViAddr               callbackData;
+   ViInt16              slot;             // Slot selected before the command, 0 = active slot
+   ViChar               command[PRO8_BATCH_MAX_LENGTH + 1];
+   ViChar               response[PRO8_ASYNC_RESPONSE_SIZE];
+}  Pro8_tFuture;
+
+//===========================================================================
+// Pro8_async is the I/O thread of a session and its operations
+//===========================================================================
+typedef struct  Pro8_async
+{
+   CmtThreadPoolHandle  pool;             // Thread pool with one thread
+   CmtThreadFunctionID  worker;           // I/O thread function
+   CmtTSQHandle         queue;            // Indices of the scheduled operations in order
+   CmtThreadLockHandle  lock;             // Protects the allocation of entries
+   Pro8_tFuture         futures[PRO8_ASYNC_MAX_PENDING];
+}  Pro8_tAsync;
+
+//===========================================================================
+// Pro8_poolJob holds the commands of one instrument of Pro8_PoolExecute
+//===========================================================================
+typedef struct  Pro8_poolJob
+{
+   ViInt32   count;              // Number of commands
+   ViInt32   *index;             // Indices of the commands in the caller arrays, in order
+   ViInt16   *slot;              // Caller arrays
+   ViString  *commands;
+   ViChar    *responses;
+   ViReal64  *values;
+   ViStatus  *results;
+   ViReal64  *times;             // Time of the responses, VI_NULL if not needed
+}  Pro8_tPoolJob;
+
+//===========================================================================
+// Pro8_shadowEntry is a value of the shadow model: the response to a query
+// of a slot without the header, e.g. ":ILD:SET?" -> "1.000E-02"
+//===========================================================================
+typedef struct  Pro8_shadowEntry
+{
+   ViInt16  slot;                // Slot, 0 if the entry is free
+   ViReal64 time;                // Time the value was stored
+   ViChar   query[PRO8_SHADOW_QUERY_WIDTH];
+   ViChar   value[PRO8_SHADOW_VALUE_WIDTH];
+}  Pro8_tShadowEntry;
+
+//===========================================================================
+// Pro8_limit is the MIN/MAX range of a parameter of a slot, e.g. ":ILD"
+//===========================================================================
+typedef struct  Pro8_limit
+{
+   ViChar   header[PRO8_META_HEADER_WIDTH];
+   ViStatus status;              // Status of the query, the parameter has no limits if < 0
+   ViReal64 minimum;
+   ViReal64 maximum;
+}  Pro8_tLimit;
+
+//===========================================================================
+// Pro8_slotInfo is the static data of the module in a slot. It is valid as
+// long as the plug configuration of the slot does not change.
+//===========================================================================
+typedef struct  Pro8_slotInfo
+{
+   ViInt16     plugType;         // Plug codes the data belongs to
+   ViInt16     plugSub;
+   ViInt16     type;             // Module type and subtype
+   ViInt16     sub;
+   ViBoolean   identValid;       // ident and options are known
+   ViBoolean   serialValid;      // serial is known
+   ViChar      ident[PRO8_META_TEXT_WIDTH];
+   ViChar      serial[PRO8_META_TEXT_WIDTH];
+   ViInt16     options[10];
+   ViInt16     limitCount;
+   Pro8_tLimit limits[PRO8_META_LIMITS];
+}  Pro8_tSlotInfo;
+
+//===========================================================================
+// Pro8_consumer is a reader of the sample ring of a stream
+//===========================================================================
+typedef struct  Pro8_consumer
+{
+   ViBoolean            used;             // Entry is allocated
+   volatile ViUInt32    cursor;           // Sequence number of the next sample to read
+   ViUInt32             lost;             // Number of samples overwritten before they were read
+}  Pro8_tConsumer;
+
+//===========================================================================
+// Pro8_stream is the acquisition thread of a session and its sample ring.
+// The acquisition thread is the only writer of the ring, it publishes the
+// samples by advancing head. Each consumer has its own cursor, so readers
+// do not wait for each other or for the writer.
+//===========================================================================
+typedef struct  Pro8_stream
+{
+   CmtThreadPoolHandle  pool;             // Thread pool with one thread
+   CmtThreadFunctionID  worker;           // Acquisition thread function
+   volatile ViBoolean   stop;             // Acquisition thread has to stop
+   ViReal64             period;           // Acquisition period (seconds), 0 = as fast as possible
+   ViUInt32             cycles;           // Number of acquisition cycles
+   ViUInt32             missed;           // Number of periods missed by late cycles
+   Pro8_tPoolJob        job;              // Queries of a cycle
+   ViInt32              index[PRO8_STREAM_MAX_CHANNELS];
+   ViInt16              slot[PRO8_STREAM_MAX_CHANNELS];
+   ViInt16              channel[PRO8_STREAM_MAX_CHANNELS];
+   ViString             commands[PRO8_STREAM_MAX_CHANNELS];
+   ViReal64             values[PRO8_STREAM_MAX_CHANNELS];
+   ViReal64             times[PRO8_STREAM_MAX_CHANNELS];
+   ViStatus             results[PRO8_STREAM_MAX_CHANNELS];
+   ViUInt32             mask;             // Capacity of the ring - 1, capacity is a power of 2
+   volatile ViUInt32    head;             // Sequence number of the next sample written
+   Pro8_tSample         *ring;
+   Pro8_tConsumer       consumers[PRO8_STREAM_MAX_CONSUMERS];
+}  Pro8_tStream;
+
+//===========================================================================
+// Pro8_setpoint is a latest-value mailbox of a setpoint channel. The value
+// is posted without locks: sequence is odd while the poster writes and is
+// incremented again when the value is complete, so the sender retries
+// reading a value that changed meanwhile.
+//===========================================================================
+typedef struct  Pro8_setpoint
+{
+   ViBoolean            used;             // Entry is allocated
+   ViInt16              slot;
+   ViInt16              parameter;        // PRO8_SETPOINT_xxx
+   volatile ViUInt32    sequence;         // Incremented twice by each post
+   volatile ViReal64    value;            // Latest value posted
+   volatile ViReal64    posted;           // Time of the latest post
+   ViUInt32             taken;            // Sequence of the value last taken by the sender
+   ViUInt32             applied;          // Number of values written to the instrument
+   ViUInt32             dropped;          // Number of values superseded before they were written
+   ViReal64             appliedValue;     // Value last written
+   ViReal64             lastAge;          // Time from post to completion of the value last written
+   ViReal64             maxAge;
+   ViStatus             status;           // Status of the value last written
+}  Pro8_tSetpoint;
+
+//===========================================================================
+// Pro8_sender is the thread writing the setpoint channels of a session
+//===========================================================================
+typedef struct  Pro8_sender
+{
+   CmtThreadPoolHandle  pool;             // Thread pool with one thread
+   CmtThreadFunctionID  worker;           // Sender thread function
+   CmtTSQHandle         doorbell;         // Wakes the sender after a post, one entry
+   Pro8_tSetpoint       setpoints[PRO8_MAX_SETPOINTS];
+}  Pro8_tSender;
+
+//===========================================================================
+// Pro8_waveform is the thread playing a setpoint table of a session. Point
+// n of the play is due at start + n * period, the thread writes it at this
+// absolute deadline. Statistics are written by the thread only and read
+// without a lock.
+//===========================================================================
+typedef struct  Pro8_waveform
+{
+   CmtThreadPoolHandle  pool;             // Thread pool with one thread
+   CmtThreadFunctionID  worker;           // Waveform thread function
+   volatile ViBoolean   stop;             // Waveform thread has to stop
+   volatile ViBoolean   running;          // Waveform thread has not finished yet
+   ViInt16              slot;
+   ViInt16              parameter;        // PRO8_SETPOINT_xxx
+   ViReal64             period;           // Time (seconds) between two points
+   ViInt32              cycles;           // Number of times the table is played, 0 = until stopped
+   ViInt32              count;            // Number of points of the table
+   ViReal64             *setpoints;
+   ViReal64             *errors;          // Timing error (seconds) of each point in the last cycle
+   volatile ViUInt32    points;           // Number of points written
+   volatile ViUInt32    played;           // Number of cycles completed
+   ViUInt32             late;             // Number of points written a period or more after their deadline
+   ViReal64             maxError;
+   ViReal64             sumError;
+   ViStatus             status;           // First error, the thread stops
+}  Pro8_tWaveform;
+
+//===========================================================================
+// Pro8_loop is the control loop thread of a session. The statistics are
+// written by the thread between two increments of sequence, so readers
+// retry a copy taken while they changed.
+//===========================================================================
+typedef struct  Pro8_loop
+{
+   CmtThreadPoolHandle  pool;             // Thread pool with one thread
+   CmtThreadFunctionID  worker;           // Control loop thread function
+   volatile ViBoolean   stop;             // Control loop thread has to stop
+   Pro8_tLoopConfig     config;           // Gains and target are changed within the session lock
+   ViString             query;            // Query of the input channel
+   ViReal64             integral;         // Integral term (output units)
+   ViReal64             lastInput;        // Input and time of the previous cycle, for the derivative term
+   ViReal64             lastTime;
+   ViReal64             start;            // Start time of the thread
+   ViReal64             sumLatency;
+   ViUInt32             applied;          // Number of outputs written
+   volatile ViUInt32    sequence;         // Odd while the statistics are updated
+   Pro8_tLoopStatistics statistics;
+}  Pro8_tLoop;
+
+//===========================================================================
+// Pro8_tune holds the experiment of Pro8_TecAutoTune
+//===========================================================================
+typedef struct  Pro8_tune
+{
+   ViSession            instr;
+   ViInt16              slot;
+   ViReal64             temperature;      // Set temperature the experiments run around
+   ViReal64             amplitude;        // Relay amplitude (K)
+   ViReal64             tolerance;        // Settling tolerance (K)
+   ViReal64             timeout;          // Max duration (seconds) of each phase
+   Pro8_TuneCallback    callback;
+   ViAddr               callbackData;
+   ViInt16              phase;            // PRO8_TUNE_xxx
+   ViReal64             start;            // Start time of the phase
+}  Pro8_tTune;
+
+//===========================================================================
+// Pro8_transport is the I/O backend of a session. The VISA transport has no
+// open and close function, Pro8_Open and Pro8_close use VISA directly.
+//===========================================================================
+struct Pro8_session;
+
+typedef struct  Pro8_transport
+{
+   ViString name;                // Name returned by Pro8_TransportPing
+   ViString prefix;              // Prefix of the resource name, VI_NULL = VISA
+   ViStatus (*open)    (struct Pro8_session *session, ViString address);
+   void     (*close)   (struct Pro8_session *session);
+   ViStatus (*write)   (struct Pro8_session *session, ViBuf buffer, ViUInt32 count, ViPUInt32 retCount);
+   ViStatus (*read)    (struct Pro8_session *session, ViBuf buffer, ViUInt32 count, ViPUInt32 retCount);
+   ViStatus (*readStb) (struct Pro8_session *session, ViUInt16 *stb);
+}  Pro8_tTransport;
+
+//===========================================================================
+// Pro8_session holds the driver data of a session opened by Pro8_init
+//===========================================================================
+typedef struct  Pro8_session
+{
+   ViSession instr;              // VISA session or driver handle, VI_NULL if the entry is free
+   const Pro8_tTransport *transport;   // I/O backend
+   int       fd;                 // File descriptor of the usbtmc, tty and tcp transports
+   ViUInt32  timeout;            // I/O timeout (ms) of the usbtmc, tty and tcp transports
+   ViBoolean queryPending;       // tty, tcp: a response is on the way, *STB? is not sent
+   ViUInt32  rxStart, rxEnd;     // tty, tcp: received bytes not yet read
+   ViChar    rx[RESPONSE_BUF_SIZE];
+   CmtThreadLockHandle lock;     // Transaction lock, recursive
+   ViInt32   users;              // Pro8_Lock calls not yet ended by Pro8_Unlock, guarded by the table lock
+   unsigned int lockThread;      // Thread holding the transaction lock
+   ViInt32   lockDepth;          // Number of holds of lockThread, 0 if the lock is free
+   ViUInt32  acquisitions;       // Number of times the lock was acquired
+   ViUInt32  contentions;        // Number of times the lock was held by another thread
+   ViInt16   completionMode;     // PRO8_COMPLETION_xxx
+   ViBoolean srqEnabled;         // Service request event is enabled
+   ViReal64  lastWait;           // Duration of the last wait for the FIN bit (seconds)
+   ViReal64  averageWait;        // Moving average of the wait for the FIN bit (seconds)
+   ViBoolean batchActive;        // Commands are collected by Pro8_Write
+   ViBoolean batchPending;       // Last command was collected, nothing to wait for
+   unsigned int batchThread;     // Thread that began the batch, only its commands are collected
+   ViStatus  batchStatus;        // First error of the batch
+   ViUInt32  batchLength;        // Length of the collected compound command
+   ViChar    batch[PRO8_BATCH_MAX_LENGTH + 1];
+   ViBoolean answerMode;         // Answer mode, 0 = full, 1 = value
+   ViInt16   slot;               // Active slot, 0 if unknown
+   ViInt16   port;               // Active port, 0 if unknown
+   ViBoolean plugValid;          // Plug configuration is known
+   ViInt16   plugType[PRO8_NUM_SLOTS];
+   ViInt16   plugSub[PRO8_NUM_SLOTS];
+   ViInt16   errorCheckMode;     // PRO8_ERROR_CHECK_xxx
+   ViReal64  syncInterval;       // Interval (seconds) of the automatic error check, 0 = never
+   ViReal64  lastSync;           // Time of the last deferred error check
+   ViBoolean writePending;       // Last command was written without waiting for the FIN bit
+   ViUInt32  sequence;           // Sequence number of the last command written
+   ViUInt32  syncedSequence;     // Last command covered by a deferred error check
+   ViStatus  deferredStatus;     // First instrument error found by a deferred error check
+   ViUInt32  deferredFirst;      // First and last command that may have caused it
+   ViUInt32  deferredLast;
+   Pro8_tLogEntry log[PRO8_COMMAND_LOG_LENGTH];
+   Pro8_tAsync    *async;        // I/O thread, VI_NULL until the first asynchronous operation
+   Pro8_tStream   *stream;       // Acquisition thread, VI_NULL if not streaming
+   Pro8_tSender   *sender;       // Setpoint sender thread, VI_NULL until the first setpoint channel
+   Pro8_tWaveform *waveform;     // Waveform thread, VI_NULL if no waveform was played
+   Pro8_tLoop     *loop;         // Control loop thread, VI_NULL if no loop runs
+   ViBoolean shadowMode;         // Getters of set values are answered by the shadow model
+   ViReal64  shadowMaxAge;       // Max age (seconds) of a shadow value, 0 = unlimited
+   ViUInt32  shadowHits;         // Number of queries answered by the shadow model
+   ViUInt32  shadowMisses;       // Number of queries sent to the instrument
+   Pro8_tShadowEntry shadow[PRO8_SHADOW_SIZE];
+   ViBoolean metadataMode;       // Slot data and limits are kept, setpoints are checked
+   ViReal64  plugCheckInterval;  // Interval (seconds) of the plug configuration check, 0 = never
+   ViReal64  plugChecked;        // Time of the last plug configuration query
+   ViUInt32  plugChecksum;       // Checksum of the plug configuration
+   ViUInt32  plugChanges;        // Number of plug configuration changes detected
+   Pro8_tSlotInfo meta[PRO8_NUM_SLOTS];
+   ViReal64  initTime;           // Duration (seconds) of Pro8_init or Pro8_InitFast
+   ViBoolean initAttached;       // Pro8_InitFast attached to a known instrument
+   ViInt16   counterClass;       // Class of the message last written, PRO8_COUNTER_xxx
+   volatile ViUInt32 counterSequence;  // Odd while the counters are updated
+   ViReal64  counterReset;       // Time the counters were reset
+   Pro8_tCounters counters[PRO8_COUNTER_CLASSES];  // Per command class, elapsed is not used
+}  Pro8_tSession;
+
+static Pro8_tSession Pro8_sessions[PRO8_MAX_SESSIONS];
+static volatile CmtThreadLockHandle Pro8_sessionsLock = 0;   // Guards the claim, lookup and release of entries
+
+//===========================================================================
+// Pro8_pool holds the instruments opened by Pro8_PoolOpen
+//===========================================================================
+typedef struct  Pro8_pool
+{
+   ViInt16   count;              // Number of instruments, 0 if the entry is free
+   ViSession instr[PRO8_POOL_MAX_CHASSIS];
+   ViChar    resource[PRO8_POOL_MAX_CHASSIS][VI_FIND_BUFLEN];
+}  Pro8_tPool;
+
+static Pro8_tPool Pro8_pools[PRO8_MAX_POOLS];
+
+//===========================================================================
+// Pro8_metrics is the thread serving the counters of all sessions on a
+// local socket
+//===========================================================================
+typedef struct  Pro8_metrics
+{
+   CmtThreadPoolHandle  pool;             // Thread pool with one thread
+   CmtThreadFunctionID  worker;           // Metrics thread function
+   volatile ViBoolean   stop;             // Metrics thread has to stop
+   int                  fd;               // Listening socket
+}  Pro8_tMetrics;
+
+static Pro8_tMetrics *Pro8_metricsServer = VI_NULL;
+
+//===========================================================================
+// Names of the command classes PRO8_COUNTER_xxx in the metrics text
+//===========================================================================
+static ViString Pro8_counterClassNames[PRO8_COUNTER_CLASSES + 1] =
+{
+   "", "setting", "query", "common", "error"
+};
+
+//===========================================================================
+// Names of the counters in the metrics text, in the order of Pro8_tCounters
+//===========================================================================
+#define PRO8_METRICS_COUNT             17
+
+static ViString Pro8_metricNames[PRO8_METRICS_COUNT] =
+{
+   "pro8_writes_total", "pro8_write_bytes_total", "pro8_reads_total", "pro8_read_bytes_total", "pro8_stb_polls_total",
+   "pro8_sleeps_total", "pro8_waits_total", "pro8_poll_timeouts_total", "pro8_error_drains_total", "pro8_io_errors_total",
+   "pro8_write_seconds_total", "pro8_read_seconds_total", "pro8_stb_seconds_total", "pro8_sleep_seconds_total",
+   "pro8_wait_seconds_total", "pro8_drain_seconds_total", "pro8_counters_age_seconds"
+};
+
+//===========================================================================
+// Pro8_probe is the identification of a resource by Pro8_FindInstruments
+//===========================================================================
+typedef struct  Pro8_probe
+{
+   ViSession            rmSession;
+   ViUInt32             timeout;          // ms
+   ViInt32              index;
+   CmtTSQHandle         done;             // Receives index when the probe is finished
+   CmtThreadFunctionID  worker;
+   Pro8_tInstrument     result;
+}  Pro8_tProbe;
+
+//===========================================================================
+// Queries of the telemetry channels PRO8_CHANNEL_xxx
+//===========================================================================
+static ViString Pro8_channelQueries[PRO8_CHANNEL_COUNT + 1] =
+{
+   "", ":ILD:ACT?", ":IMD:ACT?", ":VLD:ACT?", ":TEMP:ACT?", ":ITE:ACT?", ":VTE:ACT?", ":IPD:ACT?", ":POPT:ACT?"
+};
+
+//===========================================================================
+// Commands of the setpoint channels PRO8_SETPOINT_xxx
+//===========================================================================
+static ViString Pro8_setpointCommands[PRO8_SETPOINT_COUNT + 1] =
+{
+   "", ":ILD:SET %f", ":IMD:SET %f", ":POPT:SET %f", ":TEMP:SET %f"
+};
+
 
 //===========================================================================
 // UTILITY ROUTINE DECLARATIONS (Non-Exportable Functions)
@@ -85,8 +598,132 @@ ViBoolean Pro8_invalidViUInt32Range (ViUInt32 val, ViUInt32 min, ViUInt32 max);
 ViBoolean Pro8_invalidViReal32Range (ViReal32 val, ViReal32 min, ViReal32 max);
 ViBoolean Pro8_invalidViReal64Range (ViReal64 val, ViReal64 min, ViReal64 max);
 ViStatus Pro8_initCleanUp (ViSession openRMSession, ViPSession openInstrSession, ViStatus currentStatus);
+ViStatus Pro8_CheckIdentity (ViString company, ViString device);
+void Pro8_ReadInitCache (ViString cacheFile, ViChar cached[][BUFFER_SIZE]);
+void Pro8_WriteInitCache (ViString cacheFile, ViString resource, ViString identity, ViString plug);
+int CVICALLBACK Pro8_FindProbe (void *functionData);
 ViStatus Pro8_WaitForFinBit (ViSession instrumentHandle, ViUInt16 *stb);
 ViStatus Pro8_GetInstrumentError (ViSession instrumentHandle);
+ViStatus Pro8_ReadErrorQueue (ViSession instrumentHandle, ViInt32 *firstError, ViInt32 *lastError);
+ViStatus Pro8_CollectErrors (ViSession instrumentHandle, Pro8_tSession *session);
+CmtThreadLockHandle Pro8_TableLock (void);
+Pro8_tSession *Pro8_GetSession (ViSession instrumentHandle);
+ViStatus Pro8_NewSession (ViSession instrumentHandle);
+void Pro8_FreeSession (ViSession instrumentHandle);
+ViStatus Pro8_EnableSrq (ViSession instrumentHandle, Pro8_tSession *session, ViBoolean enable);
+ViStatus Pro8_Write (ViSession instrumentHandle, ViBuf buffer, ViUInt32 count, ViPUInt32 retCount);
+ViStatus Pro8_FlushBatch (ViSession instrumentHandle, Pro8_tSession *session);
+ViBoolean Pro8_BatchOwner (Pro8_tSession *session);
+ViStatus Pro8_CompoundQuery (ViSession instrumentHandle, ViInt16 count, ViString queries[], ViChar buffer[], ViUInt32 size, ViString answers[]);
+ViStatus Pro8_ReadAnswers (ViSession instrumentHandle, ViInt16 count, ViChar buffer[], ViUInt32 size, ViString answers[]);
+ViInt16 Pro8_SplitAnswers (ViChar buffer[], ViInt16 count, ViString answers[]);
+ViStatus Pro8_GetAnswer (ViSession instrumentHandle, ViBoolean *answer);
+void Pro8_InvalidateSession (Pro8_tSession *session);
+ViStatus Pro8_ReadPlugConfig (ViSession instrumentHandle, ViInt16 type[], ViInt16 sub[]);
+ViInt32 Pro8_Fmt (ViChar buffer[], ViString format, ...);
+ViStatus Pro8_ReadReal (ViSession instrumentHandle, ViBoolean answer, ViReal64 *value);
+ViStatus Pro8_ParseReal (ViString response, ViBoolean answer, ViReal64 *value);
+ViStatus Pro8_ParseValues (ViString response, ViBoolean answer, ViInt16 count, ViReal64 values[]);
+ViInt32 Pro8_FormatReal (ViChar buffer[], ViReal64 value);
+Pro8_tDiyFp Pro8_DiyMultiply (Pro8_tDiyFp x, Pro8_tDiyFp y);
+ViReal64 Pro8_StringToReal (ViString string, ViChar **end);
+ViReal64 Pro8_TimeNow (void);
+void Pro8_SleepSeconds (ViReal64 seconds);
+void Pro8_SleepUntil (ViReal64 deadline);
+void Pro8_RealTimeThread (void);
+void Pro8_Lock (ViSession instrumentHandle);
+ViStatus Pro8_Unlock (ViSession instrumentHandle, ViStatus status);
+ViBoolean Pro8_LockOwner (Pro8_tSession *session);
+ViStatus Pro8_AsyncStart (Pro8_tSession *session);
+void Pro8_AsyncStop (Pro8_tSession *session);
+ViStatus Pro8_AsyncSchedule (ViSession instrumentHandle, Pro8_tFuture *request, ViInt32 *future);
+Pro8_tFuture *Pro8_AsyncGetFuture (ViSession instrumentHandle, ViInt32 future);
+int CVICALLBACK Pro8_AsyncWorker (void *functionData);
+ViStatus Pro8_AsyncExecute (ViSession instrumentHandle, Pro8_tFuture *future);
+ViStatus _VI_FUNCH Pro8_PoolRun (ViSession instrumentHandle, ViAddr data);
+ViUInt32 Pro8_ChannelMask (ViInt16 type);
+ViStatus Pro8_TelemetryChannels (ViSession instrumentHandle, ViUInt32 channelMask, ViInt32 size, ViInt16 slot[], ViInt16 channel[], ViInt32 *count);
+void Pro8_StreamFree (Pro8_tSession *session);
+int CVICALLBACK Pro8_StreamWorker (void *functionData);
+Pro8_tConsumer *Pro8_StreamGetConsumer (ViSession instrumentHandle, ViInt32 consumer);
+void Pro8_MemoryBarrier (void);
+ViStatus Pro8_SenderStart (Pro8_tSession *session);
+void Pro8_SenderStop (Pro8_tSession *session);
+int CVICALLBACK Pro8_SenderWorker (void *functionData);
+ViInt32 Pro8_SenderTake (Pro8_tSender *sender, ViInt32 index[], ViInt16 slot[], ViChar commands[][CMD_BUF_SIZE], ViUInt32 sequence[], ViReal64 posted[]);
+Pro8_tSetpoint *Pro8_SetpointGet (ViSession instrumentHandle, ViInt32 setpoint);
+void Pro8_WaveformFree (Pro8_tSession *session);
+int CVICALLBACK Pro8_WaveformWorker (void *functionData);
+ViStatus Pro8_WaveformSync (ViSession instrumentHandle);
+void Pro8_LoopFree (Pro8_tSession *session);
+int CVICALLBACK Pro8_LoopWorker (void *functionData);
+ViStatus Pro8_LoopCycle (Pro8_tSession *session, Pro8_tLoop *loop);
+ViBoolean Pro8_SettleFit (ViReal64 x[], ViInt32 count, ViReal64 model[3], ViReal64 *residual);
+ViReal64 Pro8_SettlePredict (ViReal64 model[3], ViReal64 x1, ViReal64 x2, ViReal64 tolerance);
+ViStatus Pro8_TuneRun (Pro8_tTune *tune, ViString command, ViReal64 *value);
+ViStatus Pro8_TuneSample (Pro8_tTune *tune, ViReal64 *temperature, ViReal64 *current);
+ViStatus Pro8_TuneShares (Pro8_tTune *tune, ViReal64 PShare, ViReal64 IShare, ViReal64 DShare, ViReal64 temperature);
+ViStatus Pro8_TuneStep (Pro8_tTune *tune, ViReal64 temperature, ViReal64 *settleTime);
+ViBoolean _VI_FUNCH Pro8_TuneProgress (ViSession instrumentHandle, ViReal64 elapsed, ViReal64 temperature, ViReal64 predicted, ViAddr callbackData);
+ViStatus Pro8_TuneRelay (Pro8_tTune *tune, ViReal64 minimum[3], ViReal64 maximum[3], ViReal64 *ultimateGain, ViReal64 *ultimatePeriod, ViReal64 *amplitude);
+ViStatus Pro8_TuneCalibrate (Pro8_tTune *tune, ViReal64 minimum[3], ViReal64 maximum[3], ViReal64 *PGain, ViReal64 *IGain);
+ViStatus Pro8_ShadowQuery (ViSession instrumentHandle, ViString query, ViBoolean answer, ViChar value[], ViUInt32 size);
+ViStatus Pro8_ShadowReal (ViSession instrumentHandle, ViString query, ViBoolean answer, ViReal64 *value);
+void Pro8_ShadowWrite (Pro8_tSession *session, ViBuf buffer, ViUInt32 count);
+Pro8_tShadowEntry *Pro8_ShadowFind (Pro8_tSession *session, ViInt16 slot, ViString query);
+Pro8_tShadowEntry *Pro8_ShadowFresh (Pro8_tSession *session, ViInt16 slot, ViString query);
+void Pro8_ShadowStore (Pro8_tSession *session, ViInt16 slot, ViString query, ViString value);
+void Pro8_ShadowClear (Pro8_tSession *session);
+void Pro8_ShadowValue (ViString response, ViBoolean answer, ViChar value[], ViUInt32 size);
+ViStatus Pro8_ReadSlotData (ViSession instrumentHandle, ViBoolean extended, Pro8_tSlotInfo *info);
+ViStatus Pro8_MetaSlot (ViSession instrumentHandle, Pro8_tSession *session);
+ViStatus Pro8_MetaLimit (ViSession instrumentHandle, ViInt16 slot, ViString header, Pro8_tLimit *limit);
+ViStatus Pro8_MetaCheck (ViSession instrumentHandle, Pro8_tSession *session, ViBuf buffer, ViUInt32 count);
+void Pro8_MetaPlug (Pro8_tSession *session, ViInt16 type[], ViInt16 sub[]);
+ViStatus Pro8_Open (ViSession rmSession, ViRsrc resourceName, ViPSession instrSession);
+const Pro8_tTransport *Pro8_FindTransport (ViString resourceName, ViString *address);
+ViStatus Pro8_Send (ViSession instrumentHandle, ViBuf buffer, ViUInt32 count, ViPUInt32 retCount);
+ViStatus Pro8_Read (ViSession instrumentHandle, ViBuf buffer, ViUInt32 count, ViPUInt32 retCount);
+ViStatus Pro8_ReadSTB (ViSession instrumentHandle, ViUInt16 *stb);
+ViInt16 Pro8_CounterClass (ViBuf buffer, ViUInt32 count);
+void Pro8_Count (Pro8_tSession *session, ViInt16 commandClass, ViInt16 event, ViStatus status, ViUInt32 bytes, ViReal64 seconds);
+void Pro8_CounterSnapshot (Pro8_tSession *session, Pro8_tCounters counters[]);
+ViInt32 Pro8_FormatMetrics (ViChar buffer[], ViInt32 size);
+ViStatus Pro8_Scanf (ViSession instrumentHandle, ViString format, ...);
+ViStatus Pro8_Scan (ViString buffer, ViString format, ...);
+ViStatus Pro8_VScan (ViString buffer, ViString format, va_list args);
+ViStatus Pro8_VisaWrite (Pro8_tSession *session, ViBuf buffer, ViUInt32 count, ViPUInt32 retCount);
+ViStatus Pro8_VisaRead (Pro8_tSession *session, ViBuf buffer, ViUInt32 count, ViPUInt32 retCount);
+ViStatus Pro8_VisaReadStb (Pro8_tSession *session, ViUInt16 *stb);
+#if defined(__linux__)
+void Pro8_FdClose (Pro8_tSession *session);
+ViStatus Pro8_UsbtmcOpen (Pro8_tSession *session, ViString address);
+ViStatus Pro8_UsbtmcWrite (Pro8_tSession *session, ViBuf buffer, ViUInt32 count, ViPUInt32 retCount);
+ViStatus Pro8_UsbtmcRead (Pro8_tSession *session, ViBuf buffer, ViUInt32 count, ViPUInt32 retCount);
+ViStatus Pro8_UsbtmcReadStb (Pro8_tSession *session, ViUInt16 *stb);
+ViStatus Pro8_TtyOpen (Pro8_tSession *session, ViString address);
+ViStatus Pro8_TcpOpen (Pro8_tSession *session, ViString address);
+ViStatus Pro8_LineWrite (Pro8_tSession *session, ViBuf buffer, ViUInt32 count, ViPUInt32 retCount);
+ViStatus Pro8_LineRead (Pro8_tSession *session, ViBuf buffer, ViUInt32 count, ViPUInt32 retCount);
+ViStatus Pro8_LineReadStb (Pro8_tSession *session, ViUInt16 *stb);
+ViStatus Pro8_LineFill (Pro8_tSession *session);
+int CVICALLBACK Pro8_MetricsWorker (void *functionData);
+void Pro8_MetricsServe (int fd);
+#endif
+
+//===========================================================================
+// Transports, selected by the prefix of the resource name
+//===========================================================================
+static const Pro8_tTransport Pro8_transports[] =
+{
+   {"VISA",    VI_NULL,    VI_NULL,          VI_NULL,       Pro8_VisaWrite,    Pro8_VisaRead,    Pro8_VisaReadStb},
+#if defined(__linux__)
+   {"USBTMC",  "usbtmc:",  Pro8_UsbtmcOpen,  Pro8_FdClose,  Pro8_UsbtmcWrite,  Pro8_UsbtmcRead,  Pro8_UsbtmcReadStb},
+   {"TTY",     "tty:",     Pro8_TtyOpen,     Pro8_FdClose,  Pro8_LineWrite,    Pro8_LineRead,    Pro8_LineReadStb},
+   {"TCP",     "tcp:",     Pro8_TcpOpen,     Pro8_FdClose,  Pro8_LineWrite,    Pro8_LineRead,    Pro8_LineReadStb},
+#endif
+};
+static ViSession Pro8_nextHandle = PRO8_TRANSPORT_HANDLE;
 
 
 //===========================================================================
@@ -99,48 +736,37 @@ ViStatus Pro8_GetInstrumentError (ViSession instrumentHandle);
 // Function: Initialize
 // Purpose:  This function opens the instrument, queries the instrument
 //           for its ID, and initializes the instrument to a known state.
+//           Resource names "usbtmc:/dev/usbtmc0", "tty:/dev/ttyS0,19200"
+//           (or a pty "tty:/dev/pts/3") and "tcp:host:port" select the
+//           driver transports on Linux, any other name is opened by VISA.
 //---------------------------------------------------------------------------
 ViStatus _VI_FUNC Pro8_init (ViRsrc resourceName, ViBoolean IDQuery, ViBoolean resetDevice, ViPSession instrSession)
 {
    ViStatus    status      = VI_SUCCESS;
    ViSession   rmSession   = 0;
    ViUInt32    retCnt      = 0;
-   ViBoolean   match       = VI_FALSE;
+   ViReal64    start       = Pro8_TimeNow ();
    ViChar      companyBuf[BUFFER_SIZE],
                deviceBuf[BUFFER_SIZE];
+   Pro8_tSession *session;
 
    //Check input parameter ranges
    if (Pro8_invalidViBooleanRange (IDQuery))     return VI_ERROR_PARAMETER2;
    if (Pro8_invalidViBooleanRange (resetDevice)) return VI_ERROR_PARAMETER3;
-   //Open instrument session
-   if ((status = viOpenDefaultRM (&rmSession)) < 0) return status;
-   if ((status = viOpen (rmSession, resourceName, VI_NULL, VI_NULL, instrSession)) < 0)
+   //Open instrument session - VISA resources need the resource manager
+   if ((Pro8_FindTransport (resourceName, VI_NULL) == PRO8_VISA_TRANSPORT) && ((status = viOpenDefaultRM (&rmSession)) < 0)) return status;
+   if ((status = Pro8_Open (rmSession, resourceName, instrSession)) < 0)
    {
-      viClose (rmSession);
+      if (rmSession) viClose (rmSession);
       return status;
    }
-   //Configure VISA Formatted I/O
-   if ((status = viSetBuf (*instrSession, VI_READ_BUF|VI_WRITE_BUF, 4000)) < 0)                      return Pro8_initCleanUp (rmSession, instrSession, status);
-   if ((status = viSetAttribute (*instrSession, VI_ATTR_WR_BUF_OPER_MODE, VI_FLUSH_ON_ACCESS)) < 0)  return Pro8_initCleanUp (rmSession, instrSession, status);
-   if ((status = viSetAttribute (*instrSession, VI_ATTR_RD_BUF_OPER_MODE, VI_FLUSH_ON_ACCESS)) < 0)  return Pro8_initCleanUp (rmSession, instrSession, status);
    //Identification Query
    if (IDQuery)
    {
-      if ((status = viWrite (*instrSession, "*IDN?", 5, &retCnt)) < 0)                                  return Pro8_initCleanUp (rmSession, instrSession, status);
-      if ((status = viScanf (*instrSession, "%[^,], %[^,], %*[^,], %*[^\n]", companyBuf, deviceBuf))<0) return Pro8_initCleanUp (rmSession, instrSession, status);
-      //Does Company match?
-      if ( (CompareStrings (companyBuf, 0, PRO8_ID_RESPONSE_COMPANY_A, 0, 0) != 0) &&
-           (CompareStrings (companyBuf, 0, PRO8_ID_RESPONSE_COMPANY_B, 0, 0) != 0) &&
-           (CompareStrings (companyBuf, 0, PRO8_ID_RESPONSE_COMPANY_C, 0, 0) != 0) &&
-           (CompareStrings (companyBuf, 0, PRO8_ID_RESPONSE_COMPANY_D, 0, 0) != 0) ) return Pro8_initCleanUp (rmSession, instrSession, VI_ERROR_FAIL_ID_QUERY);
-
-      //Does Device match?
-      if (CompareStrings (deviceBuf, 0, PRO8_ID_RESPONSE_PRO800 ,   0, 0) == 0)   match = VI_TRUE;
-      if (CompareStrings (deviceBuf, 0, PRO8_ID_RESPONSE_PRO8000,   0, 0) == 0)   match = VI_TRUE;
-      if (CompareStrings (deviceBuf, 0, PRO8_ID_RESPONSE_PRO8xxx,   0, 0) == 0)   match = VI_TRUE;
-      if (CompareStrings (deviceBuf, 0, PRO8_ID_RESPONSE_PRO8000_4, 0, 0) == 0)   match = VI_TRUE;
-      //Error
-      if (match == VI_FALSE)  return Pro8_initCleanUp (rmSession, instrSession, VI_ERROR_FAIL_ID_QUERY);
+      if ((status = Pro8_Send (*instrSession, "*IDN?", 5, &retCnt)) < 0)                                  return Pro8_initCleanUp (rmSession, instrSession, status);
+      if ((status = Pro8_Scanf (*instrSession, "%[^,], %[^,], %*[^,], %*[^\n]", companyBuf, deviceBuf))<0) return Pro8_initCleanUp (rmSession, instrSession, status);
+      //Does Company and Device match?
+      if ((status = Pro8_CheckIdentity (companyBuf, deviceBuf)) < 0)                                     return Pro8_initCleanUp (rmSession, instrSession, status);
    }
    //Remove existing instrument errors from the instruments error queue
    status = Pro8_GetInstrumentError(*instrSession);
@@ -153,8 +779,233 @@ ViStatus _VI_FUNC Pro8_init (ViRsrc resourceName, ViBoolean IDQuery, ViBoolean r
    }
    //Answer Mode
    if ((status = Pro8_SetAnswerMode (*instrSession, 0 /* full mode */)) < 0) return Pro8_initCleanUp (rmSession, instrSession, status);
+   //Bring-up time
+   if ((session = Pro8_GetSession (*instrSession)) != VI_NULL) session->initTime = Pro8_TimeNow () - start;
+   //Ready
+   return status;
+}
+
+//---------------------------------------------------------------------------
+// Function: Initialize Fast
+// Purpose:  This function opens the instrument like Pro8_init with the
+//           resource, identity and plug configuration kept in cacheFile by
+//           the last call. resourceName VI_NULL or "" takes the cached
+//           resource, or the first instrument VISA finds if there is none
+//           or it cannot be opened. One compound query clears the error
+//           queue, sets the full answer mode and reads the identity and
+//           plug configuration. If they match the cache the instrument is
+//           attached as it is, else the identity is checked, the instrument
+//           is reset if resetDevice is set and the cache is written.
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_InitFast (ViString cacheFile, ViRsrc resourceName, ViBoolean resetDevice, ViPSession instrSession)
+{
+   ViStatus       status      = VI_SUCCESS;
+   ViSession      rmSession   = 0;
+   ViFindList     findList;
+   ViUInt32       found       = 0;
+   ViUInt32       retCnt      = 0;
+   ViUInt16       stb;
+   ViInt16        type[PRO8_NUM_SLOTS], sub[PRO8_NUM_SLOTS];
+   ViInt16        i;
+   ViBoolean      given       = (ViBoolean)(resourceName && resourceName[0]);
+   ViBoolean      attached;
+   ViReal64       start       = Pro8_TimeNow ();
+   ViString       command     = "*CLS;:SYST:ANSW FULL;*IDN?;:CONFIG:PLUG?";
+   ViString       format      = "%*s %d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d";
+   ViString       answers[2];
+   ViChar         resource[VI_FIND_BUFLEN];
+   ViChar         cached[3][BUFFER_SIZE];
+   ViChar         response[RESPONSE_BUF_SIZE];
+   ViChar         companyBuf[BUFFER_SIZE],
+                  deviceBuf[BUFFER_SIZE];
+   Pro8_tSession  *session;
+
+   //Check input parameter ranges
+   if (cacheFile == VI_NULL)                     return VI_ERROR_PARAMETER1;
+   if (Pro8_invalidViBooleanRange (resetDevice)) return VI_ERROR_PARAMETER3;
+   if (instrSession == VI_NULL)                  return VI_ERROR_PARAMETER4;
+   *instrSession = VI_NULL;
+   //Cached resource and fingerprint
+   Pro8_ReadInitCache (cacheFile, cached);
+   resource[0] = '\0';
+   strncat (resource, given ? resourceName : cached[0], VI_FIND_BUFLEN - 1);
+   //Open instrument session - find an instrument if the cached one is gone
+   status = VI_ERROR_RSRC_NFOUND;
+   if (resource[0])
+   {
+      if ((Pro8_FindTransport (resource, VI_NULL) == PRO8_VISA_TRANSPORT) && ((status = viOpenDefaultRM (&rmSession)) < 0)) return status;
+      status = Pro8_Open (rmSession, resource, instrSession);
+   }
+   if ((status < 0) && (given == VI_FALSE))
+   {
+      if ((rmSession == 0) && ((status = viOpenDefaultRM (&rmSession)) < 0)) return status;
+      if ((status = viFindRsrc (rmSession, PRO8_FIND_PATTERN, &findList, &found, resource)) >= 0)
+      {
+         viClose (findList);
+         status = Pro8_Open (rmSession, resource, instrSession);
+      }
+   }
+   if (status < 0)
+   {
+      if (rmSession) viClose (rmSession);
+      *instrSession = VI_NULL;
+      return status;
+   }
+   //Writing - Poll STB - Check EAV Bit and read error - Reading
+   if ((status = Pro8_Write (*instrSession, command, StringLength (command), &retCnt)) < 0)          return Pro8_initCleanUp (rmSession, instrSession, status);
+   if ((status = Pro8_WaitForFinBit (*instrSession, &stb)) < 0)                                     return Pro8_initCleanUp (rmSession, instrSession, status);
+   if (stb & 0x0004)                                    return Pro8_initCleanUp (rmSession, instrSession, Pro8_GetInstrumentError (*instrSession));
+   if ((status = Pro8_ReadAnswers (*instrSession, 2, response, sizeof (response), answers)) < 0)    return Pro8_initCleanUp (rmSession, instrSession, status);
+   //Answer Mode
+   session = Pro8_GetSession (*instrSession);
+   if ((session->transport == PRO8_VISA_TRANSPORT) && ((status = viSetAttribute (*instrSession, VI_ATTR_USER_DATA, (ViAttrState)0)) < 0)) return Pro8_initCleanUp (rmSession, instrSession, status);
+   session->answerMode = 0;
+   //Plug configuration
+   if ((status = Pro8_Scan (answers[1], format, &type[0], &sub[0], &type[1], &sub[1], &type[2], &sub[2], &type[3], &sub[3],
+                           &type[4], &sub[4], &type[5], &sub[5], &type[6], &sub[6], &type[7], &sub[7])) < 0) return Pro8_initCleanUp (rmSession, instrSession, status);
+   for (i = 0; i < PRO8_NUM_SLOTS; i++)
+   {
+      session->plugType[i] = type[i];
+      session->plugSub[i]  = sub[i];
+   }
+   session->plugValid = VI_TRUE;
+   Pro8_MetaPlug (session, type, sub);
+   //Known instrument
+   attached = (ViBoolean)((strcmp (resource, cached[0]) == 0) && (strcmp (answers[0], cached[1]) == 0) && (strcmp (answers[1], cached[2]) == 0));
+   if (attached == VI_FALSE)
+   {
+      //Does Company and Device match?
+      if (Pro8_Scan (answers[0], "%[^,], %[^,]", companyBuf, deviceBuf) < 0)          return Pro8_initCleanUp (rmSession, instrSession, VI_ERROR_FAIL_ID_QUERY);
+      if ((status = Pro8_CheckIdentity (companyBuf, deviceBuf)) < 0)                                 return Pro8_initCleanUp (rmSession, instrSession, status);
+      //Reset instrument
+      if (resetDevice)
+      {
+         if ((status = Pro8_reset (*instrSession)) < 0)                                              return Pro8_initCleanUp (rmSession, instrSession, status);
+         if ((status = Pro8_SetAnswerMode (*instrSession, 0 /* full mode */)) < 0)                   return Pro8_initCleanUp (rmSession, instrSession, status);
+      }
+      //Store the fingerprint for the next start
+      Pro8_WriteInitCache (cacheFile, resource, answers[0], answers[1]);
+   }
+   //Bring-up time
+   session->initTime     = Pro8_TimeNow () - start;
+   session->initAttached = attached;
    //Ready
-   return status;
+   return VI_SUCCESS;
+}
+
+//---------------------------------------------------------------------------
+// Function: Find Instruments
+// Purpose:  This function finds the instruments matching findPattern
+//           (VI_NULL = PRO8_FIND_PATTERN) and probes them at the same time.
+//           Each probe opens the resource and reads the identity and the
+//           plug configuration, its I/O is limited to timeout seconds
+//           (0 = PRO8_FIND_DEFAULT_TIMEOUT), so instruments that do not
+//           answer delay the function by about one timeout in total. The
+//           results are stored in instruments in the order the probes
+//           finish, callback (may be VI_NULL) is called within the calling
+//           thread for each result as it arrives. At most size (and
+//           PRO8_FIND_MAX_INSTRUMENTS) instruments are probed. count
+//           returns the number of instruments probed, 0 if none is found.
+//           If more instruments are found, count returns the number found
+//           and VI_SUCCESS_MAX_CNT is returned.
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_FindInstruments (ViString findPattern, ViReal64 timeout, Pro8_FindCallback callback, ViAddr callbackData,
+                                        ViInt32 size, Pro8_tInstrument instruments[], ViInt32 *count)
+{
+   ViStatus             status   = VI_SUCCESS;
+   ViSession            rmSession;
+   ViFindList           findList;
+   ViUInt32             found    = 0, total;
+   ViInt32              n, i, k;
+   CmtTSQHandle         done;
+   CmtThreadPoolHandle  pool;
+   Pro8_tProbe          *probes;
+
+   //Check input parameter ranges
+   if (Pro8_invalidViReal64Range (timeout, 0.0, 60.0))   return VI_ERROR_PARAMETER2;
+   if (size < 0)                                         return VI_ERROR_PARAMETER5;
+   if ((instruments == VI_NULL) && size)                 return VI_ERROR_PARAMETER6;
+   if (count == VI_NULL)                                 return VI_ERROR_PARAMETER7;
+   if (timeout == 0.0) timeout = PRO8_FIND_DEFAULT_TIMEOUT;
+   *count = 0;
+   //Find instruments
+   if ((status = viOpenDefaultRM (&rmSession)) < 0) return status;
+   if ((probes = (Pro8_tProbe*)calloc (PRO8_FIND_MAX_INSTRUMENTS, sizeof (Pro8_tProbe))) == VI_NULL)
+   {
+      viClose (rmSession);
+      return VI_ERROR_ALLOC;
+   }
+   if ((status = viFindRsrc (rmSession, findPattern ? findPattern : PRO8_FIND_PATTERN, &findList, &found, probes[0].result.resource)) < 0)
+   {
+      free (probes);
+      viClose (rmSession);
+      return (status == VI_ERROR_RSRC_NFOUND) ? VI_SUCCESS : status;
+   }
+   total = found;
+   if (found > (ViUInt32)size) found = size;
+   if (found > PRO8_FIND_MAX_INSTRUMENTS) found = PRO8_FIND_MAX_INSTRUMENTS;
+   for (n = 1; n < (ViInt32)found; n++)
+   {
+      if ((status = viFindNext (findList, probes[n].result.resource)) < 0) break;
+   }
+   viClose (findList);
+   if (found == 0) n = 0;
+   //Thread pool - one thread per probe
+   if ((n > 0) && (CmtNewTSQ (n, sizeof (ViInt32), 0, &done) < 0)) n = -1;
+   if ((n > 0) && (CmtNewThreadPool (n, &pool) < 0))
+   {
+      CmtDiscardTSQ (done);
+      n = -1;
+   }
+   if (n < 0)
+   {
+      free (probes);
+      viClose (rmSession);
+      return VI_ERROR_SYSTEM_ERROR;
+   }
+   //Probing
+   for (i = 0; i < n; i++)
+   {
+      probes[i].rmSession = rmSession;
+      probes[i].timeout   = (ViUInt32)(timeout * 1000.0);
+      probes[i].index     = i;
+      probes[i].done      = done;
+      if (CmtScheduleThreadPoolFunction (pool, Pro8_FindProbe, &probes[i], &probes[i].worker) < 0)
+      {
+         probes[i].worker        = 0;
+         probes[i].result.status = VI_ERROR_SYSTEM_ERROR;
+         CmtWriteTSQData (done, &i, 1, TSQ_INFINITE_TIMEOUT, VI_NULL);
+      }
+   }
+   //Results as they arrive
+   for (k = 0; k < n; k++)
+   {
+      if (CmtReadTSQData (done, &i, 1, TSQ_INFINITE_TIMEOUT, 0) < 1) break;
+      instruments[k] = probes[i].result;
+      if (callback) callback (k, &instruments[k], callbackData);
+   }
+   //Cleanup
+   for (i = 0; i < n; i++)
+   {
+      if (probes[i].worker == 0) continue;
+      CmtWaitForThreadPoolFunctionCompletion (pool, probes[i].worker, 0);
+      CmtReleaseThreadPoolFunctionID (pool, probes[i].worker);
+   }
+   if (n > 0)
+   {
+      CmtDiscardThreadPool (pool);
+      CmtDiscardTSQ (done);
+   }
+   free (probes);
+   viClose (rmSession);
+   //Ready
+   if (total > found)
+   {
+      *count = total;
+      return VI_SUCCESS_MAX_CNT;
+   }
+   *count = k;
+   return VI_SUCCESS;
 }
 
 //---------------------------------------------------------------------------
@@ -163,21 +1014,30 @@ ViStatus _VI_FUNC Pro8_init (ViRsrc resourceName, ViBoolean IDQuery, ViBoolean r
 //---------------------------------------------------------------------------
 ViStatus _VI_FUNC Pro8_SetSlot (ViSession instrumentHandle, ViInt16 slot)
 {
-   ViStatus status = VI_SUCCESS;
-   ViUInt32 retCnt = 0;
-   ViUInt16 stb;
-   ViChar   buffer[CMD_BUF_SIZE];
+   ViStatus       status   = VI_SUCCESS;
+   ViUInt32       retCnt   = 0;
+   ViUInt16       stb;
+   ViChar         buffer[CMD_BUF_SIZE];
+   Pro8_tSession  *session;
 
    //Check input parameter ranges
    if (Pro8_invalidViInt16Range (slot, 1, 8)) return VI_ERROR_PARAMETER2;
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   //Slot is already active
+   session = Pro8_GetSession (instrumentHandle);
+   if (session && (session->slot == slot)) return Pro8_Unlock (instrumentHandle, VI_SUCCESS);
    //Formatting
-   Fmt (buffer, ":SLOT %d", slot);
+   Pro8_Fmt (buffer, ":SLOT %d", slot);
    //Writing - Poll STB - Check EAV Bit and read error
-   if ((status = viWrite (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
+   if (session) session->slot = session->port = 0;
+   if ((status = Pro8_Write (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
+   //Store Data
+   if (session) session->slot = slot;
    //Ready
-   return status;
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
@@ -186,20 +1046,32 @@ ViStatus _VI_FUNC Pro8_SetSlot (ViSession instrumentHandle, ViInt16 slot)
 //---------------------------------------------------------------------------
 ViStatus _VI_FUNC Pro8_GetSlot (ViSession instrumentHandle, ViInt16 *slot)
 {
-   ViStatus  status = VI_SUCCESS;
-   ViUInt32  retCnt = 0;
-   ViUInt16  stb;
-   ViBoolean answer;
-   ViString  format[] = {"%*s %d", "%d"};
-
-   if ((status = viGetAttribute (instrumentHandle, VI_ATTR_USER_DATA, &answer)) < 0) return status;
+   ViStatus       status   = VI_SUCCESS;
+   ViUInt32       retCnt   = 0;
+   ViUInt16       stb;
+   ViBoolean      answer;
+   ViString       format[] = {"%*s %d", "%d"};
+   Pro8_tSession  *session;
+
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   //Active slot is known
+   session = Pro8_GetSession (instrumentHandle);
+   if (session && session->slot)
+   {
+      *slot = session->slot;
+      return Pro8_Unlock (instrumentHandle, VI_SUCCESS);
+   }
+   if ((status = Pro8_GetAnswer (instrumentHandle, &answer)) < 0) return Pro8_Unlock (instrumentHandle, status);
    //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, ":SLOT?", 6, &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format[answer], slot)) < 0) return status;
+   if ((status = Pro8_Write (instrumentHandle, ":SLOT?", 6, &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
+   if ((status = Pro8_Scanf (instrumentHandle, format[answer], slot)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Store Data
+   if (session) session->slot = *slot;
    //Ready
-   return status;
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
@@ -208,21 +1080,30 @@ ViStatus _VI_FUNC Pro8_GetSlot (ViSession instrumentHandle, ViInt16 *slot)
 //---------------------------------------------------------------------------
 ViStatus _VI_FUNC Pro8_SetPort (ViSession instrumentHandle, ViInt16 port)
 {
-   ViStatus status = VI_SUCCESS;
-   ViUInt32 retCnt = 0;
-   ViUInt16 stb;
-   ViChar   buffer[CMD_BUF_SIZE];
+   ViStatus       status   = VI_SUCCESS;
+   ViUInt32       retCnt   = 0;
+   ViUInt16       stb;
+   ViChar         buffer[CMD_BUF_SIZE];
+   Pro8_tSession  *session;
 
    //Check input parameter ranges
    if (Pro8_invalidViInt16Range (port, 1, 8)) return VI_ERROR_PARAMETER2;
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   //Port is already active
+   session = Pro8_GetSession (instrumentHandle);
+   if (session && (session->port == port)) return Pro8_Unlock (instrumentHandle, VI_SUCCESS);
    //Formatting
-   Fmt (buffer, ":PORT %d", port);
+   Pro8_Fmt (buffer, ":PORT %d", port);
    //Writing - Poll STB - Check EAV Bit and read error
-   if ((status = viWrite (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
+   if (session) session->port = 0;
+   if ((status = Pro8_Write (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
+   //Store Data
+   if (session) session->port = port;
    //Ready
-   return status;
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
@@ -231,20 +1112,32 @@ ViStatus _VI_FUNC Pro8_SetPort (ViSession instrumentHandle, ViInt16 port)
 //---------------------------------------------------------------------------
 ViStatus _VI_FUNC Pro8_GetPort (ViSession instrumentHandle, ViInt16 *port)
 {
-   ViStatus  status = VI_SUCCESS;
-   ViUInt32  retCnt = 0;
-   ViUInt16  stb;
-   ViBoolean answer;
-   ViString  format[] = {"%*s %d", "%d"};
-
-   if ((status = viGetAttribute (instrumentHandle, VI_ATTR_USER_DATA, &answer)) < 0) return status;
+   ViStatus       status   = VI_SUCCESS;
+   ViUInt32       retCnt   = 0;
+   ViUInt16       stb;
+   ViBoolean      answer;
+   ViString       format[] = {"%*s %d", "%d"};
+   Pro8_tSession  *session;
+
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   //Active port is known
+   session = Pro8_GetSession (instrumentHandle);
+   if (session && session->port)
+   {
+      *port = session->port;
+      return Pro8_Unlock (instrumentHandle, VI_SUCCESS);
+   }
+   if ((status = Pro8_GetAnswer (instrumentHandle, &answer)) < 0) return Pro8_Unlock (instrumentHandle, status);
    //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, ":PORT?", 6, &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format[answer], port)) < 0) return status;
+   if ((status = Pro8_Write (instrumentHandle, ":PORT?", 6, &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
+   if ((status = Pro8_Scanf (instrumentHandle, format[answer], port)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Store Data
+   if (session) session->port = *port;
    //Ready
-   return status;
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
@@ -259,14 +1152,16 @@ ViStatus _VI_FUNC Pro8_GetDESR (ViSession instrumentHandle, ViInt32 *deviceError
    ViBoolean answer;
    ViString  format[] = {"%*s %ld", "%ld"};
 
-   if ((status = viGetAttribute (instrumentHandle, VI_ATTR_USER_DATA, &answer)) < 0) return status;
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   if ((status = Pro8_GetAnswer (instrumentHandle, &answer)) < 0) return Pro8_Unlock (instrumentHandle, status);
    //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, ":STAT:DESR?", 11, &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format[answer], deviceErrorSummaryRegister)) < 0) return status;
+   if ((status = Pro8_Write (instrumentHandle, ":STAT:DESR?", 11, &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
+   if ((status = Pro8_Scanf (instrumentHandle, format[answer], deviceErrorSummaryRegister)) < 0) return Pro8_Unlock (instrumentHandle, status);
    //Ready
-   return status;
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
@@ -282,14 +1177,16 @@ ViStatus _VI_FUNC Pro8_SetDESE (ViSession instrumentHandle, ViInt32 devErrorEven
 
    //Check input parameter ranges
    if (Pro8_invalidViInt32Range (devErrorEventSumReg, 0, 255)) return VI_ERROR_PARAMETER2;
+   //Lock session
+   Pro8_Lock (instrumentHandle);
    //Formatting
-   Fmt (buffer, ":STAT:DESE %d", devErrorEventSumReg);
+   Pro8_Fmt (buffer, ":STAT:DESE %d", devErrorEventSumReg);
    //Writing - Poll STB - Check EAV Bit and read error
-   if ((status = viWrite (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
+   if ((status = Pro8_Write (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
    //Ready
-   return status;
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
@@ -304,14 +1201,16 @@ ViStatus _VI_FUNC Pro8_GetDESE (ViSession instrumentHandle, ViInt32 *devErrorSum
    ViBoolean answer;
    ViString  format[] = {"%*s %ld", "%ld"};
 
-   if ((status = viGetAttribute (instrumentHandle, VI_ATTR_USER_DATA, &answer)) < 0) return status;
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   if ((status = Pro8_GetAnswer (instrumentHandle, &answer)) < 0) return Pro8_Unlock (instrumentHandle, status);
    //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, ":STAT:DESE?", 11, &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format[answer], devErrorSumEnableRegister)) < 0) return status;
+   if ((status = Pro8_Write (instrumentHandle, ":STAT:DESE?", 11, &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
+   if ((status = Pro8_Scanf (instrumentHandle, format[answer], devErrorSumEnableRegister)) < 0) return Pro8_Unlock (instrumentHandle, status);
    //Ready
-   return status;
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
@@ -327,18 +1226,20 @@ ViStatus _VI_FUNC Pro8_GetDEC (ViSession instrumentHandle, ViInt16 slot, ViInt32
    ViBoolean answer;
    ViString  format[] = {"%*s %ld", "%ld"};
 
-   if ((status = viGetAttribute (instrumentHandle, VI_ATTR_USER_DATA, &answer)) < 0) return status;
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   if ((status = Pro8_GetAnswer (instrumentHandle, &answer)) < 0) return Pro8_Unlock (instrumentHandle, status);
    //Check input parameter ranges
-   if (Pro8_invalidViInt16Range (slot, 1, 8)) return VI_ERROR_PARAMETER2;
+   if (Pro8_invalidViInt16Range (slot, 1, 8)) return Pro8_Unlock (instrumentHandle, VI_ERROR_PARAMETER2);
    //Formatting
-   Fmt (buffer, ":STAT:DEC%d?", slot);
+   Pro8_Fmt (buffer, ":STAT:DEC%d?", slot);
    //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format[answer], deviceErrorConditionRegister)) < 0) return status;
+   if ((status = Pro8_Write (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
+   if ((status = Pro8_Scanf (instrumentHandle, format[answer], deviceErrorConditionRegister)) < 0) return Pro8_Unlock (instrumentHandle, status);
    //Ready
-   return status;
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
@@ -354,18 +1255,20 @@ ViStatus _VI_FUNC Pro8_GetDEE (ViSession instrumentHandle, ViInt16 slot, ViInt32
    ViBoolean answer;
    ViString  format[] = {"%*s %ld", "%ld"};
 
-   if ((status = viGetAttribute (instrumentHandle, VI_ATTR_USER_DATA, &answer)) < 0) return status;
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   if ((status = Pro8_GetAnswer (instrumentHandle, &answer)) < 0) return Pro8_Unlock (instrumentHandle, status);
    //Check input parameter ranges
-   if (Pro8_invalidViInt16Range (slot, 1, 8)) return VI_ERROR_PARAMETER2;
+   if (Pro8_invalidViInt16Range (slot, 1, 8)) return Pro8_Unlock (instrumentHandle, VI_ERROR_PARAMETER2);
    //Formatting
-   Fmt (buffer, ":STAT:DEE%d?", slot);
+   Pro8_Fmt (buffer, ":STAT:DEE%d?", slot);
    //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format[answer], deviceErrorEventRegister)) < 0) return status;
+   if ((status = Pro8_Write (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
+   if ((status = Pro8_Scanf (instrumentHandle, format[answer], deviceErrorEventRegister)) < 0) return Pro8_Unlock (instrumentHandle, status);
    //Ready
-   return status;
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
@@ -382,14 +1285,16 @@ ViStatus _VI_FUNC Pro8_SetEDE (ViSession instrumentHandle, ViInt16 slot, ViInt32
    //Check input parameter ranges
    if (Pro8_invalidViInt16Range (slot, 1, 8)) return VI_ERROR_PARAMETER2;
    if (Pro8_invalidViInt32Range (devErrorEventEnableReg, 0, 65535)) return VI_ERROR_PARAMETER3;
+   //Lock session
+   Pro8_Lock (instrumentHandle);
    //Formatting
-   Fmt (buffer, ":STAT:EDE%d %d", slot, devErrorEventEnableReg);
+   Pro8_Fmt (buffer, ":STAT:EDE%d %d", slot, devErrorEventEnableReg);
    //Writing - Poll STB - Check EAV Bit and read error
-   if ((status = viWrite (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
+   if ((status = Pro8_Write (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
    //Ready
-   return status;
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
@@ -405,18 +1310,20 @@ ViStatus _VI_FUNC Pro8_GetEDE (ViSession instrumentHandle, ViInt16 slot, ViInt32
    ViBoolean answer;
    ViString  format[] = {"%*s %ld", "%ld"};
 
-   if ((status = viGetAttribute (instrumentHandle, VI_ATTR_USER_DATA, &answer)) < 0) return status;
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   if ((status = Pro8_GetAnswer (instrumentHandle, &answer)) < 0) return Pro8_Unlock (instrumentHandle, status);
    //Check input parameter ranges
-   if (Pro8_invalidViInt16Range (slot, 1, 8)) return VI_ERROR_PARAMETER2;
+   if (Pro8_invalidViInt16Range (slot, 1, 8)) return Pro8_Unlock (instrumentHandle, VI_ERROR_PARAMETER2);
    //Formatting
-   Fmt (buffer, ":STAT:EDE%d?", slot);
+   Pro8_Fmt (buffer, ":STAT:EDE%d?", slot);
    //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format[answer], devErrorEventEnableRegister)) < 0) return status;
+   if ((status = Pro8_Write (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
+   if ((status = Pro8_Scanf (instrumentHandle, format[answer], devErrorEventEnableRegister)) < 0) return Pro8_Unlock (instrumentHandle, status);
    //Ready
-   return status;
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
@@ -431,14 +1338,16 @@ ViStatus _VI_FUNC Pro8_GetBFC (ViSession instrumentHandle, ViInt32 *blockFunctio
    ViBoolean answer;
    ViString  format[] = {"%*s %ld", "%ld"};
 
-   if ((status = viGetAttribute (instrumentHandle, VI_ATTR_USER_DATA, &answer)) < 0) return status;
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   if ((status = Pro8_GetAnswer (instrumentHandle, &answer)) < 0) return Pro8_Unlock (instrumentHandle, status);
    //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, ":STAT:BFC?", 10, &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format[answer], blockFunctionCondRegister)) < 0) return status;
+   if ((status = Pro8_Write (instrumentHandle, ":STAT:BFC?", 10, &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
+   if ((status = Pro8_Scanf (instrumentHandle, format[answer], blockFunctionCondRegister)) < 0) return Pro8_Unlock (instrumentHandle, status);
    //Ready
-   return status;
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
@@ -453,14 +1362,16 @@ ViStatus _VI_FUNC Pro8_GetBFR (ViSession instrumentHandle, ViInt32 *blockFunctio
    ViBoolean answer;
    ViString  format[] = {"%*s %ld", "%ld"};
 
-   if ((status = viGetAttribute (instrumentHandle, VI_ATTR_USER_DATA, &answer)) < 0) return status;
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   if ((status = Pro8_GetAnswer (instrumentHandle, &answer)) < 0) return Pro8_Unlock (instrumentHandle, status);
    //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, ":STAT:BFR?", 10, &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format[answer], blockFunctionEventRegister)) < 0) return status;
+   if ((status = Pro8_Write (instrumentHandle, ":STAT:BFR?", 10, &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
+   if ((status = Pro8_Scanf (instrumentHandle, format[answer], blockFunctionEventRegister)) < 0) return Pro8_Unlock (instrumentHandle, status);
    //Ready
-   return status;
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
@@ -476,14 +1387,16 @@ ViStatus _VI_FUNC Pro8_SetBFE (ViSession instrumentHandle, ViInt32 blockFunction
 
    //Check input parameter ranges
    if (Pro8_invalidViInt32Range (blockFunctionEnableRegister, 0, 255)) return VI_ERROR_PARAMETER2;
+   //Lock session
+   Pro8_Lock (instrumentHandle);
    //Formatting
-   Fmt (buffer, ":STAT:BFE %d", blockFunctionEnableRegister);
+   Pro8_Fmt (buffer, ":STAT:BFE %d", blockFunctionEnableRegister);
    //Writing - Poll STB - Check EAV Bit and read error
-   if ((status = viWrite (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
+   if ((status = Pro8_Write (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
    //Ready
-   return status;
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
@@ -498,14 +1411,16 @@ ViStatus _VI_FUNC Pro8_GetBFE (ViSession instrumentHandle, ViInt32 *blockFunctio
    ViBoolean answer;
    ViString  format[] = {"%*s %ld", "%ld"};
 
-   if ((status = viGetAttribute (instrumentHandle, VI_ATTR_USER_DATA, &answer)) < 0) return status;
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   if ((status = Pro8_GetAnswer (instrumentHandle, &answer)) < 0) return Pro8_Unlock (instrumentHandle, status);
    //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, ":STAT:BFE?", 10, &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format[answer], blockFunctionEnableRegister)) < 0) return status;
+   if ((status = Pro8_Write (instrumentHandle, ":STAT:BFE?", 10, &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
+   if ((status = Pro8_Scanf (instrumentHandle, format[answer], blockFunctionEnableRegister)) < 0) return Pro8_Unlock (instrumentHandle, status);
    //Ready
-   return status;
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
@@ -514,12 +1429,22 @@ ViStatus _VI_FUNC Pro8_GetBFE (ViSession instrumentHandle, ViInt32 *blockFunctio
 //---------------------------------------------------------------------------
 ViStatus _VI_FUNC Pro8_writeInstrData (ViSession instrumentHandle, ViString writeBuffer)
 {
-   ViStatus status = VI_SUCCESS;
+   ViStatus       status   = VI_SUCCESS;
+   ViUInt32       retCnt   = 0;
+   Pro8_tSession  *session;
 
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   //Send collected commands first - the command may change slot or port
+   if ((session = Pro8_GetSession (instrumentHandle)) != VI_NULL)
+   {
+      Pro8_FlushBatch (instrumentHandle, session);
+      Pro8_InvalidateSession (session);
+   }
    //Writing
-   if ((status = viPrintf (instrumentHandle, "%s", writeBuffer)) < 0) return status;
+   if ((status = Pro8_Send (instrumentHandle, writeBuffer, StringLength (writeBuffer), &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
    //Ready
-   return status;
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
@@ -531,10 +1456,12 @@ ViStatus _VI_FUNC Pro8_readInstrData (ViSession instrumentHandle, ViInt32 number
    ViStatus status = VI_SUCCESS;
    *numBytesRead   = 0L;
 
+   //Lock session
+   Pro8_Lock (instrumentHandle);
    //Reading
-   if ((status = viRead (instrumentHandle, readBuffer, numberBytesToRead, numBytesRead)) < 0) return status;
+   if ((status = Pro8_Read (instrumentHandle, readBuffer, numberBytesToRead, (ViPUInt32)numBytesRead)) < 0) return Pro8_Unlock (instrumentHandle, status);
    //Ready
-   return status;
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
@@ -546,7 +1473,9 @@ ViStatus _VI_FUNC Pro8_WaitForFinishedBit (ViSession instrumentHandle)
 {
    ViUInt16 stb;
 
-   return Pro8_WaitForFinBit (instrumentHandle, &stb);
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   return Pro8_Unlock (instrumentHandle, Pro8_WaitForFinBit (instrumentHandle, &stb));
 }
 
 //---------------------------------------------------------------------------
@@ -555,16 +1484,21 @@ ViStatus _VI_FUNC Pro8_WaitForFinishedBit (ViSession instrumentHandle)
 //---------------------------------------------------------------------------
 ViStatus _VI_FUNC Pro8_reset (ViSession instrumentHandle)
 {
-   ViStatus status = VI_SUCCESS;
-   ViUInt32 retCnt = 0;
-   ViUInt16 stb;
+   ViStatus       status   = VI_SUCCESS;
+   ViUInt32       retCnt   = 0;
+   ViUInt16       stb;
+   Pro8_tSession  *session;
 
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   //Instrument state is unknown after reset
+   if ((session = Pro8_GetSession (instrumentHandle)) != VI_NULL) Pro8_InvalidateSession (session);
    //Writing - Poll STB - Check EAV Bit and read error
-   if ((status = viWrite (instrumentHandle, "*RST", 4, &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
+   if ((status = Pro8_Write (instrumentHandle, "*RST", 4, &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
    //Ready
-   return status;
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
@@ -578,13 +1512,15 @@ ViStatus _VI_FUNC Pro8_selfTest (ViSession instrumentHandle, ViInt16 *selfTestRe
    ViStatus status = VI_SUCCESS;
    ViUInt16 stb;
 
+   //Lock session
+   Pro8_Lock (instrumentHandle);
    //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, "*TST?", 5, &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, "%d", selfTestResult)) < 0) return status;
+   if ((status = Pro8_Write (instrumentHandle, "*TST?", 5, &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
+   if ((status = Pro8_Scanf (instrumentHandle, "%d", selfTestResult)) < 0) return Pro8_Unlock (instrumentHandle, status);
    //Ready
-   return status;
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
@@ -600,24 +1536,26 @@ ViStatus _VI_FUNC Pro8_errorQuery (ViSession instrumentHandle, ViInt32 *errorCod
    ViBoolean answer;
    ViChar    msg[1024];
 
-   if ((status = viGetAttribute (instrumentHandle, VI_ATTR_USER_DATA, &answer)) < 0) return status;
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   if ((status = Pro8_GetAnswer (instrumentHandle, &answer)) < 0) return Pro8_Unlock (instrumentHandle, status);
    //Writing
-   if ((status = viWrite (instrumentHandle, ":SYST:ERR?", 10, &retCnt)) < 0) return status;
+   if ((status = Pro8_Write (instrumentHandle, ":SYST:ERR?", 10, &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
    //Poll STB
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
    //Reading
    if (answer)
    {
-      if ((status = viScanf (instrumentHandle, "%ld", errorCode)) < 0) return status;
+      if ((status = Pro8_Scanf (instrumentHandle, "%ld", errorCode)) < 0) return Pro8_Unlock (instrumentHandle, status);
       if (errorMessage) CopyString (errorMessage, 0, PRO8_ERR_NOT_AVAILABLE, 0, -1);
    }
    else
    {
-      if ((status = viScanf (instrumentHandle, "%ld, \"%[^\"]", errorCode, msg)) < 0) return status;
+      if ((status = Pro8_Scanf (instrumentHandle, "%ld, \"%[^\"]", errorCode, msg)) < 0) return Pro8_Unlock (instrumentHandle, status);
       if (errorMessage) CopyString (errorMessage, 0, msg, 0, -1);
    }
    //Ready
-   return status;
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
@@ -628,7 +1566,9 @@ ViStatus _VI_FUNC Pro8_errorQuery (ViSession instrumentHandle, ViInt32 *errorCod
 ViStatus _VI_FUNC Pro8_errorMessage (ViSession instrumentHandle, ViStatus statusCode, ViChar _VI_FAR message[])
 {
    ViStatus status = VI_SUCCESS;
+   ViSession rmSession = 0;
    ViInt16 i;
+   Pro8_tSession *session = Pro8_GetSession (instrumentHandle);
 
    static Pro8_tStringValPair statusDescArray[] =
    {
@@ -653,6 +1593,20 @@ ViStatus _VI_FUNC Pro8_errorMessage (ViSession instrumentHandle, ViStatus status
       {VI_ERROR_INSTR_INTERPRETING_RESPONSE, "ERROR: Interpreting the instrument's response"                         },
       {VI_ERROR_POLL_FIN_BIT,                "ERROR: Polling FIN Bit"                                                },
       {VI_ERROR_GET_INSTR_ERROR,             "ERROR: Query Instrument Error Queue"                                   },
+      {VI_ERROR_NO_SESSION_CONTEXT,          "ERROR: Session was not opened by Pro8_init"                            },
+      {VI_ERROR_SESSION_TABLE_FULL,          "ERROR: Too many sessions opened by Pro8_init"                          },
+      {VI_ERROR_BATCH_STATE,                 "ERROR: Command batch not started or already started"                   },
+      {VI_ERROR_COMMAND_NOT_LOGGED,          "ERROR: Command is not in the command log"                              },
+      {VI_ERROR_ASYNC_QUEUE_FULL,            "ERROR: Too many asynchronous operations pending"                       },
+      {VI_ERROR_POOL_TABLE_FULL,             "ERROR: Too many pools opened by Pro8_PoolOpen"                         },
+      {VI_ERROR_STREAM_STATE,                "ERROR: Stream not started or already started"                          },
+      {VI_ERROR_CONSUMER_TABLE_FULL,         "ERROR: Too many consumers attached to the stream"                      },
+      {VI_ERROR_STREAM_OVERRUN,              "ERROR: Stream samples were overwritten while they were read"           },
+      {VI_ERROR_SETPOINT_TABLE_FULL,         "ERROR: Too many setpoint channels opened by Pro8_SetpointOpen"         },
+      {VI_ERROR_VALUE_OUT_OF_LIMITS,         "ERROR: Value outside the limits of the module"                         },
+      {VI_ERROR_METRICS_STATE,               "ERROR: Metrics socket not started or already started"                  },
+      {VI_ERROR_WAVEFORM_STATE,              "ERROR: Waveform not started or still playing"                          },
+      {VI_ERROR_LOOP_STATE,                  "ERROR: Control loop not started or already started"                    },
       //Instrument specific error codes
       {PRO8_ERR_NO_ERROR,                    "ERROR: No Error"                                                       },
       {PRO8_ERR_UNKNOWN_COMMAND,             "ERROR: Unknown command"                                                },
@@ -762,8 +1716,16 @@ ViStatus _VI_FUNC Pro8_errorMessage (ViSession instrumentHandle, ViStatus status
       //Additional module specific errors
       {VI_NULL, VI_NULL}
    };
-   //Search
-   status = viStatusDesc (instrumentHandle, statusCode, message);
+   //Search - driver transports have no VISA session, VISA codes are described by the resource manager
+   if (session && session->transport->close)
+   {
+      if ((status = viOpenDefaultRM (&rmSession)) >= 0)
+      {
+         status = viStatusDesc (rmSession, statusCode, message);
+         viClose (rmSession);
+      }
+   }
+   else status = viStatusDesc (instrumentHandle, statusCode, message);
    if (status == VI_WARN_UNKNOWN_STATUS)
    {
       for (i=0; statusDescArray[i].stringName; i++)
@@ -793,11 +1755,13 @@ ViStatus _VI_FUNC Pro8_identificationQuery (ViSession instrumentHandle, ViChar _
    ViUInt16 stb;
    ViChar   manuf[256], name[256], sn[256], rev[256];
 
+   //Lock session
+   Pro8_Lock (instrumentHandle);
    //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, "*IDN?", 5, &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, "%[^,], %[^,], %[^,], %[^\n]", manuf, name, sn, rev)) < 0) return status;
+   if ((status = Pro8_Write (instrumentHandle, "*IDN?", 5, &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
+   if ((status = Pro8_Scanf (instrumentHandle, "%[^,], %[^,], %[^,], %[^\n]", manuf, name, sn, rev)) < 0) return Pro8_Unlock (instrumentHandle, status);
    //Ready
    if (manufacturerName)         CopyString (manufacturerName, 0, manuf, 0, -1);
    if (instrumentName)           CopyString (instrumentName, 0, name, 0, -1);
@@ -805,7 +1769,7 @@ ViStatus _VI_FUNC Pro8_identificationQuery (ViSession instrumentHandle, ViChar _
    if (firmwareRevision)         CopyString (firmwareRevision, 0, rev, 0, -1);
 
    
-   return status;
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
@@ -815,160 +1779,100 @@ ViStatus _VI_FUNC Pro8_identificationQuery (ViSession instrumentHandle, ViChar _
 ViStatus _VI_FUNC Pro8_GetSlotConfiguration (ViSession instrumentHandle, ViPInt16 type1, ViPInt16 sub1, ViPInt16 type2, ViPInt16 sub2, ViPInt16 type3, ViPInt16 sub3, ViPInt16 type4, ViPInt16 sub4,
                      ViPInt16 type5, ViPInt16 sub5, ViPInt16 type6, ViPInt16 sub6, ViPInt16 type7, ViPInt16 sub7, ViPInt16 type8, ViPInt16 sub8)
 {
-   ViUInt32  retCnt = 0;
    ViStatus  status = VI_SUCCESS;
-   ViUInt16  stb;
-   ViInt16   t0, s0, t1, s1, t2, s2, t3, s3, t4, s4, t5, s5, t6, s6, t7, s7;
-   ViBoolean answer;
-   ViString  format[] = {"%*s %d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d", "%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d"};
-
-   if ((status = viGetAttribute (instrumentHandle, VI_ATTR_USER_DATA, &answer)) < 0) return status;
-   //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, ":CONFIG:PLUG?", 13, &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format[answer], &t0, &s0, &t1, &s1, &t2, &s2, &t3, &s3, &t4, &s4, &t5, &s5, &t6, &s6, &t7, &s7)) < 0) return status;
-
-   if(type1) *type1 = t0;
-   if(type2) *type2 = t1;
-   if(type3) *type3 = t2;
-   if(type4) *type4 = t3;
-   if(type5) *type5 = t4;
-   if(type6) *type6 = t5;
-   if(type7) *type7 = t6;
-   if(type8) *type8 = t7;
+   ViInt16   t[8], s[8];
+
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   //Reading - from the session if known
+   if ((status = Pro8_ReadPlugConfig (instrumentHandle, t, s)) < 0) return Pro8_Unlock (instrumentHandle, status);
+
+   if(type1) *type1 = t[0];
+   if(type2) *type2 = t[1];
+   if(type3) *type3 = t[2];
+   if(type4) *type4 = t[3];
+   if(type5) *type5 = t[4];
+   if(type6) *type6 = t[5];
+   if(type7) *type7 = t[6];
+   if(type8) *type8 = t[7];
    
-   if(sub1) *sub1 = s0;
-   if(sub2) *sub2 = s1;
-   if(sub3) *sub3 = s2;
-   if(sub4) *sub4 = s3;
-   if(sub5) *sub5 = s4;
-   if(sub6) *sub6 = s5;
-   if(sub7) *sub7 = s6;
-   if(sub8) *sub8 = s7;
+   if(sub1) *sub1 = s[0];
+   if(sub2) *sub2 = s[1];
+   if(sub3) *sub3 = s[2];
+   if(sub4) *sub4 = s[3];
+   if(sub5) *sub5 = s[4];
+   if(sub6) *sub6 = s[5];
+   if(sub7) *sub7 = s[6];
+   if(sub8) *sub8 = s[7];
    
    //Ready
-   return status;
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
 // Function: Slot Data Query
-// Purpose:  This function returns the slot data.
+// Purpose:  This function returns the slot data of the active slot. In
+//           metadata mode it is read once per module.
 //---------------------------------------------------------------------------
 ViStatus _VI_FUNC Pro8_SlotDataQuery (ViSession instrumentHandle, ViPInt16 type, ViPInt16 sub, ViChar _VI_FAR ident[], ViPInt16 opt1, ViPInt16 opt2,
                      ViPInt16 opt3, ViPInt16 opt4, ViPInt16 opt5, ViPInt16 opt6, ViPInt16 opt7, ViPInt16 opt8, ViPInt16 opt9, ViPInt16 opt10)
 {
-   ViStatus  status = VI_SUCCESS;
-   ViUInt32  retCnt = 0;
-   ViUInt16  stb;
-   ViInt16   o[10], t, s;
-   ViChar    id[256];
-   ViBoolean answer;
-   ViString  format1[] = {"%*s %d", "%d"};
-   ViString  format2[] = {"%*s %d", "%d"};
-   ViString  format3[] = {"%*s \"%[^\"]", "\"%[^\"]"};
-   ViString  format4[] = {"%*s %d,%d,%d,%d,%d,%d,%d,%d,%d,%d", "%d,%d,%d,%d,%d,%d,%d,%d,%d,%d"};
+   ViStatus       status   = VI_SUCCESS;
+   Pro8_tSlotInfo info;
 
-   if ((status = viGetAttribute (instrumentHandle, VI_ATTR_USER_DATA, &answer)) < 0) return status;
-   //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, ":TYPE:ID?", 9, &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format1[answer], &t)) < 0) return status;
-   //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, ":TYPE:SUB?", 10, &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format2[answer], &s)) < 0) return status;
-   //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, ":TYPE:TXT?", 10, &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format3[answer], id)) < 0) return status;
-   //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, ":TYPE:OPT?", 10, &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format4[answer], &o[0], &o[1], &o[2], &o[3], &o[4], &o[5], &o[6], &o[7], &o[8], &o[9])) < 0) return status;
-   //Ready
-   if(type)    *type  = t;
-   if(sub)     *sub   = s;
-   if(ident)   strcpy(ident, id);
-   if(opt1)    *opt1  = o[0];
-   if(opt2)    *opt2  = o[1];
-   if(opt3)    *opt3  = o[2];
-   if(opt4)    *opt4  = o[3];
-   if(opt5)    *opt5  = o[4];
-   if(opt6)    *opt6  = o[5];
-   if(opt7)    *opt7  = o[6];
-   if(opt8)    *opt8  = o[7];
-   if(opt9)    *opt9  = o[8];
-   if(opt10)   *opt10 = o[9];
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   //Reading - from the session if known
+   if ((status = Pro8_ReadSlotData (instrumentHandle, VI_FALSE, &info)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Ready
+   if(type)    *type  = info.type;
+   if(sub)     *sub   = info.sub;
+   if(ident)   strcpy(ident, info.ident);
+   if(opt1)    *opt1  = info.options[0];
+   if(opt2)    *opt2  = info.options[1];
+   if(opt3)    *opt3  = info.options[2];
+   if(opt4)    *opt4  = info.options[3];
+   if(opt5)    *opt5  = info.options[4];
+   if(opt6)    *opt6  = info.options[5];
+   if(opt7)    *opt7  = info.options[6];
+   if(opt8)    *opt8  = info.options[7];
+   if(opt9)    *opt9  = info.options[8];
+   if(opt10)   *opt10 = info.options[9];
 
-   return status;
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
 // Function: Slot Data Query Extended
-// Purpose:  This function returns the slot data in extended version.
+// Purpose:  This function returns the slot data of the active slot in
+//           extended version. In metadata mode it is read once per module.
 //---------------------------------------------------------------------------
 ViStatus _VI_FUNC Pro8_SlotDataQueryEx (ViSession instrumentHandle, ViPInt16 type, ViPInt16 sub, ViChar _VI_FAR ident[], ViChar _VI_FAR sernr[],
                      ViPInt16 opt1, ViPInt16 opt2, ViPInt16 opt3, ViPInt16 opt4, ViPInt16 opt5, ViPInt16 opt6, ViPInt16 opt7, ViPInt16 opt8, ViPInt16 opt9, ViPInt16 opt10)
 {
-   ViStatus  status = VI_SUCCESS;
-   ViUInt32  retCnt = 0;
-   ViUInt16  stb;
-   ViInt16   o[10], t, s;
-   ViChar    id[256], sn[256];
-   ViBoolean answer;
-   ViString  format1[] = {"%*s %d", "%d"};
-   ViString  format2[] = {"%*s %d", "%d"};
-   ViString  format3[] = {"%*s \"%[^\"]", "\"%[^\"]"};
-   ViString  format4[] = {"%*s %s", "%s"};
-   ViString  format5[] = {"%*s %d,%d,%d,%d,%d,%d,%d,%d,%d,%d", "%d,%d,%d,%d,%d,%d,%d,%d,%d,%d"};
+   ViStatus       status   = VI_SUCCESS;
+   Pro8_tSlotInfo info;
 
-   if ((status = viGetAttribute (instrumentHandle, VI_ATTR_USER_DATA, &answer)) < 0) return status;
-   //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, ":TYPE:ID?", 9, &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format1[answer], &t)) < 0) return status;
-   //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, ":TYPE:SUB?", 10, &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format2[answer], &s)) < 0) return status;
-   //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, ":TYPE:TXT?", 10, &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format3[answer], id)) < 0) return status;
-   //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, ":TYPE:SN?", 9, &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format4[answer], sn)) < 0) return status;
-   //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, ":TYPE:OPT?", 10, &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format5[answer], &o[0], &o[1], &o[2], &o[3], &o[4], &o[5], &o[6], &o[7], &o[8], &o[9])) < 0) return status;
-   //Ready
-   if(type)    *type  = t;
-   if(sub)     *sub   = s;
-   if(ident)   strcpy(ident, id);
-   if(sernr)   strcpy(sernr, sn);
-   if(opt1)    *opt1  = o[0];
-   if(opt2)    *opt2  = o[1];
-   if(opt3)    *opt3  = o[2];
-   if(opt4)    *opt4  = o[3];
-   if(opt5)    *opt5  = o[4];
-   if(opt6)    *opt6  = o[5];
-   if(opt7)    *opt7  = o[6];
-   if(opt8)    *opt8  = o[7];
-   if(opt9)    *opt9  = o[8];
-   if(opt10)   *opt10 = o[9];
-   return status;
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   //Reading - from the session if known
+   if ((status = Pro8_ReadSlotData (instrumentHandle, VI_TRUE, &info)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Ready
+   if(type)    *type  = info.type;
+   if(sub)     *sub   = info.sub;
+   if(ident)   strcpy(ident, info.ident);
+   if(sernr)   strcpy(sernr, info.serial);
+   if(opt1)    *opt1  = info.options[0];
+   if(opt2)    *opt2  = info.options[1];
+   if(opt3)    *opt3  = info.options[2];
+   if(opt4)    *opt4  = info.options[3];
+   if(opt5)    *opt5  = info.options[4];
+   if(opt6)    *opt6  = info.options[5];
+   if(opt7)    *opt7  = info.options[6];
+   if(opt8)    *opt8  = info.options[7];
+   if(opt9)    *opt9  = info.options[8];
+   if(opt10)   *opt10 = info.options[9];
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
@@ -981,17 +1885,19 @@ ViStatus _VI_FUNC Pro8_revisionQuery (ViSession instrumentHandle, ViChar _VI_FAR
    ViStatus status = VI_SUCCESS;
    ViUInt16 stb;
 
+   //Lock session
+   Pro8_Lock (instrumentHandle);
    if(firmwareRevision)
    {
       //Writing - Poll STB - Check EAV Bit and read error - Reading
-      if ((status = viWrite (instrumentHandle, "*IDN?", 5, &retCnt)) < 0) return status;
-      if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-      if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-      if ((status = viScanf (instrumentHandle, "%*[^,], %*[^,], %*[^,], %[^\n]", firmwareRevision)) < 0) return status;
+      if ((status = Pro8_Write (instrumentHandle, "*IDN?", 5, &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+      if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+      if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
+      if ((status = Pro8_Scanf (instrumentHandle, "%*[^,], %*[^,], %*[^,], %[^\n]", firmwareRevision)) < 0) return Pro8_Unlock (instrumentHandle, status);
    }
    if(instrumentDriverRevision) CopyString (instrumentDriverRevision, 0, PRO8_DRIVER_REVISION, 0, -1);
    //Ready
-   return status;
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
@@ -1000,22 +1906,30 @@ ViStatus _VI_FUNC Pro8_revisionQuery (ViSession instrumentHandle, ViChar _VI_FAR
 //---------------------------------------------------------------------------
 ViStatus _VI_FUNC Pro8_SetAnswerMode (ViSession instrumentHandle, ViBoolean answerMode)
 {
-   ViStatus status    = VI_SUCCESS;
-   ViUInt32 retCnt    = 0;
-   ViUInt16 stb;
-   ViString command[] = {":SYST:ANSW FULL", ":SYST:ANSW VALUE"};
+   ViStatus       status    = VI_SUCCESS;
+   ViUInt32       retCnt    = 0;
+   ViUInt16       stb;
+   ViString       command[] = {":SYST:ANSW FULL", ":SYST:ANSW VALUE"};
+   Pro8_tSession  *session;
 
    //Check input parameter ranges
    if (Pro8_invalidViBooleanRange (answerMode)) return VI_ERROR_PARAMETER2;
+   //Lock session
+   Pro8_Lock (instrumentHandle);
    //Writing
-   if ((status = viWrite (instrumentHandle, command[answerMode], StringLength (command[answerMode]), &retCnt)) < 0) return status;
-   //Store Data
-   if ((status = viSetAttribute (instrumentHandle, VI_ATTR_USER_DATA, (ViAttrState)answerMode)) < 0) return status;
+   if ((status = Pro8_Write (instrumentHandle, command[answerMode], StringLength (command[answerMode]), &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Store Data - in the VISA session for sessions without driver data
+   session = Pro8_GetSession (instrumentHandle);
+   if ((session == VI_NULL) || (session->transport == PRO8_VISA_TRANSPORT))
+   {
+      if ((status = viSetAttribute (instrumentHandle, VI_ATTR_USER_DATA, (ViAttrState)answerMode)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   }
+   if (session) session->answerMode = answerMode;
    //Poll STB - Check EAV Bit and read error
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
    //Ready
-   return status;
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
@@ -1025,24 +1939,32 @@ ViStatus _VI_FUNC Pro8_SetAnswerMode (ViSession instrumentHandle, ViBoolean answ
 //---------------------------------------------------------------------------
 ViStatus _VI_FUNC Pro8_GetAnswerMode (ViSession instrumentHandle, ViBoolean *answerMode)
 {
-   ViStatus status = VI_SUCCESS;
-   ViUInt32 retCnt = 0;
-   ViUInt16 stb;
-   ViChar   buffer[CMD_BUF_SIZE];
+   ViStatus       status   = VI_SUCCESS;
+   ViUInt32       retCnt   = 0;
+   ViUInt16       stb;
+   ViChar         buffer[CMD_BUF_SIZE];
+   Pro8_tSession  *session;
 
+   //Lock session
+   Pro8_Lock (instrumentHandle);
    //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, ":SYST:ANSW?", 11, &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, "%s", buffer)) < 0) return status;
+   if ((status = Pro8_Write (instrumentHandle, ":SYST:ANSW?", 11, &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
+   if ((status = Pro8_Scanf (instrumentHandle, "%s", buffer)) < 0) return Pro8_Unlock (instrumentHandle, status);
    //Evaluate
    if      (CompareStrings (":SYST:ANSW FULL",  0, buffer, 0, 0) == 0) *answerMode = 0;
    else if (CompareStrings ("VALUE", 0, buffer, 0, 0) == 0)            *answerMode = 1;
-   else return VI_ERROR_INSTR_INTERPRETING_RESPONSE;
-   //Store Data
-   if ((status = viSetAttribute (instrumentHandle, VI_ATTR_USER_DATA, (ViAttrState)answerMode)) < 0) return status;
+   else return Pro8_Unlock (instrumentHandle, VI_ERROR_INSTR_INTERPRETING_RESPONSE);
+   //Store Data - in the VISA session for sessions without driver data
+   session = Pro8_GetSession (instrumentHandle);
+   if ((session == VI_NULL) || (session->transport == PRO8_VISA_TRANSPORT))
+   {
+      if ((status = viSetAttribute (instrumentHandle, VI_ATTR_USER_DATA, (ViAttrState)*answerMode)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   }
+   if (session) session->answerMode = *answerMode;
    //Ready
-   return status;
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
@@ -1051,15 +1973,39 @@ ViStatus _VI_FUNC Pro8_GetAnswerMode (ViSession instrumentHandle, ViBoolean *ans
 //---------------------------------------------------------------------------
 ViStatus _VI_FUNC Pro8_close (ViSession instrumentHandle)
 {
-   ViSession rmSession;
-   ViStatus  status = VI_SUCCESS;
-   ViBoolean answer;
+   ViSession      rmSession;
+   ViStatus       status   = VI_SUCCESS;
+   ViBoolean      answer;
+   Pro8_tSession  *session;
 
+   //Finish asynchronous operations and transactions of other threads - send collected commands
+   if ((session = Pro8_GetSession (instrumentHandle)) != VI_NULL)
+   {
+      //Holds of the calling thread, e.g. by Pro8_LockSession - the stopped threads and Pro8_FreeSession wait for them
+      while (Pro8_LockOwner (session)) Pro8_Unlock (instrumentHandle, VI_SUCCESS);
+      Pro8_StreamFree (session);
+      Pro8_WaveformFree (session);
+      Pro8_LoopFree (session);
+      Pro8_SenderStop (session);
+      Pro8_AsyncStop (session);
+   }
+   Pro8_Lock (instrumentHandle);
+   if (session && session->batchActive) Pro8_CommitBatch (instrumentHandle);
    //Setting answer mode to full mode
-   if ((status = viGetAttribute (instrumentHandle, VI_ATTR_USER_DATA, &answer)) < 0) return status;
+   if ((status = Pro8_GetAnswer (instrumentHandle, &answer)) < 0) return Pro8_Unlock (instrumentHandle, status);
    if (answer) Pro8_SetAnswerMode (instrumentHandle, 0);
-   //closing
+   //Disable service requests
+   if (session) Pro8_EnableSrq (instrumentHandle, session, VI_FALSE);
+   Pro8_Unlock (instrumentHandle, status);
+   //closing - driver transports
+   if (session && session->transport->close)
+   {
+      session->transport->close (session);
+      Pro8_FreeSession (instrumentHandle);
+      return status;
+   }
    if ((status = viGetAttribute (instrumentHandle, VI_ATTR_RM_SESSION, &rmSession)) < 0) return status;
+   Pro8_FreeSession (instrumentHandle);
    status = viClose (instrumentHandle);
    viClose (rmSession);
    //Ready
@@ -1067,1663 +2013,2440 @@ ViStatus _VI_FUNC Pro8_close (ViSession instrumentHandle)
 }
 
 //===========================================================================
-// OSW MODULE FUNCTIONS
+// SESSION FUNCTIONS
 //===========================================================================
 //---------------------------------------------------------------------------
-// Function: Set State
-// Purpose:  This function sets the switch state
+// Function: Set Completion Mode
+// Purpose:  This function selects how the driver waits for the FIN bit
+//           after each command. PRO8_COMPLETION_POLL is the 50 ms polling
+//           of the driver versions up to 2.5.3, PRO8_COMPLETION_BACKOFF
+//           polls with a delay growing from 50 us to 5 ms and
+//           PRO8_COMPLETION_SRQ waits for the service request raised by
+//           the FIN bit. If the interface does not support service request
+//           events the session uses PRO8_COMPLETION_BACKOFF.
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_OswSetState (ViSession instrumentHandle, ViInt16 state)
+ViStatus _VI_FUNC Pro8_SetCompletionMode (ViSession instrumentHandle, ViInt16 completionMode)
 {
-   ViStatus status = VI_SUCCESS;
-   ViUInt32 retCnt = 0;
-   ViUInt16 stb;
-   ViChar   buffer[CMD_BUF_SIZE];
+   ViStatus       status   = VI_SUCCESS;
+   Pro8_tSession  *session;
 
    //Check input parameter ranges
-   if (Pro8_invalidViInt16Range (state, 1, 8)) return VI_ERROR_PARAMETER2;
-   //Formatting
-   Fmt (buffer, ":OSW %d", state);
-   //Writing - Poll STB - Check EAV Bit and read error
-   if ((status = viWrite (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
+   if (Pro8_invalidViInt16Range (completionMode, PRO8_COMPLETION_POLL, PRO8_COMPLETION_SRQ)) return VI_ERROR_PARAMETER2;
+   if ((session = Pro8_GetSession (instrumentHandle)) == VI_NULL) return VI_ERROR_NO_SESSION_CONTEXT;
+   Pro8_Lock (instrumentHandle);
+   //Service request
+   if ((status = Pro8_EnableSrq (instrumentHandle, session, (ViBoolean)(completionMode == PRO8_COMPLETION_SRQ))) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Store Data
+   if ((completionMode == PRO8_COMPLETION_SRQ) && (session->srqEnabled == VI_FALSE)) completionMode = PRO8_COMPLETION_BACKOFF;
+   session->completionMode = completionMode;
    //Ready
-   return status;
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get State
-// Purpose:  This function returns the switch state
+// Function: Get Completion Mode
+// Purpose:  This function returns the completion mode used by the session.
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_OswGetState (ViSession instrumentHandle, ViInt16 *state)
+ViStatus _VI_FUNC Pro8_GetCompletionMode (ViSession instrumentHandle, ViInt16 *completionMode)
 {
-   ViStatus  status = VI_SUCCESS;
-   ViUInt32  retCnt = 0;
-   ViUInt16  stb;
-   ViBoolean answer;
-   ViString  format[] = {"%*s %d", "%d"};
+   Pro8_tSession  *session;
 
-   if ((status = viGetAttribute (instrumentHandle, VI_ATTR_USER_DATA, &answer)) < 0) return status;
-   //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, ":OSW?", 5, &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format[answer], state)) < 0) return status;
+   if ((session = Pro8_GetSession (instrumentHandle)) == VI_NULL) return VI_ERROR_NO_SESSION_CONTEXT;
+   if (completionMode) *completionMode = session->completionMode;
    //Ready
-   return status;
+   return VI_SUCCESS;
 }
 
-//===========================================================================
-// LDC MODULE FUNCTIONS
-//===========================================================================
 //---------------------------------------------------------------------------
-// Function: Set Mode
-// Purpose:  This function sets the operation mode
+// Function: Get Last Wait Time
+// Purpose:  This function returns the time (seconds) the last command
+//           waited for the FIN bit and the moving average of this time.
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_LdcSetMode (ViSession instrumentHandle, ViInt16 mode)
+ViStatus _VI_FUNC Pro8_GetLastWaitTime (ViSession instrumentHandle, ViReal64 *lastWaitTime, ViReal64 *averageWaitTime)
 {
-   ViStatus status    = VI_SUCCESS;
-   ViUInt32 retCnt    = 0;
-   ViUInt16 stb;
-   ViString command[] = {":MODE CC", ":MODE CP"};
+   Pro8_tSession  *session;
 
-   //Check input parameter ranges
-   if (Pro8_invalidViInt16Range (mode, 0, 1)) return VI_ERROR_PARAMETER2;
-   //Writing - Poll STB - Check EAV Bit and read error
-   if ((status = viWrite (instrumentHandle, command[mode], StringLength (command[mode]), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
+   if ((session = Pro8_GetSession (instrumentHandle)) == VI_NULL) return VI_ERROR_NO_SESSION_CONTEXT;
+   if (lastWaitTime)    *lastWaitTime    = session->lastWait;
+   if (averageWaitTime) *averageWaitTime = session->averageWait;
    //Ready
-   return status;
+   return VI_SUCCESS;
 }
 
 //---------------------------------------------------------------------------
-// Function: Get Mode
-// Purpose:  This function returns the operation mode
+// Function: Begin Batch
+// Purpose:  This function starts a command batch. The setting commands of
+//           the following Pro8_* calls are collected and joined with ';'
+//           into compound commands that fit the instruments input buffer.
+//           A query sends the collected commands before it is written.
+//           The setting functions return VI_SUCCESS as soon as their
+//           command is collected, errors are returned by Pro8_CommitBatch.
+//           Only the commands of the calling thread are collected. Other
+//           threads, e.g. the stream, loop and waveform threads, send the
+//           collected commands first and then write their own at once.
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_LdcGetMode (ViSession instrumentHandle, ViInt16 *mode)
+ViStatus _VI_FUNC Pro8_BeginBatch (ViSession instrumentHandle)
 {
-   ViStatus  status = VI_SUCCESS;
-   ViUInt32  retCnt = 0;
-   ViUInt16  stb;
-   ViChar    buffer[CMD_BUF_SIZE];
-   ViBoolean answer;
-   ViString  format[] = {"%*s %s", "%s"};
+   Pro8_tSession  *session;
 
-   if ((status = viGetAttribute (instrumentHandle, VI_ATTR_USER_DATA, &answer)) < 0) return status;
-   //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, ":MODE?", 6, &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format[answer], buffer)) < 0) return status;
-   //Evaluate
-   if      (CompareStrings ("CC", 0, buffer, 0, 0) == 0) *mode = 0;
-   else if (CompareStrings ("CP", 0, buffer, 0, 0) == 0) *mode = 1;
-   else status = VI_ERROR_INSTR_INTERPRETING_RESPONSE;
+   if ((session = Pro8_GetSession (instrumentHandle)) == VI_NULL) return VI_ERROR_NO_SESSION_CONTEXT;
+   Pro8_Lock (instrumentHandle);
+   if (session->batchActive) return Pro8_Unlock (instrumentHandle, VI_ERROR_BATCH_STATE);
+   //Preset
+   session->batchActive  = VI_TRUE;
+   session->batchPending = VI_FALSE;
+   session->batchStatus  = VI_SUCCESS;
+   session->batchLength  = 0;
+   session->batchThread  = CmtGetCurrentThreadID ();
    //Ready
-   return status;
+   return Pro8_Unlock (instrumentHandle, VI_SUCCESS);
 }
 
 //---------------------------------------------------------------------------
-// Function: Set Laser Polarity
-// Purpose:  This function sets the polarity of the laserdiode
+// Function: Commit Batch
+// Purpose:  This function sends the commands collected since
+//           Pro8_BeginBatch, waits for the FIN bit and checks the error
+//           queue once. It returns the first error of the batch. If the
+//           instrument reports an error, the commands following the failed
+//           one in the same compound command may not have been executed.
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_LdcSetLdPol (ViSession instrumentHandle, ViInt16 polarity)
+ViStatus _VI_FUNC Pro8_CommitBatch (ViSession instrumentHandle)
 {
-   ViStatus status    = VI_SUCCESS;
-   ViUInt32 retCnt    = 0;
-   ViUInt16 stb;
-   ViString command[] = {":LDPOL CG", ":LDPOL AG"};
+   ViStatus       status   = VI_SUCCESS;
+   Pro8_tSession  *session;
 
-   //Check input parameter ranges
-   if (Pro8_invalidViInt16Range (polarity, 0, 1)) return VI_ERROR_PARAMETER2;
+   if ((session = Pro8_GetSession (instrumentHandle)) == VI_NULL) return VI_ERROR_NO_SESSION_CONTEXT;
+   Pro8_Lock (instrumentHandle);
+   if (session->batchActive == VI_FALSE) return Pro8_Unlock (instrumentHandle, VI_ERROR_BATCH_STATE);
    //Writing - Poll STB - Check EAV Bit and read error
-   if ((status = viWrite (instrumentHandle, command[polarity], StringLength (command[polarity]), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
+   Pro8_FlushBatch (instrumentHandle, session);
    //Ready
-   return status;
+   status = session->batchStatus;
+   session->batchActive  = VI_FALSE;
+   session->batchPending = VI_FALSE;
+   session->batchStatus  = VI_SUCCESS;
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get Laser Polarity
-// Purpose:  This function returns the polarity of the laserdiode
+// Function: Abort Batch
+// Purpose:  This function ends a command batch and discards the commands
+//           that were not sent yet.
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_LdcGetLdPol (ViSession instrumentHandle, ViInt16 *polarity)
+ViStatus _VI_FUNC Pro8_AbortBatch (ViSession instrumentHandle)
 {
-   ViStatus  status = VI_SUCCESS;
-   ViUInt32  retCnt = 0;
-   ViUInt16  stb;
-   ViChar    buffer[CMD_BUF_SIZE];
-   ViBoolean answer;
-   ViString  format[] = {"%*s %s", "%s"};
+   Pro8_tSession  *session;
 
-   if ((status = viGetAttribute (instrumentHandle, VI_ATTR_USER_DATA, &answer)) < 0) return status;
-   //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, ":LDPOL?", 7, &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format[answer], buffer)) < 0) return status;
-   //Evaluate
-   if      (CompareStrings ("CG", 0, buffer, 0, 0) == 0) *polarity = 0;
-   else if (CompareStrings ("AG", 0, buffer, 0, 0) == 0) *polarity = 1;
-   else status = VI_ERROR_INSTR_INTERPRETING_RESPONSE;
+   if ((session = Pro8_GetSession (instrumentHandle)) == VI_NULL) return VI_ERROR_NO_SESSION_CONTEXT;
+   Pro8_Lock (instrumentHandle);
+   if (session->batchActive == VI_FALSE) return Pro8_Unlock (instrumentHandle, VI_ERROR_BATCH_STATE);
+   //Discard - the cached state may belong to discarded commands
+   session->batchActive  = VI_FALSE;
+   session->batchPending = VI_FALSE;
+   session->batchStatus  = VI_SUCCESS;
+   session->batchLength  = 0;
+   Pro8_InvalidateSession (session);
    //Ready
-   return status;
+   return Pro8_Unlock (instrumentHandle, VI_SUCCESS);
 }
 
 //---------------------------------------------------------------------------
-// Function: Set Photodiode Polarity
-// Purpose:  This function sets the photodiode polarity
+// Function: Invalidate Cache
+// Purpose:  This function discards the active slot, active port, plug
+//           configuration, shadow model and slot data the driver keeps for
+//           the session. Call it when
+//           the instrument was changed by other means than this session,
+//           e.g. at the front panel.
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_LdcSetPdPol (ViSession instrumentHandle, ViInt16 polarity)
+ViStatus _VI_FUNC Pro8_InvalidateCache (ViSession instrumentHandle)
 {
-   ViStatus status    = VI_SUCCESS;
-   ViUInt32 retCnt    = 0;
-   ViUInt16 stb;
-   ViString command[] = {":PDPOL CG", ":PDPOL AG"};
+   Pro8_tSession  *session;
 
-   //Check input parameter ranges
-   if (Pro8_invalidViInt16Range (polarity, 0, 1)) return VI_ERROR_PARAMETER2;
-   //Writing - Poll STB - Check EAV Bit and read error
-   if ((status = viWrite (instrumentHandle, command[polarity], StringLength (command[polarity]), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
+   if ((session = Pro8_GetSession (instrumentHandle)) == VI_NULL) return VI_ERROR_NO_SESSION_CONTEXT;
+   Pro8_Lock (instrumentHandle);
+   Pro8_InvalidateSession (session);
+   memset (session->meta, 0, sizeof (session->meta));
    //Ready
-   return status;
+   return Pro8_Unlock (instrumentHandle, VI_SUCCESS);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get Photodiode Polarity
-// Purpose:  This function returns the photodiode polarity
+// Function: Set Error Check Mode
+// Purpose:  This function selects when the driver reads the instruments
+//           error queue. PRO8_ERROR_CHECK_IMMEDIATE waits for the FIN bit
+//           and checks the EAV bit after each command. In
+//           PRO8_ERROR_CHECK_DEFERRED mode setting commands return as soon
+//           as they are written. Errors are read by Pro8_SyncErrors and,
+//           if syncInterval (seconds) is not 0, by the first command
+//           written after the interval has elapsed. Queries still wait
+//           for their response.
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_LdcGetPdPol (ViSession instrumentHandle, ViInt16 *polarity)
+ViStatus _VI_FUNC Pro8_SetErrorCheckMode (ViSession instrumentHandle, ViInt16 errorCheckMode, ViReal64 syncInterval)
 {
-   ViStatus  status = VI_SUCCESS;
-   ViUInt32  retCnt = 0;
-   ViUInt16  stb;
-   ViChar    buffer[CMD_BUF_SIZE];
-   ViBoolean answer;
-   ViString  format[] = {"%*s %s", "%s"};
+   ViStatus       status   = VI_SUCCESS;
+   Pro8_tSession  *session;
 
-   if ((status = viGetAttribute (instrumentHandle, VI_ATTR_USER_DATA, &answer)) < 0) return status;
-   //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, ":PDPOL?", 7, &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format[answer], buffer)) < 0) return status;
-   //Evaluate
-   if      (CompareStrings ("CG", 0, buffer, 0, 0) == 0) *polarity = 0;
-   else if (CompareStrings ("AG", 0, buffer, 0, 0) == 0) *polarity = 1;
-   else status = VI_ERROR_INSTR_INTERPRETING_RESPONSE;
+   //Check input parameter ranges
+   if (Pro8_invalidViInt16Range (errorCheckMode, PRO8_ERROR_CHECK_IMMEDIATE, PRO8_ERROR_CHECK_DEFERRED)) return VI_ERROR_PARAMETER2;
+   if (Pro8_invalidViReal64Range (syncInterval, 0.0, 3600.0)) return VI_ERROR_PARAMETER3;
+   if ((session = Pro8_GetSession (instrumentHandle)) == VI_NULL) return VI_ERROR_NO_SESSION_CONTEXT;
+   Pro8_Lock (instrumentHandle);
+   //Errors of deferred commands are kept for Pro8_SyncErrors
+   if ((session->errorCheckMode == PRO8_ERROR_CHECK_DEFERRED) && (errorCheckMode == PRO8_ERROR_CHECK_IMMEDIATE))
+   {
+      if ((status = Pro8_CollectErrors (instrumentHandle, session)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   }
+   //Store Data
+   session->errorCheckMode = errorCheckMode;
+   session->syncInterval   = syncInterval;
+   session->lastSync       = Pro8_TimeNow ();
+   session->syncedSequence = session->sequence;
    //Ready
-   return status;
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
-// Function: Set Photodiode Bias
-// Purpose:  This function switches the photodiode bias
+// Function: Get Error Check Mode
+// Purpose:  This function returns the error check mode and the sync
+//           interval used by the session.
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_LdcSetBias (ViSession instrumentHandle, ViInt16 bias)
+ViStatus _VI_FUNC Pro8_GetErrorCheckMode (ViSession instrumentHandle, ViInt16 *errorCheckMode, ViReal64 *syncInterval)
 {
-   ViStatus status    = VI_SUCCESS;
-   ViUInt32 retCnt    = 0;
-   ViUInt16 stb;
-   ViString command[] = {":PDBIA OFF", ":PDBIA ON"};
+   Pro8_tSession  *session;
 
-   //Check input parameter ranges
-   if (Pro8_invalidViInt16Range (bias, 0, 1)) return VI_ERROR_PARAMETER2;
-   //Writing - Poll STB - Check EAV Bit and read error
-   if ((status = viWrite (instrumentHandle, command[bias], StringLength (command[bias]), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
+   if ((session = Pro8_GetSession (instrumentHandle)) == VI_NULL) return VI_ERROR_NO_SESSION_CONTEXT;
+   if (errorCheckMode) *errorCheckMode = session->errorCheckMode;
+   if (syncInterval)   *syncInterval   = session->syncInterval;
    //Ready
-   return status;
+   return VI_SUCCESS;
 }
 
 //---------------------------------------------------------------------------
-// Function: Get Photodiode Bias
-// Purpose:  This function returns the state of the photodiode bias
+// Function: Sync Errors
+// Purpose:  This function waits until all written commands are finished,
+//           reads the instruments error queue and returns the first
+//           instrument error found since the last call. firstSequence and
+//           lastSequence are the sequence numbers of the commands that were
+//           written between the last error free check and the check that
+//           found the error, one of them caused it (see Pro8_GetCommand).
+//           Both are 0 if there was no error.
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_LdcGetBias (ViSession instrumentHandle, ViInt16 *bias)
+ViStatus _VI_FUNC Pro8_SyncErrors (ViSession instrumentHandle, ViUInt32 *firstSequence, ViUInt32 *lastSequence)
 {
-   ViStatus  status = VI_SUCCESS;
-   ViUInt32  retCnt = 0;
-   ViUInt16  stb;
-   ViChar    buffer[CMD_BUF_SIZE];
-   ViBoolean answer;
-   ViString  format[] = {"%*s %s", "%s"};
+   ViStatus       status   = VI_SUCCESS;
+   Pro8_tSession  *session;
 
-   if ((status = viGetAttribute (instrumentHandle, VI_ATTR_USER_DATA, &answer)) < 0) return status;
-   //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, ":PDBIA?", 7, &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format[answer], buffer)) < 0) return status;
-   //Evaluate
-   if      (CompareStrings ("OFF", 0, buffer, 0, 0) == 0) *bias = 0;
-   else if (CompareStrings ("ON",  0, buffer, 0, 0) == 0) *bias = 1;
-   else status = VI_ERROR_INSTR_INTERPRETING_RESPONSE;
+   if ((session = Pro8_GetSession (instrumentHandle)) == VI_NULL) return VI_ERROR_NO_SESSION_CONTEXT;
+   Pro8_Lock (instrumentHandle);
+   //Send collected commands - Poll STB - Read errors
+   if (session->batchActive) Pro8_FlushBatch (instrumentHandle, session);
+   if ((status = Pro8_CollectErrors (instrumentHandle, session)) < 0) return Pro8_Unlock (instrumentHandle, status);
    //Ready
-   return status;
+   status = session->deferredStatus;
+   if (firstSequence) *firstSequence = session->deferredFirst;
+   if (lastSequence)  *lastSequence  = session->deferredLast;
+   session->deferredStatus = VI_SUCCESS;
+   session->deferredFirst  = 0;
+   session->deferredLast   = 0;
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
-// Function: Set Temperature Protection Slot
-// Purpose:  This function sets the slot for temperature protection
+// Function: Get Sequence Number
+// Purpose:  This function returns the sequence number of the last command
+//           written by the session. Each command written by a driver
+//           function gets the next number, starting with 1.
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_LdcSetTpSlot (ViSession instrumentHandle, ViInt16 slot)
+ViStatus _VI_FUNC Pro8_GetSequenceNumber (ViSession instrumentHandle, ViUInt32 *sequenceNumber)
 {
-   ViStatus status = VI_SUCCESS;
-   ViUInt32 retCnt = 0;
-   ViUInt16 stb;
-   ViChar   buffer[CMD_BUF_SIZE];
+   Pro8_tSession  *session;
 
-   //Check input parameter ranges
-   if (Pro8_invalidViInt16Range (slot, 1, 8)) return VI_ERROR_PARAMETER2;
-   //Formatting
-   Fmt (buffer, ":TPSLOT %d", slot);
-   //Writing - Poll STB - Check EAV Bit and read error
-   if ((status = viWrite (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
+   if ((session = Pro8_GetSession (instrumentHandle)) == VI_NULL) return VI_ERROR_NO_SESSION_CONTEXT;
+   if (sequenceNumber) *sequenceNumber = session->sequence;
    //Ready
-   return status;
+   return VI_SUCCESS;
 }
 
 //---------------------------------------------------------------------------
-// Function: Get Temperature Protection Slot
-// Purpose:  This function returns the slot used for temperature protection
+// Function: Get Command
+// Purpose:  This function returns the command with the given sequence
+//           number from the command log of the session. The log keeps the
+//           last PRO8_COMMAND_LOG_LENGTH (64) commands, truncated to 63
+//           characters. The command buffer must hold 64 characters.
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_LdcGetTpSlot (ViSession instrumentHandle, ViInt16 *slot)
+ViStatus _VI_FUNC Pro8_GetCommand (ViSession instrumentHandle, ViUInt32 sequenceNumber, ViChar _VI_FAR command[])
 {
-   ViStatus  status = VI_SUCCESS;
-   ViUInt32  retCnt = 0;
-   ViUInt16  stb;
-   ViBoolean answer;
-   ViString  format[] = {"%*s %d", "%d"};
+   Pro8_tLogEntry *entry;
+   Pro8_tSession  *session;
 
-   if ((status = viGetAttribute (instrumentHandle, VI_ATTR_USER_DATA, &answer)) < 0) return status;
-   //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, ":TPSLOT?", 8, &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format[answer], slot)) < 0) return status;
+   if ((session = Pro8_GetSession (instrumentHandle)) == VI_NULL) return VI_ERROR_NO_SESSION_CONTEXT;
+   Pro8_Lock (instrumentHandle);
+   entry = &session->log[sequenceNumber % PRO8_COMMAND_LOG_LENGTH];
+   if ((sequenceNumber == 0) || (entry->sequence != sequenceNumber)) return Pro8_Unlock (instrumentHandle, VI_ERROR_COMMAND_NOT_LOGGED);
+   if (command) CopyString (command, 0, entry->command, 0, -1);
    //Ready
-   return status;
+   return Pro8_Unlock (instrumentHandle, VI_SUCCESS);
 }
 
 //---------------------------------------------------------------------------
-// Function: Set Temperature Protection
-// Purpose:  This function switches the temperature protection
+// Function: Lock Session
+// Purpose:  This function starts a transaction. Each driver function holds
+//           the lock of its session while it writes commands and reads
+//           responses, so calls from several threads do not interleave.
+//           Between Pro8_LockSession and Pro8_UnlockSession other threads
+//           wait, e.g. to select a slot and read a value of this slot or to
+//           run a command batch. Calls can be nested and must be balanced.
+//           Pro8_close called by the holding thread releases its holds.
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_LdcSetTempProt (ViSession instrumentHandle, ViInt16 tempProtection)
+ViStatus _VI_FUNC Pro8_LockSession (ViSession instrumentHandle)
 {
-   ViStatus status    = VI_SUCCESS;
-   ViUInt32 retCnt    = 0;
-   ViUInt16 stb;
-   ViString command[] = {":TP OFF", ":TP ON"};
+   if (Pro8_GetSession (instrumentHandle) == VI_NULL) return VI_ERROR_NO_SESSION_CONTEXT;
+   Pro8_Lock (instrumentHandle);
+   //Ready
+   return VI_SUCCESS;
+}
 
-   //Check input parameter ranges
-   if (Pro8_invalidViInt16Range (tempProtection, 0, 1)) return VI_ERROR_PARAMETER2;
-   //Writing - Poll STB - Check EAV Bit and read error
-   if ((status = viWrite (instrumentHandle, command[tempProtection], StringLength (command[tempProtection]), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
+//---------------------------------------------------------------------------
+// Function: Unlock Session
+// Purpose:  This function ends a transaction started by Pro8_LockSession.
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_UnlockSession (ViSession instrumentHandle)
+{
+   if (Pro8_GetSession (instrumentHandle) == VI_NULL) return VI_ERROR_NO_SESSION_CONTEXT;
    //Ready
-   return status;
+   return Pro8_Unlock (instrumentHandle, VI_SUCCESS);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get Temperature Protection
-// Purpose:  This function returns the state of the temperature protection
+// Function: Get Lock Statistics
+// Purpose:  This function returns how often the lock of the session was
+//           acquired and how often a thread had to wait for it because
+//           another thread held it.
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_LdcGetTempProt (ViSession instrumentHandle, ViInt16 *temperatureProtection)
+ViStatus _VI_FUNC Pro8_GetLockStatistics (ViSession instrumentHandle, ViUInt32 *acquisitions, ViUInt32 *contentions)
 {
-   ViStatus  status = VI_SUCCESS;
-   ViUInt32  retCnt = 0;
-   ViUInt16  stb;
-   ViChar    buffer[CMD_BUF_SIZE];
-   ViBoolean answer;
-   ViString  format[] = {"%*s %s", "%s"};
+   Pro8_tSession  *session;
 
-   if ((status = viGetAttribute (instrumentHandle, VI_ATTR_USER_DATA, &answer)) < 0) return status;
-   //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, ":TP?", 4, &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format[answer], buffer)) < 0) return status;
-   //Evaluate
-   if      (CompareStrings ("OFF", 0, buffer, 0, 0) == 0) *temperatureProtection = 0;
-   else if (CompareStrings ("ON",  0, buffer, 0, 0) == 0) *temperatureProtection = 1;
-   else status = VI_ERROR_INSTR_INTERPRETING_RESPONSE;
+   if ((session = Pro8_GetSession (instrumentHandle)) == VI_NULL) return VI_ERROR_NO_SESSION_CONTEXT;
+   if (acquisitions) *acquisitions = session->acquisitions;
+   if (contentions)  *contentions  = session->contentions;
    //Ready
-   return status;
+   return VI_SUCCESS;
 }
 
 //---------------------------------------------------------------------------
-// Function: Set Laser Output
-// Purpose:  This function switches the output on or off
+// Function: Get Timestamp
+// Purpose:  This function returns the monotonic time (seconds) the driver
+//           uses for the timestamps of telemetry samples.
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_LdcSetLdOutput (ViSession instrumentHandle, ViInt16 output)
+ViStatus _VI_FUNC Pro8_GetTimestamp (ViReal64 *timestamp)
 {
-   ViStatus status    = VI_SUCCESS;
-   ViUInt32 retCnt    = 0;
-   ViUInt16 stb;
-   ViString command[] = {":LASER OFF", ":LASER ON"};
-
-   //Check input parameter ranges
-   if (Pro8_invalidViInt16Range (output, 0, 1)) return VI_ERROR_PARAMETER2;
-   //Writing - Poll STB - Check EAV Bit and read error
-   if ((status = viWrite (instrumentHandle, command[output], StringLength (command[output]), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
+   if (timestamp == VI_NULL) return VI_ERROR_PARAMETER1;
+   *timestamp = Pro8_TimeNow ();
    //Ready
-   return status;
+   return VI_SUCCESS;
 }
 
 //---------------------------------------------------------------------------
-// Function: Get Laser Output
-// Purpose:  This function returns the state of the output
+// Function: Get Init Statistics
+// Purpose:  This function returns the time Pro8_init or Pro8_InitFast took
+//           to open the session and if Pro8_InitFast attached to the
+//           instrument known from its cache file.
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_LdcGetLdOutput (ViSession instrumentHandle, ViInt16 *output)
+ViStatus _VI_FUNC Pro8_GetInitStatistics (ViSession instrumentHandle, ViReal64 *initTime, ViBoolean *attached)
 {
-   ViStatus  status = VI_SUCCESS;
-   ViUInt32  retCnt = 0;
-   ViUInt16  stb;
-   ViChar    buffer[CMD_BUF_SIZE];
-   ViBoolean answer;
-   ViString  format[] = {"%*s %s", "%s"};
+   Pro8_tSession  *session;
 
-   if ((status = viGetAttribute (instrumentHandle, VI_ATTR_USER_DATA, &answer)) < 0) return status;
-   //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, ":LASER?", 7, &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format[answer], buffer)) < 0) return status;
-   //Evaluate
-   if      (CompareStrings ("OFF", 0, buffer, 0, 0) == 0) *output = 0;
-   else if (CompareStrings ("ON",  0, buffer, 0, 0) == 0) *output = 1;
-   else status = VI_ERROR_INSTR_INTERPRETING_RESPONSE;
+   if ((session = Pro8_GetSession (instrumentHandle)) == VI_NULL) return VI_ERROR_NO_SESSION_CONTEXT;
+   if (initTime) *initTime = session->initTime;
+   if (attached) *attached = session->initAttached;
    //Ready
-   return status;
+   return VI_SUCCESS;
 }
 
 //---------------------------------------------------------------------------
-// Function: Set Calibration Factor
-// Purpose:  This function sets the calibration factor of the photodiode
+// Function: Set Shadow Mode
+// Purpose:  This function enables the shadow model of a session. Setting
+//           commands store their values per slot, getters of set values,
+//           limits and configuration (MIN, MAX, SET, polarity, sensor, ...)
+//           are answered from it without instrument I/O. A value not in
+//           the model is read once from the instrument. Actual values are
+//           always read. Values older than maxAge seconds (0 = no limit)
+//           are read again. Instrument errors and Pro8_InvalidateCache
+//           discard the model, Pro8_ShadowScrub compares it with the
+//           instrument, e.g. after changes at the front panel.
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_LdcSetCalibration (ViSession instrumentHandle, ViReal64 calibrationFactor)
+ViStatus _VI_FUNC Pro8_SetShadowMode (ViSession instrumentHandle, ViBoolean shadowMode, ViReal64 maxAge)
 {
-   ViStatus status = VI_SUCCESS;
-   ViUInt32 retCnt = 0;
-   ViUInt16 stb;
-   ViChar   buffer[CMD_BUF_SIZE];
+   Pro8_tSession  *session;
 
-   //Formatting
-   Fmt (buffer, ":CALPD:SET %f", calibrationFactor);
-   //Writing - Poll STB - Check EAV Bit and read error
-   if ((status = viWrite (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
+   //Check input parameter ranges
+   if (Pro8_invalidViBooleanRange (shadowMode))                  return VI_ERROR_PARAMETER2;
+   if (Pro8_invalidViReal64Range (maxAge, 0.0, 86400.0))         return VI_ERROR_PARAMETER3;
+   if ((session = Pro8_GetSession (instrumentHandle)) == VI_NULL) return VI_ERROR_NO_SESSION_CONTEXT;
+   Pro8_Lock (instrumentHandle);
+   if (shadowMode != session->shadowMode) Pro8_ShadowClear (session);
+   session->shadowMode   = shadowMode;
+   session->shadowMaxAge = maxAge;
    //Ready
-   return status;
+   return Pro8_Unlock (instrumentHandle, VI_SUCCESS);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get Calibration Factor
-// Purpose:  This function returns the calibration factor of the photodiode
+// Function: Get Shadow Mode
+// Purpose:  This function returns the shadow mode and max age of a session.
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_LdcGetCalibration (ViSession instrumentHandle, ViInt16 value, ViReal64 *calibrationfactor)
+ViStatus _VI_FUNC Pro8_GetShadowMode (ViSession instrumentHandle, ViBoolean *shadowMode, ViReal64 *maxAge)
 {
-   ViStatus  status = VI_SUCCESS;
-   ViUInt32  retCnt = 0;
-   ViUInt16  stb;
-   ViString  command[] = {":CALPD:MIN?", ":CALPD:MAX?", ":CALPD:SET?"};
-   ViBoolean answer;
-   ViString  format[] = {"%*s %LE", "%LE"};
+   Pro8_tSession  *session;
 
-   if ((status = viGetAttribute (instrumentHandle, VI_ATTR_USER_DATA, &answer)) < 0) return status;
-   //Check input parameter ranges
-   if (Pro8_invalidViInt16Range (value, 0, 2)) return VI_ERROR_PARAMETER2;
-   //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, command[value], StringLength (command[value]), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format[answer], calibrationfactor)) < 0) return status;
+   if ((session = Pro8_GetSession (instrumentHandle)) == VI_NULL) return VI_ERROR_NO_SESSION_CONTEXT;
+   if (shadowMode) *shadowMode = session->shadowMode;
+   if (maxAge)     *maxAge     = session->shadowMaxAge;
    //Ready
-   return status;
+   return VI_SUCCESS;
 }
 
 //---------------------------------------------------------------------------
-// Function: Set Laser Current
-// Purpose:  This function sets the current of the laserdiode
+// Function: Get Shadow Statistics
+// Purpose:  This function returns the number of queries answered by the
+//           shadow model and sent to the instrument and the number of
+//           values in the model.
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_LdcSetLdCurrent (ViSession instrumentHandle, ViReal64 current)
+ViStatus _VI_FUNC Pro8_GetShadowStatistics (ViSession instrumentHandle, ViUInt32 *hits, ViUInt32 *misses, ViInt32 *entries)
 {
-   ViStatus status = VI_SUCCESS;
-   ViUInt32 retCnt = 0;
-   ViUInt16 stb;
-   ViChar   buffer[CMD_BUF_SIZE];
+   ViInt32        i, n     = 0;
+   Pro8_tSession  *session;
 
-   //Formatting
-   Fmt (buffer, ":ILD:SET %f", current);
-   //Writing - Poll STB - Check EAV Bit and read error
-   if ((status = viWrite (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
+   if ((session = Pro8_GetSession (instrumentHandle)) == VI_NULL) return VI_ERROR_NO_SESSION_CONTEXT;
+   Pro8_Lock (instrumentHandle);
+   for (i = 0; i < PRO8_SHADOW_SIZE; i++)
+   {
+      if (session->shadow[i].slot) n++;
+   }
+   if (hits)    *hits    = session->shadowHits;
+   if (misses)  *misses  = session->shadowMisses;
+   if (entries) *entries = n;
+   //Ready
+   return Pro8_Unlock (instrumentHandle, VI_SUCCESS);
+}
+
+//---------------------------------------------------------------------------
+// Function: Shadow Scrub
+// Purpose:  This function reads all values of the shadow model from the
+//           instrument in compound queries and replaces them. mismatches
+//           returns the number of values that were different, e.g. changed
+//           at the front panel. Values whose query failed are discarded.
+//           Call it periodically to keep the model consistent.
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_ShadowScrub (ViSession instrumentHandle, ViInt32 *mismatches)
+{
+   ViStatus          status   = VI_SUCCESS;
+   ViInt32           index[PRO8_SHADOW_SIZE], entries[PRO8_SHADOW_SIZE];
+   ViInt16           slot[PRO8_SHADOW_SIZE];
+   ViString          commands[PRO8_SHADOW_SIZE];
+   ViStatus          results[PRO8_SHADOW_SIZE];
+   ViInt32           i, n     = 0, count = 0;
+   ViReal64          now, a, b;
+   ViBoolean         answer;
+   ViChar            value[PRO8_SHADOW_VALUE_WIDTH];
+   ViChar            *responses;
+   Pro8_tShadowEntry *entry;
+   Pro8_tPoolJob     job;
+   Pro8_tSession     *session;
+
+   if ((session = Pro8_GetSession (instrumentHandle)) == VI_NULL) return VI_ERROR_NO_SESSION_CONTEXT;
+   if (mismatches) *mismatches = 0;
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   if ((status = Pro8_GetAnswer (instrumentHandle, &answer)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Queries of the values in the model
+   for (i = 0; i < PRO8_SHADOW_SIZE; i++)
+   {
+      if (session->shadow[i].slot == 0) continue;
+      index[n]    = n;
+      entries[n]  = i;
+      slot[n]     = session->shadow[i].slot;
+      commands[n] = session->shadow[i].query;
+      n++;
+   }
+   if (n == 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((responses = (ViChar*)malloc (n * PRO8_ASYNC_RESPONSE_SIZE)) == VI_NULL) return Pro8_Unlock (instrumentHandle, VI_ERROR_ALLOC);
+   //Writing - Reading
+   memset (&job, 0, sizeof (job));
+   job.count     = n;
+   job.index     = index;
+   job.slot      = slot;
+   job.commands  = commands;
+   job.responses = responses;
+   job.results   = results;
+   status = Pro8_PoolRun (instrumentHandle, &job);
+   //Compare - replace, errors have discarded the model
+   now = Pro8_TimeNow ();
+   for (i = 0; i < n; i++)
+   {
+      entry = &session->shadow[entries[i]];
+      if (entry->slot == 0) continue;
+      if (results[i] < 0)
+      {
+         entry->slot = 0;
+         continue;
+      }
+      Pro8_ShadowValue (&responses[i * PRO8_ASYNC_RESPONSE_SIZE], answer, value, sizeof (value));
+      if (strcmp (value, entry->value) && ((Pro8_ParseReal (value, 1, &a) < 0) || (Pro8_ParseReal (entry->value, 1, &b) < 0) || (a != b))) count++;
+      strcpy (entry->value, value);
+      entry->time = now;
+   }
+   free (responses);
+   if (mismatches) *mismatches = count;
    //Ready
-   return status;
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get Laser Current
-// Purpose:  This function returns the current of the laserdiode
+// Function: Set Metadata Mode
+// Purpose:  This function enables the slot data of a session. The
+//           identification and options of a module (Pro8_SlotDataQuery) and
+//           its MIN/MAX limits are read once. Setting commands ":xxx:SET"
+//           with a value outside the limits are rejected with
+//           VI_ERROR_VALUE_OUT_OF_LIMITS before they are written. The plug
+//           configuration is queried at most every plugCheckInterval
+//           seconds (0 = after errors only), the data of a slot is dropped
+//           when its module changed. Configuration commands (e.g. sensor,
+//           range) drop the limits of their slot.
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_LdcGetLdCurrent (ViSession instrumentHandle, ViInt16 value, ViReal64 *current)
+ViStatus _VI_FUNC Pro8_SetMetadataMode (ViSession instrumentHandle, ViBoolean metadataMode, ViReal64 plugCheckInterval)
 {
-   ViStatus  status = VI_SUCCESS;
-   ViUInt32  retCnt = 0;
-   ViUInt16  stb;
-   ViString  command[] = {":ILD:MIN?", ":ILD:MAX?", ":ILD:SET?", ":ILD:ACT?"};
-   ViBoolean answer;
-   ViString  format[] = {"%*s %LE", "%LE"};
+   Pro8_tSession  *session;
 
-   if ((status = viGetAttribute (instrumentHandle, VI_ATTR_USER_DATA, &answer)) < 0) return status;
    //Check input parameter ranges
-   if (Pro8_invalidViInt16Range (value, 0, 3)) return VI_ERROR_PARAMETER2;
-   //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, command[value], StringLength (command[value]), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format[answer], current)) < 0) return status;
+   if (Pro8_invalidViBooleanRange (metadataMode))                    return VI_ERROR_PARAMETER2;
+   if (Pro8_invalidViReal64Range (plugCheckInterval, 0.0, 86400.0))  return VI_ERROR_PARAMETER3;
+   if ((session = Pro8_GetSession (instrumentHandle)) == VI_NULL)    return VI_ERROR_NO_SESSION_CONTEXT;
+   Pro8_Lock (instrumentHandle);
+   if (metadataMode != session->metadataMode) memset (session->meta, 0, sizeof (session->meta));
+   session->metadataMode      = metadataMode;
+   session->plugCheckInterval = plugCheckInterval;
    //Ready
-   return status;
+   return Pro8_Unlock (instrumentHandle, VI_SUCCESS);
 }
 
 //---------------------------------------------------------------------------
-// Function: Set Photodiode Current
-// Purpose:  This function sets the current of the photodiode
+// Function: Get Metadata Mode
+// Purpose:  This function returns the metadata mode and the plug check
+//           interval of a session.
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_LdcSetPdCurrent (ViSession instrumentHandle, ViReal64 current)
+ViStatus _VI_FUNC Pro8_GetMetadataMode (ViSession instrumentHandle, ViBoolean *metadataMode, ViReal64 *plugCheckInterval)
 {
-   ViStatus status = VI_SUCCESS;
-   ViUInt32 retCnt = 0;
-   ViUInt16 stb;
-   ViChar   buffer[CMD_BUF_SIZE];
+   Pro8_tSession  *session;
 
-   //Formatting
-   Fmt (buffer, ":IMD:SET %f", current);
-   //Writing - Poll STB - Check EAV Bit and read error
-   if ((status = viWrite (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
+   if ((session = Pro8_GetSession (instrumentHandle)) == VI_NULL) return VI_ERROR_NO_SESSION_CONTEXT;
+   if (metadataMode)      *metadataMode      = session->metadataMode;
+   if (plugCheckInterval) *plugCheckInterval = session->plugCheckInterval;
    //Ready
-   return status;
+   return VI_SUCCESS;
 }
 
 //---------------------------------------------------------------------------
-// Function: Get Photodiode Current
-// Purpose:  This function returns the current of the photodiode
+// Function: Get Slot Limits
+// Purpose:  This function returns the MIN/MAX limits of a parameter of a
+//           slot, e.g. ":ILD" or ":TEMP". In metadata mode the limits are
+//           read once per module. The active slot may change.
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_LdcGetPdCurrent (ViSession instrumentHandle, ViInt16 value, ViReal64 *current)
+ViStatus _VI_FUNC Pro8_GetSlotLimits (ViSession instrumentHandle, ViInt16 slot, ViString parameter, ViReal64 *minimum, ViReal64 *maximum)
 {
-   ViStatus  status = VI_SUCCESS;
-   ViUInt32  retCnt = 0;
-   ViUInt16  stb;
-   ViString  command[] = {":IMD:MIN?", ":IMD:MAX?", ":IMD:SET?", ":IMD:ACT?"};
-   ViBoolean answer;
-   ViString  format[] = {"%*s %LE", "%LE"};
+   ViStatus       status   = VI_SUCCESS;
+   Pro8_tLimit    limit;
+   Pro8_tSession  *session;
 
-   if ((status = viGetAttribute (instrumentHandle, VI_ATTR_USER_DATA, &answer)) < 0) return status;
    //Check input parameter ranges
-   if (Pro8_invalidViInt16Range (value, 0, 3)) return VI_ERROR_PARAMETER2;
-   //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, command[value], StringLength (command[value]), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format[answer], current)) < 0) return status;
+   if (Pro8_invalidViInt16Range (slot, 1, PRO8_NUM_SLOTS))                                        return VI_ERROR_PARAMETER2;
+   if ((parameter == VI_NULL) || (StringLength (parameter) >= PRO8_META_HEADER_WIDTH))            return VI_ERROR_PARAMETER3;
+   if ((session = Pro8_GetSession (instrumentHandle)) == VI_NULL)                                 return VI_ERROR_NO_SESSION_CONTEXT;
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   if ((status = Pro8_MetaLimit (instrumentHandle, slot, parameter, &limit)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (minimum) *minimum = limit.minimum;
+   if (maximum) *maximum = limit.maximum;
    //Ready
-   return status;
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
-// Function: Set Optical Power
-// Purpose:  This function sets the optical power
+// Function: Get Plug Checksum
+// Purpose:  This function returns the checksum of the plug configuration
+//           and the number of changes detected since the session was
+//           opened.
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_LdcSetPower (ViSession instrumentHandle, ViReal64 opticalPower)
+ViStatus _VI_FUNC Pro8_GetPlugChecksum (ViSession instrumentHandle, ViUInt32 *checksum, ViUInt32 *changes)
 {
-   ViStatus status = VI_SUCCESS;
-   ViUInt32 retCnt = 0;
-   ViUInt16 stb;
-   ViChar   buffer[CMD_BUF_SIZE];
+   ViStatus       status   = VI_SUCCESS;
+   Pro8_tSession  *session;
 
-   //Formatting
-   Fmt (buffer, ":POPT:SET %f", opticalPower);
-   //Writing - Poll STB - Check EAV Bit and read error
-   if ((status = viWrite (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
+   if ((session = Pro8_GetSession (instrumentHandle)) == VI_NULL) return VI_ERROR_NO_SESSION_CONTEXT;
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   if ((status = Pro8_MetaSlot (instrumentHandle, session)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (checksum) *checksum = session->plugChecksum;
+   if (changes)  *changes  = session->plugChanges;
    //Ready
-   return status;
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get Optical Power
-// Purpose:  This function returns the optical power
+// Function: Transport Ping
+// Purpose:  This function times count *IDN? transactions and returns the
+//           name of the transport of the session ("VISA", "USBTMC", "TTY"
+//           or "TCP") with the minimum, average and maximum round trip in
+//           seconds, to compare the transports of one instrument.
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_LdcGetPower (ViSession instrumentHandle, ViInt16 value, ViReal64 *opticalPower)
+ViStatus _VI_FUNC Pro8_TransportPing (ViSession instrumentHandle, ViInt32 count, ViChar _VI_FAR transport[], ViReal64 *minimum, ViReal64 *average, ViReal64 *maximum)
 {
-   ViStatus  status = VI_SUCCESS;
-   ViUInt32  retCnt = 0;
-   ViUInt16  stb;
-   ViString  command[] = {":POPT:MIN?", ":POPT:MAX?", ":POPT:SET?", ":POPT:ACT?"};
-   ViBoolean answer;
-   ViString  format[] = {"%*s %LE", "%LE"};
+   ViStatus       status   = VI_SUCCESS;
+   ViUInt32       retCnt   = 0;
+   ViUInt16       stb;
+   ViChar         response[RESPONSE_BUF_SIZE];
+   ViString       answers[1];
+   ViReal64       start, time, sum = 0.0, tMin = 0.0, tMax = 0.0;
+   ViInt32        i;
+   Pro8_tSession  *session;
 
-   if ((status = viGetAttribute (instrumentHandle, VI_ATTR_USER_DATA, &answer)) < 0) return status;
-   //Check input parameter ranges
-   if (Pro8_invalidViInt16Range (value, 0, 3)) return VI_ERROR_PARAMETER2;
-   //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, command[value], StringLength (command[value]), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format[answer], opticalPower)) < 0) return status;
+   if ((session = Pro8_GetSession (instrumentHandle)) == VI_NULL) return VI_ERROR_NO_SESSION_CONTEXT;
+   if (Pro8_invalidViInt32Range (count, 1, 100000)) return VI_ERROR_PARAMETER2;
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   for (i = 0; i < count; i++)
+   {
+      //Writing - Poll STB - Check EAV Bit and read error - Reading
+      start = Pro8_TimeNow ();
+      if ((status = Pro8_Write (instrumentHandle, "*IDN?", 5, &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+      if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+      if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
+      if ((status = Pro8_ReadAnswers (instrumentHandle, 1, response, sizeof (response), answers)) < 0) return Pro8_Unlock (instrumentHandle, status);
+      time = Pro8_TimeNow () - start;
+      //Statistics
+      if ((i == 0) || (time < tMin)) tMin = time;
+      if ((i == 0) || (time > tMax)) tMax = time;
+      sum += time;
+   }
+   if (transport) CopyString (transport, 0, session->transport->name, 0, -1);
+   if (minimum)   *minimum = tMin;
+   if (average)   *average = sum / count;
+   if (maximum)   *maximum = tMax;
    //Ready
-   return status;
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
+//===========================================================================
+// ASYNCHRONOUS FUNCTIONS
+//===========================================================================
 //---------------------------------------------------------------------------
-// Function: Set LD Limit Current
-// Purpose:  This function sets the limit current of the laser diode
+// Function: Asynchronous Call
+// Purpose:  This function schedules a call of function (instrumentHandle,
+//           data) on the I/O thread of the session and returns at once.
+//           The function may call any driver functions. The operations of
+//           a session are executed one after another in the order they
+//           were scheduled. When the operation is finished, callback is
+//           called on the I/O thread with its status. If future is not
+//           VI_NULL it returns a handle for Pro8_AsyncWait, Pro8_AsyncPoll
+//           and Pro8_AsyncGetResponse that must be released by
+//           Pro8_AsyncRelease, otherwise the operation is released when
+//           finished. Each operation is a transaction, see
+//           Pro8_LockSession.
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_LdcSetLdLimit (ViSession instrumentHandle, ViReal64 limitCurrent)
+ViStatus _VI_FUNC Pro8_AsyncCall (ViSession instrumentHandle, Pro8_AsyncFunction function, ViAddr data, Pro8_AsyncCallback callback, ViAddr callbackData, ViInt32 *future)
 {
-   ViStatus status = VI_SUCCESS;
-   ViUInt32 retCnt = 0;
-   ViUInt16 stb;
-   ViChar   buffer[CMD_BUF_SIZE];
+   Pro8_tFuture   request;
 
-   //Formatting
-   Fmt (buffer, ":LIMC:SET %f", limitCurrent);
-   //Writing - Poll STB - Check EAV Bit and read error
-   if ((status = viWrite (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   //Ready
-   return status;
+   //Check input parameter ranges
+   if (function == VI_NULL) return VI_ERROR_PARAMETER2;
+   //Schedule
+   memset (&request, 0, sizeof (Pro8_tFuture));
+   request.function     = function;
+   request.data         = data;
+   request.callback     = callback;
+   request.callbackData = callbackData;
+   return Pro8_AsyncSchedule (instrumentHandle, &request, future);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get LD Limit Current
-// Purpose:  This function returns the limit current of the laser diode
+// Function: Asynchronous Write
+// Purpose:  This function schedules a setting command like Pro8_AsyncCall.
+//           The I/O thread selects the slot (0 = active slot), writes the
+//           command, waits for the FIN bit and checks the error queue.
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_LdcGetLdLimit (ViSession instrumentHandle, ViInt16 value, ViReal64 *limitCurrent)
+ViStatus _VI_FUNC Pro8_AsyncWrite (ViSession instrumentHandle, ViInt16 slot, ViString command, Pro8_AsyncCallback callback, ViAddr callbackData, ViInt32 *future)
 {
-   ViStatus  status    = VI_SUCCESS;
-   ViUInt32  retCnt    = 0;
-   ViUInt16  stb;
-   ViString  command[] = {":LIMC:MIN?", ":LIMC:MAX?", ":LIMC:SET?"};
-   ViBoolean answer;
-   ViString  format[] = {"%*s %LE", "%LE"};
+   Pro8_tFuture   request;
 
-   if ((status = viGetAttribute (instrumentHandle, VI_ATTR_USER_DATA, &answer)) < 0) return status;
    //Check input parameter ranges
-   if (Pro8_invalidViInt16Range (value, 0, 2)) return VI_ERROR_PARAMETER2;
-   //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, command[value], StringLength (command[value]), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format[answer], limitCurrent)) < 0) return status;
-   //Ready
-   return status;
+   if (Pro8_invalidViInt16Range (slot, 0, PRO8_NUM_SLOTS)) return VI_ERROR_PARAMETER2;
+   if ((command == VI_NULL) || (StringLength (command) > PRO8_BATCH_MAX_LENGTH)) return VI_ERROR_PARAMETER3;
+   //Schedule
+   memset (&request, 0, sizeof (Pro8_tFuture));
+   request.slot         = slot;
+   request.callback     = callback;
+   request.callbackData = callbackData;
+   CopyString (request.command, 0, command, 0, -1);
+   return Pro8_AsyncSchedule (instrumentHandle, &request, future);
 }
 
 //---------------------------------------------------------------------------
-// Function: Set PD Limit Current
-// Purpose:  This function sets the limit current of the photo diode
+// Function: Asynchronous Query
+// Purpose:  This function schedules a query like Pro8_AsyncWrite. The
+//           response is returned by Pro8_AsyncGetResponse.
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_LdcSetPdLimit (ViSession instrumentHandle, ViReal64 limitCurrent)
+ViStatus _VI_FUNC Pro8_AsyncQuery (ViSession instrumentHandle, ViInt16 slot, ViString query, Pro8_AsyncCallback callback, ViAddr callbackData, ViInt32 *future)
 {
-   ViStatus status = VI_SUCCESS;
-   ViUInt32 retCnt = 0;
-   ViUInt16 stb;
-   ViChar   buffer[CMD_BUF_SIZE];
+   //Check input parameter ranges
+   if ((query == VI_NULL) || (strchr (query, '?') == VI_NULL)) return VI_ERROR_PARAMETER3;
+   //Schedule
+   return Pro8_AsyncWrite (instrumentHandle, slot, query, callback, callbackData, future);
+}
 
-   //Formatting
-   Fmt (buffer, ":LIMM:SET %f", limitCurrent);
-   //Writing - Poll STB - Check EAV Bit and read error
-   if ((status = viWrite (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
+//---------------------------------------------------------------------------
+// Function: Asynchronous Wait
+// Purpose:  This function waits until an asynchronous operation is finished
+//           and returns its status. If it is not finished within timeout
+//           (ms, negative = no timeout) VI_ERROR_TMO is returned.
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_AsyncWait (ViSession instrumentHandle, ViInt32 future, ViInt32 timeout)
+{
+   ViReal64       start, delay;
+   Pro8_tFuture   *entry;
+
+   if ((entry = Pro8_AsyncGetFuture (instrumentHandle, future)) == VI_NULL) return VI_ERROR_PARAMETER2;
+   //Wait - delay like Pro8_WaitForFinBit
+   start = Pro8_TimeNow ();
+   delay = PRO8_BACKOFF_MIN_DELAY;
+   while (entry->done == VI_FALSE)
+   {
+      if ((timeout >= 0) && ((Pro8_TimeNow () - start) * 1000.0 >= timeout)) return VI_ERROR_TMO;
+      Pro8_SleepSeconds (delay);
+      delay *= 2.0;
+      if (delay > PRO8_BACKOFF_MAX_DELAY) delay = PRO8_BACKOFF_MAX_DELAY;
+   }
    //Ready
-   return status;
+   return entry->status;
 }
 
 //---------------------------------------------------------------------------
-// Function: Get PD Limit Current
-// Purpose:  This function returns the limit current of the photo diode
+// Function: Asynchronous Poll
+// Purpose:  This function returns if an asynchronous operation is finished.
+//           If it is, the status of the operation is returned.
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_LdcGetPdLimit (ViSession instrumentHandle, ViInt16 value, ViReal64 *limitCurrent)
+ViStatus _VI_FUNC Pro8_AsyncPoll (ViSession instrumentHandle, ViInt32 future, ViBoolean *done)
 {
-   ViStatus status    = VI_SUCCESS;
-   ViUInt32 retCnt    = 0;
-   ViUInt16 stb;
-   ViString command[] = {":LIMM:MIN?", ":LIMM:MAX?", ":LIMM:SET?"};
-   ViBoolean answer;
-   ViString  format[] = {"%*s %LE", "%LE"};
+   Pro8_tFuture   *entry;
 
-   if ((status = viGetAttribute (instrumentHandle, VI_ATTR_USER_DATA, &answer)) < 0) return status;
-   //Check input parameter ranges
-   if (Pro8_invalidViInt16Range (value, 0, 2)) return VI_ERROR_PARAMETER2;
-   //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, command[value], StringLength (command[value]), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format[answer], limitCurrent)) < 0) return status;
+   if ((entry = Pro8_AsyncGetFuture (instrumentHandle, future)) == VI_NULL) return VI_ERROR_PARAMETER2;
+   if (done) *done = entry->done;
    //Ready
-   return status;
+   return entry->done ? entry->status : VI_SUCCESS;
 }
 
 //---------------------------------------------------------------------------
-// Function: Set Limit Power
-// Purpose:  This function sets the limit power
+// Function: Asynchronous Get Response
+// Purpose:  This function waits until an asynchronous query is finished and
+//           returns the response and the number in the response. response
+//           must hold PRO8_ASYNC_RESPONSE_SIZE (256) characters. Pass
+//           VI_NULL for a value that is not needed.
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_LdcSetPowerLimit (ViSession instrumentHandle, ViReal64 limitPower)
+ViStatus _VI_FUNC Pro8_AsyncGetResponse (ViSession instrumentHandle, ViInt32 future, ViChar _VI_FAR response[], ViReal64 *value)
 {
-   ViStatus status = VI_SUCCESS;
-   ViUInt32 retCnt = 0;
-   ViUInt16 stb;
-   ViChar   buffer[CMD_BUF_SIZE];
+   ViStatus       status   = VI_SUCCESS;
+   ViBoolean      answer;
+   Pro8_tFuture   *entry;
 
-   //Formatting
-   Fmt (buffer, ":LIMP:SET %f", limitPower);
-   //Writing - Poll STB - Check EAV Bit and read error
-   if ((status = viWrite (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
+   if ((status = Pro8_AsyncWait (instrumentHandle, future, -1)) < 0) return status;
+   entry = Pro8_AsyncGetFuture (instrumentHandle, future);
+   if (response) CopyString (response, 0, entry->response, 0, -1);
+   //Evaluate
+   if (value)
+   {
+      if ((status = Pro8_GetAnswer (instrumentHandle, &answer)) < 0) return status;
+      if ((status = Pro8_ParseReal (entry->response, answer, value)) < 0) return status;
+   }
    //Ready
    return status;
 }
 
 //---------------------------------------------------------------------------
-// Function: Get Limit Power
-// Purpose:  This function returns the limit power
+// Function: Asynchronous Release
+// Purpose:  This function waits until an asynchronous operation is finished
+//           and releases its handle.
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_LdcGetPowerLimit (ViSession instrumentHandle, ViInt16 value, ViReal64 *limitPower)
+ViStatus _VI_FUNC Pro8_AsyncRelease (ViSession instrumentHandle, ViInt32 future)
 {
-   ViStatus  status = VI_SUCCESS;
-   ViUInt32  retCnt = 0;
-   ViUInt16  stb;
-   ViString  command[] = {":LIMP:MIN?", ":LIMP:MAX?", ":LIMP:SET?"};
-   ViBoolean answer;
-   ViString  format[] = {"%*s %LE", "%LE"};
+   Pro8_tFuture   *entry;
 
-   if ((status = viGetAttribute (instrumentHandle, VI_ATTR_USER_DATA, &answer)) < 0) return status;
-   //Check input parameter ranges
-   if (Pro8_invalidViInt16Range (value, 0, 2)) return VI_ERROR_PARAMETER2;
-   //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, command[value], StringLength (command[value]), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format[answer], limitPower)) < 0) return status;
+   if ((entry = Pro8_AsyncGetFuture (instrumentHandle, future)) == VI_NULL) return VI_ERROR_PARAMETER2;
+   Pro8_AsyncWait (instrumentHandle, future, -1);
+   entry->used = VI_FALSE;
    //Ready
-   return status;
+   return VI_SUCCESS;
 }
 
+//===========================================================================
+// POOL FUNCTIONS
+//===========================================================================
 //---------------------------------------------------------------------------
-// Function: Get Laserdiode Limit Current (adjusted via poti)
-// Purpose:  This function returns limit current of the laserdiode
+// Function: Pool Open
+// Purpose:  This function opens all instruments matching findPattern
+//           (VI_NULL = PRO8_FIND_PATTERN) with Pro8_init and returns a
+//           handle of the pool and the number of instruments. The
+//           instruments are numbered 1..chassisCount in the order VISA
+//           finds them.
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_LdcGetLdLimitPoti (ViSession instrumentHandle, ViReal64 *limitCurrent)
+ViStatus _VI_FUNC Pro8_PoolOpen (ViString findPattern, ViBoolean IDQuery, ViBoolean resetDevice, ViUInt32 *pool, ViInt16 *chassisCount)
 {
-   ViStatus  status = VI_SUCCESS;
-   ViUInt32  retCnt = 0;
-   ViUInt16  stb;
-   ViBoolean answer;
-   ViString  format[] = {"%*s %LE", "%LE"};
+   ViStatus    status   = VI_SUCCESS;
+   ViSession   rmSession;
+   ViFindList  findList;
+   ViUInt32    found    = 0;
+   ViInt16     i, n;
+   Pro8_tPool  *entry    = VI_NULL;
 
-   if ((status = viGetAttribute (instrumentHandle, VI_ATTR_USER_DATA, &answer)) < 0) return status;
-   //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, ":LIMCP:ACT?", 11, &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format[answer], limitCurrent)) < 0) return status;
+   //Check input parameter ranges
+   if (Pro8_invalidViBooleanRange (IDQuery))     return VI_ERROR_PARAMETER2;
+   if (Pro8_invalidViBooleanRange (resetDevice)) return VI_ERROR_PARAMETER3;
+   if (pool == VI_NULL)                          return VI_ERROR_PARAMETER4;
+   //Free entry
+   for (i = 0; i < PRO8_MAX_POOLS; i++)
+   {
+      if (Pro8_pools[i].count == 0)
+      {
+         entry = &Pro8_pools[i];
+         break;
+      }
+   }
+   if (entry == VI_NULL) return VI_ERROR_POOL_TABLE_FULL;
+   //Find instruments
+   if ((status = viOpenDefaultRM (&rmSession)) < 0) return status;
+   if ((status = viFindRsrc (rmSession, findPattern ? findPattern : PRO8_FIND_PATTERN, &findList, &found, entry->resource[0])) < 0)
+   {
+      viClose (rmSession);
+      return status;
+   }
+   if (found > PRO8_POOL_MAX_CHASSIS) found = PRO8_POOL_MAX_CHASSIS;
+   for (n = 1; n < (ViInt16)found; n++)
+   {
+      if ((status = viFindNext (findList, entry->resource[n])) < 0) break;
+   }
+   viClose (findList);
+   viClose (rmSession);
+   if (status < 0) return status;
+   //Open instruments
+   for (i = 0; i < n; i++)
+   {
+      if ((status = Pro8_init (entry->resource[i], IDQuery, resetDevice, &entry->instr[i])) < 0)
+      {
+         while (i > 0) Pro8_close (entry->instr[--i]);
+         return status;
+      }
+   }
    //Ready
+   entry->count = n;
+   *pool = (ViUInt32)(entry - Pro8_pools) + 1;
+   if (chassisCount) *chassisCount = n;
    return status;
 }
 
 //---------------------------------------------------------------------------
-// Function: Get Laser Voltage
-// Purpose:  This function returns the voltage of the laserdiode
+// Function: Pool Close
+// Purpose:  This function closes all instruments of a pool.
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_LdcGetLdVoltage (ViSession instrumentHandle, ViReal64 *voltage)
+ViStatus _VI_FUNC Pro8_PoolClose (ViUInt32 pool)
 {
-   ViStatus  status = VI_SUCCESS;
-   ViUInt32  retCnt = 0;
-   ViUInt16  stb;
-   ViBoolean answer;
-   ViString  format[] = {"%*s %LE", "%LE"};
+   ViStatus    status   = VI_SUCCESS;
+   ViStatus    error;
+   ViInt16     i;
+   Pro8_tPool  *entry;
 
-   if ((status = viGetAttribute (instrumentHandle, VI_ATTR_USER_DATA, &answer)) < 0) return status;
-   //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, ":VLD:ACT?", 9, &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format[answer], voltage)) < 0) return status;
+   //Check input parameter ranges
+   if ((pool < 1) || (pool > PRO8_MAX_POOLS) || (Pro8_pools[pool - 1].count == 0)) return VI_ERROR_PARAMETER1;
+   entry = &Pro8_pools[pool - 1];
+   //Closing
+   for (i = 0; i < entry->count; i++)
+   {
+      if (((error = Pro8_close (entry->instr[i])) < 0) && (status >= 0)) status = error;
+   }
+   entry->count = 0;
    //Ready
    return status;
 }
 
-//===========================================================================
-// MLC MODULE FUNCTIONS
-//===========================================================================
 //---------------------------------------------------------------------------
-// Function: Set Mode
-// Purpose:  This function sets the operation mode
+// Function: Pool Get Session
+// Purpose:  This function returns the session and the resource name of an
+//           instrument of a pool (chassis 1..chassisCount). The session can
+//           be used with all driver functions. Pass VI_NULL for a value
+//           that is not needed.
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_MlcSetMode (ViSession instrumentHandle, ViInt16 mode)
+ViStatus _VI_FUNC Pro8_PoolGetSession (ViUInt32 pool, ViInt16 chassis, ViSession *instrumentHandle, ViChar _VI_FAR resourceName[])
 {
-   return Pro8_LdcSetMode (instrumentHandle, mode);
-}
+   Pro8_tPool  *entry;
 
-//---------------------------------------------------------------------------
-// Function: Get Mode
-// Purpose:  This function returns the operation mode
-//---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_MlcGetMode (ViSession instrumentHandle, ViInt16 *mode)
-{
-   return Pro8_LdcGetMode (instrumentHandle, mode);
+   //Check input parameter ranges
+   if ((pool < 1) || (pool > PRO8_MAX_POOLS) || (Pro8_pools[pool - 1].count == 0)) return VI_ERROR_PARAMETER1;
+   entry = &Pro8_pools[pool - 1];
+   if (Pro8_invalidViInt16Range (chassis, 1, entry->count)) return VI_ERROR_PARAMETER2;
+   //Ready
+   if (instrumentHandle) *instrumentHandle = entry->instr[chassis - 1];
+   if (resourceName)     CopyString (resourceName, 0, entry->resource[chassis - 1], 0, -1);
+   return VI_SUCCESS;
 }
 
 //---------------------------------------------------------------------------
-// Function: Set Range
-// Purpose:  This function sets the current range
+// Function: Pool Execute
+// Purpose:  This function executes count commands, command i is sent to
+//           slot[i] (0 = active slot) of instrument chassis[i]. The
+//           commands of an instrument are sent in order as compound
+//           commands by the I/O thread of its session, the instruments work
+//           in parallel. For queries the response and the number in the
+//           response are returned in responses[i * PRO8_ASYNC_RESPONSE_SIZE]
+//           and values[i], results[i] is the status of command i. Pass
+//           VI_NULL for arrays that are not needed. The function returns
+//           the first error in the order of the commands.
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_MlcSetRange (ViSession instrumentHandle, ViInt16 range)
+ViStatus _VI_FUNC Pro8_PoolExecute (ViUInt32 pool, ViInt32 count, ViInt16 chassis[], ViInt16 slot[], ViString commands[],
+                                    ViChar _VI_FAR responses[], ViReal64 values[], ViStatus results[])
 {
-   ViStatus status    = VI_SUCCESS;
-   ViUInt32 retCnt    = 0;
-   ViUInt16 stb;
-   ViString command[] = {":RANGE 0", ":RANGE 1"};
+   ViStatus       status   = VI_SUCCESS;
+   ViInt32        i, c, n;
+   ViInt32        *index;
+   ViStatus       *result;
+   ViInt32        future[PRO8_POOL_MAX_CHASSIS];
+   ViStatus       error[PRO8_POOL_MAX_CHASSIS];
+   ViStatus       wait[PRO8_POOL_MAX_CHASSIS];
+   Pro8_tPoolJob  job[PRO8_POOL_MAX_CHASSIS];
+   Pro8_tPool     *entry;
 
    //Check input parameter ranges
-   if (Pro8_invalidViInt16Range (range, 0, 1)) return VI_ERROR_PARAMETER2;
-   //Writing - Poll STB - Check EAV Bit and read error
-   if ((status = viWrite (instrumentHandle, command[range], StringLength (command[range]), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
+   if ((pool < 1) || (pool > PRO8_MAX_POOLS) || (Pro8_pools[pool - 1].count == 0)) return VI_ERROR_PARAMETER1;
+   entry = &Pro8_pools[pool - 1];
+   if (count < 1) return VI_ERROR_PARAMETER2;
+   for (i = 0; i < count; i++)
+   {
+      if (Pro8_invalidViInt16Range (chassis[i], 1, entry->count))                          return VI_ERROR_PARAMETER3;
+      if (Pro8_invalidViInt16Range (slot[i], 0, PRO8_NUM_SLOTS))                          return VI_ERROR_PARAMETER4;
+      if ((commands[i] == VI_NULL) || (StringLength (commands[i]) > PRO8_BATCH_MAX_LENGTH - 8)) return VI_ERROR_PARAMETER5;
+   }
+   //Sort commands by instrument, keep their order - results of our own if not needed by the caller
+   if ((index = (ViInt32*)malloc (count * sizeof (ViInt32))) == VI_NULL) return VI_ERROR_ALLOC;
+   if (((result = results) == VI_NULL) && ((result = (ViStatus*)malloc (count * sizeof (ViStatus))) == VI_NULL))
+   {
+      free (index);
+      return VI_ERROR_ALLOC;
+   }
+   memset (job, 0, sizeof (job));
+   for (i = 0; i < count; i++) job[chassis[i] - 1].count++;
+   for (c = 0, n = 0; c < entry->count; c++)
+   {
+      job[c].index     = &index[n];
+      job[c].slot      = slot;
+      job[c].commands  = commands;
+      job[c].responses = responses;
+      job[c].values    = values;
+      job[c].results   = result;
+      n += job[c].count;
+      job[c].count = 0;
+   }
+   for (i = 0; i < count; i++)
+   {
+      c = chassis[i] - 1;
+      job[c].index[job[c].count++] = i;
+   }
+   //Schedule - one operation per instrument
+   for (c = 0; c < entry->count; c++)
+   {
+      future[c] = 0;
+      error[c]  = VI_SUCCESS;
+      if (job[c].count) error[c] = Pro8_AsyncCall (entry->instr[c], Pro8_PoolRun, &job[c], VI_NULL, VI_NULL, &future[c]);
+   }
+   //Wait
+   for (c = 0; c < entry->count; c++)
+   {
+      wait[c] = VI_SUCCESS;
+      if (future[c] == 0) continue;
+      wait[c] = Pro8_AsyncWait (entry->instr[c], future[c], -1);
+      Pro8_AsyncRelease (entry->instr[c], future[c]);
+   }
+   //Results - first error in caller order, then errors of instruments not found in the results
+   for (i = 0; i < count; i++)
+   {
+      c = chassis[i] - 1;
+      if (error[c] < 0) result[i] = error[c];
+      if ((status >= 0) && (result[i] < 0)) status = result[i];
+   }
+   for (c = 0; (c < entry->count) && (status >= 0); c++)
+   {
+      if (wait[c] < 0) status = wait[c];
+   }
+   if (result != results) free (result);
+   free (index);
    //Ready
    return status;
 }
 
+//===========================================================================
+// TELEMETRY FUNCTIONS
+//===========================================================================
 //---------------------------------------------------------------------------
-// Function: Get Range
-// Purpose:  This function returns the current rage
-//---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_MlcGetRange (ViSession instrumentHandle, ViInt16 *range)
-{
-   ViStatus  status = VI_SUCCESS;
-   ViUInt32  retCnt = 0;
-   ViUInt16  stb;
-   ViChar    buffer[CMD_BUF_SIZE];
-   ViBoolean answer;
-   ViString  format[] = {"%*s %s", "%s"};
+// Function: Telemetry Snapshot
+// Purpose:  This function reads the actual values of all channels of all
+//           populated slots selected by channelMask (bit 1 << channel,
+//           PRO8_CHANNEL_ALL = all channels). The channels of a slot depend
+//           on its module type from Pro8_GetSlotConfiguration. The slot
+//           selections and queries are joined into as few compound
+//           commands as possible, a full chassis takes one or two. Up to
+//           size samples are returned in slot and channel order, count
+//           returns the number of samples. The active slot is changed.
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_TelemetrySnapshot (ViSession instrumentHandle, ViUInt32 channelMask, ViInt32 size, Pro8_tSample samples[], ViInt32 *count)
+{
+   ViStatus       status   = VI_SUCCESS;
+   ViInt16        slot[PRO8_TELEMETRY_MAX_SAMPLES], channel[PRO8_TELEMETRY_MAX_SAMPLES];
+   ViString       commands[PRO8_TELEMETRY_MAX_SAMPLES];
+   ViInt32        index[PRO8_TELEMETRY_MAX_SAMPLES];
+   ViReal64       values[PRO8_TELEMETRY_MAX_SAMPLES], times[PRO8_TELEMETRY_MAX_SAMPLES];
+   ViStatus       results[PRO8_TELEMETRY_MAX_SAMPLES];
+   ViInt32        i, n = 0;
+   Pro8_tPoolJob  job;
 
-   if ((status = viGetAttribute (instrumentHandle, VI_ATTR_USER_DATA, &answer)) < 0) return status;
-   //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, ":RANGE?", 7, &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format[answer], buffer)) < 0) return status;
-   //Evaluate
-   if      (CompareStrings ("0", 0, buffer, 0, 0) == 0) *range = 0;
-   else if (CompareStrings ("1", 0, buffer, 0, 0) == 0) *range = 1;
-   else status = VI_ERROR_INSTR_INTERPRETING_RESPONSE;
+   //Check input parameter ranges
+   if (size < 0)                            return VI_ERROR_PARAMETER3;
+   if ((samples == VI_NULL) && (size > 0))  return VI_ERROR_PARAMETER4;
+   if (size > PRO8_TELEMETRY_MAX_SAMPLES) size = PRO8_TELEMETRY_MAX_SAMPLES;
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   //Channels of the populated slots
+   status = Pro8_TelemetryChannels (instrumentHandle, channelMask, size, slot, channel, &n);
+   if (count) *count = n;
+   if (status < 0) return Pro8_Unlock (instrumentHandle, status);
+   for (i = 0; i < n; i++)
+   {
+      index[i]    = i;
+      commands[i] = Pro8_channelQueries[channel[i]];
+   }
+   if (n == 0) return Pro8_Unlock (instrumentHandle, status);
+   //Writing - Reading
+   memset (&job, 0, sizeof (job));
+   job.count    = n;
+   job.index    = index;
+   job.slot     = slot;
+   job.commands = commands;
+   job.values   = values;
+   job.results  = results;
+   job.times    = times;
+   status = Pro8_PoolRun (instrumentHandle, &job);
+   //Samples
+   for (i = 0; i < n; i++)
+   {
+      samples[i].timestamp = times[i];
+      samples[i].slot      = slot[i];
+      samples[i].channel   = channel[i];
+      samples[i].status    = results[i];
+      samples[i].value     = values[i];
+   }
    //Ready
-   return status;
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
+//===========================================================================
+// STREAMING FUNCTIONS
+//===========================================================================
 //---------------------------------------------------------------------------
-// Function: Set Temperature Protection Slot
-// Purpose:  This function sets the slot for temperature protection
+// Function: Stream Start
+// Purpose:  This function starts the acquisition thread of a session. Every
+//           period seconds (0 = as fast as possible) it reads the channels
+//           slot[i], channel[i] in one transaction and writes the samples
+//           into a ring of capacity samples (0 = default, rounded up to a
+//           power of 2). If count is 0 all channels of the populated slots
+//           are acquired. Periods missed by late cycles are skipped, not
+//           caught up. Consumers attached by Pro8_StreamAttach read the
+//           samples without copying them.
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_MlcSetTpSlot (ViSession instrumentHandle, ViInt16 slot)
+ViStatus _VI_FUNC Pro8_StreamStart (ViSession instrumentHandle, ViInt32 count, ViInt16 slot[], ViInt16 channel[], ViReal64 period, ViInt32 capacity)
 {
-   return Pro8_LdcSetTpSlot (instrumentHandle, slot);
+   ViStatus       status   = VI_SUCCESS;
+   ViUInt32       size;
+   ViInt32        i;
+   Pro8_tStream   *stream;
+   Pro8_tSession  *session;
+
+   //Check input parameter ranges
+   if ((count < 0) || (count > PRO8_STREAM_MAX_CHANNELS))                     return VI_ERROR_PARAMETER2;
+   if ((count > 0) && (slot == VI_NULL))                                      return VI_ERROR_PARAMETER3;
+   if ((count > 0) && (channel == VI_NULL))                                   return VI_ERROR_PARAMETER4;
+   for (i = 0; i < count; i++)
+   {
+      if (Pro8_invalidViInt16Range (slot[i], 1, PRO8_NUM_SLOTS))              return VI_ERROR_PARAMETER3;
+      if (Pro8_invalidViInt16Range (channel[i], 1, PRO8_CHANNEL_COUNT))       return VI_ERROR_PARAMETER4;
+   }
+   if (Pro8_invalidViReal64Range (period, 0.0, 3600.0))                       return VI_ERROR_PARAMETER5;
+   if ((capacity < 0) || (capacity > PRO8_STREAM_MAX_CAPACITY))               return VI_ERROR_PARAMETER6;
+   if ((session = Pro8_GetSession (instrumentHandle)) == VI_NULL)             return VI_ERROR_NO_SESSION_CONTEXT;
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   if (session->stream) return Pro8_Unlock (instrumentHandle, VI_ERROR_STREAM_STATE);
+   if ((stream = (Pro8_tStream*)calloc (1, sizeof (Pro8_tStream))) == VI_NULL) return Pro8_Unlock (instrumentHandle, VI_ERROR_ALLOC);
+   //Channels
+   if (count == 0)
+   {
+      status = Pro8_TelemetryChannels (instrumentHandle, PRO8_CHANNEL_ALL, PRO8_STREAM_MAX_CHANNELS, stream->slot, stream->channel, &count);
+   }
+   else
+   {
+      memcpy (stream->slot, slot, count * sizeof (ViInt16));
+      memcpy (stream->channel, channel, count * sizeof (ViInt16));
+   }
+   if ((status >= 0) && (count == 0)) status = VI_ERROR_PARAMETER2;
+   if (status < 0)
+   {
+      free (stream);
+      return Pro8_Unlock (instrumentHandle, status);
+   }
+   for (i = 0; i < count; i++)
+   {
+      stream->index[i]    = i;
+      stream->commands[i] = Pro8_channelQueries[stream->channel[i]];
+   }
+   stream->job.count    = count;
+   stream->job.index    = stream->index;
+   stream->job.slot     = stream->slot;
+   stream->job.commands = stream->commands;
+   stream->job.values   = stream->values;
+   stream->job.results  = stream->results;
+   stream->job.times    = stream->times;
+   stream->period       = period;
+   //Ring
+   size = capacity ? capacity : PRO8_STREAM_DEFAULT_CAPACITY;
+   if (size < (ViUInt32)count * 2) size = (ViUInt32)count * 2;
+   for (stream->mask = 1; stream->mask < size; stream->mask <<= 1);
+   stream->mask--;
+   if ((stream->ring = (Pro8_tSample*)calloc (stream->mask + 1, sizeof (Pro8_tSample))) == VI_NULL)
+   {
+      free (stream);
+      return Pro8_Unlock (instrumentHandle, VI_ERROR_ALLOC);
+   }
+   //Thread pool - acquisition thread
+   if (CmtNewThreadPool (1, &stream->pool) < 0)
+   {
+      free (stream->ring);
+      free (stream);
+      return Pro8_Unlock (instrumentHandle, VI_ERROR_SYSTEM_ERROR);
+   }
+   session->stream = stream;
+   if (CmtScheduleThreadPoolFunction (stream->pool, Pro8_StreamWorker, session, &stream->worker) < 0)
+   {
+      session->stream = VI_NULL;
+      CmtDiscardThreadPool (stream->pool);
+      free (stream->ring);
+      free (stream);
+      return Pro8_Unlock (instrumentHandle, VI_ERROR_SYSTEM_ERROR);
+   }
+   //Ready
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get Temperature Protection Slot
-// Purpose:  This function returns the slot used for temperature protection
+// Function: Stream Stop
+// Purpose:  This function stops the acquisition thread of a session and
+//           frees the sample ring. Consumers must not read the ring any
+//           more.
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_MlcGetTpSlot (ViSession instrumentHandle, ViInt16 *slot)
+ViStatus _VI_FUNC Pro8_StreamStop (ViSession instrumentHandle)
 {
-   return Pro8_LdcGetTpSlot (instrumentHandle, slot);
+   Pro8_tSession  *session;
+
+   if ((session = Pro8_GetSession (instrumentHandle)) == VI_NULL) return VI_ERROR_NO_SESSION_CONTEXT;
+   if (session->stream == VI_NULL) return VI_ERROR_STREAM_STATE;
+   Pro8_StreamFree (session);
+   //Ready
+   return VI_SUCCESS;
 }
 
 //---------------------------------------------------------------------------
-// Function: Set Temperature Protection
-// Purpose:  This function switches the temperature protection
+// Function: Stream Attach
+// Purpose:  This function attaches a consumer to the stream of a session.
+//           The consumer reads the samples written after this call. A
+//           consumer has to be used by one thread at a time.
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_MlcSetTempProt (ViSession instrumentHandle, ViInt16 tempProtection)
+ViStatus _VI_FUNC Pro8_StreamAttach (ViSession instrumentHandle, ViInt32 *consumer)
 {
-   return Pro8_LdcSetTempProt (instrumentHandle, tempProtection);
+   ViInt32        i;
+   Pro8_tSession  *session;
+
+   if (consumer == VI_NULL) return VI_ERROR_PARAMETER2;
+   if ((session = Pro8_GetSession (instrumentHandle)) == VI_NULL) return VI_ERROR_NO_SESSION_CONTEXT;
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   if (session->stream == VI_NULL) return Pro8_Unlock (instrumentHandle, VI_ERROR_STREAM_STATE);
+   for (i = 0; i < PRO8_STREAM_MAX_CONSUMERS; i++)
+   {
+      if (session->stream->consumers[i].used) continue;
+      session->stream->consumers[i].cursor = session->stream->head;
+      session->stream->consumers[i].lost   = 0;
+      session->stream->consumers[i].used   = VI_TRUE;
+      *consumer = i + 1;
+      return Pro8_Unlock (instrumentHandle, VI_SUCCESS);
+   }
+   //Ready
+   return Pro8_Unlock (instrumentHandle, VI_ERROR_CONSUMER_TABLE_FULL);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get Temperature Protection
-// Purpose:  This function returns the state of the temperature protection
+// Function: Stream Detach
+// Purpose:  This function detaches a consumer from the stream of a session.
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_MlcGetTempProt (ViSession instrumentHandle, ViInt16 *temperatureProtection)
+ViStatus _VI_FUNC Pro8_StreamDetach (ViSession instrumentHandle, ViInt32 consumer)
 {
-   return Pro8_LdcGetTempProt (instrumentHandle, temperatureProtection);
+   Pro8_tConsumer *entry;
+
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   if ((entry = Pro8_StreamGetConsumer (instrumentHandle, consumer)) == VI_NULL) return Pro8_Unlock (instrumentHandle, VI_ERROR_PARAMETER2);
+   entry->used = VI_FALSE;
+   //Ready
+   return Pro8_Unlock (instrumentHandle, VI_SUCCESS);
 }
 
 //---------------------------------------------------------------------------
-// Function: Set Laser Output
-// Purpose:  This function switches the output on or off
+// Function: Stream Acquire
+// Purpose:  This function returns a pointer to the oldest unread samples of
+//           a consumer in the ring and the number of samples that follow
+//           without wrapping around (0 if there are none). Nothing is
+//           copied, the samples stay valid until the acquisition thread
+//           overwrites them, which Pro8_StreamRelease detects. If the
+//           consumer fell behind by more than the ring, the overwritten
+//           samples are skipped and counted as lost.
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_MlcSetLdOutput (ViSession instrumentHandle, ViInt16 output)
+ViStatus _VI_FUNC Pro8_StreamAcquire (ViSession instrumentHandle, ViInt32 consumer, const Pro8_tSample **samples, ViInt32 *count)
 {
-   return Pro8_LdcSetLdOutput (instrumentHandle, output);
+   ViUInt32       head, cursor, available;
+   Pro8_tStream   *stream;
+   Pro8_tConsumer *entry;
+
+   if ((entry = Pro8_StreamGetConsumer (instrumentHandle, consumer)) == VI_NULL) return VI_ERROR_PARAMETER2;
+   if (samples == VI_NULL)                                                          return VI_ERROR_PARAMETER3;
+   if (count == VI_NULL)                                                            return VI_ERROR_PARAMETER4;
+   stream = Pro8_GetSession (instrumentHandle)->stream;
+   //Published samples - the sample at head may be written right now
+   head = stream->head;
+   Pro8_MemoryBarrier ();
+   cursor = entry->cursor;
+   if (head - cursor > stream->mask)
+   {
+      entry->lost  += head - cursor - stream->mask;
+      cursor        = head - stream->mask;
+      entry->cursor = cursor;
+   }
+   available = head - cursor;
+   if (available > stream->mask + 1 - (cursor & stream->mask)) available = stream->mask + 1 - (cursor & stream->mask);
+   *samples = &stream->ring[cursor & stream->mask];
+   *count   = (ViInt32)available;
+   //Ready
+   return VI_SUCCESS;
 }
 
 //---------------------------------------------------------------------------
-// Function: Get Laser Output
-// Purpose:  This function returns the state of the output
+// Function: Stream Release
+// Purpose:  This function marks count samples returned by Pro8_StreamAcquire
+//           as read. It returns VI_ERROR_STREAM_OVERRUN if the acquisition
+//           thread overwrote some of them before they were released, the
+//           values read may then be invalid and are counted as lost.
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_MlcGetLdOutput (ViSession instrumentHandle, ViInt16 *output)
+ViStatus _VI_FUNC Pro8_StreamRelease (ViSession instrumentHandle, ViInt32 consumer, ViInt32 count)
 {
-   return Pro8_LdcGetLdOutput (instrumentHandle, output);
+   ViUInt32       head, cursor, overwritten;
+   Pro8_tStream   *stream;
+   Pro8_tConsumer *entry;
+
+   if ((entry = Pro8_StreamGetConsumer (instrumentHandle, consumer)) == VI_NULL) return VI_ERROR_PARAMETER2;
+   stream = Pro8_GetSession (instrumentHandle)->stream;
+   cursor = entry->cursor;
+   Pro8_MemoryBarrier ();
+   head = stream->head;
+   if ((count < 0) || ((ViUInt32)count > head - cursor))                           return VI_ERROR_PARAMETER3;
+   entry->cursor = cursor + count;
+   //Samples written since Pro8_StreamAcquire
+   if (head - cursor <= stream->mask) return VI_SUCCESS;
+   overwritten = head - cursor - stream->mask;
+   entry->lost += (overwritten < (ViUInt32)count) ? overwritten : (ViUInt32)count;
+   //Ready
+   return VI_ERROR_STREAM_OVERRUN;
 }
 
 //---------------------------------------------------------------------------
-// Function: Set Laser Current
-// Purpose:  This function sets the current of the laserdiode
+// Function: Stream Get Statistics
+// Purpose:  This function returns the number of samples a consumer is
+//           behind the acquisition thread and the number of samples it
+//           lost. cycles and missed return the number of acquisition cycles
+//           and of periods missed by late cycles.
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_MlcSetLdCurrent (ViSession instrumentHandle, ViReal64 current)
+ViStatus _VI_FUNC Pro8_StreamGetStatistics (ViSession instrumentHandle, ViInt32 consumer, ViUInt32 *behind, ViUInt32 *lost, ViUInt32 *cycles, ViUInt32 *missed)
 {
-   return Pro8_LdcSetLdCurrent (instrumentHandle, current);
+   Pro8_tStream   *stream;
+   Pro8_tConsumer *entry;
+   Pro8_tSession  *session;
+
+   if ((session = Pro8_GetSession (instrumentHandle)) == VI_NULL) return VI_ERROR_NO_SESSION_CONTEXT;
+   if ((stream = session->stream) == VI_NULL)                    return VI_ERROR_STREAM_STATE;
+   if (cycles) *cycles = stream->cycles;
+   if (missed) *missed = stream->missed;
+   //Consumer, 0 = none
+   if (consumer == 0) return VI_SUCCESS;
+   if ((entry = Pro8_StreamGetConsumer (instrumentHandle, consumer)) == VI_NULL) return VI_ERROR_PARAMETER2;
+   if (behind) *behind = stream->head - entry->cursor;
+   if (lost)   *lost   = entry->lost;
+   //Ready
+   return VI_SUCCESS;
 }
 
+//===========================================================================
+// SETPOINT FUNCTIONS
+//===========================================================================
 //---------------------------------------------------------------------------
-// Function: Get Laser Current
-// Purpose:  This function returns the current of the laserdiode
+// Function: Setpoint Open
+// Purpose:  This function opens a setpoint channel for a parameter
+//           (PRO8_SETPOINT_xxx) of a slot. Values posted to the channel are
+//           written by the sender thread of the session as fast as the
+//           instrument completes them. A value that is superseded before
+//           the sender takes it is dropped, pending channels are written
+//           together in one compound command.
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_MlcGetLdCurrent (ViSession instrumentHandle, ViInt16 value, ViReal64 *current)
+ViStatus _VI_FUNC Pro8_SetpointOpen (ViSession instrumentHandle, ViInt16 slot, ViInt16 parameter, ViInt32 *setpoint)
 {
-   return Pro8_LdcGetLdCurrent (instrumentHandle, value, current);
+   ViStatus       status   = VI_SUCCESS;
+   ViInt32        i;
+   Pro8_tSetpoint *entry;
+   Pro8_tSession  *session;
+
+   //Check input parameter ranges
+   if (Pro8_invalidViInt16Range (slot, 1, PRO8_NUM_SLOTS))                  return VI_ERROR_PARAMETER2;
+   if (Pro8_invalidViInt16Range (parameter, 1, PRO8_SETPOINT_COUNT))        return VI_ERROR_PARAMETER3;
+   if (setpoint == VI_NULL)                                                 return VI_ERROR_PARAMETER4;
+   if ((session = Pro8_GetSession (instrumentHandle)) == VI_NULL)           return VI_ERROR_NO_SESSION_CONTEXT;
+   //Lock session - start the sender thread
+   Pro8_Lock (instrumentHandle);
+   if ((status = Pro8_SenderStart (session)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   for (i = 0; i < PRO8_MAX_SETPOINTS; i++)
+   {
+      entry = &session->sender->setpoints[i];
+      if (entry->used) continue;
+      memset (entry, 0, sizeof (Pro8_tSetpoint));
+      entry->slot      = slot;
+      entry->parameter = parameter;
+      entry->used      = VI_TRUE;
+      *setpoint = i + 1;
+      return Pro8_Unlock (instrumentHandle, VI_SUCCESS);
+   }
+   //Ready
+   return Pro8_Unlock (instrumentHandle, VI_ERROR_SETPOINT_TABLE_FULL);
 }
 
 //---------------------------------------------------------------------------
-// Function: Set Photodiode Current
-// Purpose:  This function sets the current of the photodiode
+// Function: Setpoint Close
+// Purpose:  This function closes a setpoint channel. A value not yet taken
+//           by the sender is discarded.
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_MlcSetPdCurrent (ViSession instrumentHandle, ViReal64 current)
+ViStatus _VI_FUNC Pro8_SetpointClose (ViSession instrumentHandle, ViInt32 setpoint)
 {
-   return Pro8_LdcSetPdCurrent (instrumentHandle, current);
+   Pro8_tSetpoint *entry;
+
+   //Lock session - the sender takes values within the lock
+   Pro8_Lock (instrumentHandle);
+   if ((entry = Pro8_SetpointGet (instrumentHandle, setpoint)) == VI_NULL) return Pro8_Unlock (instrumentHandle, VI_ERROR_PARAMETER2);
+   entry->used = VI_FALSE;
+   //Ready
+   return Pro8_Unlock (instrumentHandle, VI_SUCCESS);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get Photodiode Current
-// Purpose:  This function returns the current of the photodiode
+// Function: Setpoint Post
+// Purpose:  This function posts a value to a setpoint channel and returns
+//           at once. It replaces a value not yet taken by the sender. The
+//           function takes no lock, values of a channel have to be posted
+//           by one thread at a time.
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_MlcGetPdCurrent (ViSession instrumentHandle, ViInt16 value, ViReal64 *current)
+ViStatus _VI_FUNC Pro8_SetpointPost (ViSession instrumentHandle, ViInt32 setpoint, ViReal64 value)
 {
-   return Pro8_LdcGetPdCurrent (instrumentHandle, value, current);
+   ViInt32        wake     = PRO8_SENDER_WAKE;
+   Pro8_tSetpoint *entry;
+
+   if ((entry = Pro8_SetpointGet (instrumentHandle, setpoint)) == VI_NULL) return VI_ERROR_PARAMETER2;
+   //Write the value between two increments of the sequence
+   entry->sequence++;
+   Pro8_MemoryBarrier ();
+   entry->value  = value;
+   entry->posted = Pro8_TimeNow ();
+   Pro8_MemoryBarrier ();
+   entry->sequence++;
+   //Wake the sender, the doorbell is already rung if it is full
+   CmtWriteTSQData (Pro8_GetSession (instrumentHandle)->sender->doorbell, &wake, 1, 0, VI_NULL);
+   //Ready
+   return VI_SUCCESS;
 }
 
 //---------------------------------------------------------------------------
-// Function: Get Laserdiode Limit Current (adjusted via poti)
-// Purpose:  This function returns limit current of the laserdiode
+// Function: Setpoint Get Statistics
+// Purpose:  This function returns the number of values of a setpoint
+//           channel written to the instrument and dropped because they
+//           were superseded, the value last written and the age of the
+//           applied values: the time from the post to the completion of
+//           the write, last and maximum.
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_MlcGetLdLimitPoti (ViSession instrumentHandle, ViReal64 *limitCurrent)
+ViStatus _VI_FUNC Pro8_SetpointGetStatistics (ViSession instrumentHandle, ViInt32 setpoint, ViUInt32 *applied, ViUInt32 *dropped,
+                                              ViReal64 *appliedValue, ViReal64 *lastAge, ViReal64 *maxAge, ViStatus *lastStatus)
 {
-   return Pro8_LdcGetLdLimitPoti (instrumentHandle, limitCurrent);
+   Pro8_tSetpoint *entry;
+
+   if ((entry = Pro8_SetpointGet (instrumentHandle, setpoint)) == VI_NULL) return VI_ERROR_PARAMETER2;
+   if (applied)      *applied      = entry->applied;
+   if (dropped)      *dropped      = entry->dropped;
+   if (appliedValue) *appliedValue = entry->appliedValue;
+   if (lastAge)      *lastAge      = entry->lastAge;
+   if (maxAge)       *maxAge       = entry->maxAge;
+   if (lastStatus)   *lastStatus   = entry->status;
+   //Ready
+   return VI_SUCCESS;
 }
 
 //===========================================================================
-// TEC MODULE FUNCTIONS
+// WAVEFORM FUNCTIONS
 //===========================================================================
 //---------------------------------------------------------------------------
-// Function: Set Sensor
-// Purpose:  This function sets the temperature sensor
-//---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_TecSetSensor (ViSession instrumentHandle, ViInt16 sensor)
-{
-   ViStatus status    = VI_SUCCESS;
-   ViUInt32 retCnt    = 0;
-   ViUInt16 stb;
-   ViString command[] = {":SENS AD", ":SENS THL", ":SENS THH", ":SENS PT100", ":SENS PT1000L", ":SENS PT1000H"};
+// Function: Waveform Start
+// Purpose:  This function starts the waveform thread of a session. It
+//           writes the count values of setpoints to a parameter
+//           (PRO8_SETPOINT_xxx) of a slot, one every period seconds, and
+//           plays the table cycles times (0 = until Pro8_WaveformStop). The
+//           table is copied. Each point is written at its absolute
+//           deadline, so timing errors do not add up; points behind their
+//           deadline are written back to back until the play catches up.
+//           The points are written without waiting for the FIN bit. The
+//           thread holds the session lock while points follow each other
+//           closely and checks the instrument errors before it releases
+//           it, at the latest after PRO8_WAVEFORM_SYNC_POINTS points. An
+//           error stops the play. The thread runs at real-time priority if
+//           the process is allowed to.
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_WaveformStart (ViSession instrumentHandle, ViInt16 slot, ViInt16 parameter, ViInt32 count, ViReal64 setpoints[],
+                                      ViReal64 period, ViInt32 cycles)
+{
+   Pro8_tWaveform *waveform;
+   Pro8_tSession  *session;
 
    //Check input parameter ranges
-   if (Pro8_invalidViInt16Range (sensor, 0, 5)) return VI_ERROR_PARAMETER2;
-   //Writing - Poll STB - Check EAV Bit and read error
-   if ((status = viWrite (instrumentHandle, command[sensor], StringLength (command[sensor]), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   //Ready
-   return status;
+   if (Pro8_invalidViInt16Range (slot, 1, PRO8_NUM_SLOTS))                  return VI_ERROR_PARAMETER2;
+   if (Pro8_invalidViInt16Range (parameter, 1, PRO8_SETPOINT_COUNT))        return VI_ERROR_PARAMETER3;
+   if (Pro8_invalidViInt32Range (count, 1, PRO8_WAVEFORM_MAX_POINTS))       return VI_ERROR_PARAMETER4;
+   if (setpoints == VI_NULL)                                                return VI_ERROR_PARAMETER5;
+   if (Pro8_invalidViReal64Range (period, PRO8_WAVEFORM_MIN_PERIOD, 3600.0)) return VI_ERROR_PARAMETER6;
+   if (cycles < 0)                                                          return VI_ERROR_PARAMETER7;
+   if ((session = Pro8_GetSession (instrumentHandle)) == VI_NULL)           return VI_ERROR_NO_SESSION_CONTEXT;
+   //Lock session - a finished waveform is replaced
+   Pro8_Lock (instrumentHandle);
+   if (session->waveform && session->waveform->running) return Pro8_Unlock (instrumentHandle, VI_ERROR_WAVEFORM_STATE);
+   Pro8_WaveformFree (session);
+   if ((waveform = (Pro8_tWaveform*)calloc (1, sizeof (Pro8_tWaveform))) == VI_NULL) return Pro8_Unlock (instrumentHandle, VI_ERROR_ALLOC);
+   waveform->setpoints = (ViReal64*)malloc (count * sizeof (ViReal64));
+   waveform->errors    = (ViReal64*)calloc (count, sizeof (ViReal64));
+   if ((waveform->setpoints == VI_NULL) || (waveform->errors == VI_NULL))
+   {
+      free (waveform->setpoints);
+      free (waveform->errors);
+      free (waveform);
+      return Pro8_Unlock (instrumentHandle, VI_ERROR_ALLOC);
+   }
+   memcpy (waveform->setpoints, setpoints, count * sizeof (ViReal64));
+   waveform->slot      = slot;
+   waveform->parameter = parameter;
+   waveform->count     = count;
+   waveform->period    = period;
+   waveform->cycles    = cycles;
+   waveform->running   = VI_TRUE;
+   //Thread pool - waveform thread
+   if (CmtNewThreadPool (1, &waveform->pool) < 0)
+   {
+      free (waveform->setpoints);
+      free (waveform->errors);
+      free (waveform);
+      return Pro8_Unlock (instrumentHandle, VI_ERROR_SYSTEM_ERROR);
+   }
+   session->waveform = waveform;
+   if (CmtScheduleThreadPoolFunction (waveform->pool, Pro8_WaveformWorker, session, &waveform->worker) < 0)
+   {
+      session->waveform = VI_NULL;
+      CmtDiscardThreadPool (waveform->pool);
+      free (waveform->setpoints);
+      free (waveform->errors);
+      free (waveform);
+      return Pro8_Unlock (instrumentHandle, VI_ERROR_SYSTEM_ERROR);
+   }
+   //Ready
+   return Pro8_Unlock (instrumentHandle, VI_SUCCESS);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get Sensor
-// Purpose:  This function returns the temperature sensor
+// Function: Waveform Stop
+// Purpose:  This function stops the waveform thread of a session after the
+//           current point and frees the table. It returns the first error
+//           of the play.
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_TecGetSensor (ViSession instrumentHandle, ViInt16 *sensor)
+ViStatus _VI_FUNC Pro8_WaveformStop (ViSession instrumentHandle)
 {
-   ViStatus  status = VI_SUCCESS;
-   ViUInt32  retCnt = 0;
-   ViUInt16  stb;
-   ViChar    buffer[CMD_BUF_SIZE];
-   ViBoolean answer;
-   ViString  format[] = {"%*s %s", "%s"};
+   ViStatus       status;
+   Pro8_tSession  *session;
 
-   if ((status = viGetAttribute (instrumentHandle, VI_ATTR_USER_DATA, &answer)) < 0) return status;
-   //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, ":SENS?", 6, &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format[answer], buffer)) < 0) return status;
-   //Evaluate
-   if      (CompareStrings ("AD",      0, buffer, 0, 0) == 0) *sensor = 0;
-   else if (CompareStrings ("THL",     0, buffer, 0, 0) == 0) *sensor = 1;
-   else if (CompareStrings ("THH",     0, buffer, 0, 0) == 0) *sensor = 2;
-   else if (CompareStrings ("PT100",   0, buffer, 0, 0) == 0) *sensor = 3;
-   else if (CompareStrings ("PT1000L", 0, buffer, 0, 0) == 0) *sensor = 4;
-   else if (CompareStrings ("PT1000H", 0, buffer, 0, 0) == 0) *sensor = 5;
-   else status = VI_ERROR_INSTR_INTERPRETING_RESPONSE;
+   if ((session = Pro8_GetSession (instrumentHandle)) == VI_NULL) return VI_ERROR_NO_SESSION_CONTEXT;
+   if (session->waveform == VI_NULL) return VI_ERROR_WAVEFORM_STATE;
+   session->waveform->stop = VI_TRUE;
+   CmtWaitForThreadPoolFunctionCompletion (session->waveform->pool, session->waveform->worker, 0);
+   status = session->waveform->status;
+   Pro8_WaveformFree (session);
    //Ready
    return status;
 }
 
 //---------------------------------------------------------------------------
-// Function: Set I-Share
-// Purpose:  This function switches the I-share on and off
+// Function: Waveform Get Statistics
+// Purpose:  This function returns whether the waveform thread of a session
+//           is still playing, the number of points written and of cycles
+//           completed, the number of points written a period or more after
+//           their deadline, the maximum and mean timing error (seconds,
+//           start of the write minus deadline) and the first error of the
+//           play. The values are read while the thread writes, they may
+//           belong to different points.
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_TecSetIShare (ViSession instrumentHandle, ViInt16 IShare)
+ViStatus _VI_FUNC Pro8_WaveformGetStatistics (ViSession instrumentHandle, ViBoolean *running, ViUInt32 *points, ViUInt32 *cycles, ViUInt32 *late,
+                                              ViReal64 *maxError, ViReal64 *meanError, ViStatus *playStatus)
 {
-   ViStatus status    = VI_SUCCESS;
-   ViUInt32 retCnt    = 0;
-   ViUInt16 stb;
-   ViString command[] = {":INTEG OFF", ":INTEG ON"};
+   Pro8_tWaveform *waveform;
+   Pro8_tSession  *session;
 
-   //Check input parameter ranges
-   if (Pro8_invalidViInt16Range (IShare, 0, 1)) return VI_ERROR_PARAMETER2;
-   //Writing - Poll STB - Check EAV Bit and read error
-   if ((status = viWrite (instrumentHandle, command[IShare], StringLength (command[IShare]), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
+   if ((session = Pro8_GetSession (instrumentHandle)) == VI_NULL) return VI_ERROR_NO_SESSION_CONTEXT;
+   if ((waveform = session->waveform) == VI_NULL) return VI_ERROR_WAVEFORM_STATE;
+   if (running)    *running    = waveform->running;
+   if (points)     *points     = waveform->points;
+   if (cycles)     *cycles     = waveform->played;
+   if (late)       *late       = waveform->late;
+   if (maxError)   *maxError   = waveform->maxError;
+   if (meanError)  *meanError  = waveform->points ? waveform->sumError / waveform->points : 0.0;
+   if (playStatus) *playStatus = waveform->status;
    //Ready
-   return status;
+   return VI_SUCCESS;
 }
 
 //---------------------------------------------------------------------------
-// Function: Get I_Share
-// Purpose:  This function returns the state of the I-share
+// Function: Waveform Get Errors
+// Purpose:  This function returns the timing error (seconds, start of the
+//           write minus deadline) of each point of the table in the cycle
+//           it was written last, 0 for points not written yet. count
+//           returns the number of points of the table, at most size values
+//           are copied.
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_TecGetIShare (ViSession instrumentHandle, ViInt16 *IShare)
+ViStatus _VI_FUNC Pro8_WaveformGetErrors (ViSession instrumentHandle, ViInt32 size, ViReal64 errors[], ViInt32 *count)
 {
-   ViStatus  status = VI_SUCCESS;
-   ViUInt32  retCnt = 0;
-   ViUInt16  stb;
-   ViChar    buffer[CMD_BUF_SIZE];
-   ViBoolean answer;
-   ViString  format[] = {"%*s %s", "%s"};
+   Pro8_tWaveform *waveform;
+   Pro8_tSession  *session;
 
-   if ((status = viGetAttribute (instrumentHandle, VI_ATTR_USER_DATA, &answer)) < 0) return status;
-   //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, ":INTEG?", 7, &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format[answer], buffer)) < 0) return status;
-   //Evaluate
-   if      (CompareStrings ("OFF", 0, buffer, 0, 0) == 0) *IShare = 0;
-   else if (CompareStrings ("ON",  0, buffer, 0, 0) == 0) *IShare = 1;
-   else status = VI_ERROR_INSTR_INTERPRETING_RESPONSE;
+   //Check input parameter ranges
+   if (size < 0)                                                  return VI_ERROR_PARAMETER2;
+   if ((size > 0) && (errors == VI_NULL))                         return VI_ERROR_PARAMETER3;
+   if ((session = Pro8_GetSession (instrumentHandle)) == VI_NULL) return VI_ERROR_NO_SESSION_CONTEXT;
+   if ((waveform = session->waveform) == VI_NULL)                 return VI_ERROR_WAVEFORM_STATE;
+   if (size > waveform->count) size = waveform->count;
+   memcpy (errors, waveform->errors, size * sizeof (ViReal64));
+   if (count) *count = waveform->count;
    //Ready
-   return status;
+   return (size < waveform->count) ? VI_SUCCESS_MAX_CNT : VI_SUCCESS;
 }
 
+//===========================================================================
+// CONTROL LOOP FUNCTIONS
+//===========================================================================
 //---------------------------------------------------------------------------
-// Function: Set Peltier Output
-// Purpose:  This function switches the output on or off
-//---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_TecSetPtOutput (ViSession instrumentHandle, ViInt16 output)
-{
-   ViStatus status    = VI_SUCCESS;
-   ViUInt32 retCnt    = 0;
-   ViUInt16 stb;
-   ViString command[] = {":TEC OFF", ":TEC ON"};
+// Function: Loop Start
+// Purpose:  This function starts the control loop thread of a session.
+//           Every period seconds it reads the input, either the channel
+//           inputChannel of inputSlot or the external input function, and
+//           writes the output of a PID controller to the setpoint
+//           outputParameter of outputSlot:
+//
+//              error  = target - input
+//              output = bias + kp * error + integral - kd * d(input)/dt
+//
+//           with the integral of ki * error. The output is limited to
+//           outputMin..outputMax, the integral is held while the output is
+//           at a limit and would be driven further into it (anti-windup).
+//           The derivative acts on the input, so a new target does not
+//           kick the output. Periods missed by late cycles are skipped. A
+//           failed cycle leaves the output unchanged. The thread runs at
+//           real-time priority if the process is allowed to.
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_LoopStart (ViSession instrumentHandle, Pro8_tLoopConfig *config)
+{
+   Pro8_tLoop     *loop;
+   Pro8_tSession  *session;
 
    //Check input parameter ranges
-   if (Pro8_invalidViInt16Range (output, 0, 1)) return VI_ERROR_PARAMETER2;
-   //Writing - Poll STB - Check EAV Bit and read error
-   if ((status = viWrite (instrumentHandle, command[output], StringLength (command[output]), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
+   if (config == VI_NULL)                                                                      return VI_ERROR_PARAMETER2;
+   if ((config->input == VI_NULL) && Pro8_invalidViInt16Range (config->inputSlot, 1, PRO8_NUM_SLOTS))          return VI_ERROR_PARAMETER2;
+   if ((config->input == VI_NULL) && Pro8_invalidViInt16Range (config->inputChannel, 1, PRO8_CHANNEL_COUNT))   return VI_ERROR_PARAMETER2;
+   if (Pro8_invalidViInt16Range (config->outputSlot, 1, PRO8_NUM_SLOTS))                       return VI_ERROR_PARAMETER2;
+   if (Pro8_invalidViInt16Range (config->outputParameter, 1, PRO8_SETPOINT_COUNT))             return VI_ERROR_PARAMETER2;
+   if (config->outputMin > config->outputMax)                                                  return VI_ERROR_PARAMETER2;
+   if (Pro8_invalidViReal64Range (config->period, PRO8_LOOP_MIN_PERIOD, 3600.0))               return VI_ERROR_PARAMETER2;
+   if ((session = Pro8_GetSession (instrumentHandle)) == VI_NULL)                              return VI_ERROR_NO_SESSION_CONTEXT;
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   if (session->loop) return Pro8_Unlock (instrumentHandle, VI_ERROR_LOOP_STATE);
+   if ((loop = (Pro8_tLoop*)calloc (1, sizeof (Pro8_tLoop))) == VI_NULL) return Pro8_Unlock (instrumentHandle, VI_ERROR_ALLOC);
+   loop->config = *config;
+   loop->query  = config->input ? VI_NULL : Pro8_channelQueries[config->inputChannel];
+   //Thread pool - control loop thread
+   if (CmtNewThreadPool (1, &loop->pool) < 0)
+   {
+      free (loop);
+      return Pro8_Unlock (instrumentHandle, VI_ERROR_SYSTEM_ERROR);
+   }
+   session->loop = loop;
+   if (CmtScheduleThreadPoolFunction (loop->pool, Pro8_LoopWorker, session, &loop->worker) < 0)
+   {
+      session->loop = VI_NULL;
+      CmtDiscardThreadPool (loop->pool);
+      free (loop);
+      return Pro8_Unlock (instrumentHandle, VI_ERROR_SYSTEM_ERROR);
+   }
    //Ready
-   return status;
+   return Pro8_Unlock (instrumentHandle, VI_SUCCESS);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get Peltier Output
-// Purpose:  This function returns the state of the output
+// Function: Loop Stop
+// Purpose:  This function stops the control loop thread of a session after
+//           the current cycle. The output keeps the value last written.
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_TecGetPtOutput (ViSession instrumentHandle, ViInt16 *output)
+ViStatus _VI_FUNC Pro8_LoopStop (ViSession instrumentHandle)
 {
-   ViStatus status = VI_SUCCESS;
-   ViUInt32 retCnt = 0;
-   ViUInt16 stb;
-   ViChar   buffer[CMD_BUF_SIZE];
-   ViBoolean answer;
-   ViString  format[] = {"%*s %s", "%s"};
+   Pro8_tSession  *session;
 
-   if ((status = viGetAttribute (instrumentHandle, VI_ATTR_USER_DATA, &answer)) < 0) return status;
-   //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, ":TEC?", 5, &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format[answer], buffer)) < 0) return status;
-   //Evaluate
-   if      (CompareStrings ("OFF", 0, buffer, 0, 0) == 0) *output = 0;
-   else if (CompareStrings ("ON",  0, buffer, 0, 0) == 0) *output = 1;
-   else status = VI_ERROR_INSTR_INTERPRETING_RESPONSE;
+   if ((session = Pro8_GetSession (instrumentHandle)) == VI_NULL) return VI_ERROR_NO_SESSION_CONTEXT;
+   if (session->loop == VI_NULL) return VI_ERROR_LOOP_STATE;
+   Pro8_LoopFree (session);
    //Ready
-   return status;
+   return VI_SUCCESS;
 }
 
 //---------------------------------------------------------------------------
-// Function: Set Thermistor Calibration (exponential method)
-// Purpose:  This function sets the calibration values for the thermistor
+// Function: Loop Set Parameters
+// Purpose:  This function changes the target and the gains of the running
+//           control loop. The integral is kept, so the output does not
+//           jump.
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_TecSetThCalExp (ViSession instrumentHandle, ViReal64 BValue, ViReal64 RValue, ViReal64 TValue)
+ViStatus _VI_FUNC Pro8_LoopSetParameters (ViSession instrumentHandle, ViReal64 target, ViReal64 kp, ViReal64 ki, ViReal64 kd)
 {
-   ViStatus status = VI_SUCCESS;
-   ViUInt32 retCnt = 0;
-   ViUInt16 stb;
-   ViChar   buffer[CMD_BUF_SIZE];
+   Pro8_tSession  *session;
 
-   //Formatting
-   Fmt (buffer, ":CALTB:SET %f;:CALTR:SET %f;:CALTT:SET %f", BValue, RValue, TValue);
-   //Writing - Poll STB - Check EAV Bit and read error
-   if ((status = viWrite (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
+   if ((session = Pro8_GetSession (instrumentHandle)) == VI_NULL) return VI_ERROR_NO_SESSION_CONTEXT;
+   //Lock session - the thread reads the parameters within the lock
+   Pro8_Lock (instrumentHandle);
+   if (session->loop == VI_NULL) return Pro8_Unlock (instrumentHandle, VI_ERROR_LOOP_STATE);
+   session->loop->config.target = target;
+   session->loop->config.kp     = kp;
+   session->loop->config.ki     = ki;
+   session->loop->config.kd     = kd;
    //Ready
-   return status;
+   return Pro8_Unlock (instrumentHandle, VI_SUCCESS);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get Thermistor Calibration (exponential method)
-// Purpose:  This function returns the calibration values for the thermistor
+// Function: Loop Get Statistics
+// Purpose:  This function returns a consistent copy of the statistics of
+//           the control loop of a session: cycles, missed periods, loop
+//           rate, latency from the input sample to the completed output
+//           and the values of the last cycle.
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_TecGetThCalExp (ViSession instrumentHandle, ViInt16 values, ViReal64 *BValue, ViReal64 *RValue, ViReal64 *TValue)
+ViStatus _VI_FUNC Pro8_LoopGetStatistics (ViSession instrumentHandle, Pro8_tLoopStatistics *statistics)
 {
-   ViStatus  status = VI_SUCCESS;
-   ViUInt32  retCnt = 0;
-   ViUInt16  stb;
-   ViString  command1[] = {":CALTB:MIN?", ":CALTB:MAX?", ":CALTB:SET?"};
-   ViString  command2[] = {":CALTR:MIN?", ":CALTR:MAX?", ":CALTR:SET?"};
-   ViString  command3[] = {":CALTT:MIN?", ":CALTT:MAX?", ":CALTT:SET?"};
-   ViBoolean answer;
-   ViString  format[] = {"%*s %LE", "%LE"};
+   ViUInt32       first;
+   Pro8_tLoop     *loop;
+   Pro8_tSession  *session;
+
+   if (statistics == VI_NULL)                                     return VI_ERROR_PARAMETER2;
+   if ((session = Pro8_GetSession (instrumentHandle)) == VI_NULL) return VI_ERROR_NO_SESSION_CONTEXT;
+   if ((loop = session->loop) == VI_NULL)                         return VI_ERROR_LOOP_STATE;
+   //Consistent copy - retry while the thread writes
+   do
+   {
+      first = loop->sequence;
+      Pro8_MemoryBarrier ();
+      *statistics = loop->statistics;
+      Pro8_MemoryBarrier ();
+   }  while ((first & 1) || (first != loop->sequence));
+   //Ready
+   return VI_SUCCESS;
+}
+
+//===========================================================================
+// SETTLING FUNCTIONS
+//===========================================================================
+//---------------------------------------------------------------------------
+// Function: TEC Wait Settled
+// Purpose:  This function waits until the temperature of a TEC slot has
+//           settled to within tolerance (C) of the set temperature, e.g.
+//           after Pro8_TecSetTemp. It samples the actual temperature every
+//           PRO8_SETTLE_INTERVAL seconds and fits the deviation from the
+//           set temperature x(k) of the last PRO8_SETTLE_WINDOW samples to
+//           a second order response
+//
+//              x(k) = a1 * x(k-1) + a2 * x(k-2) + c
+//
+//           which covers exponential approach and overshoot. The
+//           temperature has settled when the last PRO8_SETTLE_CONFIRM
+//           samples are within tolerance and, if the fit agrees with the
+//           samples to within half the tolerance, the fitted response
+//           stays within tolerance from now on. A fit of a noisy signal
+//           that does not agree is not used. callback (may be VI_NULL) is
+//           called after each sample with the predicted time (seconds)
+//           until the temperature settles, -1 if the fit does not predict
+//           it yet. It returns VI_FALSE to cancel the wait. After timeout
+//           seconds VI_ERROR_TMO is returned. settleTime returns the time
+//           waited and temperature the last sample. The session is locked
+//           for each sample only.
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_TecWaitSettled (ViSession instrumentHandle, ViInt16 slot, ViReal64 tolerance, ViReal64 timeout,
+                                       Pro8_SettleCallback callback, ViAddr callbackData, ViReal64 *settleTime, ViReal64 *temperature)
+{
+   ViStatus       status   = VI_SUCCESS;
+   Pro8_tPoolJob  job;
+   ViInt32        index    = 0;
+   ViInt32        count    = 0;
+   ViInt32        i;
+   ViString       command;
+   ViStatus       result   = VI_SUCCESS;
+   ViReal64       value    = 0.0;
+   ViReal64       target, start, next, elapsed, residual, predicted;
+   ViReal64       model[3];
+   ViReal64       x[PRO8_SETTLE_WINDOW];
+   ViBoolean      settled;
 
-   if ((status = viGetAttribute (instrumentHandle, VI_ATTR_USER_DATA, &answer)) < 0) return status;
    //Check input parameter ranges
-   if (Pro8_invalidViInt16Range (values, 0, 2)) return VI_ERROR_PARAMETER2;
-   //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, command1[values], StringLength (command1[values]), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format[answer], BValue)) < 0) return status;
-   //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, command2[values], StringLength (command2[values]), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format[answer], RValue)) < 0) return status;
-   //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, command3[values], StringLength (command3[values]), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format[answer], TValue)) < 0) return status;
+   if (Pro8_invalidViInt16Range (slot, 1, PRO8_NUM_SLOTS)) return VI_ERROR_PARAMETER2;
+   if (tolerance <= 0.0)                                   return VI_ERROR_PARAMETER3;
+   if (timeout < 0.0)                                      return VI_ERROR_PARAMETER4;
+   if (settleTime)  *settleTime  = 0.0;
+   if (temperature) *temperature = 0.0;
+   memset (&job, 0, sizeof (job));
+   job.count    = 1;
+   job.index    = &index;
+   job.slot     = &slot;
+   job.commands = &command;
+   job.values   = &value;
+   job.results  = &result;
+   //Set temperature
+   command = ":TEMP:SET?";
+   Pro8_Lock (instrumentHandle);
+   status = Pro8_Unlock (instrumentHandle, Pro8_PoolRun (instrumentHandle, &job));
+   if (status >= 0) status = result;
+   if (status < 0) return status;
+   target  = value;
+   command = ":TEMP:ACT?";
+   start   = next = Pro8_TimeNow ();
+   for (;;)
+   {
+      //Sample - at absolute deadlines, the fit needs equal intervals
+      Pro8_Lock (instrumentHandle);
+      status = Pro8_Unlock (instrumentHandle, Pro8_PoolRun (instrumentHandle, &job));
+      if (status >= 0) status = result;
+      if (status < 0) break;
+      elapsed = Pro8_TimeNow () - start;
+      if (temperature) *temperature = value;
+      if (settleTime)  *settleTime  = elapsed;
+      //Window of the last samples
+      if (count == PRO8_SETTLE_WINDOW) memmove (x, &x[1], (PRO8_SETTLE_WINDOW - 1) * sizeof (ViReal64));
+      else count++;
+      x[count - 1] = value - target;
+      //Last samples within tolerance
+      settled = (ViBoolean)(count >= PRO8_SETTLE_CONFIRM);
+      for (i = count - PRO8_SETTLE_CONFIRM; settled && (i < count); i++) settled = (ViBoolean)(fabs (x[i]) <= tolerance);
+      //Fit and prediction - a window without a fit or with a noisy one is predicted by its samples
+      predicted = -1.0;
+      if (count >= PRO8_SETTLE_MIN_SAMPLES)
+      {
+         if (Pro8_SettleFit (x, count, model, &residual) && (residual <= tolerance * 0.5))
+         {
+            predicted = Pro8_SettlePredict (model, x[count - 1], x[count - 2], tolerance) * PRO8_SETTLE_INTERVAL;
+         }
+         else if (settled) predicted = 0.0;
+      }
+      if (settled && (predicted == 0.0)) break;
+      //Progress - timeout
+      if (callback && (callback (instrumentHandle, elapsed, value, predicted, callbackData) == VI_FALSE)) return VI_ERROR_ABORT;
+      if (elapsed >= timeout)
+      {
+         status = VI_ERROR_TMO;
+         break;
+      }
+      next += PRO8_SETTLE_INTERVAL;
+      if (next < Pro8_TimeNow ()) next = Pro8_TimeNow ();
+      Pro8_SleepUntil (next);
+   }
    //Ready
    return status;
 }
 
+//===========================================================================
+// TUNING FUNCTIONS
+//===========================================================================
 //---------------------------------------------------------------------------
-// Function: Set Thermistor Calibration (Steinhart-Hart method)
-// Purpose:  This function sets the calibration values for the thermistor
-//---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_TecSetThCalSH (ViSession instrumentHandle, ViReal64 c1Value, ViReal64 c2Value, ViReal64 c3Value)
-{
-   ViStatus status = VI_SUCCESS;
-   ViUInt32 retCnt = 0;
-   ViUInt16 stb;
-   ViChar   buffer[CMD_BUF_SIZE];
+// Function: TEC Auto Tune
+// Purpose:  This function tunes the PID shares of a TEC or ITC slot around
+//           its set temperature with a relay feedback experiment:
+//
+//           1. The settling time of a step of amplitude (K) up and back is
+//              measured with the present shares (Pro8_TecWaitSettled).
+//           2. With the maximum P share and the minimum I and D shares the
+//              set temperature is switched between +amplitude and
+//              -amplitude whenever the temperature crosses the set
+//              temperature. The amplitude a of the temperature and d of
+//              the TEC current of the oscillation give the ultimate gain
+//              Ku = 4 d / (pi * sqrt (a^2 - h^2)) (A/K, h = hysteresis)
+//              and its period the ultimate period Pu.
+//           3. The TEC current answering a small step with a P share only
+//              and an I share only calibrates the gain of one share unit.
+//           4. The Tyreus-Luyben PI rule Kc = Ku / 3.2, Ti = 2.2 Pu gives
+//              the shares, limited to the MIN/MAX of the module. The D
+//              share is set to its minimum. The shares and the set
+//              temperature are written in one compound command.
+//           5. The settling time of the step is measured again. If it is
+//              not shorter by PRO8_TUNE_MIN_IMPROVEMENT the present shares
+//              are restored.
+//
+//           The temperature is sampled every PRO8_SETTLE_INTERVAL seconds,
+//           the session is locked for each sample only. callback (may be
+//           VI_NULL) is called after each sample with the phase
+//           (PRO8_TUNE_xxx), it returns VI_FALSE to cancel. A phase longer
+//           than timeout seconds ends with VI_ERROR_TMO. After an error the
+//           present shares and the set temperature are restored.
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_TecAutoTune (ViSession instrumentHandle, ViInt16 slot, ViReal64 amplitude, ViReal64 tolerance, ViReal64 timeout,
+                                    Pro8_TuneCallback callback, ViAddr callbackData, Pro8_tTuneResult *result)
+{
+   ViStatus       status   = VI_SUCCESS;
+   ViString       minima[] = {":SHAREP:MIN?", ":SHAREI:MIN?", ":SHARED:MIN?"};
+   ViString       maxima[] = {":SHAREP:MAX?", ":SHAREI:MAX?", ":SHARED:MAX?"};
+   ViString       shares[] = {":SHAREP:SET?", ":SHAREI:SET?", ":SHARED:SET?"};
+   ViReal64       minimum[3], maximum[3], old[3];
+   ViReal64       gain, PGain, IGain, integral;
+   ViInt32        i;
+   Pro8_tTune     tune;
 
-   //Formatting
-   Fmt (buffer, ":CALTC1:SET %f;:CALTC2:SET %f;:CALTC3:SET %f", c1Value, c2Value, c3Value);
-   //Writing - Poll STB - Check EAV Bit and read error
-   if ((status = viWrite (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
+   //Check input parameter ranges
+   if (Pro8_invalidViInt16Range (slot, 1, PRO8_NUM_SLOTS))  return VI_ERROR_PARAMETER2;
+   if (amplitude <= 0.0)                                    return VI_ERROR_PARAMETER3;
+   if (tolerance <= 0.0)                                    return VI_ERROR_PARAMETER4;
+   if (timeout <= 0.0)                                      return VI_ERROR_PARAMETER5;
+   if (result == VI_NULL)                                   return VI_ERROR_PARAMETER8;
+   memset (result, 0, sizeof (Pro8_tTuneResult));
+   memset (&tune, 0, sizeof (tune));
+   tune.instr        = instrumentHandle;
+   tune.slot         = slot;
+   tune.amplitude    = amplitude;
+   tune.tolerance    = tolerance;
+   tune.timeout      = timeout;
+   tune.callback     = callback;
+   tune.callbackData = callbackData;
+   //Bounds - present shares - set temperature
+   for (i = 0; (i < 3) && (status >= 0); i++)
+   {
+      if ((status = Pro8_TuneRun (&tune, minima[i], &minimum[i])) < 0) break;
+      if ((status = Pro8_TuneRun (&tune, maxima[i], &maximum[i])) < 0) break;
+      status = Pro8_TuneRun (&tune, shares[i], &old[i]);
+   }
+   if (status < 0) return status;
+   if ((status = Pro8_TuneRun (&tune, ":TEMP:SET?", &tune.temperature)) < 0) return status;
+   result->oldPShare = old[0];
+   result->oldIShare = old[1];
+   result->oldDShare = old[2];
+   //1. Settling time with the present shares
+   tune.phase = PRO8_TUNE_BASELINE;
+   if ((status = Pro8_TuneStep (&tune, tune.temperature + amplitude, &result->oldSettleTime)) >= 0)
+   {
+      status = Pro8_TuneStep (&tune, tune.temperature, VI_NULL);
+   }
+   //2. Relay experiment - 3. Calibration
+   if (status >= 0)
+   {
+      tune.phase = PRO8_TUNE_RELAY;
+      status = Pro8_TuneRelay (&tune, minimum, maximum, &result->ultimateGain, &result->ultimatePeriod, &result->amplitude);
+   }
+   if (status >= 0)
+   {
+      tune.phase = PRO8_TUNE_CALIBRATE;
+      status = Pro8_TuneCalibrate (&tune, minimum, maximum, &PGain, &IGain);
+   }
+   //4. Shares - written with the set temperature
+   if (status >= 0)
+   {
+      gain     = result->ultimateGain / 3.2;
+      integral = gain / (2.2 * result->ultimatePeriod);
+      result->PShare = gain / PGain;
+      result->IShare = integral / IGain;
+      result->DShare = minimum[2];
+      if (result->PShare < minimum[0]) result->PShare = minimum[0];
+      if (result->PShare > maximum[0]) result->PShare = maximum[0];
+      if (result->IShare < minimum[1]) result->IShare = minimum[1];
+      if (result->IShare > maximum[1]) result->IShare = maximum[1];
+      status = Pro8_TuneShares (&tune, result->PShare, result->IShare, result->DShare, tune.temperature);
+   }
+   //5. Validation - settled at the set temperature first
+   if (status >= 0)
+   {
+      tune.phase = PRO8_TUNE_VALIDATE;
+      if ((status = Pro8_TuneStep (&tune, tune.temperature, VI_NULL)) >= 0)
+      {
+         if ((status = Pro8_TuneStep (&tune, tune.temperature + amplitude, &result->newSettleTime)) >= 0)
+         {
+            status = Pro8_TuneStep (&tune, tune.temperature, VI_NULL);
+         }
+      }
+      result->applied = (ViBoolean)((status >= 0) && (result->newSettleTime < result->oldSettleTime - PRO8_TUNE_MIN_IMPROVEMENT));
+   }
+   //Present shares restored
+   if (result->applied == VI_FALSE)
+   {
+      if (status >= 0) status = Pro8_TuneShares (&tune, old[0], old[1], old[2], tune.temperature);
+      else Pro8_TuneShares (&tune, old[0], old[1], old[2], tune.temperature);
+   }
    //Ready
    return status;
 }
 
+//===========================================================================
+// COUNTER FUNCTIONS
+//===========================================================================
 //---------------------------------------------------------------------------
-// Function: Get Thermistor Calibration (Steinhart-Hart method)
-// Purpose:  This function returns the calibration values for the thermistor
+// Function: Get Counters
+// Purpose:  This function returns the instrumentation counters of a session
+//           for a command class (PRO8_COUNTER_xxx) or their sum. Writes,
+//           reads, status byte polls, the sleeps and waits for the FIN bit
+//           and error queue drains are counted with their cumulative time
+//           for the class of the message written last. An error drain is
+//           counted for the class of the failed command, its messages for
+//           PRO8_COUNTER_ERROR. The function takes no lock, the counters
+//           are copied again while the I/O of the session updates them.
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_TecGetThCalSH (ViSession instrumentHandle, ViInt16 values, ViReal64 *c1Value, ViReal64 *c2Value, ViReal64 *c3Value)
+ViStatus _VI_FUNC Pro8_GetCounters (ViSession instrumentHandle, ViInt16 commandClass, Pro8_tCounters *counters)
 {
-   ViStatus  status     = VI_SUCCESS;
-   ViUInt32  retCnt     = 0;
-   ViUInt16  stb;
-   ViString  command1[] = {":CALTC1:MIN?", ":CALTC1:MAX?", ":CALTC1:SET?"};
-   ViString  command2[] = {":CALTC2:MIN?", ":CALTC2:MAX?", ":CALTC2:SET?"};
-   ViString  command3[] = {":CALTC3:MIN?", ":CALTC3:MAX?", ":CALTC3:SET?"};
-   ViBoolean answer;
-   ViString  format[] = {"%*s %LE", "%LE"};
+   Pro8_tCounters snapshot[PRO8_COUNTER_CLASSES + 1];
+   Pro8_tSession  *session;
 
-   if ((status = viGetAttribute (instrumentHandle, VI_ATTR_USER_DATA, &answer)) < 0) return status;
+   if ((session = Pro8_GetSession (instrumentHandle)) == VI_NULL) return VI_ERROR_NO_SESSION_CONTEXT;
    //Check input parameter ranges
-   if (Pro8_invalidViInt16Range (values, 0, 2)) return VI_ERROR_PARAMETER2;
-   //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, command1[values], StringLength (command1[values]), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format[answer], c1Value)) < 0) return status;
-   //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, command2[values], StringLength (command2[values]), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format[answer], c2Value)) < 0) return status;
-   //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, command3[values], StringLength (command3[values]), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format[answer], c3Value)) < 0) return status;
+   if (Pro8_invalidViInt16Range (commandClass, PRO8_COUNTER_ALL, PRO8_COUNTER_CLASSES)) return VI_ERROR_PARAMETER2;
+   if (counters == VI_NULL) return VI_ERROR_PARAMETER3;
+   //Copy
+   Pro8_CounterSnapshot (session, snapshot);
+   *counters = snapshot[commandClass];
    //Ready
-   return status;
+   return VI_SUCCESS;
 }
 
 //---------------------------------------------------------------------------
-// Function: Set Temperature
-// Purpose:  This function sets the temperature
+// Function: Reset Counters
+// Purpose:  This function sets the instrumentation counters of a session
+//           to 0 and restarts their elapsed time.
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_TecSetTemp (ViSession instrumentHandle, ViReal64 temperature)
+ViStatus _VI_FUNC Pro8_ResetCounters (ViSession instrumentHandle)
 {
-   ViStatus status = VI_SUCCESS;
-   ViUInt32 retCnt = 0;
-   ViUInt16 stb;
-   ViChar   buffer[CMD_BUF_SIZE];
+   Pro8_tSession  *session;
 
-   //Formatting
-   Fmt (buffer, ":TEMP:SET %f", temperature);
-   //Writing - Poll STB - Check EAV Bit and read error
-   if ((status = viWrite (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
+   if ((session = Pro8_GetSession (instrumentHandle)) == VI_NULL) return VI_ERROR_NO_SESSION_CONTEXT;
+   //Lock session - no I/O updates the counters meanwhile
+   Pro8_Lock (instrumentHandle);
+   session->counterSequence++;
+   Pro8_MemoryBarrier ();
+   memset (session->counters, 0, sizeof (session->counters));
+   session->counterReset = Pro8_TimeNow ();
+   Pro8_MemoryBarrier ();
+   session->counterSequence++;
    //Ready
-   return status;
+   return Pro8_Unlock (instrumentHandle, VI_SUCCESS);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get Temperature
-// Purpose:  This function returns the temperature
+// Function: Get Metrics
+// Purpose:  This function returns the counters of all sessions opened by
+//           Pro8_init as text in the Prometheus exposition format, one line
+//           per counter, session and command class, e.g.
+//           pro8_writes_total{session="1",transport="VISA",class="query"} 42
+//           This is the text served by Pro8_MetricsStart. length returns
+//           the length of the whole text. If it does not fit size, the
+//           text is cut after the last whole line and VI_SUCCESS_MAX_CNT is
+//           returned.
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_TecGetTemp (ViSession instrumentHandle, ViInt16 value, ViReal64 *temperature)
+ViStatus _VI_FUNC Pro8_GetMetrics (ViInt32 size, ViChar _VI_FAR text[], ViInt32 *length)
 {
-   ViStatus  status    = VI_SUCCESS;
-   ViUInt32  retCnt    = 0;
-   ViUInt16  stb;
-   ViString  command[] = {":TEMP:MIN?", ":TEMP:MAX?", ":TEMP:SET?", ":TEMP:ACT?"};
-   ViBoolean answer;
-   ViString  format[] = {"%*s %LE", "%LE"};
+   ViInt32 n;
 
-   if ((status = viGetAttribute (instrumentHandle, VI_ATTR_USER_DATA, &answer)) < 0) return status;
    //Check input parameter ranges
-   if (Pro8_invalidViInt16Range (value, 0, 3)) return VI_ERROR_PARAMETER2;
-   //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, command[value], StringLength (command[value]), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format[answer], temperature)) < 0) return status;
+   if (size < 1)        return VI_ERROR_PARAMETER1;
+   if (text == VI_NULL) return VI_ERROR_PARAMETER2;
+   //Formatting
+   n = Pro8_FormatMetrics (text, size);
+   if (length) *length = n;
    //Ready
-   return status;
+   return (n < size) ? VI_SUCCESS : VI_SUCCESS_MAX_CNT;
 }
 
 //---------------------------------------------------------------------------
-// Function: Set Resistance
-// Purpose:  This function sets the resistance
+// Function: Metrics Start
+// Purpose:  This function starts a thread serving the text of
+//           Pro8_GetMetrics on a TCP port of the loopback interface
+//           (PRO8_METRICS_DEFAULT_PORT if port is 0). Each connection gets
+//           the current text as an HTTP response and is closed, so the port
+//           can be scraped by Prometheus, e.g.
+//           "curl http://localhost:9180/metrics". The clients are served
+//           one at a time, a stalled client delays the next one by at most
+//           PRO8_METRICS_CLIENT_TIMEOUT. Only available on Linux.
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_TecSetRes (ViSession instrumentHandle, ViReal64 resistance)
+ViStatus _VI_FUNC Pro8_MetricsStart (ViInt32 port)
 {
-   ViStatus status = VI_SUCCESS;
-   ViUInt32 retCnt = 0;
-   ViUInt16 stb;
-   ViChar   buffer[CMD_BUF_SIZE];
+#if defined(__linux__)
+   Pro8_tMetrics      *metrics;
+   struct sockaddr_in address;
+   int                one = 1;
 
-   //Formatting
-   Fmt (buffer, ":RESI:SET %f", resistance);
-   //Writing - Poll STB - Check EAV Bit and read error
-   if ((status = viWrite (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
+   //Check input parameter ranges
+   if (Pro8_invalidViInt32Range (port, 0, 65535)) return VI_ERROR_PARAMETER1;
+   if (Pro8_metricsServer) return VI_ERROR_METRICS_STATE;
+   if (port == 0) port = PRO8_METRICS_DEFAULT_PORT;
+   if ((metrics = (Pro8_tMetrics*)calloc (1, sizeof (Pro8_tMetrics))) == VI_NULL) return VI_ERROR_ALLOC;
+   //Listening socket - local clients only
+   if ((metrics->fd = socket (AF_INET, SOCK_STREAM, 0)) < 0)
+   {
+      free (metrics);
+      return VI_ERROR_SYSTEM_ERROR;
+   }
+   setsockopt (metrics->fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof (one));
+   memset (&address, 0, sizeof (address));
+   address.sin_family      = AF_INET;
+   address.sin_port        = htons ((unsigned short)port);
+   address.sin_addr.s_addr = htonl (INADDR_LOOPBACK);
+   if ((bind (metrics->fd, (struct sockaddr*)&address, sizeof (address)) < 0) || (listen (metrics->fd, 4) < 0))
+   {
+      close (metrics->fd);
+      free (metrics);
+      return VI_ERROR_RSRC_BUSY;
+   }
+   //Thread pool - metrics thread
+   if (CmtNewThreadPool (1, &metrics->pool) < 0)
+   {
+      close (metrics->fd);
+      free (metrics);
+      return VI_ERROR_SYSTEM_ERROR;
+   }
+   if (CmtScheduleThreadPoolFunction (metrics->pool, Pro8_MetricsWorker, metrics, &metrics->worker) < 0)
+   {
+      CmtDiscardThreadPool (metrics->pool);
+      close (metrics->fd);
+      free (metrics);
+      return VI_ERROR_SYSTEM_ERROR;
+   }
+   Pro8_metricsServer = metrics;
    //Ready
-   return status;
+   return VI_SUCCESS;
+#else
+   return VI_ERROR_NSUP_OPER;
+#endif
 }
 
 //---------------------------------------------------------------------------
-// Function: Get Resistance
-// Purpose:  This function returns the resistance
+// Function: Metrics Stop
+// Purpose:  This function stops the thread started by Pro8_MetricsStart
+//           and closes its port.
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_TecGetRes (ViSession instrumentHandle, ViInt16 value, ViReal64 *resistance)
+ViStatus _VI_FUNC Pro8_MetricsStop (void)
 {
-   ViStatus  status = VI_SUCCESS;
-   ViUInt32  retCnt = 0;
-   ViUInt16  stb;
-   ViString  command[] = {":RESI:MIN?", ":RESI:MAX?", ":RESI:SET?", ":RESI:ACT?"};
-   ViBoolean answer;
-   ViString  format[] = {"%*s %LE", "%LE"};
+   Pro8_tMetrics *metrics;
 
-   if ((status = viGetAttribute (instrumentHandle, VI_ATTR_USER_DATA, &answer)) < 0) return status;
-   //Check input parameter ranges
-   if (Pro8_invalidViInt16Range (value, 0, 3)) return VI_ERROR_PARAMETER2;
-   //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, command[value], StringLength (command[value]), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format[answer], resistance)) < 0) return status;
+   if ((metrics = Pro8_metricsServer) == VI_NULL) return VI_ERROR_METRICS_STATE;
+   //Stop thread - it checks the flag between connections
+   metrics->stop = VI_TRUE;
+   CmtWaitForThreadPoolFunctionCompletion (metrics->pool, metrics->worker, 0);
+   CmtReleaseThreadPoolFunctionID (metrics->pool, metrics->worker);
+   CmtDiscardThreadPool (metrics->pool);
+#if defined(__linux__)
+   close (metrics->fd);
+#endif
+   Pro8_metricsServer = VI_NULL;
+   free (metrics);
    //Ready
-   return status;
+   return VI_SUCCESS;
 }
 
+//===========================================================================
+// OSW MODULE FUNCTIONS
+//===========================================================================
 //---------------------------------------------------------------------------
-// Function: Set Temperature Window
-// Purpose:  This function sets the temperature window
+// Function: Set State
+// Purpose:  This function sets the switch state
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_TecSetTempWin (ViSession instrumentHandle, ViReal64 temperatureWindow)
+ViStatus _VI_FUNC Pro8_OswSetState (ViSession instrumentHandle, ViInt16 state)
 {
    ViStatus status = VI_SUCCESS;
    ViUInt32 retCnt = 0;
    ViUInt16 stb;
    ViChar   buffer[CMD_BUF_SIZE];
 
+   //Check input parameter ranges
+   if (Pro8_invalidViInt16Range (state, 1, 8)) return VI_ERROR_PARAMETER2;
+   //Lock session
+   Pro8_Lock (instrumentHandle);
    //Formatting
-   Fmt (buffer, ":TWIN:SET %f", temperatureWindow);
+   Pro8_Fmt (buffer, ":OSW %d", state);
    //Writing - Poll STB - Check EAV Bit and read error
-   if ((status = viWrite (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
+   if ((status = Pro8_Write (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
    //Ready
-   return status;
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get Temperature Window
-// Purpose:  This function returns the temperature window
+// Function: Get State
+// Purpose:  This function returns the switch state
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_TecGetTempWin (ViSession instrumentHandle, ViInt16 value, ViReal64 *temperatureWindow)
+ViStatus _VI_FUNC Pro8_OswGetState (ViSession instrumentHandle, ViInt16 *state)
 {
    ViStatus  status = VI_SUCCESS;
    ViUInt32  retCnt = 0;
    ViUInt16  stb;
-   ViString  command[] = {":TWIN:MIN?", ":TWIN:MAX?", ":TWIN:SET?"};
    ViBoolean answer;
-   ViString  format[] = {"%*s %LE", "%LE"};
+   ViString  format[] = {"%*s %d", "%d"};
 
-   if ((status = viGetAttribute (instrumentHandle, VI_ATTR_USER_DATA, &answer)) < 0) return status;
-   //Check input parameter ranges
-   if (Pro8_invalidViInt16Range (value, 0, 2)) return VI_ERROR_PARAMETER2;
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   if ((status = Pro8_GetAnswer (instrumentHandle, &answer)) < 0) return Pro8_Unlock (instrumentHandle, status);
    //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, command[value], StringLength (command[value]), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format[answer], temperatureWindow)) < 0) return status;
+   if ((status = Pro8_Write (instrumentHandle, ":OSW?", 5, &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
+   if ((status = Pro8_Scanf (instrumentHandle, format[answer], state)) < 0) return Pro8_Unlock (instrumentHandle, status);
    //Ready
-   return status;
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
+//===========================================================================
+// LDC MODULE FUNCTIONS
+//===========================================================================
 //---------------------------------------------------------------------------
-// Function: Set Resistance Window
-// Purpose:  This function sets the resistance window
+// Function: Set Mode
+// Purpose:  This function sets the operation mode
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_TecSetResWin (ViSession instrumentHandle, ViReal64 resistanceWindow)
+ViStatus _VI_FUNC Pro8_LdcSetMode (ViSession instrumentHandle, ViInt16 mode)
 {
-   ViStatus status = VI_SUCCESS;
-   ViUInt32 retCnt = 0;
+   ViStatus status    = VI_SUCCESS;
+   ViUInt32 retCnt    = 0;
    ViUInt16 stb;
-   ViChar   buffer[CMD_BUF_SIZE];
+   ViString command[] = {":MODE CC", ":MODE CP"};
 
-   //Formatting
-   Fmt (buffer, ":RWIN:SET %f", resistanceWindow);
+   //Check input parameter ranges
+   if (Pro8_invalidViInt16Range (mode, 0, 1)) return VI_ERROR_PARAMETER2;
+   //Lock session
+   Pro8_Lock (instrumentHandle);
    //Writing - Poll STB - Check EAV Bit and read error
-   if ((status = viWrite (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
+   if ((status = Pro8_Write (instrumentHandle, command[mode], StringLength (command[mode]), &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
    //Ready
-   return status;
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get Resistance Window
-// Purpose:  This function returns the resistance window
+// Function: Get Mode
+// Purpose:  This function returns the operation mode
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_TecGetResWin (ViSession instrumentHandle, ViInt16 value, ViReal64 *resistanceWindow)
+ViStatus _VI_FUNC Pro8_LdcGetMode (ViSession instrumentHandle, ViInt16 *mode)
 {
    ViStatus  status = VI_SUCCESS;
-   ViUInt32  retCnt = 0;
-   ViUInt16  stb;
-   ViString  command[] = {":RWIN:MIN?", ":RWIN:MAX?", ":RWIN:SET?"};
+   ViChar    buffer[CMD_BUF_SIZE];
    ViBoolean answer;
-   ViString  format[] = {"%*s %LE", "%LE"};
 
-   if ((status = viGetAttribute (instrumentHandle, VI_ATTR_USER_DATA, &answer)) < 0) return status;
-   //Check input parameter ranges
-   if (Pro8_invalidViInt16Range (value, 0, 2)) return VI_ERROR_PARAMETER2;
-   //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, command[value], StringLength (command[value]), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format[answer], resistanceWindow)) < 0) return status;
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   if ((status = Pro8_GetAnswer (instrumentHandle, &answer)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Shadow model or Writing - Poll STB - Check EAV Bit and read error - Reading
+   if ((status = Pro8_ShadowQuery (instrumentHandle, ":MODE?", answer, buffer, sizeof (buffer))) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Evaluate
+   if      (CompareStrings ("CC", 0, buffer, 0, 0) == 0) *mode = 0;
+   else if (CompareStrings ("CP", 0, buffer, 0, 0) == 0) *mode = 1;
+   else status = VI_ERROR_INSTR_INTERPRETING_RESPONSE;
    //Ready
-   return status;
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
-// Function: Set PID Shares
-// Purpose:  This function sets the PID shares
+// Function: Set Laser Polarity
+// Purpose:  This function sets the polarity of the laserdiode
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_TecSetPID (ViSession instrumentHandle, ViReal64 PShare, ViReal64 IShare, ViReal64 DShare)
+ViStatus _VI_FUNC Pro8_LdcSetLdPol (ViSession instrumentHandle, ViInt16 polarity)
 {
-   ViStatus status = VI_SUCCESS;
-   ViUInt32 retCnt = 0;
+   ViStatus status    = VI_SUCCESS;
+   ViUInt32 retCnt    = 0;
    ViUInt16 stb;
-   ViChar   buffer[CMD_BUF_SIZE];
+   ViString command[] = {":LDPOL CG", ":LDPOL AG"};
 
-   //Formatting
-   Fmt (buffer, ":SHAREP:SET %f;:SHAREI:SET %f;:SHARED:SET %f", PShare, IShare, DShare);
+   //Check input parameter ranges
+   if (Pro8_invalidViInt16Range (polarity, 0, 1)) return VI_ERROR_PARAMETER2;
+   //Lock session
+   Pro8_Lock (instrumentHandle);
    //Writing - Poll STB - Check EAV Bit and read error
-   if ((status = viWrite (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
+   if ((status = Pro8_Write (instrumentHandle, command[polarity], StringLength (command[polarity]), &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
    //Ready
-   return status;
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get PID Shares
-// Purpose:  This function returns the PID shares
+// Function: Get Laser Polarity
+// Purpose:  This function returns the polarity of the laserdiode
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_TecGetPID (ViSession instrumentHandle, ViInt16 values, ViReal64 *PShare, ViReal64 *IShare, ViReal64 *DShare)
+ViStatus _VI_FUNC Pro8_LdcGetLdPol (ViSession instrumentHandle, ViInt16 *polarity)
 {
    ViStatus  status = VI_SUCCESS;
-   ViUInt32  retCnt = 0;
-   ViUInt16  stb;
-   ViString  command1[] = {":SHAREP:MIN?", ":SHAREP:MAX?", ":SHAREP:SET?"};
-   ViString  command2[] = {":SHAREI:MIN?", ":SHAREI:MAX?", ":SHAREI:SET?"};
-   ViString  command3[] = {":SHARED:MIN?", ":SHARED:MAX?", ":SHARED:SET?"};
+   ViChar    buffer[CMD_BUF_SIZE];
    ViBoolean answer;
-   ViString  format[] = {"%*s %LE", "%LE"};
 
-   if ((status = viGetAttribute (instrumentHandle, VI_ATTR_USER_DATA, &answer)) < 0) return status;
-   //Check input parameter ranges
-   if (Pro8_invalidViInt16Range (values, 0, 2)) return VI_ERROR_PARAMETER2;
-   //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, command1[values], StringLength (command1[values]), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format[answer], PShare)) < 0) return status;
-   //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, command2[values], StringLength (command2[values]), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format[answer], IShare)) < 0) return status;
-   //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, command3[values], StringLength (command3[values]), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format[answer], DShare)) < 0) return status;
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   if ((status = Pro8_GetAnswer (instrumentHandle, &answer)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Shadow model or Writing - Poll STB - Check EAV Bit and read error - Reading
+   if ((status = Pro8_ShadowQuery (instrumentHandle, ":LDPOL?", answer, buffer, sizeof (buffer))) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Evaluate
+   if      (CompareStrings ("CG", 0, buffer, 0, 0) == 0) *polarity = 0;
+   else if (CompareStrings ("AG", 0, buffer, 0, 0) == 0) *polarity = 1;
+   else status = VI_ERROR_INSTR_INTERPRETING_RESPONSE;
    //Ready
-   return status;
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
-// Function: Set Peltier Limit Current
-// Purpose:  This function sets the limit current of the peltier
+// Function: Set Photodiode Polarity
+// Purpose:  This function sets the photodiode polarity
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_TecSetPtLimit (ViSession instrumentHandle, ViReal64 limitCurrent)
+ViStatus _VI_FUNC Pro8_LdcSetPdPol (ViSession instrumentHandle, ViInt16 polarity)
 {
-   ViStatus status = VI_SUCCESS;
-   ViUInt32 retCnt = 0;
+   ViStatus status    = VI_SUCCESS;
+   ViUInt32 retCnt    = 0;
    ViUInt16 stb;
-   ViChar   buffer[CMD_BUF_SIZE];
+   ViString command[] = {":PDPOL CG", ":PDPOL AG"};
 
-   //Formatting
-   Fmt (buffer, ":LIMT:SET %f", limitCurrent);
+   //Check input parameter ranges
+   if (Pro8_invalidViInt16Range (polarity, 0, 1)) return VI_ERROR_PARAMETER2;
+   //Lock session
+   Pro8_Lock (instrumentHandle);
    //Writing - Poll STB - Check EAV Bit and read error
-   if ((status = viWrite (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
+   if ((status = Pro8_Write (instrumentHandle, command[polarity], StringLength (command[polarity]), &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
    //Ready
-   return status;
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get Peltier Limit Current
-// Purpose:  This function returns the limit current of the peltier
+// Function: Get Photodiode Polarity
+// Purpose:  This function returns the photodiode polarity
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_TecGetPtLimit (ViSession instrumentHandle, ViInt16 value, ViReal64 *limitCurrent)
+ViStatus _VI_FUNC Pro8_LdcGetPdPol (ViSession instrumentHandle, ViInt16 *polarity)
 {
-   ViStatus status = VI_SUCCESS;
-   ViUInt32 retCnt = 0;
-   ViUInt16 stb;
-   ViString command[] = {":LIMT:MIN?", ":LIMT:MAX?", ":LIMT:SET?"};
+   ViStatus  status = VI_SUCCESS;
+   ViChar    buffer[CMD_BUF_SIZE];
    ViBoolean answer;
-   ViString  format[] = {"%*s %LE", "%LE"};
 
-   if ((status = viGetAttribute (instrumentHandle, VI_ATTR_USER_DATA, &answer)) < 0) return status;
-   //Check input parameter ranges
-   if (Pro8_invalidViInt16Range (value, 0, 2)) return VI_ERROR_PARAMETER2;
-   //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, command[value], StringLength (command[value]), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format[answer], limitCurrent)) < 0) return status;
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   if ((status = Pro8_GetAnswer (instrumentHandle, &answer)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Shadow model or Writing - Poll STB - Check EAV Bit and read error - Reading
+   if ((status = Pro8_ShadowQuery (instrumentHandle, ":PDPOL?", answer, buffer, sizeof (buffer))) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Evaluate
+   if      (CompareStrings ("CG", 0, buffer, 0, 0) == 0) *polarity = 0;
+   else if (CompareStrings ("AG", 0, buffer, 0, 0) == 0) *polarity = 1;
+   else status = VI_ERROR_INSTR_INTERPRETING_RESPONSE;
    //Ready
-   return status;
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get Peltier Limit Current (adjusted via poti)
-// Purpose:  This function returns the limit current of the peltier
+// Function: Set Photodiode Bias
+// Purpose:  This function switches the photodiode bias
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_TecGetPtLimitPoti (ViSession instrumentHandle, ViReal64 *limitCurrent)
+ViStatus _VI_FUNC Pro8_LdcSetBias (ViSession instrumentHandle, ViInt16 bias)
 {
-   ViStatus  status = VI_SUCCESS;
-   ViUInt32  retCnt = 0;
-   ViUInt16  stb;
-   ViBoolean answer;
-   ViString  format[] = {"%*s %LE", "%LE"};
+   ViStatus status    = VI_SUCCESS;
+   ViUInt32 retCnt    = 0;
+   ViUInt16 stb;
+   ViString command[] = {":PDBIA OFF", ":PDBIA ON"};
 
-   if ((status = viGetAttribute (instrumentHandle, VI_ATTR_USER_DATA, &answer)) < 0) return status;
-   //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, ":LIMTP:ACT?", 11, &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format[answer], limitCurrent)) < 0) return status;
+   //Check input parameter ranges
+   if (Pro8_invalidViInt16Range (bias, 0, 1)) return VI_ERROR_PARAMETER2;
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   //Writing - Poll STB - Check EAV Bit and read error
+   if ((status = Pro8_Write (instrumentHandle, command[bias], StringLength (command[bias]), &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
    //Ready
-   return status;
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get Peltier Current
-// Purpose:  This function returns the current of the peltier
+// Function: Get Photodiode Bias
+// Purpose:  This function returns the state of the photodiode bias
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_TecGetPtCurrent (ViSession instrumentHandle, ViReal64 *current)
+ViStatus _VI_FUNC Pro8_LdcGetBias (ViSession instrumentHandle, ViInt16 *bias)
 {
    ViStatus  status = VI_SUCCESS;
-   ViUInt32  retCnt = 0;
-   ViUInt16  stb;
+   ViChar    buffer[CMD_BUF_SIZE];
    ViBoolean answer;
-   ViString  format[] = {"%*s %LE", "%LE"};
 
-   if ((status = viGetAttribute (instrumentHandle, VI_ATTR_USER_DATA, &answer)) < 0) return status;
-   //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, ":ITE:ACT?", 9, &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format[answer], current)) < 0) return status;
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   if ((status = Pro8_GetAnswer (instrumentHandle, &answer)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Shadow model or Writing - Poll STB - Check EAV Bit and read error - Reading
+   if ((status = Pro8_ShadowQuery (instrumentHandle, ":PDBIA?", answer, buffer, sizeof (buffer))) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Evaluate
+   if      (CompareStrings ("OFF", 0, buffer, 0, 0) == 0) *bias = 0;
+   else if (CompareStrings ("ON",  0, buffer, 0, 0) == 0) *bias = 1;
+   else status = VI_ERROR_INSTR_INTERPRETING_RESPONSE;
    //Ready
-   return status;
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get Peltier Voltage
-// Purpose:  This function returns the voltage of the peltier
+// Function: Set Temperature Protection Slot
+// Purpose:  This function sets the slot for temperature protection
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_TecGetPtVoltage (ViSession instrumentHandle, ViReal64 *voltage)
+ViStatus _VI_FUNC Pro8_LdcSetTpSlot (ViSession instrumentHandle, ViInt16 slot)
 {
-   ViStatus  status = VI_SUCCESS;
-   ViUInt32  retCnt = 0;
-   ViUInt16  stb;
-   ViBoolean answer;
-   ViString  format[] = {"%*s %LE", "%LE"};
+   ViStatus status = VI_SUCCESS;
+   ViUInt32 retCnt = 0;
+   ViUInt16 stb;
+   ViChar   buffer[CMD_BUF_SIZE];
 
-   if ((status = viGetAttribute (instrumentHandle, VI_ATTR_USER_DATA, &answer)) < 0) return status;
-   //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, ":VTE:ACT?", 9, &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format[answer], voltage)) < 0) return status;
+   //Check input parameter ranges
+   if (Pro8_invalidViInt16Range (slot, 1, 8)) return VI_ERROR_PARAMETER2;
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   //Formatting
+   Pro8_Fmt (buffer, ":TPSLOT %d", slot);
+   //Writing - Poll STB - Check EAV Bit and read error
+   if ((status = Pro8_Write (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
    //Ready
-   return status;
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
-//===========================================================================
-// ITC MODULE FUNCTIONS
-//===========================================================================
 //---------------------------------------------------------------------------
-// Function: Set Mode
-// Purpose:  This function sets the operation mode
+// Function: Get Temperature Protection Slot
+// Purpose:  This function returns the slot used for temperature protection
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_ItcSetMode (ViSession instrumentHandle, ViInt16 mode)
+ViStatus _VI_FUNC Pro8_LdcGetTpSlot (ViSession instrumentHandle, ViInt16 *slot)
 {
-   return Pro8_LdcSetMode (instrumentHandle, mode);
+   ViStatus  status = VI_SUCCESS;
+   ViChar    buffer[CMD_BUF_SIZE];
+   ViBoolean answer;
+
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   if ((status = Pro8_GetAnswer (instrumentHandle, &answer)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Shadow model or Writing - Poll STB - Check EAV Bit and read error - Reading
+   if ((status = Pro8_ShadowQuery (instrumentHandle, ":TPSLOT?", answer, buffer, sizeof (buffer))) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Evaluate
+   *slot = (ViInt16)atoi (buffer);
+   //Ready
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get Mode
-// Purpose:  This function returns the operation mode
+// Function: Set Temperature Protection
+// Purpose:  This function switches the temperature protection
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_ItcGetMode (ViSession instrumentHandle, ViInt16 *mode)
+ViStatus _VI_FUNC Pro8_LdcSetTempProt (ViSession instrumentHandle, ViInt16 tempProtection)
 {
-   return Pro8_LdcGetMode (instrumentHandle, mode);
+   ViStatus status    = VI_SUCCESS;
+   ViUInt32 retCnt    = 0;
+   ViUInt16 stb;
+   ViString command[] = {":TP OFF", ":TP ON"};
+
+   //Check input parameter ranges
+   if (Pro8_invalidViInt16Range (tempProtection, 0, 1)) return VI_ERROR_PARAMETER2;
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   //Writing - Poll STB - Check EAV Bit and read error
+   if ((status = Pro8_Write (instrumentHandle, command[tempProtection], StringLength (command[tempProtection]), &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
+   //Ready
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
-// Function: Set Laser Polarity
-// Purpose:  This function sets the polarity of the laserdiode
+// Function: Get Temperature Protection
+// Purpose:  This function returns the state of the temperature protection
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_ItcSetLdPol (ViSession instrumentHandle, ViInt16 polarity)
-{
-   return Pro8_LdcSetLdPol (instrumentHandle, polarity);
-}
-
-//---------------------------------------------------------------------------
-// Function: Get Laser Polarity
-// Purpose:  This function returns the polarity of the laserdiode
-//---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_ItcGetLdPol (ViSession instrumentHandle, ViInt16 *polarity)
-{
-   return Pro8_LdcGetLdPol (instrumentHandle, polarity);
-}
-
-//---------------------------------------------------------------------------
-// Function: Set Photodiode Polarity
-// Purpose:  This function sets the photodiode polarity
-//---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_ItcSetPdPol (ViSession instrumentHandle, ViInt16 polarity)
-{
-   return Pro8_LdcSetPdPol (instrumentHandle, polarity);
-}
-
-//---------------------------------------------------------------------------
-// Function: Get Photodiode Polarity
-// Purpose:  This function returns the photodiode polarity
-//---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_ItcGetPdPol (ViSession instrumentHandle, ViInt16 *polarity)
-{
-   return Pro8_LdcGetPdPol (instrumentHandle, polarity);
-}
-
-//---------------------------------------------------------------------------
-// Function: Set Temperature Protection
-// Purpose:  This function switches the temperature protection
-//---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_ItcSetTempProt (ViSession instrumentHandle, ViInt16 tempProtection)
+ViStatus _VI_FUNC Pro8_LdcGetTempProt (ViSession instrumentHandle, ViInt16 *temperatureProtection)
 {
-   return Pro8_LdcSetTempProt (instrumentHandle, tempProtection);
-}
+   ViStatus  status = VI_SUCCESS;
+   ViChar    buffer[CMD_BUF_SIZE];
+   ViBoolean answer;
 
-//---------------------------------------------------------------------------
-// Function: Get Temperature Protection
-// Purpose:  This function returns the state of the temperature protection
-//---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_ItcGetTempProt (ViSession instrumentHandle, ViInt16 *temperatureProtection)
-{
-   return Pro8_LdcGetTempProt (instrumentHandle, temperatureProtection);
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   if ((status = Pro8_GetAnswer (instrumentHandle, &answer)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Shadow model or Writing - Poll STB - Check EAV Bit and read error - Reading
+   if ((status = Pro8_ShadowQuery (instrumentHandle, ":TP?", answer, buffer, sizeof (buffer))) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Evaluate
+   if      (CompareStrings ("OFF", 0, buffer, 0, 0) == 0) *temperatureProtection = 0;
+   else if (CompareStrings ("ON",  0, buffer, 0, 0) == 0) *temperatureProtection = 1;
+   else status = VI_ERROR_INSTR_INTERPRETING_RESPONSE;
+   //Ready
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
 // Function: Set Laser Output
 // Purpose:  This function switches the output on or off
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_ItcSetLdOutput (ViSession instrumentHandle, ViInt16 output)
-{
-   return Pro8_LdcSetLdOutput (instrumentHandle, output);
-}
-
-//---------------------------------------------------------------------------
-// Function: Get Laser Output
-// Purpose:  This function returns the state of the output
-//---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_ItcGetLdOutput (ViSession instrumentHandle, ViInt16 *output)
-{
-   return Pro8_LdcGetLdOutput (instrumentHandle, output);
-}
-
-//---------------------------------------------------------------------------
-// Function: Set Sensor
-// Purpose:  This function sets the temperature sensor
-//---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_ItcSetSensor (ViSession instrumentHandle, ViInt16 sensor)
+ViStatus _VI_FUNC Pro8_LdcSetLdOutput (ViSession instrumentHandle, ViInt16 output)
 {
    ViStatus status    = VI_SUCCESS;
    ViUInt32 retCnt    = 0;
    ViUInt16 stb;
-   ViString command[] = {":SENS AD", ":SENS TH"};
+   ViString command[] = {":LASER OFF", ":LASER ON"};
 
    //Check input parameter ranges
-   if (Pro8_invalidViInt16Range (sensor, 0, 1)) return VI_ERROR_PARAMETER2;
+   if (Pro8_invalidViInt16Range (output, 0, 1)) return VI_ERROR_PARAMETER2;
+   //Lock session
+   Pro8_Lock (instrumentHandle);
    //Writing - Poll STB - Check EAV Bit and read error
-   if ((status = viWrite (instrumentHandle, command[sensor], StringLength (command[sensor]), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
+   if ((status = Pro8_Write (instrumentHandle, command[output], StringLength (command[output]), &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
    //Ready
-   return status;
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get Sensor
-// Purpose:  This function returns the temperature sensor
+// Function: Get Laser Output
+// Purpose:  This function returns the state of the output
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_ItcGetSensor (ViSession instrumentHandle, ViInt16 *sensor)
+ViStatus _VI_FUNC Pro8_LdcGetLdOutput (ViSession instrumentHandle, ViInt16 *output)
 {
    ViStatus  status = VI_SUCCESS;
    ViUInt32  retCnt = 0;
@@ -2732,1771 +4455,1908 @@ ViStatus _VI_FUNC Pro8_ItcGetSensor (ViSession instrumentHandle, ViInt16 *sensor
    ViBoolean answer;
    ViString  format[] = {"%*s %s", "%s"};
 
-   if ((status = viGetAttribute (instrumentHandle, VI_ATTR_USER_DATA, &answer)) < 0) return status;
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   if ((status = Pro8_GetAnswer (instrumentHandle, &answer)) < 0) return Pro8_Unlock (instrumentHandle, status);
    //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, ":SENS?", 6, &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format[answer], buffer)) < 0) return status;
+   if ((status = Pro8_Write (instrumentHandle, ":LASER?", 7, &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
+   if ((status = Pro8_Scanf (instrumentHandle, format[answer], buffer)) < 0) return Pro8_Unlock (instrumentHandle, status);
    //Evaluate
-   if      (CompareStrings ("AD", 0, buffer, 0, 0) == 0) *sensor = 0;
-   else if (CompareStrings ("TH", 0, buffer, 0, 0) == 0) *sensor = 1;
+   if      (CompareStrings ("OFF", 0, buffer, 0, 0) == 0) *output = 0;
+   else if (CompareStrings ("ON",  0, buffer, 0, 0) == 0) *output = 1;
    else status = VI_ERROR_INSTR_INTERPRETING_RESPONSE;
    //Ready
-   return status;
-}
-
-//---------------------------------------------------------------------------
-// Function: Set I-Share
-// Purpose:  This function switches the I-share on and off
-//---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_ItcSetIShare (ViSession instrumentHandle, ViInt16 IShare)
-{
-   return Pro8_TecSetIShare (instrumentHandle, IShare);
-}
-
-//---------------------------------------------------------------------------
-// Function: Get I_Share
-// Purpose:  This function returns the state of the I-share
-//---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_ItcGetIShare (ViSession instrumentHandle, ViInt16 *IShare)
-{
-   return Pro8_TecGetIShare (instrumentHandle, IShare);
-}
-
-//---------------------------------------------------------------------------
-// Function: Set Peltier Output
-// Purpose:  This function switches the output on or off
-//---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_ItcSetPtOutput (ViSession instrumentHandle, ViInt16 output)
-{
-   return Pro8_TecSetPtOutput (instrumentHandle, output);
-}
-
-//---------------------------------------------------------------------------
-// Function: Get Peltier Output
-// Purpose:  This function returns the state of the output
-//---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_ItcGetPtOutput (ViSession instrumentHandle, ViInt16 *output)
-{
-   return Pro8_TecGetPtOutput (instrumentHandle, output);
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
 // Function: Set Calibration Factor
 // Purpose:  This function sets the calibration factor of the photodiode
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_ItcSetCalibration (ViSession instrumentHandle, ViReal64 calibrationFactor)
+ViStatus _VI_FUNC Pro8_LdcSetCalibration (ViSession instrumentHandle, ViReal64 calibrationFactor)
 {
-   return Pro8_LdcSetCalibration (instrumentHandle, calibrationFactor);
+   ViStatus status = VI_SUCCESS;
+   ViUInt32 retCnt = 0;
+   ViUInt16 stb;
+   ViChar   buffer[CMD_BUF_SIZE];
+
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   //Formatting
+   Pro8_Fmt (buffer, ":CALPD:SET %f", calibrationFactor);
+   //Writing - Poll STB - Check EAV Bit and read error
+   if ((status = Pro8_Write (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
+   //Ready
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
 // Function: Get Calibration Factor
 // Purpose:  This function returns the calibration factor of the photodiode
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_ItcGetCalibration (ViSession instrumentHandle, ViInt16 value, ViReal64 *calibrationfactor)
+ViStatus _VI_FUNC Pro8_LdcGetCalibration (ViSession instrumentHandle, ViInt16 value, ViReal64 *calibrationfactor)
 {
-   return Pro8_LdcGetCalibration (instrumentHandle, value, calibrationfactor);
+   ViStatus  status = VI_SUCCESS;
+   ViString  command[] = {":CALPD:MIN?", ":CALPD:MAX?", ":CALPD:SET?"};
+   ViBoolean answer;
+
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   if ((status = Pro8_GetAnswer (instrumentHandle, &answer)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Check input parameter ranges
+   if (Pro8_invalidViInt16Range (value, 0, 2)) return Pro8_Unlock (instrumentHandle, VI_ERROR_PARAMETER2);
+   //Shadow model or Writing - Poll STB - Check EAV Bit and read error - Reading
+   if ((status = Pro8_ShadowReal (instrumentHandle, command[value], answer, calibrationfactor)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Ready
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
 // Function: Set Laser Current
 // Purpose:  This function sets the current of the laserdiode
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_ItcSetLdCurrent (ViSession instrumentHandle, ViReal64 current)
+ViStatus _VI_FUNC Pro8_LdcSetLdCurrent (ViSession instrumentHandle, ViReal64 current)
 {
-   return Pro8_LdcSetLdCurrent (instrumentHandle, current);
+   ViStatus status = VI_SUCCESS;
+   ViUInt32 retCnt = 0;
+   ViUInt16 stb;
+   ViChar   buffer[CMD_BUF_SIZE];
+
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   //Formatting
+   Pro8_Fmt (buffer, ":ILD:SET %f", current);
+   //Writing - Poll STB - Check EAV Bit and read error
+   if ((status = Pro8_Write (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
+   //Ready
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
 // Function: Get Laser Current
 // Purpose:  This function returns the current of the laserdiode
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_ItcGetLdCurrent (ViSession instrumentHandle, ViInt16 value, ViReal64 *current)
+ViStatus _VI_FUNC Pro8_LdcGetLdCurrent (ViSession instrumentHandle, ViInt16 value, ViReal64 *current)
 {
-   return Pro8_LdcGetLdCurrent (instrumentHandle, value, current);
+   ViStatus  status = VI_SUCCESS;
+   ViString  command[] = {":ILD:MIN?", ":ILD:MAX?", ":ILD:SET?", ":ILD:ACT?"};
+   ViBoolean answer;
+
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   if ((status = Pro8_GetAnswer (instrumentHandle, &answer)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Check input parameter ranges
+   if (Pro8_invalidViInt16Range (value, 0, 3)) return Pro8_Unlock (instrumentHandle, VI_ERROR_PARAMETER2);
+   //Shadow model or Writing - Poll STB - Check EAV Bit and read error - Reading
+   if ((status = Pro8_ShadowReal (instrumentHandle, command[value], answer, current)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Ready
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
 // Function: Set Photodiode Current
 // Purpose:  This function sets the current of the photodiode
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_ItcSetPdCurrent (ViSession instrumentHandle, ViReal64 current)
+ViStatus _VI_FUNC Pro8_LdcSetPdCurrent (ViSession instrumentHandle, ViReal64 current)
 {
-   return Pro8_LdcSetPdCurrent (instrumentHandle, current);
+   ViStatus status = VI_SUCCESS;
+   ViUInt32 retCnt = 0;
+   ViUInt16 stb;
+   ViChar   buffer[CMD_BUF_SIZE];
+
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   //Formatting
+   Pro8_Fmt (buffer, ":IMD:SET %f", current);
+   //Writing - Poll STB - Check EAV Bit and read error
+   if ((status = Pro8_Write (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
+   //Ready
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
 // Function: Get Photodiode Current
 // Purpose:  This function returns the current of the photodiode
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_ItcGetPdCurrent (ViSession instrumentHandle, ViInt16 value, ViReal64 *current)
+ViStatus _VI_FUNC Pro8_LdcGetPdCurrent (ViSession instrumentHandle, ViInt16 value, ViReal64 *current)
 {
-   return Pro8_LdcGetPdCurrent (instrumentHandle, value, current);
+   ViStatus  status = VI_SUCCESS;
+   ViString  command[] = {":IMD:MIN?", ":IMD:MAX?", ":IMD:SET?", ":IMD:ACT?"};
+   ViBoolean answer;
+
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   if ((status = Pro8_GetAnswer (instrumentHandle, &answer)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Check input parameter ranges
+   if (Pro8_invalidViInt16Range (value, 0, 3)) return Pro8_Unlock (instrumentHandle, VI_ERROR_PARAMETER2);
+   //Shadow model or Writing - Poll STB - Check EAV Bit and read error - Reading
+   if ((status = Pro8_ShadowReal (instrumentHandle, command[value], answer, current)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Ready
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
 // Function: Set Optical Power
 // Purpose:  This function sets the optical power
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_ItcSetPower (ViSession instrumentHandle, ViReal64 opticalPower)
+ViStatus _VI_FUNC Pro8_LdcSetPower (ViSession instrumentHandle, ViReal64 opticalPower)
 {
-   return Pro8_LdcSetPower (instrumentHandle, opticalPower);
+   ViStatus status = VI_SUCCESS;
+   ViUInt32 retCnt = 0;
+   ViUInt16 stb;
+   ViChar   buffer[CMD_BUF_SIZE];
+
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   //Formatting
+   Pro8_Fmt (buffer, ":POPT:SET %f", opticalPower);
+   //Writing - Poll STB - Check EAV Bit and read error
+   if ((status = Pro8_Write (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
+   //Ready
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
 // Function: Get Optical Power
 // Purpose:  This function returns the optical power
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_ItcGetPower (ViSession instrumentHandle, ViInt16 value, ViReal64 *opticalPower)
-{
-   return Pro8_LdcGetPower (instrumentHandle, value, opticalPower);
-}
-
-//---------------------------------------------------------------------------
-// Function: Set Bias Voltage
-// Purpose:  This function sets the photo diode bias voltage
-//---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_ItcSetBiasVoltage (ViSession instrumentHandle, ViReal64 biasVoltage)
+ViStatus _VI_FUNC Pro8_LdcGetPower (ViSession instrumentHandle, ViInt16 value, ViReal64 *opticalPower)
 {
-   return Pro8_PdaSetBiasVoltage (instrumentHandle, biasVoltage);
-}
+   ViStatus  status = VI_SUCCESS;
+   ViString  command[] = {":POPT:MIN?", ":POPT:MAX?", ":POPT:SET?", ":POPT:ACT?"};
+   ViBoolean answer;
 
-//---------------------------------------------------------------------------
-// Function: Get Bias Voltage
-// Purpose:  This function returns the bias voltage
-//---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_ItcGetBiasVoltage (ViSession instrumentHandle, ViInt16 value, ViReal64 *biasVoltage)
-{
-   return Pro8_PdaGetBiasVoltage (instrumentHandle, value, biasVoltage);
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   if ((status = Pro8_GetAnswer (instrumentHandle, &answer)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Check input parameter ranges
+   if (Pro8_invalidViInt16Range (value, 0, 3)) return Pro8_Unlock (instrumentHandle, VI_ERROR_PARAMETER2);
+   //Shadow model or Writing - Poll STB - Check EAV Bit and read error - Reading
+   if ((status = Pro8_ShadowReal (instrumentHandle, command[value], answer, opticalPower)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Ready
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
 // Function: Set LD Limit Current
 // Purpose:  This function sets the limit current of the laser diode
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_ItcSetLdLimit (ViSession instrumentHandle, ViReal64 limitCurrent)
+ViStatus _VI_FUNC Pro8_LdcSetLdLimit (ViSession instrumentHandle, ViReal64 limitCurrent)
 {
-   return Pro8_LdcSetLdLimit (instrumentHandle, limitCurrent);
+   ViStatus status = VI_SUCCESS;
+   ViUInt32 retCnt = 0;
+   ViUInt16 stb;
+   ViChar   buffer[CMD_BUF_SIZE];
+
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   //Formatting
+   Pro8_Fmt (buffer, ":LIMC:SET %f", limitCurrent);
+   //Writing - Poll STB - Check EAV Bit and read error
+   if ((status = Pro8_Write (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
+   //Ready
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
 // Function: Get LD Limit Current
 // Purpose:  This function returns the limit current of the laser diode
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_ItcGetLdLimit (ViSession instrumentHandle, ViInt16 value, ViReal64 *limitCurrent)
+ViStatus _VI_FUNC Pro8_LdcGetLdLimit (ViSession instrumentHandle, ViInt16 value, ViReal64 *limitCurrent)
 {
-   return Pro8_LdcGetLdLimit (instrumentHandle, value, limitCurrent);
+   ViStatus  status    = VI_SUCCESS;
+   ViString  command[] = {":LIMC:MIN?", ":LIMC:MAX?", ":LIMC:SET?"};
+   ViBoolean answer;
+
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   if ((status = Pro8_GetAnswer (instrumentHandle, &answer)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Check input parameter ranges
+   if (Pro8_invalidViInt16Range (value, 0, 2)) return Pro8_Unlock (instrumentHandle, VI_ERROR_PARAMETER2);
+   //Shadow model or Writing - Poll STB - Check EAV Bit and read error - Reading
+   if ((status = Pro8_ShadowReal (instrumentHandle, command[value], answer, limitCurrent)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Ready
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get Laserdiode Limit Current (adjusted via poti)
-// Purpose:  This function returns limit current of the laserdiode
+// Function: Set PD Limit Current
+// Purpose:  This function sets the limit current of the photo diode
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_ItcGetLdLimitPoti (ViSession instrumentHandle, ViReal64 *limitCurrent)
+ViStatus _VI_FUNC Pro8_LdcSetPdLimit (ViSession instrumentHandle, ViReal64 limitCurrent)
 {
-   return Pro8_LdcGetLdLimitPoti (instrumentHandle, limitCurrent);
-}
-
-//---------------------------------------------------------------------------
-// Function: Get Laser Voltage
-// Purpose:  This function returns the voltage of the laserdiode
-//---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_ItcGetLdVoltage (ViSession instrumentHandle, ViReal64 *voltage)
-{
-   return Pro8_LdcGetLdVoltage (instrumentHandle, voltage);
+   ViStatus status = VI_SUCCESS;
+   ViUInt32 retCnt = 0;
+   ViUInt16 stb;
+   ViChar   buffer[CMD_BUF_SIZE];
+
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   //Formatting
+   Pro8_Fmt (buffer, ":LIMM:SET %f", limitCurrent);
+   //Writing - Poll STB - Check EAV Bit and read error
+   if ((status = Pro8_Write (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
+   //Ready
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
-// Function: Set Thermistor Calibration (exponential method)
-// Purpose:  This function sets the calibration values for the thermistor
+// Function: Get PD Limit Current
+// Purpose:  This function returns the limit current of the photo diode
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_ItcSetThCalExp (ViSession instrumentHandle, ViReal64 BValue, ViReal64 RValue, ViReal64 TValue)
+ViStatus _VI_FUNC Pro8_LdcGetPdLimit (ViSession instrumentHandle, ViInt16 value, ViReal64 *limitCurrent)
 {
-   return Pro8_TecSetThCalExp (instrumentHandle, BValue, RValue, TValue);
+   ViStatus status    = VI_SUCCESS;
+   ViString command[] = {":LIMM:MIN?", ":LIMM:MAX?", ":LIMM:SET?"};
+   ViBoolean answer;
+
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   if ((status = Pro8_GetAnswer (instrumentHandle, &answer)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Check input parameter ranges
+   if (Pro8_invalidViInt16Range (value, 0, 2)) return Pro8_Unlock (instrumentHandle, VI_ERROR_PARAMETER2);
+   //Shadow model or Writing - Poll STB - Check EAV Bit and read error - Reading
+   if ((status = Pro8_ShadowReal (instrumentHandle, command[value], answer, limitCurrent)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Ready
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get Thermistor Calibration (exponential method)
-// Purpose:  This function returns the calibration values for the thermistor
+// Function: Set Limit Power
+// Purpose:  This function sets the limit power
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_ItcGetThCalExp (ViSession instrumentHandle, ViInt16 values, ViReal64 *BValue, ViReal64 *RValue, ViReal64 *TValue)
+ViStatus _VI_FUNC Pro8_LdcSetPowerLimit (ViSession instrumentHandle, ViReal64 limitPower)
 {
-   return Pro8_TecGetThCalExp (instrumentHandle, values, BValue, RValue, TValue);
+   ViStatus status = VI_SUCCESS;
+   ViUInt32 retCnt = 0;
+   ViUInt16 stb;
+   ViChar   buffer[CMD_BUF_SIZE];
+
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   //Formatting
+   Pro8_Fmt (buffer, ":LIMP:SET %f", limitPower);
+   //Writing - Poll STB - Check EAV Bit and read error
+   if ((status = Pro8_Write (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
+   //Ready
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
-// Function: Set Thermistor Calibration (Steinhart-Hart method)
-// Purpose:  This function sets the calibration values for the thermistor
+// Function: Get Limit Power
+// Purpose:  This function returns the limit power
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_ItcSetThCalSH (ViSession instrumentHandle, ViReal64 c1Value, ViReal64 c2Value, ViReal64 c3Value)
+ViStatus _VI_FUNC Pro8_LdcGetPowerLimit (ViSession instrumentHandle, ViInt16 value, ViReal64 *limitPower)
 {
-   return Pro8_TecSetThCalSH (instrumentHandle, c1Value, c2Value, c3Value);
+   ViStatus  status = VI_SUCCESS;
+   ViString  command[] = {":LIMP:MIN?", ":LIMP:MAX?", ":LIMP:SET?"};
+   ViBoolean answer;
+
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   if ((status = Pro8_GetAnswer (instrumentHandle, &answer)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Check input parameter ranges
+   if (Pro8_invalidViInt16Range (value, 0, 2)) return Pro8_Unlock (instrumentHandle, VI_ERROR_PARAMETER2);
+   //Shadow model or Writing - Poll STB - Check EAV Bit and read error - Reading
+   if ((status = Pro8_ShadowReal (instrumentHandle, command[value], answer, limitPower)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Ready
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get Thermistor Calibration (Steinhart-Hart method)
-// Purpose:  This function returns the calibration values for the thermistor
+// Function: Get Laserdiode Limit Current (adjusted via poti)
+// Purpose:  This function returns limit current of the laserdiode
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_ItcGetThCalSH (ViSession instrumentHandle, ViInt16 values, ViReal64 *c1Value, ViReal64 *c2Value, ViReal64 *c3Value)
+ViStatus _VI_FUNC Pro8_LdcGetLdLimitPoti (ViSession instrumentHandle, ViReal64 *limitCurrent)
 {
-   return Pro8_TecGetThCalSH (instrumentHandle, values, c1Value, c2Value, c3Value);
+   ViStatus  status = VI_SUCCESS;
+   ViUInt32  retCnt = 0;
+   ViUInt16  stb;
+   ViBoolean answer;
+
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   if ((status = Pro8_GetAnswer (instrumentHandle, &answer)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Writing - Poll STB - Check EAV Bit and read error - Reading
+   if ((status = Pro8_Write (instrumentHandle, ":LIMCP:ACT?", 11, &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
+   if ((status = Pro8_ReadReal (instrumentHandle, answer, limitCurrent)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Ready
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
-// Function: Set Temperature
-// Purpose:  This function sets the temperature
+// Function: Get Laser Voltage
+// Purpose:  This function returns the voltage of the laserdiode
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_ItcSetTemp (ViSession instrumentHandle, ViReal64 temperature)
+ViStatus _VI_FUNC Pro8_LdcGetLdVoltage (ViSession instrumentHandle, ViReal64 *voltage)
 {
-   return Pro8_TecSetTemp (instrumentHandle, temperature);
+   ViStatus  status = VI_SUCCESS;
+   ViUInt32  retCnt = 0;
+   ViUInt16  stb;
+   ViBoolean answer;
+
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   if ((status = Pro8_GetAnswer (instrumentHandle, &answer)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Writing - Poll STB - Check EAV Bit and read error - Reading
+   if ((status = Pro8_Write (instrumentHandle, ":VLD:ACT?", 9, &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
+   if ((status = Pro8_ReadReal (instrumentHandle, answer, voltage)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Ready
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
+//===========================================================================
+// MLC MODULE FUNCTIONS
+//===========================================================================
 //---------------------------------------------------------------------------
-// Function: Get Temperature
-// Purpose:  This function returns the temperature
+// Function: Set Mode
+// Purpose:  This function sets the operation mode
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_ItcGetTemp (ViSession instrumentHandle, ViInt16 value, ViReal64 *temperature)
+ViStatus _VI_FUNC Pro8_MlcSetMode (ViSession instrumentHandle, ViInt16 mode)
 {
-   return Pro8_TecGetTemp (instrumentHandle, value, temperature);
+   return Pro8_LdcSetMode (instrumentHandle, mode);
 }
 
 //---------------------------------------------------------------------------
-// Function: Set Resistance
-// Purpose:  This function sets the resistance
+// Function: Get Mode
+// Purpose:  This function returns the operation mode
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_ItcSetRes (ViSession instrumentHandle, ViReal64 resistance)
+ViStatus _VI_FUNC Pro8_MlcGetMode (ViSession instrumentHandle, ViInt16 *mode)
 {
-   return Pro8_TecSetRes (instrumentHandle, resistance);
+   return Pro8_LdcGetMode (instrumentHandle, mode);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get Resistance
-// Purpose:  This function returns the resistance
+// Function: Set Range
+// Purpose:  This function sets the current range
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_ItcGetRes (ViSession instrumentHandle, ViInt16 value, ViReal64 *resistance)
+ViStatus _VI_FUNC Pro8_MlcSetRange (ViSession instrumentHandle, ViInt16 range)
 {
-   return Pro8_TecGetRes (instrumentHandle, value, resistance);
+   ViStatus status    = VI_SUCCESS;
+   ViUInt32 retCnt    = 0;
+   ViUInt16 stb;
+   ViString command[] = {":RANGE 0", ":RANGE 1"};
+
+   //Check input parameter ranges
+   if (Pro8_invalidViInt16Range (range, 0, 1)) return VI_ERROR_PARAMETER2;
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   //Writing - Poll STB - Check EAV Bit and read error
+   if ((status = Pro8_Write (instrumentHandle, command[range], StringLength (command[range]), &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
+   //Ready
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
-// Function: Set Temperature Window
-// Purpose:  This function sets the temperature window
+// Function: Get Range
+// Purpose:  This function returns the current rage
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_ItcSetTempWin (ViSession instrumentHandle, ViReal64 temperatureWindow)
+ViStatus _VI_FUNC Pro8_MlcGetRange (ViSession instrumentHandle, ViInt16 *range)
 {
-   return Pro8_TecSetTempWin (instrumentHandle, temperatureWindow);
+   ViStatus  status = VI_SUCCESS;
+   ViChar    buffer[CMD_BUF_SIZE];
+   ViBoolean answer;
+
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   if ((status = Pro8_GetAnswer (instrumentHandle, &answer)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Shadow model or Writing - Poll STB - Check EAV Bit and read error - Reading
+   if ((status = Pro8_ShadowQuery (instrumentHandle, ":RANGE?", answer, buffer, sizeof (buffer))) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Evaluate
+   if      (CompareStrings ("0", 0, buffer, 0, 0) == 0) *range = 0;
+   else if (CompareStrings ("1", 0, buffer, 0, 0) == 0) *range = 1;
+   else status = VI_ERROR_INSTR_INTERPRETING_RESPONSE;
+   //Ready
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get Temperature Window
-// Purpose:  This function returns the temperature window
+// Function: Set Temperature Protection Slot
+// Purpose:  This function sets the slot for temperature protection
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_ItcGetTempWin (ViSession instrumentHandle, ViInt16 value, ViReal64 *temperatureWindow)
+ViStatus _VI_FUNC Pro8_MlcSetTpSlot (ViSession instrumentHandle, ViInt16 slot)
 {
-   return Pro8_TecGetTempWin (instrumentHandle, value, temperatureWindow);
+   return Pro8_LdcSetTpSlot (instrumentHandle, slot);
 }
 
 //---------------------------------------------------------------------------
-// Function: Set Resistance Window
-// Purpose:  This function sets the resistance window
+// Function: Get Temperature Protection Slot
+// Purpose:  This function returns the slot used for temperature protection
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_ItcSetResWin (ViSession instrumentHandle, ViReal64 resistanceWindow)
+ViStatus _VI_FUNC Pro8_MlcGetTpSlot (ViSession instrumentHandle, ViInt16 *slot)
 {
-   return Pro8_TecSetResWin (instrumentHandle, resistanceWindow);
+   return Pro8_LdcGetTpSlot (instrumentHandle, slot);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get Resistance Window
-// Purpose:  This function returns the resistance window
+// Function: Set Temperature Protection
+// Purpose:  This function switches the temperature protection
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_ItcGetResWin (ViSession instrumentHandle, ViInt16 value, ViReal64 *resistanceWindow)
+ViStatus _VI_FUNC Pro8_MlcSetTempProt (ViSession instrumentHandle, ViInt16 tempProtection)
 {
-   return Pro8_TecGetResWin (instrumentHandle, value, resistanceWindow);
+   return Pro8_LdcSetTempProt (instrumentHandle, tempProtection);
 }
 
 //---------------------------------------------------------------------------
-// Function: Set PID Shares
-// Purpose:  This function sets the PID shares
+// Function: Get Temperature Protection
+// Purpose:  This function returns the state of the temperature protection
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_ItcSetPID (ViSession instrumentHandle, ViReal64 PShare, ViReal64 IShare, ViReal64 DShare)
+ViStatus _VI_FUNC Pro8_MlcGetTempProt (ViSession instrumentHandle, ViInt16 *temperatureProtection)
 {
-   return Pro8_TecSetPID (instrumentHandle, PShare, IShare, DShare);
+   return Pro8_LdcGetTempProt (instrumentHandle, temperatureProtection);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get PID Shares
-// Purpose:  This function returns the PID shares
+// Function: Set Laser Output
+// Purpose:  This function switches the output on or off
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_ItcGetPID (ViSession instrumentHandle, ViInt16 values, ViReal64 *PShare, ViReal64 *IShare, ViReal64 *DShare)
+ViStatus _VI_FUNC Pro8_MlcSetLdOutput (ViSession instrumentHandle, ViInt16 output)
 {
-   return Pro8_TecGetPID (instrumentHandle, values, PShare, IShare, DShare);
+   return Pro8_LdcSetLdOutput (instrumentHandle, output);
 }
 
 //---------------------------------------------------------------------------
-// Function: Set Peltier Limit Current
-// Purpose:  This function sets the limit current of the peltier
+// Function: Get Laser Output
+// Purpose:  This function returns the state of the output
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_ItcSetPtLimit (ViSession instrumentHandle, ViReal64 limitCurrent)
+ViStatus _VI_FUNC Pro8_MlcGetLdOutput (ViSession instrumentHandle, ViInt16 *output)
 {
-   return Pro8_TecSetPtLimit (instrumentHandle, limitCurrent);
+   return Pro8_LdcGetLdOutput (instrumentHandle, output);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get Peltier Limit Current
-// Purpose:  This function returns the limit current of the peltier
+// Function: Set Laser Current
+// Purpose:  This function sets the current of the laserdiode
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_ItcGetPtLimit (ViSession instrumentHandle, ViInt16 value, ViReal64 *limitCurrent)
+ViStatus _VI_FUNC Pro8_MlcSetLdCurrent (ViSession instrumentHandle, ViReal64 current)
 {
-   return Pro8_TecGetPtLimit (instrumentHandle, value, limitCurrent);
+   return Pro8_LdcSetLdCurrent (instrumentHandle, current);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get Peltier Current
-// Purpose:  This function returns the current of the peltier
+// Function: Get Laser Current
+// Purpose:  This function returns the current of the laserdiode
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_ItcGetPtCurrent (ViSession instrumentHandle, ViReal64 *current)
+ViStatus _VI_FUNC Pro8_MlcGetLdCurrent (ViSession instrumentHandle, ViInt16 value, ViReal64 *current)
 {
-   return Pro8_TecGetPtCurrent (instrumentHandle, current);
+   return Pro8_LdcGetLdCurrent (instrumentHandle, value, current);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get Peltier Voltage
-// Purpose:  This function returns the voltage of the peltier
+// Function: Set Photodiode Current
+// Purpose:  This function sets the current of the photodiode
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_ItcGetPtVoltage (ViSession instrumentHandle, ViReal64 *voltage)
+ViStatus _VI_FUNC Pro8_MlcSetPdCurrent (ViSession instrumentHandle, ViReal64 current)
 {
-   return Pro8_TecGetPtVoltage (instrumentHandle, voltage);
+   return Pro8_LdcSetPdCurrent (instrumentHandle, current);
 }
 
-//===========================================================================
-// PDA MODULE FUNCTIONS
-//===========================================================================
 //---------------------------------------------------------------------------
-// Function: Set Photodiode Polarity
-// Purpose:  This function sets the photodiode polarity
+// Function: Get Photodiode Current
+// Purpose:  This function returns the current of the photodiode
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_PdaSetPdPol (ViSession instrumentHandle, ViInt16 polarity)
+ViStatus _VI_FUNC Pro8_MlcGetPdCurrent (ViSession instrumentHandle, ViInt16 value, ViReal64 *current)
 {
-   return Pro8_LdcSetPdPol (instrumentHandle, polarity);
+   return Pro8_LdcGetPdCurrent (instrumentHandle, value, current);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get Photodiode Polarity
-// Purpose:  This function returns the photodiode polarity
+// Function: Get Laserdiode Limit Current (adjusted via poti)
+// Purpose:  This function returns limit current of the laserdiode
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_PdaGetPdPol (ViSession instrumentHandle, ViInt16 *polarity)
+ViStatus _VI_FUNC Pro8_MlcGetLdLimitPoti (ViSession instrumentHandle, ViReal64 *limitCurrent)
 {
-   return Pro8_LdcGetPdPol (instrumentHandle, polarity);
+   return Pro8_LdcGetLdLimitPoti (instrumentHandle, limitCurrent);
 }
 
+//===========================================================================
+// TEC MODULE FUNCTIONS
+//===========================================================================
 //---------------------------------------------------------------------------
-// Function: Set Photodiode Bias
-// Purpose:  This function switches the photodiode bias
+// Function: Set Sensor
+// Purpose:  This function sets the temperature sensor
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_PdaSetBias (ViSession instrumentHandle, ViInt16 bias)
+ViStatus _VI_FUNC Pro8_TecSetSensor (ViSession instrumentHandle, ViInt16 sensor)
 {
-   return Pro8_LdcSetBias (instrumentHandle, bias);
+   ViStatus status    = VI_SUCCESS;
+   ViUInt32 retCnt    = 0;
+   ViUInt16 stb;
+   ViString command[] = {":SENS AD", ":SENS THL", ":SENS THH", ":SENS PT100", ":SENS PT1000L", ":SENS PT1000H"};
+
+   //Check input parameter ranges
+   if (Pro8_invalidViInt16Range (sensor, 0, 5)) return VI_ERROR_PARAMETER2;
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   //Writing - Poll STB - Check EAV Bit and read error
+   if ((status = Pro8_Write (instrumentHandle, command[sensor], StringLength (command[sensor]), &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
+   //Ready
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get Photodiode Bias
-// Purpose:  This function returns the state of the photodiode bias
+// Function: Get Sensor
+// Purpose:  This function returns the temperature sensor
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_PdaGetBias (ViSession instrumentHandle, ViInt16 *bias)
+ViStatus _VI_FUNC Pro8_TecGetSensor (ViSession instrumentHandle, ViInt16 *sensor)
 {
-   return Pro8_LdcGetBias (instrumentHandle, bias);
-}
+   ViStatus  status = VI_SUCCESS;
+   ViChar    buffer[CMD_BUF_SIZE];
+   ViBoolean answer;
+
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   if ((status = Pro8_GetAnswer (instrumentHandle, &answer)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Shadow model or Writing - Poll STB - Check EAV Bit and read error - Reading
+   if ((status = Pro8_ShadowQuery (instrumentHandle, ":SENS?", answer, buffer, sizeof (buffer))) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Evaluate
+   if      (CompareStrings ("AD",      0, buffer, 0, 0) == 0) *sensor = 0;
+   else if (CompareStrings ("THL",     0, buffer, 0, 0) == 0) *sensor = 1;
+   else if (CompareStrings ("THH",     0, buffer, 0, 0) == 0) *sensor = 2;
+   else if (CompareStrings ("PT100",   0, buffer, 0, 0) == 0) *sensor = 3;
+   else if (CompareStrings ("PT1000L", 0, buffer, 0, 0) == 0) *sensor = 4;
+   else if (CompareStrings ("PT1000H", 0, buffer, 0, 0) == 0) *sensor = 5;
+   else status = VI_ERROR_INSTR_INTERPRETING_RESPONSE;
+   //Ready
+   return Pro8_Unlock (instrumentHandle, status);
+}
 
 //---------------------------------------------------------------------------
-// Function: Set Range
-// Purpose:  This function sets the current range
-//---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_PdaSetRange (ViSession instrumentHandle, ViInt16 range)
+// Function: Set I-Share
+// Purpose:  This function switches the I-share on and off
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_TecSetIShare (ViSession instrumentHandle, ViInt16 IShare)
 {
-   ViStatus status = VI_SUCCESS;
-   ViUInt32 retCnt = 0;
+   ViStatus status    = VI_SUCCESS;
+   ViUInt32 retCnt    = 0;
    ViUInt16 stb;
-   ViChar   buffer[CMD_BUF_SIZE];
+   ViString command[] = {":INTEG OFF", ":INTEG ON"};
 
    //Check input parameter ranges
-   if (Pro8_invalidViInt16Range (range, 1, 7)) return VI_ERROR_PARAMETER2;
-   //Formatting
-   Fmt (buffer, ":RANGE %d", range);
+   if (Pro8_invalidViInt16Range (IShare, 0, 1)) return VI_ERROR_PARAMETER2;
+   //Lock session
+   Pro8_Lock (instrumentHandle);
    //Writing - Poll STB - Check EAV Bit and read error
-   if ((status = viWrite (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
+   if ((status = Pro8_Write (instrumentHandle, command[IShare], StringLength (command[IShare]), &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
    //Ready
-   return status;
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get Range
-// Purpose:  This function returns the current rage
+// Function: Get I_Share
+// Purpose:  This function returns the state of the I-share
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_PdaGetRange (ViSession instrumentHandle, ViInt16 *range)
+ViStatus _VI_FUNC Pro8_TecGetIShare (ViSession instrumentHandle, ViInt16 *IShare)
 {
    ViStatus  status = VI_SUCCESS;
-   ViUInt32  retCnt = 0;
-   ViUInt16  stb;
+   ViChar    buffer[CMD_BUF_SIZE];
    ViBoolean answer;
-   ViString  format[] = {"%*s %d", "%d"};
 
-   if ((status = viGetAttribute (instrumentHandle, VI_ATTR_USER_DATA, &answer)) < 0) return status;
-   //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, ":RANGE?", 7, &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format[answer], range)) < 0) return status;
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   if ((status = Pro8_GetAnswer (instrumentHandle, &answer)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Shadow model or Writing - Poll STB - Check EAV Bit and read error - Reading
+   if ((status = Pro8_ShadowQuery (instrumentHandle, ":INTEG?", answer, buffer, sizeof (buffer))) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Evaluate
+   if      (CompareStrings ("OFF", 0, buffer, 0, 0) == 0) *IShare = 0;
+   else if (CompareStrings ("ON",  0, buffer, 0, 0) == 0) *IShare = 1;
+   else status = VI_ERROR_INSTR_INTERPRETING_RESPONSE;
    //Ready
-   return status;
-}
-
-//---------------------------------------------------------------------------
-// Function: Set Calibration Factor
-// Purpose:  This function sets the calibration factor of the photodiode
-//---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_PdaSetCalibration (ViSession instrumentHandle, ViReal64 calibrationFactor)
-{
-   return Pro8_LdcSetCalibration (instrumentHandle, calibrationFactor);
-}
-
-//---------------------------------------------------------------------------
-// Function: Get Calibration Factor
-// Purpose:  This function returns the calibration factor of the photodiode
-//---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_PdaGetCalibration (ViSession instrumentHandle, ViInt16 value, ViReal64 *calibrationfactor)
-{
-   return Pro8_LdcGetCalibration (instrumentHandle, value, calibrationfactor);
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get Photodiode Current
-// Purpose:  This function returns the current of the photodiode
+// Function: Set Peltier Output
+// Purpose:  This function switches the output on or off
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_PdaGetPdCurrent (ViSession instrumentHandle, ViReal64 *current)
+ViStatus _VI_FUNC Pro8_TecSetPtOutput (ViSession instrumentHandle, ViInt16 output)
 {
-   ViStatus  status    = VI_SUCCESS;
-   ViUInt32  retCnt    = 0;
-   ViUInt16  stb;
-   ViBoolean answer;
-   ViString  format[] = {"%*s %LE", "%LE"};
+   ViStatus status    = VI_SUCCESS;
+   ViUInt32 retCnt    = 0;
+   ViUInt16 stb;
+   ViString command[] = {":TEC OFF", ":TEC ON"};
 
-   if ((status = viGetAttribute (instrumentHandle, VI_ATTR_USER_DATA, &answer)) < 0) return status;
-   //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, ":IPD:ACT?", 9, &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format[answer], current)) < 0) return status;
+   //Check input parameter ranges
+   if (Pro8_invalidViInt16Range (output, 0, 1)) return VI_ERROR_PARAMETER2;
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   //Writing - Poll STB - Check EAV Bit and read error
+   if ((status = Pro8_Write (instrumentHandle, command[output], StringLength (command[output]), &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
    //Ready
-   return status;
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get Optical Power
-// Purpose:  This function returns the optical power
+// Function: Get Peltier Output
+// Purpose:  This function returns the state of the output
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_PdaGetPower (ViSession instrumentHandle, ViReal64 *opticalPower)
+ViStatus _VI_FUNC Pro8_TecGetPtOutput (ViSession instrumentHandle, ViInt16 *output)
 {
-   ViStatus  status    = VI_SUCCESS;
-   ViUInt32  retCnt    = 0;
-   ViUInt16  stb;
+   ViStatus status = VI_SUCCESS;
+   ViUInt32 retCnt = 0;
+   ViUInt16 stb;
+   ViChar   buffer[CMD_BUF_SIZE];
    ViBoolean answer;
-   ViString  format[] = {"%*s %LE", "%LE"};
+   ViString  format[] = {"%*s %s", "%s"};
 
-   if ((status = viGetAttribute (instrumentHandle, VI_ATTR_USER_DATA, &answer)) < 0) return status;
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   if ((status = Pro8_GetAnswer (instrumentHandle, &answer)) < 0) return Pro8_Unlock (instrumentHandle, status);
    //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, ":POPT:ACT?", 10, &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format[answer], opticalPower)) < 0) return status;
+   if ((status = Pro8_Write (instrumentHandle, ":TEC?", 5, &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
+   if ((status = Pro8_Scanf (instrumentHandle, format[answer], buffer)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Evaluate
+   if      (CompareStrings ("OFF", 0, buffer, 0, 0) == 0) *output = 0;
+   else if (CompareStrings ("ON",  0, buffer, 0, 0) == 0) *output = 1;
+   else status = VI_ERROR_INSTR_INTERPRETING_RESPONSE;
    //Ready
-   return status;
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
-// Function: Set Bias Voltage
-// Purpose:  This function sets the photo diode bias voltage
+// Function: Set Thermistor Calibration (exponential method)
+// Purpose:  This function sets the calibration values for the thermistor
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_PdaSetBiasVoltage (ViSession instrumentHandle, ViReal64 biasVoltage)
+ViStatus _VI_FUNC Pro8_TecSetThCalExp (ViSession instrumentHandle, ViReal64 BValue, ViReal64 RValue, ViReal64 TValue)
 {
    ViStatus status = VI_SUCCESS;
    ViUInt32 retCnt = 0;
    ViUInt16 stb;
    ViChar   buffer[CMD_BUF_SIZE];
 
+   //Lock session
+   Pro8_Lock (instrumentHandle);
    //Formatting
-   Fmt (buffer, ":VBIAS:SET %f", biasVoltage);
+   Pro8_Fmt (buffer, ":CALTB:SET %f;:CALTR:SET %f;:CALTT:SET %f", BValue, RValue, TValue);
    //Writing - Poll STB - Check EAV Bit and read error
-   if ((status = viWrite (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
+   if ((status = Pro8_Write (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
    //Ready
-   return status;
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get Bias Voltage
-// Purpose:  This function returns the bias voltage
+// Function: Get Thermistor Calibration (exponential method)
+// Purpose:  This function returns the calibration values for the thermistor
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_PdaGetBiasVoltage (ViSession instrumentHandle, ViInt16 value, ViReal64 *biasVoltage)
+ViStatus _VI_FUNC Pro8_TecGetThCalExp (ViSession instrumentHandle, ViInt16 values, ViReal64 *BValue, ViReal64 *RValue, ViReal64 *TValue)
 {
-   ViStatus  status = VI_SUCCESS;
-   ViUInt32  retCnt = 0;
-   ViUInt16  stb;
-   ViString  command[] = {":VBIAS:MIN?", ":VBIAS:MAX?", ":VBIAS:SET?"};
+   ViStatus  status     = VI_SUCCESS;
+   ViString  command1[] = {":CALTB:MIN?", ":CALTB:MAX?", ":CALTB:SET?"};
+   ViString  command2[] = {":CALTR:MIN?", ":CALTR:MAX?", ":CALTR:SET?"};
+   ViString  command3[] = {":CALTT:MIN?", ":CALTT:MAX?", ":CALTT:SET?"};
+   ViString  queries[3], answers[3];
+   ViChar    response[RESPONSE_BUF_SIZE];
    ViBoolean answer;
-   ViString  format[] = {"%*s %LE", "%LE"};
 
-   if ((status = viGetAttribute (instrumentHandle, VI_ATTR_USER_DATA, &answer)) < 0) return status;
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   if ((status = Pro8_GetAnswer (instrumentHandle, &answer)) < 0) return Pro8_Unlock (instrumentHandle, status);
    //Check input parameter ranges
-   if (Pro8_invalidViInt16Range (value, 0, 3)) return VI_ERROR_PARAMETER2;
+   if (Pro8_invalidViInt16Range (values, 0, 2)) return Pro8_Unlock (instrumentHandle, VI_ERROR_PARAMETER2);
    //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, command[value], StringLength (command[value]), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format[answer], biasVoltage)) < 0) return status;
+   queries[0] = command1[values];
+   queries[1] = command2[values];
+   queries[2] = command3[values];
+   if ((status = Pro8_CompoundQuery (instrumentHandle, 3, queries, response, sizeof (response), answers)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_ParseReal (answers[0], answer, BValue)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_ParseReal (answers[1], answer, RValue)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_ParseReal (answers[2], answer, TValue)) < 0) return Pro8_Unlock (instrumentHandle, status);
    //Ready
-   return status;
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
-// Function: Set Forward Current
-// Purpose:  This function sets the photo diode forward current
+// Function: Set Thermistor Calibration (Steinhart-Hart method)
+// Purpose:  This function sets the calibration values for the thermistor
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_PdaSetFwdCurr (ViSession instrumentHandle, ViReal64 forwardCurrent)
+ViStatus _VI_FUNC Pro8_TecSetThCalSH (ViSession instrumentHandle, ViReal64 c1Value, ViReal64 c2Value, ViReal64 c3Value)
 {
    ViStatus status = VI_SUCCESS;
    ViUInt32 retCnt = 0;
    ViUInt16 stb;
    ViChar   buffer[CMD_BUF_SIZE];
 
+   //Lock session
+   Pro8_Lock (instrumentHandle);
    //Formatting
-   Fmt (buffer, ":IFWD:SET %f", forwardCurrent);
+   Pro8_Fmt (buffer, ":CALTC1:SET %f;:CALTC2:SET %f;:CALTC3:SET %f", c1Value, c2Value, c3Value);
    //Writing - Poll STB - Check EAV Bit and read error
-   if ((status = viWrite (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
+   if ((status = Pro8_Write (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
    //Ready
-   return status;
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get Forward Current
-// Purpose:  This function returns the photo diode forward current
+// Function: Get Thermistor Calibration (Steinhart-Hart method)
+// Purpose:  This function returns the calibration values for the thermistor
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_PdaGetFwdCurr (ViSession instrumentHandle, ViInt16 value, ViReal64 *forwardCurrent)
+ViStatus _VI_FUNC Pro8_TecGetThCalSH (ViSession instrumentHandle, ViInt16 values, ViReal64 *c1Value, ViReal64 *c2Value, ViReal64 *c3Value)
 {
-   ViStatus  status = VI_SUCCESS;
-   ViUInt32  retCnt = 0;
-   ViUInt16  stb;
-   ViString  command[] = {":IFWD:MIN?", ":IFWD:MAX?", ":IFWD:SET?"};
+   ViStatus  status     = VI_SUCCESS;
+   ViString  command1[] = {":CALTC1:MIN?", ":CALTC1:MAX?", ":CALTC1:SET?"};
+   ViString  command2[] = {":CALTC2:MIN?", ":CALTC2:MAX?", ":CALTC2:SET?"};
+   ViString  command3[] = {":CALTC3:MIN?", ":CALTC3:MAX?", ":CALTC3:SET?"};
+   ViString  queries[3], answers[3];
+   ViChar    response[RESPONSE_BUF_SIZE];
    ViBoolean answer;
-   ViString  format[] = {"%*s %LE", "%LE"};
 
-   if ((status = viGetAttribute (instrumentHandle, VI_ATTR_USER_DATA, &answer)) < 0) return status;
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   if ((status = Pro8_GetAnswer (instrumentHandle, &answer)) < 0) return Pro8_Unlock (instrumentHandle, status);
    //Check input parameter ranges
-   if (Pro8_invalidViInt16Range (value, 0, 3)) return VI_ERROR_PARAMETER2;
+   if (Pro8_invalidViInt16Range (values, 0, 2)) return Pro8_Unlock (instrumentHandle, VI_ERROR_PARAMETER2);
    //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, command[value], StringLength (command[value]), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format[answer], forwardCurrent)) < 0) return status;
+   queries[0] = command1[values];
+   queries[1] = command2[values];
+   queries[2] = command3[values];
+   if ((status = Pro8_CompoundQuery (instrumentHandle, 3, queries, response, sizeof (response), answers)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_ParseReal (answers[0], answer, c1Value)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_ParseReal (answers[1], answer, c2Value)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_ParseReal (answers[2], answer, c3Value)) < 0) return Pro8_Unlock (instrumentHandle, status);
    //Ready
-   return status;
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get Forward Voltage
-// Purpose:  This function returns the photo diode forward voltage
+// Function: Set Temperature
+// Purpose:  This function sets the temperature
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_PdaGetFwdVoltage (ViSession instrumentHandle, ViReal64 *forwardVoltage)
+ViStatus _VI_FUNC Pro8_TecSetTemp (ViSession instrumentHandle, ViReal64 temperature)
 {
-   ViStatus status    = VI_SUCCESS;
-   ViUInt32 retCnt    = 0;
+   ViStatus status = VI_SUCCESS;
+   ViUInt32 retCnt = 0;
    ViUInt16 stb;
-   ViBoolean answer;
-   ViString  format[] = {"%*s %LE", "%LE"};
+   ViChar   buffer[CMD_BUF_SIZE];
 
-   if ((status = viGetAttribute (instrumentHandle, VI_ATTR_USER_DATA, &answer)) < 0) return status;
-   //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, ":VFWD:ACT?", 10, &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format[answer], forwardVoltage)) < 0) return status;
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   //Formatting
+   Pro8_Fmt (buffer, ":TEMP:SET %f", temperature);
+   //Writing - Poll STB - Check EAV Bit and read error
+   if ((status = Pro8_Write (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
    //Ready
-   return status;
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
-//===========================================================================
-// LS MODULE FUNCTIONS
-//===========================================================================
 //---------------------------------------------------------------------------
-// Function: Set Laser Output
-// Purpose:  This function switches the output on or off
+// Function: Get Temperature
+// Purpose:  This function returns the temperature
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_LsSetOutput (ViSession instrumentHandle, ViInt16 output)
+ViStatus _VI_FUNC Pro8_TecGetTemp (ViSession instrumentHandle, ViInt16 value, ViReal64 *temperature)
 {
-   return Pro8_LdcSetLdOutput (instrumentHandle, output);
-}
+   ViStatus  status    = VI_SUCCESS;
+   ViString  command[] = {":TEMP:MIN?", ":TEMP:MAX?", ":TEMP:SET?", ":TEMP:ACT?"};
+   ViBoolean answer;
 
-//---------------------------------------------------------------------------
-// Function: Get Laser Output
-// Purpose:  This function returns the state of the output
-//---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_LsGetOutput (ViSession instrumentHandle, ViInt16 *output)
-{
-   return Pro8_LdcGetLdOutput (instrumentHandle, output);
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   if ((status = Pro8_GetAnswer (instrumentHandle, &answer)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Check input parameter ranges
+   if (Pro8_invalidViInt16Range (value, 0, 3)) return Pro8_Unlock (instrumentHandle, VI_ERROR_PARAMETER2);
+   //Shadow model or Writing - Poll STB - Check EAV Bit and read error - Reading
+   if ((status = Pro8_ShadowReal (instrumentHandle, command[value], answer, temperature)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Ready
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
-// Function: Set Laser Power
-// Purpose:  This function sets the laser power (dBm)
+// Function: Set Resistance
+// Purpose:  This function sets the resistance
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_LsSetPowerdBm (ViSession instrumentHandle, ViReal64 power)
+ViStatus _VI_FUNC Pro8_TecSetRes (ViSession instrumentHandle, ViReal64 resistance)
 {
    ViStatus status = VI_SUCCESS;
    ViUInt32 retCnt = 0;
    ViUInt16 stb;
    ViChar   buffer[CMD_BUF_SIZE];
 
+   //Lock session
+   Pro8_Lock (instrumentHandle);
    //Formatting
-   Fmt (buffer, ":P_DBM:SET %f", power);
+   Pro8_Fmt (buffer, ":RESI:SET %f", resistance);
    //Writing - Poll STB - Check EAV Bit and read error
-   if ((status = viWrite (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
+   if ((status = Pro8_Write (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
    //Ready
-   return status;
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get Laser Power
-// Purpose:  This function returns the laser power (dBm)
+// Function: Get Resistance
+// Purpose:  This function returns the resistance
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_LsGetPowerdBm (ViSession instrumentHandle, ViInt16 value, ViReal64 *power)
+ViStatus _VI_FUNC Pro8_TecGetRes (ViSession instrumentHandle, ViInt16 value, ViReal64 *resistance)
 {
    ViStatus  status = VI_SUCCESS;
-   ViUInt32  retCnt = 0;
-   ViUInt16  stb;
-   ViString  command[] = {":P_DBM:MIN?", ":P_DBM:MAX?", ":P_DBM:SET?"};
+   ViString  command[] = {":RESI:MIN?", ":RESI:MAX?", ":RESI:SET?", ":RESI:ACT?"};
    ViBoolean answer;
-   ViString  format[] = {"%*s %LE", "%LE"};
 
-   if ((status = viGetAttribute (instrumentHandle, VI_ATTR_USER_DATA, &answer)) < 0) return status;
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   if ((status = Pro8_GetAnswer (instrumentHandle, &answer)) < 0) return Pro8_Unlock (instrumentHandle, status);
    //Check input parameter ranges
-   if (Pro8_invalidViInt16Range (value, 0, 2)) return VI_ERROR_PARAMETER2;
-   //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, command[value], StringLength (command[value]), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format[answer], power)) < 0) return status;
+   if (Pro8_invalidViInt16Range (value, 0, 3)) return Pro8_Unlock (instrumentHandle, VI_ERROR_PARAMETER2);
+   //Shadow model or Writing - Poll STB - Check EAV Bit and read error - Reading
+   if ((status = Pro8_ShadowReal (instrumentHandle, command[value], answer, resistance)) < 0) return Pro8_Unlock (instrumentHandle, status);
    //Ready
-   return status;
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
-// Function: Set Laser Power
-// Purpose:  This function sets the laser power (W)
+// Function: Set Temperature Window
+// Purpose:  This function sets the temperature window
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_LsSetPowerW (ViSession instrumentHandle, ViReal64 power)
+ViStatus _VI_FUNC Pro8_TecSetTempWin (ViSession instrumentHandle, ViReal64 temperatureWindow)
 {
    ViStatus status = VI_SUCCESS;
    ViUInt32 retCnt = 0;
    ViUInt16 stb;
    ViChar   buffer[CMD_BUF_SIZE];
 
+   //Lock session
+   Pro8_Lock (instrumentHandle);
    //Formatting
-   Fmt (buffer, ":P_W:SET %f", power);
+   Pro8_Fmt (buffer, ":TWIN:SET %f", temperatureWindow);
    //Writing - Poll STB - Check EAV Bit and read error
-   if ((status = viWrite (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
+   if ((status = Pro8_Write (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
    //Ready
-   return status;
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get Laser Power
-// Purpose:  This function returns the laser power (W)
+// Function: Get Temperature Window
+// Purpose:  This function returns the temperature window
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_LsGetPowerW (ViSession instrumentHandle, ViInt16 value, ViReal64 *power)
+ViStatus _VI_FUNC Pro8_TecGetTempWin (ViSession instrumentHandle, ViInt16 value, ViReal64 *temperatureWindow)
 {
    ViStatus  status = VI_SUCCESS;
-   ViUInt32  retCnt = 0;
-   ViUInt16  stb;
-   ViString  command[] = {":P_W:MIN?", ":P_W:MAX?", ":P_W:SET?"};
+   ViString  command[] = {":TWIN:MIN?", ":TWIN:MAX?", ":TWIN:SET?"};
    ViBoolean answer;
-   ViString  format[] = {"%*s %LE", "%LE"};
 
-   if ((status = viGetAttribute (instrumentHandle, VI_ATTR_USER_DATA, &answer)) < 0) return status;
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   if ((status = Pro8_GetAnswer (instrumentHandle, &answer)) < 0) return Pro8_Unlock (instrumentHandle, status);
    //Check input parameter ranges
-   if (Pro8_invalidViInt16Range (value, 0, 2)) return VI_ERROR_PARAMETER2;
-   //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, command[value], StringLength (command[value]), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format[answer], power)) < 0) return status;
+   if (Pro8_invalidViInt16Range (value, 0, 2)) return Pro8_Unlock (instrumentHandle, VI_ERROR_PARAMETER2);
+   //Shadow model or Writing - Poll STB - Check EAV Bit and read error - Reading
+   if ((status = Pro8_ShadowReal (instrumentHandle, command[value], answer, temperatureWindow)) < 0) return Pro8_Unlock (instrumentHandle, status);
    //Ready
-   return status;
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
-// Function: Set Temperature Difference
-// Purpose:  This function sets the temperature difference
+// Function: Set Resistance Window
+// Purpose:  This function sets the resistance window
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_LsSetTempDiff (ViSession instrumentHandle, ViReal64 temperatureDifference)
+ViStatus _VI_FUNC Pro8_TecSetResWin (ViSession instrumentHandle, ViReal64 resistanceWindow)
 {
    ViStatus status = VI_SUCCESS;
    ViUInt32 retCnt = 0;
    ViUInt16 stb;
    ViChar   buffer[CMD_BUF_SIZE];
 
+   //Lock session
+   Pro8_Lock (instrumentHandle);
    //Formatting
-   Fmt (buffer, ":DTEMP:SET %f", temperatureDifference);
+   Pro8_Fmt (buffer, ":RWIN:SET %f", resistanceWindow);
    //Writing - Poll STB - Check EAV Bit and read error
-   if ((status = viWrite (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
+   if ((status = Pro8_Write (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
    //Ready
-   return status;
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get Temperature Difference
-// Purpose:  This function returns the temperature difference
+// Function: Get Resistance Window
+// Purpose:  This function returns the resistance window
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_LsGetTempDifference (ViSession instrumentHandle, ViInt16 value, ViReal64 *temperatureDifference)
+ViStatus _VI_FUNC Pro8_TecGetResWin (ViSession instrumentHandle, ViInt16 value, ViReal64 *resistanceWindow)
 {
-   ViStatus  status    = VI_SUCCESS;
-   ViUInt32  retCnt    = 0;
-   ViUInt16  stb;
-   ViString  command[] = {":DTEMP:MIN?", ":DTEMP:MAX?", ":DTEMP:SET?"};
+   ViStatus  status = VI_SUCCESS;
+   ViString  command[] = {":RWIN:MIN?", ":RWIN:MAX?", ":RWIN:SET?"};
    ViBoolean answer;
-   ViString  format[] = {"%*s %LE", "%LE"};
 
-   if ((status = viGetAttribute (instrumentHandle, VI_ATTR_USER_DATA, &answer)) < 0) return status;
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   if ((status = Pro8_GetAnswer (instrumentHandle, &answer)) < 0) return Pro8_Unlock (instrumentHandle, status);
    //Check input parameter ranges
-   if (Pro8_invalidViInt16Range (value, 0, 2)) return VI_ERROR_PARAMETER2;
-   //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, command[value], StringLength (command[value]), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format[answer], temperatureDifference)) < 0) return status;
+   if (Pro8_invalidViInt16Range (value, 0, 2)) return Pro8_Unlock (instrumentHandle, VI_ERROR_PARAMETER2);
+   //Shadow model or Writing - Poll STB - Check EAV Bit and read error - Reading
+   if ((status = Pro8_ShadowReal (instrumentHandle, command[value], answer, resistanceWindow)) < 0) return Pro8_Unlock (instrumentHandle, status);
    //Ready
-   return status;
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
-// Function: Set Synchronous Modulation
-// Purpose:  This function switches the sync. modulation on and off
+// Function: Set PID Shares
+// Purpose:  This function sets the PID shares
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_LsSetSyncMod (ViSession instrumentHandle, ViInt16 synchronousModulation)
+ViStatus _VI_FUNC Pro8_TecSetPID (ViSession instrumentHandle, ViReal64 PShare, ViReal64 IShare, ViReal64 DShare)
 {
-   ViStatus status    = VI_SUCCESS;
-   ViUInt32 retCnt    = 0;
+   ViStatus status = VI_SUCCESS;
+   ViUInt32 retCnt = 0;
    ViUInt16 stb;
-   ViString command[] = {":SYNCMOD OFF", ":SYNCMOD ON"};
+   ViChar   buffer[CMD_BUF_SIZE];
 
-   //Check input parameter ranges
-   if (Pro8_invalidViInt16Range (synchronousModulation, 0, 1)) return VI_ERROR_PARAMETER2;
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   //Formatting
+   Pro8_Fmt (buffer, ":SHAREP:SET %f;:SHAREI:SET %f;:SHARED:SET %f", PShare, IShare, DShare);
    //Writing - Poll STB - Check EAV Bit and read error
-   if ((status = viWrite (instrumentHandle, command[synchronousModulation], StringLength (command[synchronousModulation]), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
+   if ((status = Pro8_Write (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
    //Ready
-   return status;
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get Synchronous Modulation
-// Purpose:  This function retuns the state of the sync. modulation
+// Function: Get PID Shares
+// Purpose:  This function returns the PID shares. In shadow mode the set
+//           shares are taken from the shadow model if all three are in it,
+//           otherwise they are read at once and stored.
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_LsGetSyncMod (ViSession instrumentHandle, ViInt16 *synchronousModulation)
+ViStatus _VI_FUNC Pro8_TecGetPID (ViSession instrumentHandle, ViInt16 values, ViReal64 *PShare, ViReal64 *IShare, ViReal64 *DShare)
 {
-   ViStatus  status = VI_SUCCESS;
-   ViUInt32  retCnt = 0;
-   ViUInt16  stb;
-   ViChar    buffer[CMD_BUF_SIZE];
-   ViBoolean answer;
-   ViString  format[] = {"%*s %s", "%s"};
-
-   if ((status = viGetAttribute (instrumentHandle, VI_ATTR_USER_DATA, &answer)) < 0) return status;
+   ViStatus          status     = VI_SUCCESS;
+   ViString          command1[] = {":SHAREP:MIN?", ":SHAREP:MAX?", ":SHAREP:SET?"};
+   ViString          command2[] = {":SHAREI:MIN?", ":SHAREI:MAX?", ":SHAREI:SET?"};
+   ViString          command3[] = {":SHARED:MIN?", ":SHARED:MAX?", ":SHARED:SET?"};
+   ViString          queries[3], answers[3];
+   ViReal64          *shares[3];
+   ViChar            response[RESPONSE_BUF_SIZE];
+   ViChar            value[PRO8_SHADOW_VALUE_WIDTH];
+   ViBoolean         answer, shadow;
+   ViInt16           i;
+   Pro8_tShadowEntry *entries[3];
+   Pro8_tSession     *session;
+
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   if ((status = Pro8_GetAnswer (instrumentHandle, &answer)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Check input parameter ranges
+   if (Pro8_invalidViInt16Range (values, 0, 2)) return Pro8_Unlock (instrumentHandle, VI_ERROR_PARAMETER2);
+   queries[0] = command1[values];
+   queries[1] = command2[values];
+   queries[2] = command3[values];
+   shares[0]  = PShare;
+   shares[1]  = IShare;
+   shares[2]  = DShare;
+   //Shadow model - all three shares or none
+   session = Pro8_GetSession (instrumentHandle);
+   shadow  = (ViBoolean)(session && session->shadowMode && session->slot && (values == 2));
+   if (shadow)
+   {
+      for (i = 0; (i < 3) && ((entries[i] = Pro8_ShadowFresh (session, session->slot, queries[i])) != VI_NULL); i++);
+      if (i == 3)
+      {
+         session->shadowHits++;
+         for (i = 0; i < 3; i++)
+         {
+            if ((status = Pro8_ParseReal (entries[i]->value, 1, shares[i])) < 0) return Pro8_Unlock (instrumentHandle, status);
+         }
+         return Pro8_Unlock (instrumentHandle, status);
+      }
+   }
    //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, ":SYNCMOD?", 9, &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format[answer], buffer)) < 0) return status;
-   //Evaluate
-   if      (CompareStrings ("OFF", 0, buffer, 0, 0) == 0) *synchronousModulation = 0;
-   else if (CompareStrings ("ON",  0, buffer, 0, 0) == 0) *synchronousModulation = 1;
-   else status = VI_ERROR_INSTR_INTERPRETING_RESPONSE;
+   if ((status = Pro8_CompoundQuery (instrumentHandle, 3, queries, response, sizeof (response), answers)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   for (i = 0; i < 3; i++)
+   {
+      if ((status = Pro8_ParseReal (answers[i], answer, shares[i])) < 0) return Pro8_Unlock (instrumentHandle, status);
+      if (shadow)
+      {
+         Pro8_ShadowValue (answers[i], answer, value, sizeof (value));
+         Pro8_ShadowStore (session, session->slot, queries[i], value);
+      }
+   }
+   if (shadow) session->shadowMisses++;
    //Ready
-   return status;
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
-
-
-//===========================================================================
-// SLED MODULE FUNCTIONS
-//===========================================================================
 //---------------------------------------------------------------------------
-// Function: Set LED Output
-// Purpose:  This function switches the output on or off
+// Function: Set Peltier Limit Current
+// Purpose:  This function sets the limit current of the peltier
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_SledSetOutput (ViSession instrumentHandle, ViInt16 output)
+ViStatus _VI_FUNC Pro8_TecSetPtLimit (ViSession instrumentHandle, ViReal64 limitCurrent)
 {
-   ViStatus status    = VI_SUCCESS;
-   ViUInt32 retCnt    = 0;
+   ViStatus status = VI_SUCCESS;
+   ViUInt32 retCnt = 0;
    ViUInt16 stb;
-   ViString command[] = {":LED OFF", ":LED ON"};
+   ViChar   buffer[CMD_BUF_SIZE];
 
-   //Check input parameter ranges
-   if (Pro8_invalidViInt16Range (output, 0, 1)) return VI_ERROR_PARAMETER2;
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   //Formatting
+   Pro8_Fmt (buffer, ":LIMT:SET %f", limitCurrent);
    //Writing - Poll STB - Check EAV Bit and read error
-   if ((status = viWrite (instrumentHandle, command[output], StringLength (command[output]), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
+   if ((status = Pro8_Write (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
    //Ready
-   return status;
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get Laser Output
-// Purpose:  This function returns the state of the output
+// Function: Get Peltier Limit Current
+// Purpose:  This function returns the limit current of the peltier
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_SledGetOutput (ViSession instrumentHandle, ViInt16 *output)
+ViStatus _VI_FUNC Pro8_TecGetPtLimit (ViSession instrumentHandle, ViInt16 value, ViReal64 *limitCurrent)
 {
    ViStatus status = VI_SUCCESS;
-   ViUInt32 retCnt = 0;
-   ViUInt16 stb;
-   ViChar   buffer[CMD_BUF_SIZE];
+   ViString command[] = {":LIMT:MIN?", ":LIMT:MAX?", ":LIMT:SET?"};
    ViBoolean answer;
-   ViString  format[] = {"%*s %s", "%s"};
 
-   if ((status = viGetAttribute (instrumentHandle, VI_ATTR_USER_DATA, &answer)) < 0) return status;
-   //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, ":LED?", 5, &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format[answer], buffer)) < 0) return status;
-   //Evaluate
-   if      (CompareStrings ("OFF", 0, buffer, 0, 0) == 0) *output = 0;
-   else if (CompareStrings ("ON",  0, buffer, 0, 0) == 0) *output = 1;
-   else status = VI_ERROR_INSTR_INTERPRETING_RESPONSE;
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   if ((status = Pro8_GetAnswer (instrumentHandle, &answer)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Check input parameter ranges
+   if (Pro8_invalidViInt16Range (value, 0, 2)) return Pro8_Unlock (instrumentHandle, VI_ERROR_PARAMETER2);
+   //Shadow model or Writing - Poll STB - Check EAV Bit and read error - Reading
+   if ((status = Pro8_ShadowReal (instrumentHandle, command[value], answer, limitCurrent)) < 0) return Pro8_Unlock (instrumentHandle, status);
    //Ready
-   return status;
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
-// Function: Set Laser Power
-// Purpose:  This function sets the laser power (dBm)
+// Function: Get Peltier Limit Current (adjusted via poti)
+// Purpose:  This function returns the limit current of the peltier
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_SledSetPowerdBm (ViSession instrumentHandle, ViReal64 power)
+ViStatus _VI_FUNC Pro8_TecGetPtLimitPoti (ViSession instrumentHandle, ViReal64 *limitCurrent)
 {
-   return Pro8_LsSetPowerdBm (instrumentHandle, power);
+   ViStatus  status = VI_SUCCESS;
+   ViUInt32  retCnt = 0;
+   ViUInt16  stb;
+   ViBoolean answer;
+
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   if ((status = Pro8_GetAnswer (instrumentHandle, &answer)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Writing - Poll STB - Check EAV Bit and read error - Reading
+   if ((status = Pro8_Write (instrumentHandle, ":LIMTP:ACT?", 11, &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
+   if ((status = Pro8_ReadReal (instrumentHandle, answer, limitCurrent)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Ready
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get Laser Power
-// Purpose:  This function returns the laser power (dBm)
+// Function: Get Peltier Current
+// Purpose:  This function returns the current of the peltier
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_SledGetPowerdBm (ViSession instrumentHandle, ViInt16 value, ViReal64 *power)
+ViStatus _VI_FUNC Pro8_TecGetPtCurrent (ViSession instrumentHandle, ViReal64 *current)
 {
-   return Pro8_LsGetPowerdBm (instrumentHandle, value, power);
+   ViStatus  status = VI_SUCCESS;
+   ViUInt32  retCnt = 0;
+   ViUInt16  stb;
+   ViBoolean answer;
+
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   if ((status = Pro8_GetAnswer (instrumentHandle, &answer)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Writing - Poll STB - Check EAV Bit and read error - Reading
+   if ((status = Pro8_Write (instrumentHandle, ":ITE:ACT?", 9, &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
+   if ((status = Pro8_ReadReal (instrumentHandle, answer, current)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Ready
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
-// Function: Set Laser Power
-// Purpose:  This function sets the laser power (W)
+// Function: Get Peltier Voltage
+// Purpose:  This function returns the voltage of the peltier
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_SledSetPowerW (ViSession instrumentHandle, ViReal64 power)
+ViStatus _VI_FUNC Pro8_TecGetPtVoltage (ViSession instrumentHandle, ViReal64 *voltage)
 {
-   return Pro8_LsSetPowerW (instrumentHandle, power);
+   ViStatus  status = VI_SUCCESS;
+   ViUInt32  retCnt = 0;
+   ViUInt16  stb;
+   ViBoolean answer;
+
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   if ((status = Pro8_GetAnswer (instrumentHandle, &answer)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Writing - Poll STB - Check EAV Bit and read error - Reading
+   if ((status = Pro8_Write (instrumentHandle, ":VTE:ACT?", 9, &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
+   if ((status = Pro8_ReadReal (instrumentHandle, answer, voltage)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Ready
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
+//===========================================================================
+// ITC MODULE FUNCTIONS
+//===========================================================================
 //---------------------------------------------------------------------------
-// Function: Get Laser Power
-// Purpose:  This function returns the laser power (W)
+// Function: Set Mode
+// Purpose:  This function sets the operation mode
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_SledGetPowerW (ViSession instrumentHandle, ViInt16 value, ViReal64 *power)
+ViStatus _VI_FUNC Pro8_ItcSetMode (ViSession instrumentHandle, ViInt16 mode)
 {
-   return Pro8_LsGetPowerW (instrumentHandle, value, power);
+   return Pro8_LdcSetMode (instrumentHandle, mode);
 }
 
 //---------------------------------------------------------------------------
-// Function: Set Synchronous Modulation
-// Purpose:  This function switches the sync. modulation on and off
+// Function: Get Mode
+// Purpose:  This function returns the operation mode
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_SledSetSyncMod (ViSession instrumentHandle, ViInt16 synchronousModulation)
+ViStatus _VI_FUNC Pro8_ItcGetMode (ViSession instrumentHandle, ViInt16 *mode)
 {
-   return Pro8_LsSetSyncMod (instrumentHandle, synchronousModulation);
+   return Pro8_LdcGetMode (instrumentHandle, mode);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get Synchronous Modulation
-// Purpose:  This function retuns the state of the sync. modulation
+// Function: Set Laser Polarity
+// Purpose:  This function sets the polarity of the laserdiode
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_SledGetSyncMod (ViSession instrumentHandle, ViInt16 *synchronousModulation)
+ViStatus _VI_FUNC Pro8_ItcSetLdPol (ViSession instrumentHandle, ViInt16 polarity)
 {
-   return Pro8_LsGetSyncMod (instrumentHandle, synchronousModulation);
+   return Pro8_LdcSetLdPol (instrumentHandle, polarity);
 }
 
+//---------------------------------------------------------------------------
+// Function: Get Laser Polarity
+// Purpose:  This function returns the polarity of the laserdiode
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_ItcGetLdPol (ViSession instrumentHandle, ViInt16 *polarity)
+{
+   return Pro8_LdcGetLdPol (instrumentHandle, polarity);
+}
 
-//===========================================================================
-// WDM-CW MODULE FUNCTIONS
-//===========================================================================
 //---------------------------------------------------------------------------
-// Function: Set Laser Output
-// Purpose:  This function switches the output on or off
+// Function: Set Photodiode Polarity
+// Purpose:  This function sets the photodiode polarity
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmCwSetOutput (ViSession instrumentHandle, ViInt16 output)
+ViStatus _VI_FUNC Pro8_ItcSetPdPol (ViSession instrumentHandle, ViInt16 polarity)
 {
-   return Pro8_LdcSetLdOutput (instrumentHandle, output);
+   return Pro8_LdcSetPdPol (instrumentHandle, polarity);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get Laser Output
-// Purpose:  This function returns the state of the output
+// Function: Get Photodiode Polarity
+// Purpose:  This function returns the photodiode polarity
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmCwGetOutput (ViSession instrumentHandle, ViInt16 *output)
+ViStatus _VI_FUNC Pro8_ItcGetPdPol (ViSession instrumentHandle, ViInt16 *polarity)
 {
-   return Pro8_LdcGetLdOutput (instrumentHandle, output);
+   return Pro8_LdcGetPdPol (instrumentHandle, polarity);
 }
 
 //---------------------------------------------------------------------------
-// Function: Set Laser Power
-// Purpose:  This function sets the laser power (dBm)
+// Function: Set Temperature Protection
+// Purpose:  This function switches the temperature protection
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmCwSetPowerdBm (ViSession instrumentHandle, ViReal64 power)
+ViStatus _VI_FUNC Pro8_ItcSetTempProt (ViSession instrumentHandle, ViInt16 tempProtection)
 {
-   return Pro8_LsSetPowerdBm (instrumentHandle, power);
+   return Pro8_LdcSetTempProt (instrumentHandle, tempProtection);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get Laser Power
-// Purpose:  This function returns the laser power (dBm)
+// Function: Get Temperature Protection
+// Purpose:  This function returns the state of the temperature protection
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmCwGetPowerdBm (ViSession instrumentHandle, ViInt16 value, ViReal64 *power)
+ViStatus _VI_FUNC Pro8_ItcGetTempProt (ViSession instrumentHandle, ViInt16 *temperatureProtection)
 {
-   return Pro8_LsGetPowerdBm (instrumentHandle, value, power);
+   return Pro8_LdcGetTempProt (instrumentHandle, temperatureProtection);
 }
 
 //---------------------------------------------------------------------------
-// Function: Set Laser Power
-// Purpose:  This function sets the laser power (W)
+// Function: Set Laser Output
+// Purpose:  This function switches the output on or off
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmCwSetPowerW (ViSession instrumentHandle, ViReal64 power)
+ViStatus _VI_FUNC Pro8_ItcSetLdOutput (ViSession instrumentHandle, ViInt16 output)
 {
-   return Pro8_LsSetPowerW (instrumentHandle, power);
+   return Pro8_LdcSetLdOutput (instrumentHandle, output);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get Laser Power
-// Purpose:  This function returns the laser power (W)
+// Function: Get Laser Output
+// Purpose:  This function returns the state of the output
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmCwGetPowerW (ViSession instrumentHandle, ViInt16 value, ViReal64 *power)
+ViStatus _VI_FUNC Pro8_ItcGetLdOutput (ViSession instrumentHandle, ViInt16 *output)
 {
-   return Pro8_LsGetPowerW (instrumentHandle, value, power);
+   return Pro8_LdcGetLdOutput (instrumentHandle, output);
 }
 
 //---------------------------------------------------------------------------
-// Function: Set Coherence Control Ration
-// Purpose:  This function sets the coherence control ratio
+// Function: Set Sensor
+// Purpose:  This function sets the temperature sensor
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmCwSetCoherence (ViSession instrumentHandle, ViReal64 coherence)
+ViStatus _VI_FUNC Pro8_ItcSetSensor (ViSession instrumentHandle, ViInt16 sensor)
 {
-   ViStatus status = VI_SUCCESS;
-   ViUInt32 retCnt = 0;
+   ViStatus status    = VI_SUCCESS;
+   ViUInt32 retCnt    = 0;
    ViUInt16 stb;
-   ViChar   buffer[CMD_BUF_SIZE];
+   ViString command[] = {":SENS AD", ":SENS TH"};
 
-   //Formatting
-   Fmt (buffer, ":COHERENCE:SET %f", coherence);
+   //Check input parameter ranges
+   if (Pro8_invalidViInt16Range (sensor, 0, 1)) return VI_ERROR_PARAMETER2;
+   //Lock session
+   Pro8_Lock (instrumentHandle);
    //Writing - Poll STB - Check EAV Bit and read error
-   if ((status = viWrite (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
+   if ((status = Pro8_Write (instrumentHandle, command[sensor], StringLength (command[sensor]), &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
    //Ready
-   return status;
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get Coherence Control Ration
-// Purpose:  This function returns the coherence control ratio
+// Function: Get Sensor
+// Purpose:  This function returns the temperature sensor
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmCwGetCoherence (ViSession instrumentHandle, ViInt16 value, ViReal64 *coherence)
+ViStatus _VI_FUNC Pro8_ItcGetSensor (ViSession instrumentHandle, ViInt16 *sensor)
 {
    ViStatus  status = VI_SUCCESS;
-   ViUInt32  retCnt = 0;
-   ViUInt16  stb;
-   ViString  command[] = {":COHERENCE:MIN?", ":COHERENCE:MAX?", ":COHERENCE:SET?"};
+   ViChar    buffer[CMD_BUF_SIZE];
    ViBoolean answer;
-   ViString  format[] = {"%*s %LE", "%LE"};
 
-   if ((status = viGetAttribute (instrumentHandle, VI_ATTR_USER_DATA, &answer)) < 0) return status;
-   //Check input parameter ranges
-   if (Pro8_invalidViInt16Range (value, 0, 2)) return VI_ERROR_PARAMETER2;
-   //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, command[value], StringLength (command[value]), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format[answer], coherence)) < 0) return status;
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   if ((status = Pro8_GetAnswer (instrumentHandle, &answer)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Shadow model or Writing - Poll STB - Check EAV Bit and read error - Reading
+   if ((status = Pro8_ShadowQuery (instrumentHandle, ":SENS?", answer, buffer, sizeof (buffer))) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Evaluate
+   if      (CompareStrings ("AD", 0, buffer, 0, 0) == 0) *sensor = 0;
+   else if (CompareStrings ("TH", 0, buffer, 0, 0) == 0) *sensor = 1;
+   else status = VI_ERROR_INSTR_INTERPRETING_RESPONSE;
    //Ready
-   return status;
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
-// Function: Set Wavelength
-// Purpose:  This function sets the wavelength
+// Function: Set I-Share
+// Purpose:  This function switches the I-share on and off
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmCwSetWavelength (ViSession instrumentHandle, ViReal64 wavelength)
+ViStatus _VI_FUNC Pro8_ItcSetIShare (ViSession instrumentHandle, ViInt16 IShare)
 {
-   ViStatus status = VI_SUCCESS;
-   ViUInt32 retCnt = 0;
-   ViUInt16 stb;
-   ViChar   buffer[CMD_BUF_SIZE];
-
-   //Formatting
-   Fmt (buffer, ":LAMBDA:SET %f", wavelength);
-   //Writing - Poll STB - Check EAV Bit and read error
-   if ((status = viWrite (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   //Ready
-   return status;
+   return Pro8_TecSetIShare (instrumentHandle, IShare);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get Wavelength
-// Purpose:  This function returns the wavelength
+// Function: Get I_Share
+// Purpose:  This function returns the state of the I-share
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmCwGetWavelength (ViSession instrumentHandle, ViInt16 value, ViReal64 *wavelength)
+ViStatus _VI_FUNC Pro8_ItcGetIShare (ViSession instrumentHandle, ViInt16 *IShare)
 {
-   ViStatus  status = VI_SUCCESS;
-   ViUInt32  retCnt = 0;
-   ViUInt16  stb;
-   ViString  command[] = {":LAMBDA:MIN?", ":LAMBDA:MAX?", ":LAMBDA:SET?"};
-   ViBoolean answer;
-   ViString  format[] = {"%*s %LE", "%LE"};
-
-   if ((status = viGetAttribute (instrumentHandle, VI_ATTR_USER_DATA, &answer)) < 0) return status;
-   //Check input parameter ranges
-   if (Pro8_invalidViInt16Range (value, 0, 2)) return VI_ERROR_PARAMETER2;
-   //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, command[value], StringLength (command[value]), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format[answer], wavelength)) < 0) return status;
-   //Ready
-   return status;
+   return Pro8_TecGetIShare (instrumentHandle, IShare);
 }
 
 //---------------------------------------------------------------------------
-// Function: Set Frequency
-// Purpose:  This function sets the frequency
+// Function: Set Peltier Output
+// Purpose:  This function switches the output on or off
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmCwSetFrequency (ViSession instrumentHandle, ViReal64 frequency)
+ViStatus _VI_FUNC Pro8_ItcSetPtOutput (ViSession instrumentHandle, ViInt16 output)
 {
-   ViStatus status = VI_SUCCESS;
-   ViUInt32 retCnt = 0;
-   ViUInt16 stb;
-   ViChar   buffer[CMD_BUF_SIZE];
-
-   //Formatting
-   Fmt (buffer, ":LASERFREQ:SET %f", frequency);
-   //Writing - Poll STB - Check EAV Bit and read error
-   if ((status = viWrite (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   //Ready
-   return status;
+   return Pro8_TecSetPtOutput (instrumentHandle, output);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get Frequency
-// Purpose:  This function returns the frequency
+// Function: Get Peltier Output
+// Purpose:  This function returns the state of the output
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmCwGetFrequency (ViSession instrumentHandle, ViInt16 value, ViReal64 *frequency)
+ViStatus _VI_FUNC Pro8_ItcGetPtOutput (ViSession instrumentHandle, ViInt16 *output)
 {
-   ViStatus  status = VI_SUCCESS;
-   ViUInt32  retCnt = 0;
-   ViUInt16  stb;
-   ViString  command[] = {":LASERFREQ:MIN?", ":LASERFREQ:MAX?", ":LASERFREQ:SET?"};
-   ViBoolean answer;
-   ViString  format[] = {"%*s %LE", "%LE"};
-
-   if ((status = viGetAttribute (instrumentHandle, VI_ATTR_USER_DATA, &answer)) < 0) return status;
-   //Check input parameter ranges
-   if (Pro8_invalidViInt16Range (value, 0, 2)) return VI_ERROR_PARAMETER2;
-   //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, command[value], StringLength (command[value]), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format[answer], frequency)) < 0) return status;
-   //Ready
-   return status;
+   return Pro8_TecGetPtOutput (instrumentHandle, output);
 }
 
 //---------------------------------------------------------------------------
-// Function: Set Synchronous Modulation
-// Purpose:  This function switches the sync. modulation on and off
+// Function: Set Calibration Factor
+// Purpose:  This function sets the calibration factor of the photodiode
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmCwSetSyncMod (ViSession instrumentHandle, ViInt16 synchronousModulation)
+ViStatus _VI_FUNC Pro8_ItcSetCalibration (ViSession instrumentHandle, ViReal64 calibrationFactor)
 {
-   return Pro8_LsSetSyncMod (instrumentHandle, synchronousModulation);
+   return Pro8_LdcSetCalibration (instrumentHandle, calibrationFactor);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get Synchronous Modulation
-// Purpose:  This function retuns the state of the sync. modulation
+// Function: Get Calibration Factor
+// Purpose:  This function returns the calibration factor of the photodiode
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmCwGetSyncMod (ViSession instrumentHandle, ViInt16 *synchronousModulation)
+ViStatus _VI_FUNC Pro8_ItcGetCalibration (ViSession instrumentHandle, ViInt16 value, ViReal64 *calibrationfactor)
 {
-   return Pro8_LsGetSyncMod (instrumentHandle, synchronousModulation);
+   return Pro8_LdcGetCalibration (instrumentHandle, value, calibrationfactor);
 }
 
 //---------------------------------------------------------------------------
-// Function: Set LF Modulation
-// Purpose:  This function switches the LF modulation on and off
+// Function: Set Laser Current
+// Purpose:  This function sets the current of the laserdiode
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmCwSetLfMod (ViSession instrumentHandle, ViInt16 LFModulation)
+ViStatus _VI_FUNC Pro8_ItcSetLdCurrent (ViSession instrumentHandle, ViReal64 current)
 {
-   ViStatus status    = VI_SUCCESS;
-   ViUInt32 retCnt    = 0;
-   ViUInt16 stb;
-   ViString command[] = {":LFMOD:ENABLE OFF", ":LFMOD:ENABLE ON"};
-
-   //Check input parameter ranges
-   if (Pro8_invalidViInt16Range (LFModulation, 0, 1)) return VI_ERROR_PARAMETER2;
-   //Writing - Poll STB - Check EAV Bit and read error
-   if ((status = viWrite (instrumentHandle, command[LFModulation], StringLength (command[LFModulation]), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   //Ready
-   return status;
+   return Pro8_LdcSetLdCurrent (instrumentHandle, current);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get LF Modulation
-// Purpose:  This function retuns the state of the LF modulation
+// Function: Get Laser Current
+// Purpose:  This function returns the current of the laserdiode
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmCwGetLfMod (ViSession instrumentHandle, ViInt16 *LFModulation)
+ViStatus _VI_FUNC Pro8_ItcGetLdCurrent (ViSession instrumentHandle, ViInt16 value, ViReal64 *current)
 {
-   ViStatus status = VI_SUCCESS;
-   ViUInt32 retCnt = 0;
-   ViUInt16 stb;
-   ViChar   buffer[CMD_BUF_SIZE];
-   ViBoolean answer;
-   ViString  format[] = {"%*s %s", "%s"};
-
-   if ((status = viGetAttribute (instrumentHandle, VI_ATTR_USER_DATA, &answer)) < 0) return status;
-   //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, ":LFMOD:ENABLE?", 14, &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format[answer], buffer)) < 0) return status;
-   //Evaluate
-   if      (CompareStrings ("OFF", 0, buffer, 0, 0) == 0) *LFModulation = 0;
-   else if (CompareStrings ("ON",  0, buffer, 0, 0) == 0) *LFModulation = 1;
-   else status = VI_ERROR_INSTR_INTERPRETING_RESPONSE;
-   //Ready
-   return status;
+   return Pro8_LdcGetLdCurrent (instrumentHandle, value, current);
 }
 
 //---------------------------------------------------------------------------
-// Function: Set LF Modulation Type
-// Purpose:  This function switches the LF modulation type
+// Function: Set Photodiode Current
+// Purpose:  This function sets the current of the photodiode
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmCwSetLfModType (ViSession instrumentHandle, ViInt16 LFModulationType)
+ViStatus _VI_FUNC Pro8_ItcSetPdCurrent (ViSession instrumentHandle, ViReal64 current)
 {
-   ViStatus status    = VI_SUCCESS;
-   ViUInt32 retCnt    = 0;
-   ViUInt16 stb;
-   ViString command[] = {":LFMOD:TYPE NOISE", ":LFMOD:TYPE PULSE", ":LFMOD:TYPE SINE", ":LFMOD:TYPE SQUARE", ":LFMOD:TYPE TRIANGLE"};
-
-   //Check input parameter ranges
-   if (Pro8_invalidViInt16Range (LFModulationType, 0, 4)) return VI_ERROR_PARAMETER2;
-   //Writing - Poll STB - Check EAV Bit and read error
-   if ((status = viWrite (instrumentHandle, command[LFModulationType], StringLength (command[LFModulationType]), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   //Ready
-   return status;
+   return Pro8_LdcSetPdCurrent (instrumentHandle, current);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get LF Modulation Type
-// Purpose:  This function retuns the type of LF modulation
+// Function: Get Photodiode Current
+// Purpose:  This function returns the current of the photodiode
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmCwGetLfModType (ViSession instrumentHandle, ViInt16 *LFModulationType)
+ViStatus _VI_FUNC Pro8_ItcGetPdCurrent (ViSession instrumentHandle, ViInt16 value, ViReal64 *current)
 {
-   ViStatus status = VI_SUCCESS;
-   ViUInt32 retCnt = 0;
-   ViUInt16 stb;
-   ViChar   buffer[CMD_BUF_SIZE];
-   ViBoolean answer;
-   ViString  format[] = {"%*s %s", "%s"};
-
-   if ((status = viGetAttribute (instrumentHandle, VI_ATTR_USER_DATA, &answer)) < 0) return status;
-   //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, ":LFMOD:TYPE?", 12, &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format[answer], buffer)) < 0) return status;
-   //Evaluate
-   if      (CompareStrings ("NOISE",    0, buffer, 0, 0) == 0) *LFModulationType = 0;
-   else if (CompareStrings ("PULSE",    0, buffer, 0, 0) == 0) *LFModulationType = 1;
-   else if (CompareStrings ("SINE" ,    0, buffer, 0, 0) == 0) *LFModulationType = 2;
-   else if (CompareStrings ("SQUARE",   0, buffer, 0, 0) == 0) *LFModulationType = 3;
-   else if (CompareStrings ("TRIANGLE", 0, buffer, 0, 0) == 0) *LFModulationType = 4;
-   else status = VI_ERROR_INSTR_INTERPRETING_RESPONSE;
-   //Ready
-   return status;
+   return Pro8_LdcGetPdCurrent (instrumentHandle, value, current);
 }
 
 //---------------------------------------------------------------------------
-// Function: Set LF Modulation Amplitude
-// Purpose:  This function sets the LF modulation amplitude
+// Function: Set Optical Power
+// Purpose:  This function sets the optical power
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmCwSetLfAmplitude (ViSession instrumentHandle, ViReal64 LFAmplitude)
+ViStatus _VI_FUNC Pro8_ItcSetPower (ViSession instrumentHandle, ViReal64 opticalPower)
 {
-   ViStatus status = VI_SUCCESS;
-   ViUInt32 retCnt = 0;
-   ViUInt16 stb;
-   ViChar   buffer[CMD_BUF_SIZE];
-
-   //Formatting
-   Fmt (buffer, ":LFAMP:SET %f", LFAmplitude);
-   //Writing - Poll STB - Check EAV Bit and read error
-   if ((status = viWrite (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   //Ready
-   return status;
+   return Pro8_LdcSetPower (instrumentHandle, opticalPower);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get LF Modulation Amplitude
-// Purpose:  This function returns the LF modulation amplitude
+// Function: Get Optical Power
+// Purpose:  This function returns the optical power
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmCwGetLfAmplitude (ViSession instrumentHandle, ViInt16 value, ViReal64 *LFAmplitude)
+ViStatus _VI_FUNC Pro8_ItcGetPower (ViSession instrumentHandle, ViInt16 value, ViReal64 *opticalPower)
 {
-   ViStatus  status = VI_SUCCESS;
-   ViUInt32  retCnt = 0;
-   ViUInt16  stb;
-   ViString  command[] = {":LFAMP:MIN?", ":LFAMP:MAX?", ":LFAMP:SET?"};
-   ViBoolean answer;
-   ViString  format[] = {"%*s %LE", "%LE"};
-
-   if ((status = viGetAttribute (instrumentHandle, VI_ATTR_USER_DATA, &answer)) < 0) return status;
-   //Check input parameter ranges
-   if (Pro8_invalidViInt16Range (value, 0, 2)) return VI_ERROR_PARAMETER2;
-   //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, command[value], StringLength (command[value]), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format[answer], LFAmplitude)) < 0) return status;
-   //Ready
-   return status;
+   return Pro8_LdcGetPower (instrumentHandle, value, opticalPower);
 }
 
 //---------------------------------------------------------------------------
-// Function: Set LF Modulation Frequency
-// Purpose:  This function sets the LF modulation frequency
+// Function: Set Bias Voltage
+// Purpose:  This function sets the photo diode bias voltage
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmCwSetLfFrequency (ViSession instrumentHandle, ViReal64 LFFrequency)
+ViStatus _VI_FUNC Pro8_ItcSetBiasVoltage (ViSession instrumentHandle, ViReal64 biasVoltage)
 {
-   ViStatus status = VI_SUCCESS;
-   ViUInt32 retCnt = 0;
-   ViUInt16 stb;
-   ViChar   buffer[CMD_BUF_SIZE];
-
-   //Formatting
-   Fmt (buffer, ":LFFREQ:SET %f", LFFrequency);
-   //Writing - Poll STB - Check EAV Bit and read error
-   if ((status = viWrite (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   //Ready
-   return status;
+   return Pro8_PdaSetBiasVoltage (instrumentHandle, biasVoltage);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get LF Modulation Frequency
-// Purpose:  This function returns the LF modulation frequency
+// Function: Get Bias Voltage
+// Purpose:  This function returns the bias voltage
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmCwGetLfFrequency (ViSession instrumentHandle, ViInt16 value, ViReal64 *LFFrequency)
+ViStatus _VI_FUNC Pro8_ItcGetBiasVoltage (ViSession instrumentHandle, ViInt16 value, ViReal64 *biasVoltage)
 {
-   ViStatus  status = VI_SUCCESS;
-   ViUInt32  retCnt = 0;
-   ViUInt16  stb;
-   ViString  command[] = {":LFFREQ:MIN?", ":LFFREQ:MAX?", ":LFFREQ:SET?"};
-   ViBoolean answer;
-   ViString  format[] = {"%*s %LE", "%LE"};
-
-   if ((status = viGetAttribute (instrumentHandle, VI_ATTR_USER_DATA, &answer)) < 0) return status;
-   //Check input parameter ranges
-   if (Pro8_invalidViInt16Range (value, 0, 2)) return VI_ERROR_PARAMETER2;
-   //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, command[value], StringLength (command[value]), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format[answer], LFFrequency)) < 0) return status;
-   //Ready
-   return status;
+   return Pro8_PdaGetBiasVoltage (instrumentHandle, value, biasVoltage);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get max HF Modulation Voltage
-// Purpose:  This function returns the maximum HF modulation voltage
+// Function: Set LD Limit Current
+// Purpose:  This function sets the limit current of the laser diode
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmCwGetMaxHfVoltage (ViSession instrumentHandle, ViReal64 *maxHF_modVoltage)
+ViStatus _VI_FUNC Pro8_ItcSetLdLimit (ViSession instrumentHandle, ViReal64 limitCurrent)
 {
-   ViStatus  status = VI_SUCCESS;
-   ViUInt32  retCnt = 0;
-   ViUInt16  stb;
-   ViBoolean answer;
-   ViString  format[] = {"%*s %LE", "%LE"};
-
-   if ((status = viGetAttribute (instrumentHandle, VI_ATTR_USER_DATA, &answer)) < 0) return status;
-   //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, ":VHFMAX:ACT?", 12, &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format[answer], maxHF_modVoltage)) < 0) return status;
-   //Ready
-   return status;
+   return Pro8_LdcSetLdLimit (instrumentHandle, limitCurrent);
 }
 
-//===========================================================================
-// WDM-EA MODULE FUNCTIONS
-//===========================================================================
 //---------------------------------------------------------------------------
-// Function: Set Coherence Control
-// Purpose:  This function switches the coherence control on or off
+// Function: Get LD Limit Current
+// Purpose:  This function returns the limit current of the laser diode
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmEaSetCohCtrl (ViSession instrumentHandle, ViInt16 coherence)
+ViStatus _VI_FUNC Pro8_ItcGetLdLimit (ViSession instrumentHandle, ViInt16 value, ViReal64 *limitCurrent)
 {
-   ViStatus status    = VI_SUCCESS;
-   ViUInt32 retCnt    = 0;
-   ViUInt16 stb;
-   ViString command[] = {":COHCNTL OFF", ":COHCNTL ON"};
-
-   //Check input parameter ranges
-   if (Pro8_invalidViInt16Range (coherence, 0, 1)) return VI_ERROR_PARAMETER2;
-   //Writing - Poll STB - Check EAV Bit and read error
-   if ((status = viWrite (instrumentHandle, command[coherence], StringLength (command[coherence]), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   //Ready
-   return status;
+   return Pro8_LdcGetLdLimit (instrumentHandle, value, limitCurrent);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get Coherence Control
-// Purpose:  This function returns the state of the coherence control
+// Function: Get Laserdiode Limit Current (adjusted via poti)
+// Purpose:  This function returns limit current of the laserdiode
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmEaGetCohCtrl (ViSession instrumentHandle, ViInt16 *coherence)
+ViStatus _VI_FUNC Pro8_ItcGetLdLimitPoti (ViSession instrumentHandle, ViReal64 *limitCurrent)
 {
-   ViStatus  status = VI_SUCCESS;
-   ViUInt32  retCnt = 0;
-   ViUInt16  stb;
-   ViChar    buffer[CMD_BUF_SIZE];
-   ViBoolean answer;
-   ViString  format[] = {"%*s %s", "%s"};
-
-   if ((status = viGetAttribute (instrumentHandle, VI_ATTR_USER_DATA, &answer)) < 0) return status;
-   //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, ":COHCNTL?", 9, &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format[answer], buffer)) < 0) return status;
-   //Evaluate
-   if      (CompareStrings ("OFF", 0, buffer, 0, 0) == 0) *coherence = 0;
-   else if (CompareStrings ("ON",  0, buffer, 0, 0) == 0) *coherence = 1;
-   else status = VI_ERROR_INSTR_INTERPRETING_RESPONSE;
-   //Ready
-   return status;
+   return Pro8_LdcGetLdLimitPoti (instrumentHandle, limitCurrent);
 }
 
 //---------------------------------------------------------------------------
-// Function: Set Laser Output
-// Purpose:  This function switches the output on or off
+// Function: Get Laser Voltage
+// Purpose:  This function returns the voltage of the laserdiode
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmEaSetOutput (ViSession instrumentHandle, ViInt16 output)
+ViStatus _VI_FUNC Pro8_ItcGetLdVoltage (ViSession instrumentHandle, ViReal64 *voltage)
 {
-   return Pro8_LdcSetLdOutput (instrumentHandle, output);
+   return Pro8_LdcGetLdVoltage (instrumentHandle, voltage);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get Laser Output
-// Purpose:  This function returns the state of the output
+// Function: Set Thermistor Calibration (exponential method)
+// Purpose:  This function sets the calibration values for the thermistor
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmEaGetOutput (ViSession instrumentHandle, ViInt16 *output)
+ViStatus _VI_FUNC Pro8_ItcSetThCalExp (ViSession instrumentHandle, ViReal64 BValue, ViReal64 RValue, ViReal64 TValue)
 {
-   return Pro8_LdcGetLdOutput (instrumentHandle, output);
+   return Pro8_TecSetThCalExp (instrumentHandle, BValue, RValue, TValue);
 }
 
 //---------------------------------------------------------------------------
-// Function: Set Laser Power
-// Purpose:  This function sets the laser power (dBm)
+// Function: Get Thermistor Calibration (exponential method)
+// Purpose:  This function returns the calibration values for the thermistor
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmEaSetPowerdBm (ViSession instrumentHandle, ViReal64 power)
+ViStatus _VI_FUNC Pro8_ItcGetThCalExp (ViSession instrumentHandle, ViInt16 values, ViReal64 *BValue, ViReal64 *RValue, ViReal64 *TValue)
 {
-   return Pro8_LsSetPowerdBm (instrumentHandle, power);
+   return Pro8_TecGetThCalExp (instrumentHandle, values, BValue, RValue, TValue);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get Laser Power
-// Purpose:  This function returns the laser power (dBm)
+// Function: Set Thermistor Calibration (Steinhart-Hart method)
+// Purpose:  This function sets the calibration values for the thermistor
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmEaGetPowerdBm (ViSession instrumentHandle, ViInt16 value, ViReal64 *power)
+ViStatus _VI_FUNC Pro8_ItcSetThCalSH (ViSession instrumentHandle, ViReal64 c1Value, ViReal64 c2Value, ViReal64 c3Value)
 {
-   return Pro8_LsGetPowerdBm (instrumentHandle, value, power);
+   return Pro8_TecSetThCalSH (instrumentHandle, c1Value, c2Value, c3Value);
 }
 
 //---------------------------------------------------------------------------
-// Function: Set Laser Power
-// Purpose:  This function sets the laser power (W)
+// Function: Get Thermistor Calibration (Steinhart-Hart method)
+// Purpose:  This function returns the calibration values for the thermistor
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmEaSetPowerW (ViSession instrumentHandle, ViReal64 power)
+ViStatus _VI_FUNC Pro8_ItcGetThCalSH (ViSession instrumentHandle, ViInt16 values, ViReal64 *c1Value, ViReal64 *c2Value, ViReal64 *c3Value)
 {
-   return Pro8_LsSetPowerW (instrumentHandle, power);
+   return Pro8_TecGetThCalSH (instrumentHandle, values, c1Value, c2Value, c3Value);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get Laser Power
-// Purpose:  This function returns the laser power (W)
+// Function: Set Temperature
+// Purpose:  This function sets the temperature
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmEaGetPowerW (ViSession instrumentHandle, ViInt16 value, ViReal64 *power)
+ViStatus _VI_FUNC Pro8_ItcSetTemp (ViSession instrumentHandle, ViReal64 temperature)
 {
-   return Pro8_LsGetPowerW (instrumentHandle, value, power);
+   return Pro8_TecSetTemp (instrumentHandle, temperature);
 }
 
 //---------------------------------------------------------------------------
-// Function: Set Wavelength
-// Purpose:  This function sets the wavelength
+// Function: Get Temperature
+// Purpose:  This function returns the temperature
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmEaSetWavelength (ViSession instrumentHandle, ViReal64 wavelength)
+ViStatus _VI_FUNC Pro8_ItcGetTemp (ViSession instrumentHandle, ViInt16 value, ViReal64 *temperature)
 {
-   return Pro8_WdmCwSetWavelength (instrumentHandle, wavelength);
+   return Pro8_TecGetTemp (instrumentHandle, value, temperature);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get Wavelength
-// Purpose:  This function returns the wavelength
+// Function: Set Resistance
+// Purpose:  This function sets the resistance
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmEaGetWavelength (ViSession instrumentHandle, ViInt16 value, ViReal64 *wavelength)
+ViStatus _VI_FUNC Pro8_ItcSetRes (ViSession instrumentHandle, ViReal64 resistance)
 {
-   return Pro8_WdmCwGetWavelength (instrumentHandle, value, wavelength);
+   return Pro8_TecSetRes (instrumentHandle, resistance);
 }
 
 //---------------------------------------------------------------------------
-// Function: Set Threshold Voltage
-// Purpose:  This function sets the threshold voltage
+// Function: Get Resistance
+// Purpose:  This function returns the resistance
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmEaSetThreshold (ViSession instrumentHandle, ViReal64 thresholdVoltage)
+ViStatus _VI_FUNC Pro8_ItcGetRes (ViSession instrumentHandle, ViInt16 value, ViReal64 *resistance)
 {
-   ViStatus status = VI_SUCCESS;
-   ViUInt32 retCnt = 0;
-   ViUInt16 stb;
-   ViChar   buffer[CMD_BUF_SIZE];
-
-   //Formatting
-   Fmt (buffer, ":VTH:SET %f", thresholdVoltage);
-   //Writing - Poll STB - Check EAV Bit and read error
-   if ((status = viWrite (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   //Ready
-   return status;
+   return Pro8_TecGetRes (instrumentHandle, value, resistance);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get Threshold Voltage
-// Purpose:  This function returns the threshold voltage
+// Function: Set Temperature Window
+// Purpose:  This function sets the temperature window
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmEaGetThreshold (ViSession instrumentHandle, ViInt16 value, ViReal64 *thresholdVoltage)
+ViStatus _VI_FUNC Pro8_ItcSetTempWin (ViSession instrumentHandle, ViReal64 temperatureWindow)
 {
-   ViStatus  status = VI_SUCCESS;
-   ViUInt32  retCnt = 0;
-   ViUInt16  stb;
-   ViString  command[] = {":VTH:MIN?", ":VTH:MAX?", ":VTH:SET?"};
-   ViBoolean answer;
-   ViString  format[] = {"%*s %LE", "%LE"};
-
-   if ((status = viGetAttribute (instrumentHandle, VI_ATTR_USER_DATA, &answer)) < 0) return status;
-   //Check input parameter ranges
-   if (Pro8_invalidViInt16Range (value, 0, 2)) return VI_ERROR_PARAMETER2;
-   //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, command[value], StringLength (command[value]), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format[answer], thresholdVoltage)) < 0) return status;
-   //Ready
-   return status;
+   return Pro8_TecSetTempWin (instrumentHandle, temperatureWindow);
 }
 
 //---------------------------------------------------------------------------
-// Function: Set Frequency
-// Purpose:  This function sets the frequency
+// Function: Get Temperature Window
+// Purpose:  This function returns the temperature window
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmEaSetFrequency (ViSession instrumentHandle, ViReal64 frequency)
+ViStatus _VI_FUNC Pro8_ItcGetTempWin (ViSession instrumentHandle, ViInt16 value, ViReal64 *temperatureWindow)
 {
-   return Pro8_WdmCwSetFrequency (instrumentHandle, frequency);
+   return Pro8_TecGetTempWin (instrumentHandle, value, temperatureWindow);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get Frequency
-// Purpose:  This function returns the frequency
+// Function: Set Resistance Window
+// Purpose:  This function sets the resistance window
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmEaGetFrequency (ViSession instrumentHandle, ViInt16 value, ViReal64 *frequency)
+ViStatus _VI_FUNC Pro8_ItcSetResWin (ViSession instrumentHandle, ViReal64 resistanceWindow)
 {
-   return Pro8_WdmCwGetFrequency (instrumentHandle, value, frequency);
+   return Pro8_TecSetResWin (instrumentHandle, resistanceWindow);
 }
 
 //---------------------------------------------------------------------------
-// Function: Set Synchronous Modulation
-// Purpose:  This function switches the sync. modulation on and off
+// Function: Get Resistance Window
+// Purpose:  This function returns the resistance window
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmEaSetSyncMod (ViSession instrumentHandle, ViInt16 synchronousModulation)
+ViStatus _VI_FUNC Pro8_ItcGetResWin (ViSession instrumentHandle, ViInt16 value, ViReal64 *resistanceWindow)
 {
-   return Pro8_LsSetSyncMod (instrumentHandle, synchronousModulation);
+   return Pro8_TecGetResWin (instrumentHandle, value, resistanceWindow);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get Synchronous Modulation
-// Purpose:  This function retuns the state of the sync. modulation
+// Function: Set PID Shares
+// Purpose:  This function sets the PID shares
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmEaGetSyncMod (ViSession instrumentHandle, ViInt16 *synchronousModulation)
+ViStatus _VI_FUNC Pro8_ItcSetPID (ViSession instrumentHandle, ViReal64 PShare, ViReal64 IShare, ViReal64 DShare)
 {
-   return Pro8_LsGetSyncMod (instrumentHandle, synchronousModulation);
+   return Pro8_TecSetPID (instrumentHandle, PShare, IShare, DShare);
 }
 
 //---------------------------------------------------------------------------
-// Function: Set LF Modulation
-// Purpose:  This function switches the LF modulation on and off
+// Function: Get PID Shares
+// Purpose:  This function returns the PID shares
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmEaSetLfMod (ViSession instrumentHandle, ViInt16 LFModulation)
+ViStatus _VI_FUNC Pro8_ItcGetPID (ViSession instrumentHandle, ViInt16 values, ViReal64 *PShare, ViReal64 *IShare, ViReal64 *DShare)
 {
-   return Pro8_WdmCwSetLfMod (instrumentHandle, LFModulation);
+   return Pro8_TecGetPID (instrumentHandle, values, PShare, IShare, DShare);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get LF Modulation
-// Purpose:  This function retuns the state of the LF modulation
+// Function: Set Peltier Limit Current
+// Purpose:  This function sets the limit current of the peltier
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmEaGetLfMod (ViSession instrumentHandle, ViInt16 *LFModulation)
+ViStatus _VI_FUNC Pro8_ItcSetPtLimit (ViSession instrumentHandle, ViReal64 limitCurrent)
 {
-   return Pro8_WdmCwGetLfMod (instrumentHandle, LFModulation);
+   return Pro8_TecSetPtLimit (instrumentHandle, limitCurrent);
 }
 
 //---------------------------------------------------------------------------
-// Function: Set LF Modulation Type
-// Purpose:  This function switches the LF modulation type
+// Function: Get Peltier Limit Current
+// Purpose:  This function returns the limit current of the peltier
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmEaSetLfModType (ViSession instrumentHandle, ViInt16 LFModulationType)
+ViStatus _VI_FUNC Pro8_ItcGetPtLimit (ViSession instrumentHandle, ViInt16 value, ViReal64 *limitCurrent)
 {
-   return Pro8_WdmCwSetLfModType (instrumentHandle, LFModulationType);
+   return Pro8_TecGetPtLimit (instrumentHandle, value, limitCurrent);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get LF Modulation Type
-// Purpose:  This function retuns the type of LF modulation
+// Function: Get Peltier Current
+// Purpose:  This function returns the current of the peltier
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmEaGetLfModType (ViSession instrumentHandle, ViInt16 *LFModulationType)
+ViStatus _VI_FUNC Pro8_ItcGetPtCurrent (ViSession instrumentHandle, ViReal64 *current)
 {
-   return Pro8_WdmCwGetLfModType (instrumentHandle, LFModulationType);
+   return Pro8_TecGetPtCurrent (instrumentHandle, current);
 }
 
 //---------------------------------------------------------------------------
-// Function: Set LF Modulation Amplitude
-// Purpose:  This function sets the LF modulation amplitude
+// Function: Get Peltier Voltage
+// Purpose:  This function returns the voltage of the peltier
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmEaSetLfAmplitude (ViSession instrumentHandle, ViReal64 LFAmplitude)
+ViStatus _VI_FUNC Pro8_ItcGetPtVoltage (ViSession instrumentHandle, ViReal64 *voltage)
 {
-   return Pro8_WdmCwSetLfAmplitude (instrumentHandle, LFAmplitude);
+   return Pro8_TecGetPtVoltage (instrumentHandle, voltage);
 }
 
+//===========================================================================
+// PDA MODULE FUNCTIONS
+//===========================================================================
 //---------------------------------------------------------------------------
-// Function: Get LF Modulation Amplitude
-// Purpose:  This function returns the LF modulation amplitude
-//---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmEaGetLfAmplitude (ViSession instrumentHandle, ViInt16 value, ViReal64 *LFAmplitude)
+// Function: Set Photodiode Polarity
+// Purpose:  This function sets the photodiode polarity
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_PdaSetPdPol (ViSession instrumentHandle, ViInt16 polarity)
 {
-   return Pro8_WdmCwGetLfAmplitude (instrumentHandle, value, LFAmplitude);
+   return Pro8_LdcSetPdPol (instrumentHandle, polarity);
 }
 
 //---------------------------------------------------------------------------
-// Function: Set LF Modulation Frequency
-// Purpose:  This function sets the LF modulation frequency
+// Function: Get Photodiode Polarity
+// Purpose:  This function returns the photodiode polarity
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmEaSetLfFrequency (ViSession instrumentHandle, ViReal64 LFFrequency)
+ViStatus _VI_FUNC Pro8_PdaGetPdPol (ViSession instrumentHandle, ViInt16 *polarity)
 {
-   return Pro8_WdmCwSetLfFrequency (instrumentHandle, LFFrequency);
+   return Pro8_LdcGetPdPol (instrumentHandle, polarity);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get LF Modulation Frequency
-// Purpose:  This function returns the LF modulation frequency
+// Function: Set Photodiode Bias
+// Purpose:  This function switches the photodiode bias
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmEaGetLfFrequency (ViSession instrumentHandle, ViInt16 value, ViReal64 *LFFrequency)
+ViStatus _VI_FUNC Pro8_PdaSetBias (ViSession instrumentHandle, ViInt16 bias)
 {
-   return Pro8_WdmCwGetLfFrequency (instrumentHandle, value, LFFrequency);
+   return Pro8_LdcSetBias (instrumentHandle, bias);
 }
 
 //---------------------------------------------------------------------------
-// Function: Set HF Modulation Amplitude
-// Purpose:  This function sets the HF modulation amplitude
+// Function: Get Photodiode Bias
+// Purpose:  This function returns the state of the photodiode bias
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmEaSetHfAmplitude (ViSession instrumentHandle, ViReal64 HFAmplitude)
+ViStatus _VI_FUNC Pro8_PdaGetBias (ViSession instrumentHandle, ViInt16 *bias)
+{
+   return Pro8_LdcGetBias (instrumentHandle, bias);
+}
+
+//---------------------------------------------------------------------------
+// Function: Set Range
+// Purpose:  This function sets the current range
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_PdaSetRange (ViSession instrumentHandle, ViInt16 range)
 {
    ViStatus status = VI_SUCCESS;
    ViUInt32 retCnt = 0;
    ViUInt16 stb;
    ViChar   buffer[CMD_BUF_SIZE];
 
+   //Check input parameter ranges
+   if (Pro8_invalidViInt16Range (range, 1, 7)) return VI_ERROR_PARAMETER2;
+   //Lock session
+   Pro8_Lock (instrumentHandle);
    //Formatting
-   Fmt (buffer, ":HFAMP:SET %f", HFAmplitude);
+   Pro8_Fmt (buffer, ":RANGE %d", range);
    //Writing - Poll STB - Check EAV Bit and read error
-   if ((status = viWrite (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
+   if ((status = Pro8_Write (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
    //Ready
-   return status;
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get HF Modulation Amplitude
-// Purpose:  This function returns the HF modulation amplitude
+// Function: Get Range
+// Purpose:  This function returns the current rage
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmEaGetHfAmplitude (ViSession instrumentHandle, ViInt16 value, ViReal64 *HFAmplitude)
+ViStatus _VI_FUNC Pro8_PdaGetRange (ViSession instrumentHandle, ViInt16 *range)
 {
    ViStatus  status = VI_SUCCESS;
-   ViUInt32  retCnt = 0;
+   ViChar    buffer[CMD_BUF_SIZE];
+   ViBoolean answer;
+
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   if ((status = Pro8_GetAnswer (instrumentHandle, &answer)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Shadow model or Writing - Poll STB - Check EAV Bit and read error - Reading
+   if ((status = Pro8_ShadowQuery (instrumentHandle, ":RANGE?", answer, buffer, sizeof (buffer))) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Evaluate
+   *range = (ViInt16)atoi (buffer);
+   //Ready
+   return Pro8_Unlock (instrumentHandle, status);
+}
+
+//---------------------------------------------------------------------------
+// Function: Set Calibration Factor
+// Purpose:  This function sets the calibration factor of the photodiode
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_PdaSetCalibration (ViSession instrumentHandle, ViReal64 calibrationFactor)
+{
+   return Pro8_LdcSetCalibration (instrumentHandle, calibrationFactor);
+}
+
+//---------------------------------------------------------------------------
+// Function: Get Calibration Factor
+// Purpose:  This function returns the calibration factor of the photodiode
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_PdaGetCalibration (ViSession instrumentHandle, ViInt16 value, ViReal64 *calibrationfactor)
+{
+   return Pro8_LdcGetCalibration (instrumentHandle, value, calibrationfactor);
+}
+
+//---------------------------------------------------------------------------
+// Function: Get Photodiode Current
+// Purpose:  This function returns the current of the photodiode
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_PdaGetPdCurrent (ViSession instrumentHandle, ViReal64 *current)
+{
+   ViStatus  status    = VI_SUCCESS;
+   ViUInt32  retCnt    = 0;
    ViUInt16  stb;
-   ViString  command[] = {":HFAMP:MIN?", ":HFAMP:MAX?", ":HFAMP:SET?"};
    ViBoolean answer;
-   ViString  format[] = {"%*s %LE", "%LE"};
 
-   if ((status = viGetAttribute (instrumentHandle, VI_ATTR_USER_DATA, &answer)) < 0) return status;
-   //Check input parameter ranges
-   if (Pro8_invalidViInt16Range (value, 0, 2)) return VI_ERROR_PARAMETER2;
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   if ((status = Pro8_GetAnswer (instrumentHandle, &answer)) < 0) return Pro8_Unlock (instrumentHandle, status);
    //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, command[value], StringLength (command[value]), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format[answer], HFAmplitude)) < 0) return status;
+   if ((status = Pro8_Write (instrumentHandle, ":IPD:ACT?", 9, &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
+   if ((status = Pro8_ReadReal (instrumentHandle, answer, current)) < 0) return Pro8_Unlock (instrumentHandle, status);
    //Ready
-   return status;
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
-// Function: Set HF Modulation
-// Purpose:  This function switches the HF modulation on and off
+// Function: Get Optical Power
+// Purpose:  This function returns the optical power
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmEaSetHfMod (ViSession instrumentHandle, ViInt16 HFModulation)
+ViStatus _VI_FUNC Pro8_PdaGetPower (ViSession instrumentHandle, ViReal64 *opticalPower)
 {
-   ViStatus status    = VI_SUCCESS;
-   ViUInt32 retCnt    = 0;
-   ViUInt16 stb;
-   ViString command[] = {":HFMOD OFF", ":HFMOD ON"};
+   ViStatus  status    = VI_SUCCESS;
+   ViUInt32  retCnt    = 0;
+   ViUInt16  stb;
+   ViBoolean answer;
 
-   //Check input parameter ranges
-   if (Pro8_invalidViInt16Range (HFModulation, 0, 1)) return VI_ERROR_PARAMETER2;
-   //Writing - Poll STB - Check EAV Bit and read error
-   if ((status = viWrite (instrumentHandle, command[HFModulation], StringLength (command[HFModulation]), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   if ((status = Pro8_GetAnswer (instrumentHandle, &answer)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Writing - Poll STB - Check EAV Bit and read error - Reading
+   if ((status = Pro8_Write (instrumentHandle, ":POPT:ACT?", 10, &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
+   if ((status = Pro8_ReadReal (instrumentHandle, answer, opticalPower)) < 0) return Pro8_Unlock (instrumentHandle, status);
    //Ready
-   return status;
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get HF Modulation
-// Purpose:  This function retuns the state of the HF modulation
+// Function: Set Bias Voltage
+// Purpose:  This function sets the photo diode bias voltage
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmEaGetHfMod (ViSession instrumentHandle, ViInt16 *HFModulation)
+ViStatus _VI_FUNC Pro8_PdaSetBiasVoltage (ViSession instrumentHandle, ViReal64 biasVoltage)
 {
    ViStatus status = VI_SUCCESS;
    ViUInt32 retCnt = 0;
    ViUInt16 stb;
    ViChar   buffer[CMD_BUF_SIZE];
+
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   //Formatting
+   Pro8_Fmt (buffer, ":VBIAS:SET %f", biasVoltage);
+   //Writing - Poll STB - Check EAV Bit and read error
+   if ((status = Pro8_Write (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
+   //Ready
+   return Pro8_Unlock (instrumentHandle, status);
+}
+
+//---------------------------------------------------------------------------
+// Function: Get Bias Voltage
+// Purpose:  This function returns the bias voltage
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_PdaGetBiasVoltage (ViSession instrumentHandle, ViInt16 value, ViReal64 *biasVoltage)
+{
+   ViStatus  status = VI_SUCCESS;
+   ViString  command[] = {":VBIAS:MIN?", ":VBIAS:MAX?", ":VBIAS:SET?"};
    ViBoolean answer;
-   ViString  format[] = {"%*s %s", "%s"};
 
-   if ((status = viGetAttribute (instrumentHandle, VI_ATTR_USER_DATA, &answer)) < 0) return status;
-   //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, ":HFMOD?", 7, &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format[answer], buffer)) < 0) return status;
-   //Evaluate
-   if      (CompareStrings ("OFF", 0, buffer, 0, 0) == 0) *HFModulation = 0;
-   else if (CompareStrings ("ON",  0, buffer, 0, 0) == 0) *HFModulation = 1;
-   else status = VI_ERROR_INSTR_INTERPRETING_RESPONSE;
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   if ((status = Pro8_GetAnswer (instrumentHandle, &answer)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Check input parameter ranges
+   if (Pro8_invalidViInt16Range (value, 0, 3)) return Pro8_Unlock (instrumentHandle, VI_ERROR_PARAMETER2);
+   //Shadow model or Writing - Poll STB - Check EAV Bit and read error - Reading
+   if ((status = Pro8_ShadowReal (instrumentHandle, command[value], answer, biasVoltage)) < 0) return Pro8_Unlock (instrumentHandle, status);
    //Ready
-   return status;
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
-// Function: Set Modulation Voltage
-// Purpose:  This function sets the modulation voltage
+// Function: Set Forward Current
+// Purpose:  This function sets the photo diode forward current
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmEaSetModVoltage (ViSession instrumentHandle, ViReal64 modulationVoltage)
+ViStatus _VI_FUNC Pro8_PdaSetFwdCurr (ViSession instrumentHandle, ViReal64 forwardCurrent)
 {
    ViStatus status = VI_SUCCESS;
    ViUInt32 retCnt = 0;
    ViUInt16 stb;
    ViChar   buffer[CMD_BUF_SIZE];
 
+   //Lock session
+   Pro8_Lock (instrumentHandle);
    //Formatting
-   Fmt (buffer, ":VMOD:SET %f", modulationVoltage);
+   Pro8_Fmt (buffer, ":IFWD:SET %f", forwardCurrent);
    //Writing - Poll STB - Check EAV Bit and read error
-   if ((status = viWrite (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
+   if ((status = Pro8_Write (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
    //Ready
-   return status;
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get Modulation Voltage
-// Purpose:  This function returns the modulation voltage
+// Function: Get Forward Current
+// Purpose:  This function returns the photo diode forward current
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmEaGetModVoltage (ViSession instrumentHandle, ViInt16 value, ViReal64 *modulationVoltage)
+ViStatus _VI_FUNC Pro8_PdaGetFwdCurr (ViSession instrumentHandle, ViInt16 value, ViReal64 *forwardCurrent)
 {
-   ViStatus status = VI_SUCCESS;
-   ViUInt32 retCnt = 0;
-   ViUInt16 stb;
-   ViString command[] = {":VMOD:MIN?", ":VMOD:MAX?", ":VMOD:SET?"};
+   ViStatus  status = VI_SUCCESS;
+   ViString  command[] = {":IFWD:MIN?", ":IFWD:MAX?", ":IFWD:SET?"};
    ViBoolean answer;
-   ViString  format[] = {"%*s %LE", "%LE"};
 
-   if ((status = viGetAttribute (instrumentHandle, VI_ATTR_USER_DATA, &answer)) < 0) return status;
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   if ((status = Pro8_GetAnswer (instrumentHandle, &answer)) < 0) return Pro8_Unlock (instrumentHandle, status);
    //Check input parameter ranges
-   if (Pro8_invalidViInt16Range (value, 0, 2)) return VI_ERROR_PARAMETER2;
-   //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, command[value], StringLength (command[value]), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format[answer], modulationVoltage)) < 0) return status;
+   if (Pro8_invalidViInt16Range (value, 0, 3)) return Pro8_Unlock (instrumentHandle, VI_ERROR_PARAMETER2);
+   //Shadow model or Writing - Poll STB - Check EAV Bit and read error - Reading
+   if ((status = Pro8_ShadowReal (instrumentHandle, command[value], answer, forwardCurrent)) < 0) return Pro8_Unlock (instrumentHandle, status);
    //Ready
-   return status;
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
+//---------------------------------------------------------------------------
+// Function: Get Forward Voltage
+// Purpose:  This function returns the photo diode forward voltage
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_PdaGetFwdVoltage (ViSession instrumentHandle, ViReal64 *forwardVoltage)
+{
+   ViStatus status    = VI_SUCCESS;
+   ViUInt32 retCnt    = 0;
+   ViUInt16 stb;
+   ViBoolean answer;
+
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   if ((status = Pro8_GetAnswer (instrumentHandle, &answer)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Writing - Poll STB - Check EAV Bit and read error - Reading
+   if ((status = Pro8_Write (instrumentHandle, ":VFWD:ACT?", 10, &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
+   if ((status = Pro8_ReadReal (instrumentHandle, answer, forwardVoltage)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Ready
+   return Pro8_Unlock (instrumentHandle, status);
+}
 
 //===========================================================================
-// WDM-DIR MODULE FUNCTIONS
+// LS MODULE FUNCTIONS
 //===========================================================================
 //---------------------------------------------------------------------------
 // Function: Set Laser Output
 // Purpose:  This function switches the output on or off
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmDirSetOutput (ViSession instrumentHandle, ViInt16 output)
+ViStatus _VI_FUNC Pro8_LsSetOutput (ViSession instrumentHandle, ViInt16 output)
 {
    return Pro8_LdcSetLdOutput (instrumentHandle, output);
 }
@@ -4505,262 +6365,287 @@ ViStatus _VI_FUNC Pro8_WdmDirSetOutput (ViSession instrumentHandle, ViInt16 outp
 // Function: Get Laser Output
 // Purpose:  This function returns the state of the output
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmDirGetOutput (ViSession instrumentHandle, ViInt16 *output)
+ViStatus _VI_FUNC Pro8_LsGetOutput (ViSession instrumentHandle, ViInt16 *output)
 {
    return Pro8_LdcGetLdOutput (instrumentHandle, output);
 }
 
 //---------------------------------------------------------------------------
-// Function: Set Coherence Control
-// Purpose:  This function switches the coherence control on or off
+// Function: Set Laser Power
+// Purpose:  This function sets the laser power (dBm)
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmDirSetCohCtrl (ViSession instrumentHandle, ViInt16 coherence)
+ViStatus _VI_FUNC Pro8_LsSetPowerdBm (ViSession instrumentHandle, ViReal64 power)
 {
-   return Pro8_WdmEaSetCohCtrl (instrumentHandle, coherence);
+   ViStatus status = VI_SUCCESS;
+   ViUInt32 retCnt = 0;
+   ViUInt16 stb;
+   ViChar   buffer[CMD_BUF_SIZE];
+
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   //Formatting
+   Pro8_Fmt (buffer, ":P_DBM:SET %f", power);
+   //Writing - Poll STB - Check EAV Bit and read error
+   if ((status = Pro8_Write (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
+   //Ready
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get Coherence Control
-// Purpose:  This function returns the state of the coherence control
+// Function: Get Laser Power
+// Purpose:  This function returns the laser power (dBm)
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmDirGetCohCtrl (ViSession instrumentHandle, ViInt16 *coherence)
+ViStatus _VI_FUNC Pro8_LsGetPowerdBm (ViSession instrumentHandle, ViInt16 value, ViReal64 *power)
 {
-   return Pro8_WdmEaGetCohCtrl (instrumentHandle, coherence);
+   ViStatus  status = VI_SUCCESS;
+   ViString  command[] = {":P_DBM:MIN?", ":P_DBM:MAX?", ":P_DBM:SET?"};
+   ViBoolean answer;
+
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   if ((status = Pro8_GetAnswer (instrumentHandle, &answer)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Check input parameter ranges
+   if (Pro8_invalidViInt16Range (value, 0, 2)) return Pro8_Unlock (instrumentHandle, VI_ERROR_PARAMETER2);
+   //Shadow model or Writing - Poll STB - Check EAV Bit and read error - Reading
+   if ((status = Pro8_ShadowReal (instrumentHandle, command[value], answer, power)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Ready
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
-// Function: Set Modulation
-// Purpose:  This function switches the modulation on or off
+// Function: Set Laser Power
+// Purpose:  This function sets the laser power (W)
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmDirSetModulation (ViSession instrumentHandle, ViInt16 modulation)
+ViStatus _VI_FUNC Pro8_LsSetPowerW (ViSession instrumentHandle, ViReal64 power)
 {
-   ViStatus status    = VI_SUCCESS;
-   ViUInt32 retCnt    = 0;
+   ViStatus status = VI_SUCCESS;
+   ViUInt32 retCnt = 0;
    ViUInt16 stb;
-   ViString command[] = {":MOD OFF", ":MOD ON"};
+   ViChar   buffer[CMD_BUF_SIZE];
 
-   //Check input parameter ranges
-   if (Pro8_invalidViInt16Range (modulation, 0, 1)) return VI_ERROR_PARAMETER2;
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   //Formatting
+   Pro8_Fmt (buffer, ":P_W:SET %f", power);
    //Writing - Poll STB - Check EAV Bit and read error
-   if ((status = viWrite (instrumentHandle, command[modulation], StringLength (command[modulation]), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
+   if ((status = Pro8_Write (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
    //Ready
-   return status;
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get Modulation
-// Purpose:  This function returns the state of the modulation
+// Function: Get Laser Power
+// Purpose:  This function returns the laser power (W)
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmDirGetModulation (ViSession instrumentHandle, ViInt16 *modulation)
+ViStatus _VI_FUNC Pro8_LsGetPowerW (ViSession instrumentHandle, ViInt16 value, ViReal64 *power)
 {
    ViStatus  status = VI_SUCCESS;
-   ViUInt32  retCnt = 0;
-   ViUInt16  stb;
-   ViChar    buffer[CMD_BUF_SIZE];
+   ViString  command[] = {":P_W:MIN?", ":P_W:MAX?", ":P_W:SET?"};
    ViBoolean answer;
-   ViString  format[] = {"%*s %s", "%s"};
 
-   if ((status = viGetAttribute (instrumentHandle, VI_ATTR_USER_DATA, &answer)) < 0) return status;
-   //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, ":MOD?", 5, &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format[answer], buffer)) < 0) return status;
-   //Evaluate
-   if      (CompareStrings ("OFF", 0, buffer, 0, 0) == 0) *modulation = 0;
-   else if (CompareStrings ("ON",  0, buffer, 0, 0) == 0) *modulation = 1;
-   else status = VI_ERROR_INSTR_INTERPRETING_RESPONSE;
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   if ((status = Pro8_GetAnswer (instrumentHandle, &answer)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Check input parameter ranges
+   if (Pro8_invalidViInt16Range (value, 0, 2)) return Pro8_Unlock (instrumentHandle, VI_ERROR_PARAMETER2);
+   //Shadow model or Writing - Poll STB - Check EAV Bit and read error - Reading
+   if ((status = Pro8_ShadowReal (instrumentHandle, command[value], answer, power)) < 0) return Pro8_Unlock (instrumentHandle, status);
    //Ready
-   return status;
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
-// Function: Set Laser Power
-// Purpose:  This function sets the laser power (dBm)
+// Function: Set Temperature Difference
+// Purpose:  This function sets the temperature difference
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmDirSetPowerdBm (ViSession instrumentHandle, ViReal64 power)
+ViStatus _VI_FUNC Pro8_LsSetTempDiff (ViSession instrumentHandle, ViReal64 temperatureDifference)
 {
-   return Pro8_LsSetPowerdBm (instrumentHandle, power);
-}
+   ViStatus status = VI_SUCCESS;
+   ViUInt32 retCnt = 0;
+   ViUInt16 stb;
+   ViChar   buffer[CMD_BUF_SIZE];
 
-//---------------------------------------------------------------------------
-// Function: Get Laser Power
-// Purpose:  This function returns the laser power (dBm)
-//---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmDirGetPowerdBm (ViSession instrumentHandle, ViInt16 value, ViReal64 *power)
-{
-   return Pro8_LsGetPowerdBm (instrumentHandle, value, power);
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   //Formatting
+   Pro8_Fmt (buffer, ":DTEMP:SET %f", temperatureDifference);
+   //Writing - Poll STB - Check EAV Bit and read error
+   if ((status = Pro8_Write (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
+   //Ready
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get Average Laser Power
-// Purpose:  This function returns the average laser power (dBm)
+// Function: Get Temperature Difference
+// Purpose:  This function returns the temperature difference
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmDirGetAvPowerdBm (ViSession instrumentHandle, ViReal64 *power)
+ViStatus _VI_FUNC Pro8_LsGetTempDifference (ViSession instrumentHandle, ViInt16 value, ViReal64 *temperatureDifference)
 {
-   ViStatus  status = VI_SUCCESS;
-   ViUInt32  retCnt = 0;
-   ViUInt16  stb;
+   ViStatus  status    = VI_SUCCESS;
+   ViString  command[] = {":DTEMP:MIN?", ":DTEMP:MAX?", ":DTEMP:SET?"};
    ViBoolean answer;
-   ViString  format[] = {"%*s %LE", "%LE"};
 
-   if ((status = viGetAttribute (instrumentHandle, VI_ATTR_USER_DATA, &answer)) < 0) return status;
-   //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, ":PAV_DBM:ACT?", 13, &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format[answer], power)) < 0) return status;
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   if ((status = Pro8_GetAnswer (instrumentHandle, &answer)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Check input parameter ranges
+   if (Pro8_invalidViInt16Range (value, 0, 2)) return Pro8_Unlock (instrumentHandle, VI_ERROR_PARAMETER2);
+   //Shadow model or Writing - Poll STB - Check EAV Bit and read error - Reading
+   if ((status = Pro8_ShadowReal (instrumentHandle, command[value], answer, temperatureDifference)) < 0) return Pro8_Unlock (instrumentHandle, status);
    //Ready
-   return status;
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
-// Function: Set Laser Power
-// Purpose:  This function sets the laser power (W)
+// Function: Set Synchronous Modulation
+// Purpose:  This function switches the sync. modulation on and off
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmDirSetPowerW (ViSession instrumentHandle, ViReal64 power)
+ViStatus _VI_FUNC Pro8_LsSetSyncMod (ViSession instrumentHandle, ViInt16 synchronousModulation)
 {
-   return Pro8_LsSetPowerW (instrumentHandle, power);
-}
+   ViStatus status    = VI_SUCCESS;
+   ViUInt32 retCnt    = 0;
+   ViUInt16 stb;
+   ViString command[] = {":SYNCMOD OFF", ":SYNCMOD ON"};
 
-//---------------------------------------------------------------------------
-// Function: Get Laser Power
-// Purpose:  This function returns the laser power (W)
-//---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmDirGetPowerW (ViSession instrumentHandle, ViInt16 value, ViReal64 *power)
-{
-   return Pro8_LsGetPowerW (instrumentHandle, value, power);
+   //Check input parameter ranges
+   if (Pro8_invalidViInt16Range (synchronousModulation, 0, 1)) return VI_ERROR_PARAMETER2;
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   //Writing - Poll STB - Check EAV Bit and read error
+   if ((status = Pro8_Write (instrumentHandle, command[synchronousModulation], StringLength (command[synchronousModulation]), &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
+   //Ready
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get Average Laser Power
-// Purpose:  This function returns the average laser power (W)
+// Function: Get Synchronous Modulation
+// Purpose:  This function retuns the state of the sync. modulation
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmDirGetAvPowerW (ViSession instrumentHandle, ViReal64 *power)
+ViStatus _VI_FUNC Pro8_LsGetSyncMod (ViSession instrumentHandle, ViInt16 *synchronousModulation)
 {
    ViStatus  status = VI_SUCCESS;
-   ViUInt32  retCnt = 0;
-   ViUInt16  stb;
+   ViChar    buffer[CMD_BUF_SIZE];
    ViBoolean answer;
-   ViString  format[] = {"%*s %LE", "%LE"};
 
-   if ((status = viGetAttribute (instrumentHandle, VI_ATTR_USER_DATA, &answer)) < 0) return status;
-   //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, ":PAV_W:ACT?", 11, &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format[answer], power)) < 0) return status;
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   if ((status = Pro8_GetAnswer (instrumentHandle, &answer)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Shadow model or Writing - Poll STB - Check EAV Bit and read error - Reading
+   if ((status = Pro8_ShadowQuery (instrumentHandle, ":SYNCMOD?", answer, buffer, sizeof (buffer))) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Evaluate
+   if      (CompareStrings ("OFF", 0, buffer, 0, 0) == 0) *synchronousModulation = 0;
+   else if (CompareStrings ("ON",  0, buffer, 0, 0) == 0) *synchronousModulation = 1;
+   else status = VI_ERROR_INSTR_INTERPRETING_RESPONSE;
    //Ready
-   return status;
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
-//---------------------------------------------------------------------------
-// Function: Set Wavelength
-// Purpose:  This function sets the wavelength
-//---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmDirSetWavelength (ViSession instrumentHandle, ViReal64 wavelength)
-{
-   return Pro8_WdmCwSetWavelength (instrumentHandle, wavelength);
-}
 
-//---------------------------------------------------------------------------
-// Function: Get Wavelength
-// Purpose:  This function returns the wavelength
-//---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmDirGetWavelength (ViSession instrumentHandle, ViInt16 value, ViReal64 *wavelength)
-{
-   return Pro8_WdmCwGetWavelength (instrumentHandle, value, wavelength);
-}
 
+//===========================================================================
+// SLED MODULE FUNCTIONS
+//===========================================================================
 //---------------------------------------------------------------------------
-// Function: Set Threshold Voltage
-// Purpose:  This function sets the threshold voltage
+// Function: Set LED Output
+// Purpose:  This function switches the output on or off
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmDirSetThreshold (ViSession instrumentHandle, ViReal64 thresholdVoltage)
+ViStatus _VI_FUNC Pro8_SledSetOutput (ViSession instrumentHandle, ViInt16 output)
 {
-   return Pro8_WdmEaSetThreshold (instrumentHandle, thresholdVoltage);
-}
+   ViStatus status    = VI_SUCCESS;
+   ViUInt32 retCnt    = 0;
+   ViUInt16 stb;
+   ViString command[] = {":LED OFF", ":LED ON"};
 
-//---------------------------------------------------------------------------
-// Function: Get Threshold Voltage
-// Purpose:  This function returns the threshold voltage
-//---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmDirGetThreshold (ViSession instrumentHandle, ViInt16 value, ViReal64 *thresholdVoltage)
-{
-   return Pro8_WdmEaGetThreshold (instrumentHandle, value, thresholdVoltage);
+   //Check input parameter ranges
+   if (Pro8_invalidViInt16Range (output, 0, 1)) return VI_ERROR_PARAMETER2;
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   //Writing - Poll STB - Check EAV Bit and read error
+   if ((status = Pro8_Write (instrumentHandle, command[output], StringLength (command[output]), &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
+   //Ready
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
-// Function: Set Modulation Current
-// Purpose:  This function sets the modulation current
+// Function: Get Laser Output
+// Purpose:  This function returns the state of the output
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmDirSetModCurrent (ViSession instrumentHandle, ViReal64 modulationCurrent)
+ViStatus _VI_FUNC Pro8_SledGetOutput (ViSession instrumentHandle, ViInt16 *output)
 {
    ViStatus status = VI_SUCCESS;
    ViUInt32 retCnt = 0;
    ViUInt16 stb;
    ViChar   buffer[CMD_BUF_SIZE];
+   ViBoolean answer;
+   ViString  format[] = {"%*s %s", "%s"};
 
-   //Formatting
-   Fmt (buffer, ":CMOD:SET %f", modulationCurrent);
-   //Writing - Poll STB - Check EAV Bit and read error
-   if ((status = viWrite (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   if ((status = Pro8_GetAnswer (instrumentHandle, &answer)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Writing - Poll STB - Check EAV Bit and read error - Reading
+   if ((status = Pro8_Write (instrumentHandle, ":LED?", 5, &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
+   if ((status = Pro8_Scanf (instrumentHandle, format[answer], buffer)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Evaluate
+   if      (CompareStrings ("OFF", 0, buffer, 0, 0) == 0) *output = 0;
+   else if (CompareStrings ("ON",  0, buffer, 0, 0) == 0) *output = 1;
+   else status = VI_ERROR_INSTR_INTERPRETING_RESPONSE;
    //Ready
-   return status;
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get Modulation Current
-// Purpose:  This function returns the modulation current
+// Function: Set Laser Power
+// Purpose:  This function sets the laser power (dBm)
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmDirGetModCurrent (ViSession instrumentHandle, ViInt16 value, ViReal64 *modulationCurrent)
+ViStatus _VI_FUNC Pro8_SledSetPowerdBm (ViSession instrumentHandle, ViReal64 power)
 {
-   ViStatus status = VI_SUCCESS;
-   ViUInt32 retCnt = 0;
-   ViUInt16 stb;
-   ViString command[] = {":CMOD:MIN?", ":CMOD:MAX?", ":CMOD:SET?"};
-   ViBoolean answer;
-   ViString  format[] = {"%*s %LE", "%LE"};
+   return Pro8_LsSetPowerdBm (instrumentHandle, power);
+}
 
-   if ((status = viGetAttribute (instrumentHandle, VI_ATTR_USER_DATA, &answer)) < 0) return status;
-   //Check input parameter ranges
-   if (Pro8_invalidViInt16Range (value, 0, 2)) return VI_ERROR_PARAMETER2;
-   //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, command[value], StringLength (command[value]), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format[answer], modulationCurrent)) < 0) return status;
-   //Ready
-   return status;
+//---------------------------------------------------------------------------
+// Function: Get Laser Power
+// Purpose:  This function returns the laser power (dBm)
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_SledGetPowerdBm (ViSession instrumentHandle, ViInt16 value, ViReal64 *power)
+{
+   return Pro8_LsGetPowerdBm (instrumentHandle, value, power);
 }
 
 //---------------------------------------------------------------------------
-// Function: Set Frequency
-// Purpose:  This function sets the frequency
+// Function: Set Laser Power
+// Purpose:  This function sets the laser power (W)
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmDirSetFrequency (ViSession instrumentHandle, ViReal64 frequency)
+ViStatus _VI_FUNC Pro8_SledSetPowerW (ViSession instrumentHandle, ViReal64 power)
 {
-   return Pro8_WdmCwSetFrequency (instrumentHandle, frequency);
+   return Pro8_LsSetPowerW (instrumentHandle, power);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get Frequency
-// Purpose:  This function returns the frequency
+// Function: Get Laser Power
+// Purpose:  This function returns the laser power (W)
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmDirGetFrequency (ViSession instrumentHandle, ViInt16 value, ViReal64 *frequency)
+ViStatus _VI_FUNC Pro8_SledGetPowerW (ViSession instrumentHandle, ViInt16 value, ViReal64 *power)
 {
-   return Pro8_WdmCwGetFrequency (instrumentHandle, value, frequency);
+   return Pro8_LsGetPowerW (instrumentHandle, value, power);
 }
 
 //---------------------------------------------------------------------------
 // Function: Set Synchronous Modulation
 // Purpose:  This function switches the sync. modulation on and off
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmDirSetSyncMod (ViSession instrumentHandle, ViInt16 synchronousModulation)
+ViStatus _VI_FUNC Pro8_SledSetSyncMod (ViSession instrumentHandle, ViInt16 synchronousModulation)
 {
    return Pro8_LsSetSyncMod (instrumentHandle, synchronousModulation);
 }
@@ -4769,268 +6654,206 @@ ViStatus _VI_FUNC Pro8_WdmDirSetSyncMod (ViSession instrumentHandle, ViInt16 syn
 // Function: Get Synchronous Modulation
 // Purpose:  This function retuns the state of the sync. modulation
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmDirGetSyncMod (ViSession instrumentHandle, ViInt16 *synchronousModulation)
+ViStatus _VI_FUNC Pro8_SledGetSyncMod (ViSession instrumentHandle, ViInt16 *synchronousModulation)
 {
    return Pro8_LsGetSyncMod (instrumentHandle, synchronousModulation);
 }
 
+
+//===========================================================================
+// WDM-CW MODULE FUNCTIONS
+//===========================================================================
 //---------------------------------------------------------------------------
-// Function: Set LF Modulation
-// Purpose:  This function switches the LF modulation on and off
+// Function: Set Laser Output
+// Purpose:  This function switches the output on or off
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmDirSetLfMod (ViSession instrumentHandle, ViInt16 LFModulation)
+ViStatus _VI_FUNC Pro8_WdmCwSetOutput (ViSession instrumentHandle, ViInt16 output)
 {
-   return Pro8_WdmCwSetLfMod (instrumentHandle, LFModulation);
+   return Pro8_LdcSetLdOutput (instrumentHandle, output);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get LF Modulation
-// Purpose:  This function retuns the state of the LF modulation
+// Function: Get Laser Output
+// Purpose:  This function returns the state of the output
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmDirGetLfMod (ViSession instrumentHandle, ViInt16 *LFModulation)
+ViStatus _VI_FUNC Pro8_WdmCwGetOutput (ViSession instrumentHandle, ViInt16 *output)
 {
-   return Pro8_WdmCwGetLfMod (instrumentHandle, LFModulation);
+   return Pro8_LdcGetLdOutput (instrumentHandle, output);
 }
 
 //---------------------------------------------------------------------------
-// Function: Set LF Modulation Type
-// Purpose:  This function switches the LF modulation type
+// Function: Set Laser Power
+// Purpose:  This function sets the laser power (dBm)
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmDirSetLfModType (ViSession instrumentHandle, ViInt16 LFModulationType)
+ViStatus _VI_FUNC Pro8_WdmCwSetPowerdBm (ViSession instrumentHandle, ViReal64 power)
 {
-   return Pro8_WdmCwSetLfModType (instrumentHandle, LFModulationType);
+   return Pro8_LsSetPowerdBm (instrumentHandle, power);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get LF Modulation Type
-// Purpose:  This function retuns the type of LF modulation
+// Function: Get Laser Power
+// Purpose:  This function returns the laser power (dBm)
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmDirGetLfModType (ViSession instrumentHandle, ViInt16 *LFModulationType)
+ViStatus _VI_FUNC Pro8_WdmCwGetPowerdBm (ViSession instrumentHandle, ViInt16 value, ViReal64 *power)
 {
-   return Pro8_WdmCwGetLfModType (instrumentHandle, LFModulationType);
+   return Pro8_LsGetPowerdBm (instrumentHandle, value, power);
 }
 
 //---------------------------------------------------------------------------
-// Function: Set LF Modulation Amplitude
-// Purpose:  This function sets the LF modulation amplitude
+// Function: Set Laser Power
+// Purpose:  This function sets the laser power (W)
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmDirSetLfAmplitude (ViSession instrumentHandle, ViReal64 LFAmplitude)
+ViStatus _VI_FUNC Pro8_WdmCwSetPowerW (ViSession instrumentHandle, ViReal64 power)
 {
-   return Pro8_WdmCwSetLfAmplitude (instrumentHandle, LFAmplitude);
+   return Pro8_LsSetPowerW (instrumentHandle, power);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get LF Modulation Amplitude
-// Purpose:  This function returns the LF modulation amplitude
+// Function: Get Laser Power
+// Purpose:  This function returns the laser power (W)
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmDirGetLfAmplitude (ViSession instrumentHandle, ViInt16 value, ViReal64 *LFAmplitude)
+ViStatus _VI_FUNC Pro8_WdmCwGetPowerW (ViSession instrumentHandle, ViInt16 value, ViReal64 *power)
 {
-   return Pro8_WdmCwGetLfAmplitude (instrumentHandle, value, LFAmplitude);
+   return Pro8_LsGetPowerW (instrumentHandle, value, power);
 }
 
 //---------------------------------------------------------------------------
-// Function: Set LF Modulation Frequency
-// Purpose:  This function sets the LF modulation frequency
+// Function: Set Coherence Control Ration
+// Purpose:  This function sets the coherence control ratio
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmDirSetLfFrequency (ViSession instrumentHandle, ViReal64 LFFrequency)
+ViStatus _VI_FUNC Pro8_WdmCwSetCoherence (ViSession instrumentHandle, ViReal64 coherence)
 {
-   return Pro8_WdmCwSetLfFrequency (instrumentHandle, LFFrequency);
+   ViStatus status = VI_SUCCESS;
+   ViUInt32 retCnt = 0;
+   ViUInt16 stb;
+   ViChar   buffer[CMD_BUF_SIZE];
+
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   //Formatting
+   Pro8_Fmt (buffer, ":COHERENCE:SET %f", coherence);
+   //Writing - Poll STB - Check EAV Bit and read error
+   if ((status = Pro8_Write (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
+   //Ready
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get LF Modulation Frequency
-// Purpose:  This function returns the LF modulation frequency
-//---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmDirGetLfFrequency (ViSession instrumentHandle, ViInt16 value, ViReal64 *LFFrequency)
-{
-   return Pro8_WdmEaGetLfFrequency (instrumentHandle, value, LFFrequency);
-}
-
-//---------------------------------------------------------------------------
-// Function: Set HF Modulation Amplitude
-// Purpose:  This function sets the HF modulation amplitude
-//---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmDirSetHfAmplitude (ViSession instrumentHandle, ViReal64 HFAmplitude)
-{
-   return Pro8_WdmEaSetHfAmplitude (instrumentHandle, HFAmplitude);
-}
-
-//---------------------------------------------------------------------------
-// Function: Get HF Modulation Amplitude
-// Purpose:  This function returns the HF modulation amplitude
-//---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmDirGetHfAmplitude (ViSession instrumentHandle, ViInt16 value, ViReal64 *LFAmplitude)
-{
-   return Pro8_WdmEaGetHfAmplitude (instrumentHandle, value, LFAmplitude);
-}
-
-//---------------------------------------------------------------------------
-// Function: Set HF Modulation
-// Purpose:  This function switches the HF modulation on and off
-//---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmDirSetHfMod (ViSession instrumentHandle, ViInt16 HFModulation)
-{
-   return Pro8_WdmEaSetHfMod (instrumentHandle, HFModulation);
-}
-
-//---------------------------------------------------------------------------
-// Function: Get HF Modulation
-// Purpose:  This function retuns the state of the HF modulation
-//---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmDirGetHfMod (ViSession instrumentHandle, ViInt16 *HFModulation)
-{
-   return Pro8_WdmEaGetHfMod (instrumentHandle, HFModulation);
-}
-
-
-//===========================================================================
-// WDM-CCDM MODULE FUNCTIONS
-//===========================================================================
-//---------------------------------------------------------------------------
-// Function: Set Laser Output
-// Purpose:  This function switches the output on or off
-//---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmCcdmSetOutput (ViSession instrumentHandle, ViInt16 output)
-{
-   return Pro8_LdcSetLdOutput (instrumentHandle, output);
-}
-
-//---------------------------------------------------------------------------
-// Function: Get Laser Output
-// Purpose:  This function returns the state of the output
-//---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmCcdmGetOutput (ViSession instrumentHandle, ViInt16 *output)
-{
-   return Pro8_LdcGetLdOutput (instrumentHandle, output);
-}
-
-//---------------------------------------------------------------------------
-// Function: Set Laser Power
-// Purpose:  This function sets the laser power (dBm)
-//---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmCcdmSetPowerdBm (ViSession instrumentHandle, ViReal64 power)
-{
-   return Pro8_LsSetPowerdBm (instrumentHandle, power);
-}
-
-//---------------------------------------------------------------------------
-// Function: Get Laser Power
-// Purpose:  This function returns the laser power (dBm)
-//---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmCcdmGetPowerdBm (ViSession instrumentHandle, ViInt16 value, ViReal64 *power)
-{
-   ViStatus  status    = VI_SUCCESS;
-   ViUInt32  retCnt    = 0;
-   ViUInt16  stb;
-   ViString  command[] = {":P_DBM:MIN?", ":P_DBM:MAX?", ":P_DBM:SET?", ":P_DBM:ACT?"};
-   ViBoolean answer;
-   ViString  format[] = {"%*s %LE", "%LE"};
-
-   if ((status = viGetAttribute (instrumentHandle, VI_ATTR_USER_DATA, &answer)) < 0) return status;
-   //Check input parameter ranges
-   if (Pro8_invalidViInt16Range (value, 0, 3)) return VI_ERROR_PARAMETER2;
-   //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, command[value], StringLength (command[value]), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format[answer], power)) < 0) return status;
-   //Ready
-   return status;
-}
-
-//---------------------------------------------------------------------------
-// Function: Set Laser Power
-// Purpose:  This function sets the laser power (W)
-//---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmCcdmSetPowerW (ViSession instrumentHandle, ViReal64 power)
-{
-   return Pro8_LsSetPowerW (instrumentHandle, power);
-}
-
-//---------------------------------------------------------------------------
-// Function: Get Laser Power
-// Purpose:  This function returns the laser power (W)
+// Function: Get Coherence Control Ration
+// Purpose:  This function returns the coherence control ratio
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmCcdmGetPowerW (ViSession instrumentHandle, ViInt16 value, ViReal64 *power)
+ViStatus _VI_FUNC Pro8_WdmCwGetCoherence (ViSession instrumentHandle, ViInt16 value, ViReal64 *coherence)
 {
    ViStatus  status = VI_SUCCESS;
-   ViUInt32  retCnt = 0;
-   ViUInt16  stb;
-   ViString  command[] = {":P_W:MIN?", ":P_W:MAX?", ":P_W:SET?", ":P_W:ACT?"};
+   ViString  command[] = {":COHERENCE:MIN?", ":COHERENCE:MAX?", ":COHERENCE:SET?"};
    ViBoolean answer;
-   ViString  format[] = {"%*s %LE", "%LE"};
 
-   if ((status = viGetAttribute (instrumentHandle, VI_ATTR_USER_DATA, &answer)) < 0) return status;
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   if ((status = Pro8_GetAnswer (instrumentHandle, &answer)) < 0) return Pro8_Unlock (instrumentHandle, status);
    //Check input parameter ranges
-   if (Pro8_invalidViInt16Range (value, 0, 3)) return VI_ERROR_PARAMETER2;
-   //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, command[value], StringLength (command[value]), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format[answer], power)) < 0) return status;
+   if (Pro8_invalidViInt16Range (value, 0, 2)) return Pro8_Unlock (instrumentHandle, VI_ERROR_PARAMETER2);
+   //Shadow model or Writing - Poll STB - Check EAV Bit and read error - Reading
+   if ((status = Pro8_ShadowReal (instrumentHandle, command[value], answer, coherence)) < 0) return Pro8_Unlock (instrumentHandle, status);
    //Ready
-   return status;
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
 // Function: Set Wavelength
 // Purpose:  This function sets the wavelength
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmCcdmSetWavelength (ViSession instrumentHandle, ViReal64 wavelength)
+ViStatus _VI_FUNC Pro8_WdmCwSetWavelength (ViSession instrumentHandle, ViReal64 wavelength)
 {
-   return Pro8_WdmCwSetWavelength (instrumentHandle, wavelength);
+   ViStatus status = VI_SUCCESS;
+   ViUInt32 retCnt = 0;
+   ViUInt16 stb;
+   ViChar   buffer[CMD_BUF_SIZE];
+
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   //Formatting
+   Pro8_Fmt (buffer, ":LAMBDA:SET %f", wavelength);
+   //Writing - Poll STB - Check EAV Bit and read error
+   if ((status = Pro8_Write (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
+   //Ready
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
 // Function: Get Wavelength
 // Purpose:  This function returns the wavelength
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmCcdmGetWavelength (ViSession instrumentHandle, ViInt16 value, ViReal64 *wavelength)
+ViStatus _VI_FUNC Pro8_WdmCwGetWavelength (ViSession instrumentHandle, ViInt16 value, ViReal64 *wavelength)
 {
-   return Pro8_WdmCwGetWavelength (instrumentHandle, value, wavelength);
+   ViStatus  status = VI_SUCCESS;
+   ViString  command[] = {":LAMBDA:MIN?", ":LAMBDA:MAX?", ":LAMBDA:SET?"};
+   ViBoolean answer;
+
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   if ((status = Pro8_GetAnswer (instrumentHandle, &answer)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Check input parameter ranges
+   if (Pro8_invalidViInt16Range (value, 0, 2)) return Pro8_Unlock (instrumentHandle, VI_ERROR_PARAMETER2);
+   //Shadow model or Writing - Poll STB - Check EAV Bit and read error - Reading
+   if ((status = Pro8_ShadowReal (instrumentHandle, command[value], answer, wavelength)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Ready
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
 // Function: Set Frequency
 // Purpose:  This function sets the frequency
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmCcdmSetFrequency (ViSession instrumentHandle, ViReal64 frequency)
+ViStatus _VI_FUNC Pro8_WdmCwSetFrequency (ViSession instrumentHandle, ViReal64 frequency)
 {
-   return Pro8_WdmCwSetFrequency (instrumentHandle, frequency);
+   ViStatus status = VI_SUCCESS;
+   ViUInt32 retCnt = 0;
+   ViUInt16 stb;
+   ViChar   buffer[CMD_BUF_SIZE];
+
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   //Formatting
+   Pro8_Fmt (buffer, ":LASERFREQ:SET %f", frequency);
+   //Writing - Poll STB - Check EAV Bit and read error
+   if ((status = Pro8_Write (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
+   //Ready
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
 // Function: Get Frequency
 // Purpose:  This function returns the frequency
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmCcdmGetFrequency (ViSession instrumentHandle, ViInt16 value, ViReal64 *frequency)
-{
-   return Pro8_WdmCwGetFrequency (instrumentHandle, value, frequency);
-}
-
-//---------------------------------------------------------------------------
-// Function: Set Coherence Control Ration
-// Purpose:  This function sets the coherence control ratio
-//---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmCcdmSetCoherence (ViSession instrumentHandle, ViReal64 coherence)
+ViStatus _VI_FUNC Pro8_WdmCwGetFrequency (ViSession instrumentHandle, ViInt16 value, ViReal64 *frequency)
 {
-   return Pro8_WdmCwSetCoherence (instrumentHandle, coherence);
-}
+   ViStatus  status = VI_SUCCESS;
+   ViString  command[] = {":LASERFREQ:MIN?", ":LASERFREQ:MAX?", ":LASERFREQ:SET?"};
+   ViBoolean answer;
 
-//---------------------------------------------------------------------------
-// Function: Get Coherence Control Ration
-// Purpose:  This function returns the coherence control ratio
-//---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmCcdmGetCoherence (ViSession instrumentHandle, ViInt16 value, ViReal64 *coherence)
-{
-   return Pro8_WdmCwGetCoherence (instrumentHandle, value, coherence);
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   if ((status = Pro8_GetAnswer (instrumentHandle, &answer)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Check input parameter ranges
+   if (Pro8_invalidViInt16Range (value, 0, 2)) return Pro8_Unlock (instrumentHandle, VI_ERROR_PARAMETER2);
+   //Shadow model or Writing - Poll STB - Check EAV Bit and read error - Reading
+   if ((status = Pro8_ShadowReal (instrumentHandle, command[value], answer, frequency)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Ready
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
 // Function: Set Synchronous Modulation
 // Purpose:  This function switches the sync. modulation on and off
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmCcdmSetSyncMod (ViSession instrumentHandle, ViInt16 synchronousModulation)
+ViStatus _VI_FUNC Pro8_WdmCwSetSyncMod (ViSession instrumentHandle, ViInt16 synchronousModulation)
 {
    return Pro8_LsSetSyncMod (instrumentHandle, synchronousModulation);
 }
@@ -5039,7 +6862,7 @@ ViStatus _VI_FUNC Pro8_WdmCcdmSetSyncMod (ViSession instrumentHandle, ViInt16 sy
 // Function: Get Synchronous Modulation
 // Purpose:  This function retuns the state of the sync. modulation
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmCcdmGetSyncMod (ViSession instrumentHandle, ViInt16 *synchronousModulation)
+ViStatus _VI_FUNC Pro8_WdmCwGetSyncMod (ViSession instrumentHandle, ViInt16 *synchronousModulation)
 {
    return Pro8_LsGetSyncMod (instrumentHandle, synchronousModulation);
 }
@@ -5048,200 +6871,280 @@ ViStatus _VI_FUNC Pro8_WdmCcdmGetSyncMod (ViSession instrumentHandle, ViInt16 *s
 // Function: Set LF Modulation
 // Purpose:  This function switches the LF modulation on and off
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmCcdmSetLfMod (ViSession instrumentHandle, ViInt16 LFModulation)
+ViStatus _VI_FUNC Pro8_WdmCwSetLfMod (ViSession instrumentHandle, ViInt16 LFModulation)
 {
-   return Pro8_WdmCwSetLfMod (instrumentHandle, LFModulation);
+   ViStatus status    = VI_SUCCESS;
+   ViUInt32 retCnt    = 0;
+   ViUInt16 stb;
+   ViString command[] = {":LFMOD:ENABLE OFF", ":LFMOD:ENABLE ON"};
+
+   //Check input parameter ranges
+   if (Pro8_invalidViInt16Range (LFModulation, 0, 1)) return VI_ERROR_PARAMETER2;
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   //Writing - Poll STB - Check EAV Bit and read error
+   if ((status = Pro8_Write (instrumentHandle, command[LFModulation], StringLength (command[LFModulation]), &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
+   //Ready
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
 // Function: Get LF Modulation
 // Purpose:  This function retuns the state of the LF modulation
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmCcdmGetLfMod (ViSession instrumentHandle, ViInt16 *LFModulation)
+ViStatus _VI_FUNC Pro8_WdmCwGetLfMod (ViSession instrumentHandle, ViInt16 *LFModulation)
 {
-   return Pro8_WdmCwGetLfMod (instrumentHandle, LFModulation);
+   ViStatus status = VI_SUCCESS;
+   ViChar   buffer[CMD_BUF_SIZE];
+   ViBoolean answer;
+
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   if ((status = Pro8_GetAnswer (instrumentHandle, &answer)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Shadow model or Writing - Poll STB - Check EAV Bit and read error - Reading
+   if ((status = Pro8_ShadowQuery (instrumentHandle, ":LFMOD:ENABLE?", answer, buffer, sizeof (buffer))) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Evaluate
+   if      (CompareStrings ("OFF", 0, buffer, 0, 0) == 0) *LFModulation = 0;
+   else if (CompareStrings ("ON",  0, buffer, 0, 0) == 0) *LFModulation = 1;
+   else status = VI_ERROR_INSTR_INTERPRETING_RESPONSE;
+   //Ready
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
 // Function: Set LF Modulation Type
 // Purpose:  This function switches the LF modulation type
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmCcdmSetLfModType (ViSession instrumentHandle, ViInt16 LFModulationType)
+ViStatus _VI_FUNC Pro8_WdmCwSetLfModType (ViSession instrumentHandle, ViInt16 LFModulationType)
 {
-   return Pro8_WdmCwSetLfModType (instrumentHandle, LFModulationType);
+   ViStatus status    = VI_SUCCESS;
+   ViUInt32 retCnt    = 0;
+   ViUInt16 stb;
+   ViString command[] = {":LFMOD:TYPE NOISE", ":LFMOD:TYPE PULSE", ":LFMOD:TYPE SINE", ":LFMOD:TYPE SQUARE", ":LFMOD:TYPE TRIANGLE"};
+
+   //Check input parameter ranges
+   if (Pro8_invalidViInt16Range (LFModulationType, 0, 4)) return VI_ERROR_PARAMETER2;
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   //Writing - Poll STB - Check EAV Bit and read error
+   if ((status = Pro8_Write (instrumentHandle, command[LFModulationType], StringLength (command[LFModulationType]), &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
+   //Ready
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
 // Function: Get LF Modulation Type
 // Purpose:  This function retuns the type of LF modulation
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmCcdmGetLfModType (ViSession instrumentHandle, ViInt16 *LFModulationType)
+ViStatus _VI_FUNC Pro8_WdmCwGetLfModType (ViSession instrumentHandle, ViInt16 *LFModulationType)
 {
-   return Pro8_WdmCwGetLfModType (instrumentHandle, LFModulationType);
+   ViStatus status = VI_SUCCESS;
+   ViChar   buffer[CMD_BUF_SIZE];
+   ViBoolean answer;
+
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   if ((status = Pro8_GetAnswer (instrumentHandle, &answer)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Shadow model or Writing - Poll STB - Check EAV Bit and read error - Reading
+   if ((status = Pro8_ShadowQuery (instrumentHandle, ":LFMOD:TYPE?", answer, buffer, sizeof (buffer))) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Evaluate
+   if      (CompareStrings ("NOISE",    0, buffer, 0, 0) == 0) *LFModulationType = 0;
+   else if (CompareStrings ("PULSE",    0, buffer, 0, 0) == 0) *LFModulationType = 1;
+   else if (CompareStrings ("SINE" ,    0, buffer, 0, 0) == 0) *LFModulationType = 2;
+   else if (CompareStrings ("SQUARE",   0, buffer, 0, 0) == 0) *LFModulationType = 3;
+   else if (CompareStrings ("TRIANGLE", 0, buffer, 0, 0) == 0) *LFModulationType = 4;
+   else status = VI_ERROR_INSTR_INTERPRETING_RESPONSE;
+   //Ready
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
 // Function: Set LF Modulation Amplitude
 // Purpose:  This function sets the LF modulation amplitude
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmCcdmSetLfAmplitude (ViSession instrumentHandle, ViReal64 LFAmplitude)
+ViStatus _VI_FUNC Pro8_WdmCwSetLfAmplitude (ViSession instrumentHandle, ViReal64 LFAmplitude)
 {
-   return Pro8_WdmCwSetLfAmplitude (instrumentHandle, LFAmplitude);
+   ViStatus status = VI_SUCCESS;
+   ViUInt32 retCnt = 0;
+   ViUInt16 stb;
+   ViChar   buffer[CMD_BUF_SIZE];
+
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   //Formatting
+   Pro8_Fmt (buffer, ":LFAMP:SET %f", LFAmplitude);
+   //Writing - Poll STB - Check EAV Bit and read error
+   if ((status = Pro8_Write (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
+   //Ready
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
 // Function: Get LF Modulation Amplitude
 // Purpose:  This function returns the LF modulation amplitude
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmCcdmGetLfAmplitude (ViSession instrumentHandle, ViInt16 value, ViReal64 *LFAmplitude)
+ViStatus _VI_FUNC Pro8_WdmCwGetLfAmplitude (ViSession instrumentHandle, ViInt16 value, ViReal64 *LFAmplitude)
 {
-   return Pro8_WdmCwGetLfAmplitude (instrumentHandle, value, LFAmplitude);
+   ViStatus  status = VI_SUCCESS;
+   ViString  command[] = {":LFAMP:MIN?", ":LFAMP:MAX?", ":LFAMP:SET?"};
+   ViBoolean answer;
+
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   if ((status = Pro8_GetAnswer (instrumentHandle, &answer)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Check input parameter ranges
+   if (Pro8_invalidViInt16Range (value, 0, 2)) return Pro8_Unlock (instrumentHandle, VI_ERROR_PARAMETER2);
+   //Shadow model or Writing - Poll STB - Check EAV Bit and read error - Reading
+   if ((status = Pro8_ShadowReal (instrumentHandle, command[value], answer, LFAmplitude)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Ready
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
 // Function: Set LF Modulation Frequency
 // Purpose:  This function sets the LF modulation frequency
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmCcdmSetLfFrequency (ViSession instrumentHandle, ViReal64 LFFrequency)
+ViStatus _VI_FUNC Pro8_WdmCwSetLfFrequency (ViSession instrumentHandle, ViReal64 LFFrequency)
 {
-   return Pro8_WdmCwSetLfFrequency (instrumentHandle, LFFrequency);
-}
+   ViStatus status = VI_SUCCESS;
+   ViUInt32 retCnt = 0;
+   ViUInt16 stb;
+   ViChar   buffer[CMD_BUF_SIZE];
 
-//---------------------------------------------------------------------------
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   //Formatting
+   Pro8_Fmt (buffer, ":LFFREQ:SET %f", LFFrequency);
+   //Writing - Poll STB - Check EAV Bit and read error
+   if ((status = Pro8_Write (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
+   //Ready
+   return Pro8_Unlock (instrumentHandle, status);
+}
+
+//---------------------------------------------------------------------------
 // Function: Get LF Modulation Frequency
 // Purpose:  This function returns the LF modulation frequency
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmCcdmGetLfFrequency (ViSession instrumentHandle, ViInt16 value, ViReal64 *LFFrequency)
+ViStatus _VI_FUNC Pro8_WdmCwGetLfFrequency (ViSession instrumentHandle, ViInt16 value, ViReal64 *LFFrequency)
 {
-   return Pro8_WdmEaGetLfFrequency (instrumentHandle, value, LFFrequency);
+   ViStatus  status = VI_SUCCESS;
+   ViString  command[] = {":LFFREQ:MIN?", ":LFFREQ:MAX?", ":LFFREQ:SET?"};
+   ViBoolean answer;
+
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   if ((status = Pro8_GetAnswer (instrumentHandle, &answer)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Check input parameter ranges
+   if (Pro8_invalidViInt16Range (value, 0, 2)) return Pro8_Unlock (instrumentHandle, VI_ERROR_PARAMETER2);
+   //Shadow model or Writing - Poll STB - Check EAV Bit and read error - Reading
+   if ((status = Pro8_ShadowReal (instrumentHandle, command[value], answer, LFFrequency)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Ready
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
 // Function: Get max HF Modulation Voltage
 // Purpose:  This function returns the maximum HF modulation voltage
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmCcdmGetMaxHfVoltage (ViSession instrumentHandle, ViReal64 *maxHF_modVoltage)
+ViStatus _VI_FUNC Pro8_WdmCwGetMaxHfVoltage (ViSession instrumentHandle, ViReal64 *maxHF_modVoltage)
 {
-   return Pro8_WdmCwGetMaxHfVoltage (instrumentHandle, maxHF_modVoltage);
-}
+   ViStatus  status = VI_SUCCESS;
+   ViUInt32  retCnt = 0;
+   ViUInt16  stb;
+   ViBoolean answer;
 
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   if ((status = Pro8_GetAnswer (instrumentHandle, &answer)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Writing - Poll STB - Check EAV Bit and read error - Reading
+   if ((status = Pro8_Write (instrumentHandle, ":VHFMAX:ACT?", 12, &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
+   if ((status = Pro8_ReadReal (instrumentHandle, answer, maxHF_modVoltage)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Ready
+   return Pro8_Unlock (instrumentHandle, status);
+}
 
 //===========================================================================
-// WDM-CWDM Functions
+// WDM-EA MODULE FUNCTIONS
 //===========================================================================
 //---------------------------------------------------------------------------
-// Function: Set Laser Output
-// Purpose:  This function switches the output on or off
-//---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmCwdmSetOutput (ViSession instrumentHandle, ViInt16 output)
-{
-   return Pro8_LdcSetLdOutput (instrumentHandle, output);
-}
-
-//---------------------------------------------------------------------------
-// Function: Get Laser Output
-// Purpose:  This function returns the state of the output
-//---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmCwdmGetOutput (ViSession instrumentHandle, ViInt16 *output)
-{
-   return Pro8_LdcGetLdOutput (instrumentHandle, output);
-}
-
-//---------------------------------------------------------------------------
-// Function: Set Synchronous Modulation
-// Purpose:  This function switches the sync. modulation on and off
-//---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmCwdmSetSyncMod (ViSession instrumentHandle, ViInt16 synchronousModulation)
-{
-   return Pro8_LsSetSyncMod (instrumentHandle, synchronousModulation);
-}
-
-//---------------------------------------------------------------------------
-// Function: Get Synchronous Modulation
-// Purpose:  This function retuns the state of the sync. modulation
-//---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmCwdmGetSyncMod (ViSession instrumentHandle, ViInt16 *synchronousModulation)
-{
-   return Pro8_LsGetSyncMod (instrumentHandle, synchronousModulation);
-}
-
-//---------------------------------------------------------------------------
-// Function: Set LF Modulation
-// Purpose:  This function switches the LF modulation on and off
-//---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmCwdmSetLfMod (ViSession instrumentHandle, ViInt16 LFModulation)
-{
-   return Pro8_WdmCwSetLfMod (instrumentHandle, LFModulation);
-}
-
-//---------------------------------------------------------------------------
-// Function: Get LF Modulation
-// Purpose:  This function retuns the state of the LF modulation
-//---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmCwdmGetLfMod (ViSession instrumentHandle, ViInt16 *LFModulation)
-{
-   return Pro8_WdmCwGetLfMod (instrumentHandle, LFModulation);
-}
-
-//---------------------------------------------------------------------------
-// Function: Set LF Modulation Type
-// Purpose:  This function switches the LF modulation type
+// Function: Set Coherence Control
+// Purpose:  This function switches the coherence control on or off
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmCwdmSetLfModType (ViSession instrumentHandle, ViInt16 LFModulationType)
+ViStatus _VI_FUNC Pro8_WdmEaSetCohCtrl (ViSession instrumentHandle, ViInt16 coherence)
 {
-   return Pro8_WdmCwSetLfModType (instrumentHandle, LFModulationType);
-}
+   ViStatus status    = VI_SUCCESS;
+   ViUInt32 retCnt    = 0;
+   ViUInt16 stb;
+   ViString command[] = {":COHCNTL OFF", ":COHCNTL ON"};
 
-//---------------------------------------------------------------------------
-// Function: Get LF Modulation Type
-// Purpose:  This function retuns the type of LF modulation
-//---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmCwdmGetLfModType (ViSession instrumentHandle, ViInt16 *LFModulationType)
-{
-   return Pro8_WdmCwGetLfModType (instrumentHandle, LFModulationType);
+   //Check input parameter ranges
+   if (Pro8_invalidViInt16Range (coherence, 0, 1)) return VI_ERROR_PARAMETER2;
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   //Writing - Poll STB - Check EAV Bit and read error
+   if ((status = Pro8_Write (instrumentHandle, command[coherence], StringLength (command[coherence]), &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
+   //Ready
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
-// Function: Set LF Modulation Amplitude
-// Purpose:  This function sets the LF modulation amplitude
+// Function: Get Coherence Control
+// Purpose:  This function returns the state of the coherence control
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmCwdmSetLfAmplitude (ViSession instrumentHandle, ViReal64 LFAmplitude)
+ViStatus _VI_FUNC Pro8_WdmEaGetCohCtrl (ViSession instrumentHandle, ViInt16 *coherence)
 {
-   return Pro8_WdmCwSetLfAmplitude (instrumentHandle, LFAmplitude);
-}
+   ViStatus  status = VI_SUCCESS;
+   ViChar    buffer[CMD_BUF_SIZE];
+   ViBoolean answer;
 
-//---------------------------------------------------------------------------
-// Function: Get LF Modulation Amplitude
-// Purpose:  This function returns the LF modulation amplitude
-//---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmCwdmGetLfAmplitude (ViSession instrumentHandle, ViInt16 value, ViReal64 *LFAmplitude)
-{
-   return Pro8_WdmCwGetLfAmplitude (instrumentHandle, value, LFAmplitude);
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   if ((status = Pro8_GetAnswer (instrumentHandle, &answer)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Shadow model or Writing - Poll STB - Check EAV Bit and read error - Reading
+   if ((status = Pro8_ShadowQuery (instrumentHandle, ":COHCNTL?", answer, buffer, sizeof (buffer))) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Evaluate
+   if      (CompareStrings ("OFF", 0, buffer, 0, 0) == 0) *coherence = 0;
+   else if (CompareStrings ("ON",  0, buffer, 0, 0) == 0) *coherence = 1;
+   else status = VI_ERROR_INSTR_INTERPRETING_RESPONSE;
+   //Ready
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
-// Function: Set LF Modulation Frequency
-// Purpose:  This function sets the LF modulation frequency
+// Function: Set Laser Output
+// Purpose:  This function switches the output on or off
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmCwdmSetLfFrequency (ViSession instrumentHandle, ViReal64 LFFrequency)
+ViStatus _VI_FUNC Pro8_WdmEaSetOutput (ViSession instrumentHandle, ViInt16 output)
 {
-   return Pro8_WdmCwSetLfFrequency (instrumentHandle, LFFrequency);
+   return Pro8_LdcSetLdOutput (instrumentHandle, output);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get LF Modulation Frequency
-// Purpose:  This function returns the LF modulation frequency
+// Function: Get Laser Output
+// Purpose:  This function returns the state of the output
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmCwdmGetLfFrequency (ViSession instrumentHandle, ViInt16 value, ViReal64 *LFFrequency)
+ViStatus _VI_FUNC Pro8_WdmEaGetOutput (ViSession instrumentHandle, ViInt16 *output)
 {
-   return Pro8_WdmEaGetLfFrequency (instrumentHandle, value, LFFrequency);
+   return Pro8_LdcGetLdOutput (instrumentHandle, output);
 }
 
 //---------------------------------------------------------------------------
 // Function: Set Laser Power
 // Purpose:  This function sets the laser power (dBm)
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmCwdmSetPowerdBm (ViSession instrumentHandle, ViReal64 power)
+ViStatus _VI_FUNC Pro8_WdmEaSetPowerdBm (ViSession instrumentHandle, ViReal64 power)
 {
    return Pro8_LsSetPowerdBm (instrumentHandle, power);
 }
@@ -5250,17 +7153,16 @@ ViStatus _VI_FUNC Pro8_WdmCwdmSetPowerdBm (ViSession instrumentHandle, ViReal64
 // Function: Get Laser Power
 // Purpose:  This function returns the laser power (dBm)
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmCwdmGetPowerdBm (ViSession instrumentHandle, ViInt16 value, ViReal64 *power)
+ViStatus _VI_FUNC Pro8_WdmEaGetPowerdBm (ViSession instrumentHandle, ViInt16 value, ViReal64 *power)
 {
-   if (Pro8_invalidViInt16Range (value, 0, 2)) return VI_ERROR_PARAMETER2;
-   return Pro8_WdmCcdmGetPowerdBm (instrumentHandle, value, power);
+   return Pro8_LsGetPowerdBm (instrumentHandle, value, power);
 }
 
 //---------------------------------------------------------------------------
 // Function: Set Laser Power
 // Purpose:  This function sets the laser power (W)
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmCwdmSetPowerW (ViSession instrumentHandle, ViReal64 power)
+ViStatus _VI_FUNC Pro8_WdmEaSetPowerW (ViSession instrumentHandle, ViReal64 power)
 {
    return Pro8_LsSetPowerW (instrumentHandle, power);
 }
@@ -5269,75 +7171,96 @@ ViStatus _VI_FUNC Pro8_WdmCwdmSetPowerW (ViSession instrumentHandle, ViReal64 po
 // Function: Get Laser Power
 // Purpose:  This function returns the laser power (W)
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmCwdmGetPowerW (ViSession instrumentHandle, ViInt16 value, ViReal64 *power)
+ViStatus _VI_FUNC Pro8_WdmEaGetPowerW (ViSession instrumentHandle, ViInt16 value, ViReal64 *power)
 {
-   if (Pro8_invalidViInt16Range (value, 0, 2)) return VI_ERROR_PARAMETER2;
-   return Pro8_WdmCcdmGetPowerW (instrumentHandle, value, power);
+   return Pro8_LsGetPowerW (instrumentHandle, value, power);
 }
 
 //---------------------------------------------------------------------------
-// Function: Set Temperature Difference
-// Purpose:  This function sets the temperature difference
+// Function: Set Wavelength
+// Purpose:  This function sets the wavelength
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmCwdmSetTempDiff (ViSession instrumentHandle, ViReal64 temperatureDifference)
+ViStatus _VI_FUNC Pro8_WdmEaSetWavelength (ViSession instrumentHandle, ViReal64 wavelength)
 {
-   return Pro8_LsSetTempDiff (instrumentHandle, temperatureDifference);
+   return Pro8_WdmCwSetWavelength (instrumentHandle, wavelength);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get Temperature Difference
-// Purpose:  This function returns the temperature difference
+// Function: Get Wavelength
+// Purpose:  This function returns the wavelength
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmCwdmGetTempDifference (ViSession instrumentHandle, ViInt16 value, ViPReal64 temperatureDifference)
+ViStatus _VI_FUNC Pro8_WdmEaGetWavelength (ViSession instrumentHandle, ViInt16 value, ViReal64 *wavelength)
 {
-   return Pro8_LsGetTempDifference(instrumentHandle, value, temperatureDifference);
+   return Pro8_WdmCwGetWavelength (instrumentHandle, value, wavelength);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get Wavelength
-// Purpose:  This function returns the wavelength
+// Function: Set Threshold Voltage
+// Purpose:  This function sets the threshold voltage
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmCwdmGetWavelength (ViSession instrumentHandle, ViReal64 *wavelength)
+ViStatus _VI_FUNC Pro8_WdmEaSetThreshold (ViSession instrumentHandle, ViReal64 thresholdVoltage)
 {
-   return Pro8_WdmCwGetWavelength (instrumentHandle, 2, wavelength);
+   ViStatus status = VI_SUCCESS;
+   ViUInt32 retCnt = 0;
+   ViUInt16 stb;
+   ViChar   buffer[CMD_BUF_SIZE];
+
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   //Formatting
+   Pro8_Fmt (buffer, ":VTH:SET %f", thresholdVoltage);
+   //Writing - Poll STB - Check EAV Bit and read error
+   if ((status = Pro8_Write (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
+   //Ready
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get Frequency
-// Purpose:  This function returns the frequency
+// Function: Get Threshold Voltage
+// Purpose:  This function returns the threshold voltage
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmCwdmGetFrequency (ViSession instrumentHandle, ViReal64 *frequency)
+ViStatus _VI_FUNC Pro8_WdmEaGetThreshold (ViSession instrumentHandle, ViInt16 value, ViReal64 *thresholdVoltage)
 {
-   return Pro8_WdmCwGetFrequency (instrumentHandle, 2, frequency);
-}
+   ViStatus  status = VI_SUCCESS;
+   ViString  command[] = {":VTH:MIN?", ":VTH:MAX?", ":VTH:SET?"};
+   ViBoolean answer;
 
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   if ((status = Pro8_GetAnswer (instrumentHandle, &answer)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Check input parameter ranges
+   if (Pro8_invalidViInt16Range (value, 0, 2)) return Pro8_Unlock (instrumentHandle, VI_ERROR_PARAMETER2);
+   //Shadow model or Writing - Poll STB - Check EAV Bit and read error - Reading
+   if ((status = Pro8_ShadowReal (instrumentHandle, command[value], answer, thresholdVoltage)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Ready
+   return Pro8_Unlock (instrumentHandle, status);
+}
 
-//===========================================================================
-// WDM-ITC Functions
-//===========================================================================
 //---------------------------------------------------------------------------
-// Function: Set Laser Output
-// Purpose:  This function switches the output on or off
+// Function: Set Frequency
+// Purpose:  This function sets the frequency
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmItcSetOutput (ViSession instrumentHandle, ViInt16 output)
+ViStatus _VI_FUNC Pro8_WdmEaSetFrequency (ViSession instrumentHandle, ViReal64 frequency)
 {
-   return Pro8_LdcSetLdOutput (instrumentHandle, output);
+   return Pro8_WdmCwSetFrequency (instrumentHandle, frequency);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get Laser Output
-// Purpose:  This function returns the state of the output
+// Function: Get Frequency
+// Purpose:  This function returns the frequency
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmItcGetOutput (ViSession instrumentHandle, ViInt16 *output)
+ViStatus _VI_FUNC Pro8_WdmEaGetFrequency (ViSession instrumentHandle, ViInt16 value, ViReal64 *frequency)
 {
-   return Pro8_LdcGetLdOutput (instrumentHandle, output);
+   return Pro8_WdmCwGetFrequency (instrumentHandle, value, frequency);
 }
 
 //---------------------------------------------------------------------------
 // Function: Set Synchronous Modulation
 // Purpose:  This function switches the sync. modulation on and off
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmItcSetSyncMod (ViSession instrumentHandle, ViInt16 synchronousModulation)
+ViStatus _VI_FUNC Pro8_WdmEaSetSyncMod (ViSession instrumentHandle, ViInt16 synchronousModulation)
 {
    return Pro8_LsSetSyncMod (instrumentHandle, synchronousModulation);
 }
@@ -5346,7 +7269,7 @@ ViStatus _VI_FUNC Pro8_WdmItcSetSyncMod (ViSession instrumentHandle, ViInt16 syn
 // Function: Get Synchronous Modulation
 // Purpose:  This function retuns the state of the sync. modulation
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmItcGetSyncMod (ViSession instrumentHandle, ViInt16 *synchronousModulation)
+ViStatus _VI_FUNC Pro8_WdmEaGetSyncMod (ViSession instrumentHandle, ViInt16 *synchronousModulation)
 {
    return Pro8_LsGetSyncMod (instrumentHandle, synchronousModulation);
 }
@@ -5355,7 +7278,7 @@ ViStatus _VI_FUNC Pro8_WdmItcGetSyncMod (ViSession instrumentHandle, ViInt16 *sy
 // Function: Set LF Modulation
 // Purpose:  This function switches the LF modulation on and off
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmItcSetLfMod (ViSession instrumentHandle, ViInt16 LFModulation)
+ViStatus _VI_FUNC Pro8_WdmEaSetLfMod (ViSession instrumentHandle, ViInt16 LFModulation)
 {
    return Pro8_WdmCwSetLfMod (instrumentHandle, LFModulation);
 }
@@ -5364,7 +7287,7 @@ ViStatus _VI_FUNC Pro8_WdmItcSetLfMod (ViSession instrumentHandle, ViInt16 LFMod
 // Function: Get LF Modulation
 // Purpose:  This function retuns the state of the LF modulation
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmItcGetLfMod (ViSession instrumentHandle, ViInt16 *LFModulation)
+ViStatus _VI_FUNC Pro8_WdmEaGetLfMod (ViSession instrumentHandle, ViInt16 *LFModulation)
 {
    return Pro8_WdmCwGetLfMod (instrumentHandle, LFModulation);
 }
@@ -5373,7 +7296,7 @@ ViStatus _VI_FUNC Pro8_WdmItcGetLfMod (ViSession instrumentHandle, ViInt16 *LFMo
 // Function: Set LF Modulation Type
 // Purpose:  This function switches the LF modulation type
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmItcSetLfModType (ViSession instrumentHandle, ViInt16 LFModulationType)
+ViStatus _VI_FUNC Pro8_WdmEaSetLfModType (ViSession instrumentHandle, ViInt16 LFModulationType)
 {
    return Pro8_WdmCwSetLfModType (instrumentHandle, LFModulationType);
 }
@@ -5382,7 +7305,7 @@ ViStatus _VI_FUNC Pro8_WdmItcSetLfModType (ViSession instrumentHandle, ViInt16 L
 // Function: Get LF Modulation Type
 // Purpose:  This function retuns the type of LF modulation
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmItcGetLfModType (ViSession instrumentHandle, ViInt16 *LFModulationType)
+ViStatus _VI_FUNC Pro8_WdmEaGetLfModType (ViSession instrumentHandle, ViInt16 *LFModulationType)
 {
    return Pro8_WdmCwGetLfModType (instrumentHandle, LFModulationType);
 }
@@ -5391,7 +7314,7 @@ ViStatus _VI_FUNC Pro8_WdmItcGetLfModType (ViSession instrumentHandle, ViInt16 *
 // Function: Set LF Modulation Amplitude
 // Purpose:  This function sets the LF modulation amplitude
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmItcSetLfAmplitude (ViSession instrumentHandle, ViReal64 LFAmplitude)
+ViStatus _VI_FUNC Pro8_WdmEaSetLfAmplitude (ViSession instrumentHandle, ViReal64 LFAmplitude)
 {
    return Pro8_WdmCwSetLfAmplitude (instrumentHandle, LFAmplitude);
 }
@@ -5400,7 +7323,7 @@ ViStatus _VI_FUNC Pro8_WdmItcSetLfAmplitude (ViSession instrumentHandle, ViReal6
 // Function: Get LF Modulation Amplitude
 // Purpose:  This function returns the LF modulation amplitude
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmItcGetLfAmplitude (ViSession instrumentHandle, ViInt16 value, ViReal64 *LFAmplitude)
+ViStatus _VI_FUNC Pro8_WdmEaGetLfAmplitude (ViSession instrumentHandle, ViInt16 value, ViReal64 *LFAmplitude)
 {
    return Pro8_WdmCwGetLfAmplitude (instrumentHandle, value, LFAmplitude);
 }
@@ -5409,7 +7332,7 @@ ViStatus _VI_FUNC Pro8_WdmItcGetLfAmplitude (ViSession instrumentHandle, ViInt16
 // Function: Set LF Modulation Frequency
 // Purpose:  This function sets the LF modulation frequency
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmItcSetLfFrequency (ViSession instrumentHandle, ViReal64 LFFrequency)
+ViStatus _VI_FUNC Pro8_WdmEaSetLfFrequency (ViSession instrumentHandle, ViReal64 LFFrequency)
 {
    return Pro8_WdmCwSetLfFrequency (instrumentHandle, LFFrequency);
 }
@@ -5418,1133 +7341,6212 @@ ViStatus _VI_FUNC Pro8_WdmItcSetLfFrequency (ViSession instrumentHandle, ViReal6
 // Function: Get LF Modulation Frequency
 // Purpose:  This function returns the LF modulation frequency
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmItcGetLfFrequency (ViSession instrumentHandle, ViInt16 value, ViReal64 *LFFrequency)
+ViStatus _VI_FUNC Pro8_WdmEaGetLfFrequency (ViSession instrumentHandle, ViInt16 value, ViReal64 *LFFrequency)
 {
    return Pro8_WdmCwGetLfFrequency (instrumentHandle, value, LFFrequency);
 }
 
 //---------------------------------------------------------------------------
-// Function: Set Laser Current
-// Purpose:  This function sets the current of the laserdiode
+// Function: Set HF Modulation Amplitude
+// Purpose:  This function sets the HF modulation amplitude
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmItcSetLdCurrent (ViSession instrumentHandle, ViReal64 current)
+ViStatus _VI_FUNC Pro8_WdmEaSetHfAmplitude (ViSession instrumentHandle, ViReal64 HFAmplitude)
 {
-   return Pro8_LdcSetLdCurrent (instrumentHandle, current);
-}
+   ViStatus status = VI_SUCCESS;
+   ViUInt32 retCnt = 0;
+   ViUInt16 stb;
+   ViChar   buffer[CMD_BUF_SIZE];
 
-//---------------------------------------------------------------------------
-// Function: Get Laser Current
-// Purpose:  This function returns the current of the laserdiode
-//---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmItcGetLdCurrent (ViSession instrumentHandle, ViInt16 value, ViReal64 *current)
-{
-   if (Pro8_invalidViInt16Range (value, 0, 2)) return VI_ERROR_PARAMETER2;
-   return Pro8_LdcGetLdCurrent (instrumentHandle, value, current);
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   //Formatting
+   Pro8_Fmt (buffer, ":HFAMP:SET %f", HFAmplitude);
+   //Writing - Poll STB - Check EAV Bit and read error
+   if ((status = Pro8_Write (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
+   //Ready
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
-// Function: Set LD Limit Current
-// Purpose:  This function sets the limit current of the laser diode
+// Function: Get HF Modulation Amplitude
+// Purpose:  This function returns the HF modulation amplitude
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmItcSetLdLimit (ViSession instrumentHandle, ViReal64 limitCurrent)
+ViStatus _VI_FUNC Pro8_WdmEaGetHfAmplitude (ViSession instrumentHandle, ViInt16 value, ViReal64 *HFAmplitude)
 {
-   return Pro8_LdcSetLdLimit (instrumentHandle, limitCurrent);
-}
+   ViStatus  status = VI_SUCCESS;
+   ViString  command[] = {":HFAMP:MIN?", ":HFAMP:MAX?", ":HFAMP:SET?"};
+   ViBoolean answer;
 
-//---------------------------------------------------------------------------
-// Function: Get LD Limit Current
-// Purpose:  This function returns the limit current of the laser diode
-//---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmItcGetLdLimit (ViSession instrumentHandle, ViInt16 value, ViReal64 *limitCurrent)
-{
-   return Pro8_LdcGetLdLimit (instrumentHandle, value, limitCurrent);
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   if ((status = Pro8_GetAnswer (instrumentHandle, &answer)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Check input parameter ranges
+   if (Pro8_invalidViInt16Range (value, 0, 2)) return Pro8_Unlock (instrumentHandle, VI_ERROR_PARAMETER2);
+   //Shadow model or Writing - Poll STB - Check EAV Bit and read error - Reading
+   if ((status = Pro8_ShadowReal (instrumentHandle, command[value], answer, HFAmplitude)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Ready
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
-// Function: Set Temperature
-// Purpose:  This function sets the temperature
+// Function: Set HF Modulation
+// Purpose:  This function switches the HF modulation on and off
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmItcSetTemp (ViSession instrumentHandle, ViReal64 temperature)
+ViStatus _VI_FUNC Pro8_WdmEaSetHfMod (ViSession instrumentHandle, ViInt16 HFModulation)
 {
-   return Pro8_TecSetTemp (instrumentHandle, temperature);
+   ViStatus status    = VI_SUCCESS;
+   ViUInt32 retCnt    = 0;
+   ViUInt16 stb;
+   ViString command[] = {":HFMOD OFF", ":HFMOD ON"};
+
+   //Check input parameter ranges
+   if (Pro8_invalidViInt16Range (HFModulation, 0, 1)) return VI_ERROR_PARAMETER2;
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   //Writing - Poll STB - Check EAV Bit and read error
+   if ((status = Pro8_Write (instrumentHandle, command[HFModulation], StringLength (command[HFModulation]), &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
+   //Ready
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get Temperature
-// Purpose:  This function returns the temperature
+// Function: Get HF Modulation
+// Purpose:  This function retuns the state of the HF modulation
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmItcGetTemp (ViSession instrumentHandle, ViInt16 value, ViReal64 *temperature)
+ViStatus _VI_FUNC Pro8_WdmEaGetHfMod (ViSession instrumentHandle, ViInt16 *HFModulation)
 {
-   if (Pro8_invalidViInt16Range (value, 0, 2)) return VI_ERROR_PARAMETER2;
-   return Pro8_TecGetTemp (instrumentHandle, value, temperature);
+   ViStatus status = VI_SUCCESS;
+   ViChar   buffer[CMD_BUF_SIZE];
+   ViBoolean answer;
+
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   if ((status = Pro8_GetAnswer (instrumentHandle, &answer)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Shadow model or Writing - Poll STB - Check EAV Bit and read error - Reading
+   if ((status = Pro8_ShadowQuery (instrumentHandle, ":HFMOD?", answer, buffer, sizeof (buffer))) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Evaluate
+   if      (CompareStrings ("OFF", 0, buffer, 0, 0) == 0) *HFModulation = 0;
+   else if (CompareStrings ("ON",  0, buffer, 0, 0) == 0) *HFModulation = 1;
+   else status = VI_ERROR_INSTR_INTERPRETING_RESPONSE;
+   //Ready
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
-// Function: Set Resistance
-// Purpose:  This function sets the resistance
+// Function: Set Modulation Voltage
+// Purpose:  This function sets the modulation voltage
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmItcSetRes (ViSession instrumentHandle, ViReal64 resistance)
+ViStatus _VI_FUNC Pro8_WdmEaSetModVoltage (ViSession instrumentHandle, ViReal64 modulationVoltage)
 {
-   return Pro8_TecSetRes (instrumentHandle, resistance);
+   ViStatus status = VI_SUCCESS;
+   ViUInt32 retCnt = 0;
+   ViUInt16 stb;
+   ViChar   buffer[CMD_BUF_SIZE];
+
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   //Formatting
+   Pro8_Fmt (buffer, ":VMOD:SET %f", modulationVoltage);
+   //Writing - Poll STB - Check EAV Bit and read error
+   if ((status = Pro8_Write (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
+   //Ready
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get Resistance
-// Purpose:  This function returns the resistance
+// Function: Get Modulation Voltage
+// Purpose:  This function returns the modulation voltage
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_WdmItcGetRes (ViSession instrumentHandle, ViInt16 value, ViReal64 *resistance)
+ViStatus _VI_FUNC Pro8_WdmEaGetModVoltage (ViSession instrumentHandle, ViInt16 value, ViReal64 *modulationVoltage)
 {
-   if (Pro8_invalidViInt16Range (value, 0, 2)) return VI_ERROR_PARAMETER2;
-   return Pro8_TecGetRes (instrumentHandle, value, resistance);
+   ViStatus status = VI_SUCCESS;
+   ViString command[] = {":VMOD:MIN?", ":VMOD:MAX?", ":VMOD:SET?"};
+   ViBoolean answer;
+
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   if ((status = Pro8_GetAnswer (instrumentHandle, &answer)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Check input parameter ranges
+   if (Pro8_invalidViInt16Range (value, 0, 2)) return Pro8_Unlock (instrumentHandle, VI_ERROR_PARAMETER2);
+   //Shadow model or Writing - Poll STB - Check EAV Bit and read error - Reading
+   if ((status = Pro8_ShadowReal (instrumentHandle, command[value], answer, modulationVoltage)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Ready
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 
 //===========================================================================
-// BBS Functions
+// WDM-DIR MODULE FUNCTIONS
 //===========================================================================
 //---------------------------------------------------------------------------
-// Function: Set LED Output
+// Function: Set Laser Output
 // Purpose:  This function switches the output on or off
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_BbsSetOutput (ViSession instrumentHandle, ViInt16 output)
+ViStatus _VI_FUNC Pro8_WdmDirSetOutput (ViSession instrumentHandle, ViInt16 output)
 {
-   return Pro8_SledSetOutput (instrumentHandle, output);
+   return Pro8_LdcSetLdOutput (instrumentHandle, output);
 }
 
 //---------------------------------------------------------------------------
 // Function: Get Laser Output
 // Purpose:  This function returns the state of the output
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_BbsGetOutput (ViSession instrumentHandle, ViInt16 *output)
+ViStatus _VI_FUNC Pro8_WdmDirGetOutput (ViSession instrumentHandle, ViInt16 *output)
 {
-   return Pro8_SledGetOutput (instrumentHandle, output);
+   return Pro8_LdcGetLdOutput (instrumentHandle, output);
 }
 
 //---------------------------------------------------------------------------
-// Function: Set Synchronous Modulation
-// Purpose:  This function switches the sync. modulation on and off
+// Function: Set Coherence Control
+// Purpose:  This function switches the coherence control on or off
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_BbsSetSyncMod (ViSession instrumentHandle, ViInt16 synchronousModulation)
+ViStatus _VI_FUNC Pro8_WdmDirSetCohCtrl (ViSession instrumentHandle, ViInt16 coherence)
 {
-   return Pro8_LsSetSyncMod (instrumentHandle, synchronousModulation);
+   return Pro8_WdmEaSetCohCtrl (instrumentHandle, coherence);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get Synchronous Modulation
-// Purpose:  This function retuns the state of the sync. modulation
+// Function: Get Coherence Control
+// Purpose:  This function returns the state of the coherence control
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_BbsGetSyncMod (ViSession instrumentHandle, ViInt16 *synchronousModulation)
+ViStatus _VI_FUNC Pro8_WdmDirGetCohCtrl (ViSession instrumentHandle, ViInt16 *coherence)
 {
-   return Pro8_LsGetSyncMod (instrumentHandle, synchronousModulation);
+   return Pro8_WdmEaGetCohCtrl (instrumentHandle, coherence);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get Laser Power
-// Purpose:  This function returns the laser power (dBm)
+// Function: Set Modulation
+// Purpose:  This function switches the modulation on or off
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_BbsGetPowerdBm (ViSession instrumentHandle, ViReal64 *power)
+ViStatus _VI_FUNC Pro8_WdmDirSetModulation (ViSession instrumentHandle, ViInt16 modulation)
 {
-   return Pro8_WdmCcdmGetPowerdBm (instrumentHandle, 2, power);
+   ViStatus status    = VI_SUCCESS;
+   ViUInt32 retCnt    = 0;
+   ViUInt16 stb;
+   ViString command[] = {":MOD OFF", ":MOD ON"};
+
+   //Check input parameter ranges
+   if (Pro8_invalidViInt16Range (modulation, 0, 1)) return VI_ERROR_PARAMETER2;
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   //Writing - Poll STB - Check EAV Bit and read error
+   if ((status = Pro8_Write (instrumentHandle, command[modulation], StringLength (command[modulation]), &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
+   //Ready
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get Laser Power
-// Purpose:  This function returns the laser power (W)
+// Function: Get Modulation
+// Purpose:  This function returns the state of the modulation
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_BbsGetPowerW (ViSession instrumentHandle, ViReal64 *power)
+ViStatus _VI_FUNC Pro8_WdmDirGetModulation (ViSession instrumentHandle, ViInt16 *modulation)
 {
-   return Pro8_WdmCcdmGetPowerW (instrumentHandle, 2, power);
-}
+   ViStatus  status = VI_SUCCESS;
+   ViChar    buffer[CMD_BUF_SIZE];
+   ViBoolean answer;
 
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   if ((status = Pro8_GetAnswer (instrumentHandle, &answer)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Shadow model or Writing - Poll STB - Check EAV Bit and read error - Reading
+   if ((status = Pro8_ShadowQuery (instrumentHandle, ":MOD?", answer, buffer, sizeof (buffer))) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Evaluate
+   if      (CompareStrings ("OFF", 0, buffer, 0, 0) == 0) *modulation = 0;
+   else if (CompareStrings ("ON",  0, buffer, 0, 0) == 0) *modulation = 1;
+   else status = VI_ERROR_INSTR_INTERPRETING_RESPONSE;
+   //Ready
+   return Pro8_Unlock (instrumentHandle, status);
+}
 
-//===========================================================================
-// ELCH Functions
-//===========================================================================
 //---------------------------------------------------------------------------
-// Function: Set ELCH Parameters
-// Purpose:  This function sets the parameters for ELCH
+// Function: Set Laser Power
+// Purpose:  This function sets the laser power (dBm)
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_ElchSetParameters (ViSession instrumentHandle, ViInt16 steps, ViInt16 measurementValues)
+ViStatus _VI_FUNC Pro8_WdmDirSetPowerdBm (ViSession instrumentHandle, ViReal64 power)
 {
-   ViStatus status = VI_SUCCESS;
-   ViUInt32 retCnt = 0;
-   ViUInt16 stb;
-   ViChar   buffer[CMD_BUF_SIZE];
+   return Pro8_LsSetPowerdBm (instrumentHandle, power);
+}
 
-   //Check input parameter ranges
-   if (Pro8_invalidViInt16Range (steps, 2, 1001))           return VI_ERROR_PARAMETER2;
-   if (Pro8_invalidViInt16Range (measurementValues, 1, 8))  return VI_ERROR_PARAMETER3;
-   //Formatting
-   Fmt (buffer, ":ELCH:STEPS %d;:ELCH:MEAS %d", steps, measurementValues);
-   //Writing - Poll STB - Check EAV Bit and read error
-   if ((status = viWrite (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   //Ready
-   return status;
+//---------------------------------------------------------------------------
+// Function: Get Laser Power
+// Purpose:  This function returns the laser power (dBm)
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_WdmDirGetPowerdBm (ViSession instrumentHandle, ViInt16 value, ViReal64 *power)
+{
+   return Pro8_LsGetPowerdBm (instrumentHandle, value, power);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get ELCH Parameters
-// Purpose:  This function returns the parameters for ELCH
+// Function: Get Average Laser Power
+// Purpose:  This function returns the average laser power (dBm)
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_ElchGetParameters (ViSession instrumentHandle, ViInt16 *steps, ViInt16 *measurementValues)
+ViStatus _VI_FUNC Pro8_WdmDirGetAvPowerdBm (ViSession instrumentHandle, ViReal64 *power)
 {
-   ViStatus status = VI_SUCCESS;
-   ViUInt32 retCnt = 0;
-   ViUInt16 stb;
+   ViStatus  status = VI_SUCCESS;
+   ViUInt32  retCnt = 0;
+   ViUInt16  stb;
    ViBoolean answer;
-   ViString  format1[] = {"%*s %d", "%d"};
-   ViString  format2[] = {"%*s %d", "%d"};
 
-   if ((status = viGetAttribute (instrumentHandle, VI_ATTR_USER_DATA, &answer)) < 0) return status;
-   //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, ":ELCH:STEPS?", 12, &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format1[answer], steps)) < 0) return status;
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   if ((status = Pro8_GetAnswer (instrumentHandle, &answer)) < 0) return Pro8_Unlock (instrumentHandle, status);
    //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, ":ELCH:MEAS?", 11, &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format2[answer], measurementValues)) < 0) return status;
+   if ((status = Pro8_Write (instrumentHandle, ":PAV_DBM:ACT?", 13, &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
+   if ((status = Pro8_ReadReal (instrumentHandle, answer, power)) < 0) return Pro8_Unlock (instrumentHandle, status);
    //Ready
-   return status;
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
-// Function: ELCH Run
-// Purpose:  This function starts a electrical characterisation
+// Function: Set Laser Power
+// Purpose:  This function sets the laser power (W)
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_ElchRun (ViSession instrumentHandle, ViInt16 function)
+ViStatus _VI_FUNC Pro8_WdmDirSetPowerW (ViSession instrumentHandle, ViReal64 power)
 {
-   ViStatus status = VI_SUCCESS;
-   ViUInt32 retCnt = 0;
-   ViUInt16 stb;
-   ViChar   buffer[CMD_BUF_SIZE];
+   return Pro8_LsSetPowerW (instrumentHandle, power);
+}
 
-   //Check input parameter ranges
-   if (Pro8_invalidViInt16Range (function, 0, 2)) return VI_ERROR_PARAMETER2;
-   //Formatting
-   Fmt (buffer, ":ELCH:RUN %d", function);
-   //Writing - Poll STB - Check EAV Bit and read error
-   if ((status = viWrite (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   //Ready
-   return status;
+//---------------------------------------------------------------------------
+// Function: Get Laser Power
+// Purpose:  This function returns the laser power (W)
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_WdmDirGetPowerW (ViSession instrumentHandle, ViInt16 value, ViReal64 *power)
+{
+   return Pro8_LsGetPowerW (instrumentHandle, value, power);
 }
 
 //---------------------------------------------------------------------------
-// Function: Get ELCH Measurement Values
-// Purpose:  This function returns ELCH measurement values
+// Function: Get Average Laser Power
+// Purpose:  This function returns the average laser power (W)
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_ElchGetMeasVal (ViSession instrumentHandle, ViInt16 measurementValues, ViReal64 *value1, ViReal64 *value2, ViReal64 *value3, ViReal64 *value4, ViReal64 *value5, ViReal64 *value6, ViReal64 *value7, ViReal64 *value8)
+ViStatus _VI_FUNC Pro8_WdmDirGetAvPowerW (ViSession instrumentHandle, ViReal64 *power)
 {
    ViStatus  status = VI_SUCCESS;
    ViUInt32  retCnt = 0;
    ViUInt16  stb;
    ViBoolean answer;
-   ViString  format1[] = {"%*s %LE",                             "%LE"};
-   ViString  format2[] = {"%*s %LE,%LE",                         "%LE,%LE"};
-   ViString  format3[] = {"%*s %LE,%LE,%LE",                     "%LE,%LE,%LE"};
-   ViString  format4[] = {"%*s %LE,%LE,%LE,%LE",                 "%LE,%LE,%LE,%LE"};
-   ViString  format5[] = {"%*s %LE,%LE,%LE,%LE,%LE",             "%LE,%LE,%LE,%LE,%LE"};
-   ViString  format6[] = {"%*s %LE,%LE,%LE,%LE,%LE,%LE",         "%LE,%LE,%LE,%LE,%LE,%LE"};
-   ViString  format7[] = {"%*s %LE,%LE,%LE,%LE,%LE,%LE,%LE",     "%LE,%LE,%LE,%LE,%LE,%LE,%LE"};
-   ViString  format8[] = {"%*s %LE,%LE,%LE,%LE,%LE,%LE,%LE,%LE", "%LE,%LE,%LE,%LE,%LE,%LE,%LE,%LE"};
 
-   if ((status = viGetAttribute (instrumentHandle, VI_ATTR_USER_DATA, &answer)) < 0) return status;
-
-   //Check input parameter ranges
-   if (Pro8_invalidViInt16Range (measurementValues, 1, 8)) return VI_ERROR_PARAMETER3;
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   if ((status = Pro8_GetAnswer (instrumentHandle, &answer)) < 0) return Pro8_Unlock (instrumentHandle, status);
    //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, ":ELCH:TRIG?", 11, &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   //Reading
-   switch (measurementValues)
-   {
-      case 1:
-         status = viScanf (instrumentHandle, format1[answer], value1);
-         break;
-      case 2:
-         status = viScanf (instrumentHandle, format2[answer], value1, value2);
-         break;
-      case 3:
-         status = viScanf (instrumentHandle, format3[answer], value1, value2, value3);
-         break;
-      case 4:
-         status = viScanf (instrumentHandle, format4[answer], value1, value2, value3, value4);
-         break;
-      case 5:
-         status = viScanf (instrumentHandle, format5[answer], value1, value2, value3, value4, value5);
-         break;
-      case 6:
-         status = viScanf (instrumentHandle, format6[answer], value1, value2, value3, value4, value5, value6);
-         break;
-      case 7:
-         status = viScanf (instrumentHandle, format7[answer], value1, value2, value3, value4, value5, value6, value7);
-         break;
-      case 8:
-         status = viScanf (instrumentHandle, format8[answer], value1, value2, value3, value4, value5, value6, value7, value8);
-         break;
-   }
+   if ((status = Pro8_Write (instrumentHandle, ":PAV_W:ACT?", 11, &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
+   if ((status = Pro8_ReadReal (instrumentHandle, answer, power)) < 0) return Pro8_Unlock (instrumentHandle, status);
    //Ready
-   return status;
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
-// Function: LDC Set ELCH Set Values
-// Purpose:  This function sets the start and stop values for ELCH
+// Function: Set Wavelength
+// Purpose:  This function sets the wavelength
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_LdcSetElchSetVal (ViSession instrumentHandle, ViInt16 setParameter, ViReal64 startValue, ViReal64 stopValue)
+ViStatus _VI_FUNC Pro8_WdmDirSetWavelength (ViSession instrumentHandle, ViReal64 wavelength)
 {
-   ViStatus status = VI_SUCCESS;
-   ViUInt32 retCnt = 0;
-   ViUInt16 stb;
-   ViChar   buffer[CMD_BUF_SIZE];
-   ViString command[] = {"ILD", "IMD"};
+   return Pro8_WdmCwSetWavelength (instrumentHandle, wavelength);
+}
 
-   //Check input parameter ranges
-   if (Pro8_invalidViInt16Range (setParameter, 0, 1)) return VI_ERROR_PARAMETER2;
-   //Formatting
-   Fmt (buffer, ":%s:START %f;:%s:STOP %f", command[setParameter], startValue, command[setParameter], stopValue);
-   //Writing - Poll STB - Check EAV Bit and read error
-   if ((status = viWrite (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   //Ready
-   return status;
+//---------------------------------------------------------------------------
+// Function: Get Wavelength
+// Purpose:  This function returns the wavelength
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_WdmDirGetWavelength (ViSession instrumentHandle, ViInt16 value, ViReal64 *wavelength)
+{
+   return Pro8_WdmCwGetWavelength (instrumentHandle, value, wavelength);
 }
 
 //---------------------------------------------------------------------------
-// Function: LDC Get ELCH Set Values
-// Purpose:  This function returns the start and stop values for ELCH
+// Function: Set Threshold Voltage
+// Purpose:  This function sets the threshold voltage
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_LdcGetElchSetVal (ViSession instrumentHandle, ViInt16 setParameter, ViReal64 *startValue, ViReal64 *stopValue)
+ViStatus _VI_FUNC Pro8_WdmDirSetThreshold (ViSession instrumentHandle, ViReal64 thresholdVoltage)
 {
-   ViStatus  status = VI_SUCCESS;
-   ViUInt32  retCnt = 0;
-   ViUInt16  stb;
-   ViString  command1[] = {":ILD:START?", ":IMD:START?"};
-   ViString  command2[] = {":ILD:STOP?",  ":IMD:STOP?" };
-   ViBoolean answer;
-   ViString  format1[] = {"%*s %LE", "%LE"};
-   ViString  format2[] = {"%*s %LE", "%LE"};
+   return Pro8_WdmEaSetThreshold (instrumentHandle, thresholdVoltage);
+}
 
-   if ((status = viGetAttribute (instrumentHandle, VI_ATTR_USER_DATA, &answer)) < 0) return status;
-   //Check input parameter ranges
-   if (Pro8_invalidViInt16Range (setParameter, 0, 1)) return VI_ERROR_PARAMETER2;
-   //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, command1[setParameter], StringLength (command1[setParameter]), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format1[answer], startValue)) < 0) return status;
-   //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, command2[setParameter], StringLength (command2[setParameter]), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format2[answer], stopValue)) < 0) return status;
-   //Ready
-   return status;
+//---------------------------------------------------------------------------
+// Function: Get Threshold Voltage
+// Purpose:  This function returns the threshold voltage
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_WdmDirGetThreshold (ViSession instrumentHandle, ViInt16 value, ViReal64 *thresholdVoltage)
+{
+   return Pro8_WdmEaGetThreshold (instrumentHandle, value, thresholdVoltage);
 }
 
 //---------------------------------------------------------------------------
-// Function: LDC Set ELCH Measurement Value Position
-// Purpose:  This function sets the position of the measurement value
+// Function: Set Modulation Current
+// Purpose:  This function sets the modulation current
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_LdcSetElchMeasVal (ViSession instrumentHandle, ViInt16 measurementParameter, ViInt16 position)
+ViStatus _VI_FUNC Pro8_WdmDirSetModCurrent (ViSession instrumentHandle, ViReal64 modulationCurrent)
 {
    ViStatus status = VI_SUCCESS;
    ViUInt32 retCnt = 0;
    ViUInt16 stb;
    ViChar   buffer[CMD_BUF_SIZE];
-   ViString command[] = {"ILD", "IMD", "VLD"};
 
-   //Check input parameter ranges
-   if (Pro8_invalidViInt16Range (measurementParameter, 0, 2))  return VI_ERROR_PARAMETER2;
-   if (Pro8_invalidViInt16Range (position, 1, 8))              return VI_ERROR_PARAMETER3;
+   //Lock session
+   Pro8_Lock (instrumentHandle);
    //Formatting
-   Fmt (buffer, ":%s:MEAS %d", command[measurementParameter], position);
+   Pro8_Fmt (buffer, ":CMOD:SET %f", modulationCurrent);
    //Writing - Poll STB - Check EAV Bit and read error
-   if ((status = viWrite (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
+   if ((status = Pro8_Write (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
    //Ready
-   return status;
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
-// Function: LDC Get ELCH Measurement Value Position
-// Purpose:  This function returns the position of the measurement value
+// Function: Get Modulation Current
+// Purpose:  This function returns the modulation current
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_LdcGetElchMeasVal (ViSession instrumentHandle, ViInt16 measurementParameter, ViInt16 *position)
+ViStatus _VI_FUNC Pro8_WdmDirGetModCurrent (ViSession instrumentHandle, ViInt16 value, ViReal64 *modulationCurrent)
 {
-   ViStatus  status = VI_SUCCESS;
-   ViUInt32  retCnt = 0;
-   ViUInt16  stb;
-   ViString  command[] = {":ILD:MEAS?", ":IMD:MEAS?", ":VLD:MEAS?"};
+   ViStatus status = VI_SUCCESS;
+   ViString command[] = {":CMOD:MIN?", ":CMOD:MAX?", ":CMOD:SET?"};
    ViBoolean answer;
-   ViString  format[] = {"%*s %d", "%d"};
 
-   if ((status = viGetAttribute (instrumentHandle, VI_ATTR_USER_DATA, &answer)) < 0) return status;
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   if ((status = Pro8_GetAnswer (instrumentHandle, &answer)) < 0) return Pro8_Unlock (instrumentHandle, status);
    //Check input parameter ranges
-   if (Pro8_invalidViInt16Range (measurementParameter, 0, 2))  return VI_ERROR_PARAMETER2;
-   //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, command[measurementParameter], StringLength (command[measurementParameter]), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format[answer], position)) < 0) return status;
+   if (Pro8_invalidViInt16Range (value, 0, 2)) return Pro8_Unlock (instrumentHandle, VI_ERROR_PARAMETER2);
+   //Shadow model or Writing - Poll STB - Check EAV Bit and read error - Reading
+   if ((status = Pro8_ShadowReal (instrumentHandle, command[value], answer, modulationCurrent)) < 0) return Pro8_Unlock (instrumentHandle, status);
    //Ready
-   return status;
+   return Pro8_Unlock (instrumentHandle, status);
 }
 
 //---------------------------------------------------------------------------
-// Function: MLC Set ELCH Set Values
-// Purpose:  This function sets the start and stop values for ELCH
+// Function: Set Frequency
+// Purpose:  This function sets the frequency
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_MlcSetElchSetVal (ViSession instrumentHandle, ViInt16 setParameter, ViReal64 startValue, ViReal64 stopValue)
+ViStatus _VI_FUNC Pro8_WdmDirSetFrequency (ViSession instrumentHandle, ViReal64 frequency)
 {
-   return Pro8_LdcSetElchSetVal (instrumentHandle, setParameter, startValue, stopValue);
+   return Pro8_WdmCwSetFrequency (instrumentHandle, frequency);
 }
 
 //---------------------------------------------------------------------------
-// Function: MLC Get ELCH Set Values
-// Purpose:  This function returns the start and stop values for ELCH
+// Function: Get Frequency
+// Purpose:  This function returns the frequency
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_MlcGetElchSetVal (ViSession instrumentHandle, ViInt16 setParameter, ViReal64 *startValue, ViReal64 *stopValue)
+ViStatus _VI_FUNC Pro8_WdmDirGetFrequency (ViSession instrumentHandle, ViInt16 value, ViReal64 *frequency)
 {
-   return Pro8_LdcGetElchSetVal (instrumentHandle, setParameter, startValue, stopValue);
+   return Pro8_WdmCwGetFrequency (instrumentHandle, value, frequency);
 }
 
 //---------------------------------------------------------------------------
-// Function: MLC Set ELCH Measurement Value Position
-// Purpose:  This function sets the position of the measurement value
+// Function: Set Synchronous Modulation
+// Purpose:  This function switches the sync. modulation on and off
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_MlcSetElchMeasVal (ViSession instrumentHandle, ViInt16 measurementParameter, ViInt16 position)
+ViStatus _VI_FUNC Pro8_WdmDirSetSyncMod (ViSession instrumentHandle, ViInt16 synchronousModulation)
 {
-   ViStatus  status = VI_SUCCESS;
-   ViUInt32  retCnt = 0;
-   ViUInt16  stb;
-   ViChar    buffer[CMD_BUF_SIZE];
-   ViString  command[] = {"ILD", "IMD"};
-
-   //Check input parameter ranges
-   if (Pro8_invalidViInt16Range (measurementParameter, 0, 1))  return VI_ERROR_PARAMETER2;
-   if (Pro8_invalidViInt16Range (position, 1, 8))              return VI_ERROR_PARAMETER3;
-   //Formatting
-   Fmt (buffer, ":%s:MEAS %d", command[measurementParameter], position);
-   //Writing - Poll STB - Check EAV Bit and read error
-   if ((status = viWrite (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   //Ready
-   return status;
+   return Pro8_LsSetSyncMod (instrumentHandle, synchronousModulation);
 }
 
 //---------------------------------------------------------------------------
-// Function: MLC Get ELCH Measurement Value Position
-// Purpose:  This function returns the position of the measurement value
+// Function: Get Synchronous Modulation
+// Purpose:  This function retuns the state of the sync. modulation
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_MlcGetElchMeasVal (ViSession instrumentHandle, ViInt16 measurementParameter, ViInt16 *position)
+ViStatus _VI_FUNC Pro8_WdmDirGetSyncMod (ViSession instrumentHandle, ViInt16 *synchronousModulation)
 {
-   ViStatus  status = VI_SUCCESS;
-   ViUInt32  retCnt = 0;
-   ViUInt16  stb;
-   ViString  command[] = {":ILD:MEAS?", ":IMD:MEAS?"};
-   ViBoolean answer;
-   ViString  format[] = {"%*s %d", "%d"};
-
-   if ((status = viGetAttribute (instrumentHandle, VI_ATTR_USER_DATA, &answer)) < 0) return status;
-   //Check input parameter ranges
-   if (Pro8_invalidViInt16Range (measurementParameter, 0, 1))  return VI_ERROR_PARAMETER2;
-   //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, command[measurementParameter], StringLength (command[measurementParameter]), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format[answer], position)) < 0) return status;
-   //Ready
-   return status;
+   return Pro8_LsGetSyncMod (instrumentHandle, synchronousModulation);
 }
 
 //---------------------------------------------------------------------------
-// Function: TEC Set ELCH Measurement Value Position
-// Purpose:  This function sets the position of the measurement value
+// Function: Set LF Modulation
+// Purpose:  This function switches the LF modulation on and off
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_TecSetElchMeasVal (ViSession instrumentHandle, ViInt16 measurementParameter, ViInt16 position)
+ViStatus _VI_FUNC Pro8_WdmDirSetLfMod (ViSession instrumentHandle, ViInt16 LFModulation)
 {
-   ViStatus status = VI_SUCCESS;
-   ViUInt32 retCnt = 0;
-   ViUInt16 stb;
-   ViChar   buffer[CMD_BUF_SIZE];
-   ViString command[] = {"ITE", "VTE", "RESI", "TEMP"};
-
-   //Check input parameter ranges
-   if (Pro8_invalidViInt16Range (measurementParameter, 0, 3))  return VI_ERROR_PARAMETER2;
-   if (Pro8_invalidViInt16Range (position, 1, 8))              return VI_ERROR_PARAMETER3;
-   //Formatting
-   Fmt (buffer, ":%s:MEAS %d", command[measurementParameter], position);
-   //Writing - Poll STB - Check EAV Bit and read error
-   if ((status = viWrite (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   //Ready
-   return status;
+   return Pro8_WdmCwSetLfMod (instrumentHandle, LFModulation);
 }
 
 //---------------------------------------------------------------------------
-// Function: TEC Get ELCH Measurement Value Position
-// Purpose:  This function returns the position of the measurement value
+// Function: Get LF Modulation
+// Purpose:  This function retuns the state of the LF modulation
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_TecGetElchMeasVal (ViSession instrumentHandle, ViInt16 measurementParameter, ViInt16 *position)
+ViStatus _VI_FUNC Pro8_WdmDirGetLfMod (ViSession instrumentHandle, ViInt16 *LFModulation)
 {
-   ViStatus  status = VI_SUCCESS;
-   ViUInt32  retCnt = 0;
-   ViUInt16  stb;
-   ViString  command[] = {":ITE:MEAS?", ":VTE:MEAS?", ":RESI:MEAS?", ":TEMP:MEAS?"};
-   ViBoolean answer;
-   ViString  format[] = {"%*s %d", "%d"};
-
-   if ((status = viGetAttribute (instrumentHandle, VI_ATTR_USER_DATA, &answer)) < 0) return status;
-   //Check input parameter ranges
-   if (Pro8_invalidViInt16Range (measurementParameter, 0, 3))  return VI_ERROR_PARAMETER2;
-   //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, command[measurementParameter], StringLength (command[measurementParameter]), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format[answer], position)) < 0) return status;
-   //Ready
-   return status;
+   return Pro8_WdmCwGetLfMod (instrumentHandle, LFModulation);
 }
 
 //---------------------------------------------------------------------------
-// Function: ITC Set ELCH Set Values
-// Purpose:  This function sets the start and stop values for ELCH
+// Function: Set LF Modulation Type
+// Purpose:  This function switches the LF modulation type
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_ItcSetElchSetVal (ViSession instrumentHandle, ViInt16 setParameter, ViReal64 startValue, ViReal64 stopValue)
+ViStatus _VI_FUNC Pro8_WdmDirSetLfModType (ViSession instrumentHandle, ViInt16 LFModulationType)
 {
-   ViStatus status = VI_SUCCESS;
-   ViUInt32 retCnt = 0;
-   ViUInt16 stb;
-   ViChar   buffer[CMD_BUF_SIZE];
-   ViString command[] = {"ILD", "IMD", "VBIAS"};
-
-   //Check input parameter ranges
-   if (Pro8_invalidViInt16Range (setParameter, 0, 2)) return VI_ERROR_PARAMETER2;
-   //Formatting
-   Fmt (buffer, ":%s:START %f;:%s:STOP %f", command[setParameter], startValue, command[setParameter], stopValue);
-   //Writing - Poll STB - Check EAV Bit and read error
-   if ((status = viWrite (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   //Ready
-   return status;
+   return Pro8_WdmCwSetLfModType (instrumentHandle, LFModulationType);
 }
 
 //---------------------------------------------------------------------------
-// Function: ITC Get ELCH Set Values
-// Purpose:  This function returns the start and stop values for ELCH
+// Function: Get LF Modulation Type
+// Purpose:  This function retuns the type of LF modulation
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_ItcGetElchSetVal (ViSession instrumentHandle, ViInt16 setParameter, ViReal64 *startValue, ViReal64 *stopValue)
+ViStatus _VI_FUNC Pro8_WdmDirGetLfModType (ViSession instrumentHandle, ViInt16 *LFModulationType)
 {
-   ViStatus status     = VI_SUCCESS;
-   ViUInt32 retCnt     = 0;
-   ViUInt16 stb;
-   ViString command1[] = {":ILD:START?", ":IMD:START?", ":VBIAS:START?"};
-   ViString command2[] = {":ILD:STOP?",  ":IMD:STOP?" , ":VBIAS:STOP?" };
-   ViBoolean answer;
-   ViString  format1[] = {"%*s %LE", "%LE"};
-   ViString  format2[] = {"%*s %LE", "%LE"};
-
-   if ((status = viGetAttribute (instrumentHandle, VI_ATTR_USER_DATA, &answer)) < 0) return status;
-   //Check input parameter ranges
-   if (Pro8_invalidViInt16Range (setParameter, 0, 2)) return VI_ERROR_PARAMETER2;
-   //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, command1[setParameter], StringLength (command1[setParameter]), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format1[answer], startValue)) < 0) return status;
-   //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, command2[setParameter], StringLength (command2[setParameter]), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format2[answer], stopValue)) < 0) return status;
-   //Ready
-   return status;
+   return Pro8_WdmCwGetLfModType (instrumentHandle, LFModulationType);
 }
 
 //---------------------------------------------------------------------------
-// Function: ITC Set ELCH Measurement Value Position
-// Purpose:  This function sets the position of the measurement value
+// Function: Set LF Modulation Amplitude
+// Purpose:  This function sets the LF modulation amplitude
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_ItcSetElchMeasVal (ViSession instrumentHandle, ViInt16 measurementParameter, ViInt16 position)
+ViStatus _VI_FUNC Pro8_WdmDirSetLfAmplitude (ViSession instrumentHandle, ViReal64 LFAmplitude)
 {
-   ViStatus status = VI_SUCCESS;
-   ViUInt32 retCnt = 0;
-   ViUInt16 stb;
-   ViChar   buffer[CMD_BUF_SIZE];
-   ViString command[] = {"ILD", "IMD", "VLD", "ITE", "VTE", "RESI", "TEMP"};
-
-   //Check input parameter ranges
-   if (Pro8_invalidViInt16Range (measurementParameter, 0, 6))  return VI_ERROR_PARAMETER2;
-   if (Pro8_invalidViInt16Range (position, 1, 8))              return VI_ERROR_PARAMETER3;
-   //Formatting
-   Fmt (buffer, ":%s:MEAS %d", command[measurementParameter], position);
-   //Writing - Poll STB - Check EAV Bit and read error
-   if ((status = viWrite (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   //Ready
-   return status;
+   return Pro8_WdmCwSetLfAmplitude (instrumentHandle, LFAmplitude);
 }
 
 //---------------------------------------------------------------------------
-// Function: ITC Get ELCH Measurement Value Position
-// Purpose:  This function returns the position of the measurement value
+// Function: Get LF Modulation Amplitude
+// Purpose:  This function returns the LF modulation amplitude
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_ItcGetElchMeasVal (ViSession instrumentHandle, ViInt16 measurementParameter, ViInt16 *position)
+ViStatus _VI_FUNC Pro8_WdmDirGetLfAmplitude (ViSession instrumentHandle, ViInt16 value, ViReal64 *LFAmplitude)
 {
-   ViStatus status = VI_SUCCESS;
+   return Pro8_WdmCwGetLfAmplitude (instrumentHandle, value, LFAmplitude);
+}
+
+//---------------------------------------------------------------------------
+// Function: Set LF Modulation Frequency
+// Purpose:  This function sets the LF modulation frequency
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_WdmDirSetLfFrequency (ViSession instrumentHandle, ViReal64 LFFrequency)
+{
+   return Pro8_WdmCwSetLfFrequency (instrumentHandle, LFFrequency);
+}
+
+//---------------------------------------------------------------------------
+// Function: Get LF Modulation Frequency
+// Purpose:  This function returns the LF modulation frequency
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_WdmDirGetLfFrequency (ViSession instrumentHandle, ViInt16 value, ViReal64 *LFFrequency)
+{
+   return Pro8_WdmEaGetLfFrequency (instrumentHandle, value, LFFrequency);
+}
+
+//---------------------------------------------------------------------------
+// Function: Set HF Modulation Amplitude
+// Purpose:  This function sets the HF modulation amplitude
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_WdmDirSetHfAmplitude (ViSession instrumentHandle, ViReal64 HFAmplitude)
+{
+   return Pro8_WdmEaSetHfAmplitude (instrumentHandle, HFAmplitude);
+}
+
+//---------------------------------------------------------------------------
+// Function: Get HF Modulation Amplitude
+// Purpose:  This function returns the HF modulation amplitude
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_WdmDirGetHfAmplitude (ViSession instrumentHandle, ViInt16 value, ViReal64 *LFAmplitude)
+{
+   return Pro8_WdmEaGetHfAmplitude (instrumentHandle, value, LFAmplitude);
+}
+
+//---------------------------------------------------------------------------
+// Function: Set HF Modulation
+// Purpose:  This function switches the HF modulation on and off
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_WdmDirSetHfMod (ViSession instrumentHandle, ViInt16 HFModulation)
+{
+   return Pro8_WdmEaSetHfMod (instrumentHandle, HFModulation);
+}
+
+//---------------------------------------------------------------------------
+// Function: Get HF Modulation
+// Purpose:  This function retuns the state of the HF modulation
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_WdmDirGetHfMod (ViSession instrumentHandle, ViInt16 *HFModulation)
+{
+   return Pro8_WdmEaGetHfMod (instrumentHandle, HFModulation);
+}
+
+
+//===========================================================================
+// WDM-CCDM MODULE FUNCTIONS
+//===========================================================================
+//---------------------------------------------------------------------------
+// Function: Set Laser Output
+// Purpose:  This function switches the output on or off
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_WdmCcdmSetOutput (ViSession instrumentHandle, ViInt16 output)
+{
+   return Pro8_LdcSetLdOutput (instrumentHandle, output);
+}
+
+//---------------------------------------------------------------------------
+// Function: Get Laser Output
+// Purpose:  This function returns the state of the output
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_WdmCcdmGetOutput (ViSession instrumentHandle, ViInt16 *output)
+{
+   return Pro8_LdcGetLdOutput (instrumentHandle, output);
+}
+
+//---------------------------------------------------------------------------
+// Function: Set Laser Power
+// Purpose:  This function sets the laser power (dBm)
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_WdmCcdmSetPowerdBm (ViSession instrumentHandle, ViReal64 power)
+{
+   return Pro8_LsSetPowerdBm (instrumentHandle, power);
+}
+
+//---------------------------------------------------------------------------
+// Function: Get Laser Power
+// Purpose:  This function returns the laser power (dBm)
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_WdmCcdmGetPowerdBm (ViSession instrumentHandle, ViInt16 value, ViReal64 *power)
+{
+   ViStatus  status    = VI_SUCCESS;
+   ViString  command[] = {":P_DBM:MIN?", ":P_DBM:MAX?", ":P_DBM:SET?", ":P_DBM:ACT?"};
+   ViBoolean answer;
+
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   if ((status = Pro8_GetAnswer (instrumentHandle, &answer)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Check input parameter ranges
+   if (Pro8_invalidViInt16Range (value, 0, 3)) return Pro8_Unlock (instrumentHandle, VI_ERROR_PARAMETER2);
+   //Shadow model or Writing - Poll STB - Check EAV Bit and read error - Reading
+   if ((status = Pro8_ShadowReal (instrumentHandle, command[value], answer, power)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Ready
+   return Pro8_Unlock (instrumentHandle, status);
+}
+
+//---------------------------------------------------------------------------
+// Function: Set Laser Power
+// Purpose:  This function sets the laser power (W)
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_WdmCcdmSetPowerW (ViSession instrumentHandle, ViReal64 power)
+{
+   return Pro8_LsSetPowerW (instrumentHandle, power);
+}
+
+//---------------------------------------------------------------------------
+// Function: Get Laser Power
+// Purpose:  This function returns the laser power (W)
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_WdmCcdmGetPowerW (ViSession instrumentHandle, ViInt16 value, ViReal64 *power)
+{
+   ViStatus  status = VI_SUCCESS;
+   ViString  command[] = {":P_W:MIN?", ":P_W:MAX?", ":P_W:SET?", ":P_W:ACT?"};
+   ViBoolean answer;
+
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   if ((status = Pro8_GetAnswer (instrumentHandle, &answer)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Check input parameter ranges
+   if (Pro8_invalidViInt16Range (value, 0, 3)) return Pro8_Unlock (instrumentHandle, VI_ERROR_PARAMETER2);
+   //Shadow model or Writing - Poll STB - Check EAV Bit and read error - Reading
+   if ((status = Pro8_ShadowReal (instrumentHandle, command[value], answer, power)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Ready
+   return Pro8_Unlock (instrumentHandle, status);
+}
+
+//---------------------------------------------------------------------------
+// Function: Set Wavelength
+// Purpose:  This function sets the wavelength
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_WdmCcdmSetWavelength (ViSession instrumentHandle, ViReal64 wavelength)
+{
+   return Pro8_WdmCwSetWavelength (instrumentHandle, wavelength);
+}
+
+//---------------------------------------------------------------------------
+// Function: Get Wavelength
+// Purpose:  This function returns the wavelength
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_WdmCcdmGetWavelength (ViSession instrumentHandle, ViInt16 value, ViReal64 *wavelength)
+{
+   return Pro8_WdmCwGetWavelength (instrumentHandle, value, wavelength);
+}
+
+//---------------------------------------------------------------------------
+// Function: Set Frequency
+// Purpose:  This function sets the frequency
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_WdmCcdmSetFrequency (ViSession instrumentHandle, ViReal64 frequency)
+{
+   return Pro8_WdmCwSetFrequency (instrumentHandle, frequency);
+}
+
+//---------------------------------------------------------------------------
+// Function: Get Frequency
+// Purpose:  This function returns the frequency
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_WdmCcdmGetFrequency (ViSession instrumentHandle, ViInt16 value, ViReal64 *frequency)
+{
+   return Pro8_WdmCwGetFrequency (instrumentHandle, value, frequency);
+}
+
+//---------------------------------------------------------------------------
+// Function: Set Coherence Control Ration
+// Purpose:  This function sets the coherence control ratio
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_WdmCcdmSetCoherence (ViSession instrumentHandle, ViReal64 coherence)
+{
+   return Pro8_WdmCwSetCoherence (instrumentHandle, coherence);
+}
+
+//---------------------------------------------------------------------------
+// Function: Get Coherence Control Ration
+// Purpose:  This function returns the coherence control ratio
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_WdmCcdmGetCoherence (ViSession instrumentHandle, ViInt16 value, ViReal64 *coherence)
+{
+   return Pro8_WdmCwGetCoherence (instrumentHandle, value, coherence);
+}
+
+//---------------------------------------------------------------------------
+// Function: Set Synchronous Modulation
+// Purpose:  This function switches the sync. modulation on and off
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_WdmCcdmSetSyncMod (ViSession instrumentHandle, ViInt16 synchronousModulation)
+{
+   return Pro8_LsSetSyncMod (instrumentHandle, synchronousModulation);
+}
+
+//---------------------------------------------------------------------------
+// Function: Get Synchronous Modulation
+// Purpose:  This function retuns the state of the sync. modulation
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_WdmCcdmGetSyncMod (ViSession instrumentHandle, ViInt16 *synchronousModulation)
+{
+   return Pro8_LsGetSyncMod (instrumentHandle, synchronousModulation);
+}
+
+//---------------------------------------------------------------------------
+// Function: Set LF Modulation
+// Purpose:  This function switches the LF modulation on and off
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_WdmCcdmSetLfMod (ViSession instrumentHandle, ViInt16 LFModulation)
+{
+   return Pro8_WdmCwSetLfMod (instrumentHandle, LFModulation);
+}
+
+//---------------------------------------------------------------------------
+// Function: Get LF Modulation
+// Purpose:  This function retuns the state of the LF modulation
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_WdmCcdmGetLfMod (ViSession instrumentHandle, ViInt16 *LFModulation)
+{
+   return Pro8_WdmCwGetLfMod (instrumentHandle, LFModulation);
+}
+
+//---------------------------------------------------------------------------
+// Function: Set LF Modulation Type
+// Purpose:  This function switches the LF modulation type
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_WdmCcdmSetLfModType (ViSession instrumentHandle, ViInt16 LFModulationType)
+{
+   return Pro8_WdmCwSetLfModType (instrumentHandle, LFModulationType);
+}
+
+//---------------------------------------------------------------------------
+// Function: Get LF Modulation Type
+// Purpose:  This function retuns the type of LF modulation
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_WdmCcdmGetLfModType (ViSession instrumentHandle, ViInt16 *LFModulationType)
+{
+   return Pro8_WdmCwGetLfModType (instrumentHandle, LFModulationType);
+}
+
+//---------------------------------------------------------------------------
+// Function: Set LF Modulation Amplitude
+// Purpose:  This function sets the LF modulation amplitude
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_WdmCcdmSetLfAmplitude (ViSession instrumentHandle, ViReal64 LFAmplitude)
+{
+   return Pro8_WdmCwSetLfAmplitude (instrumentHandle, LFAmplitude);
+}
+
+//---------------------------------------------------------------------------
+// Function: Get LF Modulation Amplitude
+// Purpose:  This function returns the LF modulation amplitude
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_WdmCcdmGetLfAmplitude (ViSession instrumentHandle, ViInt16 value, ViReal64 *LFAmplitude)
+{
+   return Pro8_WdmCwGetLfAmplitude (instrumentHandle, value, LFAmplitude);
+}
+
+//---------------------------------------------------------------------------
+// Function: Set LF Modulation Frequency
+// Purpose:  This function sets the LF modulation frequency
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_WdmCcdmSetLfFrequency (ViSession instrumentHandle, ViReal64 LFFrequency)
+{
+   return Pro8_WdmCwSetLfFrequency (instrumentHandle, LFFrequency);
+}
+
+//---------------------------------------------------------------------------
+// Function: Get LF Modulation Frequency
+// Purpose:  This function returns the LF modulation frequency
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_WdmCcdmGetLfFrequency (ViSession instrumentHandle, ViInt16 value, ViReal64 *LFFrequency)
+{
+   return Pro8_WdmEaGetLfFrequency (instrumentHandle, value, LFFrequency);
+}
+
+//---------------------------------------------------------------------------
+// Function: Get max HF Modulation Voltage
+// Purpose:  This function returns the maximum HF modulation voltage
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_WdmCcdmGetMaxHfVoltage (ViSession instrumentHandle, ViReal64 *maxHF_modVoltage)
+{
+   return Pro8_WdmCwGetMaxHfVoltage (instrumentHandle, maxHF_modVoltage);
+}
+
+
+//===========================================================================
+// WDM-CWDM Functions
+//===========================================================================
+//---------------------------------------------------------------------------
+// Function: Set Laser Output
+// Purpose:  This function switches the output on or off
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_WdmCwdmSetOutput (ViSession instrumentHandle, ViInt16 output)
+{
+   return Pro8_LdcSetLdOutput (instrumentHandle, output);
+}
+
+//---------------------------------------------------------------------------
+// Function: Get Laser Output
+// Purpose:  This function returns the state of the output
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_WdmCwdmGetOutput (ViSession instrumentHandle, ViInt16 *output)
+{
+   return Pro8_LdcGetLdOutput (instrumentHandle, output);
+}
+
+//---------------------------------------------------------------------------
+// Function: Set Synchronous Modulation
+// Purpose:  This function switches the sync. modulation on and off
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_WdmCwdmSetSyncMod (ViSession instrumentHandle, ViInt16 synchronousModulation)
+{
+   return Pro8_LsSetSyncMod (instrumentHandle, synchronousModulation);
+}
+
+//---------------------------------------------------------------------------
+// Function: Get Synchronous Modulation
+// Purpose:  This function retuns the state of the sync. modulation
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_WdmCwdmGetSyncMod (ViSession instrumentHandle, ViInt16 *synchronousModulation)
+{
+   return Pro8_LsGetSyncMod (instrumentHandle, synchronousModulation);
+}
+
+//---------------------------------------------------------------------------
+// Function: Set LF Modulation
+// Purpose:  This function switches the LF modulation on and off
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_WdmCwdmSetLfMod (ViSession instrumentHandle, ViInt16 LFModulation)
+{
+   return Pro8_WdmCwSetLfMod (instrumentHandle, LFModulation);
+}
+
+//---------------------------------------------------------------------------
+// Function: Get LF Modulation
+// Purpose:  This function retuns the state of the LF modulation
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_WdmCwdmGetLfMod (ViSession instrumentHandle, ViInt16 *LFModulation)
+{
+   return Pro8_WdmCwGetLfMod (instrumentHandle, LFModulation);
+}
+
+//---------------------------------------------------------------------------
+// Function: Set LF Modulation Type
+// Purpose:  This function switches the LF modulation type
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_WdmCwdmSetLfModType (ViSession instrumentHandle, ViInt16 LFModulationType)
+{
+   return Pro8_WdmCwSetLfModType (instrumentHandle, LFModulationType);
+}
+
+//---------------------------------------------------------------------------
+// Function: Get LF Modulation Type
+// Purpose:  This function retuns the type of LF modulation
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_WdmCwdmGetLfModType (ViSession instrumentHandle, ViInt16 *LFModulationType)
+{
+   return Pro8_WdmCwGetLfModType (instrumentHandle, LFModulationType);
+}
+
+//---------------------------------------------------------------------------
+// Function: Set LF Modulation Amplitude
+// Purpose:  This function sets the LF modulation amplitude
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_WdmCwdmSetLfAmplitude (ViSession instrumentHandle, ViReal64 LFAmplitude)
+{
+   return Pro8_WdmCwSetLfAmplitude (instrumentHandle, LFAmplitude);
+}
+
+//---------------------------------------------------------------------------
+// Function: Get LF Modulation Amplitude
+// Purpose:  This function returns the LF modulation amplitude
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_WdmCwdmGetLfAmplitude (ViSession instrumentHandle, ViInt16 value, ViReal64 *LFAmplitude)
+{
+   return Pro8_WdmCwGetLfAmplitude (instrumentHandle, value, LFAmplitude);
+}
+
+//---------------------------------------------------------------------------
+// Function: Set LF Modulation Frequency
+// Purpose:  This function sets the LF modulation frequency
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_WdmCwdmSetLfFrequency (ViSession instrumentHandle, ViReal64 LFFrequency)
+{
+   return Pro8_WdmCwSetLfFrequency (instrumentHandle, LFFrequency);
+}
+
+//---------------------------------------------------------------------------
+// Function: Get LF Modulation Frequency
+// Purpose:  This function returns the LF modulation frequency
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_WdmCwdmGetLfFrequency (ViSession instrumentHandle, ViInt16 value, ViReal64 *LFFrequency)
+{
+   return Pro8_WdmEaGetLfFrequency (instrumentHandle, value, LFFrequency);
+}
+
+//---------------------------------------------------------------------------
+// Function: Set Laser Power
+// Purpose:  This function sets the laser power (dBm)
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_WdmCwdmSetPowerdBm (ViSession instrumentHandle, ViReal64 power)
+{
+   return Pro8_LsSetPowerdBm (instrumentHandle, power);
+}
+
+//---------------------------------------------------------------------------
+// Function: Get Laser Power
+// Purpose:  This function returns the laser power (dBm)
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_WdmCwdmGetPowerdBm (ViSession instrumentHandle, ViInt16 value, ViReal64 *power)
+{
+   if (Pro8_invalidViInt16Range (value, 0, 2)) return VI_ERROR_PARAMETER2;
+   return Pro8_WdmCcdmGetPowerdBm (instrumentHandle, value, power);
+}
+
+//---------------------------------------------------------------------------
+// Function: Set Laser Power
+// Purpose:  This function sets the laser power (W)
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_WdmCwdmSetPowerW (ViSession instrumentHandle, ViReal64 power)
+{
+   return Pro8_LsSetPowerW (instrumentHandle, power);
+}
+
+//---------------------------------------------------------------------------
+// Function: Get Laser Power
+// Purpose:  This function returns the laser power (W)
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_WdmCwdmGetPowerW (ViSession instrumentHandle, ViInt16 value, ViReal64 *power)
+{
+   if (Pro8_invalidViInt16Range (value, 0, 2)) return VI_ERROR_PARAMETER2;
+   return Pro8_WdmCcdmGetPowerW (instrumentHandle, value, power);
+}
+
+//---------------------------------------------------------------------------
+// Function: Set Temperature Difference
+// Purpose:  This function sets the temperature difference
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_WdmCwdmSetTempDiff (ViSession instrumentHandle, ViReal64 temperatureDifference)
+{
+   return Pro8_LsSetTempDiff (instrumentHandle, temperatureDifference);
+}
+
+//---------------------------------------------------------------------------
+// Function: Get Temperature Difference
+// Purpose:  This function returns the temperature difference
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_WdmCwdmGetTempDifference (ViSession instrumentHandle, ViInt16 value, ViPReal64 temperatureDifference)
+{
+   return Pro8_LsGetTempDifference(instrumentHandle, value, temperatureDifference);
+}
+
+//---------------------------------------------------------------------------
+// Function: Get Wavelength
+// Purpose:  This function returns the wavelength
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_WdmCwdmGetWavelength (ViSession instrumentHandle, ViReal64 *wavelength)
+{
+   return Pro8_WdmCwGetWavelength (instrumentHandle, 2, wavelength);
+}
+
+//---------------------------------------------------------------------------
+// Function: Get Frequency
+// Purpose:  This function returns the frequency
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_WdmCwdmGetFrequency (ViSession instrumentHandle, ViReal64 *frequency)
+{
+   return Pro8_WdmCwGetFrequency (instrumentHandle, 2, frequency);
+}
+
+
+//===========================================================================
+// WDM-ITC Functions
+//===========================================================================
+//---------------------------------------------------------------------------
+// Function: Set Laser Output
+// Purpose:  This function switches the output on or off
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_WdmItcSetOutput (ViSession instrumentHandle, ViInt16 output)
+{
+   return Pro8_LdcSetLdOutput (instrumentHandle, output);
+}
+
+//---------------------------------------------------------------------------
+// Function: Get Laser Output
+// Purpose:  This function returns the state of the output
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_WdmItcGetOutput (ViSession instrumentHandle, ViInt16 *output)
+{
+   return Pro8_LdcGetLdOutput (instrumentHandle, output);
+}
+
+//---------------------------------------------------------------------------
+// Function: Set Synchronous Modulation
+// Purpose:  This function switches the sync. modulation on and off
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_WdmItcSetSyncMod (ViSession instrumentHandle, ViInt16 synchronousModulation)
+{
+   return Pro8_LsSetSyncMod (instrumentHandle, synchronousModulation);
+}
+
+//---------------------------------------------------------------------------
+// Function: Get Synchronous Modulation
+// Purpose:  This function retuns the state of the sync. modulation
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_WdmItcGetSyncMod (ViSession instrumentHandle, ViInt16 *synchronousModulation)
+{
+   return Pro8_LsGetSyncMod (instrumentHandle, synchronousModulation);
+}
+
+//---------------------------------------------------------------------------
+// Function: Set LF Modulation
+// Purpose:  This function switches the LF modulation on and off
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_WdmItcSetLfMod (ViSession instrumentHandle, ViInt16 LFModulation)
+{
+   return Pro8_WdmCwSetLfMod (instrumentHandle, LFModulation);
+}
+
+//---------------------------------------------------------------------------
+// Function: Get LF Modulation
+// Purpose:  This function retuns the state of the LF modulation
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_WdmItcGetLfMod (ViSession instrumentHandle, ViInt16 *LFModulation)
+{
+   return Pro8_WdmCwGetLfMod (instrumentHandle, LFModulation);
+}
+
+//---------------------------------------------------------------------------
+// Function: Set LF Modulation Type
+// Purpose:  This function switches the LF modulation type
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_WdmItcSetLfModType (ViSession instrumentHandle, ViInt16 LFModulationType)
+{
+   return Pro8_WdmCwSetLfModType (instrumentHandle, LFModulationType);
+}
+
+//---------------------------------------------------------------------------
+// Function: Get LF Modulation Type
+// Purpose:  This function retuns the type of LF modulation
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_WdmItcGetLfModType (ViSession instrumentHandle, ViInt16 *LFModulationType)
+{
+   return Pro8_WdmCwGetLfModType (instrumentHandle, LFModulationType);
+}
+
+//---------------------------------------------------------------------------
+// Function: Set LF Modulation Amplitude
+// Purpose:  This function sets the LF modulation amplitude
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_WdmItcSetLfAmplitude (ViSession instrumentHandle, ViReal64 LFAmplitude)
+{
+   return Pro8_WdmCwSetLfAmplitude (instrumentHandle, LFAmplitude);
+}
+
+//---------------------------------------------------------------------------
+// Function: Get LF Modulation Amplitude
+// Purpose:  This function returns the LF modulation amplitude
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_WdmItcGetLfAmplitude (ViSession instrumentHandle, ViInt16 value, ViReal64 *LFAmplitude)
+{
+   return Pro8_WdmCwGetLfAmplitude (instrumentHandle, value, LFAmplitude);
+}
+
+//---------------------------------------------------------------------------
+// Function: Set LF Modulation Frequency
+// Purpose:  This function sets the LF modulation frequency
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_WdmItcSetLfFrequency (ViSession instrumentHandle, ViReal64 LFFrequency)
+{
+   return Pro8_WdmCwSetLfFrequency (instrumentHandle, LFFrequency);
+}
+
+//---------------------------------------------------------------------------
+// Function: Get LF Modulation Frequency
+// Purpose:  This function returns the LF modulation frequency
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_WdmItcGetLfFrequency (ViSession instrumentHandle, ViInt16 value, ViReal64 *LFFrequency)
+{
+   return Pro8_WdmCwGetLfFrequency (instrumentHandle, value, LFFrequency);
+}
+
+//---------------------------------------------------------------------------
+// Function: Set Laser Current
+// Purpose:  This function sets the current of the laserdiode
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_WdmItcSetLdCurrent (ViSession instrumentHandle, ViReal64 current)
+{
+   return Pro8_LdcSetLdCurrent (instrumentHandle, current);
+}
+
+//---------------------------------------------------------------------------
+// Function: Get Laser Current
+// Purpose:  This function returns the current of the laserdiode
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_WdmItcGetLdCurrent (ViSession instrumentHandle, ViInt16 value, ViReal64 *current)
+{
+   if (Pro8_invalidViInt16Range (value, 0, 2)) return VI_ERROR_PARAMETER2;
+   return Pro8_LdcGetLdCurrent (instrumentHandle, value, current);
+}
+
+//---------------------------------------------------------------------------
+// Function: Set LD Limit Current
+// Purpose:  This function sets the limit current of the laser diode
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_WdmItcSetLdLimit (ViSession instrumentHandle, ViReal64 limitCurrent)
+{
+   return Pro8_LdcSetLdLimit (instrumentHandle, limitCurrent);
+}
+
+//---------------------------------------------------------------------------
+// Function: Get LD Limit Current
+// Purpose:  This function returns the limit current of the laser diode
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_WdmItcGetLdLimit (ViSession instrumentHandle, ViInt16 value, ViReal64 *limitCurrent)
+{
+   return Pro8_LdcGetLdLimit (instrumentHandle, value, limitCurrent);
+}
+
+//---------------------------------------------------------------------------
+// Function: Set Temperature
+// Purpose:  This function sets the temperature
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_WdmItcSetTemp (ViSession instrumentHandle, ViReal64 temperature)
+{
+   return Pro8_TecSetTemp (instrumentHandle, temperature);
+}
+
+//---------------------------------------------------------------------------
+// Function: Get Temperature
+// Purpose:  This function returns the temperature
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_WdmItcGetTemp (ViSession instrumentHandle, ViInt16 value, ViReal64 *temperature)
+{
+   if (Pro8_invalidViInt16Range (value, 0, 2)) return VI_ERROR_PARAMETER2;
+   return Pro8_TecGetTemp (instrumentHandle, value, temperature);
+}
+
+//---------------------------------------------------------------------------
+// Function: Set Resistance
+// Purpose:  This function sets the resistance
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_WdmItcSetRes (ViSession instrumentHandle, ViReal64 resistance)
+{
+   return Pro8_TecSetRes (instrumentHandle, resistance);
+}
+
+//---------------------------------------------------------------------------
+// Function: Get Resistance
+// Purpose:  This function returns the resistance
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_WdmItcGetRes (ViSession instrumentHandle, ViInt16 value, ViReal64 *resistance)
+{
+   if (Pro8_invalidViInt16Range (value, 0, 2)) return VI_ERROR_PARAMETER2;
+   return Pro8_TecGetRes (instrumentHandle, value, resistance);
+}
+
+
+//===========================================================================
+// BBS Functions
+//===========================================================================
+//---------------------------------------------------------------------------
+// Function: Set LED Output
+// Purpose:  This function switches the output on or off
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_BbsSetOutput (ViSession instrumentHandle, ViInt16 output)
+{
+   return Pro8_SledSetOutput (instrumentHandle, output);
+}
+
+//---------------------------------------------------------------------------
+// Function: Get Laser Output
+// Purpose:  This function returns the state of the output
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_BbsGetOutput (ViSession instrumentHandle, ViInt16 *output)
+{
+   return Pro8_SledGetOutput (instrumentHandle, output);
+}
+
+//---------------------------------------------------------------------------
+// Function: Set Synchronous Modulation
+// Purpose:  This function switches the sync. modulation on and off
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_BbsSetSyncMod (ViSession instrumentHandle, ViInt16 synchronousModulation)
+{
+   return Pro8_LsSetSyncMod (instrumentHandle, synchronousModulation);
+}
+
+//---------------------------------------------------------------------------
+// Function: Get Synchronous Modulation
+// Purpose:  This function retuns the state of the sync. modulation
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_BbsGetSyncMod (ViSession instrumentHandle, ViInt16 *synchronousModulation)
+{
+   return Pro8_LsGetSyncMod (instrumentHandle, synchronousModulation);
+}
+
+//---------------------------------------------------------------------------
+// Function: Get Laser Power
+// Purpose:  This function returns the laser power (dBm)
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_BbsGetPowerdBm (ViSession instrumentHandle, ViReal64 *power)
+{
+   return Pro8_WdmCcdmGetPowerdBm (instrumentHandle, 2, power);
+}
+
+//---------------------------------------------------------------------------
+// Function: Get Laser Power
+// Purpose:  This function returns the laser power (W)
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_BbsGetPowerW (ViSession instrumentHandle, ViReal64 *power)
+{
+   return Pro8_WdmCcdmGetPowerW (instrumentHandle, 2, power);
+}
+
+
+//===========================================================================
+// ELCH Functions
+//===========================================================================
+//---------------------------------------------------------------------------
+// Function: Set ELCH Parameters
+// Purpose:  This function sets the parameters for ELCH
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_ElchSetParameters (ViSession instrumentHandle, ViInt16 steps, ViInt16 measurementValues)
+{
+   ViStatus status = VI_SUCCESS;
+   ViUInt32 retCnt = 0;
+   ViUInt16 stb;
+   ViChar   buffer[CMD_BUF_SIZE];
+
+   //Check input parameter ranges
+   if (Pro8_invalidViInt16Range (steps, 2, 1001))           return VI_ERROR_PARAMETER2;
+   if (Pro8_invalidViInt16Range (measurementValues, 1, 8))  return VI_ERROR_PARAMETER3;
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   //Formatting
+   Pro8_Fmt (buffer, ":ELCH:STEPS %d;:ELCH:MEAS %d", steps, measurementValues);
+   //Writing - Poll STB - Check EAV Bit and read error
+   if ((status = Pro8_Write (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
+   //Ready
+   return Pro8_Unlock (instrumentHandle, status);
+}
+
+//---------------------------------------------------------------------------
+// Function: Get ELCH Parameters
+// Purpose:  This function returns the parameters for ELCH
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_ElchGetParameters (ViSession instrumentHandle, ViInt16 *steps, ViInt16 *measurementValues)
+{
+   ViStatus  status     = VI_SUCCESS;
+   ViString  queries[]  = {":ELCH:STEPS?", ":ELCH:MEAS?"};
+   ViString  answers[2];
+   ViChar    response[RESPONSE_BUF_SIZE];
+   ViBoolean answer;
+   ViString  format[]   = {"%*s %d", "%d"};
+
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   if ((status = Pro8_GetAnswer (instrumentHandle, &answer)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Writing - Poll STB - Check EAV Bit and read error - Reading
+   if ((status = Pro8_CompoundQuery (instrumentHandle, 2, queries, response, sizeof (response), answers)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_Scan (answers[0], format[answer], steps)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_Scan (answers[1], format[answer], measurementValues)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Ready
+   return Pro8_Unlock (instrumentHandle, status);
+}
+
+//---------------------------------------------------------------------------
+// Function: ELCH Run
+// Purpose:  This function starts a electrical characterisation
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_ElchRun (ViSession instrumentHandle, ViInt16 function)
+{
+   ViStatus status = VI_SUCCESS;
+   ViUInt32 retCnt = 0;
+   ViUInt16 stb;
+   ViChar   buffer[CMD_BUF_SIZE];
+
+   //Check input parameter ranges
+   if (Pro8_invalidViInt16Range (function, 0, 2)) return VI_ERROR_PARAMETER2;
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   //Formatting
+   Pro8_Fmt (buffer, ":ELCH:RUN %d", function);
+   //Writing - Poll STB - Check EAV Bit and read error
+   if ((status = Pro8_Write (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
+   //Ready
+   return Pro8_Unlock (instrumentHandle, status);
+}
+
+//---------------------------------------------------------------------------
+// Function: Get ELCH Measurement Values
+// Purpose:  This function returns ELCH measurement values
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_ElchGetMeasVal (ViSession instrumentHandle, ViInt16 measurementValues, ViReal64 *value1, ViReal64 *value2, ViReal64 *value3, ViReal64 *value4, ViReal64 *value5, ViReal64 *value6, ViReal64 *value7, ViReal64 *value8)
+{
+   ViStatus  status = VI_SUCCESS;
+   ViUInt32  retCnt = 0;
+   ViUInt16  stb;
+   ViBoolean answer;
+   ViString  answers[1];
+   ViChar    response[RESPONSE_BUF_SIZE];
+   ViReal64  values[8];
+   ViReal64  *targets[8];
+   ViInt16   i;
+
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   if ((status = Pro8_GetAnswer (instrumentHandle, &answer)) < 0) return Pro8_Unlock (instrumentHandle, status);
+
+   //Check input parameter ranges
+   if (Pro8_invalidViInt16Range (measurementValues, 1, 8)) return Pro8_Unlock (instrumentHandle, VI_ERROR_PARAMETER3);
+   //Writing - Poll STB - Check EAV Bit and read error
+   if ((status = Pro8_Write (instrumentHandle, ":ELCH:TRIG?", 11, &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
+   //Reading
+   if ((status = Pro8_ReadAnswers (instrumentHandle, 1, response, sizeof (response), answers)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_ParseValues (answers[0], answer, measurementValues, values)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   targets[0] = value1;
+   targets[1] = value2;
+   targets[2] = value3;
+   targets[3] = value4;
+   targets[4] = value5;
+   targets[5] = value6;
+   targets[6] = value7;
+   targets[7] = value8;
+   for (i = 0; i < measurementValues; i++)
+   {
+      if (targets[i]) *targets[i] = values[i];
+   }
+   //Ready
+   return Pro8_Unlock (instrumentHandle, status);
+}
+
+//---------------------------------------------------------------------------
+// Function: ELCH Acquire
+// Purpose:  This function runs a triggered electrical characterisation with
+//           steps steps and returns measurementValues values per step in
+//           values[step * measurementValues + i]. The set values and the
+//           measurement positions are configured by the module functions
+//           before. Several :ELCH:TRIG? queries are sent as one compound
+//           query, so the instrument runs the steps of a message back to
+//           back and the characterisation takes one round trip per
+//           message instead of one per step. After each message callback
+//           (may be VI_NULL) is called with the number of steps done, the
+//           values of these steps are valid. It returns VI_FALSE to stop
+//           the characterisation. count returns the number of steps
+//           acquired. The function is a transaction, the callback is
+//           called within it. Pro8_AsyncCall runs it in the background.
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_ElchAcquire (ViSession instrumentHandle, ViInt16 steps, ViInt16 measurementValues, ViReal64 values[],
+                                    Pro8_ElchCallback callback, ViAddr callbackData, ViInt32 *count)
+{
+   ViStatus  status   = VI_SUCCESS;
+   ViStatus  stopped;
+   ViUInt32  retCnt   = 0;
+   ViUInt32  length;
+   ViUInt16  stb;
+   ViBoolean answer;
+   ViInt32   done     = 0;
+   ViInt16   batch, n, i;
+   ViString  answers[PRO8_ELCH_MAX_BATCH];
+   ViChar    command[PRO8_BATCH_MAX_LENGTH + 1];
+   ViChar    response[RESPONSE_BUF_SIZE];
+
+   //Check input parameter ranges
+   if (Pro8_invalidViInt16Range (steps, 2, 1001))           return VI_ERROR_PARAMETER2;
+   if (Pro8_invalidViInt16Range (measurementValues, 1, 8))  return VI_ERROR_PARAMETER3;
+   if (values == VI_NULL)                                   return VI_ERROR_PARAMETER4;
+   if (count) *count = 0;
+   //Steps per message - the responses fit the response buffer
+   batch = (ViInt16)((RESPONSE_BUF_SIZE - 2) / (measurementValues * PRO8_ELCH_VALUE_WIDTH + PRO8_ELCH_HEADER_WIDTH));
+   if (batch > PRO8_ELCH_MAX_BATCH) batch = PRO8_ELCH_MAX_BATCH;
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   if ((status = Pro8_GetAnswer (instrumentHandle, &answer)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Parameters and start in triggered mode
+   Pro8_Fmt (command, ":ELCH:STEPS %d;:ELCH:MEAS %d;:ELCH:RUN 2", steps, measurementValues);
+   if ((status = Pro8_Write (instrumentHandle, command, StringLength (command), &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
+   //Steps
+   while (done < steps)
+   {
+      //Formatting
+      n = (steps - done < batch) ? (ViInt16)(steps - done) : batch;
+      for (i = 0, length = 0; i < n; i++)
+      {
+         if (i) command[length++] = ';';
+         memcpy (&command[length], ":ELCH:TRIG?", 11);
+         length += 11;
+      }
+      //Writing - Poll STB - Check EAV Bit and read error - Reading
+      if ((status = Pro8_Write (instrumentHandle, command, length, &retCnt)) < 0) break;
+      if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) break;
+      if (stb & 0x0004)
+      {
+         status = Pro8_GetInstrumentError (instrumentHandle);
+         break;
+      }
+      if ((status = Pro8_ReadAnswers (instrumentHandle, n, response, sizeof (response), answers)) < 0) break;
+      for (i = 0; (i < n) && (status >= 0); i++) status = Pro8_ParseValues (answers[i], answer, measurementValues, &values[(done + i) * measurementValues]);
+      if (status < 0) break;
+      done += n;
+      if (count) *count = done;
+      //Progress
+      if (callback && (callback (instrumentHandle, done, steps, callbackData) == VI_FALSE)) break;
+   }
+   //Stopped early - the instrument waits for further triggers
+   if (done < steps)
+   {
+      if (((stopped = Pro8_Write (instrumentHandle, ":ELCH:RUN 0", 11, &retCnt)) >= 0) && ((stopped = Pro8_WaitForFinBit (instrumentHandle, &stb)) >= 0))
+      {
+         if (stb & 0x0004) stopped = Pro8_GetInstrumentError (instrumentHandle);
+      }
+      if (status >= 0) status = stopped;
+   }
+   //Ready
+   return Pro8_Unlock (instrumentHandle, status);
+}
+
+//---------------------------------------------------------------------------
+// Function: LDC Set ELCH Set Values
+// Purpose:  This function sets the start and stop values for ELCH
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_LdcSetElchSetVal (ViSession instrumentHandle, ViInt16 setParameter, ViReal64 startValue, ViReal64 stopValue)
+{
+   ViStatus status = VI_SUCCESS;
+   ViUInt32 retCnt = 0;
+   ViUInt16 stb;
+   ViChar   buffer[CMD_BUF_SIZE];
+   ViString command[] = {"ILD", "IMD"};
+
+   //Check input parameter ranges
+   if (Pro8_invalidViInt16Range (setParameter, 0, 1)) return VI_ERROR_PARAMETER2;
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   //Formatting
+   Pro8_Fmt (buffer, ":%s:START %f;:%s:STOP %f", command[setParameter], startValue, command[setParameter], stopValue);
+   //Writing - Poll STB - Check EAV Bit and read error
+   if ((status = Pro8_Write (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
+   //Ready
+   return Pro8_Unlock (instrumentHandle, status);
+}
+
+//---------------------------------------------------------------------------
+// Function: LDC Get ELCH Set Values
+// Purpose:  This function returns the start and stop values for ELCH
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_LdcGetElchSetVal (ViSession instrumentHandle, ViInt16 setParameter, ViReal64 *startValue, ViReal64 *stopValue)
+{
+   ViStatus  status     = VI_SUCCESS;
+   ViString  command1[] = {":ILD:START?", ":IMD:START?"};
+   ViString  command2[] = {":ILD:STOP?",  ":IMD:STOP?" };
+   ViString  queries[2], answers[2];
+   ViChar    response[RESPONSE_BUF_SIZE];
+   ViBoolean answer;
+
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   if ((status = Pro8_GetAnswer (instrumentHandle, &answer)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Check input parameter ranges
+   if (Pro8_invalidViInt16Range (setParameter, 0, 1)) return Pro8_Unlock (instrumentHandle, VI_ERROR_PARAMETER2);
+   //Writing - Poll STB - Check EAV Bit and read error - Reading
+   queries[0] = command1[setParameter];
+   queries[1] = command2[setParameter];
+   if ((status = Pro8_CompoundQuery (instrumentHandle, 2, queries, response, sizeof (response), answers)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_ParseReal (answers[0], answer, startValue)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_ParseReal (answers[1], answer, stopValue)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Ready
+   return Pro8_Unlock (instrumentHandle, status);
+}
+
+//---------------------------------------------------------------------------
+// Function: LDC Set ELCH Measurement Value Position
+// Purpose:  This function sets the position of the measurement value
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_LdcSetElchMeasVal (ViSession instrumentHandle, ViInt16 measurementParameter, ViInt16 position)
+{
+   ViStatus status = VI_SUCCESS;
+   ViUInt32 retCnt = 0;
+   ViUInt16 stb;
+   ViChar   buffer[CMD_BUF_SIZE];
+   ViString command[] = {"ILD", "IMD", "VLD"};
+
+   //Check input parameter ranges
+   if (Pro8_invalidViInt16Range (measurementParameter, 0, 2))  return VI_ERROR_PARAMETER2;
+   if (Pro8_invalidViInt16Range (position, 1, 8))              return VI_ERROR_PARAMETER3;
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   //Formatting
+   Pro8_Fmt (buffer, ":%s:MEAS %d", command[measurementParameter], position);
+   //Writing - Poll STB - Check EAV Bit and read error
+   if ((status = Pro8_Write (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
+   //Ready
+   return Pro8_Unlock (instrumentHandle, status);
+}
+
+//---------------------------------------------------------------------------
+// Function: LDC Get ELCH Measurement Value Position
+// Purpose:  This function returns the position of the measurement value
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_LdcGetElchMeasVal (ViSession instrumentHandle, ViInt16 measurementParameter, ViInt16 *position)
+{
+   ViStatus  status = VI_SUCCESS;
+   ViUInt32  retCnt = 0;
+   ViUInt16  stb;
+   ViString  command[] = {":ILD:MEAS?", ":IMD:MEAS?", ":VLD:MEAS?"};
+   ViBoolean answer;
+   ViString  format[] = {"%*s %d", "%d"};
+
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   if ((status = Pro8_GetAnswer (instrumentHandle, &answer)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Check input parameter ranges
+   if (Pro8_invalidViInt16Range (measurementParameter, 0, 2))  return Pro8_Unlock (instrumentHandle, VI_ERROR_PARAMETER2);
+   //Writing - Poll STB - Check EAV Bit and read error - Reading
+   if ((status = Pro8_Write (instrumentHandle, command[measurementParameter], StringLength (command[measurementParameter]), &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
+   if ((status = Pro8_Scanf (instrumentHandle, format[answer], position)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Ready
+   return Pro8_Unlock (instrumentHandle, status);
+}
+
+//---------------------------------------------------------------------------
+// Function: MLC Set ELCH Set Values
+// Purpose:  This function sets the start and stop values for ELCH
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_MlcSetElchSetVal (ViSession instrumentHandle, ViInt16 setParameter, ViReal64 startValue, ViReal64 stopValue)
+{
+   return Pro8_LdcSetElchSetVal (instrumentHandle, setParameter, startValue, stopValue);
+}
+
+//---------------------------------------------------------------------------
+// Function: MLC Get ELCH Set Values
+// Purpose:  This function returns the start and stop values for ELCH
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_MlcGetElchSetVal (ViSession instrumentHandle, ViInt16 setParameter, ViReal64 *startValue, ViReal64 *stopValue)
+{
+   return Pro8_LdcGetElchSetVal (instrumentHandle, setParameter, startValue, stopValue);
+}
+
+//---------------------------------------------------------------------------
+// Function: MLC Set ELCH Measurement Value Position
+// Purpose:  This function sets the position of the measurement value
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_MlcSetElchMeasVal (ViSession instrumentHandle, ViInt16 measurementParameter, ViInt16 position)
+{
+   ViStatus  status = VI_SUCCESS;
+   ViUInt32  retCnt = 0;
+   ViUInt16  stb;
+   ViChar    buffer[CMD_BUF_SIZE];
+   ViString  command[] = {"ILD", "IMD"};
+
+   //Check input parameter ranges
+   if (Pro8_invalidViInt16Range (measurementParameter, 0, 1))  return VI_ERROR_PARAMETER2;
+   if (Pro8_invalidViInt16Range (position, 1, 8))              return VI_ERROR_PARAMETER3;
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   //Formatting
+   Pro8_Fmt (buffer, ":%s:MEAS %d", command[measurementParameter], position);
+   //Writing - Poll STB - Check EAV Bit and read error
+   if ((status = Pro8_Write (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
+   //Ready
+   return Pro8_Unlock (instrumentHandle, status);
+}
+
+//---------------------------------------------------------------------------
+// Function: MLC Get ELCH Measurement Value Position
+// Purpose:  This function returns the position of the measurement value
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_MlcGetElchMeasVal (ViSession instrumentHandle, ViInt16 measurementParameter, ViInt16 *position)
+{
+   ViStatus  status = VI_SUCCESS;
+   ViUInt32  retCnt = 0;
+   ViUInt16  stb;
+   ViString  command[] = {":ILD:MEAS?", ":IMD:MEAS?"};
+   ViBoolean answer;
+   ViString  format[] = {"%*s %d", "%d"};
+
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   if ((status = Pro8_GetAnswer (instrumentHandle, &answer)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Check input parameter ranges
+   if (Pro8_invalidViInt16Range (measurementParameter, 0, 1))  return Pro8_Unlock (instrumentHandle, VI_ERROR_PARAMETER2);
+   //Writing - Poll STB - Check EAV Bit and read error - Reading
+   if ((status = Pro8_Write (instrumentHandle, command[measurementParameter], StringLength (command[measurementParameter]), &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
+   if ((status = Pro8_Scanf (instrumentHandle, format[answer], position)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Ready
+   return Pro8_Unlock (instrumentHandle, status);
+}
+
+//---------------------------------------------------------------------------
+// Function: TEC Set ELCH Measurement Value Position
+// Purpose:  This function sets the position of the measurement value
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_TecSetElchMeasVal (ViSession instrumentHandle, ViInt16 measurementParameter, ViInt16 position)
+{
+   ViStatus status = VI_SUCCESS;
+   ViUInt32 retCnt = 0;
+   ViUInt16 stb;
+   ViChar   buffer[CMD_BUF_SIZE];
+   ViString command[] = {"ITE", "VTE", "RESI", "TEMP"};
+
+   //Check input parameter ranges
+   if (Pro8_invalidViInt16Range (measurementParameter, 0, 3))  return VI_ERROR_PARAMETER2;
+   if (Pro8_invalidViInt16Range (position, 1, 8))              return VI_ERROR_PARAMETER3;
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   //Formatting
+   Pro8_Fmt (buffer, ":%s:MEAS %d", command[measurementParameter], position);
+   //Writing - Poll STB - Check EAV Bit and read error
+   if ((status = Pro8_Write (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
+   //Ready
+   return Pro8_Unlock (instrumentHandle, status);
+}
+
+//---------------------------------------------------------------------------
+// Function: TEC Get ELCH Measurement Value Position
+// Purpose:  This function returns the position of the measurement value
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_TecGetElchMeasVal (ViSession instrumentHandle, ViInt16 measurementParameter, ViInt16 *position)
+{
+   ViStatus  status = VI_SUCCESS;
+   ViUInt32  retCnt = 0;
+   ViUInt16  stb;
+   ViString  command[] = {":ITE:MEAS?", ":VTE:MEAS?", ":RESI:MEAS?", ":TEMP:MEAS?"};
+   ViBoolean answer;
+   ViString  format[] = {"%*s %d", "%d"};
+
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   if ((status = Pro8_GetAnswer (instrumentHandle, &answer)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Check input parameter ranges
+   if (Pro8_invalidViInt16Range (measurementParameter, 0, 3))  return Pro8_Unlock (instrumentHandle, VI_ERROR_PARAMETER2);
+   //Writing - Poll STB - Check EAV Bit and read error - Reading
+   if ((status = Pro8_Write (instrumentHandle, command[measurementParameter], StringLength (command[measurementParameter]), &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
+   if ((status = Pro8_Scanf (instrumentHandle, format[answer], position)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Ready
+   return Pro8_Unlock (instrumentHandle, status);
+}
+
+//---------------------------------------------------------------------------
+// Function: ITC Set ELCH Set Values
+// Purpose:  This function sets the start and stop values for ELCH
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_ItcSetElchSetVal (ViSession instrumentHandle, ViInt16 setParameter, ViReal64 startValue, ViReal64 stopValue)
+{
+   ViStatus status = VI_SUCCESS;
+   ViUInt32 retCnt = 0;
+   ViUInt16 stb;
+   ViChar   buffer[CMD_BUF_SIZE];
+   ViString command[] = {"ILD", "IMD", "VBIAS"};
+
+   //Check input parameter ranges
+   if (Pro8_invalidViInt16Range (setParameter, 0, 2)) return VI_ERROR_PARAMETER2;
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   //Formatting
+   Pro8_Fmt (buffer, ":%s:START %f;:%s:STOP %f", command[setParameter], startValue, command[setParameter], stopValue);
+   //Writing - Poll STB - Check EAV Bit and read error
+   if ((status = Pro8_Write (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
+   //Ready
+   return Pro8_Unlock (instrumentHandle, status);
+}
+
+//---------------------------------------------------------------------------
+// Function: ITC Get ELCH Set Values
+// Purpose:  This function returns the start and stop values for ELCH
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_ItcGetElchSetVal (ViSession instrumentHandle, ViInt16 setParameter, ViReal64 *startValue, ViReal64 *stopValue)
+{
+   ViStatus  status     = VI_SUCCESS;
+   ViString  command1[] = {":ILD:START?", ":IMD:START?", ":VBIAS:START?"};
+   ViString  command2[] = {":ILD:STOP?",  ":IMD:STOP?" , ":VBIAS:STOP?" };
+   ViString  queries[2], answers[2];
+   ViChar    response[RESPONSE_BUF_SIZE];
+   ViBoolean answer;
+
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   if ((status = Pro8_GetAnswer (instrumentHandle, &answer)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Check input parameter ranges
+   if (Pro8_invalidViInt16Range (setParameter, 0, 2)) return Pro8_Unlock (instrumentHandle, VI_ERROR_PARAMETER2);
+   //Writing - Poll STB - Check EAV Bit and read error - Reading
+   queries[0] = command1[setParameter];
+   queries[1] = command2[setParameter];
+   if ((status = Pro8_CompoundQuery (instrumentHandle, 2, queries, response, sizeof (response), answers)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_ParseReal (answers[0], answer, startValue)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_ParseReal (answers[1], answer, stopValue)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Ready
+   return Pro8_Unlock (instrumentHandle, status);
+}
+
+//---------------------------------------------------------------------------
+// Function: ITC Set ELCH Measurement Value Position
+// Purpose:  This function sets the position of the measurement value
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_ItcSetElchMeasVal (ViSession instrumentHandle, ViInt16 measurementParameter, ViInt16 position)
+{
+   ViStatus status = VI_SUCCESS;
+   ViUInt32 retCnt = 0;
+   ViUInt16 stb;
+   ViChar   buffer[CMD_BUF_SIZE];
+   ViString command[] = {"ILD", "IMD", "VLD", "ITE", "VTE", "RESI", "TEMP"};
+
+   //Check input parameter ranges
+   if (Pro8_invalidViInt16Range (measurementParameter, 0, 6))  return VI_ERROR_PARAMETER2;
+   if (Pro8_invalidViInt16Range (position, 1, 8))              return VI_ERROR_PARAMETER3;
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   //Formatting
+   Pro8_Fmt (buffer, ":%s:MEAS %d", command[measurementParameter], position);
+   //Writing - Poll STB - Check EAV Bit and read error
+   if ((status = Pro8_Write (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
+   //Ready
+   return Pro8_Unlock (instrumentHandle, status);
+}
+
+//---------------------------------------------------------------------------
+// Function: ITC Get ELCH Measurement Value Position
+// Purpose:  This function returns the position of the measurement value
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_ItcGetElchMeasVal (ViSession instrumentHandle, ViInt16 measurementParameter, ViInt16 *position)
+{
+   ViStatus status = VI_SUCCESS;
+   ViUInt32 retCnt = 0;
+   ViUInt16 stb;
+   ViString command[] = {":ILD:MEAS?", ":IMD:MEAS?", ":VLD:MEAS?", ":ITE:MEAS?", ":VTE:MEAS?", ":RESI:MEAS?", ":TEMP:MEAS?"};
+   ViBoolean answer;
+   ViString  format[] = {"%*s %d", "%d"};
+
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   if ((status = Pro8_GetAnswer (instrumentHandle, &answer)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Check input parameter ranges
+   if (Pro8_invalidViInt16Range (measurementParameter, 0, 6))  return Pro8_Unlock (instrumentHandle, VI_ERROR_PARAMETER2);
+   //Writing - Poll STB - Check EAV Bit and read error - Reading
+   if ((status = Pro8_Write (instrumentHandle, command[measurementParameter], StringLength (command[measurementParameter]), &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
+   if ((status = Pro8_Scanf (instrumentHandle, format[answer], position)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Ready
+   return Pro8_Unlock (instrumentHandle, status);
+}
+
+//---------------------------------------------------------------------------
+// Function: PDA Set ELCH Set Values
+// Purpose:  This function sets the start and stop values for ELCH
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_PdaSetElchSetVal (ViSession instrumentHandle, ViInt16 setParameter, ViReal64 startValue, ViReal64 stopValue)
+{
+   ViStatus status = VI_SUCCESS;
+   ViUInt32 retCnt = 0;
+   ViUInt16 stb;
+   ViChar   buffer[CMD_BUF_SIZE];
+   ViString command[] = {"VBIAS"};
+
+   //Check input parameter ranges
+   if (Pro8_invalidViInt16Range (setParameter, 0, 0)) return VI_ERROR_PARAMETER2;
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   //Formatting
+   Pro8_Fmt (buffer, ":%s:START %f;:%s:STOP %f", command[setParameter], startValue, command[setParameter], stopValue);
+   //Writing - Poll STB - Check EAV Bit and read error
+   if ((status = Pro8_Write (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
+   //Ready
+   return Pro8_Unlock (instrumentHandle, status);
+}
+
+//---------------------------------------------------------------------------
+// Function: PDA Get ELCH Set Values
+// Purpose:  This function returns the start and stop values for ELCH
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_PdaGetElchSetVal (ViSession instrumentHandle, ViInt16 setParameter, ViReal64 *startValue, ViReal64 *stopValue)
+{
+   ViStatus  status     = VI_SUCCESS;
+   ViString  command1[] = {":VBIAS:START?"};
+   ViString  command2[] = {":VBIAS:STOP?" };
+   ViString  queries[2], answers[2];
+   ViChar    response[RESPONSE_BUF_SIZE];
+   ViBoolean answer;
+
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   if ((status = Pro8_GetAnswer (instrumentHandle, &answer)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Check input parameter ranges
+   if (Pro8_invalidViInt16Range (setParameter, 0, 0)) return Pro8_Unlock (instrumentHandle, VI_ERROR_PARAMETER2);
+   //Writing - Poll STB - Check EAV Bit and read error - Reading
+   queries[0] = command1[setParameter];
+   queries[1] = command2[setParameter];
+   if ((status = Pro8_CompoundQuery (instrumentHandle, 2, queries, response, sizeof (response), answers)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_ParseReal (answers[0], answer, startValue)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_ParseReal (answers[1], answer, stopValue)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Ready
+   return Pro8_Unlock (instrumentHandle, status);
+}
+
+//---------------------------------------------------------------------------
+// Function: PDA Set ELCH Measurement Value Position
+// Purpose:  This function sets the position of the measurement value
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_PdaSetElchMeasVal (ViSession instrumentHandle, ViInt16 measurementParameter, ViInt16 position)
+{
+   ViStatus status = VI_SUCCESS;
+   ViUInt32 retCnt = 0;
+   ViUInt16 stb;
+   ViChar   buffer[CMD_BUF_SIZE];
+   ViString command[] = {"IPD"};
+
+   //Check input parameter ranges
+   if (Pro8_invalidViInt16Range (measurementParameter, 0, 0))  return VI_ERROR_PARAMETER2;
+   if (Pro8_invalidViInt16Range (position, 1, 8))              return VI_ERROR_PARAMETER3;
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   //Formatting
+   Pro8_Fmt (buffer, ":%s:MEAS %d", command[measurementParameter], position);
+   //Writing - Poll STB - Check EAV Bit and read error
+   if ((status = Pro8_Write (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
+   //Ready
+   return Pro8_Unlock (instrumentHandle, status);
+}
+
+//---------------------------------------------------------------------------
+// Function: PDA Get ELCH Measurement Value Position
+// Purpose:  This function returns the position of the measurement value
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_PdaGetElchMeasVal (ViSession instrumentHandle, ViInt16 measurementParameter, ViInt16 *position)
+{
+   ViStatus  status = VI_SUCCESS;
+   ViUInt32  retCnt = 0;
+   ViUInt16  stb;
+   ViString  command[] = {":IPD:MEAS?"};
+   ViBoolean answer;
+   ViString  format[] = {"%*s %d", "%d"};
+
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   if ((status = Pro8_GetAnswer (instrumentHandle, &answer)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Check input parameter ranges
+   if (Pro8_invalidViInt16Range (measurementParameter, 0, 0))  return Pro8_Unlock (instrumentHandle, VI_ERROR_PARAMETER2);
+   //Writing - Poll STB - Check EAV Bit and read error - Reading
+   if ((status = Pro8_Write (instrumentHandle, command[measurementParameter], StringLength (command[measurementParameter]), &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
+   if ((status = Pro8_Scanf (instrumentHandle, format[answer], position)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Ready
+   return Pro8_Unlock (instrumentHandle, status);
+}
+
+//---------------------------------------------------------------------------
+// Function: LS Set ELCH Set Values
+// Purpose:  This function sets the start and stop values for ELCH
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_LsSetElchSetVal (ViSession instrumentHandle, ViInt16 setParameter, ViReal64 startValue, ViReal64 stopValue)
+{
+   ViStatus status = VI_SUCCESS;
+   ViUInt32 retCnt = 0;
+   ViUInt16 stb;
+   ViChar   buffer[CMD_BUF_SIZE];
+   ViString command[] = {"P_DBM", "P_W"};
+
+   //Check input parameter ranges
+   if (Pro8_invalidViInt16Range (setParameter, 0, 1)) return VI_ERROR_PARAMETER2;
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   //Formatting
+   Pro8_Fmt (buffer, ":%s:START %f;:%s:STOP %f", command[setParameter], startValue, command[setParameter], stopValue);
+   //Writing - Poll STB - Check EAV Bit and read error
+   if ((status = Pro8_Write (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
+   //Ready
+   return Pro8_Unlock (instrumentHandle, status);
+}
+
+//---------------------------------------------------------------------------
+// Function: LS Get ELCH Set Values
+// Purpose:  This function returns the start and stop values for ELCH
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_LsGetElchSetVal (ViSession instrumentHandle, ViInt16 setParameter, ViReal64 *startValue, ViReal64 *stopValue)
+{
+   ViStatus  status     = VI_SUCCESS;
+   ViString  command1[] = {":P_DBM:START?", ":P_W:START?"};
+   ViString  command2[] = {":P_DBM:STOP?",  ":P_W:STOP?" };
+   ViString  queries[2], answers[2];
+   ViChar    response[RESPONSE_BUF_SIZE];
+   ViBoolean answer;
+
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   if ((status = Pro8_GetAnswer (instrumentHandle, &answer)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Check input parameter ranges
+   if (Pro8_invalidViInt16Range (setParameter, 0, 1)) return Pro8_Unlock (instrumentHandle, VI_ERROR_PARAMETER2);
+   //Writing - Poll STB - Check EAV Bit and read error - Reading
+   queries[0] = command1[setParameter];
+   queries[1] = command2[setParameter];
+   if ((status = Pro8_CompoundQuery (instrumentHandle, 2, queries, response, sizeof (response), answers)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_ParseReal (answers[0], answer, startValue)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_ParseReal (answers[1], answer, stopValue)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Ready
+   return Pro8_Unlock (instrumentHandle, status);
+}
+
+//---------------------------------------------------------------------------
+// Function: SLED Set ELCH Set Values
+// Purpose:  This function sets the start and stop values for ELCH
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_SledSetElchSetVal (ViSession instrumentHandle, ViInt16 setParameter, ViReal64 startValue, ViReal64 stopValue)
+{
+   return Pro8_LsSetElchSetVal (instrumentHandle, setParameter, startValue, stopValue);
+}
+
+//---------------------------------------------------------------------------
+// Function: SLED Get ELCH Set Values
+// Purpose:  This function returns the start and stop values for ELCH
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_SledGetElchSetVal (ViSession instrumentHandle, ViInt16 setParameter, ViReal64 *startValue, ViReal64 *stopValue)
+{
+   return Pro8_LsGetElchSetVal (instrumentHandle, setParameter, startValue, stopValue);
+}
+
+//---------------------------------------------------------------------------
+// Function: WDM-CW Set ELCH Set Values
+// Purpose:  This function sets the start and stop values for ELCH
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_CwSetElchSetVal (ViSession instrumentHandle, ViInt16 setParameter, ViReal64 startValue, ViReal64 stopValue)
+{
+   return Pro8_LsSetElchSetVal (instrumentHandle, setParameter, startValue, stopValue);
+}
+
+//---------------------------------------------------------------------------
+// Function: WDM_CW Get ELCH Set Values
+// Purpose:  This function returns the start and stop values for ELCH
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_CwGetElchSetVal (ViSession instrumentHandle, ViInt16 setParameter, ViReal64 *startValue, ViReal64 *stopValue)
+{
+   return Pro8_LsGetElchSetVal (instrumentHandle, setParameter, startValue, stopValue);
+}
+
+//---------------------------------------------------------------------------
+// Function: WDM-EA Set ELCH Set Values
+// Purpose:  This function sets the start and stop values for ELCH
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_EaSetElchSetVal (ViSession instrumentHandle, ViInt16 setParameter, ViReal64 startValue, ViReal64 stopValue)
+{
+   return Pro8_LsSetElchSetVal (instrumentHandle, setParameter, startValue, stopValue);
+}
+
+//---------------------------------------------------------------------------
+// Function: WDM_EA Get ELCH Set Values
+// Purpose:  This function returns the start and stop values for ELCH
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_EaGetElchSetVal (ViSession instrumentHandle, ViInt16 setParameter, ViReal64 *startValue, ViReal64 *stopValue)
+{
+   return Pro8_LsGetElchSetVal (instrumentHandle, setParameter, startValue, stopValue);
+}
+
+//---------------------------------------------------------------------------
+// Function: WDM-DIR Set ELCH Set Values
+// Purpose:  This function sets the start and stop values for ELCH
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_DirSetElchSetVal (ViSession instrumentHandle, ViInt16 setParameter, ViReal64 startValue, ViReal64 stopValue)
+{
+   return Pro8_LsSetElchSetVal (instrumentHandle, setParameter, startValue, stopValue);
+}
+
+//---------------------------------------------------------------------------
+// Function: WDM_DIR Get ELCH Set Values
+// Purpose:  This function returns the start and stop values for ELCH
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_DirGetElchSetVal (ViSession instrumentHandle, ViInt16 setParameter, ViReal64 *startValue, ViReal64 *stopValue)
+{
+   return Pro8_LsGetElchSetVal (instrumentHandle, setParameter, startValue, stopValue);
+}
+
+//---------------------------------------------------------------------------
+// Function: WDM-CCDM Set ELCH Set Values
+// Purpose:  This function sets the start and stop values for ELCH
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_CcdmSetElchSetVal (ViSession instrumentHandle, ViInt16 setParameter, ViReal64 startValue, ViReal64 stopValue)
+{
+   return Pro8_LsSetElchSetVal (instrumentHandle, setParameter, startValue, stopValue);
+}
+
+//---------------------------------------------------------------------------
+// Function: WDM_CCDM Get ELCH Set Values
+// Purpose:  This function returns the start and stop values for ELCH
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_CcdmGetElchSetVal (ViSession instrumentHandle, ViInt16 setParameter, ViReal64 *startValue, ViReal64 *stopValue)
+{
+   return Pro8_LsGetElchSetVal (instrumentHandle, setParameter, startValue, stopValue);
+}
+
+//---------------------------------------------------------------------------
+// Function: WDM-CCDM Set ELCH Measurement Value Position
+// Purpose:  This function sets the position of the measurement value
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_CcdmSetElchMeasVal (ViSession instrumentHandle, ViInt16 measurementParameter, ViInt16 position)
+{
+   ViStatus status = VI_SUCCESS;
+   ViUInt32 retCnt = 0;
+   ViUInt16 stb;
+   ViChar   buffer[CMD_BUF_SIZE];
+   ViString command[] = {"P_DBM", "P_W"};
+
+   //Check input parameter ranges
+   if (Pro8_invalidViInt16Range (measurementParameter, 0, 1))  return VI_ERROR_PARAMETER2;
+   if (Pro8_invalidViInt16Range (position, 1, 8))              return VI_ERROR_PARAMETER3;
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   //Formatting
+   Pro8_Fmt (buffer, ":%s:MEAS %d", command[measurementParameter], position);
+   //Writing - Poll STB - Check EAV Bit and read error
+   if ((status = Pro8_Write (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
+   //Ready
+   return Pro8_Unlock (instrumentHandle, status);
+}
+
+//---------------------------------------------------------------------------
+// Function: WDM-CCDM Get ELCH Measurement Value Position
+// Purpose:  This function returns the position of the measurement value
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_CcdmGetElchMeasVal (ViSession instrumentHandle, ViInt16 measurementParameter, ViInt16 *position)
+{
+   ViStatus  status = VI_SUCCESS;
+   ViUInt32  retCnt = 0;
+   ViUInt16  stb;
+   ViString  command[] = {":P_DBM:MEAS?", ":P_W:MEAS?"};
+   ViBoolean answer;
+   ViString  format[] = {"%*s %d", "%d"};
+
+   //Lock session
+   Pro8_Lock (instrumentHandle);
+   if ((status = Pro8_GetAnswer (instrumentHandle, &answer)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Check input parameter ranges
+   if (Pro8_invalidViInt16Range (measurementParameter, 0, 1))  return Pro8_Unlock (instrumentHandle, VI_ERROR_PARAMETER2);
+   //Writing - Poll STB - Check EAV Bit and read error - Reading
+   if ((status = Pro8_Write (instrumentHandle, command[measurementParameter], StringLength (command[measurementParameter]), &retCnt)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   if (stb & 0x0004) return Pro8_Unlock (instrumentHandle, Pro8_GetInstrumentError (instrumentHandle));
+   if ((status = Pro8_Scanf (instrumentHandle, format[answer], position)) < 0) return Pro8_Unlock (instrumentHandle, status);
+   //Ready
+   return Pro8_Unlock (instrumentHandle, status);
+}
+
+//---------------------------------------------------------------------------
+// Function: WDM-CWDM Set ELCH Set Values
+// Purpose:  This function sets the start and stop values for ELCH
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_CwdmSetElchSetVal (ViSession instrumentHandle, ViInt16 setParameter, ViReal64 startValue, ViReal64 stopValue)
+{
+   return Pro8_LsSetElchSetVal (instrumentHandle, setParameter, startValue, stopValue);
+}
+
+//---------------------------------------------------------------------------
+// Function: WDM_CWDM Get ELCH Set Values
+// Purpose:  This function returns the start and stop values for ELCH
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNC Pro8_CwdmGetElchSetVal (ViSession instrumentHandle, ViInt16 setParameter, ViReal64 *startValue, ViReal64 *stopValue)
+{
+   return Pro8_LsGetElchSetVal (instrumentHandle, setParameter, startValue, stopValue);
+}
+
+
+//===========================================================================
+// UTILITY ROUTINES (Non-Exportable Functions)
+//===========================================================================
+//---------------------------------------------------------------------------
+// Function: Wait for FIN Bit (Bit0 in Status Byte)
+// Purpose:  This function waits for the FIN (finished) Bit and returns
+//           the status byte. The way of waiting depends on the completion
+//           mode of the session (see Pro8_SetCompletionMode). Sessions not
+//           opened by Pro8_init use PRO8_COMPLETION_BACKOFF. A command
+//           collected by a batch or written in deferred error check mode
+//           returns the FIN bit at once. In deferred error check mode the
+//           EAV bit is not returned, errors are read by Pro8_CollectErrors.
+//           If the wait fails the shadow model is discarded, the command
+//           may not have been executed.
+//---------------------------------------------------------------------------
+ViStatus Pro8_WaitForFinBit (ViSession instrumentHandle, ViUInt16 *stb)
+{
+   ViStatus       status   = VI_SUCCESS;
+   ViInt16        mode     = PRO8_COMPLETION_BACKOFF;
+   ViUInt16       counter  = PRO8_POLL_STB_LOOP_COUNTER;
+   ViUInt16       value    = 0;
+   ViReal64       start, elapsed, delay, slept;
+   ViEventType    eventType;
+   ViEvent        eventContext;
+   Pro8_tSession  *session;
+
+   //Preset
+   *stb    = 0;
+   start   = Pro8_TimeNow ();
+   delay   = PRO8_BACKOFF_MIN_DELAY;
+   session = Pro8_GetSession (instrumentHandle);
+   if (session)
+   {
+      //Command was collected by a batch or is checked later by Pro8_CollectErrors
+      if (session->batchPending || session->writePending)
+      {
+         session->batchPending = VI_FALSE;
+         session->writePending = VI_FALSE;
+         *stb = 0x0001;
+         return VI_SUCCESS;
+      }
+      mode = session->completionMode;
+      if ((mode == PRO8_COMPLETION_SRQ) && (session->srqEnabled == VI_FALSE)) mode = PRO8_COMPLETION_BACKOFF;
+      //First delay is half of the usual wait time
+      if (session->averageWait * 0.5 > delay) delay = session->averageWait * 0.5;
+      if (delay > PRO8_BACKOFF_MAX_DELAY)     delay = PRO8_BACKOFF_MAX_DELAY;
+   }
+   //Loop
+   for (;;)
+   {
+      //Poll STB - Check FIN Bit
+      if ((status = Pro8_ReadSTB (instrumentHandle, &value)) < 0)
+      {
+         if (session) Pro8_ShadowClear (session);
+         return status;
+      }
+      if (value & 0x0001) break;
+      slept   = Pro8_TimeNow ();
+      elapsed = slept - start;
+      switch (mode)
+      {
+         case PRO8_COMPLETION_POLL:
+            //Delay and decrement counter
+            Delay (PRO8_POLL_STB_LOOP_DELAY);
+            if (--counter == 0) status = VI_ERROR_POLL_FIN_BIT;
+            break;
+
+         case PRO8_COMPLETION_SRQ:
+            //Wait for service request, a lost event costs one polling delay at most
+            if (elapsed >= PRO8_COMPLETION_TIMEOUT)
+            {
+               status = VI_ERROR_POLL_FIN_BIT;
+               break;
+            }
+            status = viWaitOnEvent (instrumentHandle, VI_EVENT_SERVICE_REQ, (ViUInt32)(PRO8_POLL_STB_LOOP_DELAY * 1000.0), &eventType, &eventContext);
+            if (status >= 0) viClose (eventContext);
+            else if (status != VI_ERROR_TMO)
+            {
+               if (session) Pro8_ShadowClear (session);
+               return status;
+            }
+            break;
+
+         default:
+            //Delay and increase delay
+            if (elapsed >= PRO8_COMPLETION_TIMEOUT)
+            {
+               status = VI_ERROR_POLL_FIN_BIT;
+               break;
+            }
+            Pro8_SleepSeconds (delay);
+            delay *= 2.0;
+            if (delay > PRO8_BACKOFF_MAX_DELAY) delay = PRO8_BACKOFF_MAX_DELAY;
+            break;
+      }
+      //Counting - the timeouts of the backoff and SRQ mode do not sleep
+      if ((status != VI_ERROR_POLL_FIN_BIT) || (mode == PRO8_COMPLETION_POLL)) Pro8_Count (session, PRO8_COUNTER_ALL, PRO8_COUNT_SLEEP, VI_SUCCESS, 0, Pro8_TimeNow () - slept);
+      if (status == VI_ERROR_POLL_FIN_BIT)
+      {
+         Pro8_Count (session, PRO8_COUNTER_ALL, PRO8_COUNT_TIMEOUT, status, 0, Pro8_TimeNow () - start);
+         if (session) Pro8_ShadowClear (session);
+         return status;
+      }
+   }
+   //Wait time
+   if (session)
+   {
+      if (mode == PRO8_COMPLETION_SRQ) viDiscardEvents (instrumentHandle, VI_EVENT_SERVICE_REQ, VI_QUEUE);
+      session->lastWait = Pro8_TimeNow () - start;
+      Pro8_Count (session, PRO8_COUNTER_ALL, PRO8_COUNT_WAIT, VI_SUCCESS, 0, session->lastWait);
+      if (session->averageWait == 0.0) session->averageWait = session->lastWait;
+      else session->averageWait += (session->lastWait - session->averageWait) / PRO8_WAIT_AVERAGE_WEIGHT;
+      //Deferred error check - the EAV bit stays set until the error queue is read
+      if (session->errorCheckMode == PRO8_ERROR_CHECK_DEFERRED) value &= ~0x0004;
+   }
+   //Ready
+   *stb = value;
+   return VI_SUCCESS;
+}
+
+//---------------------------------------------------------------------------
+// Function: Get Instrument Error Code
+// Purpose:  This function queries the instruments error queue until the
+//           queue is empty and returns the error code.
+//---------------------------------------------------------------------------
+ViStatus Pro8_GetInstrumentError (ViSession instrumentHandle)
+{
+   ViStatus       status   = VI_SUCCESS;
+   ViInt32        first, last;
+   ViInt16        commandClass;
+   ViReal64       start;
+   Pro8_tSession  *session;
+
+   //The failed command may be in the shadow model
+   if ((session = Pro8_GetSession (instrumentHandle)) != VI_NULL) Pro8_ShadowClear (session);
+   //The drain is counted for the class of the failed command
+   commandClass = session ? session->counterClass : PRO8_COUNTER_ALL;
+   start        = Pro8_TimeNow ();
+   status       = Pro8_ReadErrorQueue (instrumentHandle, &first, &last);
+   Pro8_Count (session, commandClass, PRO8_COUNT_DRAIN, status, 0, Pro8_TimeNow () - start);
+   if (status < 0) return status;
+   //Ready
+   return (last + VI_INSTR_ERROR_OFFSET);
+}
+
+//---------------------------------------------------------------------------
+// Function: Read Error Queue
+// Purpose:  This function reads the instruments error queue until it is
+//           empty. Each compound query reads PRO8_ERROR_BULK_COUNT entries,
+//           at most PRO8_GET_ERROR_LOOP_COUNTER entries are read. The first
+//           and the last error code are returned, 0 if the queue was empty.
+//---------------------------------------------------------------------------
+ViStatus Pro8_ReadErrorQueue (ViSession instrumentHandle, ViInt32 *firstError, ViInt32 *lastError)
+{
+   ViStatus status  = VI_SUCCESS;
+   ViUInt32 retCnt  = 0;
+   ViUInt32 length  = 0;
+   ViUInt16 stb;
+   ViInt16  counter = 0;
+   ViInt16  i;
+   ViInt32  code    = 0;
+   ViString answers[PRO8_ERROR_BULK_COUNT];
+   ViChar   command[PRO8_ERROR_BULK_COUNT * 11];
+   ViChar   buffer[RESPONSE_BUF_SIZE];
+
+   //Formatting
+   for (i = 0; i < PRO8_ERROR_BULK_COUNT; i++)
+   {
+      if (i) command[length++] = ';';
+      memcpy (&command[length], ":SYST:ERR?", 10);
+      length += 10;
+   }
+   //Loop - until an entry reports the empty queue
+   *firstError = *lastError = 0;
+   do
+   {
+      if (counter >= PRO8_GET_ERROR_LOOP_COUNTER) return VI_ERROR_GET_INSTR_ERROR;
+      //Writing - Poll STB - Reading
+      if ((status = Pro8_Send (instrumentHandle, command, length, &retCnt)) < 0) return status;
+      if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
+      if ((status = Pro8_ReadAnswers (instrumentHandle, PRO8_ERROR_BULK_COUNT, buffer, sizeof (buffer), answers)) < 0) return status;
+      //Evaluate
+      for (i = 0; i < PRO8_ERROR_BULK_COUNT; i++)
+      {
+         if ((code = strtol (answers[i], VI_NULL, 10)) == 0) break;
+         if (*firstError == 0) *firstError = code;
+         *lastError = code;
+      }
+      counter += PRO8_ERROR_BULK_COUNT;
+   }
+   while (code != 0);
+   //Ready
+   return VI_SUCCESS;
+}
+
+//---------------------------------------------------------------------------
+// Function: Collect Errors
+// Purpose:  This function waits until the commands written in deferred
+//           error check mode are finished and reads the error queue. The
+//           first error and the sequence numbers of the commands written
+//           since the last check are stored for Pro8_SyncErrors.
+//---------------------------------------------------------------------------
+ViStatus Pro8_CollectErrors (ViSession instrumentHandle, Pro8_tSession *session)
+{
+   ViStatus status = VI_SUCCESS;
+   ViUInt16 stb;
+   ViInt32  first, last;
+   ViInt16  commandClass;
+   ViReal64 start;
+
+   //Poll STB - the EAV bit is read separately, Pro8_WaitForFinBit hides it
+   session->writePending = VI_FALSE;
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
+   if ((status = Pro8_ReadSTB (instrumentHandle, &stb)) < 0) return status;
+   session->lastSync = Pro8_TimeNow ();
+   //Read errors - the instrument state is unknown
+   if (stb & 0x0004)
+   {
+      commandClass = session->counterClass;
+      start        = Pro8_TimeNow ();
+      status       = Pro8_ReadErrorQueue (instrumentHandle, &first, &last);
+      Pro8_Count (session, commandClass, PRO8_COUNT_DRAIN, status, 0, Pro8_TimeNow () - start);
+      if (status < 0) return status;
+      if (first)
+      {
+         if (session->deferredStatus >= 0)
+         {
+            session->deferredStatus = first + VI_INSTR_ERROR_OFFSET;
+            session->deferredFirst  = session->syncedSequence + 1;
+            session->deferredLast   = session->sequence;
+         }
+         Pro8_InvalidateSession (session);
+      }
+   }
+   session->syncedSequence = session->sequence;
+   //Ready
+   return VI_SUCCESS;
+}
+
+//---------------------------------------------------------------------------
+// Function: Table Lock
+// Purpose:  This function returns the lock of the session table. It is
+//           created by the first caller, a thread losing the race discards
+//           its own lock.
+//---------------------------------------------------------------------------
+CmtThreadLockHandle Pro8_TableLock (void)
+{
+   CmtThreadLockHandle lock;
+
+   if (Pro8_sessionsLock == 0)
+   {
+      if (CmtNewLock (VI_NULL, 0, &lock) < 0) return 0;
+#if defined(_WIN32)
+      if (InterlockedCompareExchange ((volatile LONG*)&Pro8_sessionsLock, (LONG)lock, 0) != 0) CmtDiscardLock (lock);
+#else
+      if (!__sync_bool_compare_and_swap (&Pro8_sessionsLock, 0, lock)) CmtDiscardLock (lock);
+#endif
+   }
+   return Pro8_sessionsLock;
+}
+
+//---------------------------------------------------------------------------
+// Function: Get Session
+// Purpose:  This function returns the driver data of a session opened by
+//           Pro8_init or VI_NULL for any other session.
+//---------------------------------------------------------------------------
+Pro8_tSession *Pro8_GetSession (ViSession instrumentHandle)
+{
+   Pro8_tSession  *session = VI_NULL;
+   ViInt16        i;
+
+   if (instrumentHandle == VI_NULL) return VI_NULL;
+   CmtGetLock (Pro8_TableLock ());
+   for (i = 0; i < PRO8_MAX_SESSIONS; i++)
+   {
+      if (Pro8_sessions[i].instr == instrumentHandle)
+      {
+         session = &Pro8_sessions[i];
+         break;
+      }
+   }
+   CmtReleaseLock (Pro8_TableLock ());
+   return session;
+}
+
+//---------------------------------------------------------------------------
+// Function: New Session
+// Purpose:  This function allocates the driver data of a session and sets
+//           it to the default values. The entry is claimed under the table
+//           lock, so two threads never get the same one.
+//---------------------------------------------------------------------------
+ViStatus Pro8_NewSession (ViSession instrumentHandle)
+{
+   ViInt16 i;
+
+   CmtGetLock (Pro8_TableLock ());
+   for (i = 0; i < PRO8_MAX_SESSIONS; i++)
+   {
+      if (Pro8_sessions[i].instr == VI_NULL)
+      {
+         memset (&Pro8_sessions[i], 0, sizeof (Pro8_tSession));
+         if (CmtNewLock (VI_NULL, 0, &Pro8_sessions[i].lock) < 0)
+         {
+            CmtReleaseLock (Pro8_TableLock ());
+            return VI_ERROR_SYSTEM_ERROR;
+         }
+         Pro8_sessions[i].completionMode = PRO8_COMPLETION_BACKOFF;
+         Pro8_sessions[i].plugCheckInterval = PRO8_PLUG_CHECK_INTERVAL;
+         Pro8_sessions[i].transport      = PRO8_VISA_TRANSPORT;
+         Pro8_sessions[i].timeout        = PRO8_TRANSPORT_TIMEOUT;
+         Pro8_sessions[i].fd             = -1;
+         Pro8_sessions[i].counterClass   = PRO8_COUNTER_COMMON;
+         Pro8_sessions[i].counterReset   = Pro8_TimeNow ();
+         Pro8_sessions[i].instr          = instrumentHandle;
+         CmtReleaseLock (Pro8_TableLock ());
+         return VI_SUCCESS;
+      }
+   }
+   CmtReleaseLock (Pro8_TableLock ());
+   return VI_ERROR_SESSION_TABLE_FULL;
+}
+
+//---------------------------------------------------------------------------
+// Function: Free Session
+// Purpose:  This function releases the driver data of a session. It waits
+//           until no other thread is between Pro8_Lock and Pro8_Unlock of
+//           the session, the transaction lock is discarded and the entry is
+//           released under the table lock. The calling thread must not hold
+//           the transaction lock (see Pro8_close).
+//---------------------------------------------------------------------------
+void Pro8_FreeSession (ViSession instrumentHandle)
+{
+   Pro8_tSession  *session;
+
+   if ((session = Pro8_GetSession (instrumentHandle)) == VI_NULL) return;
+   Pro8_StreamFree (session);
+   Pro8_WaveformFree (session);
+   Pro8_LoopFree (session);
+   Pro8_SenderStop (session);
+   Pro8_AsyncStop (session);
+   for (;;)
+   {
+      CmtGetLock (Pro8_TableLock ());
+      if (session->users <= 0) break;
+      CmtReleaseLock (Pro8_TableLock ());
+      Pro8_SleepSeconds (PRO8_SESSION_WAIT_TIME);
+   }
+   session->instr = VI_NULL;
+   CmtDiscardLock (session->lock);
+   CmtReleaseLock (Pro8_TableLock ());
+}
+
+//---------------------------------------------------------------------------
+// Function: Lock
+// Purpose:  This function acquires the transaction lock of a session opened
+//           by Pro8_init. The lock is recursive. If it is free it is taken
+//           without waiting, otherwise the contention is counted and the
+//           thread waits for the lock.
+//---------------------------------------------------------------------------
+void Pro8_Lock (ViSession instrumentHandle)
+{
+   int            obtained = 0;
+   Pro8_tSession  *session;
+
+   //Counted as user under the table lock - the lock is not discarded before Pro8_Unlock
+   CmtGetLock (Pro8_TableLock ());
+   if ((session = Pro8_GetSession (instrumentHandle)) != VI_NULL) session->users++;
+   CmtReleaseLock (Pro8_TableLock ());
+   if (session == VI_NULL) return;
+   //Fast path - lock is free or already held by this thread
+   CmtTryToGetLock (session->lock, &obtained);
+   if (obtained == 0)
+   {
+      CmtGetLock (session->lock);
+      session->contentions++;
+   }
+   session->acquisitions++;
+   if (session->lockDepth++ == 0) session->lockThread = CmtGetCurrentThreadID ();
+}
+
+//---------------------------------------------------------------------------
+// Function: Unlock
+// Purpose:  This function releases the transaction lock of a session and
+//           returns status, so it can be used in return statements.
+//---------------------------------------------------------------------------
+ViStatus Pro8_Unlock (ViSession instrumentHandle, ViStatus status)
+{
+   Pro8_tSession  *session;
+
+   CmtGetLock (Pro8_TableLock ());
+   if (((session = Pro8_GetSession (instrumentHandle)) != VI_NULL) && (session->users > 0))
+   {
+      if ((session->lockDepth > 0) && (--session->lockDepth == 0)) session->lockThread = 0;
+      CmtReleaseLock (session->lock);
+      session->users--;
+   }
+   CmtReleaseLock (Pro8_TableLock ());
+   return status;
+}
+
+//---------------------------------------------------------------------------
+// Function: Lock Owner
+// Purpose:  This function returns VI_TRUE if the calling thread holds the
+//           transaction lock of a session.
+//---------------------------------------------------------------------------
+ViBoolean Pro8_LockOwner (Pro8_tSession *session)
+{
+   return (ViBoolean)((session->lockDepth > 0) && (session->lockThread == CmtGetCurrentThreadID ()));
+}
+
+//---------------------------------------------------------------------------
+// Function: Asynchronous Start
+// Purpose:  This function starts the I/O thread of a session. Each session
+//           has a thread pool with one thread that executes the scheduled
+//           operations in order.
+//---------------------------------------------------------------------------
+ViStatus Pro8_AsyncStart (Pro8_tSession *session)
+{
+   Pro8_tAsync *async;
+
+   if (session->async) return VI_SUCCESS;
+   if ((async = (Pro8_tAsync*)calloc (1, sizeof (Pro8_tAsync))) == VI_NULL) return VI_ERROR_ALLOC;
+   //Queue - Thread pool - I/O thread
+   if (CmtNewTSQ (PRO8_ASYNC_MAX_PENDING + 1, sizeof (ViInt32), 0, &async->queue) < 0)
+   {
+      free (async);
+      return VI_ERROR_SYSTEM_ERROR;
+   }
+   if (CmtNewLock (VI_NULL, 0, &async->lock) < 0)
+   {
+      CmtDiscardTSQ (async->queue);
+      free (async);
+      return VI_ERROR_SYSTEM_ERROR;
+   }
+   if (CmtNewThreadPool (1, &async->pool) < 0)
+   {
+      CmtDiscardLock (async->lock);
+      CmtDiscardTSQ (async->queue);
+      free (async);
+      return VI_ERROR_SYSTEM_ERROR;
+   }
+   session->async = async;
+   if (CmtScheduleThreadPoolFunction (async->pool, Pro8_AsyncWorker, session, &async->worker) < 0)
+   {
+      session->async = VI_NULL;
+      CmtDiscardThreadPool (async->pool);
+      CmtDiscardLock (async->lock);
+      CmtDiscardTSQ (async->queue);
+      free (async);
+      return VI_ERROR_SYSTEM_ERROR;
+   }
+   //Ready
+   return VI_SUCCESS;
+}
+
+//---------------------------------------------------------------------------
+// Function: Asynchronous Stop
+// Purpose:  This function waits until the scheduled operations of a session
+//           are finished and stops its I/O thread.
+//---------------------------------------------------------------------------
+void Pro8_AsyncStop (Pro8_tSession *session)
+{
+   Pro8_tAsync *async;
+   ViInt32     stop     = PRO8_ASYNC_STOP;
+
+   if ((async = session->async) == VI_NULL) return;
+   //Stop after the scheduled operations
+   CmtWriteTSQData (async->queue, &stop, 1, TSQ_INFINITE_TIMEOUT, VI_NULL);
+   CmtWaitForThreadPoolFunctionCompletion (async->pool, async->worker, 0);
+   CmtReleaseThreadPoolFunctionID (async->pool, async->worker);
+   CmtDiscardThreadPool (async->pool);
+   CmtDiscardLock (async->lock);
+   CmtDiscardTSQ (async->queue);
+   session->async = VI_NULL;
+   free (async);
+}
+
+//---------------------------------------------------------------------------
+// Function: Asynchronous Schedule
+// Purpose:  This function copies an operation to a free entry of the session
+//           and passes it to the I/O thread. The I/O thread is started by
+//           the first operation.
+//---------------------------------------------------------------------------
+ViStatus Pro8_AsyncSchedule (ViSession instrumentHandle, Pro8_tFuture *request, ViInt32 *future)
+{
+   ViStatus       status   = VI_SUCCESS;
+   ViInt32        index;
+   Pro8_tSession  *session;
+
+   if ((session = Pro8_GetSession (instrumentHandle)) == VI_NULL) return VI_ERROR_NO_SESSION_CONTEXT;
+   if (session->async == VI_NULL)
+   {
+      Pro8_Lock (instrumentHandle);
+      status = Pro8_AsyncStart (session);
+      Pro8_Unlock (instrumentHandle, status);
+      if (status < 0) return status;
+   }
+   //Free entry - the I/O thread holds the session lock, entries have their own
+   CmtGetLock (session->async->lock);
+   for (index = 0; index < PRO8_ASYNC_MAX_PENDING; index++)
+   {
+      if (session->async->futures[index].used == VI_FALSE) break;
+   }
+   if (index == PRO8_ASYNC_MAX_PENDING)
+   {
+      CmtReleaseLock (session->async->lock);
+      return VI_ERROR_ASYNC_QUEUE_FULL;
+   }
+   //Copy - Schedule
+   request->used = VI_TRUE;
+   request->keep = (ViBoolean)(future != VI_NULL);
+   request->done = VI_FALSE;
+   session->async->futures[index] = *request;
+   if (CmtWriteTSQData (session->async->queue, &index, 1, 0, VI_NULL) != 1)
+   {
+      session->async->futures[index].used = VI_FALSE;
+      status = VI_ERROR_ASYNC_QUEUE_FULL;
+   }
+   else if (future) *future = index + 1;
+   CmtReleaseLock (session->async->lock);
+   //Ready
+   return status;
+}
+
+//---------------------------------------------------------------------------
+// Function: Asynchronous Get Future
+// Purpose:  This function returns the entry of an asynchronous operation
+//           handle or VI_NULL if the handle is invalid.
+//---------------------------------------------------------------------------
+Pro8_tFuture *Pro8_AsyncGetFuture (ViSession instrumentHandle, ViInt32 future)
+{
+   Pro8_tFuture   *entry;
+   Pro8_tSession  *session;
+
+   if ((session = Pro8_GetSession (instrumentHandle)) == VI_NULL || (session->async == VI_NULL)) return VI_NULL;
+   if ((future < 1) || (future > PRO8_ASYNC_MAX_PENDING)) return VI_NULL;
+   entry = &session->async->futures[future - 1];
+   if ((entry->used == VI_FALSE) || (entry->keep == VI_FALSE)) return VI_NULL;
+   return entry;
+}
+
+//---------------------------------------------------------------------------
+// Function: Asynchronous Worker
+// Purpose:  This is the I/O thread of a session. It executes the scheduled
+//           operations in order until PRO8_ASYNC_STOP is read.
+//---------------------------------------------------------------------------
+int CVICALLBACK Pro8_AsyncWorker (void *functionData)
+{
+   Pro8_tSession  *session  = (Pro8_tSession*)functionData;
+   Pro8_tFuture   *future;
+   ViInt32        index;
+
+   for (;;)
+   {
+      //Next operation
+      if (CmtReadTSQData (session->async->queue, &index, 1, TSQ_INFINITE_TIMEOUT, 0) < 1) break;
+      if (index == PRO8_ASYNC_STOP) break;
+      future = &session->async->futures[index];
+      //Execute as one transaction - notify
+      Pro8_Lock (session->instr);
+      future->status = Pro8_Unlock (session->instr, Pro8_AsyncExecute (session->instr, future));
+      if (future->callback) future->callback (session->instr, future->keep ? index + 1 : 0, future->status, future->callbackData);
+      if (future->keep) future->done = VI_TRUE;
+      else future->used = VI_FALSE;
+   }
+   return 0;
+}
+
+//---------------------------------------------------------------------------
+// Function: Asynchronous Execute
+// Purpose:  This function executes an asynchronous operation on the I/O
+//           thread: the function of Pro8_AsyncCall or the command of
+//           Pro8_AsyncWrite and Pro8_AsyncQuery.
+//---------------------------------------------------------------------------
+ViStatus Pro8_AsyncExecute (ViSession instrumentHandle, Pro8_tFuture *future)
+{
+   ViStatus status = VI_SUCCESS;
+   ViUInt32 retCnt = 0;
+   ViUInt32 length;
+   ViUInt16 stb;
+   ViChar   rest[CMD_BUF_SIZE];
+
+   //Function
+   if (future->function) return future->function (instrumentHandle, future->data);
+   //Select slot
+   if (future->slot)
+   {
+      if ((status = Pro8_SetSlot (instrumentHandle, future->slot)) < 0) return status;
+   }
+   //Writing - Poll STB - Check EAV Bit and read error
+   if ((status = Pro8_Write (instrumentHandle, future->command, StringLength (future->command), &retCnt)) < 0) return status;
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
+   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
+   if (strchr (future->command, '?') == VI_NULL) return status;
+   //Reading
+   if ((status = Pro8_Read (instrumentHandle, future->response, PRO8_ASYNC_RESPONSE_SIZE - 1, &retCnt)) < 0) return status;
+   length = retCnt;
+   while ((length > 0) && ((future->response[length - 1] == '\n') || (future->response[length - 1] == '\r'))) length--;
+   future->response[length] = '\0';
+   //Discard the rest of a long response
+   while (status == VI_SUCCESS_MAX_CNT)
+   {
+      if ((status = Pro8_Read (instrumentHandle, rest, sizeof (rest), &retCnt)) < 0) return status;
+   }
+   //Ready
+   return VI_SUCCESS;
+}
+
+//---------------------------------------------------------------------------
+// Function: Pool Run
+// Purpose:  This function is executed by the I/O thread of an instrument of
+//           Pro8_PoolExecute. The commands are joined with the slot
+//           selections into compound commands that fit the instruments
+//           input buffer, each compound command is written and its
+//           responses are read at once. Pro8_TelemetrySnapshot uses it
+//           within the calling thread. If results is given, the status of
+//           every command is written, also if the function fails before
+//           the first command is sent.
+//---------------------------------------------------------------------------
+ViStatus _VI_FUNCH Pro8_PoolRun (ViSession instrumentHandle, ViAddr data)
+{
+   ViStatus       status   = VI_SUCCESS;
+   ViStatus       first    = VI_SUCCESS;
+   ViUInt32       retCnt   = 0;
+   ViUInt32       length, n;
+   ViUInt16       stb;
+   ViInt32        pos      = 0;
+   ViInt32        start, i, k;
+   ViInt16        current, queries;
+   ViBoolean      answer;
+   ViReal64       written, time;
+   ViString       answers[PRO8_BATCH_MAX_LENGTH / 2];
+   ViChar         command[PRO8_BATCH_MAX_LENGTH + 1];
+   ViChar         select[CMD_BUF_SIZE];
+   ViChar         buffer[RESPONSE_BUF_SIZE * 2];
+   ViChar         *response;
+   Pro8_tPoolJob  *job      = (Pro8_tPoolJob*)data;
+   Pro8_tSession  *session;
+
+   session = Pro8_GetSession (instrumentHandle);
+   if ((status = Pro8_GetAnswer (instrumentHandle, &answer)) < 0)
+   {
+      for (; (pos < job->count) && job->results; pos++) job->results[job->index[pos]] = status;
+      return status;
+   }
+   while (pos < job->count)
+   {
+      //Formatting - as many commands as fit
+      length  = 0;
+      queries = 0;
+      start   = pos;
+      current = session ? session->slot : 0;
+      for (; pos < job->count; pos++)
+      {
+         i = job->index[pos];
+         select[0] = '\0';
+         if (job->slot[i] && (job->slot[i] != current)) Pro8_Fmt (select, ":SLOT %d;", job->slot[i]);
+         n = StringLength (select) + StringLength (job->commands[i]);
+         if ((pos > start) && (length + 1 + n > PRO8_BATCH_MAX_LENGTH)) break;
+         if (length) command[length++] = ';';
+         memcpy (&command[length], select, StringLength (select));
+         length += StringLength (select);
+         memcpy (&command[length], job->commands[i], StringLength (job->commands[i]));
+         length += StringLength (job->commands[i]);
+         if (job->slot[i]) current = job->slot[i];
+         if (strchr (job->commands[i], '?')) queries++;
+      }
+      command[length] = '\0';
+      //Writing - Poll STB - Check EAV Bit and read error - Reading
+      written = Pro8_TimeNow ();
+      if ((status = Pro8_Write (instrumentHandle, command, length, &retCnt)) >= 0)
+      {
+         if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) >= 0)
+         {
+            if (stb & 0x0004) status = Pro8_GetInstrumentError (instrumentHandle);
+            else if (queries) status = Pro8_ReadAnswers (instrumentHandle, queries, buffer, sizeof (buffer), answers);
+         }
+      }
+      //Values are taken between writing and reading
+      time = (written + Pro8_TimeNow ()) * 0.5;
+      //Active slot
+      if (session)
+      {
+         if (status < 0) Pro8_InvalidateSession (session);
+         else if (current != session->slot)
+         {
+            session->slot = current;
+            session->port = 0;
+         }
+      }
+      //Results
+      for (queries = 0; start < pos; start++)
+      {
+         i = job->index[start];
+         if (job->results) job->results[i] = status;
+         if (job->times)   job->times[i]   = time;
+         response = job->responses ? &job->responses[i * PRO8_ASYNC_RESPONSE_SIZE] : VI_NULL;
+         if (response) response[0] = '\0';
+         if (job->values) job->values[i] = 0.0;
+         if ((status < 0) || (strchr (job->commands[i], '?') == VI_NULL)) continue;
+         //Response
+         k = queries++;
+         if (response)
+         {
+            n = StringLength (answers[k]);
+            if (n >= PRO8_ASYNC_RESPONSE_SIZE) n = PRO8_ASYNC_RESPONSE_SIZE - 1;
+            memcpy (response, answers[k], n);
+            response[n] = '\0';
+         }
+         if (job->values) Pro8_ParseReal (answers[k], answer, &job->values[i]);
+      }
+      if ((status < 0) && (first >= 0)) first = status;
+   }
+   //Ready
+   return first;
+}
+
+//---------------------------------------------------------------------------
+// Function: Channel Mask
+// Purpose:  This function returns the telemetry channels (bit 1 << channel)
+//           of a module type code.
+//---------------------------------------------------------------------------
+ViUInt32 Pro8_ChannelMask (ViInt16 type)
+{
+   ViUInt32 ld  = (1UL << PRO8_CHANNEL_LD_CURRENT) | (1UL << PRO8_CHANNEL_PD_CURRENT);
+   ViUInt32 tec = (1UL << PRO8_CHANNEL_TEMPERATURE) | (1UL << PRO8_CHANNEL_TEC_CURRENT) | (1UL << PRO8_CHANNEL_TEC_VOLTAGE);
+
+   switch (type)
+   {
+      case PRO8_TYPE_LDC:  return ld | (1UL << PRO8_CHANNEL_LD_VOLTAGE);
+      case PRO8_TYPE_MLC:  return ld;
+      case PRO8_TYPE_TEC:  return tec;
+      case PRO8_TYPE_ITC:  return ld | (1UL << PRO8_CHANNEL_LD_VOLTAGE) | tec;
+      case PRO8_TYPE_PDA:  return (1UL << PRO8_CHANNEL_PDA_CURRENT) | (1UL << PRO8_CHANNEL_OPTICAL_POWER);
+      default:             return 0;
+   }
+}
+
+//---------------------------------------------------------------------------
+// Function: Telemetry Channels
+// Purpose:  This function returns up to size channels of the populated
+//           slots selected by channelMask in slot and channel order.
+//---------------------------------------------------------------------------
+ViStatus Pro8_TelemetryChannels (ViSession instrumentHandle, ViUInt32 channelMask, ViInt32 size, ViInt16 slot[], ViInt16 channel[], ViInt32 *count)
+{
+   ViStatus status;
+   ViInt16  type[PRO8_NUM_SLOTS], sub[PRO8_NUM_SLOTS];
+   ViUInt32 mask;
+   ViInt32  n        = 0;
+   ViInt16  s, c;
+
+   *count = 0;
+   if (channelMask == PRO8_CHANNEL_ALL) channelMask = 0xFFFFFFFF;
+   if ((status = Pro8_ReadPlugConfig (instrumentHandle, type, sub)) < 0) return status;
+   for (s = 1; s <= PRO8_NUM_SLOTS; s++)
+   {
+      mask = Pro8_ChannelMask (type[s - 1]) & channelMask;
+      for (c = 1; c <= PRO8_CHANNEL_COUNT; c++)
+      {
+         if (((mask & (1UL << c)) == 0) || (n >= size)) continue;
+         slot[n]    = s;
+         channel[n] = c;
+         n++;
+      }
+   }
+   *count = n;
+   //Ready
+   return status;
+}
+
+//---------------------------------------------------------------------------
+// Function: Stream Free
+// Purpose:  This function stops the acquisition thread of a session after
+//           the current cycle and frees the stream.
+//---------------------------------------------------------------------------
+void Pro8_StreamFree (Pro8_tSession *session)
+{
+   Pro8_tStream *stream;
+
+   if ((stream = session->stream) == VI_NULL) return;
+   stream->stop = VI_TRUE;
+   CmtWaitForThreadPoolFunctionCompletion (stream->pool, stream->worker, 0);
+   CmtReleaseThreadPoolFunctionID (stream->pool, stream->worker);
+   CmtDiscardThreadPool (stream->pool);
+   session->stream = VI_NULL;
+   free (stream->ring);
+   free (stream);
+}
+
+//---------------------------------------------------------------------------
+// Function: Stream Worker
+// Purpose:  This is the acquisition thread of a session. Each cycle reads
+//           the channels in one transaction and publishes the samples one
+//           by one, so the writer never waits for a consumer.
+//---------------------------------------------------------------------------
+int CVICALLBACK Pro8_StreamWorker (void *functionData)
+{
+   Pro8_tSession  *session  = (Pro8_tSession*)functionData;
+   Pro8_tStream   *stream   = session->stream;
+   Pro8_tSample   *sample;
+   ViReal64       next, now;
+   ViUInt32       skipped;
+   ViInt32        i;
+
+   next = Pro8_TimeNow ();
+   while (stream->stop == VI_FALSE)
+   {
+      //Read the channels as one transaction
+      Pro8_Lock (session->instr);
+      Pro8_Unlock (session->instr, Pro8_PoolRun (session->instr, &stream->job));
+      //Write - publish
+      for (i = 0; i < stream->job.count; i++)
+      {
+         sample = &stream->ring[stream->head & stream->mask];
+         sample->timestamp = stream->times[i];
+         sample->slot      = stream->slot[i];
+         sample->channel   = stream->channel[i];
+         sample->status    = stream->results[i];
+         sample->value     = stream->values[i];
+         Pro8_MemoryBarrier ();
+         stream->head++;
+      }
+      stream->cycles++;
+      //Next period - a late cycle starts at once, whole periods already over are skipped
+      next += stream->period;
+      now   = Pro8_TimeNow ();
+      if (stream->period == 0.0) next = now;
+      else if (now - next >= stream->period)
+      {
+         skipped         = (ViUInt32)((now - next) / stream->period);
+         stream->missed += skipped;
+         next           += stream->period * skipped;
+      }
+      if (next > now) Pro8_SleepSeconds (next - now);
+   }
+   return 0;
+}
+
+//---------------------------------------------------------------------------
+// Function: Stream Get Consumer
+// Purpose:  This function returns the entry of a consumer handle or VI_NULL
+//           if the handle is invalid.
+//---------------------------------------------------------------------------
+Pro8_tConsumer *Pro8_StreamGetConsumer (ViSession instrumentHandle, ViInt32 consumer)
+{
+   Pro8_tConsumer *entry;
+   Pro8_tSession  *session;
+
+   if ((session = Pro8_GetSession (instrumentHandle)) == VI_NULL || (session->stream == VI_NULL)) return VI_NULL;
+   if ((consumer < 1) || (consumer > PRO8_STREAM_MAX_CONSUMERS)) return VI_NULL;
+   entry = &session->stream->consumers[consumer - 1];
+   if (entry->used == VI_FALSE) return VI_NULL;
+   return entry;
+}
+
+//---------------------------------------------------------------------------
+// Function: Sender Start
+// Purpose:  This function starts the setpoint sender thread of a session.
+//---------------------------------------------------------------------------
+ViStatus Pro8_SenderStart (Pro8_tSession *session)
+{
+   Pro8_tSender *sender;
+
+   if (session->sender) return VI_SUCCESS;
+   if ((sender = (Pro8_tSender*)calloc (1, sizeof (Pro8_tSender))) == VI_NULL) return VI_ERROR_ALLOC;
+   //Doorbell - Thread pool - sender thread
+   if (CmtNewTSQ (1, sizeof (ViInt32), 0, &sender->doorbell) < 0)
+   {
+      free (sender);
+      return VI_ERROR_SYSTEM_ERROR;
+   }
+   if (CmtNewThreadPool (1, &sender->pool) < 0)
+   {
+      CmtDiscardTSQ (sender->doorbell);
+      free (sender);
+      return VI_ERROR_SYSTEM_ERROR;
+   }
+   session->sender = sender;
+   if (CmtScheduleThreadPoolFunction (sender->pool, Pro8_SenderWorker, session, &sender->worker) < 0)
+   {
+      session->sender = VI_NULL;
+      CmtDiscardThreadPool (sender->pool);
+      CmtDiscardTSQ (sender->doorbell);
+      free (sender);
+      return VI_ERROR_SYSTEM_ERROR;
+   }
+   //Ready
+   return VI_SUCCESS;
+}
+
+//---------------------------------------------------------------------------
+// Function: Sender Stop
+// Purpose:  This function stops the setpoint sender thread of a session
+//           after the values taken are written.
+//---------------------------------------------------------------------------
+void Pro8_SenderStop (Pro8_tSession *session)
+{
+   Pro8_tSender *sender;
+   ViInt32      stop     = PRO8_ASYNC_STOP;
+
+   if ((sender = session->sender) == VI_NULL) return;
+   CmtWriteTSQData (sender->doorbell, &stop, 1, TSQ_INFINITE_TIMEOUT, VI_NULL);
+   CmtWaitForThreadPoolFunctionCompletion (sender->pool, sender->worker, 0);
+   CmtReleaseThreadPoolFunctionID (sender->pool, sender->worker);
+   CmtDiscardThreadPool (sender->pool);
+   CmtDiscardTSQ (sender->doorbell);
+   session->sender = VI_NULL;
+   free (sender);
+}
+
+//---------------------------------------------------------------------------
+// Function: Sender Worker
+// Purpose:  This is the setpoint sender thread of a session. After a post
+//           it takes the latest value of every pending channel and writes
+//           them in one transaction, until no channel is pending. Values
+//           posted during a write are coalesced into the next one.
+//---------------------------------------------------------------------------
+int CVICALLBACK Pro8_SenderWorker (void *functionData)
+{
+   Pro8_tSession  *session  = (Pro8_tSession*)functionData;
+   Pro8_tSender   *sender   = session->sender;
+   Pro8_tSetpoint *entry;
+   Pro8_tPoolJob  job;
+   ViInt32        index[PRO8_MAX_SETPOINTS], count, signal, i;
+   ViInt16        slot[PRO8_MAX_SETPOINTS];
+   ViChar         commands[PRO8_MAX_SETPOINTS][CMD_BUF_SIZE];
+   ViString       pointers[PRO8_MAX_SETPOINTS];
+   ViUInt32       sequence[PRO8_MAX_SETPOINTS];
+   ViReal64       posted[PRO8_MAX_SETPOINTS];
+   ViStatus       results[PRO8_MAX_SETPOINTS];
+   ViReal64       done;
+
+   memset (&job, 0, sizeof (job));
+   for (i = 0; i < PRO8_MAX_SETPOINTS; i++) pointers[i] = commands[i];
+   job.index    = index;
+   job.slot     = slot;
+   job.commands = pointers;
+   job.results  = results;
+   for (;;)
+   {
+      //Wait for a post
+      if (CmtReadTSQData (sender->doorbell, &signal, 1, TSQ_INFINITE_TIMEOUT, 0) < 1) break;
+      if (signal == PRO8_ASYNC_STOP) break;
+      do
+      {
+         //Take the pending values - write as one transaction
+         Pro8_Lock (session->instr);
+         if ((count = Pro8_SenderTake (sender, index, slot, commands, sequence, posted)) > 0)
+         {
+            job.count = count;
+            Pro8_PoolRun (session->instr, &job);
+            done = Pro8_TimeNow ();
+            for (i = 0; i < count; i++)
+            {
+               entry = &sender->setpoints[index[i]];
+               entry->dropped += (sequence[i] - entry->taken) / 2 - 1;
+               entry->taken    = sequence[i];
+               entry->status   = results[index[i]];
+               entry->lastAge  = done - posted[i];
+               if (entry->lastAge > entry->maxAge) entry->maxAge = entry->lastAge;
+               if (results[index[i]] >= 0) entry->applied++;
+            }
+         }
+         Pro8_Unlock (session->instr, VI_SUCCESS);
+      }  while (count > 0);
+   }
+   return 0;
+}
+
+//---------------------------------------------------------------------------
+// Function: Sender Take
+// Purpose:  This function takes the latest value of every setpoint channel
+//           posted since the last write and formats its command. It returns
+//           the number of channels taken. index[n] is the channel entry,
+//           slot and commands are stored at the entry, sequence and posted
+//           at n.
+//---------------------------------------------------------------------------
+ViInt32 Pro8_SenderTake (Pro8_tSender *sender, ViInt32 index[], ViInt16 slot[], ViChar commands[][CMD_BUF_SIZE], ViUInt32 sequence[], ViReal64 posted[])
+{
+   Pro8_tSetpoint *entry;
+   ViUInt32       first;
+   ViReal64       value;
+   ViInt32        i, n = 0;
+
+   for (i = 0; i < PRO8_MAX_SETPOINTS; i++)
+   {
+      entry = &sender->setpoints[i];
+      if (entry->used == VI_FALSE) continue;
+      //Consistent value - retry while the poster writes
+      do
+      {
+         first = entry->sequence;
+         Pro8_MemoryBarrier ();
+         value     = entry->value;
+         posted[n] = entry->posted;
+         Pro8_MemoryBarrier ();
+      }  while ((first & 1) || (first != entry->sequence));
+      if (first == entry->taken) continue;
+      index[n]    = i;
+      sequence[n] = first;
+      slot[i]     = entry->slot;
+      Pro8_Fmt (commands[i], Pro8_setpointCommands[entry->parameter], value);
+      n++;
+   }
+   return n;
+}
+
+//---------------------------------------------------------------------------
+// Function: Setpoint Get
+// Purpose:  This function returns the entry of a setpoint channel handle or
+//           VI_NULL if the handle is invalid.
+//---------------------------------------------------------------------------
+Pro8_tSetpoint *Pro8_SetpointGet (ViSession instrumentHandle, ViInt32 setpoint)
+{
+   Pro8_tSetpoint *entry;
+   Pro8_tSession  *session;
+
+   if ((session = Pro8_GetSession (instrumentHandle)) == VI_NULL || (session->sender == VI_NULL)) return VI_NULL;
+   if ((setpoint < 1) || (setpoint > PRO8_MAX_SETPOINTS)) return VI_NULL;
+   entry = &session->sender->setpoints[setpoint - 1];
+   if (entry->used == VI_FALSE) return VI_NULL;
+   return entry;
+}
+
+//---------------------------------------------------------------------------
+// Function: Waveform Free
+// Purpose:  This function stops the waveform thread of a session after the
+//           current point and frees the waveform.
+//---------------------------------------------------------------------------
+void Pro8_WaveformFree (Pro8_tSession *session)
+{
+   Pro8_tWaveform *waveform;
+
+   if ((waveform = session->waveform) == VI_NULL) return;
+   waveform->stop = VI_TRUE;
+   CmtWaitForThreadPoolFunctionCompletion (waveform->pool, waveform->worker, 0);
+   CmtReleaseThreadPoolFunctionID (waveform->pool, waveform->worker);
+   CmtDiscardThreadPool (waveform->pool);
+   session->waveform = VI_NULL;
+   free (waveform->setpoints);
+   free (waveform->errors);
+   free (waveform);
+}
+
+//---------------------------------------------------------------------------
+// Function: Waveform Worker
+// Purpose:  This is the waveform thread of a session. It sleeps until the
+//           deadline of the next point and writes it without waiting for
+//           the FIN bit. If there is time enough before the following
+//           point, or PRO8_WAVEFORM_SYNC_POINTS points are written, it
+//           waits for the FIN bit, checks the errors and releases the
+//           session lock. Otherwise it keeps the lock, so no other
+//           transaction takes the time of the next point.
+//---------------------------------------------------------------------------
+int CVICALLBACK Pro8_WaveformWorker (void *functionData)
+{
+   Pro8_tSession  *session  = (Pro8_tSession*)functionData;
+   Pro8_tWaveform *waveform = session->waveform;
+   ViStatus       status    = VI_SUCCESS;
+   ViUInt32       retCnt    = 0;
+   ViInt32        point     = 0;
+   ViInt32        pending   = 0;
+   ViBoolean      locked    = VI_FALSE;
+   ViBoolean      select;
+   ViReal64       start, deadline, written, error;
+   ViChar         setting[CMD_BUF_SIZE], command[CMD_BUF_SIZE];
+
+   Pro8_RealTimeThread ();
+   start = Pro8_TimeNow ();
+   while (waveform->stop == VI_FALSE)
+   {
+      //Deadline - the lock is taken after the sleep unless the thread kept it
+      deadline = start + (ViReal64)waveform->points * waveform->period;
+      Pro8_SleepUntil (deadline);
+      if (locked == VI_FALSE)
+      {
+         Pro8_Lock (session->instr);
+         locked = VI_TRUE;
+      }
+      //Formatting - the slot is selected if another transaction changed it
+      Pro8_Fmt (setting, Pro8_setpointCommands[waveform->parameter], waveform->setpoints[point]);
+      select = (ViBoolean)(session->slot != waveform->slot);
+      if (select)
+      {
+         Pro8_Fmt (command, ":SLOT %d;%s", waveform->slot, setting);
+         session->slot = session->port = 0;
+      }
+      else strcpy (command, setting);
+      //Writing - no wait for the FIN bit
+      written = Pro8_TimeNow ();
+      if ((status = Pro8_Write (session->instr, command, StringLength (command), &retCnt)) < 0) break;
+      if (select) session->slot = waveform->slot;
+      pending++;
+      //Timing error
+      error = written - deadline;
+      waveform->errors[point] = error;
+      waveform->sumError     += error;
+      if (error > waveform->maxError)        waveform->maxError = error;
+      if (error >= waveform->period)         waveform->late++;
+      waveform->points++;
+      if (++point == waveform->count)
+      {
+         point = 0;
+         waveform->played++;
+         if (waveform->played == (ViUInt32)waveform->cycles) break;
+      }
+      //Check errors and release the lock if there is time enough before the next point
+      deadline = start + (ViReal64)waveform->points * waveform->period;
+      if ((pending >= PRO8_WAVEFORM_SYNC_POINTS) || (deadline - Pro8_TimeNow () > session->averageWait + PRO8_WAVEFORM_SYNC_MARGIN))
+      {
+         pending = 0;
+         locked  = VI_FALSE;
+         if ((status = Pro8_Unlock (session->instr, Pro8_WaveformSync (session->instr))) < 0) break;
+         //A late thread would take the lock again at once
+         if (deadline <= Pro8_TimeNow ()) Pro8_SleepSeconds (PRO8_WAVEFORM_YIELD_TIME);
+      }
+   }
+   //Last points - an error invalidates the active slot
+   if (locked)
+   {
+      if ((status >= 0) && pending) status = Pro8_WaveformSync (session->instr);
+      Pro8_Unlock (session->instr, status);
+   }
+   if (status < 0) Pro8_InvalidateSession (session);
+   waveform->status  = status;
+   waveform->running = VI_FALSE;
+   return 0;
+}
+
+//---------------------------------------------------------------------------
+// Function: Waveform Sync
+// Purpose:  This function waits for the FIN bit after the points written
+//           by the waveform thread and reads the instrument error.
+//---------------------------------------------------------------------------
+ViStatus Pro8_WaveformSync (ViSession instrumentHandle)
+{
+   ViStatus status = VI_SUCCESS;
+   ViUInt16 stb;
+
+   //Poll STB - Check EAV Bit and read error
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
+   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
+   //Ready
+   return status;
+}
+
+//---------------------------------------------------------------------------
+// Function: Loop Free
+// Purpose:  This function stops the control loop thread of a session after
+//           the current cycle and frees the loop.
+//---------------------------------------------------------------------------
+void Pro8_LoopFree (Pro8_tSession *session)
+{
+   Pro8_tLoop *loop;
+
+   if ((loop = session->loop) == VI_NULL) return;
+   loop->stop = VI_TRUE;
+   CmtWaitForThreadPoolFunctionCompletion (loop->pool, loop->worker, 0);
+   CmtReleaseThreadPoolFunctionID (loop->pool, loop->worker);
+   CmtDiscardThreadPool (loop->pool);
+   session->loop = VI_NULL;
+   free (loop);
+}
+
+//---------------------------------------------------------------------------
+// Function: Loop Worker
+// Purpose:  This is the control loop thread of a session. Cycles start at
+//           absolute deadlines, a late cycle starts at once and whole
+//           periods already over are skipped.
+//---------------------------------------------------------------------------
+int CVICALLBACK Pro8_LoopWorker (void *functionData)
+{
+   Pro8_tSession  *session  = (Pro8_tSession*)functionData;
+   Pro8_tLoop     *loop     = session->loop;
+   ViReal64       next, now;
+   ViUInt32       skipped;
+   ViStatus       status;
+
+   Pro8_RealTimeThread ();
+   loop->start = next = Pro8_TimeNow ();
+   while (loop->stop == VI_FALSE)
+   {
+      status = Pro8_LoopCycle (session, loop);
+      //Statistics
+      now = Pro8_TimeNow ();
+      loop->sequence++;
+      Pro8_MemoryBarrier ();
+      loop->statistics.cycles++;
+      loop->statistics.status = status;
+      if (status < 0) loop->statistics.errors++;
+      if (now > loop->start) loop->statistics.rate = loop->statistics.cycles / (now - loop->start);
+      //Next period
+      next += loop->config.period;
+      if (now - next >= loop->config.period)
+      {
+         skipped                     = (ViUInt32)((now - next) / loop->config.period);
+         loop->statistics.missed    += skipped;
+         next                       += loop->config.period * skipped;
+      }
+      Pro8_MemoryBarrier ();
+      loop->sequence++;
+      if (next > now) Pro8_SleepUntil (next);
+   }
+   return 0;
+}
+
+//---------------------------------------------------------------------------
+// Function: Loop Cycle
+// Purpose:  This function runs one cycle of a control loop: it reads the
+//           input, computes the PID output and writes it. The input
+//           channel is read and the output written in one transaction.
+//---------------------------------------------------------------------------
+ViStatus Pro8_LoopCycle (Pro8_tSession *session, Pro8_tLoop *loop)
+{
+   ViStatus          status   = VI_SUCCESS;
+   Pro8_tLoopConfig  *config  = &loop->config;
+   Pro8_tPoolJob     job;
+   ViInt32           index    = 0;
+   ViInt16           slot;
+   ViString          command;
+   ViChar            setting[CMD_BUF_SIZE];
+   ViReal64          input, sampled, time, dt, error, integral, output, latency;
+   ViStatus          result;
+
+   memset (&job, 0, sizeof (job));
+   job.count    = 1;
+   job.index    = &index;
+   job.slot     = &slot;
+   job.commands = &command;
+   job.values   = &input;
+   job.results  = &result;
+   job.times    = &time;
+   //External input - read outside the lock
+   if (config->input)
+   {
+      sampled = Pro8_TimeNow ();
+      status  = config->input (config->inputData, &input);
+      sampled = (sampled + Pro8_TimeNow ()) * 0.5;
+      if (status < 0) return status;
+   }
+   Pro8_Lock (session->instr);
+   //Input channel
+   if (config->input == VI_NULL)
+   {
+      slot    = config->inputSlot;
+      command = loop->query;
+      Pro8_PoolRun (session->instr, &job);
+      if (result < 0) return Pro8_Unlock (session->instr, result);
+      sampled = time;
+   }
+   //PID - the integral is held while it drives the output further into a limit
+   error    = config->target - input;
+   dt       = (loop->lastTime > 0.0) ? sampled - loop->lastTime : 0.0;
+   integral = loop->integral + config->ki * error * dt;
+   output   = config->bias + config->kp * error;
+   if (dt > 0.0) output -= config->kd * (input - loop->lastInput) / dt;
+   if (((output + integral > config->outputMax) && (integral > loop->integral)) ||
+       ((output + integral < config->outputMin) && (integral < loop->integral))) integral = loop->integral;
+   output         += integral;
+   loop->integral  = integral;
+   loop->lastInput = input;
+   loop->lastTime  = sampled;
+   if (output > config->outputMax) output = config->outputMax;
+   if (output < config->outputMin) output = config->outputMin;
+   //Output
+   Pro8_Fmt (setting, Pro8_setpointCommands[config->outputParameter], output);
+   slot       = config->outputSlot;
+   command    = setting;
+   job.values = VI_NULL;
+   job.times  = VI_NULL;
+   Pro8_PoolRun (session->instr, &job);
+   latency = Pro8_TimeNow () - sampled;
+   status  = Pro8_Unlock (session->instr, result);
+   //Statistics - within the sequence of the worker
+   loop->sequence++;
+   Pro8_MemoryBarrier ();
+   loop->statistics.input    = input;
+   loop->statistics.error    = error;
+   loop->statistics.integral = integral;
+   if (status >= 0)
+   {
+      loop->statistics.output       = output;
+      loop->statistics.lastLatency  = latency;
+      loop->sumLatency             += latency;
+      loop->statistics.meanLatency  = loop->sumLatency / ++loop->applied;
+      if (latency > loop->statistics.maxLatency) loop->statistics.maxLatency = latency;
+      if ((output == config->outputMax) || (output == config->outputMin)) loop->statistics.saturated++;
+   }
+   Pro8_MemoryBarrier ();
+   loop->sequence++;
+   //Ready
+   return status;
+}
+
+//---------------------------------------------------------------------------
+// Function: Settle Fit
+// Purpose:  This function fits x(k) = a1 * x(k-1) + a2 * x(k-2) + c to count
+//           samples by least squares. model returns a1, a2 and c, residual
+//           the RMS deviation of the fit from the samples. It returns
+//           VI_FALSE if the samples do not determine the model, e.g. they
+//           are constant.
+//---------------------------------------------------------------------------
+ViBoolean Pro8_SettleFit (ViReal64 x[], ViInt32 count, ViReal64 model[3], ViReal64 *residual)
+{
+   ViReal64 a[3][4], row[3], scale = 0.0, factor, sum = 0.0, e;
+   ViInt32  i, j, k, pivot;
+
+   //Normal equations [A'A | A'y]
+   memset (a, 0, sizeof (a));
+   for (k = 2; k < count; k++)
+   {
+      row[0] = x[k - 1];
+      row[1] = x[k - 2];
+      row[2] = 1.0;
+      for (i = 0; i < 3; i++)
+      {
+         for (j = 0; j < 3; j++) a[i][j] += row[i] * row[j];
+         a[i][3] += row[i] * x[k];
+      }
+   }
+   for (i = 0; i < 3; i++) if (a[i][i] > scale) scale = a[i][i];
+   //Gaussian elimination with partial pivoting
+   for (i = 0; i < 3; i++)
+   {
+      for (pivot = i, k = i + 1; k < 3; k++) if (fabs (a[k][i]) > fabs (a[pivot][i])) pivot = k;
+      if (fabs (a[pivot][i]) <= scale * 1.0e-12) return VI_FALSE;
+      for (j = 0; j < 4; j++)
+      {
+         factor      = a[i][j];
+         a[i][j]     = a[pivot][j];
+         a[pivot][j] = factor;
+      }
+      for (k = i + 1; k < 3; k++)
+      {
+         factor = a[k][i] / a[i][i];
+         for (j = i; j < 4; j++) a[k][j] -= factor * a[i][j];
+      }
+   }
+   for (i = 2; i >= 0; i--)
+   {
+      model[i] = a[i][3];
+      for (j = i + 1; j < 3; j++) model[i] -= a[i][j] * model[j];
+      model[i] /= a[i][i];
+   }
+   //Residual
+   for (k = 2; k < count; k++)
+   {
+      e    = x[k] - (model[0] * x[k - 1] + model[1] * x[k - 2] + model[2]);
+      sum += e * e;
+   }
+   *residual = sqrt (sum / (count - 2));
+   //Ready
+   return VI_TRUE;
+}
+
+//---------------------------------------------------------------------------
+// Function: Settle Predict
+// Purpose:  This function continues the fitted response from the last
+//           samples x1 = x(k) and x2 = x(k-1) over PRO8_SETTLE_HORIZON
+//           intervals. It returns the number of intervals until the
+//           response stays within tolerance, 0 if it already does and -1
+//           if it does not within the horizon.
+//---------------------------------------------------------------------------
+ViReal64 Pro8_SettlePredict (ViReal64 model[3], ViReal64 x1, ViReal64 x2, ViReal64 tolerance)
+{
+   ViReal64 x;
+   ViInt32  k, last = 0;
+
+   for (k = 1; k <= PRO8_SETTLE_HORIZON; k++)
+   {
+      x  = model[0] * x1 + model[1] * x2 + model[2];
+      x2 = x1;
+      x1 = x;
+      if (fabs (x) > tolerance) last = k;
+   }
+   //Ready
+   return (last == PRO8_SETTLE_HORIZON) ? -1.0 : (ViReal64)last;
+}
+
+//---------------------------------------------------------------------------
+// Function: Tune Run
+// Purpose:  This function writes a command or query to the slot of an auto
+//           tune experiment in one transaction. value (may be VI_NULL)
+//           returns the response of a query.
+//---------------------------------------------------------------------------
+ViStatus Pro8_TuneRun (Pro8_tTune *tune, ViString command, ViReal64 *value)
+{
+   ViStatus       status   = VI_SUCCESS;
+   Pro8_tPoolJob  job;
+   ViInt32        index    = 0;
+   ViStatus       result   = VI_SUCCESS;
+   ViReal64       response = 0.0;
+
+   memset (&job, 0, sizeof (job));
+   job.count    = 1;
+   job.index    = &index;
+   job.slot     = &tune->slot;
+   job.commands = &command;
+   job.values   = &response;
+   job.results  = &result;
+   Pro8_Lock (tune->instr);
+   status = Pro8_Unlock (tune->instr, Pro8_PoolRun (tune->instr, &job));
+   if (status >= 0) status = result;
+   if (status < 0) return status;
+   if (value) *value = response;
+   //Ready
+   return VI_SUCCESS;
+}
+
+//---------------------------------------------------------------------------
+// Function: Tune Sample
+// Purpose:  This function reads the temperature and the TEC current of the
+//           slot of an auto tune experiment in one transaction.
+//---------------------------------------------------------------------------
+ViStatus Pro8_TuneSample (Pro8_tTune *tune, ViReal64 *temperature, ViReal64 *current)
+{
+   ViStatus       status   = VI_SUCCESS;
+   Pro8_tPoolJob  job;
+   ViInt32        index[2] = {0, 1};
+   ViInt16        slot[2];
+   ViString       commands[2] = {":TEMP:ACT?", ":ITE:ACT?"};
+   ViReal64       values[2]   = {0.0, 0.0};
+   ViStatus       results[2]  = {VI_SUCCESS, VI_SUCCESS};
+
+   memset (&job, 0, sizeof (job));
+   slot[0] = slot[1] = tune->slot;
+   job.count    = 2;
+   job.index    = index;
+   job.slot     = slot;
+   job.commands = commands;
+   job.values   = values;
+   job.results  = results;
+   Pro8_Lock (tune->instr);
+   if ((status = Pro8_Unlock (tune->instr, Pro8_PoolRun (tune->instr, &job))) < 0) return status;
+   if (results[0] < 0) return results[0];
+   if (results[1] < 0) return results[1];
+   *temperature = values[0];
+   *current     = values[1];
+   //Ready
+   return VI_SUCCESS;
+}
+
+//---------------------------------------------------------------------------
+// Function: Tune Shares
+// Purpose:  This function writes the PID shares and the set temperature of
+//           the slot of an auto tune experiment as one compound command.
+//---------------------------------------------------------------------------
+ViStatus Pro8_TuneShares (Pro8_tTune *tune, ViReal64 PShare, ViReal64 IShare, ViReal64 DShare, ViReal64 temperature)
+{
+   ViChar buffer[CMD_BUF_SIZE];
+
+   Pro8_Fmt (buffer, ":SHAREP:SET %f;:SHAREI:SET %f;:SHARED:SET %f;:TEMP:SET %f", PShare, IShare, DShare, temperature);
+   return Pro8_TuneRun (tune, buffer, VI_NULL);
+}
+
+//---------------------------------------------------------------------------
+// Function: Tune Step
+// Purpose:  This function sets the temperature of the slot of an auto tune
+//           experiment and waits until it has settled. settleTime (may be
+//           VI_NULL) returns the time waited.
+//---------------------------------------------------------------------------
+ViStatus Pro8_TuneStep (Pro8_tTune *tune, ViReal64 temperature, ViReal64 *settleTime)
+{
+   ViStatus status;
+   ViChar   buffer[CMD_BUF_SIZE];
+   ViReal64 actual;
+
+   Pro8_Fmt (buffer, ":TEMP:SET %f", temperature);
+   if ((status = Pro8_TuneRun (tune, buffer, VI_NULL)) < 0) return status;
+   tune->start = Pro8_TimeNow ();
+   return Pro8_TecWaitSettled (tune->instr, tune->slot, tune->tolerance, tune->timeout, Pro8_TuneProgress, tune, settleTime, &actual);
+}
+
+//---------------------------------------------------------------------------
+// Function: Tune Progress
+// Purpose:  This function passes the samples of Pro8_TecWaitSettled to the
+//           callback of an auto tune experiment.
+//---------------------------------------------------------------------------
+ViBoolean _VI_FUNCH Pro8_TuneProgress (ViSession instrumentHandle, ViReal64 elapsed, ViReal64 temperature, ViReal64 predicted, ViAddr callbackData)
+{
+   Pro8_tTune *tune = (Pro8_tTune*)callbackData;
+
+   if (tune->callback == VI_NULL) return VI_TRUE;
+   return tune->callback (instrumentHandle, tune->phase, Pro8_TimeNow () - tune->start, temperature, tune->callbackData);
+}
+
+//---------------------------------------------------------------------------
+// Function: Tune Relay
+// Purpose:  This function runs the relay experiment of an auto tune and
+//           returns the ultimate gain (A/K) and period (seconds) and the
+//           amplitude (K) of the temperature oscillation. The relay is
+//           switched when the temperature leaves the hysteresis band
+//           around the set temperature.
+//---------------------------------------------------------------------------
+ViStatus Pro8_TuneRelay (Pro8_tTune *tune, ViReal64 minimum[3], ViReal64 maximum[3], ViReal64 *ultimateGain, ViReal64 *ultimatePeriod, ViReal64 *amplitude)
+{
+   ViStatus  status   = VI_SUCCESS;
+   ViChar    buffer[CMD_BUF_SIZE];
+   ViBoolean high     = VI_TRUE;
+   ViInt32   ups      = 0;
+   ViReal64  hysteresis, temperature, current, now, next, up = 0.0;
+   ViReal64  minT = 0.0, maxT = 0.0, minI = 0.0, maxI = 0.0;
+
+   hysteresis = tune->amplitude * PRO8_TUNE_HYSTERESIS;
+   //Maximum P share, minimum I and D share - relay up
+   if ((status = Pro8_TuneShares (tune, maximum[0], minimum[1], minimum[2], tune->temperature + tune->amplitude)) < 0) return status;
+   tune->start = next = Pro8_TimeNow ();
+   for (;;)
+   {
+      if ((status = Pro8_TuneSample (tune, &temperature, &current)) < 0) return status;
+      now = Pro8_TimeNow ();
+      if (tune->callback && (tune->callback (tune->instr, tune->phase, now - tune->start, temperature, tune->callbackData) == VI_FALSE)) return VI_ERROR_ABORT;
+      if (now - tune->start >= tune->timeout) return VI_ERROR_TMO;
+      //Extremes of the measured periods
+      if (ups > PRO8_TUNE_SKIP)
+      {
+         if (temperature < minT) minT = temperature;
+         if (temperature > maxT) maxT = temperature;
+         if (current < minI)     minI = current;
+         if (current > maxI)     maxI = current;
+      }
+      //Relay
+      if (high && (temperature > tune->temperature + hysteresis))
+      {
+         high = VI_FALSE;
+         Pro8_Fmt (buffer, ":TEMP:SET %f", tune->temperature - tune->amplitude);
+         if ((status = Pro8_TuneRun (tune, buffer, VI_NULL)) < 0) return status;
+      }
+      else if ((high == VI_FALSE) && (temperature < tune->temperature - hysteresis))
+      {
+         high = VI_TRUE;
+         Pro8_Fmt (buffer, ":TEMP:SET %f", tune->temperature + tune->amplitude);
+         if ((status = Pro8_TuneRun (tune, buffer, VI_NULL)) < 0) return status;
+         //A period starts with each switch up
+         if (++ups == PRO8_TUNE_SKIP + 1)
+         {
+            up   = now;
+            minT = maxT = temperature;
+            minI = maxI = current;
+         }
+         if (ups == PRO8_TUNE_SKIP + 1 + PRO8_TUNE_CYCLES) break;
+      }
+      next += PRO8_SETTLE_INTERVAL;
+      if (next < Pro8_TimeNow ()) next = Pro8_TimeNow ();
+      Pro8_SleepUntil (next);
+   }
+   //Describing function of the relay with hysteresis
+   *amplitude      = (maxT - minT) * 0.5;
+   *ultimatePeriod = (now - up) / PRO8_TUNE_CYCLES;
+   if (*amplitude <= hysteresis) return VI_ERROR_INSTR_INTERPRETING_RESPONSE;
+   *ultimateGain   = 4.0 * (maxI - minI) * 0.5 / (3.14159265358979 * sqrt (*amplitude * *amplitude - hysteresis * hysteresis));
+   //Ready
+   return VI_SUCCESS;
+}
+
+//---------------------------------------------------------------------------
+// Function: Tune Calibrate
+// Purpose:  This function returns the TEC current per share unit and
+//           Kelvin of the P share (A/K) and of the I share (A/K/s). A
+//           small step of the set temperature is answered with a P share
+//           only and with an I share only. If the current of the I share
+//           does not ramp measurably, VI_ERROR_INSTR_INTERPRETING_RESPONSE
+//           is returned.
+//---------------------------------------------------------------------------
+ViStatus Pro8_TuneCalibrate (Pro8_tTune *tune, ViReal64 minimum[3], ViReal64 maximum[3], ViReal64 *PGain, ViReal64 *IGain)
+{
+   ViStatus status;
+   ViReal64 step, share, limit, temperature, current, first, start, error;
+   ViInt32  i;
+
+   step = tune->amplitude * PRO8_TUNE_CALIBRATE_STEP;
+   if ((status = Pro8_TuneRun (tune, ":LIMT:SET?", &limit)) < 0) return status;
+   tune->start = Pro8_TimeNow ();
+   //P share - halved while the current is at the limit
+   share = (minimum[0] + maximum[0]) * 0.5;
+   for (i = 0; ; i++)
+   {
+      if ((status = Pro8_TuneShares (tune, share, minimum[1], minimum[2], tune->temperature + step)) < 0) return status;
+      Pro8_SleepSeconds (PRO8_SETTLE_INTERVAL);
+      if ((status = Pro8_TuneSample (tune, &temperature, &current)) < 0) return status;
+      if ((fabs (current) < limit * 0.9) || (i == 3)) break;
+      share *= 0.5;
+   }
+   error = tune->temperature + step - temperature;
+   if ((share <= 0.0) || (error == 0.0) || (current == 0.0)) return VI_ERROR_INSTR_INTERPRETING_RESPONSE;
+   *PGain = fabs (current / (error * share));
+   //I share - ramp of the current after the shares are settled
+   share = (minimum[1] + maximum[1]) * 0.5;
+   if ((status = Pro8_TuneShares (tune, minimum[0], share, minimum[2], tune->temperature + step)) < 0) return status;
+   Pro8_SleepSeconds (PRO8_SETTLE_INTERVAL);
+   start = Pro8_TimeNow ();
+   if ((status = Pro8_TuneSample (tune, &temperature, &first)) < 0) return status;
+   Pro8_SleepSeconds (PRO8_TUNE_CALIBRATE_TIME);
+   if ((status = Pro8_TuneSample (tune, &temperature, &current)) < 0) return status;
+   error = tune->temperature + step - temperature;
+   if ((share <= 0.0) || (error == 0.0) || (current == first)) return VI_ERROR_INSTR_INTERPRETING_RESPONSE;
+   *IGain = fabs ((current - first) / (error * (Pro8_TimeNow () - start) * share));
+   //Ready
+   return VI_SUCCESS;
+}
+
+//---------------------------------------------------------------------------
+// Function: Shadow Query
+// Purpose:  This function returns the value of a query of the active slot
+//           without the response header. In shadow mode the value is taken
+//           from the shadow model, a value not in the model is read from
+//           the instrument and stored. Queries of actual values (":ACT?")
+//           are always read.
+//---------------------------------------------------------------------------
+ViStatus Pro8_ShadowQuery (ViSession instrumentHandle, ViString query, ViBoolean answer, ViChar value[], ViUInt32 size)
+{
+   ViStatus          status   = VI_SUCCESS;
+   ViUInt32          retCnt   = 0;
+   ViUInt32          length;
+   ViUInt16          stb;
+   ViBoolean         shadow;
+   ViChar            buffer[CMD_BUF_SIZE], rest[CMD_BUF_SIZE];
+   Pro8_tShadowEntry *entry;
+   Pro8_tSession     *session;
+
+   session = Pro8_GetSession (instrumentHandle);
+   shadow  = (ViBoolean)(session && session->shadowMode && session->slot && (strstr (query, ":ACT?") == VI_NULL));
+   //Shadow model
+   if (shadow && ((entry = Pro8_ShadowFresh (session, session->slot, query)) != VI_NULL))
+   {
+      session->shadowHits++;
+      length = StringLength (entry->value);
+      if (length >= size) length = size - 1;
+      memcpy (value, entry->value, length);
+      value[length] = '\0';
+      return VI_SUCCESS;
+   }
+   //Writing - Poll STB - Check EAV Bit and read error - Reading
+   if ((status = Pro8_Write (instrumentHandle, query, StringLength (query), &retCnt)) < 0) return status;
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
+   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
+   if ((status = Pro8_Read (instrumentHandle, buffer, sizeof (buffer) - 1, &retCnt)) < 0) return status;
+   buffer[retCnt] = '\0';
+   //Discard the rest of a long response
+   while (status == VI_SUCCESS_MAX_CNT)
+   {
+      if ((status = Pro8_Read (instrumentHandle, rest, sizeof (rest), &retCnt)) < 0) return status;
+   }
+   Pro8_ShadowValue (buffer, answer, value, size);
+   //Store
+   if (shadow)
+   {
+      session->shadowMisses++;
+      Pro8_ShadowStore (session, session->slot, query, value);
+   }
+   //Ready
+   return VI_SUCCESS;
+}
+
+//---------------------------------------------------------------------------
+// Function: Shadow Real
+// Purpose:  This function returns the number of a query of the active slot
+//           from the shadow model or the instrument, see Pro8_ShadowQuery.
+//           In metadata mode MIN and MAX are taken from the slot data.
+//---------------------------------------------------------------------------
+ViStatus Pro8_ShadowReal (ViSession instrumentHandle, ViString query, ViBoolean answer, ViReal64 *value)
+{
+   ViStatus       status;
+   ViUInt32       length   = StringLength (query);
+   ViChar         buffer[PRO8_SHADOW_VALUE_WIDTH];
+   Pro8_tLimit    limit;
+   Pro8_tSession  *session;
+
+   //Limits from the slot data
+   session = Pro8_GetSession (instrumentHandle);
+   if (session && session->metadataMode && session->slot && (length > 5) && (length - 5 < PRO8_META_HEADER_WIDTH) &&
+       ((strcmp (&query[length - 5], ":MIN?") == 0) || (strcmp (&query[length - 5], ":MAX?") == 0)))
+   {
+      memcpy (buffer, query, length - 5);
+      buffer[length - 5] = '\0';
+      if ((status = Pro8_MetaLimit (instrumentHandle, session->slot, buffer, &limit)) < 0) return status;
+      *value = (query[length - 3] == 'I') ? limit.minimum : limit.maximum;
+      return VI_SUCCESS;
+   }
+   if ((status = Pro8_ShadowQuery (instrumentHandle, query, answer, buffer, sizeof (buffer))) < 0) return status;
+   //Evaluate
+   return Pro8_ParseReal (buffer, 1, value);
+}
+
+//---------------------------------------------------------------------------
+// Function: Shadow Write
+// Purpose:  This function stores the values of the setting commands in a
+//           command written by a session, e.g. ":SLOT 2;:ILD:SET 0.01"
+//           stores "0.01" as ":ILD:SET?" of slot 2. Limits (MIN, MAX) of a
+//           slot depend on its settings and are discarded. A reset or
+//           recall discards the model.
+//---------------------------------------------------------------------------
+void Pro8_ShadowWrite (Pro8_tSession *session, ViBuf buffer, ViUInt32 count)
+{
+   ViChar   command[PRO8_BATCH_MAX_LENGTH + 1];
+   ViChar   query[PRO8_SHADOW_QUERY_WIDTH];
+   ViChar   *segment, *next, *arg;
+   ViInt16  slot     = session->slot;
+   ViUInt32 length;
+   ViInt32  i;
+
+   if (count > PRO8_BATCH_MAX_LENGTH) return;
+   memcpy (command, buffer, count);
+   command[count] = '\0';
+   for (segment = command; segment; segment = next)
+   {
+      //Next segment
+      if ((next = strchr (segment, ';')) != VI_NULL) *next++ = '\0';
+      while ((*segment == ' ') || (*segment == '\t')) segment++;
+      length = StringLength (segment);
+      while (length && ((segment[length - 1] == '\n') || (segment[length - 1] == '\r') || (segment[length - 1] == ' '))) segment[--length] = '\0';
+      if (strchr (segment, '?')) continue;
+      if ((strncmp (segment, "*RST", 4) == 0) || (strncmp (segment, "*RCL", 4) == 0))
+      {
+         Pro8_ShadowClear (session);
+         continue;
+      }
+      //Header and value
+      if ((arg = strchr (segment, ' ')) == VI_NULL) continue;
+      *arg++ = '\0';
+      while (*arg == ' ') arg++;
+      if (strcmp (segment, ":SLOT") == 0)
+      {
+         slot = (ViInt16)atoi (arg);
+         continue;
+      }
+      if ((slot == 0) || (*arg == '\0') || (StringLength (segment) + 2 > PRO8_SHADOW_QUERY_WIDTH)) continue;
+      //Discard limits of the slot - store
+      for (i = 0; i < PRO8_SHADOW_SIZE; i++)
+      {
+         if ((session->shadow[i].slot == slot) && (strstr (session->shadow[i].query, ":MIN?") || strstr (session->shadow[i].query, ":MAX?"))) session->shadow[i].slot = 0;
+      }
+      Pro8_Fmt (query, "%s?", segment);
+      Pro8_ShadowStore (session, slot, query, arg);
+   }
+}
+
+//---------------------------------------------------------------------------
+// Function: Shadow Find
+// Purpose:  This function returns the shadow model entry of a query of a
+//           slot or VI_NULL if the value is not in the model.
+//---------------------------------------------------------------------------
+Pro8_tShadowEntry *Pro8_ShadowFind (Pro8_tSession *session, ViInt16 slot, ViString query)
+{
+   ViInt32 i;
+
+   for (i = 0; i < PRO8_SHADOW_SIZE; i++)
+   {
+      if ((session->shadow[i].slot == slot) && (strcmp (session->shadow[i].query, query) == 0)) return &session->shadow[i];
+   }
+   return VI_NULL;
+}
+
+//---------------------------------------------------------------------------
+// Function: Shadow Fresh
+// Purpose:  This function returns the shadow model entry of a query of a
+//           slot if it is not older than the max age of the session, else
+//           VI_NULL.
+//---------------------------------------------------------------------------
+Pro8_tShadowEntry *Pro8_ShadowFresh (Pro8_tSession *session, ViInt16 slot, ViString query)
+{
+   Pro8_tShadowEntry *entry;
+
+   if ((entry = Pro8_ShadowFind (session, slot, query)) == VI_NULL) return VI_NULL;
+   if ((session->shadowMaxAge > 0.0) && (Pro8_TimeNow () - entry->time > session->shadowMaxAge)) return VI_NULL;
+   return entry;
+}
+
+//---------------------------------------------------------------------------
+// Function: Shadow Store
+// Purpose:  This function stores a value in the shadow model. It replaces
+//           the value of the same query or the oldest value if the model
+//           is full.
+//---------------------------------------------------------------------------
+void Pro8_ShadowStore (Pro8_tSession *session, ViInt16 slot, ViString query, ViString value)
+{
+   Pro8_tShadowEntry *entry;
+   ViUInt32          length;
+   ViInt32           i;
+
+   if (StringLength (query) >= PRO8_SHADOW_QUERY_WIDTH) return;
+   if ((entry = Pro8_ShadowFind (session, slot, query)) == VI_NULL)
+   {
+      //Free or oldest entry
+      entry = &session->shadow[0];
+      for (i = 0; i < PRO8_SHADOW_SIZE; i++)
+      {
+         if (session->shadow[i].slot == 0)
+         {
+            entry = &session->shadow[i];
+            break;
+         }
+         if (session->shadow[i].time < entry->time) entry = &session->shadow[i];
+      }
+      strcpy (entry->query, query);
+      entry->slot = slot;
+   }
+   length = StringLength (value);
+   if (length >= PRO8_SHADOW_VALUE_WIDTH) length = PRO8_SHADOW_VALUE_WIDTH - 1;
+   memcpy (entry->value, value, length);
+   entry->value[length] = '\0';
+   entry->time = Pro8_TimeNow ();
+}
+
+//---------------------------------------------------------------------------
+// Function: Shadow Clear
+// Purpose:  This function discards all values of the shadow model.
+//---------------------------------------------------------------------------
+void Pro8_ShadowClear (Pro8_tSession *session)
+{
+   ViInt32 i;
+
+   for (i = 0; i < PRO8_SHADOW_SIZE; i++) session->shadow[i].slot = 0;
+}
+
+//---------------------------------------------------------------------------
+// Function: Shadow Value
+// Purpose:  This function copies the value of a response to value. In full
+//           answer mode (answer = 0) the response header is skipped.
+//---------------------------------------------------------------------------
+void Pro8_ShadowValue (ViString response, ViBoolean answer, ViChar value[], ViUInt32 size)
+{
+   ViChar   *p = response;
+   ViUInt32 length;
+
+   while ((*p == ' ') || (*p == '\t')) p++;
+   if (answer == 0)
+   {
+      while (*p && (*p != ' ') && (*p != '\t')) p++;
+      while ((*p == ' ') || (*p == '\t')) p++;
+   }
+   for (length = 0; (length < size - 1) && p[length] && (p[length] != '\r') && (p[length] != '\n'); length++) value[length] = p[length];
+   while (length && (value[length - 1] == ' ')) length--;
+   value[length] = '\0';
+}
+
+//---------------------------------------------------------------------------
+// Function: Read Slot Data
+// Purpose:  This function reads the slot data of the active slot. In
+//           metadata mode it is taken from the session if known.
+//---------------------------------------------------------------------------
+ViStatus Pro8_ReadSlotData (ViSession instrumentHandle, ViBoolean extended, Pro8_tSlotInfo *info)
+{
+   ViStatus       status     = VI_SUCCESS;
+   ViInt16        o[10], t, s, i;
+   ViString       queries1[] = {":TYPE:ID?", ":TYPE:SUB?", ":TYPE:TXT?", ":TYPE:OPT?"};
+   ViString       queries2[] = {":TYPE:ID?", ":TYPE:SUB?", ":TYPE:TXT?", ":TYPE:SN?", ":TYPE:OPT?"};
+   ViString       answers[5];
+   ViChar         response[RESPONSE_BUF_SIZE];
+   ViBoolean      answer;
+   ViString       format1[]  = {"%*s %d", "%d"};
+   ViString       format2[]  = {"%*s %d", "%d"};
+   ViString       format3[]  = {"%*s \"%[^\"]", "\"%[^\"]"};
+   ViString       format4[]  = {"%*s %d,%d,%d,%d,%d,%d,%d,%d,%d,%d", "%d,%d,%d,%d,%d,%d,%d,%d,%d,%d"};
+   ViString       format5[]  = {"%*s %s", "%s"};
+   Pro8_tSlotInfo *known     = VI_NULL;
+   Pro8_tSession  *session;
+
+   //Known
+   session = Pro8_GetSession (instrumentHandle);
+   if (session && session->metadataMode && session->slot)
+   {
+      if ((status = Pro8_MetaSlot (instrumentHandle, session)) < 0) return status;
+      known = &session->meta[session->slot - 1];
+      if (known->identValid && (known->serialValid || (extended == VI_FALSE)))
+      {
+         *info = *known;
+         return VI_SUCCESS;
+      }
+   }
+   memset (info, 0, sizeof (Pro8_tSlotInfo));
+   if ((status = Pro8_GetAnswer (instrumentHandle, &answer)) < 0) return status;
+   //Writing - Poll STB - Check EAV Bit and read error - Reading
+   if (extended) status = Pro8_CompoundQuery (instrumentHandle, 5, queries2, response, sizeof (response), answers);
+   else          status = Pro8_CompoundQuery (instrumentHandle, 4, queries1, response, sizeof (response), answers);
+   if (status < 0) return status;
+   if ((status = Pro8_Scan (answers[0], format1[answer], &t)) < 0) return status;
+   if ((status = Pro8_Scan (answers[1], format2[answer], &s)) < 0) return status;
+   if ((status = Pro8_Scan (answers[2], format3[answer], info->ident)) < 0) return status;
+   if (extended && ((status = Pro8_Scan (answers[3], format5[answer], info->serial)) < 0)) return status;
+   if ((status = Pro8_Scan (answers[extended ? 4 : 3], format4[answer], &o[0], &o[1], &o[2], &o[3], &o[4], &o[5], &o[6], &o[7], &o[8], &o[9])) < 0) return status;
+   info->type = t;
+   info->sub  = s;
+   for (i = 0; i < 10; i++) info->options[i] = o[i];
+   info->identValid  = VI_TRUE;
+   info->serialValid = extended;
+   //Store Data - the limits stay
+   if (known)
+   {
+      known->type = t;
+      known->sub  = s;
+      strcpy (known->ident, info->ident);
+      if (extended) strcpy (known->serial, info->serial);
+      memcpy (known->options, info->options, sizeof (known->options));
+      known->identValid  = VI_TRUE;
+      known->serialValid = (ViBoolean)(known->serialValid || extended);
+   }
+   //Ready
+   return status;
+}
+
+//---------------------------------------------------------------------------
+// Function: Meta Slot
+// Purpose:  This function queries the plug configuration when the plug
+//           check interval has elapsed, so the data of changed modules is
+//           dropped before it is used.
+//---------------------------------------------------------------------------
+ViStatus Pro8_MetaSlot (ViSession instrumentHandle, Pro8_tSession *session)
+{
+   ViInt16 type[PRO8_NUM_SLOTS], sub[PRO8_NUM_SLOTS];
+
+   if ((session->plugCheckInterval > 0.0) && (Pro8_TimeNow () - session->plugChecked >= session->plugCheckInterval)) session->plugValid = VI_FALSE;
+   return Pro8_ReadPlugConfig (instrumentHandle, type, sub);
+}
+
+//---------------------------------------------------------------------------
+// Function: Meta Limit
+// Purpose:  This function returns the MIN/MAX limits of a parameter of a
+//           slot. In metadata mode they are read once per module and kept
+//           in the slot data, a parameter without limits keeps its
+//           instrument error. Transport errors are not kept, the next call
+//           reads the limits again.
+//---------------------------------------------------------------------------
+ViStatus Pro8_MetaLimit (ViSession instrumentHandle, ViInt16 slot, ViString header, Pro8_tLimit *limit)
+{
+   ViStatus       status   = VI_SUCCESS;
+   ViInt32        index[2] = {0, 1};
+   ViInt16        slots[2];
+   ViChar         queries[2][PRO8_META_HEADER_WIDTH + 5];
+   ViString       commands[2];
+   ViReal64       values[2];
+   ViStatus       results[2];
+   ViInt16        i;
+   Pro8_tSlotInfo *info;
+   Pro8_tLimit    *entry;
+   Pro8_tPoolJob  job;
+   Pro8_tSession  *session;
+
+   //Known
+   session = Pro8_GetSession (instrumentHandle);
+   entry   = VI_NULL;
+   if (session && session->metadataMode)
+   {
+      if ((status = Pro8_MetaSlot (instrumentHandle, session)) < 0) return status;
+      info = &session->meta[slot - 1];
+      for (i = 0; i < info->limitCount; i++)
+      {
+         if (strcmp (info->limits[i].header, header) == 0)
+         {
+            *limit = info->limits[i];
+            return limit->status;
+         }
+      }
+      entry = &info->limits[(info->limitCount < PRO8_META_LIMITS) ? info->limitCount : PRO8_META_LIMITS - 1];
+   }
+   //Writing - Reading
+   Pro8_Fmt (queries[0], "%s:MIN?", header);
+   Pro8_Fmt (queries[1], "%s:MAX?", header);
+   commands[0] = queries[0];
+   commands[1] = queries[1];
+   slots[0]    = slots[1] = slot;
+   memset (&job, 0, sizeof (job));
+   job.count    = 2;
+   job.index    = index;
+   job.slot     = slots;
+   job.commands = commands;
+   job.values   = values;
+   job.results  = results;
+   status = Pro8_PoolRun (instrumentHandle, &job);
+   //Store Data
+   strcpy (limit->header, header);
+   limit->status  = status;
+   limit->minimum = values[0];
+   limit->maximum = values[1];
+   if (entry && ((status >= VI_SUCCESS) || ((status >= VI_INSTR_ERROR_OFFSET) && (status <= VI_INSTR_ERROR_MAXIMUM))))
+   {
+      *entry = *limit;
+      if (info->limitCount < PRO8_META_LIMITS) info->limitCount++;
+   }
+   //Ready
+   return status;
+}
+
+//---------------------------------------------------------------------------
+// Function: Meta Check
+// Purpose:  This function checks a command before it is written. A setting
+//           command ":xxx:SET value" of the active slot is rejected if the
+//           value is outside the limits of the module. The limits are read
+//           if needed, unless commands are collected or not yet checked for
+//           errors, then only known limits are used. Configuration commands
+//           drop the limits of their slot.
+//---------------------------------------------------------------------------
+ViStatus Pro8_MetaCheck (ViSession instrumentHandle, Pro8_tSession *session, ViBuf buffer, ViUInt32 count)
+{
+   ViStatus       status   = VI_SUCCESS;
+   ViChar         command[PRO8_BATCH_MAX_LENGTH + 1];
+   ViChar         *segment, *next, *arg;
+   ViInt16        slot     = session->slot;
+   ViInt16        i;
+   ViUInt32       length;
+   ViReal64       value, margin;
+   ViBoolean      single, known;
+   Pro8_tLimit    limit;
+   Pro8_tSlotInfo *info;
+
+   if ((count > PRO8_BATCH_MAX_LENGTH) || (memchr (buffer, '?', count) != VI_NULL)) return VI_SUCCESS;
+   memcpy (command, buffer, count);
+   command[count] = '\0';
+   single = (ViBoolean)(strchr (command, ';') == VI_NULL);
+   for (segment = command; segment; segment = next)
+   {
+      //Header and value
+      if ((next = strchr (segment, ';')) != VI_NULL) *next++ = '\0';
+      while (*segment == ' ') segment++;
+      if ((arg = strchr (segment, ' ')) == VI_NULL) continue;
+      *arg++ = '\0';
+      if (strcmp (segment, ":SLOT") == 0)
+      {
+         slot = (ViInt16)atoi (arg);
+         continue;
+      }
+      if ((slot < 1) || (slot > PRO8_NUM_SLOTS) || (strcmp (segment, ":PORT") == 0)) continue;
+      info   = &session->meta[slot - 1];
+      length = StringLength (segment);
+      //Configuration - the limits may depend on it
+      if ((length <= 4) || strcmp (&segment[length - 4], ":SET"))
+      {
+         info->limitCount = 0;
+         continue;
+      }
+      if (length - 4 >= PRO8_META_HEADER_WIDTH) continue;
+      segment[length - 4] = '\0';
+      //Limits - known or read
+      known = VI_FALSE;
+      for (i = 0; i < info->limitCount; i++)
+      {
+         if (strcmp (info->limits[i].header, segment) == 0) known = VI_TRUE;
+      }
+      if ((known == VI_FALSE) && ((single == VI_FALSE) || Pro8_BatchOwner (session) || session->writePending ||
+          (session->errorCheckMode != PRO8_ERROR_CHECK_IMMEDIATE))) continue;
+      if (Pro8_MetaLimit (instrumentHandle, slot, segment, &limit) < 0) continue;
+      //Check
+      if (Pro8_ParseReal (arg, 1, &value) < 0) continue;
+      margin = (limit.maximum - limit.minimum) * 1.0e-9;
+      if ((value < limit.minimum - margin) || (value > limit.maximum + margin)) status = VI_ERROR_VALUE_OUT_OF_LIMITS;
+   }
+   //Ready
+   return status;
+}
+
+//---------------------------------------------------------------------------
+// Function: Meta Plug
+// Purpose:  This function compares a plug configuration read from the
+//           instrument with the slot data. The data of slots whose module
+//           changed is dropped and the checksum is updated.
+//---------------------------------------------------------------------------
+void Pro8_MetaPlug (Pro8_tSession *session, ViInt16 type[], ViInt16 sub[])
+{
+   ViUInt32 checksum = 0;
+   ViInt16  i;
+
+   for (i = 0; i < PRO8_NUM_SLOTS; i++)
+   {
+      checksum = (checksum << 5) + (checksum >> 27) + (ViUInt16)type[i];
+      checksum = (checksum << 5) + (checksum >> 27) + (ViUInt16)sub[i];
+      if ((session->meta[i].plugType == type[i]) && (session->meta[i].plugSub == sub[i])) continue;
+      memset (&session->meta[i], 0, sizeof (Pro8_tSlotInfo));
+      session->meta[i].plugType = type[i];
+      session->meta[i].plugSub  = sub[i];
+   }
+   if (session->plugChecked && (checksum != session->plugChecksum)) session->plugChanges++;
+   session->plugChecksum = checksum;
+   session->plugChecked  = Pro8_TimeNow ();
+}
+
+//---------------------------------------------------------------------------
+// Function: Enable Service Request
+// Purpose:  This function enables or disables the service request raised
+//           by the FIN bit. If the interface does not support service
+//           request events the function returns VI_SUCCESS and the
+//           session keeps polling the status byte.
+//---------------------------------------------------------------------------
+ViStatus Pro8_EnableSrq (ViSession instrumentHandle, Pro8_tSession *session, ViBoolean enable)
+{
+   ViStatus status = VI_SUCCESS;
    ViUInt32 retCnt = 0;
    ViUInt16 stb;
-   ViString command[] = {":ILD:MEAS?", ":IMD:MEAS?", ":VLD:MEAS?", ":ITE:MEAS?", ":VTE:MEAS?", ":RESI:MEAS?", ":TEMP:MEAS?"};
-   ViBoolean answer;
-   ViString  format[] = {"%*s %d", "%d"};
 
-   if ((status = viGetAttribute (instrumentHandle, VI_ATTR_USER_DATA, &answer)) < 0) return status;
-   //Check input parameter ranges
-   if (Pro8_invalidViInt16Range (measurementParameter, 0, 6))  return VI_ERROR_PARAMETER2;
-   //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, command[measurementParameter], StringLength (command[measurementParameter]), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format[answer], position)) < 0) return status;
+   if (enable == session->srqEnabled) return VI_SUCCESS;
+   if (enable)
+   {
+      //Event first - interfaces without service requests keep polling
+      if (viEnableEvent (instrumentHandle, VI_EVENT_SERVICE_REQ, VI_QUEUE, VI_NULL) < 0) return VI_SUCCESS;
+      //Writing - Poll STB - Check EAV Bit and read error
+      if ((status = Pro8_Send (instrumentHandle, "*SRE 1", 6, &retCnt)) >= 0)
+      {
+         if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) >= 0)
+         {
+            if (stb & 0x0004) status = Pro8_GetInstrumentError (instrumentHandle);
+         }
+      }
+      if (status < 0)
+      {
+         viDisableEvent (instrumentHandle, VI_EVENT_SERVICE_REQ, VI_QUEUE);
+         return status;
+      }
+      viDiscardEvents (instrumentHandle, VI_EVENT_SERVICE_REQ, VI_QUEUE);
+      session->srqEnabled = VI_TRUE;
+   }
+   else
+   {
+      //Polling from now on
+      session->srqEnabled = VI_FALSE;
+      viDisableEvent (instrumentHandle, VI_EVENT_SERVICE_REQ, VI_QUEUE);
+      viDiscardEvents (instrumentHandle, VI_EVENT_SERVICE_REQ, VI_QUEUE);
+      //Writing - Poll STB - Check EAV Bit and read error
+      if ((status = Pro8_Send (instrumentHandle, "*SRE 0", 6, &retCnt)) < 0) return status;
+      if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
+      if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
+   }
    //Ready
    return status;
 }
 
 //---------------------------------------------------------------------------
-// Function: PDA Set ELCH Set Values
-// Purpose:  This function sets the start and stop values for ELCH
+// Function: Write
+// Purpose:  This function writes a command to the instrument like viWrite.
+//           Each command gets a sequence number and is kept in the command
+//           log of the session. While a batch is active setting commands
+//           are collected in the session and sent by Pro8_FlushBatch.
+//           Queries send the collected commands first. In deferred error
+//           check mode setting commands do not wait for the FIN bit. The
+//           values of setting commands are kept in the shadow model, a
+//           failed write discards it. In metadata mode setpoints outside
+//           the module limits are rejected.
+//---------------------------------------------------------------------------
+ViStatus Pro8_Write (ViSession instrumentHandle, ViBuf buffer, ViUInt32 count, ViPUInt32 retCount)
+{
+   ViStatus       status   = VI_SUCCESS;
+   ViUInt32       n;
+   Pro8_tLogEntry *entry;
+   Pro8_tSession  *session;
+
+   if ((session = Pro8_GetSession (instrumentHandle)) == VI_NULL) return Pro8_Send (instrumentHandle, buffer, count, retCount);
+   //Reject setpoints outside the limits of the module
+   if (session->metadataMode && ((status = Pro8_MetaCheck (instrumentHandle, session, buffer, count)) < 0)) return status;
+   //Sequence number and command log
+   if (++session->sequence == 0) session->sequence = 1;
+   entry = &session->log[session->sequence % PRO8_COMMAND_LOG_LENGTH];
+   n = (count < PRO8_COMMAND_LOG_WIDTH) ? count : PRO8_COMMAND_LOG_WIDTH - 1;
+   memcpy (entry->command, buffer, n);
+   entry->command[n] = '\0';
+   entry->sequence   = session->sequence;
+   //Shadow model - errors discard it
+   if (session->shadowMode) Pro8_ShadowWrite (session, buffer, count);
+   //Not collecting - commands of other threads follow the collected ones
+   if (Pro8_BatchOwner (session) == VI_FALSE)
+   {
+      if (session->batchActive) Pro8_FlushBatch (instrumentHandle, session);
+      if ((status = Pro8_Send (instrumentHandle, buffer, count, retCount)) < 0)
+      {
+         Pro8_InvalidateSession (session);
+         return status;
+      }
+      if ((session->errorCheckMode == PRO8_ERROR_CHECK_DEFERRED) && (memchr (buffer, '?', count) == VI_NULL))
+      {
+         //Check errors when the sync interval has elapsed
+         if ((session->syncInterval > 0.0) && (Pro8_TimeNow () - session->lastSync >= session->syncInterval)) Pro8_CollectErrors (instrumentHandle, session);
+         session->writePending = VI_TRUE;
+      }
+      return status;
+   }
+   //Queries and long commands are written at once
+   if ((memchr (buffer, '?', count) != VI_NULL) || (count > PRO8_BATCH_MAX_LENGTH))
+   {
+      Pro8_FlushBatch (instrumentHandle, session);
+      if ((status = Pro8_Send (instrumentHandle, buffer, count, retCount)) < 0) Pro8_InvalidateSession (session);
+      return status;
+   }
+   //Send collected commands if the new one does not fit
+   if (session->batchLength + 1 + count > PRO8_BATCH_MAX_LENGTH) Pro8_FlushBatch (instrumentHandle, session);
+   //Collect
+   if (session->batchLength) session->batch[session->batchLength++] = ';';
+   memcpy (&session->batch[session->batchLength], buffer, count);
+   session->batchLength += count;
+   session->batch[session->batchLength] = '\0';
+   session->batchPending = VI_TRUE;
+   if (retCount) *retCount = count;
+   //Ready
+   return VI_SUCCESS;
+}
+
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_PdaSetElchSetVal (ViSession instrumentHandle, ViInt16 setParameter, ViReal64 startValue, ViReal64 stopValue)
+// Function: Flush Batch
+// Purpose:  This function sends the collected commands of a batch as one
+//           compound command, waits for the FIN bit and checks the error
+//           queue. The first error is stored in the session for
+//           Pro8_CommitBatch.
+//---------------------------------------------------------------------------
+ViStatus Pro8_FlushBatch (ViSession instrumentHandle, Pro8_tSession *session)
 {
    ViStatus status = VI_SUCCESS;
    ViUInt32 retCnt = 0;
+   ViUInt32 length;
    ViUInt16 stb;
-   ViChar   buffer[CMD_BUF_SIZE];
-   ViString command[] = {"VBIAS"};
 
-   //Check input parameter ranges
-   if (Pro8_invalidViInt16Range (setParameter, 0, 0)) return VI_ERROR_PARAMETER2;
+   //Nothing collected
+   session->batchPending = VI_FALSE;
+   if ((length = session->batchLength) == 0) return VI_SUCCESS;
+   session->batchLength = 0;
+   //Writing - Poll STB - Check EAV Bit and read error
+   if ((status = Pro8_Send (instrumentHandle, session->batch, length, &retCnt)) >= 0)
+   {
+      if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) >= 0)
+      {
+         if (stb & 0x0004) status = Pro8_GetInstrumentError (instrumentHandle);
+      }
+   }
+   //Store first error - the instrument state is unknown
+   if (status < 0)
+   {
+      if (session->batchStatus >= 0) session->batchStatus = status;
+      Pro8_InvalidateSession (session);
+   }
+   //Ready
+   return status;
+}
+
+//---------------------------------------------------------------------------
+// Function: Batch Owner
+// Purpose:  This function returns VI_TRUE if a batch is active and was
+//           begun by the calling thread, whose setting commands are
+//           collected.
+//---------------------------------------------------------------------------
+ViBoolean Pro8_BatchOwner (Pro8_tSession *session)
+{
+   return (ViBoolean)(session->batchActive && (session->batchThread == CmtGetCurrentThreadID ()));
+}
+
+//---------------------------------------------------------------------------
+// Function: Compound Query
+// Purpose:  This function sends several queries as one compound command,
+//           waits once for the FIN bit and reads all responses. The
+//           responses are split at ';' and line ends outside of quotes,
+//           answers[i] points to the response to queries[i] in buffer.
+//---------------------------------------------------------------------------
+ViStatus Pro8_CompoundQuery (ViSession instrumentHandle, ViInt16 count, ViString queries[], ViChar buffer[], ViUInt32 size, ViString answers[])
+{
+   ViStatus status = VI_SUCCESS;
+   ViUInt32 retCnt = 0;
+   ViUInt32 length = 0;
+   ViUInt32 n;
+   ViUInt16 stb;
+   ViInt16  i;
+   ViChar   command[PRO8_BATCH_MAX_LENGTH + 1];
+
    //Formatting
-   Fmt (buffer, ":%s:START %f;:%s:STOP %f", command[setParameter], startValue, command[setParameter], stopValue);
+   for (i = 0; i < count; i++)
+   {
+      n = StringLength (queries[i]);
+      if (length + n + 1 > PRO8_BATCH_MAX_LENGTH) return VI_ERROR_PARAMETER3;
+      if (i) command[length++] = ';';
+      memcpy (&command[length], queries[i], n);
+      length += n;
+   }
    //Writing - Poll STB - Check EAV Bit and read error
-   if ((status = viWrite (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return status;
+   if ((status = Pro8_Write (instrumentHandle, command, length, &retCnt)) < 0) return status;
+   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
+   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
+   //Reading
+   return Pro8_ReadAnswers (instrumentHandle, count, buffer, size, answers);
+}
+
+//---------------------------------------------------------------------------
+// Function: Read Answers
+// Purpose:  This function reads the responses to a compound query until
+//           count responses are there, in one or several messages, and
+//           splits them like Pro8_SplitAnswers.
+//---------------------------------------------------------------------------
+ViStatus Pro8_ReadAnswers (ViSession instrumentHandle, ViInt16 count, ViChar buffer[], ViUInt32 size, ViString answers[])
+{
+   ViStatus status = VI_SUCCESS;
+   ViUInt32 retCnt = 0;
+   ViUInt32 length = 0;
+
+   //Reading
+   buffer[0] = '\0';
+   while (Pro8_SplitAnswers (buffer, count, VI_NULL) < count)
+   {
+      if (length >= size - 2) return VI_ERROR_INSTR_INTERPRETING_RESPONSE;
+      if ((status = Pro8_Read (instrumentHandle, &buffer[length], size - 2 - length, &retCnt)) < 0) return status;
+      length += retCnt;
+      //End of message terminates the last response
+      if ((status != VI_SUCCESS_MAX_CNT) && ((length == 0) || (buffer[length - 1] != '\n'))) buffer[length++] = '\n';
+      buffer[length] = '\0';
+   }
+   //Split
+   Pro8_SplitAnswers (buffer, count, answers);
+   //Ready
+   return VI_SUCCESS;
+}
+
+//---------------------------------------------------------------------------
+// Function: Split Answers
+// Purpose:  This function counts the complete responses in buffer, up to
+//           count. If answers is not VI_NULL the responses are terminated
+//           in buffer and stored in answers.
+//---------------------------------------------------------------------------
+ViInt16 Pro8_SplitAnswers (ViChar buffer[], ViInt16 count, ViString answers[])
+{
+   ViInt16   found  = 0;
+   ViBoolean quoted = VI_FALSE;
+   ViChar    *start = VI_NULL;
+   ViChar    *p;
+
+   for (p = buffer; *p && (found < count); p++)
+   {
+      if ((*p == ';') || (*p == '\n') || (*p == '\r'))
+      {
+         if (quoted) continue;
+         //Separator - empty responses are line end remainders
+         if (start)
+         {
+            if (answers)
+            {
+               answers[found] = start;
+               *p = '\0';
+            }
+            found++;
+            start = VI_NULL;
+         }
+      }
+      else
+      {
+         if ((start == VI_NULL) && (*p != ' ')) start = p;
+         if (*p == '"') quoted = (ViBoolean)!quoted;
+      }
+   }
+   return found;
+}
+
+//---------------------------------------------------------------------------
+// Function: Get Answer Mode
+// Purpose:  This function returns the answer mode (0 = full, 1 = value)
+//           that selects the response formats of the getters. Sessions
+//           opened by Pro8_init hold it in the session data.
+//---------------------------------------------------------------------------
+ViStatus Pro8_GetAnswer (ViSession instrumentHandle, ViBoolean *answer)
+{
+   ViStatus       status   = VI_SUCCESS;
+   ViAttrState    value    = 0;
+   Pro8_tSession  *session;
+
+   if ((session = Pro8_GetSession (instrumentHandle)) != VI_NULL)
+   {
+      *answer = session->answerMode;
+      return VI_SUCCESS;
+   }
+   if ((status = viGetAttribute (instrumentHandle, VI_ATTR_USER_DATA, &value)) < 0) return status;
+   *answer = (ViBoolean)(value ? 1 : 0);
+   //Ready
+   return status;
+}
+
+//---------------------------------------------------------------------------
+// Function: Invalidate Session
+// Purpose:  This function marks the cached active slot, active port,
+//           plug configuration and shadow model of a session as unknown.
+//---------------------------------------------------------------------------
+void Pro8_InvalidateSession (Pro8_tSession *session)
+{
+   session->slot      = 0;
+   session->port      = 0;
+   session->plugValid = VI_FALSE;
+   Pro8_ShadowClear (session);
+}
+
+//---------------------------------------------------------------------------
+// Function: Read Plug Configuration
+// Purpose:  This function returns the type and subtype codes of all slots.
+//           Sessions opened by Pro8_init query the instrument once and
+//           keep the codes until the session is invalidated.
+//---------------------------------------------------------------------------
+ViStatus Pro8_ReadPlugConfig (ViSession instrumentHandle, ViInt16 type[], ViInt16 sub[])
+{
+   ViStatus       status   = VI_SUCCESS;
+   ViUInt32       retCnt   = 0;
+   ViUInt16       stb;
+   ViInt16        i;
+   ViBoolean      answer;
+   ViString       format[] = {"%*s %d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d", "%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d"};
+   Pro8_tSession  *session;
+
+   //Known
+   session = Pro8_GetSession (instrumentHandle);
+   if (session && session->plugValid)
+   {
+      for (i = 0; i < PRO8_NUM_SLOTS; i++)
+      {
+         type[i] = session->plugType[i];
+         sub[i]  = session->plugSub[i];
+      }
+      return VI_SUCCESS;
+   }
+   if ((status = Pro8_GetAnswer (instrumentHandle, &answer)) < 0) return status;
+   //Writing - Poll STB - Check EAV Bit and read error - Reading
+   if ((status = Pro8_Write (instrumentHandle, ":CONFIG:PLUG?", 13, &retCnt)) < 0) return status;
    if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
    if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
+   if ((status = Pro8_Scanf (instrumentHandle, format[answer], &type[0], &sub[0], &type[1], &sub[1], &type[2], &sub[2], &type[3], &sub[3],
+                          &type[4], &sub[4], &type[5], &sub[5], &type[6], &sub[6], &type[7], &sub[7])) < 0) return status;
+   //Store Data - drop the data of changed modules
+   if (session)
+   {
+      for (i = 0; i < PRO8_NUM_SLOTS; i++)
+      {
+         session->plugType[i] = type[i];
+         session->plugSub[i]  = sub[i];
+      }
+      session->plugValid = VI_TRUE;
+      Pro8_MetaPlug (session, type, sub);
+   }
    //Ready
    return status;
 }
 
 //---------------------------------------------------------------------------
-// Function: PDA Get ELCH Set Values
-// Purpose:  This function returns the start and stop values for ELCH
+// Function: Format Command
+// Purpose:  This function formats a command like Fmt for the conversions
+//           the driver uses: %d (int), %s (string) and %f (ViReal64,
+//           written by Pro8_FormatReal with full precision instead of
+//           6 decimals). buffer must hold CMD_BUF_SIZE characters.
+//           Returns the command length.
+//---------------------------------------------------------------------------
+ViInt32 Pro8_Fmt (ViChar buffer[], ViString format, ...)
+{
+   va_list  args;
+   ViChar   *p   = buffer;
+   ViChar   *end = buffer + CMD_BUF_SIZE - 1;
+   ViChar   number[32], *s;
+   ViInt32  n, i;
+   ViBoolean negative;
+
+   va_start (args, format);
+   for (; *format && (p < end); format++)
+   {
+      if ((*format != '%') || (format[1] == '\0'))
+      {
+         *p++ = *format;
+         continue;
+      }
+      switch (*++format)
+      {
+         case 'd':
+            //Integer, digits are written backwards
+            n = va_arg (args, int);
+            negative = (ViBoolean)(n < 0);
+            i = sizeof (number) - 1;
+            number[i] = '\0';
+            do
+            {
+               number[--i] = (ViChar)('0' + ((n < 0) ? -(n % 10) : (n % 10)));
+               n /= 10;
+            }
+            while (n);
+            if (negative) number[--i] = '-';
+            s = &number[i];
+            break;
+
+         case 'f':
+            Pro8_FormatReal (number, va_arg (args, ViReal64));
+            s = number;
+            break;
+
+         case 's':
+            s = va_arg (args, ViString);
+            break;
+
+         default:
+            number[0] = *format;
+            number[1] = '\0';
+            s = number;
+            break;
+      }
+      while (*s && (p < end)) *p++ = *s++;
+   }
+   va_end (args);
+   *p = '\0';
+   return (ViInt32)(p - buffer);
+}
+
+//---------------------------------------------------------------------------
+// Function: Read Real
+// Purpose:  This function reads a response with one number and returns
+//           the value. It replaces viScanf with "%*s %LE" / "%LE".
+//---------------------------------------------------------------------------
+ViStatus Pro8_ReadReal (ViSession instrumentHandle, ViBoolean answer, ViReal64 *value)
+{
+   ViStatus status = VI_SUCCESS;
+   ViUInt32 retCnt = 0;
+   ViChar   buffer[CMD_BUF_SIZE], rest[CMD_BUF_SIZE];
+
+   //Reading
+   if ((status = Pro8_Read (instrumentHandle, buffer, sizeof (buffer) - 1, &retCnt)) < 0) return status;
+   buffer[retCnt] = '\0';
+   //Discard the rest of a long response
+   while (status == VI_SUCCESS_MAX_CNT)
+   {
+      if ((status = Pro8_Read (instrumentHandle, rest, sizeof (rest), &retCnt)) < 0) return status;
+   }
+   //Evaluate
+   return Pro8_ParseReal (buffer, answer, value);
+}
+
+//---------------------------------------------------------------------------
+// Function: Parse Real
+// Purpose:  This function returns the number in a response. In full answer
+//           mode (answer = 0) the response header is skipped.
+//---------------------------------------------------------------------------
+ViStatus Pro8_ParseReal (ViString response, ViBoolean answer, ViReal64 *value)
+{
+   ViChar   *p = response;
+   ViChar   *end;
+   ViReal64 number;
+
+   while ((*p == ' ') || (*p == '\t')) p++;
+   if (answer == 0)
+   {
+      while (*p && (*p != ' ') && (*p != '\t')) p++;
+      while ((*p == ' ') || (*p == '\t')) p++;
+   }
+   number = Pro8_StringToReal (p, &end);
+   if (end == p) return VI_ERROR_INSTR_INTERPRETING_RESPONSE;
+   //Ready
+   *value = number;
+   return VI_SUCCESS;
+}
+
+//---------------------------------------------------------------------------
+// Function: Parse Values
+// Purpose:  This function returns the count comma separated numbers of a
+//           response, e.g. the values of an ELCH step. In full answer mode
+//           (answer = 0) the response header is skipped.
+//---------------------------------------------------------------------------
+ViStatus Pro8_ParseValues (ViString response, ViBoolean answer, ViInt16 count, ViReal64 values[])
+{
+   ViChar   *p = response;
+   ViChar   *end;
+   ViInt16  i;
+
+   while ((*p == ' ') || (*p == '\t')) p++;
+   if (answer == 0)
+   {
+      while (*p && (*p != ' ') && (*p != '\t')) p++;
+   }
+   for (i = 0; i < count; i++)
+   {
+      while ((*p == ' ') || (*p == '\t')) p++;
+      if (i && (*p++ != ',')) return VI_ERROR_INSTR_INTERPRETING_RESPONSE;
+      while ((*p == ' ') || (*p == '\t')) p++;
+      values[i] = Pro8_StringToReal (p, &end);
+      if (end == p) return VI_ERROR_INSTR_INTERPRETING_RESPONSE;
+      p = end;
+   }
+   //Ready
+   return VI_SUCCESS;
+}
+
+//---------------------------------------------------------------------------
+// Function: Format Real
+// Purpose:  This function writes a short decimal string that reads back
+//           to the same double (round-trip, Grisu2, F. Loitsch "Printing
+//           Floating-Point Numbers Quickly and Accurately with Integers",
+//           PLDI 2010). Grisu2 always round-trips, but in rare cases the
+//           string is one digit longer than the shortest one. The output
+//           uses '.' whatever the locale is and needs at most 26
+//           characters. Returns the string length.
+//---------------------------------------------------------------------------
+ViInt32 Pro8_FormatReal (ViChar buffer[], ViReal64 value)
+{
+   static const Pro8_tCachedPower cachedPowers[] =
+   {
+      {0xFA8FD5A0, 0x081C0288, -1220},   // 1e-348
+      {0xBAAEE17F, 0xA23EBF76, -1193},   // 1e-340
+      {0x8B16FB20, 0x3055AC76, -1166},   // 1e-332
+      {0xCF42894A, 0x5DCE35EA, -1140},   // 1e-324
+      {0x9A6BB0AA, 0x55653B2D, -1113},   // 1e-316
+      {0xE61ACF03, 0x3D1A45DF, -1087},   // 1e-308
+      {0xAB70FE17, 0xC79AC6CA, -1060},   // 1e-300
+      {0xFF77B1FC, 0xBEBCDC4F, -1034},   // 1e-292
+      {0xBE5691EF, 0x416BD60C, -1007},   // 1e-284
+      {0x8DD01FAD, 0x907FFC3C,  -980},   // 1e-276
+      {0xD3515C28, 0x31559A83,  -954},   // 1e-268
+      {0x9D71AC8F, 0xADA6C9B5,  -927},   // 1e-260
+      {0xEA9C2277, 0x23EE8BCB,  -901},   // 1e-252
+      {0xAECC4991, 0x4078536D,  -874},   // 1e-244
+      {0x823C1279, 0x5DB6CE57,  -847},   // 1e-236
+      {0xC2109436, 0x4DFB5637,  -821},   // 1e-228
+      {0x9096EA6F, 0x3848984F,  -794},   // 1e-220
+      {0xD77485CB, 0x25823AC7,  -768},   // 1e-212
+      {0xA086CFCD, 0x97BF97F4,  -741},   // 1e-204
+      {0xEF340A98, 0x172AACE5,  -715},   // 1e-196
+      {0xB23867FB, 0x2A35B28E,  -688},   // 1e-188
+      {0x84C8D4DF, 0xD2C63F3B,  -661},   // 1e-180
+      {0xC5DD4427, 0x1AD3CDBA,  -635},   // 1e-172
+      {0x936B9FCE, 0xBB25C996,  -608},   // 1e-164
+      {0xDBAC6C24, 0x7D62A584,  -582},   // 1e-156
+      {0xA3AB6658, 0x0D5FDAF6,  -555},   // 1e-148
+      {0xF3E2F893, 0xDEC3F126,  -529},   // 1e-140
+      {0xB5B5ADA8, 0xAAFF80B8,  -502},   // 1e-132
+      {0x87625F05, 0x6C7C4A8B,  -475},   // 1e-124
+      {0xC9BCFF60, 0x34C13053,  -449},   // 1e-116
+      {0x964E858C, 0x91BA2655,  -422},   // 1e-108
+      {0xDFF97724, 0x70297EBD,  -396},   // 1e-100
+      {0xA6DFBD9F, 0xB8E5B88F,  -369},   // 1e-92
+      {0xF8A95FCF, 0x88747D94,  -343},   // 1e-84
+      {0xB9447093, 0x8FA89BCF,  -316},   // 1e-76
+      {0x8A08F0F8, 0xBF0F156B,  -289},   // 1e-68
+      {0xCDB02555, 0x653131B6,  -263},   // 1e-60
+      {0x993FE2C6, 0xD07B7FAC,  -236},   // 1e-52
+      {0xE45C10C4, 0x2A2B3B06,  -210},   // 1e-44
+      {0xAA242499, 0x697392D3,  -183},   // 1e-36
+      {0xFD87B5F2, 0x8300CA0E,  -157},   // 1e-28
+      {0xBCE50864, 0x92111AEB,  -130},   // 1e-20
+      {0x8CBCCC09, 0x6F5088CC,  -103},   // 1e-12
+      {0xD1B71758, 0xE219652C,   -77},   // 1e-4
+      {0x9C400000, 0x00000000,   -50},   // 1e4
+      {0xE8D4A510, 0x00000000,   -24},   // 1e12
+      {0xAD78EBC5, 0xAC620000,     3},   // 1e20
+      {0x813F3978, 0xF8940984,    30},   // 1e28
+      {0xC097CE7B, 0xC90715B3,    56},   // 1e36
+      {0x8F7E32CE, 0x7BEA5C70,    83},   // 1e44
+      {0xD5D238A4, 0xABE98068,   109},   // 1e52
+      {0x9F4F2726, 0x179A2245,   136},   // 1e60
+      {0xED63A231, 0xD4C4FB27,   162},   // 1e68
+      {0xB0DE6538, 0x8CC8ADA8,   189},   // 1e76
+      {0x83C7088E, 0x1AAB65DB,   216},   // 1e84
+      {0xC45D1DF9, 0x42711D9A,   242},   // 1e92
+      {0x924D692C, 0xA61BE758,   269},   // 1e100
+      {0xDA01EE64, 0x1A708DEA,   295},   // 1e108
+      {0xA26DA399, 0x9AEF774A,   322},   // 1e116
+      {0xF209787B, 0xB47D6B85,   348},   // 1e124
+      {0xB454E4A1, 0x79DD1877,   375},   // 1e132
+      {0x865B8692, 0x5B9BC5C2,   402},   // 1e140
+      {0xC83553C5, 0xC8965D3D,   428},   // 1e148
+      {0x952AB45C, 0xFA97A0B3,   455},   // 1e156
+      {0xDE469FBD, 0x99A05FE3,   481},   // 1e164
+      {0xA59BC234, 0xDB398C25,   508},   // 1e172
+      {0xF6C69A72, 0xA3989F5C,   534},   // 1e180
+      {0xB7DCBF53, 0x54E9BECE,   561},   // 1e188
+      {0x88FCF317, 0xF22241E2,   588},   // 1e196
+      {0xCC20CE9B, 0xD35C78A5,   614},   // 1e204
+      {0x98165AF3, 0x7B2153DF,   641},   // 1e212
+      {0xE2A0B5DC, 0x971F303A,   667},   // 1e220
+      {0xA8D9D153, 0x5CE3B396,   694},   // 1e228
+      {0xFB9B7CD9, 0xA4A7443C,   720},   // 1e236
+      {0xBB764C4C, 0xA7A44410,   747},   // 1e244
+      {0x8BAB8EEF, 0xB6409C1A,   774},   // 1e252
+      {0xD01FEF10, 0xA657842C,   800},   // 1e260
+      {0x9B10A4E5, 0xE9913129,   827},   // 1e268
+      {0xE7109BFB, 0xA19C0C9D,   853},   // 1e276
+      {0xAC2820D9, 0x623BF429,   880},   // 1e284
+      {0x80444B5E, 0x7AA7CF85,   907},   // 1e292
+      {0xBF21E440, 0x03ACDD2D,   933},   // 1e300
+      {0x8E679C2F, 0x5E44FF8F,   960},   // 1e308
+      {0xD433179D, 0x9C8CB841,   986},   // 1e316
+      {0x9E19DB92, 0xB4E31BA9,  1013},   // 1e324
+      {0xEB96BF6E, 0xBADF77D9,  1039},   // 1e332
+      {0xAF87023B, 0x9BF0EE6B,  1066},   // 1e340
+   };
+   union { ViReal64 d; Pro8_tUInt64 u; } bits;
+   Pro8_tDiyFp    v, w, wPlus, wMinus, cache, W, Wp, Wm;
+   Pro8_tUInt64   delta, p2, rest, one, mask, wpw, tenKappa;
+   ViUInt32       p1, div;
+   ViReal64       dk;
+   ViInt32        length = 0, K, k, kappa, index, kk, i;
+   ViChar         *p = buffer, digits[20], d;
+
+   //Special values
+   bits.d = value;
+   if (((bits.u >> 52) & 0x7FF) == 0x7FF)
+   {
+      CopyString (buffer, 0, (bits.u & PRO8_DIY_FRACTION_MASK) ? "NAN" : ((bits.u >> 63) ? "-INF" : "INF"), 0, -1);
+      return StringLength (buffer);
+   }
+   if (bits.u >> 63) *p++ = '-';
+   bits.u &= ~((Pro8_tUInt64)1 << 63);
+   if (bits.u == 0)
+   {
+      *p++ = '0';
+      *p   = '\0';
+      return (ViInt32)(p - buffer);
+   }
+   //Boundaries m- and m+ of the rounding interval, normalized to the exponent of m+
+   v.f = bits.u & PRO8_DIY_FRACTION_MASK;
+   v.e = (ViInt32)(bits.u >> 52);
+   if (v.e) { v.f += PRO8_DIY_HIDDEN_BIT; v.e -= 1075; }
+   else     v.e = -1074;
+   wPlus.f = (v.f << 1) + 1;
+   wPlus.e = v.e - 1;
+   while ((wPlus.f & (PRO8_DIY_HIDDEN_BIT << 1)) == 0) { wPlus.f <<= 1; wPlus.e--; }
+   wPlus.f <<= 10;
+   wPlus.e  -= 10;
+   if (v.f == PRO8_DIY_HIDDEN_BIT) { wMinus.f = (v.f << 2) - 1; wMinus.e = v.e - 2; }
+   else                            { wMinus.f = (v.f << 1) - 1; wMinus.e = v.e - 1; }
+   wMinus.f <<= wMinus.e - wPlus.e;
+   wMinus.e   = wPlus.e;
+   w = v;
+   while ((w.f & ((Pro8_tUInt64)1 << 63)) == 0) { w.f <<= 1; w.e--; }
+   //Cached power c = 10^-K so that the products have exponents in [-60, -32]
+   dk = (-61 - wPlus.e) * 0.30102999566398114 + 347.0;
+   k  = (ViInt32)dk;
+   if (dk - k > 0.0) k++;
+   index   = (k >> 3) + 1;
+   K       = -(-348 + index * 8);
+   cache.f = ((Pro8_tUInt64)cachedPowers[index].hi << 32) | cachedPowers[index].lo;
+   cache.e = cachedPowers[index].e;
+   W  = Pro8_DiyMultiply (w, cache);
+   Wp = Pro8_DiyMultiply (wPlus, cache);
+   Wm = Pro8_DiyMultiply (wMinus, cache);
+   Wm.f++;
+   Wp.f--;
+   //Digit generation
+   delta = Wp.f - Wm.f;
+   wpw   = Wp.f - W.f;
+   one   = (Pro8_tUInt64)1 << -Wp.e;
+   mask  = one - 1;
+   p1    = (ViUInt32)(Wp.f >> -Wp.e);
+   p2    = Wp.f & mask;
+   for (kappa = 10, div = 1000000000; (kappa > 1) && (p1 < div); kappa--) div /= 10;
+   for (;;)
+   {
+      if (kappa > 0)
+      {
+         d   = (ViChar)(p1 / div);
+         p1 %= div;
+         kappa--;
+         rest     = ((Pro8_tUInt64)p1 << -Wp.e) + p2;
+         tenKappa = (Pro8_tUInt64)div << -Wp.e;
+         div     /= 10;
+      }
+      else
+      {
+         p2    *= 10;
+         delta *= 10;
+         d      = (ViChar)(p2 >> -Wp.e);
+         p2    &= mask;
+         kappa--;
+         rest     = p2;
+         tenKappa = one;
+         wpw     *= 10;
+      }
+      if (d || length) digits[length++] = (ViChar)('0' + d);
+      if ((rest < delta) || ((kappa >= 0) && (rest == delta)))
+      {
+         //Round the last digit towards W
+         while ((rest < wpw) && (delta - rest >= tenKappa) &&
+                ((rest + tenKappa < wpw) || (wpw - rest > rest + tenKappa - wpw)))
+         {
+            digits[length - 1]--;
+            rest += tenKappa;
+         }
+         K += kappa;
+         break;
+      }
+   }
+   //Decimal point position: value = 0.digits * 10^kk
+   kk = length + K;
+   if ((kk > 0) && (kk <= 15))
+   {
+      for (i = 0; i < kk; i++) *p++ = (i < length) ? digits[i] : '0';
+      if (length > kk)
+      {
+         *p++ = '.';
+         for (; i < length; i++) *p++ = digits[i];
+      }
+   }
+   else if ((kk > -5) && (kk <= 0))
+   {
+      *p++ = '0';
+      *p++ = '.';
+      for (i = kk; i < 0; i++) *p++ = '0';
+      for (i = 0; i < length; i++) *p++ = digits[i];
+   }
+   else
+   {
+      *p++ = digits[0];
+      if (length > 1)
+      {
+         *p++ = '.';
+         for (i = 1; i < length; i++) *p++ = digits[i];
+      }
+      *p++ = 'E';
+      kk--;
+      if (kk < 0) { *p++ = '-'; kk = -kk; }
+      if (kk >= 100) *p++ = (ViChar)('0' + kk / 100);
+      if (kk >= 10)  *p++ = (ViChar)('0' + (kk / 10) % 10);
+      *p++ = (ViChar)('0' + kk % 10);
+   }
+   *p = '\0';
+   return (ViInt32)(p - buffer);
+}
+
+//---------------------------------------------------------------------------
+// Function: DIY-FP Multiply
+// Purpose:  This function multiplies two 64-bit significands and returns
+//           the rounded upper 64 bits of the product.
+//---------------------------------------------------------------------------
+Pro8_tDiyFp Pro8_DiyMultiply (Pro8_tDiyFp x, Pro8_tDiyFp y)
+{
+   Pro8_tDiyFp    r;
+   Pro8_tUInt64   a = x.f >> 32, b = x.f & 0xFFFFFFFF, c = y.f >> 32, d = y.f & 0xFFFFFFFF;
+   Pro8_tUInt64   ac = a * c, bc = b * c, ad = a * d, bd = b * d;
+   Pro8_tUInt64   tmp = (bd >> 32) + (ad & 0xFFFFFFFF) + (bc & 0xFFFFFFFF);
+
+   tmp += (Pro8_tUInt64)1 << 31;
+   r.f  = ac + (ad >> 32) + (bc >> 32) + (tmp >> 32);
+   r.e  = x.e + y.e + 64;
+   return r;
+}
+
+//---------------------------------------------------------------------------
+// Function: String To Real
+// Purpose:  This function reads a decimal number like strtod(), but with
+//           '.' as decimal point whatever the locale is. Numbers with up
+//           to 15 significant digits and a decimal exponent up to 22 are
+//           converted exactly with one multiplication or division
+//           (W. D. Clinger, "How to Read Floating Point Numbers
+//           Accurately", PLDI 1990). Other numbers go through strtod().
+//           *end points behind the number, or to string if there is none.
+//---------------------------------------------------------------------------
+ViReal64 Pro8_StringToReal (ViString string, ViChar **end)
+{
+   static const ViReal64 exact[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+   Pro8_tUInt64   mantissa  = 0;
+   ViInt32        digits    = 0, exponent = 0, e = 0, i;
+   ViBoolean      negative  = VI_FALSE, exact15 = VI_TRUE, eNegative = VI_FALSE, any = VI_FALSE;
+   ViChar         *p = string, *start, number[64], *point;
+   ViReal64       value;
+
+   //Mantissa
+   start = p;
+   if ((*p == '+') || (*p == '-')) negative = (ViBoolean)(*p++ == '-');
+   for (; (*p >= '0') && (*p <= '9'); p++)
+   {
+      any = VI_TRUE;
+      if (digits < 19) { if (mantissa || (*p != '0')) { mantissa = mantissa * 10 + (*p - '0'); digits++; } }
+      else             { exponent++; exact15 = VI_FALSE; }
+   }
+   if (*p == '.')
+   {
+      for (p++; (*p >= '0') && (*p <= '9'); p++)
+      {
+         any = VI_TRUE;
+         if (digits < 19) { if (mantissa || (*p != '0')) { mantissa = mantissa * 10 + (*p - '0'); digits++; } exponent--; }
+         else if (*p != '0') exact15 = VI_FALSE;
+      }
+   }
+   if (any == VI_FALSE)
+   {
+      if (end) *end = string;
+      return 0.0;
+   }
+   //Exponent
+   if ((*p == 'E') || (*p == 'e'))
+   {
+      ViChar *q = p + 1;
+
+      if ((*q == '+') || (*q == '-')) eNegative = (ViBoolean)(*q++ == '-');
+      if ((*q >= '0') && (*q <= '9'))
+      {
+         for (; (*q >= '0') && (*q <= '9'); q++) if (e < 10000) e = e * 10 + (*q - '0');
+         exponent += eNegative ? -e : e;
+         p = q;
+      }
+   }
+   if (end) *end = p;
+   //Fast path
+   if (exact15 && (digits <= 15) && (exponent >= -22) && (exponent <= 22))
+   {
+      value = (ViReal64)(ViUInt32)(mantissa >> 32) * 4294967296.0 + (ViReal64)(ViUInt32)(mantissa & 0xFFFFFFFF);
+      value = (exponent < 0) ? value / exact[-exponent] : value * exact[exponent];
+      return negative ? -value : value;
+   }
+   //Slow path - strtod() with the decimal point of the current locale
+   i = (ViInt32)(p - start);
+   if (i >= (ViInt32)sizeof (number)) i = sizeof (number) - 1;
+   memcpy (number, start, i);
+   number[i] = '\0';
+   if ((point = strchr (number, '.')) != VI_NULL) *point = *localeconv ()->decimal_point;
+   return strtod (number, VI_NULL);
+}
+
+//---------------------------------------------------------------------------
+// Function: Time Now
+// Purpose:  This function returns a monotonic time stamp (seconds) with
+//           microsecond resolution. CVI's Timer() only resolves 1 ms.
+//---------------------------------------------------------------------------
+ViReal64 Pro8_TimeNow (void)
+{
+#if defined(_WIN32)
+   static LARGE_INTEGER frequency;
+   LARGE_INTEGER        counter;
+
+   if (frequency.QuadPart == 0) QueryPerformanceFrequency (&frequency);
+   QueryPerformanceCounter (&counter);
+   return (ViReal64)counter.QuadPart / (ViReal64)frequency.QuadPart;
+#else
+   struct timespec now;
+
+   clock_gettime (CLOCK_MONOTONIC, &now);
+   return (ViReal64)now.tv_sec + (ViReal64)now.tv_nsec * 1.0e-9;
+#endif
+}
+
+//---------------------------------------------------------------------------
+// Function: Sleep Seconds
+// Purpose:  This function sleeps for a short time (seconds). On Windows
+//           Sleep() and Delay() round up to the system timer tick, so the
+//           delay is waited with a high-resolution waitable timer and only
+//           the last PRO8_SLEEP_SPIN_TIME seconds yield the processor.
+//           Windows without high-resolution timers falls back to Sleep().
+//---------------------------------------------------------------------------
+void Pro8_SleepSeconds (ViReal64 seconds)
+{
+#if defined(_WIN32)
+   ViReal64       end  = Pro8_TimeNow () + seconds;
+   ViReal64       wait = seconds - PRO8_SLEEP_SPIN_TIME;
+   HANDLE         timer;
+   LARGE_INTEGER  due;
+
+   if (wait > 0.0)
+   {
+      timer = CreateWaitableTimerExW (NULL, NULL, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+      if (timer != NULL)
+      {
+         //Relative due time in 100 ns units
+         due.QuadPart = -(LONGLONG)(wait * 1.0e7);
+         if (SetWaitableTimer (timer, &due, 0, NULL, NULL, FALSE)) WaitForSingleObject (timer, INFINITE);
+         CloseHandle (timer);
+      }
+      else if (wait >= 0.001) Sleep ((DWORD)(wait * 1000.0));
+   }
+   while (Pro8_TimeNow () < end) SwitchToThread ();
+#else
+   struct timespec delay;
+
+   delay.tv_sec  = (time_t)seconds;
+   delay.tv_nsec = (long)((seconds - (ViReal64)delay.tv_sec) * 1.0e9);
+   nanosleep (&delay, NULL);
+#endif
+}
+
+//---------------------------------------------------------------------------
+// Function: Sleep Until
+// Purpose:  This function sleeps until an absolute deadline (Pro8_TimeNow
+//           seconds), so the wake-up time does not depend on the time the
+//           caller took before. On Windows the last PRO8_WAVEFORM_SPIN_TIME
+//           seconds yield the processor until the deadline.
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_PdaGetElchSetVal (ViSession instrumentHandle, ViInt16 setParameter, ViReal64 *startValue, ViReal64 *stopValue)
+void Pro8_SleepUntil (ViReal64 deadline)
 {
-   ViStatus status     = VI_SUCCESS;
-   ViUInt32 retCnt     = 0;
-   ViUInt16 stb;
-   ViString command1[] = {":VBIAS:START?"};
-   ViString command2[] = {":VBIAS:STOP?" };
-   ViBoolean answer;
-   ViString  format1[] = {"%*s %LE", "%LE"};
-   ViString  format2[] = {"%*s %LE", "%LE"};
+#if defined(_WIN32)
+   ViReal64 seconds = deadline - Pro8_TimeNow () - PRO8_WAVEFORM_SPIN_TIME;
 
-   if ((status = viGetAttribute (instrumentHandle, VI_ATTR_USER_DATA, &answer)) < 0) return status;
-   //Check input parameter ranges
-   if (Pro8_invalidViInt16Range (setParameter, 0, 0)) return VI_ERROR_PARAMETER2;
-   //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, command1[setParameter], StringLength (command1[setParameter]), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format1[answer], startValue)) < 0) return status;
-   //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, command2[setParameter], StringLength (command2[setParameter]), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format2[answer], stopValue)) < 0) return status;
-   //Ready
-   return status;
+   if (seconds > 0.0) Pro8_SleepSeconds (seconds);
+   while (Pro8_TimeNow () < deadline) SwitchToThread ();
+#elif defined(__linux__)
+   struct timespec until;
+
+   until.tv_sec  = (time_t)deadline;
+   until.tv_nsec = (long)((deadline - (ViReal64)until.tv_sec) * 1.0e9);
+   while (clock_nanosleep (CLOCK_MONOTONIC, TIMER_ABSTIME, &until, NULL) == EINTR);
+#else
+   ViReal64 seconds = deadline - Pro8_TimeNow ();
+
+   if (seconds > 0.0) Pro8_SleepSeconds (seconds);
+#endif
 }
 
 //---------------------------------------------------------------------------
-// Function: PDA Set ELCH Measurement Value Position
-// Purpose:  This function sets the position of the measurement value
+// Function: Real-Time Thread
+// Purpose:  This function raises the calling thread to real-time priority.
+//           On Linux this needs CAP_SYS_NICE, without it the thread keeps
+//           its priority.
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_PdaSetElchMeasVal (ViSession instrumentHandle, ViInt16 measurementParameter, ViInt16 position)
+void Pro8_RealTimeThread (void)
 {
-   ViStatus status = VI_SUCCESS;
-   ViUInt32 retCnt = 0;
-   ViUInt16 stb;
-   ViChar   buffer[CMD_BUF_SIZE];
-   ViString command[] = {"IPD"};
+#if defined(_WIN32)
+   SetThreadPriority (GetCurrentThread (), THREAD_PRIORITY_TIME_CRITICAL);
+#elif defined(__linux__)
+   struct sched_param param;
 
-   //Check input parameter ranges
-   if (Pro8_invalidViInt16Range (measurementParameter, 0, 0))  return VI_ERROR_PARAMETER2;
-   if (Pro8_invalidViInt16Range (position, 1, 8))              return VI_ERROR_PARAMETER3;
-   //Formatting
-   Fmt (buffer, ":%s:MEAS %d", command[measurementParameter], position);
-   //Writing - Poll STB - Check EAV Bit and read error
-   if ((status = viWrite (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   //Ready
-   return status;
+   param.sched_priority = sched_get_priority_min (SCHED_FIFO);
+   sched_setscheduler (0, SCHED_FIFO, &param);
+#endif
 }
 
 //---------------------------------------------------------------------------
-// Function: PDA Get ELCH Measurement Value Position
-// Purpose:  This function returns the position of the measurement value
+// Function: Memory Barrier
+// Purpose:  This function orders the memory accesses before and after it,
+//           so samples are written before they are published to other
+//           threads.
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_PdaGetElchMeasVal (ViSession instrumentHandle, ViInt16 measurementParameter, ViInt16 *position)
+void Pro8_MemoryBarrier (void)
 {
-   ViStatus  status = VI_SUCCESS;
-   ViUInt32  retCnt = 0;
-   ViUInt16  stb;
-   ViString  command[] = {":IPD:MEAS?"};
-   ViBoolean answer;
-   ViString  format[] = {"%*s %d", "%d"};
-
-   if ((status = viGetAttribute (instrumentHandle, VI_ATTR_USER_DATA, &answer)) < 0) return status;
-   //Check input parameter ranges
-   if (Pro8_invalidViInt16Range (measurementParameter, 0, 0))  return VI_ERROR_PARAMETER2;
-   //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, command[measurementParameter], StringLength (command[measurementParameter]), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format[answer], position)) < 0) return status;
-   //Ready
-   return status;
+#if defined(_WIN32)
+   MemoryBarrier ();
+#else
+   __sync_synchronize ();
+#endif
 }
 
 //---------------------------------------------------------------------------
-// Function: LS Set ELCH Set Values
-// Purpose:  This function sets the start and stop values for ELCH
+// Function: Boolean Value Out Of Range - ViBoolean
+// Purpose:  This function checks a Boolean to see if it is equal to VI_TRUE
+//           or VI_FALSE. If the value is out of range, the return value is
+//           VI_TRUE, otherwise the return value is VI_FALSE.
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_LsSetElchSetVal (ViSession instrumentHandle, ViInt16 setParameter, ViReal64 startValue, ViReal64 stopValue)
+ViBoolean Pro8_invalidViBooleanRange (ViBoolean val)
 {
-   ViStatus status = VI_SUCCESS;
-   ViUInt32 retCnt = 0;
-   ViUInt16 stb;
-   ViChar   buffer[CMD_BUF_SIZE];
-   ViString command[] = {"P_DBM", "P_W"};
+   return ((val != VI_FALSE && val != VI_TRUE) ? VI_TRUE : VI_FALSE);
+}
 
-   //Check input parameter ranges
-   if (Pro8_invalidViInt16Range (setParameter, 0, 1)) return VI_ERROR_PARAMETER2;
-   //Formatting
-   Fmt (buffer, ":%s:START %f;:%s:STOP %f", command[setParameter], startValue, command[setParameter], stopValue);
-   //Writing - Poll STB - Check EAV Bit and read error
-   if ((status = viWrite (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   //Ready
-   return status;
+//---------------------------------------------------------------------------
+// Function: Short Signed Integer Value Out Of Range - ViInt16
+// Purpose:  This function checks a short signed integer value to see if it
+//           lies between a minimum and maximum value.  If the value is out
+//           of range, the return value is VI_TRUE, otherwise the return
+//           value is VI_FALSE.
+//---------------------------------------------------------------------------
+ViBoolean Pro8_invalidViInt16Range (ViInt16 val, ViInt16 min, ViInt16 max)
+{
+   return ((val < min || val > max) ? VI_TRUE : VI_FALSE);
 }
 
 //---------------------------------------------------------------------------
-// Function: LS Get ELCH Set Values
-// Purpose:  This function returns the start and stop values for ELCH
+// Function: Long Signed Integer Value Out Of Range - ViInt32
+// Purpose:  This function checks a long signed integer value to see if it
+//           lies between a minimum and maximum value.  If the value is out
+//           of range, the return value is VI_TRUE, otherwise the return
+//           value is VI_FALSE.
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_LsGetElchSetVal (ViSession instrumentHandle, ViInt16 setParameter, ViReal64 *startValue, ViReal64 *stopValue)
+ViBoolean Pro8_invalidViInt32Range (ViInt32 val, ViInt32 min, ViInt32 max)
 {
-   ViStatus  status = VI_SUCCESS;
-   ViUInt32  retCnt = 0;
-   ViUInt16  stb;
-   ViString  command1[] = {":P_DBM:START?", ":P_W:START?"};
-   ViString  command2[] = {":P_DBM:STOP?",  ":P_W:STOP?" };
-   ViBoolean answer;
-   ViString  format1[] = {"%*s %LE", "%LE"};
-   ViString  format2[] = {"%*s %LE", "%LE"};
+   return ((val < min || val > max) ? VI_TRUE : VI_FALSE);
+}
 
-   if ((status = viGetAttribute (instrumentHandle, VI_ATTR_USER_DATA, &answer)) < 0) return status;
-   //Check input parameter ranges
-   if (Pro8_invalidViInt16Range (setParameter, 0, 1)) return VI_ERROR_PARAMETER2;
-   //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, command1[setParameter], StringLength (command1[setParameter]), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format1[answer], startValue)) < 0) return status;
-   //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, command2[setParameter], StringLength (command2[setParameter]), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format2[answer], stopValue)) < 0) return status;
-   //Ready
-   return status;
+//---------------------------------------------------------------------------
+// Function: Unsigned Char Value Out Of Range - ViUInt8
+// Purpose:  This function checks an unsigned char value to see if it
+//           lies between a minimum and maximum value.  If the value is out
+//           of range, the return value is VI_TRUE, otherwise the return
+//           value is VI_FALSE.
+//---------------------------------------------------------------------------
+ViBoolean Pro8_invalidViUInt8Range (ViUInt8 val, ViUInt8 min, ViUInt8 max)
+{
+   return ((val < min || val > max) ? VI_TRUE : VI_FALSE);
 }
 
 //---------------------------------------------------------------------------
-// Function: SLED Set ELCH Set Values
-// Purpose:  This function sets the start and stop values for ELCH
+// Function: Short Unsigned Integer Value Out Of Range - ViUInt16
+// Purpose:  This function checks a short unsigned integer value to see if it
+//           lies between a minimum and maximum value.  If the value is out
+//           of range, the return value is VI_TRUE, otherwise the return
+//           value is VI_FALSE.
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_SledSetElchSetVal (ViSession instrumentHandle, ViInt16 setParameter, ViReal64 startValue, ViReal64 stopValue)
+ViBoolean Pro8_invalidViUInt16Range (ViUInt16 val, ViUInt16 min, ViUInt16 max)
 {
-   return Pro8_LsSetElchSetVal (instrumentHandle, setParameter, startValue, stopValue);
+   return ((val < min || val > max) ? VI_TRUE : VI_FALSE);
 }
 
 //---------------------------------------------------------------------------
-// Function: SLED Get ELCH Set Values
-// Purpose:  This function returns the start and stop values for ELCH
+// Function: Long Unsigned Integer Value Out Of Range - ViUInt32
+// Purpose:  This function checks a long unsigned integer value to see if it
+//           lies between a minimum and maximum value.  If the value is out
+//           of range, the return value is VI_TRUE, otherwise the return
+//           value is VI_FALSE.
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_SledGetElchSetVal (ViSession instrumentHandle, ViInt16 setParameter, ViReal64 *startValue, ViReal64 *stopValue)
+ViBoolean Pro8_invalidViUInt32Range (ViUInt32 val, ViUInt32 min, ViUInt32 max)
 {
-   return Pro8_LsGetElchSetVal (instrumentHandle, setParameter, startValue, stopValue);
+   return ((val < min || val > max) ? VI_TRUE : VI_FALSE);
 }
 
 //---------------------------------------------------------------------------
-// Function: WDM-CW Set ELCH Set Values
-// Purpose:  This function sets the start and stop values for ELCH
+// Function: Real (Float) Value Out Of Range - ViReal32
+// Purpose:  This function checks a real (float) value to see if it lies
+//           between a minimum and maximum value.  If the value is out of
+//           range, the return value is VI_TRUE, otherwise the return value
+//           is VI_FALSE.
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_CwSetElchSetVal (ViSession instrumentHandle, ViInt16 setParameter, ViReal64 startValue, ViReal64 stopValue)
+ViBoolean Pro8_invalidViReal32Range (ViReal32 val, ViReal32 min, ViReal32 max)
 {
-   return Pro8_LsSetElchSetVal (instrumentHandle, setParameter, startValue, stopValue);
+   return ((val < min || val > max) ? VI_TRUE : VI_FALSE);
 }
 
 //---------------------------------------------------------------------------
-// Function: WDM_CW Get ELCH Set Values
-// Purpose:  This function returns the start and stop values for ELCH
+// Function: Real (Double) Value Out Of Range - ViReal64
+// Purpose:  This function checks a real (double) value to see if it lies
+//           between a minimum and maximum value.  If the value is out of
+//           range, the return value is VI_TRUE, otherwise the return value
+//           is VI_FALSE.
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_CwGetElchSetVal (ViSession instrumentHandle, ViInt16 setParameter, ViReal64 *startValue, ViReal64 *stopValue)
+ViBoolean Pro8_invalidViReal64Range (ViReal64 val, ViReal64 min, ViReal64 max)
 {
-   return Pro8_LsGetElchSetVal (instrumentHandle, setParameter, startValue, stopValue);
+   return ((val < min || val > max) ? VI_TRUE : VI_FALSE);
 }
 
 //---------------------------------------------------------------------------
-// Function: WDM-EA Set ELCH Set Values
-// Purpose:  This function sets the start and stop values for ELCH
+// Function: Initialize Clean Up
+// Purpose:  This function is used only by the Pro8_init and Pro8_InitFast
+//           functions. When an error is detected this function is called
+//           to close the open resource manager and instrument object
+//           sessions and to set the instrSession that is returned to
+//           VI_NULL.
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_EaSetElchSetVal (ViSession instrumentHandle, ViInt16 setParameter, ViReal64 startValue, ViReal64 stopValue)
+ViStatus Pro8_initCleanUp (ViSession openRMSession, ViPSession openInstrSession, ViStatus currentStatus)
 {
-   return Pro8_LsSetElchSetVal (instrumentHandle, setParameter, startValue, stopValue);
+   Pro8_tSession *session = Pro8_GetSession (*openInstrSession);
+
+   if (session && session->transport->close)
+   {
+      //Driver transport
+      session->transport->close (session);
+      Pro8_FreeSession (*openInstrSession);
+   }
+   else
+   {
+      Pro8_FreeSession (*openInstrSession);
+      viClose (*openInstrSession);
+   }
+   if (openRMSession) viClose (openRMSession);
+   *openInstrSession = VI_NULL;
+   //Ready
+   return currentStatus;
 }
 
 //---------------------------------------------------------------------------
-// Function: WDM_EA Get ELCH Set Values
-// Purpose:  This function returns the start and stop values for ELCH
+// Function: Check Identity
+// Purpose:  This function checks the company and device name of the
+//           response to *IDN?.
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_EaGetElchSetVal (ViSession instrumentHandle, ViInt16 setParameter, ViReal64 *startValue, ViReal64 *stopValue)
+ViStatus Pro8_CheckIdentity (ViString company, ViString device)
 {
-   return Pro8_LsGetElchSetVal (instrumentHandle, setParameter, startValue, stopValue);
+   //Does Company match?
+   if ( (CompareStrings (company, 0, PRO8_ID_RESPONSE_COMPANY_A, 0, 0) != 0) &&
+        (CompareStrings (company, 0, PRO8_ID_RESPONSE_COMPANY_B, 0, 0) != 0) &&
+        (CompareStrings (company, 0, PRO8_ID_RESPONSE_COMPANY_C, 0, 0) != 0) &&
+        (CompareStrings (company, 0, PRO8_ID_RESPONSE_COMPANY_D, 0, 0) != 0) ) return VI_ERROR_FAIL_ID_QUERY;
+   //Does Device match?
+   if (CompareStrings (device, 0, PRO8_ID_RESPONSE_PRO800 ,   0, 0) == 0)   return VI_SUCCESS;
+   if (CompareStrings (device, 0, PRO8_ID_RESPONSE_PRO8000,   0, 0) == 0)   return VI_SUCCESS;
+   if (CompareStrings (device, 0, PRO8_ID_RESPONSE_PRO8xxx,   0, 0) == 0)   return VI_SUCCESS;
+   if (CompareStrings (device, 0, PRO8_ID_RESPONSE_PRO8000_4, 0, 0) == 0)   return VI_SUCCESS;
+   //Error
+   return VI_ERROR_FAIL_ID_QUERY;
 }
 
 //---------------------------------------------------------------------------
-// Function: WDM-DIR Set ELCH Set Values
-// Purpose:  This function sets the start and stop values for ELCH
+// Function: Read Init Cache
+// Purpose:  This function reads the resource, identity and plug
+//           configuration from the cache file of Pro8_InitFast. They are
+//           empty if the file is missing or incomplete.
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_DirSetElchSetVal (ViSession instrumentHandle, ViInt16 setParameter, ViReal64 startValue, ViReal64 stopValue)
+void Pro8_ReadInitCache (ViString cacheFile, ViChar cached[][BUFFER_SIZE])
 {
-   return Pro8_LsSetElchSetVal (instrumentHandle, setParameter, startValue, stopValue);
+   int      handle;
+   ViInt16  i;
+
+   memset (cached, 0, 3 * BUFFER_SIZE);
+   if ((handle = OpenFile (cacheFile, VAL_READ_ONLY, VAL_OPEN_AS_IS, VAL_ASCII)) < 0) return;
+   for (i = 0; i < 3; i++)
+   {
+      if (ReadLine (handle, cached[i], BUFFER_SIZE - 1) < 0)
+      {
+         memset (cached, 0, 3 * BUFFER_SIZE);
+         break;
+      }
+   }
+   CloseFile (handle);
 }
 
 //---------------------------------------------------------------------------
-// Function: WDM_DIR Get ELCH Set Values
-// Purpose:  This function returns the start and stop values for ELCH
+// Function: Write Init Cache
+// Purpose:  This function writes the cache file of Pro8_InitFast. A cache
+//           that cannot be written costs the next start the full path.
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_DirGetElchSetVal (ViSession instrumentHandle, ViInt16 setParameter, ViReal64 *startValue, ViReal64 *stopValue)
+void Pro8_WriteInitCache (ViString cacheFile, ViString resource, ViString identity, ViString plug)
 {
-   return Pro8_LsGetElchSetVal (instrumentHandle, setParameter, startValue, stopValue);
+   int handle;
+
+   if ((handle = OpenFile (cacheFile, VAL_WRITE_ONLY, VAL_TRUNCATE, VAL_ASCII)) < 0) return;
+   WriteLine (handle, resource, -1);
+   WriteLine (handle, identity, -1);
+   WriteLine (handle, plug, -1);
+   CloseFile (handle);
 }
 
 //---------------------------------------------------------------------------
-// Function: WDM-CCDM Set ELCH Set Values
-// Purpose:  This function sets the start and stop values for ELCH
+// Function: Find Probe
+// Purpose:  This function is executed by a thread of Pro8_FindInstruments.
+//           It opens a resource, reads the identity and the plug
+//           configuration in one compound query and posts its index when
+//           it is finished. The answer mode of the instrument is not
+//           changed, a header of the response is skipped.
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_CcdmSetElchSetVal (ViSession instrumentHandle, ViInt16 setParameter, ViReal64 startValue, ViReal64 stopValue)
+int CVICALLBACK Pro8_FindProbe (void *functionData)
 {
-   return Pro8_LsSetElchSetVal (instrumentHandle, setParameter, startValue, stopValue);
+   ViStatus          status   = VI_SUCCESS;
+   ViSession         instr    = VI_NULL;
+   ViUInt32          retCnt   = 0;
+   ViReal64          start    = Pro8_TimeNow ();
+   ViString          answers[2];
+   ViChar            response[RESPONSE_BUF_SIZE];
+   ViChar            company[BUFFER_SIZE];
+   ViChar            *plug;
+   Pro8_tProbe       *probe   = (Pro8_tProbe*)functionData;
+   Pro8_tInstrument  *result  = &probe->result;
+   ViInt16           *t       = result->type;
+   ViInt16           *s       = result->sub;
+
+   //Opening - the timeout limits every I/O
+   if ((status = viOpen (probe->rmSession, result->resource, VI_NULL, probe->timeout, &instr)) >= 0)
+   {
+      if ((status = viSetAttribute (instr, VI_ATTR_TMO_VALUE, probe->timeout)) >= 0)
+      {
+         //Writing - Reading
+         if ((status = Pro8_Send (instr, "*IDN?;:CONFIG:PLUG?", 19, &retCnt)) >= 0)
+         {
+            status = Pro8_ReadAnswers (instr, 2, response, sizeof (response), answers);
+         }
+      }
+      //Identity - plug configuration
+      if (status >= 0)
+      {
+         if (Pro8_Scan (answers[0], "%[^,], %[^,], %[^,], %[^\n]", company, result->model, result->serial, result->firmware) < 0) status = VI_ERROR_FAIL_ID_QUERY;
+         else status = Pro8_CheckIdentity (company, result->model);
+      }
+      if (status >= 0)
+      {
+         plug = answers[1];
+         if ((*plug == ':') && strchr (plug, ' ')) plug = strchr (plug, ' ') + 1;
+         if (Pro8_Scan (plug, "%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d", &t[0], &s[0], &t[1], &s[1], &t[2], &s[2], &t[3], &s[3],
+                       &t[4], &s[4], &t[5], &s[5], &t[6], &s[6], &t[7], &s[7]) < 0) status = VI_ERROR_INSTR_INTERPRETING_RESPONSE;
+      }
+      viClose (instr);
+   }
+   //Finished
+   result->status = status;
+   result->time   = Pro8_TimeNow () - start;
+   CmtWriteTSQData (probe->done, &probe->index, 1, TSQ_INFINITE_TIMEOUT, VI_NULL);
+   return 0;
 }
 
+//===========================================================================
+// TRANSPORT FUNCTIONS
+//===========================================================================
 //---------------------------------------------------------------------------
-// Function: WDM_CCDM Get ELCH Set Values
-// Purpose:  This function returns the start and stop values for ELCH
+// Function: Find Transport
+// Purpose:  This function returns the transport selected by the prefix of
+//           the resource name and the address behind the prefix. Names
+//           without a known prefix are VISA resources.
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_CcdmGetElchSetVal (ViSession instrumentHandle, ViInt16 setParameter, ViReal64 *startValue, ViReal64 *stopValue)
+const Pro8_tTransport *Pro8_FindTransport (ViString resourceName, ViString *address)
 {
-   return Pro8_LsGetElchSetVal (instrumentHandle, setParameter, startValue, stopValue);
+   ViInt16 i;
+
+   for (i = 1; i < (ViInt16)(sizeof (Pro8_transports) / sizeof (Pro8_transports[0])); i++)
+   {
+      if (strncmp (resourceName, Pro8_transports[i].prefix, StringLength (Pro8_transports[i].prefix)) == 0)
+      {
+         if (address) *address = resourceName + StringLength (Pro8_transports[i].prefix);
+         return &Pro8_transports[i];
+      }
+   }
+   if (address) *address = resourceName;
+   return PRO8_VISA_TRANSPORT;
 }
 
 //---------------------------------------------------------------------------
-// Function: WDM-CCDM Set ELCH Measurement Value Position
-// Purpose:  This function sets the position of the measurement value
+// Function: Open
+// Purpose:  This function opens the instrument with the transport selected
+//           by the resource name and allocates the driver data of the
+//           session. Driver transports get a handle of their own, VISA
+//           resources are opened with rmSession.
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_CcdmSetElchMeasVal (ViSession instrumentHandle, ViInt16 measurementParameter, ViInt16 position)
+ViStatus Pro8_Open (ViSession rmSession, ViRsrc resourceName, ViPSession instrSession)
 {
-   ViStatus status = VI_SUCCESS;
-   ViUInt32 retCnt = 0;
-   ViUInt16 stb;
-   ViChar   buffer[CMD_BUF_SIZE];
-   ViString command[] = {"P_DBM", "P_W"};
+   ViStatus              status    = VI_SUCCESS;
+   ViString              address;
+   ViSession             handle;
+   const Pro8_tTransport *transport = Pro8_FindTransport (resourceName, &address);
+   Pro8_tSession         *session;
 
-   //Check input parameter ranges
-   if (Pro8_invalidViInt16Range (measurementParameter, 0, 1))  return VI_ERROR_PARAMETER2;
-   if (Pro8_invalidViInt16Range (position, 1, 8))              return VI_ERROR_PARAMETER3;
-   //Formatting
-   Fmt (buffer, ":%s:MEAS %d", command[measurementParameter], position);
-   //Writing - Poll STB - Check EAV Bit and read error
-   if ((status = viWrite (instrumentHandle, buffer, StringLength (buffer), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   //Ready
+   *instrSession = VI_NULL;
+   //Driver transport
+   if (transport != PRO8_VISA_TRANSPORT)
+   {
+      CmtGetLock (Pro8_TableLock ());
+      handle = Pro8_nextHandle++;
+      if (Pro8_nextHandle < PRO8_TRANSPORT_HANDLE) Pro8_nextHandle = PRO8_TRANSPORT_HANDLE;
+      CmtReleaseLock (Pro8_TableLock ());
+      if ((status = Pro8_NewSession (handle)) < 0) return status;
+      session = Pro8_GetSession (handle);
+      session->transport = transport;
+      if ((status = transport->open (session, address)) < 0)
+      {
+         Pro8_FreeSession (handle);
+         return status;
+      }
+      *instrSession = handle;
+      return status;
+   }
+   //VISA - configure formatted I/O
+   if ((status = viOpen (rmSession, resourceName, VI_NULL, VI_NULL, &handle)) < 0) return status;
+   if (((status = Pro8_NewSession (handle)) < 0) ||
+       ((status = viSetBuf (handle, VI_READ_BUF|VI_WRITE_BUF, 4000)) < 0) ||
+       ((status = viSetAttribute (handle, VI_ATTR_WR_BUF_OPER_MODE, VI_FLUSH_ON_ACCESS)) < 0) ||
+       ((status = viSetAttribute (handle, VI_ATTR_RD_BUF_OPER_MODE, VI_FLUSH_ON_ACCESS)) < 0))
+   {
+      Pro8_FreeSession (handle);
+      viClose (handle);
+      return status;
+   }
+   *instrSession = handle;
+   return status;
+}
+
+//---------------------------------------------------------------------------
+// Function: Send
+// Purpose:  This function writes a message with the transport of the
+//           session. Sessions without driver data are VISA sessions.
+//           The message selects the command class the following I/O is
+//           counted for (see Pro8_GetCounters).
+//---------------------------------------------------------------------------
+ViStatus Pro8_Send (ViSession instrumentHandle, ViBuf buffer, ViUInt32 count, ViPUInt32 retCount)
+{
+   ViStatus      status;
+   ViUInt32      sent    = 0;
+   ViReal64      start;
+   Pro8_tSession *session;
+
+   if ((session = Pro8_GetSession (instrumentHandle)) == VI_NULL) return viWrite (instrumentHandle, buffer, count, retCount);
+   //The reads and polls that follow are counted for the class of this message
+   session->counterClass = Pro8_CounterClass (buffer, count);
+   start  = Pro8_TimeNow ();
+   status = session->transport->write (session, buffer, count, &sent);
+   Pro8_Count (session, PRO8_COUNTER_ALL, PRO8_COUNT_WRITE, status, sent, Pro8_TimeNow () - start);
+   if (retCount) *retCount = sent;
    return status;
 }
 
 //---------------------------------------------------------------------------
-// Function: WDM-CCDM Get ELCH Measurement Value Position
-// Purpose:  This function returns the position of the measurement value
+// Function: Read
+// Purpose:  This function reads a message with the transport of the
+//           session. VI_SUCCESS_MAX_CNT means the message continues.
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_CcdmGetElchMeasVal (ViSession instrumentHandle, ViInt16 measurementParameter, ViInt16 *position)
+ViStatus Pro8_Read (ViSession instrumentHandle, ViBuf buffer, ViUInt32 count, ViPUInt32 retCount)
 {
-   ViStatus  status = VI_SUCCESS;
-   ViUInt32  retCnt = 0;
-   ViUInt16  stb;
-   ViString  command[] = {":P_DBM:MEAS?", ":P_W:MEAS?"};
-   ViBoolean answer;
-   ViString  format[] = {"%*s %d", "%d"};
+   ViStatus      status;
+   ViUInt32      received = 0;
+   ViReal64      start;
+   Pro8_tSession *session;
 
-   if ((status = viGetAttribute (instrumentHandle, VI_ATTR_USER_DATA, &answer)) < 0) return status;
-   //Check input parameter ranges
-   if (Pro8_invalidViInt16Range (measurementParameter, 0, 1))  return VI_ERROR_PARAMETER2;
-   //Writing - Poll STB - Check EAV Bit and read error - Reading
-   if ((status = viWrite (instrumentHandle, command[measurementParameter], StringLength (command[measurementParameter]), &retCnt)) < 0) return status;
-   if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) return status;
-   if (stb & 0x0004) return Pro8_GetInstrumentError (instrumentHandle);
-   if ((status = viScanf (instrumentHandle, format[answer], position)) < 0) return status;
-   //Ready
+   if ((session = Pro8_GetSession (instrumentHandle)) == VI_NULL) return viRead (instrumentHandle, buffer, count, retCount);
+   start  = Pro8_TimeNow ();
+   status = session->transport->read (session, buffer, count, &received);
+   Pro8_Count (session, PRO8_COUNTER_ALL, PRO8_COUNT_READ, status, received, Pro8_TimeNow () - start);
+   if (retCount) *retCount = received;
    return status;
 }
 
 //---------------------------------------------------------------------------
-// Function: WDM-CWDM Set ELCH Set Values
-// Purpose:  This function sets the start and stop values for ELCH
+// Function: Read STB
+// Purpose:  This function reads the status byte with the transport of the
+//           session.
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_CwdmSetElchSetVal (ViSession instrumentHandle, ViInt16 setParameter, ViReal64 startValue, ViReal64 stopValue)
+ViStatus Pro8_ReadSTB (ViSession instrumentHandle, ViUInt16 *stb)
 {
-   return Pro8_LsSetElchSetVal (instrumentHandle, setParameter, startValue, stopValue);
+   ViStatus      status;
+   ViReal64      start;
+   Pro8_tSession *session;
+
+   if ((session = Pro8_GetSession (instrumentHandle)) == VI_NULL) return viReadSTB (instrumentHandle, stb);
+   start  = Pro8_TimeNow ();
+   status = session->transport->readStb (session, stb);
+   Pro8_Count (session, PRO8_COUNTER_ALL, PRO8_COUNT_STB, status, 0, Pro8_TimeNow () - start);
+   return status;
 }
 
 //---------------------------------------------------------------------------
-// Function: WDM_CWDM Get ELCH Set Values
-// Purpose:  This function returns the start and stop values for ELCH
+// Function: Counter Class
+// Purpose:  This function returns the command class PRO8_COUNTER_xxx of a
+//           message. A compound command with a query is a query.
 //---------------------------------------------------------------------------
-ViStatus _VI_FUNC Pro8_CwdmGetElchSetVal (ViSession instrumentHandle, ViInt16 setParameter, ViReal64 *startValue, ViReal64 *stopValue)
+ViInt16 Pro8_CounterClass (ViBuf buffer, ViUInt32 count)
 {
-   return Pro8_LsGetElchSetVal (instrumentHandle, setParameter, startValue, stopValue);
+   if ((count >= 9) && (memcmp (buffer, ":SYST:ERR", 9) == 0)) return PRO8_COUNTER_ERROR;
+   if ((count >= 1) && (buffer[0] == '*'))                      return PRO8_COUNTER_COMMON;
+   if (memchr (buffer, '?', count) != VI_NULL)                  return PRO8_COUNTER_QUERY;
+   return PRO8_COUNTER_SETTING;
 }
 
+//---------------------------------------------------------------------------
+// Function: Count
+// Purpose:  This function adds an event PRO8_COUNT_xxx and its duration to
+//           the counters of a command class, PRO8_COUNTER_ALL counts it for
+//           the class of the message written last. The counters are
+//           updated between two increments of the sequence like a
+//           setpoint value. Only the thread holding the lock of the
+//           session updates them.
+//---------------------------------------------------------------------------
+void Pro8_Count (Pro8_tSession *session, ViInt16 commandClass, ViInt16 event, ViStatus status, ViUInt32 bytes, ViReal64 seconds)
+{
+   Pro8_tCounters *counters;
+
+   if (session == VI_NULL) return;
+   if (commandClass == PRO8_COUNTER_ALL) commandClass = session->counterClass;
+   counters = &session->counters[commandClass - 1];
+   //Update
+   session->counterSequence++;
+   Pro8_MemoryBarrier ();
+   switch (event)
+   {
+      case PRO8_COUNT_WRITE:
+         counters->writes++;
+         counters->bytesWritten += bytes;
+         counters->writeTime    += seconds;
+         break;
+
+      case PRO8_COUNT_READ:
+         counters->reads++;
+         counters->bytesRead += bytes;
+         counters->readTime  += seconds;
+         break;
+
+      case PRO8_COUNT_STB:
+         counters->stbPolls++;
+         counters->stbTime += seconds;
+         break;
+
+      case PRO8_COUNT_SLEEP:
+         counters->sleeps++;
+         counters->sleepTime += seconds;
+         break;
+
+      case PRO8_COUNT_WAIT:
+         counters->waits++;
+         counters->waitTime += seconds;
+         break;
+
+      case PRO8_COUNT_TIMEOUT:
+         counters->pollTimeouts++;
+         counters->waits++;
+         counters->waitTime += seconds;
+         break;
+
+      case PRO8_COUNT_DRAIN:
+         counters->errorDrains++;
+         counters->drainTime += seconds;
+         break;
+   }
+   if ((status < 0) && (event <= PRO8_COUNT_STB)) counters->ioErrors++;
+   Pro8_MemoryBarrier ();
+   session->counterSequence++;
+}
 
-//===========================================================================
-// UTILITY ROUTINES (Non-Exportable Functions)
-//===========================================================================
 //---------------------------------------------------------------------------
-// Function: Wait for FIN Bit (Bit0 in Status Byte)
-// Purpose:  This function waits for the FIN (finished) Bit and returns
-//           the status byte.
+// Function: Counter Snapshot
+// Purpose:  This function copies the counters of a session without taking
+//           its lock. counters[PRO8_COUNTER_xxx] returns the counters of a
+//           class, counters[PRO8_COUNTER_ALL] their sum.
 //---------------------------------------------------------------------------
-ViStatus Pro8_WaitForFinBit (ViSession instrumentHandle, ViUInt16 *stb)
+void Pro8_CounterSnapshot (Pro8_tSession *session, Pro8_tCounters counters[])
 {
-   ViStatus  status  = VI_SUCCESS;
-   ViBoolean ready   = VI_FALSE;
-   ViBoolean error   = VI_FALSE;
-   ViUInt16  counter = PRO8_POLL_STB_LOOP_COUNTER;
-   ViUInt16  value   = 0;
+   Pro8_tCounters *sum = &counters[PRO8_COUNTER_ALL];
+   Pro8_tCounters *c;
+   ViUInt32       first;
+   ViReal64       elapsed;
+   ViInt16        i;
 
-   //Preset
-   *stb = 0;
-   //Loop
+   //Consistent copy - retry while the I/O of the session updates it
    do
    {
-      //Poll STB
-      if ((status = viReadSTB (instrumentHandle, &value)) < 0) error = VI_TRUE;
-      else
+      first = session->counterSequence;
+      Pro8_MemoryBarrier ();
+      memcpy (&counters[1], session->counters, sizeof (session->counters));
+      elapsed = Pro8_TimeNow () - session->counterReset;
+      Pro8_MemoryBarrier ();
+   }  while ((first & 1) || (first != session->counterSequence));
+   //Sum of the classes
+   memset (sum, 0, sizeof (Pro8_tCounters));
+   for (i = 1; i <= PRO8_COUNTER_CLASSES; i++)
+   {
+      c = &counters[i];
+      c->elapsed         = elapsed;
+      sum->writes       += c->writes;
+      sum->bytesWritten += c->bytesWritten;
+      sum->reads        += c->reads;
+      sum->bytesRead    += c->bytesRead;
+      sum->stbPolls     += c->stbPolls;
+      sum->sleeps       += c->sleeps;
+      sum->waits        += c->waits;
+      sum->pollTimeouts += c->pollTimeouts;
+      sum->errorDrains  += c->errorDrains;
+      sum->ioErrors     += c->ioErrors;
+      sum->writeTime    += c->writeTime;
+      sum->readTime     += c->readTime;
+      sum->stbTime      += c->stbTime;
+      sum->sleepTime    += c->sleepTime;
+      sum->waitTime     += c->waitTime;
+      sum->drainTime    += c->drainTime;
+   }
+   sum->elapsed = elapsed;
+}
+
+//---------------------------------------------------------------------------
+// Function: Format Metrics
+// Purpose:  This function writes the counters of all sessions as the text
+//           of Pro8_GetMetrics. Lines that do not fit size are left out
+//           from the first one on. Returns the length of the whole text,
+//           size may be 0 to get it.
+//---------------------------------------------------------------------------
+ViInt32 Pro8_FormatMetrics (ViChar buffer[], ViInt32 size)
+{
+   Pro8_tCounters counters[PRO8_MAX_SESSIONS][PRO8_COUNTER_CLASSES + 1];
+   Pro8_tCounters *c;
+   ViSession      instr[PRO8_MAX_SESSIONS];
+   ViString       transport[PRO8_MAX_SESSIONS];
+   ViReal64       value = 0.0;
+   ViChar         type[CMD_BUF_SIZE], line[CMD_BUF_SIZE];
+   ViInt32        length = 0, written = 0, t, n;
+   ViInt16        sessions = 0, i, j, k;
+
+   //Snapshots - entries are not claimed or released meanwhile
+   CmtGetLock (Pro8_TableLock ());
+   for (i = 0; i < PRO8_MAX_SESSIONS; i++)
+   {
+      if ((instr[sessions] = Pro8_sessions[i].instr) == VI_NULL) continue;
+      transport[sessions] = Pro8_sessions[i].transport->name;
+      Pro8_CounterSnapshot (&Pro8_sessions[i], counters[sessions]);
+      sessions++;
+   }
+   CmtReleaseLock (Pro8_TableLock ());
+   //Lines grouped by counter
+   for (k = 0; k < PRO8_METRICS_COUNT; k++)
+   {
+      t = Pro8_Fmt (type, "# TYPE %s %s\n", Pro8_metricNames[k], (k == PRO8_METRICS_COUNT - 1) ? "gauge" : "counter");
+      for (i = 0; i < sessions; i++)
       {
-         //Check FIN Bit
-         if (value & 0x0001) ready = VI_TRUE;
-         else
+         for (j = 1; j <= PRO8_COUNTER_CLASSES; j++)
          {
-            //Delay and decrement counter
-            Delay (PRO8_POLL_STB_LOOP_DELAY);
-            counter --;
+            c = &counters[i][j];
+            switch (k)
+            {
+               case 0:  value = c->writes;         break;
+               case 1:  value = c->bytesWritten;   break;
+               case 2:  value = c->reads;          break;
+               case 3:  value = c->bytesRead;      break;
+               case 4:  value = c->stbPolls;       break;
+               case 5:  value = c->sleeps;         break;
+               case 6:  value = c->waits;          break;
+               case 7:  value = c->pollTimeouts;   break;
+               case 8:  value = c->errorDrains;    break;
+               case 9:  value = c->ioErrors;       break;
+               case 10: value = c->writeTime;      break;
+               case 11: value = c->readTime;       break;
+               case 12: value = c->stbTime;        break;
+               case 13: value = c->sleepTime;      break;
+               case 14: value = c->waitTime;       break;
+               case 15: value = c->drainTime;      break;
+               default: value = c->elapsed;        break;
+            }
+            //The type line goes with the first value
+            n = Pro8_Fmt (line, "%s{session=\"%d\",transport=\"%s\",class=\"%s\"} %f\n",
+                          Pro8_metricNames[k], (int)instr[i], transport[i], Pro8_counterClassNames[j], value);
+            if ((written == length) && (length + t + n < size))
+            {
+               memcpy (&buffer[written], type, t);
+               memcpy (&buffer[written + t], line, n);
+               written += t + n;
+            }
+            length += t + n;
+            t = 0;
          }
       }
    }
-   while ((ready == VI_FALSE) && (error == VI_FALSE) && (counter > 0));
-   //Evaluate
-   if (error == VI_TRUE)   return status;
-   if (counter == 0)       return VI_ERROR_POLL_FIN_BIT;
-   //Ready
-   *stb = value;
-   return VI_SUCCESS;
+   if (size > 0) buffer[written] = '\0';
+   return length;
 }
 
 //---------------------------------------------------------------------------
-// Function: Get Instrument Error Code
-// Purpose:  This function queries the instruments error queue until the
-//           queue is empty and returns the error code.
+// Function: Scanf
+// Purpose:  This function reads one message and converts it like viScanf
+//           (see Pro8_VScan). A message longer than the buffer is read to
+//           its end and truncated.
 //---------------------------------------------------------------------------
-ViStatus Pro8_GetInstrumentError (ViSession instrumentHandle)
+ViStatus Pro8_Scanf (ViSession instrumentHandle, ViString format, ...)
 {
-   ViStatus  status  = VI_SUCCESS;
-   ViBoolean ready   = VI_FALSE;
-   ViBoolean error   = VI_FALSE;
-   ViUInt16  counter = PRO8_GET_ERROR_LOOP_COUNTER;
-   ViUInt32  retCnt  = 0;
-   ViUInt16  value   = 0;
-   ViUInt16  stb     = 0;
+   ViStatus status = VI_SUCCESS;
+   ViUInt32 retCnt = 0;
+   ViChar   buffer[RESPONSE_BUF_SIZE];
+   ViChar   rest[64];
+   va_list  args;
 
-   //Loop
-   do
+   //Reading
+   if ((status = Pro8_Read (instrumentHandle, buffer, sizeof (buffer) - 1, &retCnt)) < 0) return status;
+   buffer[retCnt] = '\0';
+   while (status == VI_SUCCESS_MAX_CNT)
+   {
+      if ((status = Pro8_Read (instrumentHandle, rest, sizeof (rest), &retCnt)) < 0) return status;
+   }
+   //Converting
+   va_start (args, format);
+   status = Pro8_VScan (buffer, format, args);
+   va_end (args);
+   return status;
+}
+
+//---------------------------------------------------------------------------
+// Function: Scan
+// Purpose:  This function converts a string like viSScanf (see Pro8_VScan).
+//---------------------------------------------------------------------------
+ViStatus Pro8_Scan (ViString buffer, ViString format, ...)
+{
+   ViStatus status = VI_SUCCESS;
+   va_list  args;
+
+   va_start (args, format);
+   status = Pro8_VScan (buffer, format, args);
+   va_end (args);
+   return status;
+}
+
+//---------------------------------------------------------------------------
+// Function: VScan
+// Purpose:  This function converts a string with the viScanf subset the
+//           driver uses: white space, literal characters, '*' to skip a
+//           field, an optional width, %d (ViInt16), %ld (ViInt32), %e %f
+//           %g with l or L (ViReal64, '.' as decimal point) or without
+//           (ViReal32), %s and %[set] or %[^set]. A literal character that
+//           does not match ends the conversion, a missing number is an
+//           error.
+//---------------------------------------------------------------------------
+ViStatus Pro8_VScan (ViString buffer, ViString format, va_list args)
+{
+   ViChar    *p = buffer, *f = format, *end, *dest;
+   ViChar    set[256];
+   ViBoolean skip, negate;
+   ViChar    modifier;
+   ViInt32   width, n, value;
+   ViReal64  real;
+
+   while (*f)
    {
-      //Writing
-      if ((status = viWrite (instrumentHandle, ":SYST:ERR?", 10, &retCnt)) < 0) error = VI_TRUE;
-      //Poll STB
-      if (error == VI_FALSE)
+      //White space matches any amount of white space
+      if ((*f == ' ') || (*f == '\t') || (*f == '\r') || (*f == '\n'))
       {
-         if ((status = Pro8_WaitForFinBit (instrumentHandle, &stb)) < 0) error = VI_TRUE;
-         //Reading
-         if (error == VI_FALSE)
-         {
-            if ((status = viScanf (instrumentHandle, "%ld", &value)) < 0) error = VI_TRUE;
-            //Evaluate STB
-            if (error == VI_FALSE)
+         while ((*p == ' ') || (*p == '\t') || (*p == '\r') || (*p == '\n')) p++;
+         f++;
+         continue;
+      }
+      //Literal character
+      if ((*f != '%') || (f[1] == '%'))
+      {
+         if (*f == '%') f++;
+         if (*p != *f) return VI_SUCCESS;
+         p++;
+         f++;
+         continue;
+      }
+      //Conversion - flags, width, modifier
+      f++;
+      skip = (ViBoolean)(*f == '*');
+      if (skip) f++;
+      for (width = 0; (*f >= '0') && (*f <= '9'); f++) width = width * 10 + (*f - '0');
+      modifier = ((*f == 'l') || (*f == 'L') || (*f == 'h')) ? *f++ : '\0';
+      switch (*f)
+      {
+         case 'd':
+         case 'i':
+            while ((*p == ' ') || (*p == '\t')) p++;
+            value = strtol (p, &end, 10);
+            if (end == p) return VI_ERROR_INSTR_INTERPRETING_RESPONSE;
+            p = end;
+            if (skip) break;
+            if (modifier == 'l') *va_arg (args, ViInt32*) = value;
+            else                 *va_arg (args, ViInt16*) = (ViInt16)value;
+            break;
+
+         case 'e':
+         case 'E':
+         case 'f':
+         case 'g':
+         case 'G':
+            while ((*p == ' ') || (*p == '\t')) p++;
+            real = Pro8_StringToReal (p, &end);
+            if (end == p) return VI_ERROR_INSTR_INTERPRETING_RESPONSE;
+            p = end;
+            if (skip) break;
+            if (modifier) *va_arg (args, ViReal64*) = real;
+            else          *va_arg (args, ViReal32*) = (ViReal32)real;
+            break;
+
+         case 's':
+            while ((*p == ' ') || (*p == '\t') || (*p == '\r') || (*p == '\n')) p++;
+            dest = skip ? VI_NULL : va_arg (args, ViChar*);
+            for (n = 0; *p && (*p != ' ') && (*p != '\t') && (*p != '\r') && (*p != '\n') && ((width == 0) || (n < width)); n++, p++)
             {
-               if ((stb & 0x0004) == 0) ready = VI_TRUE;
-               else counter --;
+               if (dest) *dest++ = *p;
             }
-         }
+            if (dest) *dest = '\0';
+            break;
+
+         case '[':
+            //Character set, ']' right after '[' or '^' belongs to it
+            f++;
+            negate = (ViBoolean)(*f == '^');
+            if (negate) f++;
+            memset (set, 0, sizeof (set));
+            if (*f == ']') set[(unsigned char)*f++] = 1;
+            while (*f && (*f != ']')) set[(unsigned char)*f++] = 1;
+            if (*f == '\0') return VI_ERROR_INV_FMT;
+            dest = skip ? VI_NULL : va_arg (args, ViChar*);
+            for (n = 0; *p && (set[(unsigned char)*p] != negate) && ((width == 0) || (n < width)); n++, p++)
+            {
+               if (dest) *dest++ = *p;
+            }
+            if (dest) *dest = '\0';
+            break;
+
+         default:
+            return VI_ERROR_INV_FMT;
       }
+      f++;
    }
-   while ((ready == VI_FALSE) && (error == VI_FALSE) && (counter > 0));
-   //Evaluate
-   if (error == VI_TRUE)   return status;
-   if (counter == 0)       return VI_ERROR_GET_INSTR_ERROR;
    //Ready
-   return (value + VI_INSTR_ERROR_OFFSET);
+   return VI_SUCCESS;
 }
 
 //---------------------------------------------------------------------------
-// Function: Boolean Value Out Of Range - ViBoolean
-// Purpose:  This function checks a Boolean to see if it is equal to VI_TRUE
-//           or VI_FALSE. If the value is out of range, the return value is
-//           VI_TRUE, otherwise the return value is VI_FALSE.
+// Function: VISA Write, VISA Read, VISA Read STB
+// Purpose:  These functions are the VISA transport.
 //---------------------------------------------------------------------------
-ViBoolean Pro8_invalidViBooleanRange (ViBoolean val)
+ViStatus Pro8_VisaWrite (Pro8_tSession *session, ViBuf buffer, ViUInt32 count, ViPUInt32 retCount)
 {
-   return ((val != VI_FALSE && val != VI_TRUE) ? VI_TRUE : VI_FALSE);
+   return viWrite (session->instr, buffer, count, retCount);
+}
+
+ViStatus Pro8_VisaRead (Pro8_tSession *session, ViBuf buffer, ViUInt32 count, ViPUInt32 retCount)
+{
+   return viRead (session->instr, buffer, count, retCount);
+}
+
+ViStatus Pro8_VisaReadStb (Pro8_tSession *session, ViUInt16 *stb)
+{
+   return viReadSTB (session->instr, stb);
 }
 
+#if defined(__linux__)
 //---------------------------------------------------------------------------
-// Function: Short Signed Integer Value Out Of Range - ViInt16
-// Purpose:  This function checks a short signed integer value to see if it
-//           lies between a minimum and maximum value.  If the value is out
-//           of range, the return value is VI_TRUE, otherwise the return
-//           value is VI_FALSE.
+// Function: File Descriptor Close
+// Purpose:  This function closes the device or socket of a usbtmc, tty or
+//           tcp session.
 //---------------------------------------------------------------------------
-ViBoolean Pro8_invalidViInt16Range (ViInt16 val, ViInt16 min, ViInt16 max)
+void Pro8_FdClose (Pro8_tSession *session)
 {
-   return ((val < min || val > max) ? VI_TRUE : VI_FALSE);
+   if (session->fd >= 0) close (session->fd);
+   session->fd = -1;
 }
 
 //---------------------------------------------------------------------------
-// Function: Long Signed Integer Value Out Of Range - ViInt32
-// Purpose:  This function checks a long signed integer value to see if it
-//           lies between a minimum and maximum value.  If the value is out
-//           of range, the return value is VI_TRUE, otherwise the return
-//           value is VI_FALSE.
+// Function: USBTMC Open
+// Purpose:  This function opens a device of the Linux usbtmc driver, e.g.
+//           "usbtmc:/dev/usbtmc0". Every write() is one message, read()
+//           and the status byte go through the kernel driver.
 //---------------------------------------------------------------------------
-ViBoolean Pro8_invalidViInt32Range (ViInt32 val, ViInt32 min, ViInt32 max)
+ViStatus Pro8_UsbtmcOpen (Pro8_tSession *session, ViString address)
 {
-   return ((val < min || val > max) ? VI_TRUE : VI_FALSE);
+   unsigned int timeout = session->timeout;
+
+   if ((session->fd = open (address, O_RDWR)) < 0) return VI_ERROR_RSRC_NFOUND;
+#ifdef USBTMC_IOCTL_SET_TIMEOUT
+   ioctl (session->fd, USBTMC_IOCTL_SET_TIMEOUT, &timeout);
+#endif
+   return VI_SUCCESS;
+}
+
+ViStatus Pro8_UsbtmcWrite (Pro8_tSession *session, ViBuf buffer, ViUInt32 count, ViPUInt32 retCount)
+{
+   ssize_t n;
+
+   if (retCount) *retCount = 0;
+   do n = write (session->fd, buffer, count); while ((n < 0) && (errno == EINTR));
+   if (n < 0) return (errno == ETIMEDOUT) ? VI_ERROR_TMO : VI_ERROR_IO;
+   if (retCount) *retCount = (ViUInt32)n;
+   return ((ViUInt32)n == count) ? VI_SUCCESS : VI_ERROR_IO;
+}
+
+ViStatus Pro8_UsbtmcRead (Pro8_tSession *session, ViBuf buffer, ViUInt32 count, ViPUInt32 retCount)
+{
+   ssize_t n;
+
+   if (retCount) *retCount = 0;
+   do n = read (session->fd, buffer, count); while ((n < 0) && (errno == EINTR));
+   if (n < 0) return (errno == ETIMEDOUT) ? VI_ERROR_TMO : VI_ERROR_IO;
+   if (retCount) *retCount = (ViUInt32)n;
+   return ((ViUInt32)n == count) ? VI_SUCCESS_MAX_CNT : VI_SUCCESS;
+}
+
+ViStatus Pro8_UsbtmcReadStb (Pro8_tSession *session, ViUInt16 *stb)
+{
+#ifdef USBTMC488_IOCTL_READ_STB
+   unsigned char value = 0;
+
+   if (ioctl (session->fd, USBTMC488_IOCTL_READ_STB, &value) < 0) return (errno == ETIMEDOUT) ? VI_ERROR_TMO : VI_ERROR_IO;
+   *stb = value;
+   return VI_SUCCESS;
+#else
+   return VI_ERROR_NSUP_OPER;
+#endif
 }
 
 //---------------------------------------------------------------------------
-// Function: Unsigned Char Value Out Of Range - ViUInt8
-// Purpose:  This function checks an unsigned char value to see if it
-//           lies between a minimum and maximum value.  If the value is out
-//           of range, the return value is VI_TRUE, otherwise the return
-//           value is VI_FALSE.
+// Function: TTY Open
+// Purpose:  This function opens a serial port or pseudo terminal, e.g.
+//           "tty:/dev/ttyUSB0,19200" or "tty:/dev/pts/3". The line is set
+//           to raw 8N1, the baud rate is only changed if it is given.
 //---------------------------------------------------------------------------
-ViBoolean Pro8_invalidViUInt8Range (ViUInt8 val, ViUInt8 min, ViUInt8 max)
+ViStatus Pro8_TtyOpen (Pro8_tSession *session, ViString address)
 {
-   return ((val < min || val > max) ? VI_TRUE : VI_FALSE);
+   static const struct { long baud; speed_t speed; } rates[] =
+   {
+      {9600, B9600}, {19200, B19200}, {38400, B38400}, {57600, B57600}, {115200, B115200}
+   };
+   ViChar         device[256], *comma;
+   speed_t        speed = 0;
+   long           baud;
+   ViInt16        i;
+   struct termios tio;
+
+   if (StringLength (address) >= (int)sizeof (device)) return VI_ERROR_INV_RSRC_NAME;
+   CopyString (device, 0, address, 0, -1);
+   //Baud rate
+   if ((comma = strchr (device, ',')) != VI_NULL)
+   {
+      *comma = '\0';
+      baud   = atol (comma + 1);
+      for (i = 0; i < (ViInt16)(sizeof (rates) / sizeof (rates[0])); i++) if (rates[i].baud == baud) speed = rates[i].speed;
+      if (speed == 0) return VI_ERROR_INV_RSRC_NAME;
+   }
+   //Opening - raw 8N1, files other than terminals are used as they are
+   if ((session->fd = open (device, O_RDWR | O_NOCTTY)) < 0) return VI_ERROR_RSRC_NFOUND;
+   if (tcgetattr (session->fd, &tio) == 0)
+   {
+      tio.c_iflag &= ~(IGNBRK | BRKINT | PARMRK | ISTRIP | INLCR | IGNCR | ICRNL | IXON | IXOFF);
+      tio.c_oflag &= ~OPOST;
+      tio.c_lflag &= ~(ECHO | ECHONL | ICANON | ISIG | IEXTEN);
+      tio.c_cflag &= ~(CSIZE | PARENB | CSTOPB);
+      tio.c_cflag |= CS8 | CLOCAL | CREAD;
+      tio.c_cc[VMIN]  = 1;
+      tio.c_cc[VTIME] = 0;
+      if (speed)
+      {
+         cfsetispeed (&tio, speed);
+         cfsetospeed (&tio, speed);
+      }
+      if (tcsetattr (session->fd, TCSANOW, &tio) < 0)
+      {
+         Pro8_FdClose (session);
+         return VI_ERROR_IO;
+      }
+      tcflush (session->fd, TCIOFLUSH);
+   }
+   return VI_SUCCESS;
 }
 
 //---------------------------------------------------------------------------
-// Function: Short Unsigned Integer Value Out Of Range - ViUInt16
-// Purpose:  This function checks a short unsigned integer value to see if it
-//           lies between a minimum and maximum value.  If the value is out
-//           of range, the return value is VI_TRUE, otherwise the return
-//           value is VI_FALSE.
+// Function: TCP Open
+// Purpose:  This function connects to a raw SCPI socket, e.g.
+//           "tcp:192.168.1.20:5025", with Nagle's algorithm disabled.
 //---------------------------------------------------------------------------
-ViBoolean Pro8_invalidViUInt16Range (ViUInt16 val, ViUInt16 min, ViUInt16 max)
+ViStatus Pro8_TcpOpen (Pro8_tSession *session, ViString address)
 {
-   return ((val < min || val > max) ? VI_TRUE : VI_FALSE);
+   ViChar          host[256], *colon;
+   int             one = 1;
+   struct addrinfo hints, *list, *a;
+
+   if (StringLength (address) >= (int)sizeof (host)) return VI_ERROR_INV_RSRC_NAME;
+   CopyString (host, 0, address, 0, -1);
+   if ((colon = strrchr (host, ':')) == VI_NULL) return VI_ERROR_INV_RSRC_NAME;
+   *colon = '\0';
+   //Resolving - connecting to the first address that answers
+   memset (&hints, 0, sizeof (hints));
+   hints.ai_family   = AF_UNSPEC;
+   hints.ai_socktype = SOCK_STREAM;
+   if (getaddrinfo (host, colon + 1, &hints, &list) != 0) return VI_ERROR_RSRC_NFOUND;
+   for (a = list; a; a = a->ai_next)
+   {
+      if ((session->fd = socket (a->ai_family, a->ai_socktype, a->ai_protocol)) < 0) continue;
+      if (connect (session->fd, a->ai_addr, a->ai_addrlen) == 0) break;
+      Pro8_FdClose (session);
+   }
+   freeaddrinfo (list);
+   if (session->fd < 0) return VI_ERROR_RSRC_NFOUND;
+   setsockopt (session->fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof (one));
+   return VI_SUCCESS;
 }
 
 //---------------------------------------------------------------------------
-// Function: Long Unsigned Integer Value Out Of Range - ViUInt32
-// Purpose:  This function checks a long unsigned integer value to see if it
-//           lies between a minimum and maximum value.  If the value is out
-//           of range, the return value is VI_TRUE, otherwise the return
-//           value is VI_FALSE.
+// Function: Line Write
+// Purpose:  This function writes a message terminated by '\n' to a tty or
+//           tcp session, in one write() if it fits the line buffer. tcp
+//           sessions use send() with MSG_NOSIGNAL, a closed connection
+//           returns VI_ERROR_CONN_LOST instead of raising SIGPIPE.
 //---------------------------------------------------------------------------
-ViBoolean Pro8_invalidViUInt32Range (ViUInt32 val, ViUInt32 min, ViUInt32 max)
+ViStatus Pro8_LineWrite (Pro8_tSession *session, ViBuf buffer, ViUInt32 count, ViPUInt32 retCount)
 {
-   return ((val < min || val > max) ? VI_TRUE : VI_FALSE);
+   ViChar    line[RESPONSE_BUF_SIZE];
+   ViBuf     data   = buffer;
+   ViUInt32  length = count, sent = 0;
+   ViBoolean tcp    = (session->transport->open == Pro8_TcpOpen);
+   ssize_t   n;
+
+   if (retCount) *retCount = 0;
+   if (count < sizeof (line))
+   {
+      memcpy (line, buffer, count);
+      line[count] = '\n';
+      data   = (ViBuf)line;
+      length = count + 1;
+   }
+   //Writing
+   while (sent < length)
+   {
+      if (tcp) n = send (session->fd, data + sent, length - sent, MSG_NOSIGNAL);
+      else     n = write (session->fd, data + sent, length - sent);
+      if (n < 0)
+      {
+         if (errno == EINTR) continue;
+         return (errno == EPIPE) ? VI_ERROR_CONN_LOST : VI_ERROR_IO;
+      }
+      sent += (ViUInt32)n;
+      //Terminator of long messages
+      if ((sent == length) && (data == buffer))
+      {
+         data   = (ViBuf)"\n";
+         length = 1;
+         sent   = 0;
+      }
+   }
+   if (memchr (buffer, '?', count)) session->queryPending = VI_TRUE;
+   if (retCount) *retCount = count;
+   return VI_SUCCESS;
 }
 
 //---------------------------------------------------------------------------
-// Function: Real (Float) Value Out Of Range - ViReal32
-// Purpose:  This function checks a real (float) value to see if it lies
-//           between a minimum and maximum value.  If the value is out of
-//           range, the return value is VI_TRUE, otherwise the return value
-//           is VI_FALSE.
+// Function: Line Fill
+// Purpose:  This function waits up to the session timeout for received
+//           bytes and appends them to the receive buffer.
 //---------------------------------------------------------------------------
-ViBoolean Pro8_invalidViReal32Range (ViReal32 val, ViReal32 min, ViReal32 max)
+ViStatus Pro8_LineFill (Pro8_tSession *session)
 {
-   return ((val < min || val > max) ? VI_TRUE : VI_FALSE);
+   struct pollfd pfd;
+   ssize_t       n;
+   int           ready;
+
+   //Compacting
+   if (session->rxStart)
+   {
+      memmove (session->rx, &session->rx[session->rxStart], session->rxEnd - session->rxStart);
+      session->rxEnd  -= session->rxStart;
+      session->rxStart = 0;
+   }
+   if (session->rxEnd >= sizeof (session->rx)) return VI_SUCCESS;
+   //Waiting - reading
+   pfd.fd     = session->fd;
+   pfd.events = POLLIN;
+   do ready = poll (&pfd, 1, (int)session->timeout); while ((ready < 0) && (errno == EINTR));
+   if (ready == 0) return VI_ERROR_TMO;
+   if (ready < 0)  return VI_ERROR_IO;
+   do n = read (session->fd, &session->rx[session->rxEnd], sizeof (session->rx) - session->rxEnd); while ((n < 0) && (errno == EINTR));
+   if (n == 0) return VI_ERROR_CONN_LOST;
+   if (n < 0)  return VI_ERROR_IO;
+   session->rxEnd += (ViUInt32)n;
+   return VI_SUCCESS;
 }
 
 //---------------------------------------------------------------------------
-// Function: Real (Double) Value Out Of Range - ViReal64
-// Purpose:  This function checks a real (double) value to see if it lies
-//           between a minimum and maximum value.  If the value is out of
-//           range, the return value is VI_TRUE, otherwise the return value
-//           is VI_FALSE.
+// Function: Line Read
+// Purpose:  This function reads a message of a tty or tcp session up to and
+//           including '\n'. A "\r\n" terminator is returned as '\n'.
 //---------------------------------------------------------------------------
-ViBoolean Pro8_invalidViReal64Range (ViReal64 val, ViReal64 min, ViReal64 max)
+ViStatus Pro8_LineRead (Pro8_tSession *session, ViBuf buffer, ViUInt32 count, ViPUInt32 retCount)
 {
-   return ((val < min || val > max) ? VI_TRUE : VI_FALSE);
+   ViStatus status = VI_SUCCESS;
+   ViUInt32 length = 0, take;
+   ViChar   *newline;
+
+   if (retCount) *retCount = 0;
+   while (length < count)
+   {
+      if ((session->rxStart == session->rxEnd) && ((status = Pro8_LineFill (session)) < 0))
+      {
+         if (retCount) *retCount = length;
+         return status;
+      }
+      //Up to the terminator
+      take = session->rxEnd - session->rxStart;
+      if (take > count - length) take = count - length;
+      if ((newline = memchr (&session->rx[session->rxStart], '\n', take)) != VI_NULL) take = (ViUInt32)(newline - &session->rx[session->rxStart]) + 1;
+      memcpy (&buffer[length], &session->rx[session->rxStart], take);
+      session->rxStart += take;
+      length += take;
+      if (newline)
+      {
+         if ((length >= 2) && (buffer[length - 2] == '\r')) buffer[--length - 1] = '\n';
+         session->queryPending = VI_FALSE;
+         if (retCount) *retCount = length;
+         return VI_SUCCESS;
+      }
+   }
+   if (retCount) *retCount = length;
+   return VI_SUCCESS_MAX_CNT;
 }
 
 //---------------------------------------------------------------------------
-// Function: Initialize Clean Up
-// Purpose:  This function is used only by the Pro8_init function.  When
-//           an error is detected this function is called to close the
-//           open resource manager and instrument object sessions and to
-//           set the instrSession that is returned from Pro8_init to
-//           VI_NULL.
+// Function: Line Read STB
+// Purpose:  This function stands in for the serial poll of tty and tcp
+//           sessions. While a response is pending FIN and MAV are returned
+//           without I/O, otherwise the status byte is queried with *STB?.
+//           An error of a query is not seen in EAV, the query times out.
 //---------------------------------------------------------------------------
-ViStatus Pro8_initCleanUp (ViSession openRMSession, ViPSession openInstrSession, ViStatus currentStatus)
+ViStatus Pro8_LineReadStb (Pro8_tSession *session, ViUInt16 *stb)
 {
-   viClose (*openInstrSession);
-   viClose (openRMSession);
-   *openInstrSession = VI_NULL;
-   //Ready
-   return currentStatus;
+   ViStatus status = VI_SUCCESS;
+   ViUInt32 retCnt = 0;
+   ViChar   line[64], *p;
+   ViInt16  value  = 0;
+
+   if (session->queryPending || (session->rxStart != session->rxEnd))
+   {
+      *stb = 0x0011;
+      return VI_SUCCESS;
+   }
+   //Querying - the header of full answers is skipped
+   if ((status = Pro8_LineWrite (session, (ViBuf)"*STB?", 5, &retCnt)) < 0) return status;
+   if ((status = Pro8_LineRead (session, (ViBuf)line, sizeof (line) - 1, &retCnt)) < 0) return status;
+   line[retCnt] = '\0';
+   p = line;
+   if (((*p < '0') || (*p > '9')) && ((p = strchr (line, ' ')) == VI_NULL)) return VI_ERROR_INSTR_INTERPRETING_RESPONSE;
+   if ((status = Pro8_Scan (p, "%d", &value)) < 0) return status;
+   *stb = (ViUInt16)value;
+   return VI_SUCCESS;
+}
+#endif
+
+#if defined(__linux__)
+//---------------------------------------------------------------------------
+// Function: Metrics Worker
+// Purpose:  This is the thread of Pro8_MetricsStart. It accepts the clients
+//           of the metrics socket and serves them one after another.
+//---------------------------------------------------------------------------
+int CVICALLBACK Pro8_MetricsWorker (void *functionData)
+{
+   Pro8_tMetrics  *metrics  = (Pro8_tMetrics*)functionData;
+   struct pollfd  pfd;
+   int            client;
+
+   pfd.fd     = metrics->fd;
+   pfd.events = POLLIN;
+   while (metrics->stop == VI_FALSE)
+   {
+      if (poll (&pfd, 1, PRO8_METRICS_POLL_TIMEOUT) <= 0) continue;
+      if ((client = accept (metrics->fd, VI_NULL, VI_NULL)) < 0) continue;
+      Pro8_MetricsServe (client);
+      close (client);
+   }
+   return 0;
+}
+
+//---------------------------------------------------------------------------
+// Function: Metrics Serve
+// Purpose:  This function writes the HTTP response header and the metrics
+//           text to a client of the metrics socket. The request the client
+//           sends within PRO8_METRICS_REQUEST_TIMEOUT is read and ignored.
+//           The socket is non-blocking, the client is dropped when the
+//           response is not sent within PRO8_METRICS_CLIENT_TIMEOUT.
+//---------------------------------------------------------------------------
+void Pro8_MetricsServe (int fd)
+{
+   static const ViChar header[] = "HTTP/1.0 200 OK\r\nContent-Type: text/plain; version=0.0.4\r\nConnection: close\r\n\r\n";
+   struct pollfd  pfd;
+   ViChar         request[256];
+   ViChar         *text;
+   ViInt32        size, length, sent;
+   ViReal64       deadline;
+   int            wait;
+   ssize_t        n;
+
+   //Non-blocking - a stalled client does not hold the thread beyond the deadline
+   deadline = Pro8_TimeNow () + PRO8_METRICS_CLIENT_TIMEOUT / 1000.0;
+   fcntl (fd, F_SETFL, fcntl (fd, F_GETFL) | O_NONBLOCK);
+   //Request
+   pfd.fd     = fd;
+   pfd.events = POLLIN;
+   if (poll (&pfd, 1, PRO8_METRICS_REQUEST_TIMEOUT) > 0) n = read (fd, request, sizeof (request));
+   //Response - room for sessions opened meanwhile
+   size = sizeof (header) - 1 + Pro8_FormatMetrics (VI_NULL, 0) + 4096;
+   if ((text = (ViChar*)malloc (size)) == VI_NULL) return;
+   memcpy (text, header, sizeof (header) - 1);
+   length = Pro8_FormatMetrics (&text[sizeof (header) - 1], size - (sizeof (header) - 1));
+   if (length >= size - (ViInt32)(sizeof (header) - 1)) length = StringLength (&text[sizeof (header) - 1]);
+   length += sizeof (header) - 1;
+   //Writing
+   pfd.events = POLLOUT;
+   for (sent = 0; sent < length; )
+   {
+      if ((n = send (fd, &text[sent], length - sent, MSG_NOSIGNAL)) > 0)
+      {
+         sent += (ViInt32)n;
+         continue;
+      }
+      if ((n == 0) || ((errno != EAGAIN) && (errno != EWOULDBLOCK) && (errno != EINTR))) break;
+      wait = (int)((deadline - Pro8_TimeNow ()) * 1000.0);
+      if ((wait <= 0) || (poll (&pfd, 1, wait) <= 0)) break;
+   }
+   free (text);
 }
+#endif
 
 /****************************************************************************
 
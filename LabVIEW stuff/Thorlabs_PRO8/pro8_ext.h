@@ -0,0 +1,398 @@
+/****************************************************************************
+
+   Thorlabs PRO800/8000 series VXIpnp instrument driver
+
+   Extended driver functions (session, completion and performance API)
+
+   Copyright:  Copyright(c) 1999-2010, Thorlabs (www.thorlabs.com)
+   Author:     Michael Biebl (mbiebl@thorlabs.com)
+
+   Disclaimer:
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with this library; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+
+   Header file
+
+   This header complements 'pro8.h' (generated from 'pro8.fp') and
+   declares the functions that are not part of the function panel.
+   Include it after 'pro8.h'.
+
+****************************************************************************/
+
+#ifndef __pro8_ext_H__
+#define __pro8_ext_H__
+
+#include <vpptype.h>
+
+#if defined(__cplusplus) || defined(__cplusplus__)
+extern "C" {
+#endif
+
+//===========================================================================
+// Driver error codes
+//===========================================================================
+#define VI_ERROR_NO_SESSION_CONTEXT    (_VI_ERROR+0x3FFC0806L)    // Session was not opened by Pro8_init
+#define VI_ERROR_SESSION_TABLE_FULL    (_VI_ERROR+0x3FFC0807L)    // Too many sessions opened by Pro8_init
+#define VI_ERROR_BATCH_STATE           (_VI_ERROR+0x3FFC0808L)    // Batch not started or already started
+#define VI_ERROR_COMMAND_NOT_LOGGED    (_VI_ERROR+0x3FFC0809L)    // Sequence number not in the command log
+#define VI_ERROR_ASYNC_QUEUE_FULL      (_VI_ERROR+0x3FFC080AL)    // Too many asynchronous operations pending
+#define VI_ERROR_POOL_TABLE_FULL       (_VI_ERROR+0x3FFC080BL)    // Too many pools opened by Pro8_PoolOpen
+#define VI_ERROR_STREAM_STATE          (_VI_ERROR+0x3FFC080CL)    // Stream not started or already started
+#define VI_ERROR_CONSUMER_TABLE_FULL   (_VI_ERROR+0x3FFC080DL)    // Too many consumers attached to the stream
+#define VI_ERROR_STREAM_OVERRUN        (_VI_ERROR+0x3FFC080EL)    // Samples were overwritten while they were read
+#define VI_ERROR_SETPOINT_TABLE_FULL   (_VI_ERROR+0x3FFC080FL)    // Too many setpoint channels opened by Pro8_SetpointOpen
+#define VI_ERROR_VALUE_OUT_OF_LIMITS   (_VI_ERROR+0x3FFC0810L)    // Value outside the MIN/MAX limits of the module
+#define VI_ERROR_METRICS_STATE         (_VI_ERROR+0x3FFC0811L)    // Metrics socket not started or already started
+#define VI_ERROR_WAVEFORM_STATE        (_VI_ERROR+0x3FFC0812L)    // Waveform not started or still playing
+#define VI_ERROR_LOOP_STATE            (_VI_ERROR+0x3FFC0813L)    // Control loop not started or already started
+
+//===========================================================================
+// Completion modes (Pro8_SetCompletionMode)
+//===========================================================================
+#define PRO8_COMPLETION_POLL           0     // Poll STB every 50 ms (driver versions up to 2.5.3)
+#define PRO8_COMPLETION_BACKOFF        1     // Poll STB with adaptive backoff from 50 us (default)
+#define PRO8_COMPLETION_SRQ            2     // Wait for the service request raised by the FIN bit
+
+//===========================================================================
+// Error check modes (Pro8_SetErrorCheckMode)
+//===========================================================================
+#define PRO8_ERROR_CHECK_IMMEDIATE     0     // Wait for the FIN bit and check errors after each command (default)
+#define PRO8_ERROR_CHECK_DEFERRED      1     // Check errors at Pro8_SyncErrors or after the sync interval
+
+//===========================================================================
+// Asynchronous operations (Pro8_AsyncCall)
+//===========================================================================
+#define PRO8_ASYNC_MAX_PENDING         64    // Max number of operations pending per session
+#define PRO8_ASYNC_RESPONSE_SIZE       256   // Buffer size of a response returned by Pro8_AsyncGetResponse
+
+typedef ViStatus (_VI_FUNCH *Pro8_AsyncFunction) (ViSession instrumentHandle, ViAddr data);
+typedef void (_VI_FUNCH *Pro8_AsyncCallback) (ViSession instrumentHandle, ViInt32 future, ViStatus status, ViAddr callbackData);
+
+//===========================================================================
+// Instrument discovery (Pro8_FindInstruments)
+//===========================================================================
+#define PRO8_FIND_MAX_INSTRUMENTS      32    // Max number of instruments probed at the same time
+#define PRO8_FIND_DEFAULT_TIMEOUT      2.0   // Deadline (seconds) of a probe if timeout is 0
+
+typedef struct
+{
+   ViChar   resource[256];       // VISA resource name
+   ViChar   model[256];          // Model name from *IDN?
+   ViChar   serial[256];         // Serial number from *IDN?
+   ViChar   firmware[256];       // Firmware revision from *IDN?
+   ViStatus status;              // Status of the probe, the fields below are not valid if < 0
+   ViReal64 time;                // Duration of the probe (seconds)
+   ViInt16  type[8];             // Plug configuration, module type per slot (0 = empty)
+   ViInt16  sub[8];              // Module subtype per slot
+}  Pro8_tInstrument;
+
+typedef void (_VI_FUNCH *Pro8_FindCallback) (ViInt32 index, Pro8_tInstrument *instrument, ViAddr callbackData);
+
+//===========================================================================
+// Session pools (Pro8_PoolOpen)
+//===========================================================================
+#define PRO8_MAX_POOLS                 4     // Max number of pools opened at the same time
+#define PRO8_POOL_MAX_CHASSIS          16    // Max number of instruments in a pool
+
+//===========================================================================
+// Telemetry channels (Pro8_TelemetrySnapshot)
+//===========================================================================
+#define PRO8_CHANNEL_LD_CURRENT        1     // Laser current (A), LDC, MLC, ITC
+#define PRO8_CHANNEL_PD_CURRENT        2     // Monitor diode current (A), LDC, MLC, ITC
+#define PRO8_CHANNEL_LD_VOLTAGE        3     // Laser voltage (V), LDC, ITC
+#define PRO8_CHANNEL_TEMPERATURE       4     // Temperature (C), TEC, ITC
+#define PRO8_CHANNEL_TEC_CURRENT       5     // TEC current (A), TEC, ITC
+#define PRO8_CHANNEL_TEC_VOLTAGE       6     // TEC voltage (V), TEC, ITC
+#define PRO8_CHANNEL_PDA_CURRENT       7     // Photo diode current (A), PDA
+#define PRO8_CHANNEL_OPTICAL_POWER     8     // Optical power (W), PDA
+#define PRO8_CHANNEL_COUNT             8
+#define PRO8_CHANNEL_ALL               0     // Channel mask selecting all channels
+
+typedef struct
+{
+   ViReal64 timestamp;           // Monotonic time (seconds, see Pro8_GetTimestamp)
+   ViInt16  slot;                // Slot 1..8
+   ViInt16  channel;             // PRO8_CHANNEL_xxx
+   ViStatus status;              // Status of the query
+   ViReal64 value;
+}  Pro8_tSample;
+
+//===========================================================================
+// Streaming acquisition (Pro8_StreamStart)
+//===========================================================================
+#define PRO8_STREAM_MAX_CHANNELS       64    // Max number of channels acquired by a stream
+#define PRO8_STREAM_MAX_CONSUMERS      8     // Max number of consumers attached to a stream
+#define PRO8_STREAM_DEFAULT_CAPACITY   65536 // Number of samples in the ring if capacity is 0
+#define PRO8_STREAM_MAX_CAPACITY       16777216
+
+//===========================================================================
+// Setpoint channels (Pro8_SetpointOpen)
+//===========================================================================
+#define PRO8_SETPOINT_LD_CURRENT       1     // Laser current (A), :ILD:SET, LDC, MLC, ITC
+#define PRO8_SETPOINT_PD_CURRENT       2     // Monitor diode current (A), :IMD:SET, LDC, MLC, ITC
+#define PRO8_SETPOINT_OPTICAL_POWER    3     // Optical power (W), :POPT:SET, LDC, MLC, ITC
+#define PRO8_SETPOINT_TEMPERATURE      4     // Temperature (C), :TEMP:SET, TEC, ITC
+#define PRO8_SETPOINT_COUNT            4
+#define PRO8_MAX_SETPOINTS             16    // Max number of setpoint channels per session
+
+//===========================================================================
+// Waveforms (Pro8_WaveformStart)
+//===========================================================================
+#define PRO8_WAVEFORM_MAX_POINTS       1048576  // Max number of points of a setpoint table
+#define PRO8_WAVEFORM_MIN_PERIOD       0.0001   // Min time (seconds) between two points
+
+//===========================================================================
+// Control loops (Pro8_LoopStart)
+//===========================================================================
+#define PRO8_LOOP_MIN_PERIOD           0.0001   // Min period (seconds) of a control loop
+
+typedef ViStatus (_VI_FUNCH *Pro8_LoopInput) (ViAddr inputData, ViReal64 *value);
+
+typedef struct
+{
+   ViInt16        inputSlot;     // Slot of the input channel
+   ViInt16        inputChannel;  // PRO8_CHANNEL_xxx, not used with an external input
+   Pro8_LoopInput input;         // External input, e.g. a scope trace, VI_NULL = input channel
+   ViAddr         inputData;     // Passed to input
+   ViInt16        outputSlot;
+   ViInt16        outputParameter;  // PRO8_SETPOINT_xxx
+   ViReal64       target;        // Input value the loop locks to
+   ViReal64       kp;            // Proportional gain (output units per input unit)
+   ViReal64       ki;            // Integral gain (per second)
+   ViReal64       kd;            // Derivative gain (seconds)
+   ViReal64       bias;          // Output at zero error and integral
+   ViReal64       outputMin;     // Output limits
+   ViReal64       outputMax;
+   ViReal64       period;        // Loop period (seconds)
+}  Pro8_tLoopConfig;
+
+typedef struct
+{
+   ViUInt32 cycles;              // Cycles run
+   ViUInt32 missed;              // Periods skipped by late cycles
+   ViUInt32 errors;              // Failed cycles, the output was not written
+   ViUInt32 saturated;           // Outputs at a limit
+   ViReal64 rate;                // Cycles per second since the start
+   ViReal64 lastLatency;         // Time (seconds) from the input sample to the completed output
+   ViReal64 meanLatency;
+   ViReal64 maxLatency;
+   ViReal64 input;               // Values of the last cycle
+   ViReal64 error;
+   ViReal64 integral;
+   ViReal64 output;
+   ViStatus status;              // Status of the last cycle
+}  Pro8_tLoopStatistics;
+
+//===========================================================================
+// Temperature settling (Pro8_TecWaitSettled)
+//===========================================================================
+typedef ViBoolean (_VI_FUNCH *Pro8_SettleCallback) (ViSession instrumentHandle, ViReal64 elapsed, ViReal64 temperature, ViReal64 predicted, ViAddr callbackData);
+
+//===========================================================================
+// PID share tuning (Pro8_TecAutoTune)
+//===========================================================================
+#define PRO8_TUNE_BASELINE             1     // Settling time with the present shares
+#define PRO8_TUNE_RELAY                2     // Relay feedback experiment
+#define PRO8_TUNE_CALIBRATE            3     // Calibration of the shares
+#define PRO8_TUNE_VALIDATE             4     // Settling time with the tuned shares
+
+typedef ViBoolean (_VI_FUNCH *Pro8_TuneCallback) (ViSession instrumentHandle, ViInt16 phase, ViReal64 elapsed, ViReal64 temperature, ViAddr callbackData);
+
+typedef struct
+{
+   ViReal64  ultimateGain;       // Ultimate gain Ku (A/K) of the relay experiment
+   ViReal64  ultimatePeriod;     // Ultimate period Pu (seconds)
+   ViReal64  amplitude;          // Temperature amplitude (K) of the relay oscillation
+   ViReal64  PShare;             // Tuned shares
+   ViReal64  IShare;
+   ViReal64  DShare;
+   ViReal64  oldPShare;          // Shares before the tuning
+   ViReal64  oldIShare;
+   ViReal64  oldDShare;
+   ViReal64  oldSettleTime;      // Settling time (seconds) of the step with the shares before the tuning
+   ViReal64  newSettleTime;      // Settling time (seconds) of the step with the tuned shares
+   ViBoolean applied;            // Tuned shares are kept, otherwise the shares before are restored
+}  Pro8_tTuneResult;
+
+//===========================================================================
+// Electrical characterisation (Pro8_ElchAcquire)
+//===========================================================================
+typedef ViBoolean (_VI_FUNCH *Pro8_ElchCallback) (ViSession instrumentHandle, ViInt32 stepsDone, ViInt32 steps, ViAddr callbackData);
+
+//===========================================================================
+// Instrumentation counters (Pro8_GetCounters)
+//===========================================================================
+#define PRO8_COUNTER_ALL               0     // Sum of all command classes
+#define PRO8_COUNTER_SETTING           1     // Setting commands, e.g. ":ILD:SET 1.0E-02"
+#define PRO8_COUNTER_QUERY             2     // Queries, e.g. ":TEMP:ACT?"
+#define PRO8_COUNTER_COMMON            3     // Common commands, e.g. "*IDN?"
+#define PRO8_COUNTER_ERROR             4     // Error queue reads, ":SYST:ERR?"
+#define PRO8_COUNTER_CLASSES           4
+#define PRO8_METRICS_DEFAULT_PORT      9180  // Port of the metrics socket if port is 0
+
+typedef struct
+{
+   ViUInt32 writes;              // Messages written
+   ViUInt32 bytesWritten;
+   ViUInt32 reads;               // Read calls, a long response takes several
+   ViUInt32 bytesRead;
+   ViUInt32 stbPolls;            // Status byte reads (serial poll or *STB?)
+   ViUInt32 sleeps;              // Delays and event waits between the polls of the FIN bit
+   ViUInt32 waits;               // Waits for the FIN bit
+   ViUInt32 pollTimeouts;        // Waits ended by VI_ERROR_POLL_FIN_BIT
+   ViUInt32 errorDrains;         // Error queue reads after a command of the class
+   ViUInt32 ioErrors;            // Failed writes, reads and status byte reads
+   ViReal64 writeTime;           // Cumulative times (seconds)
+   ViReal64 readTime;
+   ViReal64 stbTime;
+   ViReal64 sleepTime;
+   ViReal64 waitTime;            // Whole waits for the FIN bit, polls and sleeps included
+   ViReal64 drainTime;
+   ViReal64 elapsed;             // Time since the counters were reset (seconds)
+}  Pro8_tCounters;
+
+//===========================================================================
+// Initialization functions
+//===========================================================================
+ViStatus _VI_FUNC Pro8_InitFast (ViString cacheFile, ViRsrc resourceName, ViBoolean resetDevice, ViPSession instrSession);
+ViStatus _VI_FUNC Pro8_GetInitStatistics (ViSession instrumentHandle, ViReal64 *initTime, ViBoolean *attached);
+ViStatus _VI_FUNC Pro8_FindInstruments (ViString findPattern, ViReal64 timeout, Pro8_FindCallback callback, ViAddr callbackData,
+                                        ViInt32 size, Pro8_tInstrument instruments[], ViInt32 *count);
+
+//===========================================================================
+// Session functions
+//===========================================================================
+ViStatus _VI_FUNC Pro8_SetCompletionMode (ViSession instrumentHandle, ViInt16 completionMode);
+ViStatus _VI_FUNC Pro8_GetCompletionMode (ViSession instrumentHandle, ViInt16 *completionMode);
+ViStatus _VI_FUNC Pro8_GetLastWaitTime (ViSession instrumentHandle, ViReal64 *lastWaitTime, ViReal64 *averageWaitTime);
+ViStatus _VI_FUNC Pro8_BeginBatch (ViSession instrumentHandle);
+ViStatus _VI_FUNC Pro8_CommitBatch (ViSession instrumentHandle);
+ViStatus _VI_FUNC Pro8_AbortBatch (ViSession instrumentHandle);
+ViStatus _VI_FUNC Pro8_InvalidateCache (ViSession instrumentHandle);
+ViStatus _VI_FUNC Pro8_SetErrorCheckMode (ViSession instrumentHandle, ViInt16 errorCheckMode, ViReal64 syncInterval);
+ViStatus _VI_FUNC Pro8_GetErrorCheckMode (ViSession instrumentHandle, ViInt16 *errorCheckMode, ViReal64 *syncInterval);
+ViStatus _VI_FUNC Pro8_SyncErrors (ViSession instrumentHandle, ViUInt32 *firstSequence, ViUInt32 *lastSequence);
+ViStatus _VI_FUNC Pro8_GetSequenceNumber (ViSession instrumentHandle, ViUInt32 *sequenceNumber);
+ViStatus _VI_FUNC Pro8_GetCommand (ViSession instrumentHandle, ViUInt32 sequenceNumber, ViChar _VI_FAR command[]);
+ViStatus _VI_FUNC Pro8_LockSession (ViSession instrumentHandle);
+ViStatus _VI_FUNC Pro8_UnlockSession (ViSession instrumentHandle);
+ViStatus _VI_FUNC Pro8_GetLockStatistics (ViSession instrumentHandle, ViUInt32 *acquisitions, ViUInt32 *contentions);
+ViStatus _VI_FUNC Pro8_GetTimestamp (ViReal64 *timestamp);
+ViStatus _VI_FUNC Pro8_SetShadowMode (ViSession instrumentHandle, ViBoolean shadowMode, ViReal64 maxAge);
+ViStatus _VI_FUNC Pro8_GetShadowMode (ViSession instrumentHandle, ViBoolean *shadowMode, ViReal64 *maxAge);
+ViStatus _VI_FUNC Pro8_GetShadowStatistics (ViSession instrumentHandle, ViUInt32 *hits, ViUInt32 *misses, ViInt32 *entries);
+ViStatus _VI_FUNC Pro8_ShadowScrub (ViSession instrumentHandle, ViInt32 *mismatches);
+ViStatus _VI_FUNC Pro8_SetMetadataMode (ViSession instrumentHandle, ViBoolean metadataMode, ViReal64 plugCheckInterval);
+ViStatus _VI_FUNC Pro8_GetMetadataMode (ViSession instrumentHandle, ViBoolean *metadataMode, ViReal64 *plugCheckInterval);
+ViStatus _VI_FUNC Pro8_GetSlotLimits (ViSession instrumentHandle, ViInt16 slot, ViString parameter, ViReal64 *minimum, ViReal64 *maximum);
+ViStatus _VI_FUNC Pro8_GetPlugChecksum (ViSession instrumentHandle, ViUInt32 *checksum, ViUInt32 *changes);
+ViStatus _VI_FUNC Pro8_TransportPing (ViSession instrumentHandle, ViInt32 count, ViChar _VI_FAR transport[], ViReal64 *minimum, ViReal64 *average, ViReal64 *maximum);
+
+//===========================================================================
+// Counter functions
+//===========================================================================
+ViStatus _VI_FUNC Pro8_GetCounters (ViSession instrumentHandle, ViInt16 commandClass, Pro8_tCounters *counters);
+ViStatus _VI_FUNC Pro8_ResetCounters (ViSession instrumentHandle);
+ViStatus _VI_FUNC Pro8_GetMetrics (ViInt32 size, ViChar _VI_FAR text[], ViInt32 *length);
+ViStatus _VI_FUNC Pro8_MetricsStart (ViInt32 port);
+ViStatus _VI_FUNC Pro8_MetricsStop (void);
+
+//===========================================================================
+// Telemetry functions
+//===========================================================================
+ViStatus _VI_FUNC Pro8_TelemetrySnapshot (ViSession instrumentHandle, ViUInt32 channelMask, ViInt32 size, Pro8_tSample samples[], ViInt32 *count);
+
+//===========================================================================
+// Streaming functions
+//===========================================================================
+ViStatus _VI_FUNC Pro8_StreamStart (ViSession instrumentHandle, ViInt32 count, ViInt16 slot[], ViInt16 channel[], ViReal64 period, ViInt32 capacity);
+ViStatus _VI_FUNC Pro8_StreamStop (ViSession instrumentHandle);
+ViStatus _VI_FUNC Pro8_StreamAttach (ViSession instrumentHandle, ViInt32 *consumer);
+ViStatus _VI_FUNC Pro8_StreamDetach (ViSession instrumentHandle, ViInt32 consumer);
+ViStatus _VI_FUNC Pro8_StreamAcquire (ViSession instrumentHandle, ViInt32 consumer, const Pro8_tSample **samples, ViInt32 *count);
+ViStatus _VI_FUNC Pro8_StreamRelease (ViSession instrumentHandle, ViInt32 consumer, ViInt32 count);
+ViStatus _VI_FUNC Pro8_StreamGetStatistics (ViSession instrumentHandle, ViInt32 consumer, ViUInt32 *behind, ViUInt32 *lost, ViUInt32 *cycles, ViUInt32 *missed);
+
+//===========================================================================
+// Setpoint functions
+//===========================================================================
+ViStatus _VI_FUNC Pro8_SetpointOpen (ViSession instrumentHandle, ViInt16 slot, ViInt16 parameter, ViInt32 *setpoint);
+ViStatus _VI_FUNC Pro8_SetpointClose (ViSession instrumentHandle, ViInt32 setpoint);
+ViStatus _VI_FUNC Pro8_SetpointPost (ViSession instrumentHandle, ViInt32 setpoint, ViReal64 value);
+ViStatus _VI_FUNC Pro8_SetpointGetStatistics (ViSession instrumentHandle, ViInt32 setpoint, ViUInt32 *applied, ViUInt32 *dropped,
+                                              ViReal64 *appliedValue, ViReal64 *lastAge, ViReal64 *maxAge, ViStatus *lastStatus);
+
+//===========================================================================
+// Waveform functions
+//===========================================================================
+ViStatus _VI_FUNC Pro8_WaveformStart (ViSession instrumentHandle, ViInt16 slot, ViInt16 parameter, ViInt32 count, ViReal64 setpoints[],
+                                      ViReal64 period, ViInt32 cycles);
+ViStatus _VI_FUNC Pro8_WaveformStop (ViSession instrumentHandle);
+ViStatus _VI_FUNC Pro8_WaveformGetStatistics (ViSession instrumentHandle, ViBoolean *running, ViUInt32 *points, ViUInt32 *cycles, ViUInt32 *late,
+                                              ViReal64 *maxError, ViReal64 *meanError, ViStatus *playStatus);
+ViStatus _VI_FUNC Pro8_WaveformGetErrors (ViSession instrumentHandle, ViInt32 size, ViReal64 errors[], ViInt32 *count);
+
+//===========================================================================
+// Control loop functions
+//===========================================================================
+ViStatus _VI_FUNC Pro8_LoopStart (ViSession instrumentHandle, Pro8_tLoopConfig *config);
+ViStatus _VI_FUNC Pro8_LoopStop (ViSession instrumentHandle);
+ViStatus _VI_FUNC Pro8_LoopSetParameters (ViSession instrumentHandle, ViReal64 target, ViReal64 kp, ViReal64 ki, ViReal64 kd);
+ViStatus _VI_FUNC Pro8_LoopGetStatistics (ViSession instrumentHandle, Pro8_tLoopStatistics *statistics);
+
+//===========================================================================
+// Settling functions
+//===========================================================================
+ViStatus _VI_FUNC Pro8_TecWaitSettled (ViSession instrumentHandle, ViInt16 slot, ViReal64 tolerance, ViReal64 timeout,
+                                       Pro8_SettleCallback callback, ViAddr callbackData, ViReal64 *settleTime, ViReal64 *temperature);
+
+//===========================================================================
+// Tuning functions
+//===========================================================================
+ViStatus _VI_FUNC Pro8_TecAutoTune (ViSession instrumentHandle, ViInt16 slot, ViReal64 amplitude, ViReal64 tolerance, ViReal64 timeout,
+                                    Pro8_TuneCallback callback, ViAddr callbackData, Pro8_tTuneResult *result);
+
+//===========================================================================
+// Asynchronous functions
+//===========================================================================
+ViStatus _VI_FUNC Pro8_AsyncCall (ViSession instrumentHandle, Pro8_AsyncFunction function, ViAddr data, Pro8_AsyncCallback callback, ViAddr callbackData, ViInt32 *future);
+ViStatus _VI_FUNC Pro8_AsyncWrite (ViSession instrumentHandle, ViInt16 slot, ViString command, Pro8_AsyncCallback callback, ViAddr callbackData, ViInt32 *future);
+ViStatus _VI_FUNC Pro8_AsyncQuery (ViSession instrumentHandle, ViInt16 slot, ViString query, Pro8_AsyncCallback callback, ViAddr callbackData, ViInt32 *future);
+ViStatus _VI_FUNC Pro8_AsyncWait (ViSession instrumentHandle, ViInt32 future, ViInt32 timeout);
+ViStatus _VI_FUNC Pro8_AsyncPoll (ViSession instrumentHandle, ViInt32 future, ViBoolean *done);
+ViStatus _VI_FUNC Pro8_AsyncGetResponse (ViSession instrumentHandle, ViInt32 future, ViChar _VI_FAR response[], ViReal64 *value);
+ViStatus _VI_FUNC Pro8_AsyncRelease (ViSession instrumentHandle, ViInt32 future);
+
+//===========================================================================
+// Pool functions
+//===========================================================================
+ViStatus _VI_FUNC Pro8_PoolOpen (ViString findPattern, ViBoolean IDQuery, ViBoolean resetDevice, ViUInt32 *pool, ViInt16 *chassisCount);
+ViStatus _VI_FUNC Pro8_PoolClose (ViUInt32 pool);
+ViStatus _VI_FUNC Pro8_PoolGetSession (ViUInt32 pool, ViInt16 chassis, ViSession *instrumentHandle, ViChar _VI_FAR resourceName[]);
+ViStatus _VI_FUNC Pro8_PoolExecute (ViUInt32 pool, ViInt32 count, ViInt16 chassis[], ViInt16 slot[], ViString commands[],
+                                    ViChar _VI_FAR responses[], ViReal64 values[], ViStatus results[]);
+
+//===========================================================================
+// Electrical characterisation functions
+//===========================================================================
+ViStatus _VI_FUNC Pro8_ElchAcquire (ViSession instrumentHandle, ViInt16 steps, ViInt16 measurementValues, ViReal64 values[],
+                                    Pro8_ElchCallback callback, ViAddr callbackData, ViInt32 *count);
+
+#if defined(__cplusplus) || defined(__cplusplus__)
+}
+#endif
+
+#endif  /* __pro8_ext_H__ */